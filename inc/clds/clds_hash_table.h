@@ -20,23 +20,43 @@ extern "C" {
 struct CLDS_HASH_TABLE_ITEM_TAG;
 
 typedef struct CLDS_HASH_TABLE_TAG* CLDS_HASH_TABLE_HANDLE;
+typedef struct CLDS_HASH_TABLE_CURSOR_TAG* CLDS_HASH_TABLE_CURSOR_HANDLE;
 typedef uint64_t (*COMPUTE_HASH_FUNC)(void* key);
 typedef int (*KEY_COMPARE_FUNC)(void* key_1, void* key_2);
 typedef void(*HASH_TABLE_ITEM_CLEANUP_CB)(void* context, struct CLDS_HASH_TABLE_ITEM_TAG* item);
 typedef void(*HASH_TABLE_SKIPPED_SEQ_NO_CB)(void* context, int64_t skipped_sequence_no);
 
+// the key of an item together with its hash, the items of a bucket are ordered by hash and then by key,
+// so that items with a different hash are passed over without calling the key compare function
+typedef struct HASH_TABLE_HASHED_KEY_TAG
+{
+    uint64_t hash;
+    void* key;
+} HASH_TABLE_HASHED_KEY;
+
 typedef struct HASH_TABLE_ITEM_TAG
 {
     // these are internal variables used by the hash table
     HASH_TABLE_ITEM_CLEANUP_CB item_cleanup_callback;
     void* item_cleanup_callback_context;
-    void* key;
+    HASH_TABLE_HASHED_KEY hashed_key;
+    // the sequence number of the write that put the item in the table, used by clds_hash_table_snapshot_at_sequence_number
+    volatile_atomic int64_t insert_sequence_number;
+    // links the item in the items kept for a snapshot at a sequence number with the sequence numbers of its insert and of its removal,
+    // so that keeping an item taken out of the table allocates nothing
+    struct SORTED_LIST_NODE_HASH_TABLE_ITEM_TAG* next_superseded_item;
+    volatile_atomic int32_t is_superseded;
+    int64_t superseded_insert_sequence_number;
+    int64_t superseded_remove_sequence_number;
 } HASH_TABLE_ITEM;
 
 DECLARE_SORTED_LIST_NODE_TYPE(HASH_TABLE_ITEM)
 
 typedef struct SORTED_LIST_NODE_HASH_TABLE_ITEM_TAG CLDS_HASH_TABLE_ITEM;
 
+// creates the item for a key that is not in the table, the key stored in the item can be returned in item_key (when left NULL the key passed to the table is stored)
+typedef CLDS_HASH_TABLE_ITEM*(*HASH_TABLE_ITEM_FACTORY_CB)(void* context, void* key, void** item_key);
+
 // these are macros that help declaring a type that can be stored in the hash table
 #define DECLARE_HASH_TABLE_NODE_TYPE(record_type) \
 typedef struct MU_C3(HASH_TABLE_NODE_,record_type,_TAG) \
@@ -91,16 +111,54 @@ MU_DEFINE_ENUM(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_RESUL
 
 MU_DEFINE_ENUM(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_RESULT_VALUES);
 
+// how the bucket of a key is picked out of the hash of the key
+// MODULO: the bucket index is the hash modulo the bucket count, any initial bucket size can be used
+// POWER_OF_TWO: the initial bucket size is rounded up to a power of two and the bucket index is the hash masked with the bucket count - 1,
+// the hash is mixed first so that all the bits of a weak hash count
+#define CLDS_HASH_TABLE_BUCKET_INDEXING_VALUES \
+    CLDS_HASH_TABLE_BUCKET_INDEXING_MODULO, \
+    CLDS_HASH_TABLE_BUCKET_INDEXING_POWER_OF_TWO
+
+MU_DEFINE_ENUM(CLDS_HASH_TABLE_BUCKET_INDEXING, CLDS_HASH_TABLE_BUCKET_INDEXING_VALUES);
+
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_HANDLE, clds_hash_table_create, COMPUTE_HASH_FUNC, compute_hash, KEY_COMPARE_FUNC, key_compare_func, size_t, initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, volatile_atomic int64_t*, start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB, skipped_seq_no_cb, void*, skipped_seq_no_cb_context);
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_HANDLE, clds_hash_table_create_with_bucket_indexing, COMPUTE_HASH_FUNC, compute_hash, KEY_COMPARE_FUNC, key_compare_func, size_t, initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, volatile_atomic int64_t*, start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB, skipped_seq_no_cb, void*, skipped_seq_no_cb_context, CLDS_HASH_TABLE_BUCKET_INDEXING, bucket_indexing);
 MOCKABLE_FUNCTION(, void, clds_hash_table_destroy, CLDS_HASH_TABLE_HANDLE, clds_hash_table);
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_INSERT_RESULT, clds_hash_table_insert, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_HASH_TABLE_ITEM*, value, int64_t*, sequence_number);
+// returns the item of key, or inserts the item created by item_factory when key is not in the table, the bucket is walked only once
+// the item is returned with a reference that the caller has to release, CLDS_HASH_TABLE_INSERT_OK means the item was created and inserted
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_INSERT_RESULT, clds_hash_table_get_or_insert, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, HASH_TABLE_ITEM_FACTORY_CB, item_factory, void*, item_factory_context, CLDS_HASH_TABLE_ITEM**, item, int64_t*, sequence_number);
+// inserts item_count items at once (to load a table), the buckets are sized for all the items before they are inserted and the items are split by bucket
+// between thread_count threads, results[i] is the result of inserting items[i] with keys[i] (an item is owned by the table only if its result is CLDS_HASH_TABLE_INSERT_OK)
+MOCKABLE_FUNCTION(, int, clds_hash_table_insert_batch, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void**, keys, CLDS_HASH_TABLE_ITEM**, items, uint32_t, item_count, uint32_t, thread_count, CLDS_HASH_TABLE_INSERT_RESULT*, results, int64_t*, sequence_numbers);
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_DELETE_RESULT, clds_hash_table_delete, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, int64_t*, sequence_number);
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_DELETE_RESULT, clds_hash_table_delete_key_value, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_HASH_TABLE_ITEM*, value, int64_t*, sequence_number);
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_REMOVE_RESULT, clds_hash_table_remove, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_HASH_TABLE_ITEM**, item, int64_t*, sequence_number);
+// with a NULL condition_check_func this is an upsert, the item of key is replaced by new_item or new_item is inserted in one call
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_SET_VALUE_RESULT, clds_hash_table_set_value, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_HASH_TABLE_ITEM*, new_item, CONDITION_CHECK_CB, condition_check_func, void*, condition_check_context, CLDS_HASH_TABLE_ITEM**, old_item, int64_t*, sequence_number);
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_ITEM*, clds_hash_table_find, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key);
+// looks up key_count keys at once, overlapping the cache misses of the lookups, items[i] is the item found for keys[i] (or NULL)
+MOCKABLE_FUNCTION(, int, clds_hash_table_find_batch, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void**, keys, uint32_t, key_count, CLDS_HASH_TABLE_ITEM**, items);
 
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_SNAPSHOT_RESULT, clds_hash_table_snapshot, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM***, items, uint64_t*, item_count);
+// returns the items that were in the table at one sequence number, without blocking the writes while the snapshot is taken,
+// the table has to be created with a start sequence number
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_SNAPSHOT_RESULT, clds_hash_table_snapshot_at_sequence_number, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM***, items, uint64_t*, item_count, int64_t*, sequence_number);
+
+// walks the items of the table in batches without blocking the writes, the walk is weakly consistent: each item that is in the table
+// for the whole walk is returned once, items inserted or deleted during the walk might or might not be returned
+// the items are not migrated between the bucket arrays while a cursor is open, so a cursor should be closed once it is not needed anymore
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_CURSOR_HANDLE, clds_hash_table_cursor_open, CLDS_HASH_TABLE_HANDLE, clds_hash_table);
+MOCKABLE_FUNCTION(, int, clds_hash_table_cursor_next, CLDS_HASH_TABLE_CURSOR_HANDLE, clds_hash_table_cursor, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM**, items, uint32_t, item_capacity, uint32_t*, item_count);
+MOCKABLE_FUNCTION(, void, clds_hash_table_cursor_close, CLDS_HASH_TABLE_CURSOR_HANDLE, clds_hash_table_cursor);
+
+// sets how many buckets of the oldest array of buckets each write (and each find) moves to the newest array of buckets after the table grew
+MOCKABLE_FUNCTION(, int, clds_hash_table_set_migration_bucket_count, CLDS_HASH_TABLE_HANDLE, clds_hash_table, uint32_t, write_migration_bucket_count, uint32_t, read_migration_bucket_count);
+// grows the table up front so that it holds item_count items without growing while they are inserted
+MOCKABLE_FUNCTION(, int, clds_hash_table_reserve, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, uint32_t, item_count);
+// gives back the memory held by the table after items were deleted: the items are moved to a smaller array of buckets (never smaller than
+// the initial bucket size) and the older arrays of buckets are freed once no thread uses them anymore
+MOCKABLE_FUNCTION(, int, clds_hash_table_shrink, CLDS_HASH_TABLE_HANDLE, clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread);
 
 // helper APIs for creating/destroying a hash table node
 MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_ITEM*, clds_hash_table_node_create, size_t, node_size, HASH_TABLE_ITEM_CLEANUP_CB, item_cleanup_callback, void*, item_cleanup_callback_context);
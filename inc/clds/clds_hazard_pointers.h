@@ -9,8 +9,12 @@
 #else
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 #endif
 
+#include "macro_utils/macro_utils.h"
+#include "c_pal/interlocked.h"
+
 #include "umock_c/umock_c_prod.h"
 #ifdef __cplusplus
 extern "C" {
@@ -22,14 +26,78 @@ typedef struct CLDS_HAZARD_POINTER_RECORD_TAG* CLDS_HAZARD_POINTER_RECORD_HANDLE
 
 typedef void(*RECLAIM_FUNC)(void* node);
 
+// the way the instance decides when a retired node is not in use by any thread anymore
+// HAZARD_POINTERS: each acquire publishes the node, a retired node is reclaimed when no thread has it published
+// EPOCH_BASED: the first acquire of a thread pins the current epoch and the last release unpins it,
+// a retired node is reclaimed once all the threads that are pinned have pinned an epoch after the retire
+// INTERVAL_BASED: like EPOCH_BASED, but a thread reserves the interval of eras it has seen during the operation,
+// a retired node is reclaimed when no reserved interval overlaps the eras between its creation and its retire
+#define CLDS_HAZARD_POINTERS_RECLAMATION_MODE_VALUES \
+    CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS, \
+    CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH_BASED, \
+    CLDS_HAZARD_POINTERS_RECLAMATION_MODE_INTERVAL_BASED
+
+MU_DEFINE_ENUM(CLDS_HAZARD_POINTERS_RECLAMATION_MODE, CLDS_HAZARD_POINTERS_RECLAMATION_MODE_VALUES);
+
+// this is the link that a node embeds so that it can be retired without any allocation
+typedef struct CLDS_HAZARD_POINTERS_RETIRE_LINK_TAG
+{
+    // these are internal variables used by the hazard pointers module
+    struct CLDS_HAZARD_POINTERS_RETIRE_LINK_TAG* next;
+    void* volatile_atomic node;
+    RECLAIM_FUNC reclaim;
+    int64_t birth_era;
+    int64_t retire_epoch;
+    bool is_allocated;
+} CLDS_HAZARD_POINTERS_RETIRE_LINK;
+
+// reclamation counters, as returned by clds_hazard_pointers_get_statistics (whole instance) and clds_hazard_pointers_get_thread_statistics (one thread)
+typedef struct CLDS_HAZARD_POINTERS_STATISTICS_TAG
+{
+    // nodes retired (clds_hazard_pointers_retire and clds_hazard_pointers_reclaim)
+    uint64_t retired_count;
+    // nodes for which the reclaim function was called
+    uint64_t freed_count;
+    // nodes retired and not freed yet
+    uint64_t backlog_count;
+    uint64_t scan_count;
+    double total_scan_time_us;
+    double max_scan_time_us;
+    // thread records visited by all the scans, divided by scan_count this is the number of thread records visited per scan
+    uint64_t visited_thread_count;
+} CLDS_HAZARD_POINTERS_STATISTICS;
+
+// declares the retire link in a node type (like the list items), the link has to be initialized with CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT when the node is created
+#define CLDS_HAZARD_POINTERS_RETIRE_LINK_FIELD \
+    CLDS_HAZARD_POINTERS_RETIRE_LINK retire_link;
+
+// the era clock used by the interval based mode, nodes get their birth era from it when their link is initialized
+extern volatile_atomic int64_t clds_hazard_pointers_global_era;
+
+#define CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(node_ptr) \
+    ((node_ptr)->retire_link.birth_era = interlocked_add_64(&clds_hazard_pointers_global_era, 0), \
+    (void)interlocked_exchange_pointer(&(node_ptr)->retire_link.node, NULL))
+
+// retires a node that declares its retire link with CLDS_HAZARD_POINTERS_RETIRE_LINK_FIELD
+#define CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, node_ptr, reclaim_func) \
+    clds_hazard_pointers_retire(clds_hazard_pointers_thread, (void*)(node_ptr), &(node_ptr)->retire_link, reclaim_func)
+
 MOCKABLE_FUNCTION(, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers_create);
+MOCKABLE_FUNCTION(, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers_create_with_mode, CLDS_HAZARD_POINTERS_RECLAMATION_MODE, reclamation_mode);
 MOCKABLE_FUNCTION(, void, clds_hazard_pointers_destroy, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers);
 MOCKABLE_FUNCTION(, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_register_thread, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers);
 MOCKABLE_FUNCTION(, void, clds_hazard_pointers_unregister_thread, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread);
 MOCKABLE_FUNCTION(, CLDS_HAZARD_POINTER_RECORD_HANDLE, clds_hazard_pointers_acquire, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, node);
 MOCKABLE_FUNCTION(, void, clds_hazard_pointers_release, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_HAZARD_POINTER_RECORD_HANDLE, clds_hazard_pointer_record);
 MOCKABLE_FUNCTION(, void, clds_hazard_pointers_reclaim, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, node, RECLAIM_FUNC, reclaim_func);
+MOCKABLE_FUNCTION(, void, clds_hazard_pointers_retire, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, node, CLDS_HAZARD_POINTERS_RETIRE_LINK*, retire_link, RECLAIM_FUNC, reclaim_func);
 MOCKABLE_FUNCTION(, int, clds_hazard_pointers_set_reclaim_threshold, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, size_t, reclaim_threshold);
+MOCKABLE_FUNCTION(, int, clds_hazard_pointers_set_adaptive_reclaim_threshold, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, uint32_t, headroom_percent);
+MOCKABLE_FUNCTION(, int, clds_hazard_pointers_set_slot_count, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, uint32_t, slot_count);
+MOCKABLE_FUNCTION(, int, clds_hazard_pointers_start_background_reclaimer, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, uint32_t, max_pending_batches);
+MOCKABLE_FUNCTION(, int, clds_hazard_pointers_get_statistics, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, CLDS_HAZARD_POINTERS_STATISTICS*, statistics);
+MOCKABLE_FUNCTION(, int, clds_hazard_pointers_get_thread_statistics, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_HAZARD_POINTERS_STATISTICS*, statistics);
+MOCKABLE_FUNCTION(, int, clds_hazard_pointers_enable_asymmetric_fence, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers);
 
 #ifdef __cplusplus
 }
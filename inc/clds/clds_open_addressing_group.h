@@ -0,0 +1,331 @@
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#ifndef CLDS_OPEN_ADDRESSING_GROUP_H
+#define CLDS_OPEN_ADDRESSING_GROUP_H
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+#else
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#endif
+
+#include "c_pal/interlocked.h"
+
+#include "clds_hazard_pointers.h"
+
+// the control bytes of a group are matched with one 16 byte compare when SSE2 is available
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define CLDS_OPEN_ADDRESSING_USE_SSE2_CONTROL_BYTE_MATCH
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// these are the slot groups shared by the open addressing hash tables (clds_open_addressing_hash_table and the typed tables declared with DECLARE_CLDS_HASH_TABLE_TYPE)
+
+// the slots are in groups of CLDS_OPEN_ADDRESSING_GROUP_SIZE, each slot has a control byte that is either EMPTY or holds the 7 low bits of the hash of its key (tag)
+// the group of a key is given by the rest of the hash and the slots of the probe sequence of a key are visited in order (groups of the probe sequence, slots of a group by index)
+
+// a slot is claimed by a compare exchange of its item pointer from NULL, after which the tag is published in the control byte
+// deleting an item changes its slot to CLDS_OPEN_ADDRESSING_SLOT_DELETED (the item is retired by the table) and the slot is not claimed again
+// since a slot never goes back to NULL, an insert claims the first free slot of the probe sequence of its key unless the key is already in an earlier slot,
+// so 2 inserts of the same key always meet in one slot and a lookup can stop at the first group that has a NULL slot
+// the slots of deleted items are given back by rebuilding the groups in a new group array, which also grows the table
+
+// writers increment the version of a group after changing it, readers read the group without locking and read it again if the version changed meanwhile
+// readers only load the fields of a group (plain loads of the volatile_atomic fields), so they do not take the cache line of the group away from each other
+
+#define CLDS_OPEN_ADDRESSING_GROUP_SIZE 16
+#define CLDS_OPEN_ADDRESSING_CONTROL_WORD_COUNT 2
+#define CLDS_OPEN_ADDRESSING_CONTROL_BYTES_PER_WORD 8
+
+#define CLDS_OPEN_ADDRESSING_CONTROL_BYTE_EMPTY ((uint8_t)0x80)
+#define CLDS_OPEN_ADDRESSING_CONTROL_WORD_EMPTY ((int64_t)(uint64_t)0x8080808080808080)
+#define CLDS_OPEN_ADDRESSING_CONTROL_BYTE_TAG_MASK ((uint64_t)0x7F)
+#define CLDS_OPEN_ADDRESSING_GROUP_INDEX_SHIFT 7
+
+// what a slot holds once its item was deleted, the items are allocated so no item pointer has this value
+#define CLDS_OPEN_ADDRESSING_SLOT_DELETED ((void*)(uintptr_t)1)
+
+// group counts are kept in an int32_t
+#define CLDS_OPEN_ADDRESSING_MAX_CAPACITY ((size_t)1 << 30)
+
+// an insert that finds no free slot in this many groups has the groups rebuilt before looking again
+#define CLDS_OPEN_ADDRESSING_MAX_PROBE_COUNT 8
+
+typedef struct CLDS_OPEN_ADDRESSING_GROUP_TAG
+{
+    // incremented after each change of the group
+    volatile_atomic int32_t version;
+    // 8 control bytes per word, control byte i is the byte (i % 8) (from the low byte) of word i / 8
+    // a control byte is only written by the writer that claimed the slot, with a compare exchange of the whole word
+    volatile_atomic int64_t control_words[CLDS_OPEN_ADDRESSING_CONTROL_WORD_COUNT];
+    void* volatile_atomic slots[CLDS_OPEN_ADDRESSING_GROUP_SIZE];
+} CLDS_OPEN_ADDRESSING_GROUP;
+
+// the groups of a table, a new array replaces the groups when they are rebuilt and the old one is retired through hazard pointers
+typedef struct CLDS_OPEN_ADDRESSING_GROUP_ARRAY_TAG
+{
+    int32_t group_count;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_FIELD
+    CLDS_OPEN_ADDRESSING_GROUP groups[];
+} CLDS_OPEN_ADDRESSING_GROUP_ARRAY;
+
+// the control bytes of a group as read at one point, the 2 words are matched together
+typedef struct CLDS_OPEN_ADDRESSING_CONTROL_BYTES_TAG
+{
+    uint64_t words[CLDS_OPEN_ADDRESSING_CONTROL_WORD_COUNT];
+} CLDS_OPEN_ADDRESSING_CONTROL_BYTES;
+
+static inline void clds_open_addressing_group_read_control_bytes(const CLDS_OPEN_ADDRESSING_GROUP* group, CLDS_OPEN_ADDRESSING_CONTROL_BYTES* control_bytes)
+{
+    control_bytes->words[0] = (uint64_t)group->control_words[0];
+    control_bytes->words[1] = (uint64_t)group->control_words[1];
+}
+
+// returns a mask with bit i set when control byte i is value
+static inline uint32_t clds_open_addressing_group_match_control_byte(const CLDS_OPEN_ADDRESSING_CONTROL_BYTES* control_bytes, uint8_t value)
+{
+    uint32_t result;
+
+#ifdef CLDS_OPEN_ADDRESSING_USE_SSE2_CONTROL_BYTE_MATCH
+    __m128i group_control_bytes = _mm_set_epi64x((long long)control_bytes->words[1], (long long)control_bytes->words[0]);
+    result = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group_control_bytes, _mm_set1_epi8((char)value)));
+#else
+    uint32_t i;
+
+    result = 0;
+    for (i = 0; i < CLDS_OPEN_ADDRESSING_GROUP_SIZE; i++)
+    {
+        uint8_t control_byte = (uint8_t)(control_bytes->words[i / CLDS_OPEN_ADDRESSING_CONTROL_BYTES_PER_WORD] >> ((i % CLDS_OPEN_ADDRESSING_CONTROL_BYTES_PER_WORD) * 8));
+        if (control_byte == value)
+        {
+            result |= ((uint32_t)1 << i);
+        }
+    }
+#endif
+
+    return result;
+}
+
+static inline uint32_t clds_open_addressing_group_get_lowest_set_bit_index(uint32_t mask)
+{
+    uint32_t result;
+
+#if defined(_MSC_VER)
+    unsigned long bit_index;
+    (void)_BitScanForward(&bit_index, mask);
+    result = (uint32_t)bit_index;
+#elif defined(__GNUC__)
+    result = (uint32_t)__builtin_ctz(mask);
+#else
+    result = 0;
+    while ((mask & ((uint32_t)1 << result)) == 0)
+    {
+        result++;
+    }
+#endif
+
+    return result;
+}
+
+static inline uint8_t clds_open_addressing_group_get_tag(uint64_t hash)
+{
+    return (uint8_t)(hash & CLDS_OPEN_ADDRESSING_CONTROL_BYTE_TAG_MASK);
+}
+
+// returns the number of groups needed for capacity items, rounded up to a power of 2
+static inline int32_t clds_open_addressing_group_get_group_count(size_t capacity)
+{
+    int32_t group_count = 1;
+    while ((size_t)group_count * CLDS_OPEN_ADDRESSING_GROUP_SIZE < capacity)
+    {
+        group_count *= 2;
+    }
+
+    return group_count;
+}
+
+static inline int32_t clds_open_addressing_group_get_first_group_index(int32_t group_count, uint64_t hash)
+{
+    return (int32_t)((hash >> CLDS_OPEN_ADDRESSING_GROUP_INDEX_SHIFT) & (uint64_t)(group_count - 1));
+}
+
+// the probe sequence steps by 1, 2, 3, ... groups, which visits every group once when the group count is a power of 2
+static inline int32_t clds_open_addressing_group_get_next_group_index(int32_t group_count, int32_t group_index, int32_t probe_count)
+{
+    return (group_index + probe_count) & (group_count - 1);
+}
+
+static inline void clds_open_addressing_group_init(CLDS_OPEN_ADDRESSING_GROUP* group)
+{
+    uint32_t i;
+
+    (void)interlocked_exchange(&group->version, 0);
+    for (i = 0; i < CLDS_OPEN_ADDRESSING_CONTROL_WORD_COUNT; i++)
+    {
+        (void)interlocked_exchange_64(&group->control_words[i], CLDS_OPEN_ADDRESSING_CONTROL_WORD_EMPTY);
+    }
+    for (i = 0; i < CLDS_OPEN_ADDRESSING_GROUP_SIZE; i++)
+    {
+        (void)interlocked_exchange_pointer(&group->slots[i], NULL);
+    }
+}
+
+// returns what is in the slot: NULL, an item pointer or CLDS_OPEN_ADDRESSING_SLOT_DELETED
+static inline void* clds_open_addressing_group_get_slot(const CLDS_OPEN_ADDRESSING_GROUP* group, uint32_t slot_index)
+{
+    return group->slots[slot_index];
+}
+
+static inline bool clds_open_addressing_group_is_slot_deleted(void* slot_value)
+{
+    return slot_value == CLDS_OPEN_ADDRESSING_SLOT_DELETED;
+}
+
+// returns true when the slot value is an item (the slot is neither free nor deleted)
+static inline bool clds_open_addressing_group_is_slot_item(void* slot_value)
+{
+    return (slot_value != NULL) && (slot_value != CLDS_OPEN_ADDRESSING_SLOT_DELETED);
+}
+
+// changes the slot from expected_slot_value to new_slot_value, fails if another writer changed the slot first
+static inline bool clds_open_addressing_group_change_slot(CLDS_OPEN_ADDRESSING_GROUP* group, uint32_t slot_index, void* expected_slot_value, void* new_slot_value)
+{
+    return interlocked_compare_exchange_pointer(&group->slots[slot_index], new_slot_value, expected_slot_value) == expected_slot_value;
+}
+
+// publishes the tag of a slot that was just claimed, other writers can change the other control bytes of the word meanwhile
+static inline void clds_open_addressing_group_set_control_byte(CLDS_OPEN_ADDRESSING_GROUP* group, uint32_t slot_index, uint8_t value)
+{
+    volatile_atomic int64_t* control_word = &group->control_words[slot_index / CLDS_OPEN_ADDRESSING_CONTROL_BYTES_PER_WORD];
+    uint32_t shift = (slot_index % CLDS_OPEN_ADDRESSING_CONTROL_BYTES_PER_WORD) * 8;
+    int64_t current_word;
+    int64_t new_word;
+
+    do
+    {
+        current_word = *control_word;
+        new_word = (int64_t)(((uint64_t)current_word & ~((uint64_t)0xFF << shift)) | ((uint64_t)value << shift));
+    } while (interlocked_compare_exchange_64(control_word, new_word, current_word) != current_word);
+}
+
+// a group that has a NULL slot was never passed by an insert, a slot with an EMPTY control byte might just not have its tag published yet
+static inline bool clds_open_addressing_group_has_free_slot(const CLDS_OPEN_ADDRESSING_GROUP* group, uint32_t empty_mask)
+{
+    bool result = false;
+
+    while ((empty_mask != 0) && !result)
+    {
+        uint32_t slot_index = clds_open_addressing_group_get_lowest_set_bit_index(empty_mask);
+        empty_mask &= empty_mask - 1;
+
+        result = (clds_open_addressing_group_get_slot(group, slot_index) == NULL);
+    }
+
+    return result;
+}
+
+static inline void clds_open_addressing_group_increment_version(CLDS_OPEN_ADDRESSING_GROUP* group)
+{
+    (void)interlocked_increment(&group->version);
+}
+
+static inline int32_t clds_open_addressing_group_read_version(const CLDS_OPEN_ADDRESSING_GROUP* group)
+{
+    return group->version;
+}
+
+static inline bool clds_open_addressing_group_version_changed(const CLDS_OPEN_ADDRESSING_GROUP* group, int32_t version)
+{
+    return group->version != version;
+}
+
+// returns the number of items in the groups, must be called while no writer changes the groups
+static inline size_t clds_open_addressing_group_array_get_item_count(const CLDS_OPEN_ADDRESSING_GROUP_ARRAY* group_array)
+{
+    size_t result = 0;
+    int32_t i;
+
+    for (i = 0; i < group_array->group_count; i++)
+    {
+        uint32_t j;
+
+        for (j = 0; j < CLDS_OPEN_ADDRESSING_GROUP_SIZE; j++)
+        {
+            if (clds_open_addressing_group_is_slot_item(clds_open_addressing_group_get_slot(&group_array->groups[i], j)))
+            {
+                result++;
+            }
+        }
+    }
+
+    return result;
+}
+
+// returns the group count to rebuild the groups with for item_count items (the groups are at most half full after a rebuild), 0 if the items do not fit in the largest table
+static inline int32_t clds_open_addressing_group_get_rebuild_group_count(size_t item_count, int32_t min_group_count)
+{
+    int32_t result;
+
+    if (item_count >= CLDS_OPEN_ADDRESSING_MAX_CAPACITY)
+    {
+        result = 0;
+    }
+    else
+    {
+        size_t capacity = (item_count * 2 > CLDS_OPEN_ADDRESSING_MAX_CAPACITY) ? CLDS_OPEN_ADDRESSING_MAX_CAPACITY : item_count * 2;
+        result = clds_open_addressing_group_get_group_count(capacity);
+        if (result < min_group_count)
+        {
+            result = min_group_count;
+        }
+    }
+
+    return result;
+}
+
+// stores an item in the first free slot of its probe sequence in a group array that no other thread uses yet (the groups are being rebuilt)
+static inline void clds_open_addressing_group_array_place_item(CLDS_OPEN_ADDRESSING_GROUP_ARRAY* group_array, void* item, uint64_t hash)
+{
+    int32_t group_index = clds_open_addressing_group_get_first_group_index(group_array->group_count, hash);
+    int32_t probe_count = 0;
+    bool placed = false;
+
+    while (!placed)
+    {
+        CLDS_OPEN_ADDRESSING_GROUP* group = &group_array->groups[group_index];
+        CLDS_OPEN_ADDRESSING_CONTROL_BYTES control_bytes;
+        uint32_t empty_mask;
+
+        clds_open_addressing_group_read_control_bytes(group, &control_bytes);
+        empty_mask = clds_open_addressing_group_match_control_byte(&control_bytes, CLDS_OPEN_ADDRESSING_CONTROL_BYTE_EMPTY);
+        if (empty_mask != 0)
+        {
+            uint32_t slot_index = clds_open_addressing_group_get_lowest_set_bit_index(empty_mask);
+            (void)interlocked_exchange_pointer(&group->slots[slot_index], item);
+            clds_open_addressing_group_set_control_byte(group, slot_index, clds_open_addressing_group_get_tag(hash));
+            placed = true;
+        }
+        else
+        {
+            probe_count++;
+            group_index = clds_open_addressing_group_get_next_group_index(group_array->group_count, group_index, probe_count);
+        }
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLDS_OPEN_ADDRESSING_GROUP_H */
@@ -0,0 +1,83 @@
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#ifndef CLDS_OPEN_ADDRESSING_HASH_TABLE_H
+#define CLDS_OPEN_ADDRESSING_HASH_TABLE_H
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+#else
+#include <stdint.h>
+#include <stddef.h>
+#endif
+
+#include "macro_utils/macro_utils.h"
+#include "c_pal/interlocked.h"
+
+#include "umock_c/umock_c_prod.h"
+#include "clds_hazard_pointers.h"
+#include "clds_hash_table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// this is a hash table engine that keeps the items in the slots of one array (open addressing)
+// the slots are in groups of 16, each group has one control byte per slot holding 7 bits of the hash of the key in the slot,
+// so that a lookup compares the control bytes of a whole group at once and looks at the items only for the matching slots
+// deleted items keep their slot until the slot is reused by the same key or the groups are rebuilt in a new array, which also grows the table
+// the compute hash and key compare callbacks and the operation results are the ones of clds_hash_table, so that the engines can be switched
+
+struct CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM_TAG;
+
+typedef struct CLDS_OPEN_ADDRESSING_HASH_TABLE_TAG* CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE;
+typedef void(*OPEN_ADDRESSING_HASH_TABLE_ITEM_CLEANUP_CB)(void* context, struct CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM_TAG* item);
+
+typedef struct CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM_TAG
+{
+    // these are internal variables used by the hash table
+    volatile_atomic int32_t ref_count;
+    OPEN_ADDRESSING_HASH_TABLE_ITEM_CLEANUP_CB item_cleanup_callback;
+    void* item_cleanup_callback_context;
+    uint64_t hash;
+    void* key;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_FIELD
+} CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM;
+
+// these are macros that help declaring a type that can be stored in the hash table
+#define DECLARE_OPEN_ADDRESSING_HASH_TABLE_NODE_TYPE(record_type) \
+typedef struct MU_C3(OPEN_ADDRESSING_HASH_TABLE_NODE_,record_type,_TAG) \
+{ \
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM item; \
+    record_type record; \
+} MU_C2(OPEN_ADDRESSING_HASH_TABLE_NODE_,record_type); \
+
+#define CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(record_type, item_cleanup_callback, item_cleanup_callback_context) \
+clds_open_addressing_hash_table_node_create(sizeof(MU_C2(OPEN_ADDRESSING_HASH_TABLE_NODE_,record_type)), item_cleanup_callback, item_cleanup_callback_context)
+
+#define CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_INC_REF(record_type, ptr) \
+clds_open_addressing_hash_table_node_inc_ref(ptr)
+
+#define CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_RELEASE(record_type, ptr) \
+clds_open_addressing_hash_table_node_release(ptr)
+
+#define CLDS_OPEN_ADDRESSING_HASH_TABLE_GET_VALUE(record_type, ptr) \
+((record_type*)((unsigned char*)ptr + offsetof(MU_C2(OPEN_ADDRESSING_HASH_TABLE_NODE_,record_type), record)))
+
+MOCKABLE_FUNCTION(, CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE, clds_open_addressing_hash_table_create, COMPUTE_HASH_FUNC, compute_hash, KEY_COMPARE_FUNC, key_compare_func, size_t, capacity, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, volatile_atomic int64_t*, start_sequence_number);
+MOCKABLE_FUNCTION(, void, clds_open_addressing_hash_table_destroy, CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE, clds_open_addressing_hash_table);
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_INSERT_RESULT, clds_open_addressing_hash_table_insert, CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE, clds_open_addressing_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM*, value, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_DELETE_RESULT, clds_open_addressing_hash_table_delete, CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE, clds_open_addressing_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_REMOVE_RESULT, clds_open_addressing_hash_table_remove, CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE, clds_open_addressing_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM**, item, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM*, clds_open_addressing_hash_table_find, CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE, clds_open_addressing_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key);
+
+// helper APIs for creating/destroying a hash table node
+MOCKABLE_FUNCTION(, CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM*, clds_open_addressing_hash_table_node_create, size_t, node_size, OPEN_ADDRESSING_HASH_TABLE_ITEM_CLEANUP_CB, item_cleanup_callback, void*, item_cleanup_callback_context);
+MOCKABLE_FUNCTION(, int, clds_open_addressing_hash_table_node_inc_ref, CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM*, item);
+MOCKABLE_FUNCTION(, void, clds_open_addressing_hash_table_node_release, CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM*, item);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLDS_OPEN_ADDRESSING_HASH_TABLE_H */
@@ -36,6 +36,7 @@ typedef struct CLDS_SINGLY_LINKED_LIST_ITEM_TAG
     SINGLY_LINKED_LIST_ITEM_CLEANUP_CB item_cleanup_callback;
     void* item_cleanup_callback_context;
     volatile_atomic struct CLDS_SINGLY_LINKED_LIST_ITEM_TAG* next;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_FIELD
 } CLDS_SINGLY_LINKED_LIST_ITEM;
 
 // these are macros that help declaring a type that can be stored in the singly linked list
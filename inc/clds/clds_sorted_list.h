@@ -36,6 +36,7 @@ typedef int(*SORTED_LIST_KEY_COMPARE_CB)(void* context, void* key1, void* key2);
 typedef void(*SORTED_LIST_ITEM_CLEANUP_CB)(void* context, struct CLDS_SORTED_LIST_ITEM_TAG* item);
 typedef void(*SORTED_LIST_SKIPPED_SEQ_NO_CB)(void* context, int64_t skipped_sequence_no);
 typedef CLDS_CONDITION_CHECK_RESULT (*CONDITION_CHECK_CB)(void* context, void* new_key, void* old_key);
+typedef struct CLDS_SORTED_LIST_ITEM_TAG*(*SORTED_LIST_ITEM_FACTORY_CB)(void* context);
 
 // this is the structure needed for one sorted list item
 // it contains information like ref count, next pointer, etc.
@@ -46,8 +47,25 @@ typedef struct CLDS_SORTED_LIST_ITEM_TAG
     SORTED_LIST_ITEM_CLEANUP_CB item_cleanup_callback;
     void* item_cleanup_callback_context;
     struct CLDS_SORTED_LIST_ITEM_TAG* volatile_atomic next;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_FIELD
 } CLDS_SORTED_LIST_ITEM;
 
+// a list head that can be stored inline in another structure (like the buckets of a hash table)
+// the items linked to a head are handled by the clds_sorted_list_head_* APIs, using a sorted list created with clds_sorted_list_create
+// that provides the callbacks, the sequence number and the write lock shared by all the heads used with it
+typedef struct CLDS_SORTED_LIST_HEAD_TAG
+{
+    // this is an internal variable used by the sorted list
+    volatile_atomic struct CLDS_SORTED_LIST_ITEM_TAG* head;
+} CLDS_SORTED_LIST_HEAD;
+
+// a head has to be initialized before it is used, initializing it does not allocate anything
+#define CLDS_SORTED_LIST_HEAD_INIT(list_head) \
+    (void)interlocked_exchange_pointer((void* volatile_atomic*)&(list_head)->head, NULL)
+
+#define CLDS_SORTED_LIST_HEAD_IS_EMPTY(list_head) \
+    (interlocked_compare_exchange_pointer((void* volatile_atomic*)&(list_head)->head, NULL, NULL) == NULL)
+
 // these are macros that help declaring a type that can be stored in the sorted list
 #define DECLARE_SORTED_LIST_NODE_TYPE(record_type) \
 typedef struct MU_C3(SORTED_LIST_NODE_,record_type,_TAG) \
@@ -129,6 +147,23 @@ MOCKABLE_FUNCTION(, void, clds_sorted_list_unlock_writes, CLDS_SORTED_LIST_HANDL
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_GET_COUNT_RESULT, clds_sorted_list_get_count, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, uint64_t*, item_count);
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_GET_ALL_RESULT, clds_sorted_list_get_all, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, uint64_t, item_count, CLDS_SORTED_LIST_ITEM**, items);
 
+// same operations as above, on the items linked to list_head, clds_sorted_list provides the callbacks, the sequence number and the write lock
+MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_INSERT_RESULT, clds_sorted_list_head_insert, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_SORTED_LIST_HEAD*, list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM*, item, int64_t*, sequence_number);
+// looks for key and, if it is not there, inserts the item made by item_factory in the same pass over the list (item_factory is not called when key is found),
+// item is the item that was found or the one that was inserted, with a reference taken
+MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_INSERT_RESULT, clds_sorted_list_head_get_or_insert, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_SORTED_LIST_HEAD*, list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, SORTED_LIST_ITEM_FACTORY_CB, item_factory, void*, item_factory_context, CLDS_SORTED_LIST_ITEM**, item, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_DELETE_RESULT, clds_sorted_list_head_delete_item, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_SORTED_LIST_HEAD*, list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM*, item, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_DELETE_RESULT, clds_sorted_list_head_delete_key, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_SORTED_LIST_HEAD*, list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_REMOVE_RESULT, clds_sorted_list_head_remove_key, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_SORTED_LIST_HEAD*, list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_SORTED_LIST_ITEM**, item, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_ITEM*, clds_sorted_list_head_find_key, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_SORTED_LIST_HEAD*, list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key);
+MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_SET_VALUE_RESULT, clds_sorted_list_head_set_value, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_SORTED_LIST_HEAD*, list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_SORTED_LIST_ITEM*, new_item, CONDITION_CHECK_CB, condition_check_func, void*, condition_check_context, CLDS_SORTED_LIST_ITEM**, old_item, int64_t*, sequence_number, bool, only_if_exists);
+MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_GET_COUNT_RESULT, clds_sorted_list_head_get_count, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_SORTED_LIST_HEAD*, list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, uint64_t*, item_count);
+MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_GET_ALL_RESULT, clds_sorted_list_head_get_all, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_SORTED_LIST_HEAD*, list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, uint64_t, item_count, CLDS_SORTED_LIST_ITEM**, items);
+MOCKABLE_FUNCTION(, int, clds_sorted_list_head_get_first, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_SORTED_LIST_HEAD*, list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM**, item);
+// returns the first item linked to list_head with a key greater than key (key does not have to be in the list), with a reference taken, or NULL if there is none
+MOCKABLE_FUNCTION(, int, clds_sorted_list_head_get_next, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_SORTED_LIST_HEAD*, list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_SORTED_LIST_ITEM**, item);
+MOCKABLE_FUNCTION(, void, clds_sorted_list_head_clear, CLDS_SORTED_LIST_HANDLE, clds_sorted_list, CLDS_SORTED_LIST_HEAD*, list_head);
+
 // helper APIs for creating/destroying a sorted list node
 MOCKABLE_FUNCTION(, CLDS_SORTED_LIST_ITEM*, clds_sorted_list_node_create, size_t, node_size, SORTED_LIST_ITEM_CLEANUP_CB, item_cleanup_callback, void*, item_cleanup_callback_context);
 MOCKABLE_FUNCTION(, int, clds_sorted_list_node_inc_ref, CLDS_SORTED_LIST_ITEM*, item);
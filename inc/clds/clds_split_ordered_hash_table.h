@@ -0,0 +1,88 @@
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#ifndef CLDS_SPLIT_ORDERED_HASH_TABLE_H
+#define CLDS_SPLIT_ORDERED_HASH_TABLE_H
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+#else
+#include <stdint.h>
+#include <stddef.h>
+#endif
+
+#include "macro_utils/macro_utils.h"
+#include "c_pal/interlocked.h"
+
+#include "umock_c/umock_c_prod.h"
+#include "clds_hazard_pointers.h"
+#include "clds_sorted_list.h"
+#include "clds_hash_table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// this is a hash table engine that keeps all the items in one lock free list ordered by the bit reversed hash (split ordered list)
+// the buckets are pointers to dummy nodes in that list and growing the table only changes the bucket count, no item is ever moved
+// the compute hash, key compare, skipped sequence number and condition check callbacks and the operation results are the ones of clds_hash_table,
+// so that the engines can be switched
+
+struct CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM_TAG;
+
+typedef struct CLDS_SPLIT_ORDERED_HASH_TABLE_TAG* CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE;
+typedef void(*SPLIT_ORDERED_HASH_TABLE_ITEM_CLEANUP_CB)(void* context, struct CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM_TAG* item);
+
+typedef struct CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM_TAG
+{
+    // these are internal variables used by the hash table
+    volatile_atomic int32_t ref_count;
+    SPLIT_ORDERED_HASH_TABLE_ITEM_CLEANUP_CB item_cleanup_callback;
+    void* item_cleanup_callback_context;
+    struct CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM_TAG* volatile_atomic next;
+    uint64_t split_order_key;
+    void* key;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_FIELD
+} CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM;
+
+// these are macros that help declaring a type that can be stored in the hash table
+#define DECLARE_SPLIT_ORDERED_HASH_TABLE_NODE_TYPE(record_type) \
+typedef struct MU_C3(SPLIT_ORDERED_HASH_TABLE_NODE_,record_type,_TAG) \
+{ \
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM item; \
+    record_type record; \
+} MU_C2(SPLIT_ORDERED_HASH_TABLE_NODE_,record_type); \
+
+#define CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(record_type, item_cleanup_callback, item_cleanup_callback_context) \
+clds_split_ordered_hash_table_node_create(sizeof(MU_C2(SPLIT_ORDERED_HASH_TABLE_NODE_,record_type)), item_cleanup_callback, item_cleanup_callback_context)
+
+#define CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_INC_REF(record_type, ptr) \
+clds_split_ordered_hash_table_node_inc_ref(ptr)
+
+#define CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(record_type, ptr) \
+clds_split_ordered_hash_table_node_release(ptr)
+
+#define CLDS_SPLIT_ORDERED_HASH_TABLE_GET_VALUE(record_type, ptr) \
+((record_type*)((unsigned char*)ptr + offsetof(MU_C2(SPLIT_ORDERED_HASH_TABLE_NODE_,record_type), record)))
+
+MOCKABLE_FUNCTION(, CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE, clds_split_ordered_hash_table_create, COMPUTE_HASH_FUNC, compute_hash, KEY_COMPARE_FUNC, key_compare_func, size_t, initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE, clds_hazard_pointers, volatile_atomic int64_t*, start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB, skipped_seq_no_cb, void*, skipped_seq_no_cb_context);
+MOCKABLE_FUNCTION(, void, clds_split_ordered_hash_table_destroy, CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE, clds_split_ordered_hash_table);
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_INSERT_RESULT, clds_split_ordered_hash_table_insert, CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE, clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*, value, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_DELETE_RESULT, clds_split_ordered_hash_table_delete, CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE, clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_DELETE_RESULT, clds_split_ordered_hash_table_delete_key_value, CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE, clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*, value, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_REMOVE_RESULT, clds_split_ordered_hash_table_remove, CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE, clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM**, item, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_SET_VALUE_RESULT, clds_split_ordered_hash_table_set_value, CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE, clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*, new_item, CONDITION_CHECK_CB, condition_check_func, void*, condition_check_context, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM**, old_item, int64_t*, sequence_number);
+MOCKABLE_FUNCTION(, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*, clds_split_ordered_hash_table_find, CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE, clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, void*, key);
+
+MOCKABLE_FUNCTION(, CLDS_HASH_TABLE_SNAPSHOT_RESULT, clds_split_ordered_hash_table_snapshot, CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE, clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE, clds_hazard_pointers_thread, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM***, items, uint64_t*, item_count);
+
+// helper APIs for creating/destroying a hash table node
+MOCKABLE_FUNCTION(, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*, clds_split_ordered_hash_table_node_create, size_t, node_size, SPLIT_ORDERED_HASH_TABLE_ITEM_CLEANUP_CB, item_cleanup_callback, void*, item_cleanup_callback_context);
+MOCKABLE_FUNCTION(, int, clds_split_ordered_hash_table_node_inc_ref, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*, item);
+MOCKABLE_FUNCTION(, void, clds_split_ordered_hash_table_node_release, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*, item);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLDS_SPLIT_ORDERED_HASH_TABLE_H */
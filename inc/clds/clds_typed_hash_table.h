@@ -0,0 +1,893 @@
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#ifndef CLDS_TYPED_HASH_TABLE_H
+#define CLDS_TYPED_HASH_TABLE_H
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cinttypes>
+#else
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#endif
+
+#include "macro_utils/macro_utils.h"
+
+#include "c_pal/interlocked.h"
+
+#include "clds_hazard_pointers.h"
+#include "clds_hash_table.h"
+#include "clds_open_addressing_group.h"
+
+// DECLARE_CLDS_HASH_TABLE_TYPE(name, key_type) declares a hash table specialized at compile time for one key type
+// and DEFINE_CLDS_HASH_TABLE_TYPE(name, key_type, hash_fn, eq_fn) defines its functions
+// the table is laid out like clds_open_addressing_hash_table (groups of 16 slots with one control byte per slot), but:
+// - hash_fn and eq_fn are called directly, so they can be inlined in the generated functions (no call through a function pointer per visited item)
+// - the key is stored in the item (key_type key), so comparing a key does not dereference a void* key
+//
+// DECLARE_CLDS_HASH_TABLE_TYPE goes in a header (or in the .c file that uses the table),
+// DEFINE_CLDS_HASH_TABLE_TYPE goes in exactly one .c file, which shall include c_logging/logger.h, c_pal/gballoc_hl.h,
+// c_pal/gballoc_hl_redirect.h and c_pal/sync.h before it, so that this header does not force them on its includers
+//
+// hash_fn shall have the signature uint64_t hash_fn(const key_type* key)
+// eq_fn shall have the signature bool eq_fn(const key_type* key_1, const key_type* key_2)
+// both should be static inline functions declared before DEFINE_CLDS_HASH_TABLE_TYPE
+//
+// DECLARE_CLDS_HASH_TABLE_TYPE(name, ...) declares the types name_ITEM, name_ITEM_CLEANUP_CB, name_HANDLE and the functions:
+// name_HANDLE name_create(size_t capacity, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* start_sequence_number);
+// void name_destroy(name_HANDLE hash_table);
+// CLDS_HASH_TABLE_INSERT_RESULT name_insert(name_HANDLE hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, name_ITEM* value, int64_t* sequence_number);
+// CLDS_HASH_TABLE_DELETE_RESULT name_delete(name_HANDLE hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, const key_type* key, int64_t* sequence_number);
+// CLDS_HASH_TABLE_REMOVE_RESULT name_remove(name_HANDLE hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, const key_type* key, name_ITEM** item, int64_t* sequence_number);
+// name_ITEM* name_find(name_HANDLE hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, const key_type* key);
+// name_ITEM* name_node_create(size_t node_size, const key_type* key, name_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context);
+// int name_node_inc_ref(name_ITEM* item);
+// void name_node_release(name_ITEM* item);
+
+/* Codes_SRS_CLDS_TYPED_HASH_TABLE_01_045: [ DECLARE_CLDS_HASH_TABLE_TYPE(name, key_type) shall declare the types name_ITEM_CLEANUP_CB, name_ITEM and name_HANDLE and the functions of the table name, without defining them. ]*/
+#define DECLARE_CLDS_HASH_TABLE_TYPE(name, key_type) \
+    DECLARE_CLDS_HASH_TABLE_TYPE_TYPES(name, key_type) \
+    DECLARE_CLDS_HASH_TABLE_TYPE_FUNCTIONS(name, key_type) \
+
+/* Codes_SRS_CLDS_TYPED_HASH_TABLE_01_046: [ DEFINE_CLDS_HASH_TABLE_TYPE(name, key_type, hash_fn, eq_fn) shall define the functions declared by DECLARE_CLDS_HASH_TABLE_TYPE(name, key_type), with external linkage. ]*/
+/* Codes_SRS_CLDS_TYPED_HASH_TABLE_01_047: [ Apart from what the requirements below specify, name_create, name_destroy, name_insert, name_delete, name_remove and name_find shall behave as clds_open_addressing_hash_table_create, clds_open_addressing_hash_table_destroy, clds_open_addressing_hash_table_insert, clds_open_addressing_hash_table_delete, clds_open_addressing_hash_table_remove and clds_open_addressing_hash_table_find, with hash_fn and eq_fn in place of compute_hash and key_compare_func. ]*/
+#define DEFINE_CLDS_HASH_TABLE_TYPE(name, key_type, hash_fn, eq_fn) \
+    DEFINE_CLDS_HASH_TABLE_TYPE_NODE_FUNCTIONS(name, key_type) \
+    DEFINE_CLDS_HASH_TABLE_TYPE_TABLE_FUNCTIONS(name, key_type, hash_fn, eq_fn) \
+
+// these are macros that help declaring a type that can be stored in a typed hash table
+#define DECLARE_CLDS_HASH_TABLE_TYPE_NODE_TYPE(name, record_type) \
+typedef struct MU_C3(name, _NODE_TAG_, record_type) \
+{ \
+    MU_C2(name, _ITEM) item; \
+    record_type record; \
+} MU_C3(name, _NODE_, record_type); \
+
+#define CLDS_HASH_TABLE_TYPE_NODE_CREATE(name, record_type, key, item_cleanup_callback, item_cleanup_callback_context) \
+MU_C2(name, _node_create)(sizeof(MU_C3(name, _NODE_, record_type)), key, item_cleanup_callback, item_cleanup_callback_context)
+
+#define CLDS_HASH_TABLE_TYPE_NODE_INC_REF(name, ptr) \
+MU_C2(name, _node_inc_ref)(ptr)
+
+#define CLDS_HASH_TABLE_TYPE_NODE_RELEASE(name, ptr) \
+MU_C2(name, _node_release)(ptr)
+
+#define CLDS_HASH_TABLE_TYPE_GET_VALUE(name, record_type, ptr) \
+((record_type*)((unsigned char*)ptr + offsetof(MU_C3(name, _NODE_, record_type), record)))
+
+#define DECLARE_CLDS_HASH_TABLE_TYPE_TYPES(name, key_type) \
+struct MU_C2(name, _ITEM_TAG); \
+typedef void(*MU_C2(name, _ITEM_CLEANUP_CB))(void* context, struct MU_C2(name, _ITEM_TAG)* item); \
+typedef struct MU_C2(name, _ITEM_TAG) \
+{ \
+    /* these are internal variables used by the hash table */ \
+    volatile_atomic int32_t ref_count; \
+    MU_C2(name, _ITEM_CLEANUP_CB) item_cleanup_callback; \
+    void* item_cleanup_callback_context; \
+    uint64_t hash; \
+    /* the key is stored in the item, it is set when the item is created and shall not change afterwards */ \
+    key_type key; \
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_FIELD \
+} MU_C2(name, _ITEM); \
+typedef struct MU_C2(name, _TAG)* MU_C2(name, _HANDLE); \
+
+#define DECLARE_CLDS_HASH_TABLE_TYPE_FUNCTIONS(name, key_type) \
+MU_C2(name, _HANDLE) MU_C2(name, _create)(size_t capacity, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* start_sequence_number); \
+void MU_C2(name, _destroy)(MU_C2(name, _HANDLE) hash_table); \
+CLDS_HASH_TABLE_INSERT_RESULT MU_C2(name, _insert)(MU_C2(name, _HANDLE) hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, MU_C2(name, _ITEM)* value, int64_t* sequence_number); \
+CLDS_HASH_TABLE_DELETE_RESULT MU_C2(name, _delete)(MU_C2(name, _HANDLE) hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, const key_type* key, int64_t* sequence_number); \
+CLDS_HASH_TABLE_REMOVE_RESULT MU_C2(name, _remove)(MU_C2(name, _HANDLE) hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, const key_type* key, MU_C2(name, _ITEM)** item, int64_t* sequence_number); \
+MU_C2(name, _ITEM)* MU_C2(name, _find)(MU_C2(name, _HANDLE) hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, const key_type* key); \
+MU_C2(name, _ITEM)* MU_C2(name, _node_create)(size_t node_size, const key_type* key, MU_C2(name, _ITEM_CLEANUP_CB) item_cleanup_callback, void* item_cleanup_callback_context); \
+int MU_C2(name, _node_inc_ref)(MU_C2(name, _ITEM)* item); \
+void MU_C2(name, _node_release)(MU_C2(name, _ITEM)* item); \
+
+#define DEFINE_CLDS_HASH_TABLE_TYPE_NODE_FUNCTIONS(name, key_type) \
+static void MU_C2(name, _internal_node_destroy)(MU_C2(name, _ITEM)* item) \
+{ \
+    if (interlocked_decrement(&item->ref_count) == 0) \
+    { \
+        if (item->item_cleanup_callback != NULL) \
+        { \
+            item->item_cleanup_callback(item->item_cleanup_callback_context, item); \
+        } \
+ \
+        free((void*)item); \
+    } \
+} \
+static void MU_C2(name, _reclaim_node)(void* node) \
+{ \
+    MU_C2(name, _internal_node_destroy)((MU_C2(name, _ITEM)*)node); \
+} \
+MU_C2(name, _ITEM)* MU_C2(name, _node_create)(size_t node_size, const key_type* key, MU_C2(name, _ITEM_CLEANUP_CB) item_cleanup_callback, void* item_cleanup_callback_context) \
+{ \
+    MU_C2(name, _ITEM)* result; \
+ \
+    if ( \
+        /* Codes_SRS_CLDS_TYPED_HASH_TABLE_01_036: [ If key is NULL or node_size is smaller than the size of the item, name_node_create shall fail and return NULL. ]*/ \
+        (key == NULL) || \
+        (node_size < sizeof(MU_C2(name, _ITEM))) \
+        ) \
+    { \
+        LogError("Invalid arguments: size_t node_size=%zu, key=%p", node_size, (const void*)key); \
+        result = NULL; \
+    } \
+    else \
+    { \
+        /* Codes_SRS_CLDS_TYPED_HASH_TABLE_01_037: [ name_node_create shall allocate node_size bytes, copy the key into the item and set its reference count to 1. ]*/ \
+        /* Codes_SRS_CLDS_TYPED_HASH_TABLE_01_038: [ item_cleanup_callback and item_cleanup_callback_context shall be allowed to be NULL. ]*/ \
+        result = malloc(node_size); \
+        if (result == NULL) \
+        { \
+            /* Codes_SRS_CLDS_TYPED_HASH_TABLE_01_039: [ If any error occurs, name_node_create shall fail and return NULL. ]*/ \
+            LogError("malloc(node_size=%zu) failed", node_size); \
+        } \
+        else \
+        { \
+            result->item_cleanup_callback = item_cleanup_callback; \
+            result->item_cleanup_callback_context = item_cleanup_callback_context; \
+            result->key = *key; \
+            result->hash = 0; \
+            (void)interlocked_exchange(&result->ref_count, 1); \
+            CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(result); \
+        } \
+    } \
+ \
+    return result; \
+} \
+int MU_C2(name, _node_inc_ref)(MU_C2(name, _ITEM)* item) \
+{ \
+    int result; \
+ \
+    if (item == NULL) \
+    { \
+        LogError("Invalid arguments: item=%p", (void*)item); \
+        result = MU_FAILURE; \
+    } \
+    else \
+    { \
+        (void)interlocked_increment(&item->ref_count); \
+        result = 0; \
+    } \
+ \
+    return result; \
+} \
+void MU_C2(name, _node_release)(MU_C2(name, _ITEM)* item) \
+{ \
+    if (item == NULL) \
+    { \
+        LogError("Invalid arguments: item=%p", (void*)item); \
+    } \
+    else \
+    { \
+        /* Codes_SRS_CLDS_TYPED_HASH_TABLE_01_040: [ When the reference count of an item reaches 0, item_cleanup_callback shall be called (if not NULL) and the item shall be freed. ]*/ \
+        MU_C2(name, _internal_node_destroy)(item); \
+    } \
+} \
+
+#define DEFINE_CLDS_HASH_TABLE_TYPE_TABLE_FUNCTIONS(name, key_type, hash_fn, eq_fn) \
+struct MU_C2(name, _TAG) \
+{ \
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers; \
+    volatile_atomic int64_t* sequence_number; \
+    int32_t initial_group_count; \
+    CLDS_OPEN_ADDRESSING_GROUP_ARRAY* volatile_atomic group_array; \
+    volatile_atomic int32_t locked_for_write; \
+    volatile_atomic int32_t pending_write_operations; \
+}; \
+static void MU_C2(name, _reclaim_group_array)(void* node) \
+{ \
+    /* the items of the array were moved to the new array or retired on their own */ \
+    free(node); \
+} \
+static void MU_C2(name, _check_lock_and_begin_write_operation)(MU_C2(name, _HANDLE) hash_table) \
+{ \
+    int32_t locked_for_write; \
+    do \
+    { \
+        (void)interlocked_increment(&hash_table->pending_write_operations); \
+        locked_for_write = interlocked_add(&hash_table->locked_for_write, 0); \
+        if (locked_for_write != 0) \
+        { \
+            (void)interlocked_decrement(&hash_table->pending_write_operations); \
+            wake_by_address_all(&hash_table->pending_write_operations); \
+ \
+            /* Wait for the groups to be rebuilt */ \
+            (void)wait_on_address(&hash_table->locked_for_write, locked_for_write, UINT32_MAX); \
+        } \
+    } while (locked_for_write != 0); \
+} \
+static void MU_C2(name, _end_write_operation)(MU_C2(name, _HANDLE) hash_table) \
+{ \
+    /* only a rebuild waits for the writers, so there is nobody to wake otherwise */ \
+    if ( \
+        (interlocked_decrement(&hash_table->pending_write_operations) == 0) && \
+        (interlocked_add(&hash_table->locked_for_write, 0) != 0) \
+        ) \
+    { \
+        wake_by_address_all(&hash_table->pending_write_operations); \
+    } \
+} \
+static void MU_C2(name, _wait_for_write_operations)(MU_C2(name, _HANDLE) hash_table) \
+{ \
+    int32_t pending_writes; \
+    do \
+    { \
+        pending_writes = interlocked_add(&hash_table->pending_write_operations, 0); \
+        if (pending_writes != 0) \
+        { \
+            /* Wait for writes */ \
+            (void)wait_on_address(&hash_table->pending_write_operations, pending_writes, UINT32_MAX); \
+        } \
+    } while (pending_writes != 0); \
+} \
+static CLDS_HAZARD_POINTER_RECORD_HANDLE MU_C2(name, _acquire_group_array)(MU_C2(name, _HANDLE) hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_OPEN_ADDRESSING_GROUP_ARRAY** group_array) \
+{ \
+    /* returns the hazard pointer that keeps the group array of the table from being freed while it is read */ \
+    CLDS_HAZARD_POINTER_RECORD_HANDLE result; \
+    bool done = false; \
+ \
+    do \
+    { \
+        *group_array = hash_table->group_array; \
+        result = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, *group_array); \
+        if (result == NULL) \
+        { \
+            LogError("Cannot acquire hazard pointer"); \
+            done = true; \
+        } \
+        else if (hash_table->group_array != *group_array) \
+        { \
+            /* the groups were rebuilt before the hazard pointer was published */ \
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, result); \
+        } \
+        else \
+        { \
+            done = true; \
+        } \
+    } while (!done); \
+ \
+    return result; \
+} \
+static int MU_C2(name, _find_key_slot)(MU_C2(name, _HANDLE) hash_table, CLDS_OPEN_ADDRESSING_GROUP_ARRAY* group_array, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t hash, const key_type* key, CLDS_OPEN_ADDRESSING_GROUP** found_group, uint32_t* found_slot_index, void** found_slot_value, CLDS_HAZARD_POINTER_RECORD_HANDLE* found_item_hp, bool* group_array_replaced) \
+{ \
+    /* looks for the slot of the key, *found_group is NULL if the key is not in the groups, *found_item_hp protects the item of the slot */ \
+    /* *group_array_replaced is set when the groups were rebuilt while a reader read them, the key has to be looked for again in the new group array */ \
+    int result = 0; \
+    uint8_t tag = clds_open_addressing_group_get_tag(hash); \
+    int32_t group_index = clds_open_addressing_group_get_first_group_index(group_array->group_count, hash); \
+    int32_t probe_count = 0; \
+    bool done = false; \
+ \
+    *found_group = NULL; \
+    *group_array_replaced = false; \
+ \
+    while (!done && (probe_count < group_array->group_count)) \
+    { \
+        CLDS_OPEN_ADDRESSING_GROUP* group = &group_array->groups[group_index]; \
+        int32_t version = clds_open_addressing_group_read_version(group); \
+        bool group_changed = false; \
+        CLDS_OPEN_ADDRESSING_CONTROL_BYTES control_bytes; \
+        uint32_t match_mask; \
+ \
+        /* Codes_SRS_CLDS_TYPED_HASH_TABLE_01_030: [ name_find shall hash the key with hash_fn and compare the control bytes of each visited group with the low 7 bits of the hash, without locking the group. ]*/ \
+        clds_open_addressing_group_read_control_bytes(group, &control_bytes); \
+        match_mask = clds_open_addressing_group_match_control_byte(&control_bytes, tag); \
+ \
+        while ((match_mask != 0) && !group_changed && !done) \
+        { \
+            uint32_t slot_index = clds_open_addressing_group_get_lowest_set_bit_index(match_mask); \
+            void* slot_value = clds_open_addressing_group_get_slot(group, slot_index); \
+ \
+            match_mask &= match_mask - 1; \
+ \
+            if (clds_open_addressing_group_is_slot_deleted(slot_value)) \
+            { \
+                /* the item of the slot was deleted, the key of the slot is not in the table anymore */ \
+            } \
+            else \
+            { \
+                MU_C2(name, _ITEM)* item = slot_value; \
+                CLDS_HAZARD_POINTER_RECORD_HANDLE item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, item); \
+                if (item_hp == NULL) \
+                { \
+                    LogError("Cannot acquire hazard pointer"); \
+                    result = MU_FAILURE; \
+                    done = true; \
+                } \
+                else \
+                { \
+                    /* Codes_SRS_CLDS_TYPED_HASH_TABLE_01_032: [ For each matching slot, name_find shall acquire a hazard pointer on the item in the slot, check that the version of the group did not change and compare the hash and then the key of the item with eq_fn. ]*/ \
+                    if (clds_open_addressing_group_version_changed(group, version)) \
+                    { \
+                        /* the item might have been retired before the hazard pointer was published */ \
+                        group_changed = true; \
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, item_hp); \
+                    } \
+                    else if (hash_table->group_array != group_array) \
+                    { \
+                        /* the slots of a replaced group array do not change anymore, the item might have been deleted and retired from the new group array before the hazard pointer was published */ \
+                        *group_array_replaced = true; \
+                        done = true; \
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, item_hp); \
+                    } \
+                    else if ( \
+                        (item->hash == hash) && \
+                        eq_fn(&item->key, key) \
+                        ) \
+                    { \
+                        /* the slot holds the key, the key is in no other slot */ \
+                        *found_group = group; \
+                        *found_slot_index = slot_index; \
+                        *found_slot_value = slot_value; \
+                        *found_item_hp = item_hp; \
+                        done = true; \
+                    } \
+                    else \
+                    { \
+                        /* tag collision, look at the next matching slot */ \
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, item_hp); \
+                    } \
+                } \
+            } \
+        } \
+ \
+        if (!done) \
+        { \
+            if (group_changed || clds_open_addressing_group_version_changed(group, version)) \
+            { \
+                /* the group changed while it was read, read it again */ \
+            } \
+            else if (clds_open_addressing_group_has_free_slot(group, clds_open_addressing_group_match_control_byte(&control_bytes, CLDS_OPEN_ADDRESSING_CONTROL_BYTE_EMPTY))) \
+            { \
+                /* no insert of this key ever went past this group */ \
+                done = true; \
+            } \
+            else \
+            { \
+                probe_count++; \
+                group_index = clds_open_addressing_group_get_next_group_index(group_array->group_count, group_index, probe_count); \
+            } \
+        } \
+    } \
+ \
+    return result; \
+} \
+static CLDS_HASH_TABLE_REMOVE_RESULT MU_C2(name, _remove_item)(MU_C2(name, _HANDLE) hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, const key_type* key, MU_C2(name, _ITEM)** item, int64_t* sequence_number) \
+{ \
+    /* marks the slot of the key deleted and retires the item, the slot is given back when the groups are rebuilt */ \
+    CLDS_HASH_TABLE_REMOVE_RESULT result; \
+    uint64_t hash = hash_fn(key); \
+    CLDS_OPEN_ADDRESSING_GROUP_ARRAY* group_array; \
+    bool done = false; \
+ \
+    MU_C2(name, _check_lock_and_begin_write_operation)(hash_table); \
+ \
+    /* the groups are not rebuilt while a write operation is pending */ \
+    group_array = hash_table->group_array; \
+ \
+    do \
+    { \
+        CLDS_OPEN_ADDRESSING_GROUP* group; \
+        uint32_t slot_index; \
+        void* slot_value; \
+        CLDS_HAZARD_POINTER_RECORD_HANDLE item_hp; \
+        bool group_array_replaced; \
+ \
+        if (MU_C2(name, _find_key_slot)(hash_table, group_array, clds_hazard_pointers_thread, hash, key, &group, &slot_index, &slot_value, &item_hp, &group_array_replaced) != 0) \
+        { \
+            LogError("find_key_slot failed"); \
+            result = CLDS_HASH_TABLE_REMOVE_ERROR; \
+            done = true; \
+        } \
+        else if (group == NULL) \
+        { \
+            result = CLDS_HASH_TABLE_REMOVE_NOT_FOUND; \
+            done = true; \
+        } \
+        else \
+        { \
+            MU_C2(name, _ITEM)* removed_item = slot_value; \
+ \
+            if (clds_open_addressing_group_change_slot(group, slot_index, removed_item, CLDS_OPEN_ADDRESSING_SLOT_DELETED)) \
+            { \
+                clds_open_addressing_group_increment_version(group); \
+ \
+                if (sequence_number != NULL) \
+                { \
+                    *sequence_number = interlocked_increment_64(hash_table->sequence_number); \
+                } \
+ \
+                if (item != NULL) \
+                { \
+                    *item = removed_item; \
+                    (void)interlocked_increment(&removed_item->ref_count); \
+                } \
+ \
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, item_hp); \
+ \
+                /* the reference of the table goes away once no reader protects the item anymore */ \
+                CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, removed_item, MU_C2(name, _reclaim_node)); \
+ \
+                result = CLDS_HASH_TABLE_REMOVE_OK; \
+                done = true; \
+            } \
+            else \
+            { \
+                /* another writer deleted the key first, look again */ \
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, item_hp); \
+            } \
+        } \
+    } while (!done); \
+ \
+    MU_C2(name, _end_write_operation)(hash_table); \
+ \
+    return result; \
+} \
+static CLDS_HASH_TABLE_INSERT_RESULT MU_C2(name, _insert_in_groups)(MU_C2(name, _HANDLE) hash_table, CLDS_OPEN_ADDRESSING_GROUP_ARRAY* group_array, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, MU_C2(name, _ITEM)* value, int32_t max_probe_count, int64_t* sequence_number, bool* no_free_slot) \
+{ \
+    /* must be called as a write operation, *no_free_slot is set when the first max_probe_count groups of the probe sequence have no free slot */ \
+    CLDS_HASH_TABLE_INSERT_RESULT result = CLDS_HASH_TABLE_INSERT_ERROR; \
+    uint8_t tag = clds_open_addressing_group_get_tag(value->hash); \
+    int32_t group_index = clds_open_addressing_group_get_first_group_index(group_array->group_count, value->hash); \
+    int32_t probe_count = 0; \
+    bool done = false; \
+ \
+    while (!done && (probe_count < max_probe_count)) \
+    { \
+        CLDS_OPEN_ADDRESSING_GROUP* group = &group_array->groups[group_index]; \
+        bool group_changed = false; \
+        CLDS_OPEN_ADDRESSING_CONTROL_BYTES control_bytes; \
+        uint32_t candidate_mask; \
+ \
+        clds_open_addressing_group_read_control_bytes(group, &control_bytes); \
+        candidate_mask = clds_open_addressing_group_match_control_byte(&control_bytes, tag) | clds_open_addressing_group_match_control_byte(&control_bytes, CLDS_OPEN_ADDRESSING_CONTROL_BYTE_EMPTY); \
+ \
+        while ((candidate_mask != 0) && !group_changed && !done) \
+        { \
+            uint32_t slot_index = clds_open_addressing_group_get_lowest_set_bit_index(candidate_mask); \
+            void* slot_value = clds_open_addressing_group_get_slot(group, slot_index); \
+ \
+            candidate_mask &= candidate_mask - 1; \
+ \
+            if (slot_value == NULL) \
+            { \
+                if (clds_open_addressing_group_change_slot(group, slot_index, NULL, value)) \
+                { \
+                    clds_open_addressing_group_set_control_byte(group, slot_index, tag); \
+                    clds_open_addressing_group_increment_version(group); \
+ \
+                    if (sequence_number != NULL) \
+                    { \
+                        *sequence_number = interlocked_increment_64(hash_table->sequence_number); \
+                    } \
+ \
+                    result = CLDS_HASH_TABLE_INSERT_OK; \
+                    done = true; \
+                } \
+                else \
+                { \
+                    /* another writer claimed the slot, read the group again */ \
+                    group_changed = true; \
+                } \
+            } \
+            else if (clds_open_addressing_group_is_slot_deleted(slot_value)) \
+            { \
+                /* the slot is given back when the groups are rebuilt */ \
+            } \
+            else \
+            { \
+                MU_C2(name, _ITEM)* item = slot_value; \
+                CLDS_HAZARD_POINTER_RECORD_HANDLE item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, item); \
+                if (item_hp == NULL) \
+                { \
+                    LogError("Cannot acquire hazard pointer"); \
+                    done = true; \
+                } \
+                else \
+                { \
+                    if (clds_open_addressing_group_get_slot(group, slot_index) != slot_value) \
+                    { \
+                        /* the item might have been retired before the hazard pointer was published */ \
+                        group_changed = true; \
+                    } \
+                    else if ( \
+                        (item->hash == value->hash) && \
+                        eq_fn(&item->key, &value->key) \
+                        ) \
+                    { \
+                        /* Codes_SRS_CLDS_TYPED_HASH_TABLE_01_016: [ If a slot holds an item whose key is equal to the key of value according to eq_fn, name_insert shall fail and return CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/ \
+                        result = CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS; \
+                        done = true; \
+                    } \
+                    else \
+                    { \
+                        /* the slot holds another key */ \
+                    } \
+ \
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, item_hp); \
+                } \
+            } \
+        } \
+ \
+        if (!done && !group_changed) \
+        { \
+            probe_count++; \
+            group_index = clds_open_addressing_group_get_next_group_index(group_array->group_count, group_index, probe_count); \
+        } \
+    } \
+ \
+    *no_free_slot = !done; \
+ \
+    return result; \
+} \
+static int MU_C2(name, _rebuild_groups)(MU_C2(name, _HANDLE) hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread) \
+{ \
+    /* gives the slots of the deleted items back and grows the groups when they are more than half full */ \
+    int result; \
+ \
+    if (interlocked_compare_exchange(&hash_table->locked_for_write, 1, 0) != 0) \
+    { \
+        /* another insert is rebuilding the groups, look again once it is done */ \
+        result = 0; \
+    } \
+    else \
+    { \
+        CLDS_OPEN_ADDRESSING_GROUP_ARRAY* old_group_array; \
+        int32_t group_count; \
+ \
+        MU_C2(name, _wait_for_write_operations)(hash_table); \
+ \
+        old_group_array = hash_table->group_array; \
+        group_count = clds_open_addressing_group_get_rebuild_group_count(clds_open_addressing_group_array_get_item_count(old_group_array) + 1, hash_table->initial_group_count); \
+        if (group_count == 0) \
+        { \
+            LogError("The table is full"); \
+            result = MU_FAILURE; \
+        } \
+        else \
+        { \
+            CLDS_OPEN_ADDRESSING_GROUP_ARRAY* new_group_array = malloc_flex(sizeof(CLDS_OPEN_ADDRESSING_GROUP_ARRAY), (size_t)group_count, sizeof(CLDS_OPEN_ADDRESSING_GROUP)); \
+            if (new_group_array == NULL) \
+            { \
+                LogError("malloc_flex(sizeof(CLDS_OPEN_ADDRESSING_GROUP_ARRAY)=%zu, (size_t)group_count=%zu, sizeof(CLDS_OPEN_ADDRESSING_GROUP)=%zu) failed", \
+                    sizeof(CLDS_OPEN_ADDRESSING_GROUP_ARRAY), (size_t)group_count, sizeof(CLDS_OPEN_ADDRESSING_GROUP)); \
+                result = MU_FAILURE; \
+            } \
+            else \
+            { \
+                int32_t i; \
+ \
+                new_group_array->group_count = group_count; \
+                CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(new_group_array); \
+                for (i = 0; i < group_count; i++) \
+                { \
+                    clds_open_addressing_group_init(&new_group_array->groups[i]); \
+                } \
+ \
+                for (i = 0; i < old_group_array->group_count; i++) \
+                { \
+                    uint32_t j; \
+ \
+                    for (j = 0; j < CLDS_OPEN_ADDRESSING_GROUP_SIZE; j++) \
+                    { \
+                        void* slot_value = clds_open_addressing_group_get_slot(&old_group_array->groups[i], j); \
+                        if (clds_open_addressing_group_is_slot_item(slot_value)) \
+                        { \
+                            MU_C2(name, _ITEM)* item = slot_value; \
+                            clds_open_addressing_group_array_place_item(new_group_array, item, item->hash); \
+                        } \
+                    } \
+                } \
+ \
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&hash_table->group_array, new_group_array); \
+ \
+                CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, old_group_array, MU_C2(name, _reclaim_group_array)); \
+ \
+                result = 0; \
+            } \
+        } \
+ \
+        (void)interlocked_exchange(&hash_table->locked_for_write, 0); \
+        wake_by_address_all(&hash_table->locked_for_write); \
+    } \
+ \
+    return result; \
+} \
+MU_C2(name, _HANDLE) MU_C2(name, _create)(size_t capacity, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* start_sequence_number) \
+{ \
+    MU_C2(name, _HANDLE) result; \
+ \
+ \
+    if ( \
+        (capacity == 0) || \
+        (capacity > CLDS_OPEN_ADDRESSING_MAX_CAPACITY) || \
+        (clds_hazard_pointers == NULL) \
+        ) \
+    { \
+        LogError("Invalid arguments: size_t capacity=%zu, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers=%p, volatile_atomic int64_t* start_sequence_number=%p", \
+            capacity, clds_hazard_pointers, start_sequence_number); \
+        result = NULL; \
+    } \
+    else \
+    { \
+        result = malloc(sizeof(struct MU_C2(name, _TAG))); \
+        if (result == NULL) \
+        { \
+            LogError("malloc(sizeof(table)=%zu) failed", sizeof(struct MU_C2(name, _TAG))); \
+        } \
+        else \
+        { \
+            int32_t group_count = clds_open_addressing_group_get_group_count(capacity); \
+            CLDS_OPEN_ADDRESSING_GROUP_ARRAY* group_array = malloc_flex(sizeof(CLDS_OPEN_ADDRESSING_GROUP_ARRAY), (size_t)group_count, sizeof(CLDS_OPEN_ADDRESSING_GROUP)); \
+            if (group_array == NULL) \
+            { \
+                LogError("malloc_flex(sizeof(CLDS_OPEN_ADDRESSING_GROUP_ARRAY)=%zu, (size_t)group_count=%zu, sizeof(CLDS_OPEN_ADDRESSING_GROUP)=%zu) failed", \
+                    sizeof(CLDS_OPEN_ADDRESSING_GROUP_ARRAY), (size_t)group_count, sizeof(CLDS_OPEN_ADDRESSING_GROUP)); \
+                free(result); \
+                result = NULL; \
+            } \
+            else \
+            { \
+                int32_t i; \
+ \
+                result->clds_hazard_pointers = clds_hazard_pointers; \
+                result->sequence_number = start_sequence_number; \
+                result->initial_group_count = group_count; \
+ \
+                group_array->group_count = group_count; \
+                CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(group_array); \
+                for (i = 0; i < group_count; i++) \
+                { \
+                    clds_open_addressing_group_init(&group_array->groups[i]); \
+                } \
+ \
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&result->group_array, group_array); \
+                (void)interlocked_exchange(&result->locked_for_write, 0); \
+                (void)interlocked_exchange(&result->pending_write_operations, 0); \
+            } \
+        } \
+    } \
+ \
+    return result; \
+} \
+void MU_C2(name, _destroy)(MU_C2(name, _HANDLE) hash_table) \
+{ \
+    if (hash_table == NULL) \
+    { \
+        LogError("Invalid arguments: hash_table=%p", (void*)hash_table); \
+    } \
+    else \
+    { \
+        CLDS_OPEN_ADDRESSING_GROUP_ARRAY* group_array = hash_table->group_array; \
+        int32_t i; \
+ \
+        for (i = 0; i < group_array->group_count; i++) \
+        { \
+            uint32_t j; \
+            CLDS_OPEN_ADDRESSING_GROUP* group = &group_array->groups[i]; \
+ \
+            for (j = 0; j < CLDS_OPEN_ADDRESSING_GROUP_SIZE; j++) \
+            { \
+                void* slot_value = clds_open_addressing_group_get_slot(group, j); \
+                if (clds_open_addressing_group_is_slot_item(slot_value)) \
+                { \
+                    MU_C2(name, _internal_node_destroy)(slot_value); \
+                } \
+            } \
+        } \
+ \
+        free(group_array); \
+        free(hash_table); \
+    } \
+} \
+CLDS_HASH_TABLE_INSERT_RESULT MU_C2(name, _insert)(MU_C2(name, _HANDLE) hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, MU_C2(name, _ITEM)* value, int64_t* sequence_number) \
+{ \
+    CLDS_HASH_TABLE_INSERT_RESULT result; \
+ \
+    if ( \
+        /* Codes_SRS_CLDS_TYPED_HASH_TABLE_01_011: [ If hash_table, clds_hazard_pointers_thread or value is NULL, name_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/ \
+        (hash_table == NULL) || \
+        (clds_hazard_pointers_thread == NULL) || \
+        (value == NULL) || \
+        ((sequence_number != NULL) && (hash_table->sequence_number == NULL)) \
+        ) \
+    { \
+        LogError("Invalid arguments: hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, value=%p, int64_t* sequence_number=%p", \
+            (void*)hash_table, clds_hazard_pointers_thread, (void*)value, sequence_number); \
+        result = CLDS_HASH_TABLE_INSERT_ERROR; \
+    } \
+    else \
+    { \
+        bool groups_rebuilt = false; \
+        bool done = false; \
+ \
+        /* Codes_SRS_CLDS_TYPED_HASH_TABLE_01_013: [ name_insert shall hash the key stored in value by calling hash_fn. ]*/ \
+        value->hash = hash_fn(&value->key); \
+ \
+        do \
+        { \
+            CLDS_OPEN_ADDRESSING_GROUP_ARRAY* group_array; \
+            int32_t max_probe_count; \
+            bool no_free_slot; \
+ \
+            MU_C2(name, _check_lock_and_begin_write_operation)(hash_table); \
+ \
+            group_array = hash_table->group_array; \
+            max_probe_count = (groups_rebuilt || (group_array->group_count < CLDS_OPEN_ADDRESSING_MAX_PROBE_COUNT)) ? group_array->group_count : CLDS_OPEN_ADDRESSING_MAX_PROBE_COUNT; \
+ \
+            result = MU_C2(name, _insert_in_groups)(hash_table, group_array, clds_hazard_pointers_thread, value, max_probe_count, sequence_number, &no_free_slot); \
+ \
+            MU_C2(name, _end_write_operation)(hash_table); \
+ \
+            if (!no_free_slot) \
+            { \
+                done = true; \
+            } \
+            else if (MU_C2(name, _rebuild_groups)(hash_table, clds_hazard_pointers_thread) != 0) \
+            { \
+                LogError("rebuild_groups failed"); \
+                result = CLDS_HASH_TABLE_INSERT_ERROR; \
+                done = true; \
+            } \
+            else \
+            { \
+                groups_rebuilt = true; \
+            } \
+        } while (!done); \
+    } \
+ \
+    return result; \
+} \
+CLDS_HASH_TABLE_DELETE_RESULT MU_C2(name, _delete)(MU_C2(name, _HANDLE) hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, const key_type* key, int64_t* sequence_number) \
+{ \
+    CLDS_HASH_TABLE_DELETE_RESULT result; \
+ \
+    if ( \
+        (hash_table == NULL) || \
+        (clds_hazard_pointers_thread == NULL) || \
+        (key == NULL) || \
+        ((sequence_number != NULL) && (hash_table->sequence_number == NULL)) \
+        ) \
+    { \
+        LogError("Invalid arguments: hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, key=%p, int64_t* sequence_number=%p", \
+            (void*)hash_table, clds_hazard_pointers_thread, (const void*)key, sequence_number); \
+        result = CLDS_HASH_TABLE_DELETE_ERROR; \
+    } \
+    else \
+    { \
+        /* Codes_SRS_CLDS_TYPED_HASH_TABLE_01_021: [ name_delete shall hash the key with hash_fn, look for it with eq_fn in the groups of its probe sequence like name_find, mark the slot of the key deleted with a compare exchange, retire the item through hazard pointers and return CLDS_HASH_TABLE_DELETE_OK. ]*/ \
+        switch (MU_C2(name, _remove_item)(hash_table, clds_hazard_pointers_thread, key, NULL, sequence_number)) \
+        { \
+        case CLDS_HASH_TABLE_REMOVE_OK: \
+            result = CLDS_HASH_TABLE_DELETE_OK; \
+            break; \
+        case CLDS_HASH_TABLE_REMOVE_NOT_FOUND: \
+            result = CLDS_HASH_TABLE_DELETE_NOT_FOUND; \
+            break; \
+        default: \
+            result = CLDS_HASH_TABLE_DELETE_ERROR; \
+            break; \
+        } \
+    } \
+ \
+    return result; \
+} \
+CLDS_HASH_TABLE_REMOVE_RESULT MU_C2(name, _remove)(MU_C2(name, _HANDLE) hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, const key_type* key, MU_C2(name, _ITEM)** item, int64_t* sequence_number) \
+{ \
+    CLDS_HASH_TABLE_REMOVE_RESULT result; \
+ \
+    if ( \
+        (hash_table == NULL) || \
+        (clds_hazard_pointers_thread == NULL) || \
+        (key == NULL) || \
+        (item == NULL) || \
+        ((sequence_number != NULL) && (hash_table->sequence_number == NULL)) \
+        ) \
+    { \
+        LogError("Invalid arguments: hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, key=%p, item=%p, int64_t* sequence_number=%p", \
+            (void*)hash_table, clds_hazard_pointers_thread, (const void*)key, (void*)item, sequence_number); \
+        result = CLDS_HASH_TABLE_REMOVE_ERROR; \
+    } \
+    else \
+    { \
+        result = MU_C2(name, _remove_item)(hash_table, clds_hazard_pointers_thread, key, item, sequence_number); \
+    } \
+ \
+    return result; \
+} \
+MU_C2(name, _ITEM)* MU_C2(name, _find)(MU_C2(name, _HANDLE) hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, const key_type* key) \
+{ \
+    MU_C2(name, _ITEM)* result; \
+ \
+    if ( \
+        (hash_table == NULL) || \
+        (clds_hazard_pointers_thread == NULL) || \
+        (key == NULL) \
+        ) \
+    { \
+        LogError("Invalid arguments: hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, key=%p", \
+            (void*)hash_table, clds_hazard_pointers_thread, (const void*)key); \
+        result = NULL; \
+    } \
+    else \
+    { \
+        uint64_t hash = hash_fn(key); \
+        bool done = false; \
+ \
+        do \
+        { \
+            CLDS_OPEN_ADDRESSING_GROUP_ARRAY* group_array; \
+            CLDS_HAZARD_POINTER_RECORD_HANDLE group_array_hp = MU_C2(name, _acquire_group_array)(hash_table, clds_hazard_pointers_thread, &group_array); \
+            if (group_array_hp == NULL) \
+            { \
+                LogError("acquire_group_array failed"); \
+                result = NULL; \
+                done = true; \
+            } \
+            else \
+            { \
+                CLDS_OPEN_ADDRESSING_GROUP* group; \
+                uint32_t slot_index; \
+                void* slot_value; \
+                CLDS_HAZARD_POINTER_RECORD_HANDLE item_hp; \
+                bool group_array_replaced; \
+ \
+                if (MU_C2(name, _find_key_slot)(hash_table, group_array, clds_hazard_pointers_thread, hash, key, &group, &slot_index, &slot_value, &item_hp, &group_array_replaced) != 0) \
+                { \
+                    LogError("find_key_slot failed"); \
+                    result = NULL; \
+                    done = true; \
+                } \
+                else if (group_array_replaced) \
+                { \
+                    /* look again in the new group array */ \
+                } \
+                else if (group == NULL) \
+                { \
+                    result = NULL; \
+                    done = true; \
+                } \
+                else \
+                { \
+                    result = slot_value; \
+                    (void)interlocked_increment(&result->ref_count); \
+ \
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, item_hp); \
+                    done = true; \
+                } \
+ \
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, group_array_hp); \
+            } \
+        } while (!done); \
+    } \
+ \
+    return result; \
+} \
+
+#endif /* CLDS_TYPED_HASH_TABLE_H */
@@ -3,12 +3,16 @@
 #include <stdlib.h>
 #include <inttypes.h>
 #include <stdbool.h>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
 
 #include "c_logging/logger.h"
 
 #include "c_pal/gballoc_hl.h"
 #include "c_pal/gballoc_hl_redirect.h"
 #include "c_pal/sync.h"
+#include "c_pal/threadapi.h"
 #include "c_pal/interlocked.h"
 
 #include "clds/clds_sorted_list.h"
@@ -23,29 +27,141 @@ MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_RES
 MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_RESULT_VALUES);
 MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_RESULT_VALUES);
 MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_RESULT_VALUES);
+MU_DEFINE_ENUM_STRINGS(CLDS_HASH_TABLE_BUCKET_INDEXING, CLDS_HASH_TABLE_BUCKET_INDEXING_VALUES);
+
+// number of buckets migrated out of the oldest bucket array by each write operation, unless changed with clds_hash_table_set_migration_bucket_count
+#define DEFAULT_WRITE_MIGRATION_BUCKET_COUNT 4
+// bucket counts are int32_t, the biggest power of two that fits
+#define MAX_POWER_OF_TWO_BUCKET_COUNT ((size_t)1 << 30)
+
+// the item and pending insert counters of a bucket array are split in stripes, each in its own cache line, so that the writers
+// running on different cores do not keep taking the same line away from each other
+#define COUNTER_STRIPE_COUNT 16
+#define CACHE_LINE_SIZE 64
+// a write past its share of the buckets sums the stripes when its stripe crosses the share and then every this many items in its stripe,
+// in between it only reads the sum kept in the bucket array
+#define ITEM_COUNT_ESTIMATE_REFRESH_COUNT 16
+// the moves of the items between bucket arrays are counted in stripes by the hash of the key, so that a lookup that misses
+// only looks again when an item with a hash in its stripe was moved meanwhile
+#define ITEM_MOVE_STRIPE_COUNT 64
+// how many times a write checks the pending inserts of an older bucket array before it blocks until they complete
+#define PENDING_INSERTS_SPIN_COUNT 64
+// clds_hash_table_find_batch prefetches the buckets and then the first items of this many keys before it compares any of them
+#define FIND_BATCH_GROUP_SIZE 16
+// clds_hash_table_insert_batch splits the buckets of each thread in this many ranges and inserts the items of a range one after the other,
+// so that the buckets written one after the other are close to each other
+#define INSERT_BATCH_PARTITIONS_PER_THREAD 256
+// the items of a batch are inserted in write operations of this many items, so that a batch does not hold back the write lock or a snapshot until it completes
+#define INSERT_BATCH_CHUNK_SIZE 256
+// the states of a snapshot at a sequence number, the writes only keep the items they take out of the table while one is in progress,
+// and a completing snapshot waits for the writes that still keep items before it releases them
+#define SEQUENCE_NUMBER_SNAPSHOT_NONE 0
+#define SEQUENCE_NUMBER_SNAPSHOT_IN_PROGRESS 1
+#define SEQUENCE_NUMBER_SNAPSHOT_COMPLETING 2
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define PREFETCH_FOR_READ(address) _mm_prefetch((const char*)(address), _MM_HINT_T0)
+#elif defined(__GNUC__) || defined(__clang__)
+#define PREFETCH_FOR_READ(address) __builtin_prefetch((address), 0, 3)
+#else
+#define PREFETCH_FOR_READ(address) ((void)(address))
+#endif
+
+// tells the core that the thread spins, so that it does not flood the memory pipeline with the reads of the spin
+// and gives its execution resources to the other hardware thread of the core
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define CPU_PAUSE() _mm_pause()
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define CPU_PAUSE() __builtin_ia32_pause()
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+#define CPU_PAUSE() __asm__ __volatile__("yield")
+#else
+#define CPU_PAUSE() ((void)0)
+#endif
+
+typedef struct COUNTER_STRIPE_TAG
+{
+    // the items of a bucket array are the sum of the item counts of all the stripes, a stripe alone can be negative (an item inserted by a thread and deleted by another)
+    volatile_atomic int32_t item_count;
+    // a thread increments and decrements the pending inserts in the same stripe, so these never go below 0
+    volatile_atomic int32_t pending_insert_count;
+    unsigned char padding[CACHE_LINE_SIZE - 2 * sizeof(int32_t)];
+} COUNTER_STRIPE;
+
+typedef struct ITEM_MOVE_STRIPE_TAG
+{
+    volatile_atomic int64_t completed_item_moves;
+    volatile_atomic int32_t pending_item_moves;
+    unsigned char padding[CACHE_LINE_SIZE - sizeof(int64_t) - sizeof(int32_t)];
+} ITEM_MOVE_STRIPE;
 
 typedef struct BUCKET_ARRAY_TAG
 {
     struct BUCKET_ARRAY_TAG* volatile_atomic next_bucket;
     volatile_atomic int32_t bucket_count;
-    volatile_atomic int32_t item_count;
-    volatile_atomic int32_t pending_insert_count;
-    CLDS_SORTED_LIST_HANDLE volatile_atomic hash_table[];
+    COUNTER_STRIPE counter_stripes[COUNTER_STRIPE_COUNT];
+    // the last sum of the stripes, each stripe can be ahead of it by less than ITEM_COUNT_ESTIMATE_REFRESH_COUNT items
+    volatile_atomic int32_t item_count_estimate;
+    // writes blocked until the inserts in flight in this array complete, only written once the array is not the first one anymore
+    volatile_atomic int32_t pending_insert_waiters;
+    // migration of the items to the first bucket array, once this array is not the first one anymore
+    volatile_atomic int32_t migration_cursor;
+    volatile_atomic int32_t migrated_bucket_count;
+    volatile_atomic int32_t migration_failed;
+    // the heads of the bucket lists are stored inline, an empty bucket costs one pointer and creating a bucket allocates nothing
+    CLDS_SORTED_LIST_HEAD hash_table[];
 } BUCKET_ARRAY;
 
+// a removal of an item that is already kept for the snapshot (the item was inserted again and taken out again while the same snapshot is taken)
+typedef struct SUPERSEDED_ITEM_RECORD_TAG
+{
+    struct SUPERSEDED_ITEM_RECORD_TAG* next;
+    CLDS_HASH_TABLE_ITEM* item;
+    int64_t insert_sequence_number;
+    int64_t remove_sequence_number;
+} SUPERSEDED_ITEM_RECORD;
+
 typedef struct CLDS_HASH_TABLE_TAG
 {
     COMPUTE_HASH_FUNC compute_hash;
     KEY_COMPARE_FUNC key_compare_func;
+    // with power of two bucket counts the bucket index is a mask of the (mixed) hash instead of a 64 bit division
+    bool use_bucket_mask;
     BUCKET_ARRAY* volatile_atomic first_hash_table;
     CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
+    // the list that all the bucket heads are used with, it holds the callbacks, the sequence number and the write lock shared by the buckets
+    CLDS_SORTED_LIST_HANDLE bucket_lists;
     volatile_atomic int64_t* sequence_number;
     HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb;
     void* skipped_seq_no_cb_context;
 
     // Support for locking the list for writes
     volatile_atomic int32_t locked_for_write;
-    volatile_atomic int32_t pending_write_operations;
+    // the writes are counted in the slot of the write epoch they started in, so that a snapshot at a sequence number can wait for the writes
+    // that started before a point without stopping the ones that start after it
+    volatile_atomic int32_t write_epoch;
+    volatile_atomic int32_t pending_write_operations[2];
+    // only one waiter moves the write epoch at a time, otherwise a waiter could skip the slot that another waiter is still draining
+    volatile_atomic int32_t write_epoch_change_in_progress;
+
+    // Support for snapshots at a sequence number, the writes keep the items they take out of the table while one is taken
+    // (linked through the items themselves, the later removals of an item that is already kept get a record of their own)
+    volatile_atomic int32_t sequence_number_snapshot_in_progress;
+    CLDS_HASH_TABLE_ITEM* volatile_atomic superseded_items;
+    SUPERSEDED_ITEM_RECORD* volatile_atomic superseded_item_records;
+    volatile_atomic int32_t superseded_items_lost;
+
+    // Support for cursors, no items are migrated (and no bucket array is retired) while a cursor is open
+    volatile_atomic int32_t open_cursor_count;
+
+    // Support for migrating the items out of the older bucket arrays
+    volatile_atomic int32_t write_migration_bucket_count;
+    volatile_atomic int32_t read_migration_bucket_count;
+    volatile_atomic int32_t bucket_array_count;
+    // clds_hash_table_shrink does not go below the bucket count the table was created with
+    int32_t initial_bucket_count;
+    // an item being moved is in neither of the arrays for a short while, lookups that miss while an item of their stripe is moved retry
+    ITEM_MOVE_STRIPE item_move_stripes[ITEM_MOVE_STRIPE_COUNT];
 } CLDS_HASH_TABLE;
 
 typedef struct FIND_BY_KEY_VALUE_CONTEXT_TAG
@@ -55,48 +171,176 @@ typedef struct FIND_BY_KEY_VALUE_CONTEXT_TAG
     KEY_COMPARE_FUNC key_compare_func;
 } FIND_BY_KEY_VALUE_CONTEXT;
 
-static void check_lock_and_begin_write_operation(CLDS_HASH_TABLE_HANDLE clds_hash_table)
+typedef struct CONDITION_CHECK_CONTEXT_TAG
+{
+    CONDITION_CHECK_CB condition_check_func;
+    void* condition_check_context;
+} CONDITION_CHECK_CONTEXT;
+
+typedef struct GET_OR_INSERT_FACTORY_CONTEXT_TAG
+{
+    HASH_TABLE_ITEM_FACTORY_CB item_factory;
+    void* item_factory_context;
+    HASH_TABLE_HASHED_KEY* hashed_key;
+    bool snapshot_in_progress;
+} GET_OR_INSERT_FACTORY_CONTEXT;
+
+typedef struct INSERT_BATCH_CONTEXT_TAG
+{
+    CLDS_HASH_TABLE* clds_hash_table;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
+    CLDS_HASH_TABLE_ITEM** items;
+    CLDS_HASH_TABLE_INSERT_RESULT* results;
+    int64_t* sequence_numbers;
+    // the indices of the items to insert, grouped by the range of buckets they fall in
+    uint32_t* item_indices;
+    uint32_t item_index_count;
+    bool failed;
+    // set only when the items are inserted by a thread created for the batch
+    bool has_own_thread;
+    bool own_hazard_pointers_thread;
+    THREAD_HANDLE thread_handle;
+} INSERT_BATCH_CONTEXT;
+
+typedef struct CLDS_HASH_TABLE_CURSOR_TAG
+{
+    CLDS_HASH_TABLE_HANDLE clds_hash_table;
+    // the bucket array and the bucket being walked, bucket_array is NULL once all the arrays were walked
+    BUCKET_ARRAY* bucket_array;
+    int32_t bucket_index;
+    // the last item returned out of the bucket (with a reference that keeps its key alive), the walk of the bucket continues after its key
+    CLDS_SORTED_LIST_ITEM* last_item;
+} CLDS_HASH_TABLE_CURSOR;
+
+static uint64_t hash_key(CLDS_HASH_TABLE_HANDLE clds_hash_table, void* key)
+{
+    uint64_t hash = clds_hash_table->compute_hash(key);
+
+    if (clds_hash_table->use_bucket_mask)
+    {
+        // the mask only keeps the low bits of the hash, so the hash is mixed (murmur3 64 bit finalizer) to have all its bits count,
+        // otherwise a hash that only varies in the high bits (like aligned pointers shifted left) would put all keys in a few buckets
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        hash ^= hash >> 33;
+    }
+
+    return hash;
+}
+
+static uint64_t get_bucket_index(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint64_t hash, int32_t bucket_count)
+{
+    uint64_t result;
+
+    if (clds_hash_table->use_bucket_mask)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_132: [ If bucket_indexing is CLDS_HASH_TABLE_BUCKET_INDEXING_POWER_OF_TWO, the bucket index shall be the hash masked with the bucket count minus 1. ]*/
+        result = hash & (uint64_t)(bucket_count - 1);
+    }
+    else
+    {
+        result = hash % bucket_count;
+    }
+
+    return result;
+}
+
+static uint32_t check_lock_and_begin_write_operation(CLDS_HASH_TABLE_HANDLE clds_hash_table)
 {
-    int32_t locked_for_write;
+    uint32_t write_slot;
+    bool write_started = false;
     do
     {
-        (void)interlocked_increment(&clds_hash_table->pending_write_operations);
-        locked_for_write = interlocked_add(&clds_hash_table->locked_for_write, 0);
+        int32_t write_epoch = interlocked_add(&clds_hash_table->write_epoch, 0);
+        write_slot = (uint32_t)write_epoch & 1;
+        (void)interlocked_increment(&clds_hash_table->pending_write_operations[write_slot]);
+        int32_t locked_for_write = interlocked_add(&clds_hash_table->locked_for_write, 0);
         if (locked_for_write != 0)
         {
-            (void)interlocked_decrement(&clds_hash_table->pending_write_operations);
-            wake_by_address_all(&clds_hash_table->pending_write_operations);
+            (void)interlocked_decrement(&clds_hash_table->pending_write_operations[write_slot]);
+            wake_by_address_all(&clds_hash_table->pending_write_operations[write_slot]);
 
             // Wait for unlock
             (void)wait_on_address(&clds_hash_table->locked_for_write, locked_for_write, UINT32_MAX);
         }
-    } while (locked_for_write != 0);
+        else if (interlocked_add(&clds_hash_table->write_epoch, 0) != write_epoch)
+        {
+            // a snapshot at a sequence number moved to the next epoch while the write was counted, count it in the new one
+            (void)interlocked_decrement(&clds_hash_table->pending_write_operations[write_slot]);
+            wake_by_address_all(&clds_hash_table->pending_write_operations[write_slot]);
+        }
+        else
+        {
+            write_started = true;
+        }
+    } while (!write_started);
+
+    return write_slot;
 }
 
-static void end_write_operation(CLDS_HASH_TABLE_HANDLE clds_hash_table)
+static void end_write_operation(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint32_t write_slot)
 {
-    (void)interlocked_decrement(&clds_hash_table->pending_write_operations);
-    wake_by_address_all(&clds_hash_table->pending_write_operations);
+    (void)interlocked_decrement(&clds_hash_table->pending_write_operations[write_slot]);
+    wake_by_address_all(&clds_hash_table->pending_write_operations[write_slot]);
 }
 
-static void internal_lock_writes(CLDS_HASH_TABLE_HANDLE clds_hash_table)
+static bool try_begin_write_operation(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint32_t* write_slot)
 {
-    /*Codes_SRS_CLDS_HASH_TABLE_42_017: [ clds_hash_table_snapshot shall increment a counter to lock the table for writes. ]*/
-    (void)interlocked_increment(&clds_hash_table->locked_for_write);
+    bool result;
 
-    /*Codes_SRS_CLDS_HASH_TABLE_42_018: [ clds_hash_table_snapshot shall wait for the ongoing write operations to complete. ]*/
+    do
+    {
+        int32_t write_epoch = interlocked_add(&clds_hash_table->write_epoch, 0);
+        *write_slot = (uint32_t)write_epoch & 1;
+        (void)interlocked_increment(&clds_hash_table->pending_write_operations[*write_slot]);
+        if (interlocked_add(&clds_hash_table->locked_for_write, 0) != 0)
+        {
+            (void)interlocked_decrement(&clds_hash_table->pending_write_operations[*write_slot]);
+            wake_by_address_all(&clds_hash_table->pending_write_operations[*write_slot]);
+            result = false;
+            break;
+        }
+        else if (interlocked_add(&clds_hash_table->write_epoch, 0) != write_epoch)
+        {
+            (void)interlocked_decrement(&clds_hash_table->pending_write_operations[*write_slot]);
+            wake_by_address_all(&clds_hash_table->pending_write_operations[*write_slot]);
+        }
+        else
+        {
+            result = true;
+            break;
+        }
+    } while (1);
+
+    return result;
+}
+
+static void wait_for_write_slot(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint32_t write_slot)
+{
     int32_t pending_writes;
     do
     {
-        pending_writes = interlocked_add(&clds_hash_table->pending_write_operations, 0);
+        pending_writes = interlocked_add(&clds_hash_table->pending_write_operations[write_slot], 0);
         if (pending_writes != 0)
         {
             // Wait for writes
-            (void)wait_on_address(&clds_hash_table->pending_write_operations, pending_writes, UINT32_MAX);
+            (void)wait_on_address(&clds_hash_table->pending_write_operations[write_slot], pending_writes, UINT32_MAX);
         }
     } while (pending_writes != 0);
 }
 
+static void internal_lock_writes(CLDS_HASH_TABLE_HANDLE clds_hash_table)
+{
+    /*Codes_SRS_CLDS_HASH_TABLE_42_017: [ clds_hash_table_snapshot shall increment a counter to lock the table for writes. ]*/
+    (void)interlocked_increment(&clds_hash_table->locked_for_write);
+
+    /*Codes_SRS_CLDS_HASH_TABLE_42_018: [ clds_hash_table_snapshot shall wait for the ongoing write operations to complete. ]*/
+    wait_for_write_slot(clds_hash_table, 0);
+    wait_for_write_slot(clds_hash_table, 1);
+}
+
 static void internal_unlock_writes(CLDS_HASH_TABLE_HANDLE clds_hash_table)
 {
     /*Codes_SRS_CLDS_HASH_TABLE_42_030: [ clds_hash_table_snapshot shall decrement the counter to unlock the table for writes. ]*/
@@ -104,17 +348,170 @@ static void internal_unlock_writes(CLDS_HASH_TABLE_HANDLE clds_hash_table)
     wake_by_address_all(&clds_hash_table->locked_for_write);
 }
 
+static void wait_for_writes_of_current_epoch(CLDS_HASH_TABLE_HANDLE clds_hash_table)
+{
+    while (interlocked_compare_exchange(&clds_hash_table->write_epoch_change_in_progress, 1, 0) != 0)
+    {
+        (void)wait_on_address(&clds_hash_table->write_epoch_change_in_progress, 1, UINT32_MAX);
+    }
+
+    // the writes that start from now on are counted in the other slot, so the wait only has to outlast the writes already started
+    int32_t write_epoch = interlocked_increment(&clds_hash_table->write_epoch) - 1;
+    wait_for_write_slot(clds_hash_table, (uint32_t)write_epoch & 1);
+
+    (void)interlocked_exchange(&clds_hash_table->write_epoch_change_in_progress, 0);
+    wake_by_address_all(&clds_hash_table->write_epoch_change_in_progress);
+}
+
+static bool is_sequence_number_snapshot_in_progress(CLDS_HASH_TABLE_HANDLE clds_hash_table)
+{
+    return interlocked_add(&clds_hash_table->sequence_number_snapshot_in_progress, 0) == SEQUENCE_NUMBER_SNAPSHOT_IN_PROGRESS;
+}
+
+static int64_t* get_write_sequence_number(bool snapshot_in_progress, int64_t* sequence_number, int64_t* local_sequence_number)
+{
+    // the items taken out of the table while a snapshot at a sequence number is taken are kept with the sequence number of the write,
+    // which is computed even if the user did not ask for it (a snapshot is only taken on tables that have sequence numbers)
+    return ((snapshot_in_progress) && (sequence_number == NULL)) ? local_sequence_number : sequence_number;
+}
+
+static void keep_superseded_item(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_SORTED_LIST_ITEM* item, int64_t remove_sequence_number)
+{
+    /* Codes_SRS_CLDS_HASH_TABLE_01_150: [ While a snapshot at a sequence number is taken, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove and clds_hash_table_set_value shall keep a reference to each item they take out of the table, together with the sequence numbers of its insert and of its removal, until the snapshot completes. ]*/
+    HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
+
+    if (interlocked_compare_exchange(&hash_table_item->is_superseded, 1, 0) != 0)
+    {
+        // the item was inserted again and taken out again while the same snapshot is taken, its link already holds an earlier removal
+        SUPERSEDED_ITEM_RECORD* superseded_item_record = malloc(sizeof(SUPERSEDED_ITEM_RECORD));
+        if (superseded_item_record == NULL)
+        {
+            LogError("malloc(sizeof(SUPERSEDED_ITEM_RECORD)=%zu) failed, item=%p cannot be kept for the snapshot", sizeof(SUPERSEDED_ITEM_RECORD), item);
+            (void)interlocked_exchange(&clds_hash_table->superseded_items_lost, 1);
+        }
+        else
+        {
+            (void)clds_sorted_list_node_inc_ref(item);
+
+            superseded_item_record->item = (CLDS_HASH_TABLE_ITEM*)item;
+            superseded_item_record->insert_sequence_number = interlocked_add_64(&hash_table_item->insert_sequence_number, 0);
+            superseded_item_record->remove_sequence_number = remove_sequence_number;
+
+            SUPERSEDED_ITEM_RECORD* current_superseded_item_records;
+            do
+            {
+                current_superseded_item_records = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->superseded_item_records, NULL, NULL);
+                superseded_item_record->next = current_superseded_item_records;
+            } while (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->superseded_item_records, superseded_item_record, current_superseded_item_records) != current_superseded_item_records);
+        }
+    }
+    else
+    {
+        (void)clds_sorted_list_node_inc_ref(item);
+
+        // the insert sequence number of the item changes if the item is inserted again
+        hash_table_item->superseded_insert_sequence_number = interlocked_add_64(&hash_table_item->insert_sequence_number, 0);
+        hash_table_item->superseded_remove_sequence_number = remove_sequence_number;
+
+        CLDS_HASH_TABLE_ITEM* current_superseded_items;
+        do
+        {
+            current_superseded_items = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->superseded_items, NULL, NULL);
+            hash_table_item->next_superseded_item = current_superseded_items;
+        } while (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->superseded_items, item, current_superseded_items) != current_superseded_items);
+    }
+}
+
+static void release_superseded_items(CLDS_HASH_TABLE_ITEM* superseded_items)
+{
+    while (superseded_items != NULL)
+    {
+        HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, superseded_items);
+        CLDS_HASH_TABLE_ITEM* next_superseded_item = hash_table_item->next_superseded_item;
+
+        // the item can be kept again by the next snapshot
+        hash_table_item->next_superseded_item = NULL;
+        (void)interlocked_exchange(&hash_table_item->is_superseded, 0);
+
+        clds_sorted_list_node_release((void*)superseded_items);
+        superseded_items = next_superseded_item;
+    }
+}
+
+static void release_superseded_item_records(SUPERSEDED_ITEM_RECORD* superseded_item_records)
+{
+    while (superseded_item_records != NULL)
+    {
+        SUPERSEDED_ITEM_RECORD* next_superseded_item_record = superseded_item_records->next;
+
+        clds_sorted_list_node_release((void*)superseded_item_records->item);
+        free(superseded_item_records);
+        superseded_item_records = next_superseded_item_record;
+    }
+}
+
 static void* get_item_key_cb(void* context, CLDS_SORTED_LIST_ITEM* item)
 {
     HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
     (void)context;
-    return hash_table_item->key;
+    return &hash_table_item->hashed_key;
 }
 
 static int key_compare_cb(void* context, void* key1, void* key2)
 {
     CLDS_HASH_TABLE_HANDLE clds_hash_table = context;
-    return clds_hash_table->key_compare_func(key1, key2);
+    HASH_TABLE_HASHED_KEY* hashed_key_1 = key1;
+    HASH_TABLE_HASHED_KEY* hashed_key_2 = key2;
+    int result;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_125: [ The items of a bucket shall be ordered by the hash of their key and then by their key. ]*/
+    if (hashed_key_1->hash < hashed_key_2->hash)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_126: [ If the hashes of the keys are different, the key_compare_func passed to clds_hash_table_create shall not be called. ]*/
+        result = -1;
+    }
+    else if (hashed_key_1->hash > hashed_key_2->hash)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_126: [ If the hashes of the keys are different, the key_compare_func passed to clds_hash_table_create shall not be called. ]*/
+        result = 1;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_127: [ If the hashes of the keys are equal, the keys shall be compared by calling the key_compare_func passed to clds_hash_table_create. ]*/
+        result = clds_hash_table->key_compare_func(hashed_key_1->key, hashed_key_2->key);
+    }
+
+    return result;
+}
+
+static CLDS_CONDITION_CHECK_RESULT on_sorted_list_condition_check(void* context, void* new_key, void* old_key)
+{
+    CONDITION_CHECK_CONTEXT* condition_check_context = context;
+    HASH_TABLE_HASHED_KEY* new_hashed_key = new_key;
+    HASH_TABLE_HASHED_KEY* old_hashed_key = old_key;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_128: [ The condition_check_func passed to clds_hash_table_set_value shall be called with the keys of the items, not with their hashed keys. ]*/
+    return condition_check_context->condition_check_func(condition_check_context->condition_check_context, new_hashed_key->key, old_hashed_key->key);
+}
+
+static CLDS_SORTED_LIST_ITEM* on_sorted_list_item_factory(void* context)
+{
+    GET_OR_INSERT_FACTORY_CONTEXT* factory_context = context;
+    void* item_key = NULL;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_193: [ item_factory shall be called with item_factory_context and key only when key is not in the table. ]*/
+    CLDS_HASH_TABLE_ITEM* item = factory_context->item_factory(factory_context->item_factory_context, factory_context->hashed_key->key, &item_key);
+    if (item != NULL)
+    {
+        HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_194: [ clds_hash_table_get_or_insert shall store in the created item the hash of the key and the key set by item_factory in item_key, or key if item_factory leaves item_key NULL. ]*/
+        hash_table_item->hashed_key.hash = factory_context->hashed_key->hash;
+        hash_table_item->hashed_key.key = (item_key == NULL) ? factory_context->hashed_key->key : item_key;
+        (void)interlocked_exchange_64(&hash_table_item->insert_sequence_number, factory_context->snapshot_in_progress ? INT64_MAX : INT64_MIN);
+    }
+
+    return (CLDS_SORTED_LIST_ITEM*)item;
 }
 
 static void on_sorted_list_skipped_seq_no(void* context, int64_t skipped_sequence_no)
@@ -133,1189 +530,3454 @@ static void on_sorted_list_skipped_seq_no(void* context, int64_t skipped_sequenc
     }
 }
 
-static BUCKET_ARRAY* get_first_bucket_array(CLDS_HASH_TABLE* clds_hash_table)
+static void reclaim_bucket_array(void* node)
 {
-    // always insert in the first bucket array
-    BUCKET_ARRAY* first_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
-    int32_t bucket_count = interlocked_add(&first_bucket_array->bucket_count, 0);
-    while (interlocked_add(&first_bucket_array->item_count, 0) >= bucket_count)
+    // all the items were migrated out of the array, only the empty heads are left
+    free(node);
+}
+
+static COUNTER_STRIPE* get_counter_stripe(BUCKET_ARRAY* bucket_array, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    // the thread handle does not change for the lifetime of the thread, so a thread always updates the same stripe
+    uint64_t stripe_hash = (uint64_t)(uintptr_t)clds_hazard_pointers_thread * 0x9E3779B97F4A7C15;
+    return &bucket_array->counter_stripes[(stripe_hash >> 32) & (COUNTER_STRIPE_COUNT - 1)];
+}
+
+static void init_counter_stripes(BUCKET_ARRAY* bucket_array)
+{
+    for (uint32_t i = 0; i < COUNTER_STRIPE_COUNT; i++)
     {
-        // allocate a new bucket array
-        BUCKET_ARRAY* new_bucket_array = malloc_flex(sizeof(BUCKET_ARRAY), bucket_count, sizeof(CLDS_SORTED_LIST_HANDLE) * 2);
-        if (new_bucket_array == NULL)
-        {
-            // cannot allocate new bucket, will stick to what we have, but do not fail
-            break;
-        }
-        else
-        {
-            // insert new bucket
-            /* Codes_SRS_CLDS_HASH_TABLE_01_030: [ If the number of items in the list reaches the number of buckets, the number of buckets shall be doubled. ]*/
-            bucket_count = bucket_count * 2;
-            (void)interlocked_exchange(&new_bucket_array->bucket_count, bucket_count);
-            (void)interlocked_exchange(&new_bucket_array->item_count, 0);
-            (void)interlocked_exchange(&new_bucket_array->pending_insert_count, 0);
+        (void)interlocked_exchange(&bucket_array->counter_stripes[i].item_count, 0);
+        (void)interlocked_exchange(&bucket_array->counter_stripes[i].pending_insert_count, 0);
+    }
 
-            // initialize buckets
-            for (int32_t i = 0; i < bucket_count; i++)
-            {
-                (void)interlocked_exchange_pointer((void* volatile_atomic*)&new_bucket_array->hash_table[i], NULL);
-            }
+    (void)interlocked_exchange(&bucket_array->item_count_estimate, 0);
+    (void)interlocked_exchange(&bucket_array->pending_insert_waiters, 0);
+}
 
-            (void)interlocked_exchange_pointer((void* volatile_atomic*)&new_bucket_array->next_bucket, first_bucket_array);
-            if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, new_bucket_array, first_bucket_array) == first_bucket_array)
-            {
-                first_bucket_array = new_bucket_array;
-                break;
-            }
-            else
-            {
-                // first bucket array changed, drop ours and use the one that was inserted
-                free(new_bucket_array);
+static int32_t get_item_count(BUCKET_ARRAY* bucket_array)
+{
+    // the stripes are not read at the same time, while items are inserted and deleted the sum is approximate,
+    // so they are read with plain loads, an interlocked read would take the cache line of each stripe away from its writers
+    int32_t result = 0;
 
-                first_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
-                bucket_count = interlocked_add(&first_bucket_array->bucket_count, 0);
-            }
-        }
+    for (uint32_t i = 0; i < COUNTER_STRIPE_COUNT; i++)
+    {
+        result += bucket_array->counter_stripes[i].item_count;
     }
 
-    return first_bucket_array;
+    return result;
 }
 
-CLDS_HASH_TABLE_HANDLE clds_hash_table_create(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context)
+static bool needs_more_buckets(BUCKET_ARRAY* bucket_array, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, int32_t bucket_count)
 {
-    CLDS_HASH_TABLE_HANDLE clds_hash_table;
-
-    /* Codes_SRS_CLDS_HASH_TABLE_01_058: [ start_sequence_number shall be allowed to be NULL, in which case no sequence number computations shall be performed. ]*/
-    /* Codes_S_R_S_CLDS_HASH_TABLE_01_072: [ skipped_seq_no_cb shall be allowed to be NULL. ]*/
-    /* Codes_S_R_S_CLDS_HASH_TABLE_01_073: [ skipped_seq_no_cb_context shall be allowed to be NULL. ]*/
+    // a write looks at its own stripe and sums the stripes only once its stripe holds its share of the buckets and the last sum
+    // says the array may be full, so that the writes do not read the stripes of the other writers while the array is far from full
+    bool result;
+    int32_t stripe_share = bucket_count / COUNTER_STRIPE_COUNT;
+    int32_t stripe_threshold = (stripe_share > 0) ? stripe_share : 1;
+    int32_t stripe_item_count = get_counter_stripe(bucket_array, clds_hazard_pointers_thread)->item_count;
 
-    if (
-        /* Codes_SRS_CLDS_HASH_TABLE_01_003: [ If compute_hash is NULL, clds_hash_table_create shall fail and return NULL. ]*/
-        (compute_hash == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_045: [ If key_compare_func is NULL, clds_hash_table_create shall fail and return NULL. ]*/
-        (key_compare_func == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_004: [ If initial_bucket_size is 0, clds_hash_table_create shall fail and return NULL. ]*/
-        (initial_bucket_size == 0) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_005: [ If clds_hazard_pointers is NULL, clds_hash_table_create shall fail and return NULL. ]*/
-        (clds_hazard_pointers == NULL) ||
-        /* Codes_S_R_S_CLDS_HASH_TABLE_01_074: [ If start_sequence_number is NULL, then skipped_seq_no_cb must also be NULL, otherwise clds_sorted_list_create shall fail and return NULL. ]*/
-        ((start_sequence_number == NULL) && (skipped_seq_no_cb != NULL))
+    if (stripe_item_count < stripe_threshold)
+    {
+        result = false;
+    }
+    else if (
+        ((stripe_item_count - stripe_threshold) % ITEM_COUNT_ESTIMATE_REFRESH_COUNT != 0) &&
+        // the estimate is read with a plain load for the same reason as the stripes, it is only written when the stripes are summed
+        (bucket_array->item_count_estimate < bucket_count - (COUNTER_STRIPE_COUNT * ITEM_COUNT_ESTIMATE_REFRESH_COUNT))
         )
     {
-        /* Codes_SRS_CLDS_HASH_TABLE_01_002: [ If any error happens, clds_hash_table_create shall fail and return NULL. ]*/
-        LogError("Invalid arguments: COMPUTE_HASH_FUNC compute_hash=%p, KEY_COMPARE_FUNC key_compare_func=%p, size_t initial_bucket_size=%zu, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers=%p, volatile_atomic int64_t* start_sequence_number=%p, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb=%p, void* skipped_seq_no_cb_context=%p",
-            compute_hash, key_compare_func, initial_bucket_size, clds_hazard_pointers, start_sequence_number, skipped_seq_no_cb, skipped_seq_no_cb_context);
+        // even with every stripe ahead of the estimate by as much as it can be the array is not full
+        result = false;
     }
     else
     {
-        /* Codes_SRS_CLDS_HASH_TABLE_01_001: [ clds_hash_table_create shall create a new hash table object and on success it shall return a non-NULL handle to the newly created hash table. ]*/
-        clds_hash_table = malloc(sizeof(CLDS_HASH_TABLE));
-        if (clds_hash_table == NULL)
-        {
-            /* Codes_SRS_CLDS_HASH_TABLE_01_002: [ If any error happens, clds_hash_table_create shall fail and return NULL. ]*/
-            LogError("Cannot allocate memory for hash table");
-        }
-        else
-        {
-            /* Codes_SRS_CLDS_HASH_TABLE_01_027: [ The hash table shall maintain a list of arrays of buckets, so that it can be resized as needed. ]*/
-            clds_hash_table->first_hash_table = malloc_flex(sizeof(BUCKET_ARRAY), initial_bucket_size, sizeof(CLDS_SORTED_LIST_HANDLE));
-            if (clds_hash_table->first_hash_table == NULL)
-            {
-                LogError("Cannot allocate memory for hash table array. Failure in malloc_flex(sizeof(BUCKET_ARRAY)=%zu, initial_bucket_size=%zu, sizeof(CLDS_SORTED_LIST_HANDLE)=%zu);",
-                    sizeof(BUCKET_ARRAY), initial_bucket_size, sizeof(CLDS_SORTED_LIST_HANDLE));
-            }
-            else
-            {
-                size_t i;
-
-                // all OK
-                clds_hash_table->clds_hazard_pointers = clds_hazard_pointers;
-                clds_hash_table->compute_hash = compute_hash;
-                clds_hash_table->key_compare_func = key_compare_func;
-                clds_hash_table->skipped_seq_no_cb = skipped_seq_no_cb;
-                clds_hash_table->skipped_seq_no_cb_context = skipped_seq_no_cb_context;
-
-                (void)interlocked_exchange(&clds_hash_table->pending_write_operations, 0);
-                (void)interlocked_exchange(&clds_hash_table->locked_for_write, 0);
-
-                /* Codes_SRS_CLDS_HASH_TABLE_01_057: [ start_sequence_number shall be used as the sequence number variable that shall be incremented at every operation that is done on the hash table. ]*/
-                clds_hash_table->sequence_number = start_sequence_number;
-
-                // set the initial bucket count
-                (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table->next_bucket, NULL);
-                (void)interlocked_exchange(&clds_hash_table->first_hash_table->bucket_count, (int32_t)initial_bucket_size);
-                (void)interlocked_exchange(&clds_hash_table->first_hash_table->item_count, 0);
-                (void)interlocked_exchange(&clds_hash_table->first_hash_table->pending_insert_count, 0);
+        // a stripe can be ahead of the others (or the others negative), the sum decides
+        int32_t item_count = get_item_count(bucket_array);
+        (void)interlocked_exchange(&bucket_array->item_count_estimate, item_count);
+        result = (item_count >= bucket_count);
+    }
 
-                for (i = 0; i < initial_bucket_size; i++)
-                {
-                    (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table->hash_table[i], NULL);
-                }
+    return result;
+}
 
-                goto all_ok;
-            }
+static bool has_pending_inserts(BUCKET_ARRAY* bucket_array)
+{
+    // no stripe is ever negative, so the array has no pending inserts only if each stripe read 0
+    bool result = false;
 
-            free(clds_hash_table);
+    for (uint32_t i = 0; i < COUNTER_STRIPE_COUNT; i++)
+    {
+        if (interlocked_add(&bucket_array->counter_stripes[i].pending_insert_count, 0) != 0)
+        {
+            result = true;
+            break;
         }
     }
 
-    clds_hash_table = NULL;
+    return result;
+}
 
-all_ok:
-    return clds_hash_table;
+static void begin_pending_insert(BUCKET_ARRAY* bucket_array, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    (void)interlocked_increment(&get_counter_stripe(bucket_array, clds_hazard_pointers_thread)->pending_insert_count);
 }
 
-static void sorted_list_item_cleanup(void* context, CLDS_SORTED_LIST_ITEM* item)
+static void end_pending_insert(BUCKET_ARRAY* bucket_array, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
 {
-    HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
+    COUNTER_STRIPE* counter_stripe = get_counter_stripe(bucket_array, clds_hazard_pointers_thread);
 
-    (void)context;
-    if (hash_table_item->item_cleanup_callback != NULL)
+    (void)interlocked_decrement(&counter_stripe->pending_insert_count);
+
+    // the waiters count is incremented before a waiter reads the stripe it blocks on, so either the waiter is woken here
+    // or it reads the decremented value and does not block
+    if (interlocked_add(&bucket_array->pending_insert_waiters, 0) != 0)
     {
-        hash_table_item->item_cleanup_callback(hash_table_item->item_cleanup_callback_context, (void*)item);
+        wake_by_address_all(&counter_stripe->pending_insert_count);
     }
 }
 
-void clds_hash_table_destroy(CLDS_HASH_TABLE_HANDLE clds_hash_table)
+static void wait_for_pending_inserts(BUCKET_ARRAY* bucket_array)
 {
-    if (clds_hash_table == NULL)
-    {
-        /* Codes_SRS_CLDS_HASH_TABLE_01_007: [ If clds_hash_table is NULL, clds_hash_table_destroy shall return. ]*/
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p", clds_hash_table);
-    }
-    else
+    // there is nothing a late write can do to complete an insert that another thread has in flight in an older array,
+    // so it checks for a little while (the inserts are short) and then blocks instead of spinning, which would starve
+    // the threads doing the inserts when there are more threads than cores
+    uint32_t spin_count = 0;
+
+    for (uint32_t i = 0; i < COUNTER_STRIPE_COUNT; i++)
     {
-        int32_t i;
+        volatile_atomic int32_t* pending_insert_count = &bucket_array->counter_stripes[i].pending_insert_count;
+        int32_t pending_inserts = interlocked_add(pending_insert_count, 0);
 
-        BUCKET_ARRAY* bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
-        while (bucket_array != NULL)
+        while (pending_inserts != 0)
         {
-            BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_array->next_bucket, NULL, NULL);
-
-            /* Codes_SRS_CLDS_HASH_TABLE_01_006: [ clds_hash_table_destroy shall free all resources associated with the hash table instance. ]*/
-            for (i = 0; i < bucket_array->bucket_count; i++)
+            if (spin_count < PENDING_INSERTS_SPIN_COUNT)
             {
-                if (bucket_array->hash_table[i] != NULL)
-                {
-                    CLDS_SORTED_LIST_HANDLE linked_list = interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_array->hash_table[i], NULL, NULL);
-                    if (linked_list != NULL)
-                    {
-                        clds_sorted_list_destroy(linked_list);
-                    }
-                }
+                spin_count++;
+                CPU_PAUSE();
             }
+            else
+            {
+                (void)interlocked_increment(&bucket_array->pending_insert_waiters);
+
+                pending_inserts = interlocked_add(pending_insert_count, 0);
+                if (pending_inserts != 0)
+                {
+                    (void)wait_on_address(pending_insert_count, pending_inserts, UINT32_MAX);
+                }
+
+                (void)interlocked_decrement(&bucket_array->pending_insert_waiters);
+            }
+
+            pending_inserts = interlocked_add(pending_insert_count, 0);
+        }
+    }
+}
+
+static BUCKET_ARRAY* acquire_first_bucket_array(CLDS_HASH_TABLE* clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HAZARD_POINTER_RECORD_HANDLE* first_bucket_array_hp)
+{
+    BUCKET_ARRAY* result;
+
+    do
+    {
+        result = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+        *first_bucket_array_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, result);
+        if (*first_bucket_array_hp == NULL)
+        {
+            LogError("Cannot acquire hazard pointer for the first bucket array");
+            result = NULL;
+            break;
+        }
+
+        // only the arrays that are not first anymore get retired, so if it is still the first one it is protected
+        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL) == result)
+        {
+            break;
+        }
+
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, *first_bucket_array_hp);
+    } while (1);
+
+    return result;
+}
+
+static int acquire_next_bucket_array(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, BUCKET_ARRAY* bucket_array, BUCKET_ARRAY** next_bucket_array, CLDS_HAZARD_POINTER_RECORD_HANDLE* next_bucket_array_hp)
+{
+    int result;
+
+    do
+    {
+        *next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_array->next_bucket, NULL, NULL);
+        if (*next_bucket_array == NULL)
+        {
+            *next_bucket_array_hp = NULL;
+            result = 0;
+            break;
+        }
+
+        *next_bucket_array_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, *next_bucket_array);
+        if (*next_bucket_array_hp == NULL)
+        {
+            LogError("Cannot acquire hazard pointer for the next bucket array");
+            result = MU_FAILURE;
+            break;
+        }
+
+        // bucket_array is protected, if it still links to the next array then that array was not unlinked (and retired) yet
+        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_array->next_bucket, NULL, NULL) == *next_bucket_array)
+        {
+            result = 0;
+            break;
+        }
+
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, *next_bucket_array_hp);
+    } while (1);
+
+    return result;
+}
+
+static ITEM_MOVE_STRIPE* get_item_move_stripe(CLDS_HASH_TABLE* clds_hash_table, uint64_t hash)
+{
+    // the same key always has the same hash, so a move of the item of a key is always counted in the stripe its lookups check
+    return &clds_hash_table->item_move_stripes[hash & (ITEM_MOVE_STRIPE_COUNT - 1)];
+}
+
+static int64_t get_completed_item_moves(CLDS_HASH_TABLE* clds_hash_table, uint64_t hash)
+{
+    return interlocked_add_64(&get_item_move_stripe(clds_hash_table, hash)->completed_item_moves, 0);
+}
+
+static bool items_moved_since(CLDS_HASH_TABLE* clds_hash_table, uint64_t hash, int64_t completed_item_moves)
+{
+    // a lookup that started before a move of an item with a hash in its stripe completed could have missed the moved item in both arrays
+    ITEM_MOVE_STRIPE* item_move_stripe = get_item_move_stripe(clds_hash_table, hash);
+    return (interlocked_add(&item_move_stripe->pending_item_moves, 0) != 0) ||
+        (interlocked_add_64(&item_move_stripe->completed_item_moves, 0) != completed_item_moves);
+}
+
+static BUCKET_ARRAY* create_bucket_array(int32_t bucket_count)
+{
+    BUCKET_ARRAY* result = malloc_flex(sizeof(BUCKET_ARRAY), bucket_count, sizeof(CLDS_SORTED_LIST_HEAD));
+    if (result == NULL)
+    {
+        LogError("malloc_flex(sizeof(BUCKET_ARRAY)=%zu, bucket_count=%" PRId32 ", sizeof(CLDS_SORTED_LIST_HEAD)=%zu) failed",
+            sizeof(BUCKET_ARRAY), bucket_count, sizeof(CLDS_SORTED_LIST_HEAD));
+    }
+    else
+    {
+        (void)interlocked_exchange(&result->bucket_count, bucket_count);
+        init_counter_stripes(result);
+        (void)interlocked_exchange(&result->migration_cursor, 0);
+        (void)interlocked_exchange(&result->migrated_bucket_count, 0);
+        (void)interlocked_exchange(&result->migration_failed, 0);
+
+        // initialize buckets
+        for (int32_t i = 0; i < bucket_count; i++)
+        {
+            CLDS_SORTED_LIST_HEAD_INIT(&result->hash_table[i]);
+        }
+    }
+
+    return result;
+}
+
+static BUCKET_ARRAY* get_first_bucket_array(CLDS_HASH_TABLE* clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HAZARD_POINTER_RECORD_HANDLE* first_bucket_array_hp)
+{
+    // always insert in the first bucket array
+    BUCKET_ARRAY* first_bucket_array = acquire_first_bucket_array(clds_hash_table, clds_hazard_pointers_thread, first_bucket_array_hp);
+    if (first_bucket_array != NULL)
+    {
+        int32_t bucket_count = interlocked_add(&first_bucket_array->bucket_count, 0);
+        // the item count is approximate, which is good enough to decide when to grow
+        while (needs_more_buckets(first_bucket_array, clds_hazard_pointers_thread, bucket_count))
+        {
+            // allocate a new bucket array
+            /* Codes_SRS_CLDS_HASH_TABLE_01_030: [ If the number of items in the list reaches the number of buckets, the number of buckets shall be doubled. ]*/
+            BUCKET_ARRAY* new_bucket_array = create_bucket_array(bucket_count * 2);
+            if (new_bucket_array == NULL)
+            {
+                // cannot allocate new bucket, will stick to what we have, but do not fail
+                break;
+            }
+            else
+            {
+                // protect the new array before it is published
+                CLDS_HAZARD_POINTER_RECORD_HANDLE new_bucket_array_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, new_bucket_array);
+                if (new_bucket_array_hp == NULL)
+                {
+                    // cannot protect the new bucket, will stick to what we have, but do not fail
+                    free(new_bucket_array);
+                    break;
+                }
+
+                // insert new bucket
+                bucket_count = bucket_count * 2;
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&new_bucket_array->next_bucket, first_bucket_array);
+                if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, new_bucket_array, first_bucket_array) == first_bucket_array)
+                {
+                    (void)interlocked_increment(&clds_hash_table->bucket_array_count);
+
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, *first_bucket_array_hp);
+                    *first_bucket_array_hp = new_bucket_array_hp;
+                    first_bucket_array = new_bucket_array;
+                    break;
+                }
+                else
+                {
+                    // first bucket array changed, drop ours and use the one that was inserted
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, new_bucket_array_hp);
+                    free(new_bucket_array);
+
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, *first_bucket_array_hp);
+                    first_bucket_array = acquire_first_bucket_array(clds_hash_table, clds_hazard_pointers_thread, first_bucket_array_hp);
+                    if (first_bucket_array == NULL)
+                    {
+                        break;
+                    }
+
+                    bucket_count = interlocked_add(&first_bucket_array->bucket_count, 0);
+                }
+            }
+        }
+    }
+
+    return first_bucket_array;
+}
+
+static BUCKET_ARRAY* acquire_first_bucket_array_for_insert(CLDS_HASH_TABLE* clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HAZARD_POINTER_RECORD_HANDLE* first_bucket_array_hp)
+{
+    BUCKET_ARRAY* result;
+
+    do
+    {
+        result = get_first_bucket_array(clds_hash_table, clds_hazard_pointers_thread, first_bucket_array_hp);
+        if (result == NULL)
+        {
+            break;
+        }
+
+        // increment pending inserts count
+        begin_pending_insert(result, clds_hazard_pointers_thread);
+
+        // an array that is not the first one anymore gets migrated once it has no pending inserts,
+        // so the insert can only go ahead if the array is still the first one after the pending insert was counted
+        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL) == result)
+        {
+            break;
+        }
+
+        end_pending_insert(result, clds_hazard_pointers_thread);
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, *first_bucket_array_hp);
+    } while (1);
+
+    return result;
+}
+
+static void report_moved_item_seq_no(CLDS_HASH_TABLE* clds_hash_table, int64_t sequence_number)
+{
+    // moving an item is not an operation of the user, so the sequence numbers it took are indicated as skipped
+    if (clds_hash_table->skipped_seq_no_cb != NULL)
+    {
+        clds_hash_table->skipped_seq_no_cb(clds_hash_table->skipped_seq_no_cb_context, sequence_number);
+    }
+}
+
+static int move_item(CLDS_HASH_TABLE* clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, BUCKET_ARRAY* source_bucket_array, CLDS_SORTED_LIST_HEAD* source_bucket_list, BUCKET_ARRAY* destination_bucket_array, HASH_TABLE_HASHED_KEY* hashed_key)
+{
+    int result;
+    bool has_sequence_numbers = (clds_hash_table->sequence_number != NULL);
+    // the hash kept in the item is used, the key does not have to be hashed again
+    CLDS_SORTED_LIST_HEAD* destination_bucket_list = &destination_bucket_array->hash_table[get_bucket_index(clds_hash_table, hashed_key->hash, interlocked_add(&destination_bucket_array->bucket_count, 0))];
+    CLDS_SORTED_LIST_ITEM* item;
+    int64_t remove_sequence_number;
+    ITEM_MOVE_STRIPE* item_move_stripe = get_item_move_stripe(clds_hash_table, hashed_key->hash);
+
+    (void)interlocked_increment(&item_move_stripe->pending_item_moves);
+
+    CLDS_SORTED_LIST_REMOVE_RESULT remove_result = clds_sorted_list_head_remove_key(clds_hash_table->bucket_lists, source_bucket_list, clds_hazard_pointers_thread, hashed_key, &item, has_sequence_numbers ? &remove_sequence_number : NULL);
+    if (remove_result == CLDS_SORTED_LIST_REMOVE_NOT_FOUND)
+    {
+        // deleted in the meanwhile, nothing to move
+        result = 0;
+    }
+    else if (remove_result != CLDS_SORTED_LIST_REMOVE_OK)
+    {
+        LogError("clds_sorted_list_head_remove_key failed with %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_REMOVE_RESULT, remove_result));
+        result = MU_FAILURE;
+    }
+    else
+    {
+        int64_t insert_sequence_number;
+
+        (void)interlocked_decrement(&get_counter_stripe(source_bucket_array, clds_hazard_pointers_thread)->item_count);
+        if (has_sequence_numbers)
+        {
+            report_moved_item_seq_no(clds_hash_table, remove_sequence_number);
+        }
+
+        // the reference that the source list had is handed over to the destination list
+        CLDS_SORTED_LIST_INSERT_RESULT insert_result = clds_sorted_list_head_insert(clds_hash_table->bucket_lists, destination_bucket_list, clds_hazard_pointers_thread, item, has_sequence_numbers ? &insert_sequence_number : NULL);
+        if (insert_result == CLDS_SORTED_LIST_INSERT_OK)
+        {
+            (void)interlocked_increment(&get_counter_stripe(destination_bucket_array, clds_hazard_pointers_thread)->item_count);
+            if (has_sequence_numbers)
+            {
+                report_moved_item_seq_no(clds_hash_table, insert_sequence_number);
+            }
+
+            result = 0;
+        }
+        else if (insert_result == CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS)
+        {
+            // the key was written in the first array while the item was moved, the newer item wins as if it replaced the moved one
+            clds_sorted_list_node_release(item);
+            result = 0;
+        }
+        else
+        {
+            CLDS_SORTED_LIST_INSERT_RESULT put_back_result;
+
+            LogError("clds_sorted_list_head_insert failed with %" PRI_MU_ENUM ", putting the item back", MU_ENUM_VALUE(CLDS_SORTED_LIST_INSERT_RESULT, insert_result));
+
+            // the item is never dropped, it goes back to its bucket and is moved again on the next pass over the array
+            // an insert only fails when no hazard pointer can be acquired and the remove above released the ones it used, so this does not spin for long
+            // the move stays pending meanwhile, so the lookups that miss the key look again
+            do
+            {
+                put_back_result = clds_sorted_list_head_insert(clds_hash_table->bucket_lists, source_bucket_list, clds_hazard_pointers_thread, item, has_sequence_numbers ? &insert_sequence_number : NULL);
+            } while (put_back_result == CLDS_SORTED_LIST_INSERT_ERROR);
+
+            if (put_back_result == CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS)
+            {
+                // the key was written while the item was out of its bucket, the newer item wins as if it replaced the moved one
+                clds_sorted_list_node_release(item);
+            }
+            else
+            {
+                (void)interlocked_increment(&get_counter_stripe(source_bucket_array, clds_hazard_pointers_thread)->item_count);
+                if (has_sequence_numbers)
+                {
+                    report_moved_item_seq_no(clds_hash_table, insert_sequence_number);
+                }
+            }
+
+            result = MU_FAILURE;
+        }
+    }
+
+    (void)interlocked_increment_64(&item_move_stripe->completed_item_moves);
+    (void)interlocked_decrement(&item_move_stripe->pending_item_moves);
+
+    return result;
+}
+
+static int migrate_bucket(CLDS_HASH_TABLE* clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, BUCKET_ARRAY* source_bucket_array, int32_t bucket_index, BUCKET_ARRAY* destination_bucket_array)
+{
+    int result;
+    CLDS_SORTED_LIST_HEAD* bucket_list = &source_bucket_array->hash_table[bucket_index];
+
+    // no new keys get in the bucket (there are no inserts in an array that is not the first one),
+    // so moving the first item until there is none left empties the bucket without locking the lists
+    do
+    {
+        CLDS_SORTED_LIST_ITEM* first_item;
+
+        if (clds_sorted_list_head_get_first(clds_hash_table->bucket_lists, bucket_list, clds_hazard_pointers_thread, &first_item) != 0)
+        {
+            LogError("clds_sorted_list_head_get_first failed");
+            result = MU_FAILURE;
+            break;
+        }
+
+        if (first_item == NULL)
+        {
+            // bucket is empty
+            result = 0;
+            break;
+        }
+
+        HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, first_item);
+
+        // the items are moved by key, so an item that was replaced in the meanwhile (set_value) is moved as the replacement
+        int move_result = move_item(clds_hash_table, clds_hazard_pointers_thread, source_bucket_array, bucket_list, destination_bucket_array, &hash_table_item->hashed_key);
+        clds_sorted_list_node_release(first_item);
+
+        if (move_result != 0)
+        {
+            // the item went back to the bucket, leave it for the next pass over the array
+            result = MU_FAILURE;
+            break;
+        }
+    } while (1);
+
+    return result;
+}
+
+static int32_t claim_bucket_to_migrate(BUCKET_ARRAY* bucket_array, int32_t bucket_count)
+{
+    // the cursor never goes past the bucket count, every write tries to claim buckets and an increment per attempt would overflow it
+    int32_t result;
+
+    do
+    {
+        result = interlocked_add(&bucket_array->migration_cursor, 0);
+        if (result >= bucket_count)
+        {
+            result = -1;
+            break;
+        }
+    } while (interlocked_compare_exchange(&bucket_array->migration_cursor, result + 1, result) != result);
+
+    return result;
+}
+
+static void migrate_buckets(CLDS_HASH_TABLE* clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, int32_t bucket_count_to_migrate)
+{
+    CLDS_HAZARD_POINTER_RECORD_HANDLE first_bucket_array_hp;
+    BUCKET_ARRAY* first_bucket_array = acquire_first_bucket_array_for_insert(clds_hash_table, clds_hazard_pointers_thread, &first_bucket_array_hp);
+
+    if (first_bucket_array == NULL)
+    {
+        LogError("Cannot acquire the first bucket array for migration");
+    }
+    else
+    {
+        // find the oldest array and the one before it (which has to be unlinked from once the oldest array is empty)
+        BUCKET_ARRAY* previous_bucket_array = NULL;
+        CLDS_HAZARD_POINTER_RECORD_HANDLE previous_bucket_array_hp = NULL;
+        BUCKET_ARRAY* oldest_bucket_array = first_bucket_array;
+        CLDS_HAZARD_POINTER_RECORD_HANDLE oldest_bucket_array_hp = NULL;
+        bool failed = false;
+
+        do
+        {
+            BUCKET_ARRAY* next_bucket_array;
+            CLDS_HAZARD_POINTER_RECORD_HANDLE next_bucket_array_hp;
+
+            if (acquire_next_bucket_array(clds_hazard_pointers_thread, oldest_bucket_array, &next_bucket_array, &next_bucket_array_hp) != 0)
+            {
+                failed = true;
+                break;
+            }
+
+            if (next_bucket_array == NULL)
+            {
+                break;
+            }
+
+            if (previous_bucket_array_hp != NULL)
+            {
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_bucket_array_hp);
+            }
+
+            previous_bucket_array = oldest_bucket_array;
+            previous_bucket_array_hp = oldest_bucket_array_hp;
+            oldest_bucket_array = next_bucket_array;
+            oldest_bucket_array_hp = next_bucket_array_hp;
+        } while (1);
+
+        if (
+            (!failed) &&
+            (previous_bucket_array != NULL) &&
+            // an insert that started before the array stopped being the first one could still be adding to it
+            !has_pending_inserts(oldest_bucket_array)
+            )
+        {
+            int32_t bucket_count = interlocked_add(&oldest_bucket_array->bucket_count, 0);
+
+            for (int32_t i = 0; i < bucket_count_to_migrate; i++)
+            {
+                int32_t bucket_index = claim_bucket_to_migrate(oldest_bucket_array, bucket_count);
+                if (bucket_index < 0)
+                {
+                    // all buckets are claimed
+                    break;
+                }
+
+                if (migrate_bucket(clds_hash_table, clds_hazard_pointers_thread, oldest_bucket_array, bucket_index, first_bucket_array) != 0)
+                {
+                    (void)interlocked_exchange(&oldest_bucket_array->migration_failed, 1);
+                }
+
+                if (interlocked_increment(&oldest_bucket_array->migrated_bucket_count) == bucket_count)
+                {
+                    // this was the last bucket to be migrated
+                    if (interlocked_exchange(&oldest_bucket_array->migration_failed, 0) != 0)
+                    {
+                        // some items could not be moved, go over the array again
+                        LogError("Migration of bucket array %p did not complete, restarting it", oldest_bucket_array);
+                        (void)interlocked_exchange(&oldest_bucket_array->migrated_bucket_count, 0);
+                        (void)interlocked_exchange(&oldest_bucket_array->migration_cursor, 0);
+                    }
+                    else
+                    {
+                        // the array is empty, unlink it and retire it, lookups in flight might still be looking at it
+                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&previous_bucket_array->next_bucket, NULL, oldest_bucket_array) == oldest_bucket_array)
+                        {
+                            (void)interlocked_decrement(&clds_hash_table->bucket_array_count);
+                            clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, oldest_bucket_array, reclaim_bucket_array);
+                        }
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        if (oldest_bucket_array_hp != NULL)
+        {
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, oldest_bucket_array_hp);
+        }
+
+        if (previous_bucket_array_hp != NULL)
+        {
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_bucket_array_hp);
+        }
+
+        end_pending_insert(first_bucket_array, clds_hazard_pointers_thread);
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, first_bucket_array_hp);
+    }
+}
+
+// found_item is optional, when it is non-NULL the item found is returned with a reference that the caller has to release
+static int find_key_in_lower_bucket_arrays(CLDS_HASH_TABLE* clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, BUCKET_ARRAY* first_bucket_array, HASH_TABLE_HASHED_KEY* hashed_key, bool* found, CLDS_SORTED_LIST_ITEM** found_item)
+{
+    int result;
+    BUCKET_ARRAY* find_bucket_array;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE find_bucket_array_hp;
+
+    *found = false;
+
+    if (acquire_next_bucket_array(clds_hazard_pointers_thread, first_bucket_array, &find_bucket_array, &find_bucket_array_hp) != 0)
+    {
+        LogError("Cannot acquire the next bucket array");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        result = 0;
+
+        if (find_bucket_array != NULL)
+        {
+            // wait for all outstanding inserts in the lower levels to complete
+            wait_for_pending_inserts(find_bucket_array);
+        }
+
+        while (find_bucket_array != NULL)
+        {
+            BUCKET_ARRAY* next_bucket_array;
+            CLDS_HAZARD_POINTER_RECORD_HANDLE next_bucket_array_hp;
+            uint64_t bucket_index = get_bucket_index(clds_hash_table, hashed_key->hash, interlocked_add(&find_bucket_array->bucket_count, 0));
+            CLDS_SORTED_LIST_HEAD* bucket_list = &find_bucket_array->hash_table[bucket_index];
+
+            if (!CLDS_SORTED_LIST_HEAD_IS_EMPTY(bucket_list))
+            {
+                CLDS_SORTED_LIST_ITEM* sorted_list_item = clds_sorted_list_head_find_key(clds_hash_table->bucket_lists, bucket_list, clds_hazard_pointers_thread, hashed_key);
+                if (sorted_list_item != NULL)
+                {
+                    if (found_item == NULL)
+                    {
+                        clds_sorted_list_node_release(sorted_list_item);
+                    }
+                    else
+                    {
+                        *found_item = sorted_list_item;
+                    }
+
+                    *found = true;
+                    break;
+                }
+            }
+
+            if (acquire_next_bucket_array(clds_hazard_pointers_thread, find_bucket_array, &next_bucket_array, &next_bucket_array_hp) != 0)
+            {
+                LogError("Cannot acquire the next bucket array");
+                result = MU_FAILURE;
+                break;
+            }
+
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, find_bucket_array_hp);
+            find_bucket_array = next_bucket_array;
+            find_bucket_array_hp = next_bucket_array_hp;
+        }
+
+        if (find_bucket_array != NULL)
+        {
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, find_bucket_array_hp);
+        }
+    }
+
+    return result;
+}
+
+static void migrate_buckets_if_needed(CLDS_HASH_TABLE* clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, int32_t bucket_count_to_migrate)
+{
+    if (
+        (bucket_count_to_migrate > 0) &&
+        (interlocked_add(&clds_hash_table->bucket_array_count, 0) > 1) &&
+        // moving an item takes it out of the table for a while, a snapshot at a sequence number walking the buckets could miss it
+        /* Codes_SRS_CLDS_HASH_TABLE_01_151: [ While a snapshot at a sequence number is taken, no items shall be migrated between the arrays of buckets. ]*/
+        !is_sequence_number_snapshot_in_progress(clds_hash_table) &&
+        // same for a cursor, which also keeps pointers to the bucket arrays between calls
+        /* Codes_SRS_CLDS_HASH_TABLE_01_173: [ While a cursor is open, no items shall be migrated between the arrays of buckets and no array of buckets shall be freed. ]*/
+        (interlocked_add(&clds_hash_table->open_cursor_count, 0) == 0)
+        )
+    {
+        migrate_buckets(clds_hash_table, clds_hazard_pointers_thread, bucket_count_to_migrate);
+    }
+}
+
+static CLDS_HASH_TABLE_HANDLE internal_create(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context, CLDS_HASH_TABLE_BUCKET_INDEXING bucket_indexing)
+{
+    CLDS_HASH_TABLE_HANDLE clds_hash_table;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_058: [ start_sequence_number shall be allowed to be NULL, in which case no sequence number computations shall be performed. ]*/
+    /* Codes_S_R_S_CLDS_HASH_TABLE_01_072: [ skipped_seq_no_cb shall be allowed to be NULL. ]*/
+    /* Codes_S_R_S_CLDS_HASH_TABLE_01_073: [ skipped_seq_no_cb_context shall be allowed to be NULL. ]*/
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_003: [ If compute_hash is NULL, clds_hash_table_create shall fail and return NULL. ]*/
+        (compute_hash == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_045: [ If key_compare_func is NULL, clds_hash_table_create shall fail and return NULL. ]*/
+        (key_compare_func == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_004: [ If initial_bucket_size is 0, clds_hash_table_create shall fail and return NULL. ]*/
+        (initial_bucket_size == 0) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_005: [ If clds_hazard_pointers is NULL, clds_hash_table_create shall fail and return NULL. ]*/
+        (clds_hazard_pointers == NULL) ||
+        /* Codes_S_R_S_CLDS_HASH_TABLE_01_074: [ If start_sequence_number is NULL, then skipped_seq_no_cb must also be NULL, otherwise clds_sorted_list_create shall fail and return NULL. ]*/
+        ((start_sequence_number == NULL) && (skipped_seq_no_cb != NULL)) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_133: [ If bucket_indexing is CLDS_HASH_TABLE_BUCKET_INDEXING_POWER_OF_TWO and initial_bucket_size rounded up to a power of two does not fit the bucket count, clds_hash_table_create_with_bucket_indexing shall fail and return NULL. ]*/
+        ((bucket_indexing == CLDS_HASH_TABLE_BUCKET_INDEXING_POWER_OF_TWO) && (initial_bucket_size > MAX_POWER_OF_TWO_BUCKET_COUNT))
+        )
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_002: [ If any error happens, clds_hash_table_create shall fail and return NULL. ]*/
+        LogError("Invalid arguments: COMPUTE_HASH_FUNC compute_hash=%p, KEY_COMPARE_FUNC key_compare_func=%p, size_t initial_bucket_size=%zu, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers=%p, volatile_atomic int64_t* start_sequence_number=%p, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb=%p, void* skipped_seq_no_cb_context=%p",
+            compute_hash, key_compare_func, initial_bucket_size, clds_hazard_pointers, start_sequence_number, skipped_seq_no_cb, skipped_seq_no_cb_context);
+    }
+    else
+    {
+        if (bucket_indexing == CLDS_HASH_TABLE_BUCKET_INDEXING_POWER_OF_TWO)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_131: [ If bucket_indexing is CLDS_HASH_TABLE_BUCKET_INDEXING_POWER_OF_TWO, clds_hash_table_create_with_bucket_indexing shall round initial_bucket_size up to a power of two. ]*/
+            // the bucket count is doubled when the table grows, so it stays a power of two
+            size_t bucket_count = 1;
+            while (bucket_count < initial_bucket_size)
+            {
+                bucket_count *= 2;
+            }
+
+            initial_bucket_size = bucket_count;
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_001: [ clds_hash_table_create shall create a new hash table object and on success it shall return a non-NULL handle to the newly created hash table. ]*/
+        clds_hash_table = malloc(sizeof(CLDS_HASH_TABLE));
+        if (clds_hash_table == NULL)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_002: [ If any error happens, clds_hash_table_create shall fail and return NULL. ]*/
+            LogError("Cannot allocate memory for hash table");
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_027: [ The hash table shall maintain a list of arrays of buckets, so that it can be resized as needed. ]*/
+            clds_hash_table->first_hash_table = malloc_flex(sizeof(BUCKET_ARRAY), initial_bucket_size, sizeof(CLDS_SORTED_LIST_HEAD));
+            if (clds_hash_table->first_hash_table == NULL)
+            {
+                LogError("Cannot allocate memory for hash table array. Failure in malloc_flex(sizeof(BUCKET_ARRAY)=%zu, initial_bucket_size=%zu, sizeof(CLDS_SORTED_LIST_HEAD)=%zu);",
+                    sizeof(BUCKET_ARRAY), initial_bucket_size, sizeof(CLDS_SORTED_LIST_HEAD));
+            }
+            else
+            {
+                size_t i;
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_071: [ The start sequence number passed to clds_hash_table_create shall be passed as the start_sequence_number argument when creating the sorted list. ]*/
+                /* Codes_SRS_CLDS_HASH_TABLE_01_124: [ clds_hash_table_create shall create one sorted list by calling clds_sorted_list_create, which provides the key callbacks, the write lock and the sequence numbers for the lists of all the buckets. ]*/
+                clds_hash_table->bucket_lists = clds_sorted_list_create(clds_hazard_pointers, get_item_key_cb, clds_hash_table, key_compare_cb, clds_hash_table, start_sequence_number, start_sequence_number == NULL ? NULL : on_sorted_list_skipped_seq_no, clds_hash_table);
+                if (clds_hash_table->bucket_lists == NULL)
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_002: [ If any error happens, clds_hash_table_create shall fail and return NULL. ]*/
+                    LogError("Cannot create the bucket lists");
+                }
+                else
+                {
+                    // all OK
+                    clds_hash_table->clds_hazard_pointers = clds_hazard_pointers;
+                    clds_hash_table->compute_hash = compute_hash;
+                    clds_hash_table->key_compare_func = key_compare_func;
+                    clds_hash_table->use_bucket_mask = (bucket_indexing == CLDS_HASH_TABLE_BUCKET_INDEXING_POWER_OF_TWO);
+                    clds_hash_table->initial_bucket_count = (int32_t)initial_bucket_size;
+                    clds_hash_table->skipped_seq_no_cb = skipped_seq_no_cb;
+                    clds_hash_table->skipped_seq_no_cb_context = skipped_seq_no_cb_context;
+
+                    (void)interlocked_exchange(&clds_hash_table->write_epoch, 0);
+                    (void)interlocked_exchange(&clds_hash_table->pending_write_operations[0], 0);
+                    (void)interlocked_exchange(&clds_hash_table->pending_write_operations[1], 0);
+                    (void)interlocked_exchange(&clds_hash_table->write_epoch_change_in_progress, 0);
+                    (void)interlocked_exchange(&clds_hash_table->locked_for_write, 0);
+
+                    (void)interlocked_exchange(&clds_hash_table->sequence_number_snapshot_in_progress, SEQUENCE_NUMBER_SNAPSHOT_NONE);
+                    (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hash_table->superseded_items, NULL);
+                    (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hash_table->superseded_item_records, NULL);
+                    (void)interlocked_exchange(&clds_hash_table->superseded_items_lost, 0);
+
+                    (void)interlocked_exchange(&clds_hash_table->open_cursor_count, 0);
+
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_113: [ By default each write operation shall migrate 4 buckets out of the oldest array of buckets and read operations shall not migrate any buckets. ]*/
+                    (void)interlocked_exchange(&clds_hash_table->write_migration_bucket_count, DEFAULT_WRITE_MIGRATION_BUCKET_COUNT);
+                    (void)interlocked_exchange(&clds_hash_table->read_migration_bucket_count, 0);
+                    (void)interlocked_exchange(&clds_hash_table->bucket_array_count, 1);
+                    for (uint32_t i = 0; i < ITEM_MOVE_STRIPE_COUNT; i++)
+                    {
+                        (void)interlocked_exchange(&clds_hash_table->item_move_stripes[i].pending_item_moves, 0);
+                        (void)interlocked_exchange_64(&clds_hash_table->item_move_stripes[i].completed_item_moves, 0);
+                    }
+
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_057: [ start_sequence_number shall be used as the sequence number variable that shall be incremented at every operation that is done on the hash table. ]*/
+                    clds_hash_table->sequence_number = start_sequence_number;
+
+                    // set the initial bucket count
+                    (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table->next_bucket, NULL);
+                    (void)interlocked_exchange(&clds_hash_table->first_hash_table->bucket_count, (int32_t)initial_bucket_size);
+                    init_counter_stripes(clds_hash_table->first_hash_table);
+                    (void)interlocked_exchange(&clds_hash_table->first_hash_table->migration_cursor, 0);
+                    (void)interlocked_exchange(&clds_hash_table->first_hash_table->migrated_bucket_count, 0);
+                    (void)interlocked_exchange(&clds_hash_table->first_hash_table->migration_failed, 0);
+
+                    for (i = 0; i < initial_bucket_size; i++)
+                    {
+                        CLDS_SORTED_LIST_HEAD_INIT(&clds_hash_table->first_hash_table->hash_table[i]);
+                    }
+
+                    goto all_ok;
+                }
+
+                free(clds_hash_table->first_hash_table);
+            }
+
+            free(clds_hash_table);
+        }
+    }
+
+    clds_hash_table = NULL;
+
+all_ok:
+    return clds_hash_table;
+}
+
+CLDS_HASH_TABLE_HANDLE clds_hash_table_create(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context)
+{
+    /* Codes_SRS_CLDS_HASH_TABLE_01_130: [ clds_hash_table_create shall create the hash table the same way clds_hash_table_create_with_bucket_indexing does with bucket_indexing set to CLDS_HASH_TABLE_BUCKET_INDEXING_MODULO. ]*/
+    return internal_create(compute_hash, key_compare_func, initial_bucket_size, clds_hazard_pointers, start_sequence_number, skipped_seq_no_cb, skipped_seq_no_cb_context, CLDS_HASH_TABLE_BUCKET_INDEXING_MODULO);
+}
+
+CLDS_HASH_TABLE_HANDLE clds_hash_table_create_with_bucket_indexing(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context, CLDS_HASH_TABLE_BUCKET_INDEXING bucket_indexing)
+{
+    CLDS_HASH_TABLE_HANDLE clds_hash_table;
+
+    if (
+        (bucket_indexing != CLDS_HASH_TABLE_BUCKET_INDEXING_MODULO) &&
+        (bucket_indexing != CLDS_HASH_TABLE_BUCKET_INDEXING_POWER_OF_TWO)
+        )
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_134: [ If bucket_indexing is not one of the CLDS_HASH_TABLE_BUCKET_INDEXING values, clds_hash_table_create_with_bucket_indexing shall fail and return NULL. ]*/
+        LogError("Invalid arguments: CLDS_HASH_TABLE_BUCKET_INDEXING bucket_indexing=%" PRI_MU_ENUM "",
+            MU_ENUM_VALUE(CLDS_HASH_TABLE_BUCKET_INDEXING, bucket_indexing));
+        clds_hash_table = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_135: [ Otherwise clds_hash_table_create_with_bucket_indexing shall create the hash table the same way clds_hash_table_create does, picking the bucket of a key as indicated by bucket_indexing. ]*/
+        clds_hash_table = internal_create(compute_hash, key_compare_func, initial_bucket_size, clds_hazard_pointers, start_sequence_number, skipped_seq_no_cb, skipped_seq_no_cb_context, bucket_indexing);
+    }
+
+    return clds_hash_table;
+}
+
+static void sorted_list_item_cleanup(void* context, CLDS_SORTED_LIST_ITEM* item)
+{
+    HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
+
+    (void)context;
+    if (hash_table_item->item_cleanup_callback != NULL)
+    {
+        hash_table_item->item_cleanup_callback(hash_table_item->item_cleanup_callback_context, (void*)item);
+    }
+}
+
+void clds_hash_table_destroy(CLDS_HASH_TABLE_HANDLE clds_hash_table)
+{
+    if (clds_hash_table == NULL)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_007: [ If clds_hash_table is NULL, clds_hash_table_destroy shall return. ]*/
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p", clds_hash_table);
+    }
+    else
+    {
+        int32_t i;
+
+        BUCKET_ARRAY* bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+        while (bucket_array != NULL)
+        {
+            BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_array->next_bucket, NULL, NULL);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_006: [ clds_hash_table_destroy shall free all resources associated with the hash table instance. ]*/
+            for (i = 0; i < bucket_array->bucket_count; i++)
+            {
+                clds_sorted_list_head_clear(clds_hash_table->bucket_lists, &bucket_array->hash_table[i]);
+            }
+
+            free(bucket_array);
+            bucket_array = next_bucket_array;
+        }
+
+        clds_sorted_list_destroy(clds_hash_table->bucket_lists);
+        free(clds_hash_table);
+    }
+}
+
+// inserts an item (with its hashed key already set) in the first bucket array, on which the caller has a pending insert
+static CLDS_HASH_TABLE_INSERT_RESULT insert_in_first_bucket_array(CLDS_HASH_TABLE* clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, BUCKET_ARRAY* current_bucket_array, CLDS_HASH_TABLE_ITEM* value, bool snapshot_in_progress, int64_t* write_sequence_number)
+{
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, value);
+    bool found_in_lower_levels = false;
+    bool lower_levels_lookup_failed = false;
+
+    // check if the key exists in the lower level bucket arrays, again if an item was moved to the first array while looking
+    int64_t completed_item_moves;
+    do
+    {
+        completed_item_moves = get_completed_item_moves(clds_hash_table, hash_table_item->hashed_key.hash);
+        if (find_key_in_lower_bucket_arrays(clds_hash_table, clds_hazard_pointers_thread, current_bucket_array, &hash_table_item->hashed_key, &found_in_lower_levels, NULL) != 0)
+        {
+            lower_levels_lookup_failed = true;
+            break;
+        }
+    } while ((!found_in_lower_levels) && items_moved_since(clds_hash_table, hash_table_item->hashed_key.hash, completed_item_moves));
+
+    if (lower_levels_lookup_failed)
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_022: [ If any error is encountered while inserting the key/value pair, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        LogError("Cannot look up the key in the lower level bucket arrays");
+        result = CLDS_HASH_TABLE_INSERT_ERROR;
+    }
+    else if (found_in_lower_levels)
+    {
+        result = CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS;
+    }
+    else
+    {
+        (void)interlocked_increment(&get_counter_stripe(current_bucket_array, clds_hazard_pointers_thread)->item_count);
+
+        // find the bucket
+        /* Codes_SRS_CLDS_HASH_TABLE_01_018: [ clds_hash_table_insert shall obtain the bucket index to be used by calling compute_hash and passing to it the key value. ]*/
+        uint64_t bucket_index = get_bucket_index(clds_hash_table, hash_table_item->hashed_key.hash, interlocked_add(&current_bucket_array->bucket_count, 0));
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_019: [ The sorted list head of the bucket at the determined bucket index shall be used, no list is created for a bucket. ]*/
+        CLDS_SORTED_LIST_HEAD* bucket_list = &current_bucket_array->hash_table[bucket_index];
+        CLDS_SORTED_LIST_INSERT_RESULT list_insert_result;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_021: [ The new sorted list node shall be inserted in the sorted list at the identified bucket by calling clds_sorted_list_head_insert. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_059: [ For each insert the order of the operation shall be computed by passing sequence_number to clds_sorted_list_head_insert. ]*/
+        // an item inserted while no snapshot at a sequence number is taken is older than any snapshot taken later,
+        // otherwise the item is not in the snapshot until its sequence number is known
+        (void)interlocked_exchange_64(&hash_table_item->insert_sequence_number, snapshot_in_progress ? INT64_MAX : INT64_MIN);
+        list_insert_result = clds_sorted_list_head_insert(clds_hash_table->bucket_lists, bucket_list, clds_hazard_pointers_thread, (void*)value, write_sequence_number);
+
+        if (list_insert_result == CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS)
+        {
+            // the item count is what decides when the table grows, so it only counts what got in
+            (void)interlocked_decrement(&get_counter_stripe(current_bucket_array, clds_hazard_pointers_thread)->item_count);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_046: [ If the key already exists in the hash table, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ALREADY_EXISTS. ]*/
+            result = CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS;
+        }
+        else if (list_insert_result != CLDS_SORTED_LIST_INSERT_OK)
+        {
+            (void)interlocked_decrement(&get_counter_stripe(current_bucket_array, clds_hazard_pointers_thread)->item_count);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_022: [ If any error is encountered while inserting the key/value pair, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+            LogError("Cannot insert hash table item into list");
+            result = CLDS_HASH_TABLE_INSERT_ERROR;
+        }
+        else
+        {
+            if (snapshot_in_progress)
+            {
+                (void)interlocked_exchange_64(&hash_table_item->insert_sequence_number, *write_sequence_number);
+            }
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_009: [ On success clds_hash_table_insert shall return CLDS_HASH_TABLE_INSERT_OK. ]*/
+            result = CLDS_HASH_TABLE_INSERT_OK;
+        }
+    }
+
+    return result;
+}
+
+static int presize_first_bucket_array(CLDS_HASH_TABLE* clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint32_t item_count, bool add_items_in_array)
+{
+    int result;
+
+    do
+    {
+        CLDS_HAZARD_POINTER_RECORD_HANDLE first_bucket_array_hp;
+        BUCKET_ARRAY* first_bucket_array = acquire_first_bucket_array(clds_hash_table, clds_hazard_pointers_thread, &first_bucket_array_hp);
+        if (first_bucket_array == NULL)
+        {
+            LogError("Cannot acquire the first bucket array");
+            result = MU_FAILURE;
+            break;
+        }
+
+        int32_t bucket_count = interlocked_add(&first_bucket_array->bucket_count, 0);
+        int32_t item_count_in_array = add_items_in_array ? get_item_count(first_bucket_array) : 0;
+        // the table grows when the number of items reaches the number of buckets
+        int64_t needed_bucket_count = (int64_t)((item_count_in_array > 0) ? item_count_in_array : 0) + item_count + 1;
+        int64_t new_bucket_count = bucket_count;
+
+        // doubling keeps the bucket count a power of two for tables created with CLDS_HASH_TABLE_BUCKET_INDEXING_POWER_OF_TWO
+        while ((new_bucket_count < needed_bucket_count) && (new_bucket_count <= INT32_MAX / 2))
+        {
+            new_bucket_count *= 2;
+        }
+
+        if (new_bucket_count == bucket_count)
+        {
+            // the first array is big enough already
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, first_bucket_array_hp);
+            result = 0;
+            break;
+        }
+
+        BUCKET_ARRAY* new_bucket_array = create_bucket_array((int32_t)new_bucket_count);
+        if (new_bucket_array == NULL)
+        {
+            LogError("Cannot allocate the bucket array for %" PRId64 " buckets", new_bucket_count);
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, first_bucket_array_hp);
+            result = MU_FAILURE;
+            break;
+        }
+
+        (void)interlocked_exchange_pointer((void* volatile_atomic*)&new_bucket_array->next_bucket, first_bucket_array);
+        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, new_bucket_array, first_bucket_array) == first_bucket_array)
+        {
+            (void)interlocked_increment(&clds_hash_table->bucket_array_count);
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, first_bucket_array_hp);
+            result = 0;
+            break;
+        }
+
+        // another write changed the first array in the meantime, size again from that one
+        free(new_bucket_array);
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, first_bucket_array_hp);
+    } while (1);
+
+    return result;
+}
+
+static void migrate_older_bucket_arrays(CLDS_HASH_TABLE* clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    // each pass moves all the items of the oldest array, the passes stop early if an array cannot be migrated right now (it then migrates with the next writes)
+    int32_t bucket_array_count = interlocked_add(&clds_hash_table->bucket_array_count, 0);
+
+    for (int32_t i = 1; i < bucket_array_count; i++)
+    {
+        migrate_buckets_if_needed(clds_hash_table, clds_hazard_pointers_thread, INT32_MAX);
+    }
+}
+
+static int get_item_count_in_all_bucket_arrays(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, BUCKET_ARRAY* first_bucket_array, int64_t* item_count)
+{
+    // the caller protects the first array, each of the next arrays is protected while its items are counted
+    int result = 0;
+    int64_t total_item_count = get_item_count(first_bucket_array);
+    BUCKET_ARRAY* bucket_array = first_bucket_array;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE bucket_array_hp = NULL;
+
+    while (bucket_array != NULL)
+    {
+        BUCKET_ARRAY* next_bucket_array;
+        CLDS_HAZARD_POINTER_RECORD_HANDLE next_bucket_array_hp;
+
+        if (acquire_next_bucket_array(clds_hazard_pointers_thread, bucket_array, &next_bucket_array, &next_bucket_array_hp) != 0)
+        {
+            LogError("Cannot acquire the next bucket array");
+            result = MU_FAILURE;
+            break;
+        }
+
+        if (bucket_array_hp != NULL)
+        {
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, bucket_array_hp);
+        }
+
+        bucket_array = next_bucket_array;
+        bucket_array_hp = next_bucket_array_hp;
+
+        if (bucket_array != NULL)
+        {
+            total_item_count += get_item_count(bucket_array);
+        }
+    }
+
+    if (bucket_array_hp != NULL)
+    {
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, bucket_array_hp);
+    }
+
+    // the counts are approximate while items are inserted and deleted
+    *item_count = (total_item_count > 0) ? total_item_count : 0;
+
+    return result;
+}
+
+static int32_t get_shrunk_bucket_count(CLDS_HASH_TABLE* clds_hash_table, int32_t bucket_count, int64_t item_count)
+{
+    // halving keeps the bucket count a power of two for tables created with CLDS_HASH_TABLE_BUCKET_INDEXING_POWER_OF_TWO,
+    // and leaving room for twice the items keeps the table from growing again right after it was shrunk
+    while (
+        (bucket_count % 2 == 0) &&
+        (bucket_count / 2 >= clds_hash_table->initial_bucket_count) &&
+        ((int64_t)(bucket_count / 2) >= item_count * 2)
+        )
+    {
+        bucket_count /= 2;
+    }
+
+    return bucket_count;
+}
+
+static uint32_t get_insert_batch_partition(CLDS_HASH_TABLE* clds_hash_table, uint64_t hash, int32_t bucket_count, uint32_t partition_count)
+{
+    uint64_t bucket_index = get_bucket_index(clds_hash_table, hash, bucket_count);
+    return (uint32_t)((bucket_index * partition_count) / (uint64_t)bucket_count);
+}
+
+static void insert_batch_items(INSERT_BATCH_CONTEXT* insert_batch_context)
+{
+    CLDS_HASH_TABLE* clds_hash_table = insert_batch_context->clds_hash_table;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = insert_batch_context->clds_hazard_pointers_thread;
+    uint32_t i = 0;
+
+    while (i < insert_batch_context->item_index_count)
+    {
+        uint32_t chunk_end = ((insert_batch_context->item_index_count - i) < INSERT_BATCH_CHUNK_SIZE) ? insert_batch_context->item_index_count : (i + INSERT_BATCH_CHUNK_SIZE);
+        uint32_t write_slot = check_lock_and_begin_write_operation(clds_hash_table);
+        CLDS_HAZARD_POINTER_RECORD_HANDLE current_bucket_array_hp;
+        BUCKET_ARRAY* current_bucket_array = acquire_first_bucket_array_for_insert(clds_hash_table, clds_hazard_pointers_thread, &current_bucket_array_hp);
+
+        if (current_bucket_array == NULL)
+        {
+            // the results of the items left are already CLDS_HASH_TABLE_INSERT_ERROR
+            LogError("Cannot acquire the first bucket array");
+            insert_batch_context->failed = true;
+            end_write_operation(clds_hash_table, write_slot);
+            break;
+        }
+
+        for (; i < chunk_end; i++)
+        {
+            uint32_t item_index = insert_batch_context->item_indices[i];
+            bool snapshot_in_progress = is_sequence_number_snapshot_in_progress(clds_hash_table);
+            int64_t local_sequence_number;
+            int64_t* write_sequence_number = get_write_sequence_number(snapshot_in_progress, (insert_batch_context->sequence_numbers == NULL) ? NULL : &insert_batch_context->sequence_numbers[item_index], &local_sequence_number);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_211: [ Each item shall be inserted in the first array of buckets the same way clds_hash_table_insert inserts an item, results[i] receiving the result of inserting items[i] and, if sequence_numbers is non-NULL, sequence_numbers[i] receiving its sequence number. ]*/
+            insert_batch_context->results[item_index] = insert_in_first_bucket_array(clds_hash_table, clds_hazard_pointers_thread, current_bucket_array, insert_batch_context->items[item_index], snapshot_in_progress, write_sequence_number);
+            if (insert_batch_context->results[item_index] == CLDS_HASH_TABLE_INSERT_ERROR)
+            {
+                insert_batch_context->failed = true;
+            }
+        }
+
+        end_pending_insert(current_bucket_array, clds_hazard_pointers_thread);
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
+        end_write_operation(clds_hash_table, write_slot);
+    }
+}
+
+static int insert_batch_thread_func(void* arg)
+{
+    insert_batch_items(arg);
+    return 0;
+}
+
+CLDS_HASH_TABLE_INSERT_RESULT clds_hash_table_insert(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_010: [ If clds_hash_table is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_011: [ If key is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_012: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_062: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM* value=%p, int64_t* sequence_number=%p",
+            clds_hash_table, clds_hazard_pointers_thread, key, value, sequence_number);
+        result = CLDS_HASH_TABLE_INSERT_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_42_032: [ clds_hash_table_insert shall try the following until it acquires a write lock for the table: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_033: [ clds_hash_table_insert shall increment the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_034: [ If the counter to lock the table for writes is non-zero then: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_035: [ clds_hash_table_insert shall decrement the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_036: [ clds_hash_table_insert shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
+        uint32_t write_slot = check_lock_and_begin_write_operation(clds_hash_table);
+        bool snapshot_in_progress = is_sequence_number_snapshot_in_progress(clds_hash_table);
+        int64_t local_sequence_number;
+        int64_t* write_sequence_number = get_write_sequence_number(snapshot_in_progress, sequence_number, &local_sequence_number);
+
+        HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, value);
+        BUCKET_ARRAY* current_bucket_array;
+        CLDS_HAZARD_POINTER_RECORD_HANDLE current_bucket_array_hp;
+
+        // find or allocate a new bucket array
+        current_bucket_array = acquire_first_bucket_array_for_insert(clds_hash_table, clds_hazard_pointers_thread, &current_bucket_array_hp);
+        if (current_bucket_array == NULL)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_022: [ If any error is encountered while inserting the key/value pair, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+            LogError("Cannot acquire the first bucket array");
+            result = CLDS_HASH_TABLE_INSERT_ERROR;
+        }
+        else
+        {
+            // compute the hash
+            /* Codes_SRS_CLDS_HASH_TABLE_01_038: [ clds_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+            /* Codes_SRS_CLDS_HASH_TABLE_01_020: [ A new sorted list item shall be created by calling clds_sorted_list_node_create. ]*/
+            /* Codes_SRS_CLDS_HASH_TABLE_01_129: [ clds_hash_table_insert shall store the hash of the key in the item, next to the key. ]*/
+            hash_table_item->hashed_key.hash = hash_key(clds_hash_table, key);
+            hash_table_item->hashed_key.key = key;
+
+            result = insert_in_first_bucket_array(clds_hash_table, clds_hazard_pointers_thread, current_bucket_array, value, snapshot_in_progress, write_sequence_number);
+
+            end_pending_insert(current_bucket_array, clds_hazard_pointers_thread);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_114: [ clds_hash_table_insert shall migrate the items of the next buckets of the oldest array of buckets to the first array of buckets. ]*/
+            migrate_buckets_if_needed(clds_hash_table, clds_hazard_pointers_thread, interlocked_add(&clds_hash_table->write_migration_bucket_count, 0));
+
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_42_063: [ clds_hash_table_insert shall decrement the count of pending write operations. ]*/
+        end_write_operation(clds_hash_table, write_slot);
+    }
+    return result;
+}
+
+CLDS_HASH_TABLE_INSERT_RESULT clds_hash_table_get_or_insert(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, HASH_TABLE_ITEM_FACTORY_CB item_factory, void* item_factory_context, CLDS_HASH_TABLE_ITEM** item, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_186: [ If clds_hash_table is NULL, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_187: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_188: [ If key, item_factory or item is NULL, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (key == NULL) ||
+        (item_factory == NULL) ||
+        (item == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_189: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, HASH_TABLE_ITEM_FACTORY_CB item_factory=%p, void* item_factory_context=%p, CLDS_HASH_TABLE_ITEM** item=%p, int64_t* sequence_number=%p",
+            clds_hash_table, clds_hazard_pointers_thread, key, item_factory, item_factory_context, item, sequence_number);
+        result = CLDS_HASH_TABLE_INSERT_ERROR;
+    }
+    else
+    {
+        // same write lock and write epoch handling as clds_hash_table_insert
+        uint32_t write_slot = check_lock_and_begin_write_operation(clds_hash_table);
+        bool snapshot_in_progress = is_sequence_number_snapshot_in_progress(clds_hash_table);
+        int64_t local_sequence_number;
+        int64_t* write_sequence_number = get_write_sequence_number(snapshot_in_progress, sequence_number, &local_sequence_number);
+
+        HASH_TABLE_HASHED_KEY hashed_key;
+        BUCKET_ARRAY* current_bucket_array;
+        CLDS_HAZARD_POINTER_RECORD_HANDLE current_bucket_array_hp;
+        int32_t bucket_count;
+        bool found_in_lower_levels = false;
+        bool lower_levels_lookup_failed = false;
+        CLDS_SORTED_LIST_ITEM* found_item = NULL;
+
+        current_bucket_array = acquire_first_bucket_array_for_insert(clds_hash_table, clds_hazard_pointers_thread, &current_bucket_array_hp);
+        if (current_bucket_array == NULL)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_197: [ If any error occurs, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+            LogError("Cannot acquire the first bucket array");
+            result = CLDS_HASH_TABLE_INSERT_ERROR;
+        }
+        else
+        {
+            bucket_count = interlocked_add(&current_bucket_array->bucket_count, 0);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_190: [ clds_hash_table_get_or_insert shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+            hashed_key.hash = hash_key(clds_hash_table, key);
+            hashed_key.key = key;
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_191: [ clds_hash_table_get_or_insert shall look for the key in all the arrays of buckets except the first one, and if it is found it shall set item to the item in the table and return CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS without calling item_factory. ]*/
+            int64_t completed_item_moves;
+            do
+            {
+                completed_item_moves = get_completed_item_moves(clds_hash_table, hashed_key.hash);
+                if (find_key_in_lower_bucket_arrays(clds_hash_table, clds_hazard_pointers_thread, current_bucket_array, &hashed_key, &found_in_lower_levels, &found_item) != 0)
+                {
+                    lower_levels_lookup_failed = true;
+                    break;
+                }
+            } while ((!found_in_lower_levels) && items_moved_since(clds_hash_table, hashed_key.hash, completed_item_moves));
+
+            if (lower_levels_lookup_failed)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_197: [ If any error occurs, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+                LogError("Cannot look up the key in the lower level bucket arrays");
+                result = CLDS_HASH_TABLE_INSERT_ERROR;
+            }
+            else if (found_in_lower_levels)
+            {
+                *item = (CLDS_HASH_TABLE_ITEM*)found_item;
+                result = CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS;
+            }
+            else
+            {
+                GET_OR_INSERT_FACTORY_CONTEXT factory_context;
+                CLDS_SORTED_LIST_ITEM* list_item;
+                CLDS_SORTED_LIST_INSERT_RESULT list_insert_result;
+
+                (void)interlocked_increment(&get_counter_stripe(current_bucket_array, clds_hazard_pointers_thread)->item_count);
+
+                uint64_t bucket_index = get_bucket_index(clds_hash_table, hashed_key.hash, bucket_count);
+                CLDS_SORTED_LIST_HEAD* bucket_list = &current_bucket_array->hash_table[bucket_index];
+
+                factory_context.item_factory = item_factory;
+                factory_context.item_factory_context = item_factory_context;
+                factory_context.hashed_key = &hashed_key;
+                factory_context.snapshot_in_progress = snapshot_in_progress;
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_192: [ Otherwise clds_hash_table_get_or_insert shall call clds_sorted_list_head_get_or_insert on the bucket of the key in the first array of buckets, so that the key is looked up and the new item is inserted in one pass over the bucket. ]*/
+                list_insert_result = clds_sorted_list_head_get_or_insert(clds_hash_table->bucket_lists, bucket_list, clds_hazard_pointers_thread, &hashed_key, on_sorted_list_item_factory, &factory_context, &list_item, write_sequence_number);
+
+                if (list_insert_result == CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS)
+                {
+                    (void)interlocked_decrement(&get_counter_stripe(current_bucket_array, clds_hazard_pointers_thread)->item_count);
+
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_196: [ If clds_sorted_list_head_get_or_insert returns CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS, clds_hash_table_get_or_insert shall set item to the item in the table and return CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+                    *item = (CLDS_HASH_TABLE_ITEM*)list_item;
+                    result = CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS;
+                }
+                else if (list_insert_result != CLDS_SORTED_LIST_INSERT_OK)
+                {
+                    (void)interlocked_decrement(&get_counter_stripe(current_bucket_array, clds_hazard_pointers_thread)->item_count);
+
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_197: [ If any error occurs, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+                    LogError("Cannot get or insert the key in the bucket list");
+                    result = CLDS_HASH_TABLE_INSERT_ERROR;
+                }
+                else
+                {
+                    if (snapshot_in_progress)
+                    {
+                        HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, list_item);
+                        (void)interlocked_exchange_64(&hash_table_item->insert_sequence_number, *write_sequence_number);
+                    }
+
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_195: [ If clds_sorted_list_head_get_or_insert returns CLDS_SORTED_LIST_INSERT_OK, clds_hash_table_get_or_insert shall set item to the created item and return CLDS_HASH_TABLE_INSERT_OK. ]*/
+                    *item = (CLDS_HASH_TABLE_ITEM*)list_item;
+                    result = CLDS_HASH_TABLE_INSERT_OK;
+                }
+            }
+
+            end_pending_insert(current_bucket_array, clds_hazard_pointers_thread);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_198: [ clds_hash_table_get_or_insert shall migrate the items of the next buckets of the oldest array of buckets to the first array of buckets. ]*/
+            migrate_buckets_if_needed(clds_hash_table, clds_hazard_pointers_thread, interlocked_add(&clds_hash_table->write_migration_bucket_count, 0));
+
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
+        }
+
+        end_write_operation(clds_hash_table, write_slot);
+    }
+
+    return result;
+}
+
+int clds_hash_table_insert_batch(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void** keys, CLDS_HASH_TABLE_ITEM** items, uint32_t item_count, uint32_t thread_count, CLDS_HASH_TABLE_INSERT_RESULT* results, int64_t* sequence_numbers)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_199: [ If clds_hash_table is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_200: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_201: [ If keys, items or results is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+        (keys == NULL) ||
+        (items == NULL) ||
+        (results == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_202: [ If thread_count is 0, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+        (thread_count == 0) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_203: [ If the sequence_numbers argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+        ((sequence_numbers != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void** keys=%p, CLDS_HASH_TABLE_ITEM** items=%p, uint32_t item_count=%" PRIu32 ", uint32_t thread_count=%" PRIu32 ", CLDS_HASH_TABLE_INSERT_RESULT* results=%p, int64_t* sequence_numbers=%p",
+            clds_hash_table, clds_hazard_pointers_thread, keys, items, item_count, thread_count, results, sequence_numbers);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        uint32_t i;
+
+        for (i = 0; i < item_count; i++)
+        {
+            if ((keys[i] == NULL) || (items[i] == NULL))
+            {
+                break;
+            }
+        }
+
+        if (i < item_count)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_204: [ If any of the keys or items is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+            LogError("Invalid arguments: void** keys=%p, CLDS_HASH_TABLE_ITEM** items=%p, keys[%" PRIu32 "]=%p, items[%" PRIu32 "]=%p", keys, items, i, keys[i], i, items[i]);
+            result = MU_FAILURE;
+        }
+        else if (item_count == 0)
+        {
+            // nothing to insert
+            result = 0;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_205: [ clds_hash_table_insert_batch shall set all the results to CLDS_HASH_TABLE_INSERT_ERROR before inserting any item, so that the items that could not be inserted are reported as not inserted. ]*/
+            for (i = 0; i < item_count; i++)
+            {
+                results[i] = CLDS_HASH_TABLE_INSERT_ERROR;
+            }
+
+            if (thread_count > item_count)
+            {
+                thread_count = item_count;
+            }
+
+            uint32_t* item_indices = malloc_2(item_count, sizeof(uint32_t));
+            INSERT_BATCH_CONTEXT* insert_batch_contexts = malloc_2(thread_count, sizeof(INSERT_BATCH_CONTEXT));
+            if ((item_indices == NULL) || (insert_batch_contexts == NULL))
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_214: [ If any item could not be inserted because of an error, or any other error occurs, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+                LogError("malloc_2(item_count=%" PRIu32 ", sizeof(uint32_t)=%zu) or malloc_2(thread_count=%" PRIu32 ", sizeof(INSERT_BATCH_CONTEXT)=%zu) failed",
+                    item_count, sizeof(uint32_t), thread_count, sizeof(INSERT_BATCH_CONTEXT));
+                result = MU_FAILURE;
+            }
+            else
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_206: [ clds_hash_table_insert_batch shall hash all the keys by calling the compute_hash function passed to clds_hash_table_create and store the hash and the key in each item. ]*/
+                for (i = 0; i < item_count; i++)
+                {
+                    HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, items[i]);
+                    hash_table_item->hashed_key.hash = hash_key(clds_hash_table, keys[i]);
+                    hash_table_item->hashed_key.key = keys[i];
+                }
+
+                uint32_t write_slot = check_lock_and_begin_write_operation(clds_hash_table);
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_207: [ If the first array of buckets has fewer buckets than the items in it plus item_count, clds_hash_table_insert_batch shall add a new first array of buckets, with the number of buckets doubled as many times as needed to hold all the items. ]*/
+                if (presize_first_bucket_array(clds_hash_table, clds_hazard_pointers_thread, item_count, true) != 0)
+                {
+                    // the table grows as the items are inserted, only slower
+                    LogError("Cannot size the first bucket array for %" PRIu32 " more items", item_count);
+                }
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_208: [ clds_hash_table_insert_batch shall migrate all the items of the older arrays of buckets to the first array of buckets, so that only one array of buckets is left. ]*/
+                migrate_older_bucket_arrays(clds_hash_table, clds_hazard_pointers_thread);
+
+                end_write_operation(clds_hash_table, write_slot);
+
+                CLDS_HAZARD_POINTER_RECORD_HANDLE first_bucket_array_hp;
+                BUCKET_ARRAY* first_bucket_array = acquire_first_bucket_array(clds_hash_table, clds_hazard_pointers_thread, &first_bucket_array_hp);
+                if (first_bucket_array == NULL)
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_214: [ If any item could not be inserted because of an error, or any other error occurs, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+                    LogError("Cannot acquire the first bucket array");
+                    result = MU_FAILURE;
+                }
+                else
+                {
+                    int32_t bucket_count = interlocked_add(&first_bucket_array->bucket_count, 0);
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, first_bucket_array_hp);
+
+                    uint32_t partition_count = thread_count * INSERT_BATCH_PARTITIONS_PER_THREAD;
+                    if (partition_count > (uint32_t)bucket_count)
+                    {
+                        partition_count = (uint32_t)bucket_count;
+                    }
+
+                    uint32_t* partition_starts = malloc_2((size_t)partition_count + 1, sizeof(uint32_t));
+                    if (partition_starts == NULL)
+                    {
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_214: [ If any item could not be inserted because of an error, or any other error occurs, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+                        LogError("malloc_2((size_t)partition_count + 1=%zu, sizeof(uint32_t)=%zu) failed", (size_t)partition_count + 1, sizeof(uint32_t));
+                        result = MU_FAILURE;
+                    }
+                    else
+                    {
+                        uint32_t partition;
+
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_209: [ clds_hash_table_insert_batch shall order the items by the range of buckets they fall in and give each of the thread_count threads the items of a contiguous range of buckets. ]*/
+                        // counting sort of the items by partition (a range of buckets), partition_starts[p + 1] first counts the items of p
+                        for (partition = 0; partition <= partition_count; partition++)
+                        {
+                            partition_starts[partition] = 0;
+                        }
+
+                        for (i = 0; i < item_count; i++)
+                        {
+                            partition = get_insert_batch_partition(clds_hash_table, CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, items[i])->hashed_key.hash, bucket_count, partition_count);
+                            partition_starts[partition + 1]++;
+                        }
+
+                        for (partition = 0; partition < partition_count; partition++)
+                        {
+                            partition_starts[partition + 1] += partition_starts[partition];
+                        }
+
+                        // partition_starts[p] is used as the next free position of p while placing the items, which leaves it at the start of p + 1
+                        for (i = 0; i < item_count; i++)
+                        {
+                            partition = get_insert_batch_partition(clds_hash_table, CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, items[i])->hashed_key.hash, bucket_count, partition_count);
+                            item_indices[partition_starts[partition]] = i;
+                            partition_starts[partition]++;
+                        }
+
+                        for (uint32_t thread_index = 0; thread_index < thread_count; thread_index++)
+                        {
+                            // the partitions are shifted by one after the placement, the items of partitions [first, last) start at partition_starts[first - 1]
+                            uint32_t first_partition = (uint32_t)(((uint64_t)thread_index * partition_count) / thread_count);
+                            uint32_t last_partition = (uint32_t)(((uint64_t)(thread_index + 1) * partition_count) / thread_count);
+                            uint32_t first_item = (first_partition == 0) ? 0 : partition_starts[first_partition - 1];
+                            uint32_t last_item = (last_partition == 0) ? 0 : partition_starts[last_partition - 1];
+
+                            insert_batch_contexts[thread_index].clds_hash_table = clds_hash_table;
+                            insert_batch_contexts[thread_index].clds_hazard_pointers_thread = clds_hazard_pointers_thread;
+                            insert_batch_contexts[thread_index].items = items;
+                            insert_batch_contexts[thread_index].results = results;
+                            insert_batch_contexts[thread_index].sequence_numbers = sequence_numbers;
+                            insert_batch_contexts[thread_index].item_indices = &item_indices[first_item];
+                            insert_batch_contexts[thread_index].item_index_count = last_item - first_item;
+                            insert_batch_contexts[thread_index].failed = false;
+                            insert_batch_contexts[thread_index].has_own_thread = false;
+                            insert_batch_contexts[thread_index].own_hazard_pointers_thread = false;
+                        }
+
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_210: [ For each thread but the first, clds_hash_table_insert_batch shall register a hazard pointers thread and create a thread by calling ThreadAPI_Create, the calling thread inserting the items of the first thread. ]*/
+                        for (uint32_t thread_index = 1; thread_index < thread_count; thread_index++)
+                        {
+                            INSERT_BATCH_CONTEXT* insert_batch_context = &insert_batch_contexts[thread_index];
+                            CLDS_HAZARD_POINTERS_THREAD_HANDLE worker_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hash_table->clds_hazard_pointers);
+                            if (worker_hazard_pointers_thread == NULL)
+                            {
+                                /* Codes_SRS_CLDS_HASH_TABLE_01_212: [ If registering the hazard pointers thread or creating the thread fails, the calling thread shall insert the items of that thread. ]*/
+                                LogError("Cannot register a hazard pointers thread for inserting the batch, the calling thread inserts its items");
+                            }
+                            else
+                            {
+                                insert_batch_context->clds_hazard_pointers_thread = worker_hazard_pointers_thread;
+                                insert_batch_context->own_hazard_pointers_thread = true;
+
+                                if (ThreadAPI_Create(&insert_batch_context->thread_handle, insert_batch_thread_func, insert_batch_context) != THREADAPI_OK)
+                                {
+                                    /* Codes_SRS_CLDS_HASH_TABLE_01_212: [ If registering the hazard pointers thread or creating the thread fails, the calling thread shall insert the items of that thread. ]*/
+                                    LogError("ThreadAPI_Create failed, the calling thread inserts the items of the thread");
+                                    clds_hazard_pointers_unregister_thread(worker_hazard_pointers_thread);
+                                    insert_batch_context->clds_hazard_pointers_thread = clds_hazard_pointers_thread;
+                                    insert_batch_context->own_hazard_pointers_thread = false;
+                                }
+                                else
+                                {
+                                    insert_batch_context->has_own_thread = true;
+                                }
+                            }
+                        }
+
+                        for (uint32_t thread_index = 0; thread_index < thread_count; thread_index++)
+                        {
+                            if (!insert_batch_contexts[thread_index].has_own_thread)
+                            {
+                                insert_batch_items(&insert_batch_contexts[thread_index]);
+                            }
+                        }
+
+                        result = 0;
+
+                        for (uint32_t thread_index = 0; thread_index < thread_count; thread_index++)
+                        {
+                            INSERT_BATCH_CONTEXT* insert_batch_context = &insert_batch_contexts[thread_index];
+
+                            if (insert_batch_context->has_own_thread)
+                            {
+                                /* Codes_SRS_CLDS_HASH_TABLE_01_213: [ clds_hash_table_insert_batch shall wait for the threads it created by calling ThreadAPI_Join and unregister their hazard pointers threads. ]*/
+                                int dont_care;
+                                if (ThreadAPI_Join(insert_batch_context->thread_handle, &dont_care) != THREADAPI_OK)
+                                {
+                                    LogError("ThreadAPI_Join failed");
+                                }
+                            }
+
+                            if (insert_batch_context->own_hazard_pointers_thread)
+                            {
+                                clds_hazard_pointers_unregister_thread(insert_batch_context->clds_hazard_pointers_thread);
+                            }
+
+                            if (insert_batch_context->failed)
+                            {
+                                /* Codes_SRS_CLDS_HASH_TABLE_01_214: [ If any item could not be inserted because of an error, or any other error occurs, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+                                result = MU_FAILURE;
+                            }
+                        }
+
+                        if (result != 0)
+                        {
+                            LogError("Not all the items of the batch could be inserted");
+                        }
+
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_215: [ Otherwise clds_hash_table_insert_batch shall succeed and return 0, the items whose key was already in the hash table having their result set to CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+
+                        free(partition_starts);
+                    }
+                }
+            }
+
+            free(insert_batch_contexts);
+            free(item_indices);
+        }
+    }
+
+    return result;
+}
+
+static bool find_by_key_value(void* item_compare_context, CLDS_SORTED_LIST_ITEM* item)
+{
+    bool result;
+    FIND_BY_KEY_VALUE_CONTEXT* find_by_key_value_context = item_compare_context;
+    HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
+
+    if ((item != find_by_key_value_context->value) ||
+        (find_by_key_value_context->key_compare_func(hash_table_item->hashed_key.key, find_by_key_value_context->key) != 0))
+    {
+        result = false;
+    }
+    else
+    {
+        result = true;
+    }
+
+    return result;
+}
+
+static CLDS_SORTED_LIST_DELETE_RESULT delete_key_keeping_superseded_item(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_SORTED_LIST_HEAD* bucket_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, HASH_TABLE_HASHED_KEY* hashed_key, int64_t* sequence_number)
+{
+    CLDS_SORTED_LIST_DELETE_RESULT result;
+    CLDS_SORTED_LIST_ITEM* removed_item;
+
+    // the item is removed instead of deleted, so that it can be kept for the snapshot at a sequence number in progress
+    CLDS_SORTED_LIST_REMOVE_RESULT list_remove_result = clds_sorted_list_head_remove_key(clds_hash_table->bucket_lists, bucket_list, clds_hazard_pointers_thread, hashed_key, &removed_item, sequence_number);
+    switch (list_remove_result)
+    {
+    default:
+    case CLDS_SORTED_LIST_REMOVE_ERROR:
+        result = CLDS_SORTED_LIST_DELETE_ERROR;
+        break;
+
+    case CLDS_SORTED_LIST_REMOVE_NOT_FOUND:
+        result = CLDS_SORTED_LIST_DELETE_NOT_FOUND;
+        break;
+
+    case CLDS_SORTED_LIST_REMOVE_OK:
+        keep_superseded_item(clds_hash_table, removed_item, *sequence_number);
+        clds_sorted_list_node_release(removed_item);
+        result = CLDS_SORTED_LIST_DELETE_OK;
+        break;
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_DELETE_RESULT clds_hash_table_delete(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_015: [ If clds_hash_table is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_017: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_016: [ If key is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_066: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, int64_t* sequence_number=%p",
+            clds_hash_table, key, clds_hazard_pointers_thread, sequence_number);
+        result = CLDS_HASH_TABLE_DELETE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_42_037: [ clds_hash_table_delete shall try the following until it acquires a write lock for the table: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_038: [ clds_hash_table_delete shall increment the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_039: [ If the counter to lock the table for writes is non-zero then: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_040: [ clds_hash_table_delete shall decrement the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_041: [ clds_hash_table_delete shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
+        uint32_t write_slot = check_lock_and_begin_write_operation(clds_hash_table);
+        bool snapshot_in_progress = is_sequence_number_snapshot_in_progress(clds_hash_table);
+        int64_t local_sequence_number;
+        int64_t* write_sequence_number = get_write_sequence_number(snapshot_in_progress, sequence_number, &local_sequence_number);
+
+        CLDS_SORTED_LIST_HEAD* bucket_list;
+        BUCKET_ARRAY* current_bucket_array;
+
+        // compute the hash
+        /* Codes_SRS_CLDS_HASH_TABLE_01_039: [ clds_hash_table_delete shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+        uint64_t hash = hash_key(clds_hash_table, key);
+        HASH_TABLE_HASHED_KEY hashed_key = { hash, key };
+
+        // always delete starting with the first bucket array
+        /* Codes_SRS_CLDS_HASH_TABLE_01_101: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
+        int64_t completed_item_moves;
+        do
+        {
+            CLDS_HAZARD_POINTER_RECORD_HANDLE current_bucket_array_hp;
+
+            result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+
+            completed_item_moves = get_completed_item_moves(clds_hash_table, hash);
+            current_bucket_array = acquire_first_bucket_array(clds_hash_table, clds_hazard_pointers_thread, &current_bucket_array_hp);
+            if (current_bucket_array == NULL)
+            {
+                LogError("Cannot acquire the first bucket array");
+                result = CLDS_HASH_TABLE_DELETE_ERROR;
+                break;
+            }
+
+            while (current_bucket_array != NULL)
+            {
+                // find the bucket
+                uint64_t bucket_index = get_bucket_index(clds_hash_table, hash, interlocked_add(&current_bucket_array->bucket_count, 0));
+
+                bucket_list = &current_bucket_array->hash_table[bucket_index];
+                if (CLDS_SORTED_LIST_HEAD_IS_EMPTY(bucket_list))
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+                    result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+                }
+                else
+                {
+                    CLDS_SORTED_LIST_DELETE_RESULT list_delete_result;
+
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_063: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_key. ]*/
+                    if (snapshot_in_progress)
+                    {
+                        list_delete_result = delete_key_keeping_superseded_item(clds_hash_table, bucket_list, clds_hazard_pointers_thread, &hashed_key, write_sequence_number);
+                    }
+                    else
+                    {
+                        list_delete_result = clds_sorted_list_head_delete_key(clds_hash_table->bucket_lists, bucket_list, clds_hazard_pointers_thread, &hashed_key, sequence_number);
+                    }
+                    if (list_delete_result == CLDS_SORTED_LIST_DELETE_NOT_FOUND)
+                    {
+                        // not found
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+                    }
+                    else if (list_delete_result == CLDS_SORTED_LIST_DELETE_OK)
+                    {
+                        (void)interlocked_decrement(&get_counter_stripe(current_bucket_array, clds_hazard_pointers_thread)->item_count);
+
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_014: [ On success clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_OK. ]*/
+                        result = CLDS_HASH_TABLE_DELETE_OK;
+                        break;
+                    }
+                    else
+                    {
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_024: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+                        result = CLDS_HASH_TABLE_DELETE_ERROR;
+                        break;
+                    }
+                }
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_025: [ If the element to be deleted is not found in an array of buckets, then it shall be looked up in the next available array of buckets. ] */
+                BUCKET_ARRAY* next_bucket_array;
+                CLDS_HAZARD_POINTER_RECORD_HANDLE next_bucket_array_hp;
+                if (acquire_next_bucket_array(clds_hazard_pointers_thread, current_bucket_array, &next_bucket_array, &next_bucket_array_hp) != 0)
+                {
+                    LogError("Cannot acquire the next bucket array");
+                    result = CLDS_HASH_TABLE_DELETE_ERROR;
+                    break;
+                }
+
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
+                current_bucket_array = next_bucket_array;
+                current_bucket_array_hp = next_bucket_array_hp;
+            }
+
+            if (current_bucket_array != NULL)
+            {
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
+            }
+
+            // the item might have been moved to the first array while it was looked up, in which case look again
+        } while ((result == CLDS_HASH_TABLE_DELETE_NOT_FOUND) && items_moved_since(clds_hash_table, hash, completed_item_moves));
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_115: [ clds_hash_table_delete shall migrate the items of the next buckets of the oldest array of buckets to the first array of buckets. ]*/
+        migrate_buckets_if_needed(clds_hash_table, clds_hazard_pointers_thread, interlocked_add(&clds_hash_table->write_migration_bucket_count, 0));
+
+        /* Codes_SRS_CLDS_HASH_TABLE_42_042: [ clds_hash_table_insert shall decrement the count of pending write operations. ]*/
+        end_write_operation(clds_hash_table, write_slot);
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_DELETE_RESULT clds_hash_table_delete_key_value(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+
+    if (
+        /*Codes_SRS_CLDS_HASH_TABLE_42_003: [ If clds_hash_table is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /*Codes_SRS_CLDS_HASH_TABLE_42_005: [ If key is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (key == NULL) ||
+        /*Codes_SRS_CLDS_HASH_TABLE_42_006: [ If value is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (value == NULL) ||
+        /*Codes_SRS_CLDS_HASH_TABLE_42_004: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /*Codes_SRS_CLDS_HASH_TABLE_42_012: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM* value=%p, int64_t* sequence_number=%p",
+            clds_hash_table, key, value, clds_hazard_pointers_thread, sequence_number);
+        result = CLDS_HASH_TABLE_DELETE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_42_043: [ clds_hash_table_delete_key_value shall try the following until it acquires a write lock for the table: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_044: [ clds_hash_table_delete_key_value shall increment the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_045: [ If the counter to lock the table for writes is non-zero then: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_046: [ clds_hash_table_delete_key_value shall decrement the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_047: [ clds_hash_table_delete_key_value shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
+        uint32_t write_slot = check_lock_and_begin_write_operation(clds_hash_table);
+        bool snapshot_in_progress = is_sequence_number_snapshot_in_progress(clds_hash_table);
+        int64_t local_sequence_number;
+        int64_t* write_sequence_number = get_write_sequence_number(snapshot_in_progress, sequence_number, &local_sequence_number);
+
+        CLDS_SORTED_LIST_HEAD* bucket_list;
+        BUCKET_ARRAY* current_bucket_array;
+
+        // compute the hash
+        /*Codes_SRS_CLDS_HASH_TABLE_42_001: [ clds_hash_table_delete_key_value shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+        uint64_t hash = hash_key(clds_hash_table, key);
+
+        // always insert in the first bucket array
+        /*Codes_SRS_CLDS_HASH_TABLE_42_007: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
+        int64_t completed_item_moves;
+        do
+        {
+            CLDS_HAZARD_POINTER_RECORD_HANDLE current_bucket_array_hp;
+
+            result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+
+            completed_item_moves = get_completed_item_moves(clds_hash_table, hash);
+            current_bucket_array = acquire_first_bucket_array(clds_hash_table, clds_hazard_pointers_thread, &current_bucket_array_hp);
+            if (current_bucket_array == NULL)
+            {
+                LogError("Cannot acquire the first bucket array");
+                result = CLDS_HASH_TABLE_DELETE_ERROR;
+                break;
+            }
+
+            while (current_bucket_array != NULL)
+            {
+                // find the bucket
+                uint64_t bucket_index = get_bucket_index(clds_hash_table, hash, interlocked_add(&current_bucket_array->bucket_count, 0));
+
+                bucket_list = &current_bucket_array->hash_table[bucket_index];
+                if (CLDS_SORTED_LIST_HEAD_IS_EMPTY(bucket_list))
+                {
+                    /*Codes_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+                    result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+                }
+                else
+                {
+                    CLDS_SORTED_LIST_DELETE_RESULT list_delete_result;
+
+                    /*Codes_SRS_CLDS_HASH_TABLE_42_011: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_item. ]*/
+                    list_delete_result = clds_sorted_list_head_delete_item(clds_hash_table->bucket_lists, bucket_list, clds_hazard_pointers_thread, (void*)value, write_sequence_number);
+                    if (list_delete_result == CLDS_SORTED_LIST_DELETE_NOT_FOUND)
+                    {
+                        // not found
+                    }
+                    else if (list_delete_result == CLDS_SORTED_LIST_DELETE_OK)
+                    {
+                        if (snapshot_in_progress)
+                        {
+                            // the caller still has its reference on value
+                            keep_superseded_item(clds_hash_table, (void*)value, *write_sequence_number);
+                        }
+
+                        (void)interlocked_decrement(&get_counter_stripe(current_bucket_array, clds_hazard_pointers_thread)->item_count);
+
+                        /*Codes_SRS_CLDS_HASH_TABLE_42_002: [ On success clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_OK. ]*/
+                        result = CLDS_HASH_TABLE_DELETE_OK;
+                        break;
+                    }
+                    else
+                    {
+                        /*Codes_SRS_CLDS_HASH_TABLE_42_009: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+                        result = CLDS_HASH_TABLE_DELETE_ERROR;
+                        break;
+                    }
+                }
+
+                /*Codes_SRS_CLDS_HASH_TABLE_42_010: [ If the element to be deleted is not found in an array of buckets, then clds_hash_table_delete_key_value shall look in the next available array of buckets. ]*/
+                BUCKET_ARRAY* next_bucket_array;
+                CLDS_HAZARD_POINTER_RECORD_HANDLE next_bucket_array_hp;
+                if (acquire_next_bucket_array(clds_hazard_pointers_thread, current_bucket_array, &next_bucket_array, &next_bucket_array_hp) != 0)
+                {
+                    LogError("Cannot acquire the next bucket array");
+                    result = CLDS_HASH_TABLE_DELETE_ERROR;
+                    break;
+                }
+
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
+                current_bucket_array = next_bucket_array;
+                current_bucket_array_hp = next_bucket_array_hp;
+            }
+
+            if (current_bucket_array != NULL)
+            {
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
+            }
+
+            // the item might have been moved to the first array while it was looked up, in which case look again
+        } while ((result == CLDS_HASH_TABLE_DELETE_NOT_FOUND) && items_moved_since(clds_hash_table, hash, completed_item_moves));
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_116: [ clds_hash_table_delete_key_value shall migrate the items of the next buckets of the oldest array of buckets to the first array of buckets. ]*/
+        migrate_buckets_if_needed(clds_hash_table, clds_hazard_pointers_thread, interlocked_add(&clds_hash_table->write_migration_bucket_count, 0));
+
+        /* Codes_SRS_CLDS_HASH_TABLE_42_048: [ clds_hash_table_delete_key_value shall decrement the count of pending write operations. ]*/
+        end_write_operation(clds_hash_table, write_slot);
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_REMOVE_RESULT clds_hash_table_remove(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM** item, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_050: [ If clds_hash_table is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_052: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_051: [ If key is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_056: [ If item is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        (item == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_070: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM** item=%p, int64_t* sequence_number=%p",
+            clds_hash_table, key, clds_hazard_pointers_thread, item, sequence_number);
+        result = CLDS_HASH_TABLE_REMOVE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_42_049: [ clds_hash_table_remove shall try the following until it acquires a write lock for the table: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_050: [ clds_hash_table_remove shall increment the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_051: [ If the counter to lock the table for writes is non-zero then: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_052: [ clds_hash_table_remove shall decrement the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_053: [ clds_hash_table_remove shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
+        uint32_t write_slot = check_lock_and_begin_write_operation(clds_hash_table);
+        bool snapshot_in_progress = is_sequence_number_snapshot_in_progress(clds_hash_table);
+        int64_t local_sequence_number;
+        int64_t* write_sequence_number = get_write_sequence_number(snapshot_in_progress, sequence_number, &local_sequence_number);
+
+        CLDS_SORTED_LIST_HEAD* bucket_list;
+        BUCKET_ARRAY* current_bucket_array;
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_047: [ clds_hash_table_remove shall remove a key from the hash table and return a pointer to the item to the user. ]*/
 
-            free(bucket_array);
-            bucket_array = next_bucket_array;
-        }
+        // compute the hash
+        /* Codes_SRS_CLDS_HASH_TABLE_01_048: [ clds_hash_table_remove shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+        uint64_t hash = hash_key(clds_hash_table, key);
+        HASH_TABLE_HASHED_KEY hashed_key = { hash, key };
 
-        free(clds_hash_table);
+        // always insert in the first bucket array
+        int64_t completed_item_moves;
+        do
+        {
+            CLDS_HAZARD_POINTER_RECORD_HANDLE current_bucket_array_hp;
+
+            result = CLDS_HASH_TABLE_REMOVE_NOT_FOUND;
+
+            completed_item_moves = get_completed_item_moves(clds_hash_table, hash);
+            current_bucket_array = acquire_first_bucket_array(clds_hash_table, clds_hazard_pointers_thread, &current_bucket_array_hp);
+            if (current_bucket_array == NULL)
+            {
+                LogError("Cannot acquire the first bucket array");
+                result = CLDS_HASH_TABLE_REMOVE_ERROR;
+                break;
+            }
+
+            while (current_bucket_array != NULL)
+            {
+                // find the bucket
+                uint64_t bucket_index = get_bucket_index(clds_hash_table, hash, interlocked_add(&current_bucket_array->bucket_count, 0));
+
+                bucket_list = &current_bucket_array->hash_table[bucket_index];
+                if (CLDS_SORTED_LIST_HEAD_IS_EMPTY(bucket_list))
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_053: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
+                    result = CLDS_HASH_TABLE_REMOVE_NOT_FOUND;
+                }
+                else
+                {
+                    CLDS_SORTED_LIST_REMOVE_RESULT list_remove_result;
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_067: [ For each remove the order of the operation shall be computed by passing sequence_number to clds_sorted_list_remove_key. ]*/
+                    list_remove_result = clds_sorted_list_head_remove_key(clds_hash_table->bucket_lists, bucket_list, clds_hazard_pointers_thread, &hashed_key, (void*)item, write_sequence_number);
+                    if (list_remove_result == CLDS_SORTED_LIST_REMOVE_NOT_FOUND)
+                    {
+                        // not found
+                    }
+                    else if (list_remove_result == CLDS_SORTED_LIST_REMOVE_OK)
+                    {
+                        if (snapshot_in_progress)
+                        {
+                            keep_superseded_item(clds_hash_table, (void*)*item, *write_sequence_number);
+                        }
+
+                        (void)interlocked_decrement(&get_counter_stripe(current_bucket_array, clds_hazard_pointers_thread)->item_count);
+
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_049: [ On success clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_OK. ]*/
+                        result = CLDS_HASH_TABLE_REMOVE_OK;
+                        break;
+                    }
+                    else
+                    {
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_054: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+                        result = CLDS_HASH_TABLE_REMOVE_ERROR;
+                        break;
+                    }
+                }
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_055: [ If the element to be deleted is not found in the biggest array of buckets, then it shall be looked up in the next available array of buckets. ]*/
+                BUCKET_ARRAY* next_bucket_array;
+                CLDS_HAZARD_POINTER_RECORD_HANDLE next_bucket_array_hp;
+                if (acquire_next_bucket_array(clds_hazard_pointers_thread, current_bucket_array, &next_bucket_array, &next_bucket_array_hp) != 0)
+                {
+                    LogError("Cannot acquire the next bucket array");
+                    result = CLDS_HASH_TABLE_REMOVE_ERROR;
+                    break;
+                }
+
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
+                current_bucket_array = next_bucket_array;
+                current_bucket_array_hp = next_bucket_array_hp;
+            }
+
+            if (current_bucket_array != NULL)
+            {
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
+            }
+
+            // the item might have been moved to the first array while it was looked up, in which case look again
+        } while ((result == CLDS_HASH_TABLE_REMOVE_NOT_FOUND) && items_moved_since(clds_hash_table, hash, completed_item_moves));
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_117: [ clds_hash_table_remove shall migrate the items of the next buckets of the oldest array of buckets to the first array of buckets. ]*/
+        migrate_buckets_if_needed(clds_hash_table, clds_hazard_pointers_thread, interlocked_add(&clds_hash_table->write_migration_bucket_count, 0));
+
+        /* Codes_SRS_CLDS_HASH_TABLE_42_054: [ clds_hash_table_remove shall decrement the count of pending write operations. ]*/
+        end_write_operation(clds_hash_table, write_slot);
     }
+
+    return result;
 }
 
-CLDS_HASH_TABLE_INSERT_RESULT clds_hash_table_insert(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, int64_t* sequence_number)
+CLDS_HASH_TABLE_SET_VALUE_RESULT clds_hash_table_set_value(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* new_item, CONDITION_CHECK_CB condition_check_func, void* condition_check_context, CLDS_HASH_TABLE_ITEM** old_item, int64_t* sequence_number)
 {
-    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
 
     if (
-        /* Codes_SRS_CLDS_HASH_TABLE_01_010: [ If clds_hash_table is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_079: [ If clds_hash_table is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
         (clds_hash_table == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_011: [ If key is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
-        (key == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_012: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_080: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
         (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_062: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_081: [ If key is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_082: [ If new_item is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (new_item == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_083: [ If old_item is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (old_item == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_084: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
         ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
         )
     {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM* value=%p, int64_t* sequence_number=%p",
-            clds_hash_table, clds_hazard_pointers_thread, key, value, sequence_number);
-        result = CLDS_HASH_TABLE_INSERT_ERROR;
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM* new_item=%p, CONDITION_CHECK_CB condition_check_func=%p, void* condition_check_context=%p, CLDS_HASH_TABLE_ITEM** old_item=%p, int64_t* sequence_number=%p",
+            clds_hash_table, key, clds_hazard_pointers_thread, new_item, condition_check_func, condition_check_context, old_item, sequence_number);
+        result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
     }
     else
     {
-        /* Codes_SRS_CLDS_HASH_TABLE_42_032: [ clds_hash_table_insert shall try the following until it acquires a write lock for the table: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_033: [ clds_hash_table_insert shall increment the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_034: [ If the counter to lock the table for writes is non-zero then: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_035: [ clds_hash_table_insert shall decrement the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_036: [ clds_hash_table_insert shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
-        check_lock_and_begin_write_operation(clds_hash_table);
-
-        bool restart_needed;
-        CLDS_SORTED_LIST_HANDLE bucket_list = NULL;
-        HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, value);
-        uint64_t hash;
-        BUCKET_ARRAY* current_bucket_array;
-        int32_t bucket_count;
         uint64_t bucket_index;
-        bool found_in_lower_levels = false;
+        CLDS_SORTED_LIST_HEAD* bucket_list;
 
-        // find or allocate a new bucket array
-        current_bucket_array = get_first_bucket_array(clds_hash_table);
-        bucket_count = interlocked_add(&current_bucket_array->bucket_count, 0);
-
-        (void)interlocked_increment(&current_bucket_array->pending_insert_count);
+        /* Codes_SRS_CLDS_HASH_TABLE_42_055: [ clds_hash_table_set_value shall try the following until it acquires a write lock for the table: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_056: [ clds_hash_table_set_value shall increment the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_057: [ If the counter to lock the table for writes is non-zero then: ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_058: [ clds_hash_table_set_value shall decrement the count of pending write operations. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_059: [ clds_hash_table_set_value shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
+        uint32_t write_slot = check_lock_and_begin_write_operation(clds_hash_table);
+        bool snapshot_in_progress = is_sequence_number_snapshot_in_progress(clds_hash_table);
+        int64_t local_sequence_number;
+        int64_t* write_sequence_number = get_write_sequence_number(snapshot_in_progress, sequence_number, &local_sequence_number);
 
         // compute the hash
-        /* Codes_SRS_CLDS_HASH_TABLE_01_038: [ clds_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-        hash = clds_hash_table->compute_hash(key);
+        uint64_t hash = hash_key(clds_hash_table, key);
+        HASH_TABLE_HASHED_KEY hashed_key = { hash, key };
 
-        found_in_lower_levels = false;
+        // the sorted list passes the hashed keys of the items to the condition check, the user callback gets the keys
+        CONDITION_CHECK_CONTEXT hashed_key_condition_check_context = { condition_check_func, condition_check_context };
+        CONDITION_CHECK_CB list_condition_check_func = (condition_check_func == NULL) ? NULL : on_sorted_list_condition_check;
+        void* list_condition_check_context = (condition_check_func == NULL) ? NULL : &hashed_key_condition_check_context;
 
-        // check if the key exists in the lower level bucket arrays
-        BUCKET_ARRAY* find_bucket_array = current_bucket_array;
-        BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&find_bucket_array->next_bucket, NULL, NULL);
+        // an item set while no snapshot at a sequence number is taken is older than any snapshot taken later,
+        // otherwise the item is not in the snapshot until its sequence number is known
+        HASH_TABLE_ITEM* new_hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, new_item);
+        (void)interlocked_exchange_64(&new_hash_table_item->insert_sequence_number, snapshot_in_progress ? INT64_MAX : INT64_MIN);
 
-        if (next_bucket_array != NULL)
+        // find or allocate a new bucket array
+        CLDS_HAZARD_POINTER_RECORD_HANDLE first_bucket_array_hp;
+        BUCKET_ARRAY* first_bucket_array = acquire_first_bucket_array_for_insert(clds_hash_table, clds_hazard_pointers_thread, &first_bucket_array_hp);
+        if (first_bucket_array == NULL)
         {
-            // wait for all outstanding inserts in the lower levels to complete
+            /* Codes_SRS_CLDS_HASH_TABLE_01_106: [ If any error occurs, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+            LogError("Cannot acquire the first bucket array");
+            result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_085: [ clds_hash_table_set_value shall go through all non top level bucket arrays and: ]*/
+            bool set_value_in_top_level;
+            int64_t completed_item_moves;
             do
             {
-                if (interlocked_add(&next_bucket_array->pending_insert_count, 0) == 0)
+                BUCKET_ARRAY* find_bucket_array;
+                CLDS_HAZARD_POINTER_RECORD_HANDLE find_bucket_array_hp;
+
+                set_value_in_top_level = true;
+                result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+
+                completed_item_moves = get_completed_item_moves(clds_hash_table, hash);
+                if (acquire_next_bucket_array(clds_hazard_pointers_thread, first_bucket_array, &find_bucket_array, &find_bucket_array_hp) != 0)
                 {
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_106: [ If any error occurs, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+                    LogError("Cannot acquire the next bucket array");
+                    set_value_in_top_level = false;
                     break;
                 }
-            } while (1);
-        }
 
-        find_bucket_array = next_bucket_array;
-        while (find_bucket_array != NULL)
-        {
-            next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&find_bucket_array->next_bucket, NULL, NULL);
-
-            bucket_index = hash % interlocked_add(&find_bucket_array->bucket_count, 0);
-            bucket_list = interlocked_compare_exchange_pointer((void* volatile_atomic*)&find_bucket_array->hash_table[bucket_index], NULL, NULL);
+                if (find_bucket_array != NULL)
+                {
+                    // wait for all outstanding inserts in the lower levels to complete
+                    wait_for_pending_inserts(find_bucket_array);
+                }
 
-            if (bucket_list != NULL)
-            {
-                CLDS_SORTED_LIST_ITEM* sorted_list_item = clds_sorted_list_find_key(bucket_list, clds_hazard_pointers_thread, key);
-                if (sorted_list_item != NULL)
+                while (find_bucket_array != NULL)
                 {
-                    clds_sorted_list_node_release(sorted_list_item);
+                    BUCKET_ARRAY* next_bucket_array;
+                    CLDS_HAZARD_POINTER_RECORD_HANDLE next_bucket_array_hp;
 
-                    found_in_lower_levels = true;
-                    break;
-                }
-            }
+                    bucket_index = get_bucket_index(clds_hash_table, hash, interlocked_add(&find_bucket_array->bucket_count, 0));
+                    bucket_list = &find_bucket_array->hash_table[bucket_index];
 
-            find_bucket_array = next_bucket_array;
-        }
+                    if (!CLDS_SORTED_LIST_HEAD_IS_EMPTY(bucket_list))
+                    {
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_108: [ If there is a sorted list in the bucket identified by the hash of the key, clds_hash_table_set_value shall find the key in the list. ]*/
+                        CLDS_SORTED_LIST_ITEM* sorted_list_item = clds_sorted_list_head_find_key(clds_hash_table->bucket_lists, bucket_list, clds_hazard_pointers_thread, &hashed_key);
+                        if (sorted_list_item != NULL)
+                        {
+                            clds_sorted_list_node_release(sorted_list_item);
 
-        if (found_in_lower_levels)
-        {
-            result = CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS;
-        }
-        else
-        {
-            (void)interlocked_increment(&current_bucket_array->item_count);
+                            HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, new_item);
+                            hash_table_item->hashed_key = hashed_key;
 
-            // find the bucket
-            /* Codes_SRS_CLDS_HASH_TABLE_01_018: [ clds_hash_table_insert shall obtain the bucket index to be used by calling compute_hash and passing to it the key value. ]*/
-            bucket_index = hash % bucket_count;
+                            /* Codes_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item, condition_check_func, condition_check_context and old_item and only_if_exists set to true. ]*/
+                            CLDS_SORTED_LIST_SET_VALUE_RESULT sorted_list_set_value_result = clds_sorted_list_head_set_value(clds_hash_table->bucket_lists, bucket_list, clds_hazard_pointers_thread, &hashed_key, (void*)new_item, list_condition_check_func, list_condition_check_context, (void*)old_item, write_sequence_number, true);
+                            switch (sorted_list_set_value_result)
+                            {
+                            default:
+                            case CLDS_SORTED_LIST_SET_VALUE_ERROR:
+                                /* Codes_SRS_CLDS_HASH_TABLE_01_111: [ If clds_sorted_list_set_value fails, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+                                LogError("Cannot set key in sorted list: failed with %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_SET_VALUE_RESULT, sorted_list_set_value_result));
+                                set_value_in_top_level = false;
+                                break;
 
-            do
+                            case CLDS_SORTED_LIST_SET_VALUE_OK:
+                                /* Codes_SRS_CLDS_HASH_TABLE_01_112: [ If clds_sorted_list_set_value succeeds, clds_hash_table_set_value shall return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
+                                result = CLDS_HASH_TABLE_SET_VALUE_OK;
+                                set_value_in_top_level = false;
+                                break;
+                    
+                            case CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET:
+                                /* Codes_SRS_CLDS_HASH_TABLE_04_001: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET. ]*/
+                                result = CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET;
+                                set_value_in_top_level = false;
+                                break;
+
+                            case CLDS_SORTED_LIST_SET_VALUE_NOT_FOUND:
+                                /* Codes_SRS_CLDS_HASH_TABLE_01_109: [ If the key is not found, clds_hash_table_set_value shall advance to the next level of buckets. ]*/
+                                break;
+                            }
+                        }
+                    }
+                    else
+                    {
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_107: [ If there is no sorted list in the bucket identified by the hash of the key, clds_hash_table_set_value shall advance to the next level of buckets. ]*/
+                    }
+
+                    if (acquire_next_bucket_array(clds_hazard_pointers_thread, find_bucket_array, &next_bucket_array, &next_bucket_array_hp) != 0)
+                    {
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_106: [ If any error occurs, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+                        LogError("Cannot acquire the next bucket array");
+                        result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+                        set_value_in_top_level = false;
+                        break;
+                    }
+
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, find_bucket_array_hp);
+                    find_bucket_array = next_bucket_array;
+                    find_bucket_array_hp = next_bucket_array_hp;
+                }
+
+                if (find_bucket_array != NULL)
+                {
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, find_bucket_array_hp);
+                }
+
+                // the key might have been moved to the first array while it was looked up, in which case look again
+            } while (set_value_in_top_level && items_moved_since(clds_hash_table, hash, completed_item_moves));
+
+            if (set_value_in_top_level)
             {
-                // do we have a list here or do we create one?
-                bucket_list = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->hash_table[bucket_index], NULL, NULL);
-                if (bucket_list != NULL)
+                /* Codes_SRS_CLDS_HASH_TABLE_01_102: [ If the key is not found in any of the non top level buckets arrays, clds_hash_table_set_value: ]*/
+                BUCKET_ARRAY* current_bucket_array = first_bucket_array;
+
+                // look for the item in this bucket array
+                // find the bucket
+                bucket_index = get_bucket_index(clds_hash_table, hash, interlocked_add(&current_bucket_array->bucket_count, 0));
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_103: [ clds_hash_table_set_value shall obtain the sorted list at the bucket corresponding to the hash of the key. ]*/
+                bucket_list = &current_bucket_array->hash_table[bucket_index];
+
+                HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, new_item);
+
+                hash_table_item->hashed_key = hashed_key;
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_105: [ clds_hash_table_set_value shall call clds_hash_table_set_value on the top level bucket array, passing key, new_item, condition_check_func, condition_check_context, old_item and only_if_exists set to false. ]*/
+                CLDS_SORTED_LIST_SET_VALUE_RESULT sorted_list_set_value = clds_sorted_list_head_set_value(clds_hash_table->bucket_lists, bucket_list, clds_hazard_pointers_thread, &hashed_key, (void*)new_item, list_condition_check_func, list_condition_check_context, (void*)old_item, write_sequence_number, false);
+                if (sorted_list_set_value == CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET)
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_04_002: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET. ]*/
+                    LogError("Condition not met during set value - %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_SET_VALUE_RESULT, sorted_list_set_value));
+                    result = CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET;
+                }
+                else if (sorted_list_set_value != CLDS_SORTED_LIST_SET_VALUE_OK)
                 {
-                    restart_needed = false;
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_100: [ If clds_sorted_list_set_value returns any other value, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+                    LogError("Cannot set key in sorted list - %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_SET_VALUE_RESULT, sorted_list_set_value));
+                    result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
                 }
                 else
                 {
-                    // create a list
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_019: [ If no sorted list exists at the determined bucket index then a new list shall be created. ]*/
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_071: [ When a new list is created, the start sequence number passed to clds_hash_tabel_create shall be passed as the start_sequence_number argument. ]*/
-                    bucket_list = clds_sorted_list_create(clds_hash_table->clds_hazard_pointers, get_item_key_cb, clds_hash_table, key_compare_cb, clds_hash_table, clds_hash_table->sequence_number, clds_hash_table->sequence_number == NULL ? NULL : on_sorted_list_skipped_seq_no, clds_hash_table);
-                    if (bucket_list == NULL)
-                    {
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_022: [ If any error is encountered while inserting the key/value pair, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
-                        LogError("Cannot allocate list for hash table bucket");
-                        restart_needed = false;
-                    }
-                    else
+                    if (*old_item == NULL)
                     {
-                        // now put the list in the bucket
-                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->hash_table[bucket_index], bucket_list, NULL) != NULL)
-                        {
-                            // oops, someone else inserted a new list, just bail on our list and restart
-                            clds_sorted_list_destroy(bucket_list);
-                            restart_needed = true;
-                        }
-                        else
-                        {
-                            // set new list
-                            restart_needed = false;
-                        }
+                        (void)interlocked_increment(&get_counter_stripe(first_bucket_array, clds_hazard_pointers_thread)->item_count);
                     }
+
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_099: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_OK, clds_hash_table_set_value shall succeed and return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
+                    result = CLDS_HASH_TABLE_SET_VALUE_OK;
                 }
-            } while (restart_needed);
+            }
 
-            if (bucket_list == NULL)
+            if (
+                (result == CLDS_HASH_TABLE_SET_VALUE_OK) &&
+                snapshot_in_progress
+                )
             {
-                LogError("Cannot acquire bucket list");
-                result = CLDS_HASH_TABLE_INSERT_ERROR;
+                (void)interlocked_exchange_64(&new_hash_table_item->insert_sequence_number, *write_sequence_number);
+                if (*old_item != NULL)
+                {
+                    keep_superseded_item(clds_hash_table, (void*)*old_item, *write_sequence_number);
+                }
             }
-            else
-            {
-                CLDS_SORTED_LIST_INSERT_RESULT list_insert_result;
 
-                /* Codes_SRS_CLDS_HASH_TABLE_01_020: [ A new sorted list item shall be created by calling clds_sorted_list_node_create. ]*/
-                hash_table_item->key = key;
+            end_pending_insert(first_bucket_array, clds_hazard_pointers_thread);
 
-                /* Codes_SRS_CLDS_HASH_TABLE_01_021: [ The new sorted list node shall be inserted in the sorted list at the identified bucket by calling clds_sorted_list_insert. ]*/
-                /* Codes_SRS_CLDS_HASH_TABLE_01_059: [ For each insert the order of the operation shall be computed by passing sequence_number to clds_sorted_list_insert. ]*/
-                list_insert_result = clds_sorted_list_insert(bucket_list, clds_hazard_pointers_thread, (void*)value, sequence_number);
+            /* Codes_SRS_CLDS_HASH_TABLE_01_119: [ clds_hash_table_set_value shall migrate the items of the next buckets of the oldest array of buckets to the first array of buckets. ]*/
+            migrate_buckets_if_needed(clds_hash_table, clds_hazard_pointers_thread, interlocked_add(&clds_hash_table->write_migration_bucket_count, 0));
 
-                if (list_insert_result == CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS)
-                {
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_046: [ If the key already exists in the hash table, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ALREADY_EXISTS. ]*/
-                    result = CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS;
-                }
-                else if (list_insert_result != CLDS_SORTED_LIST_INSERT_OK)
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, first_bucket_array_hp);
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_42_060: [ clds_hash_table_set_value shall decrement the count of pending write operations. ]*/
+        end_write_operation(clds_hash_table, write_slot);
+    }
+
+    return result;
+}
+
+static CLDS_HASH_TABLE_ITEM* find_hashed_key(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, HASH_TABLE_HASHED_KEY* hashed_key)
+{
+    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_SORTED_LIST_HEAD* bucket_list;
+
+    // the biggest array of buckets is looked up first
+    BUCKET_ARRAY* current_bucket_array;
+    int64_t completed_item_moves;
+    do
+    {
+        CLDS_HAZARD_POINTER_RECORD_HANDLE current_bucket_array_hp;
+
+        result = NULL;
+
+        completed_item_moves = get_completed_item_moves(clds_hash_table, hashed_key->hash);
+        current_bucket_array = acquire_first_bucket_array(clds_hash_table, clds_hazard_pointers_thread, &current_bucket_array_hp);
+        if (current_bucket_array == NULL)
+        {
+            LogError("Cannot acquire the first bucket array");
+            result = NULL;
+            break;
+        }
+
+        while (current_bucket_array != NULL)
+        {
+            // find the bucket
+            /* Codes_SRS_CLDS_HASH_TABLE_01_044: [ Looking up the key in the array of buckets is done by obtaining the list in the bucket correspoding to the hash and looking up the key in the list by calling clds_sorted_list_find. ]*/
+            uint64_t bucket_index = get_bucket_index(clds_hash_table, hashed_key->hash, interlocked_add(&current_bucket_array->bucket_count, 0));
+
+            bucket_list = &current_bucket_array->hash_table[bucket_index];
+            if (!CLDS_SORTED_LIST_HEAD_IS_EMPTY(bucket_list))
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_034: [ clds_hash_table_find shall find the key identified by key in the hash table and on success return the item corresponding to it. ]*/
+                result = (void*)clds_sorted_list_head_find_key(clds_hash_table->bucket_lists, bucket_list, clds_hazard_pointers_thread, hashed_key);
+                if (result == NULL)
                 {
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_022: [ If any error is encountered while inserting the key/value pair, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
-                    LogError("Cannot insert hash table item into list");
-                    result = CLDS_HASH_TABLE_INSERT_ERROR;
+                    // go to the next level of buckets
                 }
                 else
                 {
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_009: [ On success clds_hash_table_insert shall return CLDS_HASH_TABLE_INSERT_OK. ]*/
-                    result = CLDS_HASH_TABLE_INSERT_OK;
+                    // found
+                    break;
                 }
             }
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_042: [ If the key is not found in the biggest array of buckets, the next bucket arrays shall be looked up. ]*/
+            BUCKET_ARRAY* next_bucket_array;
+            CLDS_HAZARD_POINTER_RECORD_HANDLE next_bucket_array_hp;
+            if (acquire_next_bucket_array(clds_hazard_pointers_thread, current_bucket_array, &next_bucket_array, &next_bucket_array_hp) != 0)
+            {
+                LogError("Cannot acquire the next bucket array");
+                result = NULL;
+                break;
+            }
+
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
+            current_bucket_array = next_bucket_array;
+            current_bucket_array_hp = next_bucket_array_hp;
+        }
+
+        if (current_bucket_array != NULL)
+        {
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
         }
 
-        (void)interlocked_decrement(&current_bucket_array->pending_insert_count);
+        // the item might have been moved to the first array while it was looked up, in which case look again
+    } while ((result == NULL) && items_moved_since(clds_hash_table, hashed_key->hash, completed_item_moves));
 
-        /* Codes_SRS_CLDS_HASH_TABLE_42_063: [ clds_hash_table_insert shall decrement the count of pending write operations. ]*/
-        end_write_operation(clds_hash_table);
-    }
     return result;
 }
 
-static bool find_by_key_value(void* item_compare_context, CLDS_SORTED_LIST_ITEM* item)
+static void migrate_buckets_on_read(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
 {
-    bool result;
-    FIND_BY_KEY_VALUE_CONTEXT* find_by_key_value_context = item_compare_context;
-    HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
+    // a read only migrates if asked to, and never waits for a snapshot to finish
+    /* Codes_SRS_CLDS_HASH_TABLE_01_118: [ If the table is not locked for writes, clds_hash_table_find shall migrate the items of the next buckets of the oldest array of buckets to the first array of buckets, as set by clds_hash_table_set_migration_bucket_count. ]*/
+    int32_t read_migration_bucket_count = interlocked_add(&clds_hash_table->read_migration_bucket_count, 0);
+    uint32_t write_slot;
+    if (
+        (read_migration_bucket_count > 0) &&
+        (interlocked_add(&clds_hash_table->bucket_array_count, 0) > 1) &&
+        try_begin_write_operation(clds_hash_table, &write_slot)
+        )
+    {
+        migrate_buckets_if_needed(clds_hash_table, clds_hazard_pointers_thread, read_migration_bucket_count);
+        end_write_operation(clds_hash_table, write_slot);
+    }
+}
+
+CLDS_HASH_TABLE_ITEM* clds_hash_table_find(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+{
+    CLDS_HASH_TABLE_ITEM* result;
 
-    if ((item != find_by_key_value_context->value) ||
-        (find_by_key_value_context->key_compare_func(hash_table_item->key, find_by_key_value_context->key) != 0))
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_035: [ If clds_hash_table is NULL, clds_hash_table_find shall fail and return NULL. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_036: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_find shall fail and return NULL. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_037: [ If key is NULL, clds_hash_table_find shall fail and return NULL. ]*/
+        (key == NULL)
+        )
     {
-        result = false;
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p",
+            clds_hash_table, clds_hazard_pointers_thread, key);
+        result = NULL;
     }
     else
     {
-        result = true;
+        // compute the hash
+        /* Codes_SRS_CLDS_HASH_TABLE_01_040: [ clds_hash_table_find shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+        uint64_t hash = hash_key(clds_hash_table, key);
+        HASH_TABLE_HASHED_KEY hashed_key = { hash, key };
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_041: [ clds_hash_table_find shall look up the key in the biggest array of buckets. ]*/
+        result = find_hashed_key(clds_hash_table, clds_hazard_pointers_thread, &hashed_key);
+
+        if (result == NULL)
+        {
+            /* not found */
+            /* Codes_SRS_CLDS_HASH_TABLE_01_043: [ If the key is not found at all, clds_hash_table_find shall return NULL. ]*/
+        }
+        else
+        {
+            // all OK
+        }
+
+        migrate_buckets_on_read(clds_hash_table, clds_hazard_pointers_thread);
     }
 
     return result;
 }
 
-CLDS_HASH_TABLE_DELETE_RESULT clds_hash_table_delete(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, int64_t* sequence_number)
+int clds_hash_table_find_batch(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void** keys, uint32_t key_count, CLDS_HASH_TABLE_ITEM** items)
 {
-    CLDS_HASH_TABLE_DELETE_RESULT result;
+    int result;
 
     if (
-        /* Codes_SRS_CLDS_HASH_TABLE_01_015: [ If clds_hash_table is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_174: [ If clds_hash_table is NULL, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
         (clds_hash_table == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_017: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_175: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
         (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_016: [ If key is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        (key == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_066: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        /* Codes_SRS_CLDS_HASH_TABLE_01_176: [ If keys is NULL, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
+        (keys == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_177: [ If items is NULL, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
+        (items == NULL)
         )
     {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, int64_t* sequence_number=%p",
-            clds_hash_table, key, clds_hazard_pointers_thread, sequence_number);
-        result = CLDS_HASH_TABLE_DELETE_ERROR;
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void** keys=%p, uint32_t key_count=%" PRIu32 ", CLDS_HASH_TABLE_ITEM** items=%p",
+            clds_hash_table, clds_hazard_pointers_thread, keys, key_count, items);
+        result = MU_FAILURE;
     }
     else
     {
-        /* Codes_SRS_CLDS_HASH_TABLE_42_037: [ clds_hash_table_delete shall try the following until it acquires a write lock for the table: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_038: [ clds_hash_table_delete shall increment the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_039: [ If the counter to lock the table for writes is non-zero then: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_040: [ clds_hash_table_delete shall decrement the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_041: [ clds_hash_table_delete shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
-        check_lock_and_begin_write_operation(clds_hash_table);
-
-        CLDS_SORTED_LIST_HANDLE bucket_list;
-        BUCKET_ARRAY* current_bucket_array;
-
-        // compute the hash
-        /* Codes_SRS_CLDS_HASH_TABLE_01_039: [ clds_hash_table_delete shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-        uint64_t hash = clds_hash_table->compute_hash(key);
+        uint32_t i;
 
-        result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+        for (i = 0; i < key_count; i++)
+        {
+            if (keys[i] == NULL)
+            {
+                break;
+            }
+        }
 
-        // always delete starting with the first bucket array
-        /* Codes_SRS_CLDS_HASH_TABLE_01_101: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
-        current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
-        while (current_bucket_array != NULL)
+        if (i < key_count)
         {
-            BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
+            /* Codes_SRS_CLDS_HASH_TABLE_01_178: [ If any of the keys is NULL, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
+            LogError("Invalid arguments: void** keys=%p, keys[%" PRIu32 "] is NULL", keys, i);
+            result = MU_FAILURE;
+        }
+        else
+        {
+            result = 0;
 
-            if (interlocked_add(&current_bucket_array->item_count, 0) != 0)
+            // each stage of a group touches the memory that the previous stage prefetched for all the keys of the group,
+            // so the cache misses of the keys overlap instead of being taken one after the other
+            for (uint32_t group_start = 0; group_start < key_count; group_start += FIND_BATCH_GROUP_SIZE)
             {
-                // find the bucket
-                uint64_t bucket_index = hash % interlocked_add(&current_bucket_array->bucket_count, 0);
+                uint32_t group_key_count = ((key_count - group_start) < FIND_BATCH_GROUP_SIZE) ? (key_count - group_start) : FIND_BATCH_GROUP_SIZE;
+                HASH_TABLE_HASHED_KEY hashed_keys[FIND_BATCH_GROUP_SIZE];
+                int64_t completed_item_moves[FIND_BATCH_GROUP_SIZE];
+                CLDS_SORTED_LIST_HEAD* bucket_lists[FIND_BATCH_GROUP_SIZE];
 
-                bucket_list = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->hash_table[bucket_index], NULL, NULL);
-                if (bucket_list == NULL)
+                /* Codes_SRS_CLDS_HASH_TABLE_01_179: [ clds_hash_table_find_batch shall look up the keys in groups of 16 keys, starting each group by hashing all its keys with the compute_hash function passed to clds_hash_table_create. ]*/
+                for (i = 0; i < group_key_count; i++)
                 {
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-                    result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+                    hashed_keys[i].key = keys[group_start + i];
+                    hashed_keys[i].hash = hash_key(clds_hash_table, hashed_keys[i].key);
+                    completed_item_moves[i] = get_completed_item_moves(clds_hash_table, hashed_keys[i].hash);
                 }
-                else
-                {
-                    CLDS_SORTED_LIST_DELETE_RESULT list_delete_result;
 
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_063: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_key. ]*/
-                    list_delete_result = clds_sorted_list_delete_key(bucket_list, clds_hazard_pointers_thread, key, sequence_number);
-                    if (list_delete_result == CLDS_SORTED_LIST_DELETE_NOT_FOUND)
+                CLDS_HAZARD_POINTER_RECORD_HANDLE first_bucket_array_hp;
+                BUCKET_ARRAY* first_bucket_array = acquire_first_bucket_array(clds_hash_table, clds_hazard_pointers_thread, &first_bucket_array_hp);
+                if (first_bucket_array == NULL)
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_185: [ If any error occurs, clds_hash_table_find_batch shall release the items it found, fail and return a non-zero value. ]*/
+                    LogError("Cannot acquire the first bucket array");
+                    for (i = 0; i < group_start; i++)
                     {
-                        // not found
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+                        if (items[i] != NULL)
+                        {
+                            clds_sorted_list_node_release((void*)items[i]);
+                            items[i] = NULL;
+                        }
                     }
-                    else if (list_delete_result == CLDS_SORTED_LIST_DELETE_OK)
+                    result = MU_FAILURE;
+                    break;
+                }
+
+                bool has_lower_bucket_arrays = (interlocked_compare_exchange_pointer((void* volatile_atomic*)&first_bucket_array->next_bucket, NULL, NULL) != NULL);
+                int32_t bucket_count = interlocked_add(&first_bucket_array->bucket_count, 0);
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_180: [ clds_hash_table_find_batch shall then prefetch the bucket of each key of the group in the first array of buckets, then prefetch the first item of each of these buckets and only then look up each key in its bucket with clds_sorted_list_head_find_key. ]*/
+                for (i = 0; i < group_key_count; i++)
+                {
+                    bucket_lists[i] = &first_bucket_array->hash_table[get_bucket_index(clds_hash_table, hashed_keys[i].hash, bucket_count)];
+                    PREFETCH_FOR_READ(bucket_lists[i]);
+                }
+
+                for (i = 0; i < group_key_count; i++)
+                {
+                    // prefetching never faults, so the first item does not need to be protected yet
+                    void* first_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_lists[i]->head, NULL, NULL);
+                    if (first_item != NULL)
                     {
-                        (void)interlocked_decrement(&current_bucket_array->item_count);
+                        PREFETCH_FOR_READ(first_item);
+                    }
+                }
 
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_014: [ On success clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_OK. ]*/
-                        result = CLDS_HASH_TABLE_DELETE_OK;
-                        break;
+                for (i = 0; i < group_key_count; i++)
+                {
+                    CLDS_HASH_TABLE_ITEM* item = NULL;
+
+                    if (!CLDS_SORTED_LIST_HEAD_IS_EMPTY(bucket_lists[i]))
+                    {
+                        item = (void*)clds_sorted_list_head_find_key(clds_hash_table->bucket_lists, bucket_lists[i], clds_hazard_pointers_thread, &hashed_keys[i]);
                     }
-                    else
+
+                    if (
+                        (item == NULL) &&
+                        (has_lower_bucket_arrays || items_moved_since(clds_hash_table, hashed_keys[i].hash, completed_item_moves[i]))
+                        )
                     {
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_024: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-                        result = CLDS_HASH_TABLE_DELETE_ERROR;
-                        break;
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_181: [ If a key is not found in the first array of buckets and the table has other arrays of buckets or items with hashes in the same move stripe as the key were moved between the arrays of buckets meanwhile, clds_hash_table_find_batch shall look up the key the same way clds_hash_table_find does. ]*/
+                        item = find_hashed_key(clds_hash_table, clds_hazard_pointers_thread, &hashed_keys[i]);
                     }
+
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_182: [ clds_hash_table_find_batch shall store in each element of items the item found for the key with the same index (with a reference that the caller has to release) or NULL if the key was not found. ]*/
+                    items[group_start + i] = item;
                 }
+
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, first_bucket_array_hp);
             }
 
-            /* Codes_SRS_CLDS_HASH_TABLE_01_025: [ If the element to be deleted is not found in an array of buckets, then it shall be looked up in the next available array of buckets. ] */
-            current_bucket_array = next_bucket_array;
-        }
+            if (result == 0)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_01_183: [ clds_hash_table_find_batch shall migrate the items of the oldest array of buckets the same way clds_hash_table_find does. ]*/
+                migrate_buckets_on_read(clds_hash_table, clds_hazard_pointers_thread);
 
-        /* Codes_SRS_CLDS_HASH_TABLE_42_042: [ clds_hash_table_insert shall decrement the count of pending write operations. ]*/
-        end_write_operation(clds_hash_table);
+                /* Codes_SRS_CLDS_HASH_TABLE_01_184: [ On success clds_hash_table_find_batch shall return 0. ]*/
+            }
+        }
     }
 
     return result;
 }
 
-CLDS_HASH_TABLE_DELETE_RESULT clds_hash_table_delete_key_value(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, int64_t* sequence_number)
+CLDS_HASH_TABLE_SNAPSHOT_RESULT clds_hash_table_snapshot(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count)
 {
-    CLDS_HASH_TABLE_DELETE_RESULT result;
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result;
 
     if (
-        /*Codes_SRS_CLDS_HASH_TABLE_42_003: [ If clds_hash_table is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_013: [ If clds_hash_table is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
         (clds_hash_table == NULL) ||
-        /*Codes_SRS_CLDS_HASH_TABLE_42_005: [ If key is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        (key == NULL) ||
-        /*Codes_SRS_CLDS_HASH_TABLE_42_006: [ If value is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        (value == NULL) ||
-        /*Codes_SRS_CLDS_HASH_TABLE_42_004: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_42_014: [ If clds_hazard_pointers_thread is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
         (clds_hazard_pointers_thread == NULL) ||
-        /*Codes_SRS_CLDS_HASH_TABLE_42_012: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        /* Codes_SRS_CLDS_HASH_TABLE_42_015: [ If items is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (items == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_42_016: [ If item_count is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (item_count == NULL)
         )
     {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM* value=%p, int64_t* sequence_number=%p",
-            clds_hash_table, key, value, clds_hazard_pointers_thread, sequence_number);
-        result = CLDS_HASH_TABLE_DELETE_ERROR;
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_HASH_TABLE_ITEM*** items=%p, uint64_t* item_count=%p",
+            clds_hash_table, clds_hazard_pointers_thread, items, item_count);
+        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
     }
     else
     {
-        /* Codes_SRS_CLDS_HASH_TABLE_42_043: [ clds_hash_table_delete_key_value shall try the following until it acquires a write lock for the table: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_044: [ clds_hash_table_delete_key_value shall increment the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_045: [ If the counter to lock the table for writes is non-zero then: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_046: [ clds_hash_table_delete_key_value shall decrement the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_047: [ clds_hash_table_delete_key_value shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
-        check_lock_and_begin_write_operation(clds_hash_table);
-
-        CLDS_SORTED_LIST_HANDLE bucket_list;
-        BUCKET_ARRAY* current_bucket_array;
+        internal_lock_writes(clds_hash_table);
 
-        // compute the hash
-        /*Codes_SRS_CLDS_HASH_TABLE_42_001: [ clds_hash_table_delete_key_value shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-        uint64_t hash = clds_hash_table->compute_hash(key);
+        /* Codes_SRS_CLDS_HASH_TABLE_42_020: [ clds_hash_table_snapshot shall call clds_sorted_list_lock_writes on the sorted list shared by all the buckets. ]*/
+        // all the buckets share the lock of the bucket lists, so it is taken once for the whole table
+        clds_sorted_list_lock_writes(clds_hash_table->bucket_lists);
 
-        result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+        uint64_t temp_item_count = 0;
+        bool failed = false;
 
-        // always insert in the first bucket array
-        /*Codes_SRS_CLDS_HASH_TABLE_42_007: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
-        current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+        /* Codes_SRS_CLDS_HASH_TABLE_42_019: [ For each bucket in the array: ]*/
+        BUCKET_ARRAY* current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
         while (current_bucket_array != NULL)
         {
             BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
 
-            if (interlocked_add(&current_bucket_array->item_count, 0) != 0)
+            if (get_item_count(current_bucket_array) != 0)
             {
-                // find the bucket
-                uint64_t bucket_index = hash % interlocked_add(&current_bucket_array->bucket_count, 0);
+                int32_t bucket_count = interlocked_add(&current_bucket_array->bucket_count, 0);
+                int32_t i;
+                for (i = 0; i < bucket_count; i++)
+                {
+                    if (!CLDS_SORTED_LIST_HEAD_IS_EMPTY(&current_bucket_array->hash_table[i]))
+                    {
+                        /* Codes_SRS_CLDS_HASH_TABLE_42_021: [ clds_hash_table_snapshot shall call clds_sorted_list_head_get_count and add to the running total. ]*/
+                        uint64_t list_item_count;
+                        CLDS_SORTED_LIST_GET_COUNT_RESULT count_result = clds_sorted_list_head_get_count(clds_hash_table->bucket_lists, &current_bucket_array->hash_table[i], clds_hazard_pointers_thread, &list_item_count);
+                        if (count_result != CLDS_SORTED_LIST_GET_COUNT_OK)
+                        {
+                            /* Codes_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                            LogError("clds_sorted_list_head_get_count failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_GET_COUNT_RESULT, count_result));
+                            break;
+                        }
+                        else
+                        {
+                            if (list_item_count + temp_item_count < temp_item_count)
+                            {
+                                /* Codes_SRS_CLDS_HASH_TABLE_42_022: [ If the addition of the list count causes overflow then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                                LogError("overflow in computing total count (%" PRIu64 " + %" PRIu64 ")", temp_item_count, list_item_count);
+                                break;
+                            }
+                            else
+                            {
+                                temp_item_count += list_item_count;
+                            }
+                        }
+                    }
+                }
 
-                bucket_list = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->hash_table[bucket_index], NULL, NULL);
-                if (bucket_list == NULL)
+                if (i < bucket_count)
                 {
-                    /*Codes_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-                    result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+                    failed = true;
+                    break;
+                }
+            }
+
+            current_bucket_array = next_bucket_array;
+        }
+
+        if (failed)
+        {
+            result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+        }
+        else
+        {
+            if (temp_item_count == 0)
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_42_064: [ If there are no items then clds_hash_table_snapshot shall set items to NULL and item_count to 0 and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+                *items = NULL;
+                *item_count = 0;
+                result = CLDS_HASH_TABLE_SNAPSHOT_OK;
+            }
+            else
+            {
+                /* Codes_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
+                CLDS_SORTED_LIST_ITEM** items_to_return = malloc_2((size_t)temp_item_count, sizeof(CLDS_SORTED_LIST_ITEM*));
+
+                if (items_to_return == NULL)
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                    LogError("malloc_2((size_t)temp_item_count=%zu, sizeof(CLDS_SORTED_LIST_ITEM*)=%zu) failed for the items to return",
+                        (size_t)temp_item_count, sizeof(CLDS_SORTED_LIST_ITEM*));
+                    result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
                 }
                 else
                 {
-                    CLDS_SORTED_LIST_DELETE_RESULT list_delete_result;
+                    uint64_t result_index = 0;
 
-                    /*Codes_SRS_CLDS_HASH_TABLE_42_011: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_item. ]*/
-                    list_delete_result = clds_sorted_list_delete_item(bucket_list, clds_hazard_pointers_thread, (void*)value, sequence_number);
-                    if (list_delete_result == CLDS_SORTED_LIST_DELETE_NOT_FOUND)
+                    /* Codes_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
+                    current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+                    while ((current_bucket_array != NULL) && !failed)
                     {
-                        // not found
+                        BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
+
+                        if (get_item_count(current_bucket_array) != 0)
+                        {
+                            int32_t bucket_count = interlocked_add(&current_bucket_array->bucket_count, 0);
+                            int32_t i;
+                            for (i = 0; i < bucket_count; i++)
+                            {
+                                if (!CLDS_SORTED_LIST_HEAD_IS_EMPTY(&current_bucket_array->hash_table[i]))
+                                {
+                                    /* Codes_SRS_CLDS_HASH_TABLE_42_025: [ clds_hash_table_snapshot shall call clds_sorted_list_head_get_count. ]*/
+                                    uint64_t list_item_count;
+                                    CLDS_SORTED_LIST_GET_COUNT_RESULT count_result = clds_sorted_list_head_get_count(clds_hash_table->bucket_lists, &current_bucket_array->hash_table[i], clds_hazard_pointers_thread, &list_item_count);
+                                    if (count_result != CLDS_SORTED_LIST_GET_COUNT_OK)
+                                    {
+                                        /* Codes_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                                        LogError("clds_sorted_list_head_get_count failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_GET_COUNT_RESULT, count_result));
+                                        failed = true;
+                                        break;
+                                    }
+                                    else
+                                    {
+                                        if (list_item_count == 0)
+                                        {
+                                            // skip
+                                        }
+                                        else
+                                        {
+                                            /* Codes_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_head_get_all with the next portion of the allocated array. ]*/
+                                            CLDS_SORTED_LIST_GET_ALL_RESULT get_all_result = clds_sorted_list_head_get_all(clds_hash_table->bucket_lists, &current_bucket_array->hash_table[i], clds_hazard_pointers_thread, list_item_count, items_to_return + result_index);
+                                            if (get_all_result != CLDS_SORTED_LIST_GET_ALL_OK)
+                                            {
+                                                /* Codes_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                                                LogError("clds_sorted_list_head_get_all failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_GET_ALL_RESULT, get_all_result));
+                                                failed = true;
+                                                break;
+                                            }
+                                            else
+                                            {
+                                                result_index += list_item_count;
+                                            }
+                                        }
+                                    }
+                                }
+                            }
+                        }
+
+                        current_bucket_array = next_bucket_array;
                     }
-                    else if (list_delete_result == CLDS_SORTED_LIST_DELETE_OK)
+
+                    if (failed)
                     {
-                        (void)interlocked_decrement(&current_bucket_array->item_count);
+                        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
 
-                        /*Codes_SRS_CLDS_HASH_TABLE_42_002: [ On success clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_OK. ]*/
-                        result = CLDS_HASH_TABLE_DELETE_OK;
-                        break;
+                        for (uint64_t i = 0; i < result_index; i++)
+                        {
+                            clds_sorted_list_node_release(items_to_return[i]);
+                        }
+                        free(items_to_return);
                     }
                     else
                     {
-                        /*Codes_SRS_CLDS_HASH_TABLE_42_009: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-                        result = CLDS_HASH_TABLE_DELETE_ERROR;
-                        break;
+                        /* Codes_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
+                        *items = (CLDS_HASH_TABLE_ITEM**)items_to_return;
+                        items_to_return = NULL;
+
+                        /* Codes_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
+                        *item_count = result_index;
+
+                        /* Codes_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+                        result = CLDS_HASH_TABLE_SNAPSHOT_OK;
                     }
                 }
             }
+        }
 
-            /*Codes_SRS_CLDS_HASH_TABLE_42_010: [ If the element to be deleted is not found in an array of buckets, then clds_hash_table_delete_key_value shall look in the next available array of buckets. ]*/
-            current_bucket_array = next_bucket_array;
+        /* Codes_SRS_CLDS_HASH_TABLE_42_027: [ clds_hash_table_snapshot shall call clds_sorted_list_unlock_writes on the sorted list shared by all the buckets. ]*/
+        clds_sorted_list_unlock_writes(clds_hash_table->bucket_lists);
+
+        internal_unlock_writes(clds_hash_table);
+    }
+
+    return result;
+}
+
+static int add_snapshot_item(CLDS_SORTED_LIST_ITEM*** snapshot_items, uint64_t* snapshot_item_count, uint64_t* snapshot_item_capacity, CLDS_SORTED_LIST_ITEM* item)
+{
+    int result;
+
+    if (*snapshot_item_count < *snapshot_item_capacity)
+    {
+        result = 0;
+    }
+    else
+    {
+        // the number of items is only known once all the buckets have been walked, so the array grows as needed
+        uint64_t new_capacity = (*snapshot_item_capacity == 0) ? 16 : *snapshot_item_capacity * 2;
+        CLDS_SORTED_LIST_ITEM** new_snapshot_items = realloc_2(*snapshot_items, (size_t)new_capacity, sizeof(CLDS_SORTED_LIST_ITEM*));
+        if (new_snapshot_items == NULL)
+        {
+            LogError("realloc_2(*snapshot_items=%p, (size_t)new_capacity=%zu, sizeof(CLDS_SORTED_LIST_ITEM*)=%zu) failed",
+                *snapshot_items, (size_t)new_capacity, sizeof(CLDS_SORTED_LIST_ITEM*));
+            result = MU_FAILURE;
+        }
+        else
+        {
+            *snapshot_items = new_snapshot_items;
+            *snapshot_item_capacity = new_capacity;
+            result = 0;
         }
+    }
 
-        /* Codes_SRS_CLDS_HASH_TABLE_42_048: [ clds_hash_table_delete_key_value shall decrement the count of pending write operations. ]*/
-        end_write_operation(clds_hash_table);
+    if (result == 0)
+    {
+        (*snapshot_items)[*snapshot_item_count] = item;
+        (*snapshot_item_count)++;
     }
 
     return result;
 }
 
-CLDS_HASH_TABLE_REMOVE_RESULT clds_hash_table_remove(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM** item, int64_t* sequence_number)
+static int add_superseded_item_in_snapshot(CLDS_SORTED_LIST_ITEM*** snapshot_items, uint64_t* snapshot_item_count, uint64_t* snapshot_item_capacity, CLDS_HASH_TABLE_ITEM* superseded_item, int64_t insert_sequence_number, int64_t remove_sequence_number, int64_t snapshot_sequence_number)
 {
-    CLDS_HASH_TABLE_DELETE_RESULT result;
+    int result;
 
     if (
-        /* Codes_SRS_CLDS_HASH_TABLE_01_050: [ If clds_hash_table is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-        (clds_hash_table == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_052: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-        (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_051: [ If key is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-        (key == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_056: [ If item is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-        (item == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_070: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        (insert_sequence_number <= snapshot_sequence_number) &&
+        (remove_sequence_number > snapshot_sequence_number)
         )
     {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM** item=%p, int64_t* sequence_number=%p",
-            clds_hash_table, key, clds_hazard_pointers_thread, item, sequence_number);
-        result = CLDS_HASH_TABLE_REMOVE_ERROR;
+        // the reference kept by the write is released with the other kept items
+        (void)clds_sorted_list_node_inc_ref((void*)superseded_item);
+        if (add_snapshot_item(snapshot_items, snapshot_item_count, snapshot_item_capacity, (void*)superseded_item) != 0)
+        {
+            LogError("add_snapshot_item failed");
+            clds_sorted_list_node_release((void*)superseded_item);
+            result = MU_FAILURE;
+        }
+        else
+        {
+            result = 0;
+        }
     }
     else
     {
-        /* Codes_SRS_CLDS_HASH_TABLE_42_049: [ clds_hash_table_remove shall try the following until it acquires a write lock for the table: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_050: [ clds_hash_table_remove shall increment the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_051: [ If the counter to lock the table for writes is non-zero then: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_052: [ clds_hash_table_remove shall decrement the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_053: [ clds_hash_table_remove shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
-        check_lock_and_begin_write_operation(clds_hash_table);
+        result = 0;
+    }
 
-        CLDS_SORTED_LIST_HANDLE bucket_list;
-        BUCKET_ARRAY* current_bucket_array;
+    return result;
+}
 
-        /* Codes_SRS_CLDS_HASH_TABLE_01_047: [ clds_hash_table_remove shall remove a key from the hash table and return a pointer to the item to the user. ]*/
+static int compare_item_pointers(const void* left, const void* right)
+{
+    uintptr_t left_item = (uintptr_t)*(CLDS_SORTED_LIST_ITEM* const*)left;
+    uintptr_t right_item = (uintptr_t)*(CLDS_SORTED_LIST_ITEM* const*)right;
 
-        // compute the hash
-        /* Codes_SRS_CLDS_HASH_TABLE_01_048: [ clds_hash_table_remove shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-        uint64_t hash = clds_hash_table->compute_hash(key);
+    return (left_item < right_item) ? -1 : ((left_item > right_item) ? 1 : 0);
+}
 
-        result = CLDS_HASH_TABLE_REMOVE_NOT_FOUND;
+static int collect_items_at_sequence_number(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, int64_t snapshot_sequence_number,
+    CLDS_SORTED_LIST_ITEM*** snapshot_items, uint64_t* snapshot_item_count, uint64_t* snapshot_item_capacity)
+{
+    int result = 0;
 
-        // always insert in the first bucket array
-        current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
-        while (current_bucket_array != NULL)
+    // items are not moved between the bucket arrays while the snapshot is taken, so each item is in exactly one bucket
+    CLDS_HAZARD_POINTER_RECORD_HANDLE current_bucket_array_hp;
+    BUCKET_ARRAY* current_bucket_array = acquire_first_bucket_array(clds_hash_table, clds_hazard_pointers_thread, &current_bucket_array_hp);
+    if (current_bucket_array == NULL)
+    {
+        LogError("Cannot acquire the first bucket array");
+        result = MU_FAILURE;
+    }
+
+    while ((current_bucket_array != NULL) && (result == 0))
+    {
+        int32_t bucket_count = interlocked_add(&current_bucket_array->bucket_count, 0);
+        for (int32_t i = 0; (i < bucket_count) && (result == 0); i++)
         {
-            BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
+            CLDS_SORTED_LIST_HEAD* bucket_list = &current_bucket_array->hash_table[i];
+            CLDS_SORTED_LIST_ITEM* item;
 
-            if (interlocked_add(&current_bucket_array->item_count, 0) != 0)
+            /* Codes_SRS_CLDS_HASH_TABLE_01_144: [ clds_hash_table_snapshot_at_sequence_number shall walk the items of each bucket by calling clds_sorted_list_head_get_first and then clds_sorted_list_head_get_next with the key of the last item, while the writes continue. ]*/
+            if (clds_sorted_list_head_get_first(clds_hash_table->bucket_lists, bucket_list, clds_hazard_pointers_thread, &item) != 0)
             {
-                // find the bucket
-                uint64_t bucket_index = hash % interlocked_add(&current_bucket_array->bucket_count, 0);
+                LogError("clds_sorted_list_head_get_first failed");
+                result = MU_FAILURE;
+                break;
+            }
+
+            while (item != NULL)
+            {
+                HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
+                CLDS_SORTED_LIST_ITEM* next_item;
 
-                bucket_list = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->hash_table[bucket_index], NULL, NULL);
-                if (bucket_list == NULL)
+                if (clds_sorted_list_head_get_next(clds_hash_table->bucket_lists, bucket_list, clds_hazard_pointers_thread, &hash_table_item->hashed_key, &next_item) != 0)
                 {
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_053: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
-                    result = CLDS_HASH_TABLE_REMOVE_NOT_FOUND;
+                    LogError("clds_sorted_list_head_get_next failed");
+                    clds_sorted_list_node_release(item);
+                    result = MU_FAILURE;
+                    break;
                 }
-                else
-                {
-                    CLDS_SORTED_LIST_REMOVE_RESULT list_remove_result;
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_067: [ For each remove the order of the operation shall be computed by passing sequence_number to clds_sorted_list_remove_key. ]*/
-                    list_remove_result = clds_sorted_list_remove_key(bucket_list, clds_hazard_pointers_thread, key, (void*)item, sequence_number);
-                    if (list_remove_result == CLDS_SORTED_LIST_REMOVE_NOT_FOUND)
-                    {
-                        // not found
-                    }
-                    else if (list_remove_result == CLDS_SORTED_LIST_REMOVE_OK)
-                    {
-                        (void)interlocked_decrement(&current_bucket_array->item_count);
 
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_049: [ On success clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_OK. ]*/
-                        result = CLDS_HASH_TABLE_REMOVE_OK;
-                        break;
-                    }
-                    else
+                /* Codes_SRS_CLDS_HASH_TABLE_01_145: [ clds_hash_table_snapshot_at_sequence_number shall return the items that were inserted at or before the sequence number of the snapshot. ]*/
+                if (interlocked_add_64(&hash_table_item->insert_sequence_number, 0) > snapshot_sequence_number)
+                {
+                    // inserted after the snapshot
+                    clds_sorted_list_node_release(item);
+                }
+                else if (add_snapshot_item(snapshot_items, snapshot_item_count, snapshot_item_capacity, item) != 0)
+                {
+                    LogError("Cannot add the item to the snapshot");
+                    clds_sorted_list_node_release(item);
+                    if (next_item != NULL)
                     {
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_054: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-                        result = CLDS_HASH_TABLE_REMOVE_ERROR;
-                        break;
+                        clds_sorted_list_node_release(next_item);
                     }
+                    result = MU_FAILURE;
+                    break;
+                }
+                else
+                {
+                    // the snapshot owns the reference of the item now
                 }
+
+                item = next_item;
             }
+        }
 
-            /* Codes_SRS_CLDS_HASH_TABLE_01_055: [ If the element to be deleted is not found in the biggest array of buckets, then it shall be looked up in the next available array of buckets. ]*/
-            current_bucket_array = next_bucket_array;
+        if (result == 0)
+        {
+            BUCKET_ARRAY* next_bucket_array;
+            CLDS_HAZARD_POINTER_RECORD_HANDLE next_bucket_array_hp;
+            if (acquire_next_bucket_array(clds_hazard_pointers_thread, current_bucket_array, &next_bucket_array, &next_bucket_array_hp) != 0)
+            {
+                LogError("Cannot acquire the next bucket array");
+                result = MU_FAILURE;
+            }
+            else
+            {
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
+                current_bucket_array = next_bucket_array;
+                current_bucket_array_hp = next_bucket_array_hp;
+            }
         }
+    }
 
-        /* Codes_SRS_CLDS_HASH_TABLE_42_054: [ clds_hash_table_remove shall decrement the count of pending write operations. ]*/
-        end_write_operation(clds_hash_table);
+    if (current_bucket_array != NULL)
+    {
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_bucket_array_hp);
     }
 
     return result;
 }
 
-CLDS_HASH_TABLE_SET_VALUE_RESULT clds_hash_table_set_value(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* new_item, CONDITION_CHECK_CB condition_check_func, void* condition_check_context, CLDS_HASH_TABLE_ITEM** old_item, int64_t* sequence_number)
+CLDS_HASH_TABLE_SNAPSHOT_RESULT clds_hash_table_snapshot_at_sequence_number(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count, int64_t* sequence_number)
 {
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result;
 
     if (
-        /* Codes_SRS_CLDS_HASH_TABLE_01_079: [ If clds_hash_table is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_136: [ If clds_hash_table is NULL, clds_hash_table_snapshot_at_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
         (clds_hash_table == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_080: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_137: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_snapshot_at_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
         (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_081: [ If key is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-        (key == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_082: [ If new_item is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-        (new_item == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_083: [ If old_item is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-        (old_item == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_084: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_hash_table->sequence_number == NULL))
+        /* Codes_SRS_CLDS_HASH_TABLE_01_138: [ If items is NULL, clds_hash_table_snapshot_at_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (items == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_139: [ If item_count is NULL, clds_hash_table_snapshot_at_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (item_count == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_140: [ If sequence_number is NULL, clds_hash_table_snapshot_at_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (sequence_number == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_141: [ If no start sequence number was specified in clds_hash_table_create, clds_hash_table_snapshot_at_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (clds_hash_table->sequence_number == NULL)
         )
     {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_HASH_TABLE_ITEM* new_item=%p, CONDITION_CHECK_CB condition_check_func=%p, void* condition_check_context=%p, CLDS_HASH_TABLE_ITEM** old_item=%p, int64_t* sequence_number=%p",
-            clds_hash_table, key, clds_hazard_pointers_thread, new_item, condition_check_func, condition_check_context, old_item, sequence_number);
-        result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_HASH_TABLE_ITEM*** items=%p, uint64_t* item_count=%p, int64_t* sequence_number=%p",
+            clds_hash_table, clds_hazard_pointers_thread, items, item_count, sequence_number);
+        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
     }
     else
     {
-        uint64_t bucket_index;
-        CLDS_SORTED_LIST_HANDLE bucket_list;
+        /* Codes_SRS_CLDS_HASH_TABLE_01_142: [ clds_hash_table_snapshot_at_sequence_number shall wait for any other snapshot at a sequence number of the table to complete. ]*/
+        int32_t snapshot_state;
+        while ((snapshot_state = interlocked_compare_exchange(&clds_hash_table->sequence_number_snapshot_in_progress, SEQUENCE_NUMBER_SNAPSHOT_IN_PROGRESS, SEQUENCE_NUMBER_SNAPSHOT_NONE)) != SEQUENCE_NUMBER_SNAPSHOT_NONE)
+        {
+            (void)wait_on_address(&clds_hash_table->sequence_number_snapshot_in_progress, snapshot_state, UINT32_MAX);
+        }
 
-        /* Codes_SRS_CLDS_HASH_TABLE_42_055: [ clds_hash_table_set_value shall try the following until it acquires a write lock for the table: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_056: [ clds_hash_table_set_value shall increment the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_057: [ If the counter to lock the table for writes is non-zero then: ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_058: [ clds_hash_table_set_value shall decrement the count of pending write operations. ]*/
-        /* Codes_SRS_CLDS_HASH_TABLE_42_059: [ clds_hash_table_set_value shall wait for the counter to lock the table for writes to reach 0 and repeat. ]*/
-        check_lock_and_begin_write_operation(clds_hash_table);
+        /* Codes_SRS_CLDS_HASH_TABLE_01_143: [ clds_hash_table_snapshot_at_sequence_number shall wait for the write operations that started before it to complete and then take the current sequence number of the table as the sequence number of the snapshot, without blocking the write operations that start after it. ]*/
+        // the writes that started before the snapshot do not keep the items they take out of the table, they have to be done before the sequence number is taken
+        wait_for_writes_of_current_epoch(clds_hash_table);
+        (void)interlocked_exchange(&clds_hash_table->superseded_items_lost, 0);
+        int64_t snapshot_sequence_number = interlocked_add_64(clds_hash_table->sequence_number, 0);
 
-        // compute the hash
-        uint64_t hash = clds_hash_table->compute_hash(key);
+        // the writes that started while the sequence number was taken might have taken a lower sequence number than the snapshot
+        // and not have stored it in their item yet
+        wait_for_writes_of_current_epoch(clds_hash_table);
 
-        // find or allocate a new bucket array
-        BUCKET_ARRAY* first_bucket_array = get_first_bucket_array(clds_hash_table);
+        CLDS_SORTED_LIST_ITEM** snapshot_items = NULL;
+        uint64_t snapshot_item_count = 0;
+        uint64_t snapshot_item_capacity = 0;
+        int collect_result = collect_items_at_sequence_number(clds_hash_table, clds_hazard_pointers_thread, snapshot_sequence_number, &snapshot_items, &snapshot_item_count, &snapshot_item_capacity);
 
-        // increment pending inserts count
-        (void)interlocked_increment(&first_bucket_array->pending_insert_count);
+        // the writes that ran while the buckets were walked might have taken out items that were in the table at the sequence number of the snapshot
+        wait_for_writes_of_current_epoch(clds_hash_table);
+        CLDS_HASH_TABLE_ITEM* superseded_items = interlocked_exchange_pointer((void* volatile_atomic*)&clds_hash_table->superseded_items, NULL);
+        SUPERSEDED_ITEM_RECORD* superseded_item_records = interlocked_exchange_pointer((void* volatile_atomic*)&clds_hash_table->superseded_item_records, NULL);
+        bool superseded_items_lost = (interlocked_add(&clds_hash_table->superseded_items_lost, 0) != 0);
 
-        BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&first_bucket_array->next_bucket, NULL, NULL);
-        if (next_bucket_array != NULL)
+        if (collect_result != 0)
         {
-            // wait for all outstanding inserts in the lower levels to complete
-            do
+            /* Codes_SRS_CLDS_HASH_TABLE_01_149: [ If any error occurs, clds_hash_table_snapshot_at_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+            LogError("Cannot collect the items of the buckets");
+            result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+        }
+        else if (superseded_items_lost)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_149: [ If any error occurs, clds_hash_table_snapshot_at_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+            LogError("An item taken out of the table during the snapshot could not be kept");
+            result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+        }
+        else
+        {
+            result = CLDS_HASH_TABLE_SNAPSHOT_OK;
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_146: [ clds_hash_table_snapshot_at_sequence_number shall also return the items that were inserted at or before the sequence number of the snapshot and taken out of the table after it while the snapshot was taken. ]*/
+            CLDS_HASH_TABLE_ITEM* superseded_item = superseded_items;
+            while (superseded_item != NULL)
             {
-                if (interlocked_add(&next_bucket_array->pending_insert_count, 0) == 0)
+                HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, superseded_item);
+                if (add_superseded_item_in_snapshot(&snapshot_items, &snapshot_item_count, &snapshot_item_capacity, superseded_item,
+                    hash_table_item->superseded_insert_sequence_number, hash_table_item->superseded_remove_sequence_number, snapshot_sequence_number) != 0)
                 {
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_149: [ If any error occurs, clds_hash_table_snapshot_at_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                    LogError("Cannot add the superseded item to the snapshot");
+                    result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
                     break;
                 }
-            } while (1);
-        }
-
-        /* Codes_SRS_CLDS_HASH_TABLE_01_085: [ clds_hash_table_set_value shall go through all non top level bucket arrays and: ]*/
-        bool set_value_in_top_level = true;
-        result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
 
-        BUCKET_ARRAY* find_bucket_array = next_bucket_array;
-        while (find_bucket_array != NULL)
-        {
-            next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&find_bucket_array->next_bucket, NULL, NULL);
-
-            bucket_index = hash % interlocked_add(&find_bucket_array->bucket_count, 0);
-            bucket_list = interlocked_compare_exchange_pointer((void* volatile_atomic*)&find_bucket_array->hash_table[bucket_index], NULL, NULL);
+                superseded_item = hash_table_item->next_superseded_item;
+            }
 
-            if (bucket_list != NULL)
+            // the later removals of the items taken out of the table more than once, at most one removal of an item is after the snapshot
+            // with its insert at or before it
+            SUPERSEDED_ITEM_RECORD* superseded_item_record = (result == CLDS_HASH_TABLE_SNAPSHOT_OK) ? superseded_item_records : NULL;
+            while (superseded_item_record != NULL)
             {
-                /* Codes_SRS_CLDS_HASH_TABLE_01_108: [ If there is a sorted list in the bucket identified by the hash of the key, clds_hash_table_set_value shall find the key in the list. ]*/
-                CLDS_SORTED_LIST_ITEM* sorted_list_item = clds_sorted_list_find_key(bucket_list, clds_hazard_pointers_thread, key);
-                if (sorted_list_item != NULL)
+                if (add_superseded_item_in_snapshot(&snapshot_items, &snapshot_item_count, &snapshot_item_capacity, superseded_item_record->item,
+                    superseded_item_record->insert_sequence_number, superseded_item_record->remove_sequence_number, snapshot_sequence_number) != 0)
                 {
-                    clds_sorted_list_node_release(sorted_list_item);
-
-                    HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, new_item);
-                    hash_table_item->key = key;
-
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item, condition_check_func, condition_check_context and old_item and only_if_exists set to true. ]*/
-                    CLDS_SORTED_LIST_SET_VALUE_RESULT sorted_list_set_value_result = clds_sorted_list_set_value(bucket_list, clds_hazard_pointers_thread, key, (void*)new_item, condition_check_func, condition_check_context, (void*)old_item, sequence_number, true);
-                    switch (sorted_list_set_value_result)
-                    {
-                    default:
-                    case CLDS_SORTED_LIST_SET_VALUE_ERROR:
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_111: [ If clds_sorted_list_set_value fails, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-                        LogError("Cannot set key in sorted list: failed with %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_SET_VALUE_RESULT, sorted_list_set_value_result));
-                        set_value_in_top_level = false;
-                        break;
-
-                    case CLDS_SORTED_LIST_SET_VALUE_OK:
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_112: [ If clds_sorted_list_set_value succeeds, clds_hash_table_set_value shall return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
-                        result = CLDS_HASH_TABLE_SET_VALUE_OK;
-                        set_value_in_top_level = false;
-                        break;
-                    
-                    case CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET:
-                        /* Codes_SRS_CLDS_HASH_TABLE_04_001: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET. ]*/
-                        result = CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET;
-                        set_value_in_top_level = false;
-                        break;
-
-                    case CLDS_SORTED_LIST_SET_VALUE_NOT_FOUND:
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_109: [ If the key is not found, clds_hash_table_set_value shall advance to the next level of buckets. ]*/
-                        break;
-                    }
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_149: [ If any error occurs, clds_hash_table_snapshot_at_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                    LogError("Cannot add the superseded item to the snapshot");
+                    result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+                    break;
                 }
-            }
-            else
-            {
-                /* Codes_SRS_CLDS_HASH_TABLE_01_107: [ If there is no sorted list in the bucket identified by the hash of the key, clds_hash_table_set_value shall advance to the next level of buckets. ]*/
-            }
-
-            find_bucket_array = next_bucket_array;
-        }
 
-        if (set_value_in_top_level)
-        {
-            /* Codes_SRS_CLDS_HASH_TABLE_01_102: [ If the key is not found in any of the non top level buckets arrays, clds_hash_table_set_value: ]*/
-            BUCKET_ARRAY* current_bucket_array = first_bucket_array;
-
-            // look for the item in this bucket array
-            // find the bucket
-            bucket_index = hash % interlocked_add(&current_bucket_array->bucket_count, 0);
-            bool restart_needed = false;
+                superseded_item_record = superseded_item_record->next;
+            }
 
-            do
+            if (result == CLDS_HASH_TABLE_SNAPSHOT_OK)
             {
-                /* Codes_SRS_CLDS_HASH_TABLE_01_103: [ clds_hash_table_set_value shall obtain the sorted list at the bucket corresponding to the hash of the key. ]*/
-                // do we have a list here or do we create one?
-                bucket_list = interlocked_compare_exchange_pointer((void* volatile_atomic*) &current_bucket_array->hash_table[bucket_index], NULL, NULL);
-                if (bucket_list != NULL)
-                {
-                    restart_needed = false;
-                }
-                else
+                // an item taken out of the table after its bucket was walked was found twice
+                if (snapshot_item_count > 1)
                 {
-                    // create a list
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_104: [  If no list exists at the designated bucket, one shall be created. ]*/
-                    bucket_list = clds_sorted_list_create(clds_hash_table->clds_hazard_pointers, get_item_key_cb, clds_hash_table, key_compare_cb, clds_hash_table, clds_hash_table->sequence_number, clds_hash_table->sequence_number == NULL ? NULL : on_sorted_list_skipped_seq_no, clds_hash_table);
-                    if (bucket_list == NULL)
-                    {
-                        /* Codes_SRS_CLDS_HASH_TABLE_01_106: [ If any error occurs, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-                        LogError("Cannot allocate list for hash table bucket");
-                        restart_needed = false;
-                    }
-                    else
+                    uint64_t unique_item_count = 1;
+                    qsort(snapshot_items, (size_t)snapshot_item_count, sizeof(CLDS_SORTED_LIST_ITEM*), compare_item_pointers);
+                    for (uint64_t i = 1; i < snapshot_item_count; i++)
                     {
-                        // now put the list in the bucket
-                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->hash_table[bucket_index], bucket_list, NULL) != NULL)
+                        if (snapshot_items[i] == snapshot_items[unique_item_count - 1])
                         {
-                            // oops, someone else inserted a new list, just bail on our list and restart
-                            clds_sorted_list_destroy(bucket_list);
-                            restart_needed = true;
+                            clds_sorted_list_node_release(snapshot_items[i]);
                         }
                         else
                         {
-                            // set new list
-                            restart_needed = false;
+                            snapshot_items[unique_item_count] = snapshot_items[i];
+                            unique_item_count++;
                         }
                     }
+
+                    snapshot_item_count = unique_item_count;
                 }
-            } while (restart_needed);
 
-            if (bucket_list == NULL)
-            {
-                LogError("Cannot acquire bucket list");
-                result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+                if (snapshot_item_count == 0)
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_147: [ If there are no items, clds_hash_table_snapshot_at_sequence_number shall set items to NULL and item_count to 0. ]*/
+                    free(snapshot_items);
+                    snapshot_items = NULL;
+                }
+
+                /* Codes_SRS_CLDS_HASH_TABLE_01_148: [ On success clds_hash_table_snapshot_at_sequence_number shall store the items, each with a reference that the caller has to release, in items, their count in item_count and the sequence number of the snapshot in sequence_number and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+                *items = (CLDS_HASH_TABLE_ITEM**)snapshot_items;
+                *item_count = snapshot_item_count;
+                *sequence_number = snapshot_sequence_number;
+                snapshot_items = NULL;
             }
-            else
+        }
+
+        if (snapshot_items != NULL)
+        {
+            for (uint64_t i = 0; i < snapshot_item_count; i++)
             {
-                HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, new_item);
+                clds_sorted_list_node_release(snapshot_items[i]);
+            }
+            free(snapshot_items);
+        }
 
-                hash_table_item->key = key;
+        /* Codes_SRS_CLDS_HASH_TABLE_01_230: [ When the snapshot completes, clds_hash_table_snapshot_at_sequence_number shall stop the writes from keeping items, wait for the writes that still keep items to complete and release all the kept items. ]*/
+        (void)interlocked_exchange(&clds_hash_table->sequence_number_snapshot_in_progress, SEQUENCE_NUMBER_SNAPSHOT_COMPLETING);
+        wait_for_writes_of_current_epoch(clds_hash_table);
+        release_superseded_items(superseded_items);
+        release_superseded_items(interlocked_exchange_pointer((void* volatile_atomic*)&clds_hash_table->superseded_items, NULL));
+        release_superseded_item_records(superseded_item_records);
+        release_superseded_item_records(interlocked_exchange_pointer((void* volatile_atomic*)&clds_hash_table->superseded_item_records, NULL));
 
-                /* Codes_SRS_CLDS_HASH_TABLE_01_105: [ clds_hash_table_set_value shall call clds_hash_table_set_value on the top level bucket array, passing key, new_item, condition_check_func, condition_check_context, old_item and only_if_exists set to false. ]*/
-                CLDS_SORTED_LIST_SET_VALUE_RESULT sorted_list_set_value = clds_sorted_list_set_value(bucket_list, clds_hazard_pointers_thread, key, (void*)new_item, condition_check_func, condition_check_context, (void*)old_item, sequence_number, false);
-                if (sorted_list_set_value == CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET)
-                {
-                    /* Codes_SRS_CLDS_HASH_TABLE_04_002: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET. ]*/
-                    LogError("Condition not met during set value - %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_SET_VALUE_RESULT, sorted_list_set_value));
-                    result = CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET;
-                }
-                else if (sorted_list_set_value != CLDS_SORTED_LIST_SET_VALUE_OK)
-                {
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_100: [ If clds_sorted_list_set_value returns any other value, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-                    LogError("Cannot set key in sorted list - %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_SORTED_LIST_SET_VALUE_RESULT, sorted_list_set_value));
-                    result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
-                }
-                else
-                {
-                    if (*old_item == NULL)
-                    {
-                        (void)interlocked_increment(&first_bucket_array->item_count);
-                    }
+        (void)interlocked_exchange(&clds_hash_table->sequence_number_snapshot_in_progress, SEQUENCE_NUMBER_SNAPSHOT_NONE);
+        wake_by_address_all(&clds_hash_table->sequence_number_snapshot_in_progress);
+    }
 
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_099: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_OK, clds_hash_table_set_value shall succeed and return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
-                    result = CLDS_HASH_TABLE_SET_VALUE_OK;
-                }
-            }
+    return result;
+}
+
+CLDS_HASH_TABLE_CURSOR_HANDLE clds_hash_table_cursor_open(CLDS_HASH_TABLE_HANDLE clds_hash_table)
+{
+    CLDS_HASH_TABLE_CURSOR_HANDLE result;
+
+    /* Codes_SRS_CLDS_HASH_TABLE_01_152: [ If clds_hash_table is NULL, clds_hash_table_cursor_open shall fail and return NULL. ]*/
+    if (clds_hash_table == NULL)
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p", clds_hash_table);
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_153: [ clds_hash_table_cursor_open shall allocate a new cursor. ]*/
+        result = malloc(sizeof(CLDS_HASH_TABLE_CURSOR));
+        if (result == NULL)
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_154: [ If any error occurs, clds_hash_table_cursor_open shall fail and return NULL. ]*/
+            LogError("malloc(sizeof(CLDS_HASH_TABLE_CURSOR)=%zu) failed", sizeof(CLDS_HASH_TABLE_CURSOR));
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_155: [ clds_hash_table_cursor_open shall increment the count of open cursors of the table and wait for the write operations that started before it to complete, without blocking the write operations that start after it. ]*/
+            // once the writes that might be migrating items are done the bucket arrays stay as they are (new ones can still be added in front)
+            // until the cursor is closed, so the cursor can keep pointers to them without hazard pointers
+            (void)interlocked_increment(&clds_hash_table->open_cursor_count);
+            wait_for_writes_of_current_epoch(clds_hash_table);
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_156: [ clds_hash_table_cursor_open shall position the cursor at the first bucket of the first array of buckets. ]*/
+            result->clds_hash_table = clds_hash_table;
+            result->bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
+            result->bucket_index = 0;
+            result->last_item = NULL;
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_157: [ On success clds_hash_table_cursor_open shall return a non-NULL handle to the cursor. ]*/
         }
-
-        (void)interlocked_decrement(&first_bucket_array->pending_insert_count);
-
-        /* Codes_SRS_CLDS_HASH_TABLE_42_060: [ clds_hash_table_set_value shall decrement the count of pending write operations. ]*/
-        end_write_operation(clds_hash_table);
     }
 
     return result;
 }
 
-CLDS_HASH_TABLE_ITEM* clds_hash_table_find(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+int clds_hash_table_cursor_next(CLDS_HASH_TABLE_CURSOR_HANDLE clds_hash_table_cursor, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM** items, uint32_t item_capacity, uint32_t* item_count)
 {
-    CLDS_HASH_TABLE_ITEM* result;
+    int result;
 
     if (
-        /* Codes_SRS_CLDS_HASH_TABLE_01_035: [ If clds_hash_table is NULL, clds_hash_table_find shall fail and return NULL. ]*/
-        (clds_hash_table == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_036: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_find shall fail and return NULL. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_158: [ If clds_hash_table_cursor is NULL, clds_hash_table_cursor_next shall fail and return a non-zero value. ]*/
+        (clds_hash_table_cursor == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_159: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_cursor_next shall fail and return a non-zero value. ]*/
         (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_01_037: [ If key is NULL, clds_hash_table_find shall fail and return NULL. ]*/
-        (key == NULL)
+        /* Codes_SRS_CLDS_HASH_TABLE_01_160: [ If items is NULL, clds_hash_table_cursor_next shall fail and return a non-zero value. ]*/
+        (items == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_161: [ If item_capacity is 0, clds_hash_table_cursor_next shall fail and return a non-zero value. ]*/
+        (item_capacity == 0) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_162: [ If item_count is NULL, clds_hash_table_cursor_next shall fail and return a non-zero value. ]*/
+        (item_count == NULL)
         )
     {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p",
-            clds_hash_table, clds_hazard_pointers_thread, key);
-        result = NULL;
+        LogError("Invalid arguments: CLDS_HASH_TABLE_CURSOR_HANDLE clds_hash_table_cursor=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_HASH_TABLE_ITEM** items=%p, uint32_t item_capacity=%" PRIu32 ", uint32_t* item_count=%p",
+            clds_hash_table_cursor, clds_hazard_pointers_thread, items, item_capacity, item_count);
+        result = MU_FAILURE;
     }
     else
     {
-        CLDS_SORTED_LIST_HANDLE bucket_list;
-
-        result = NULL;
+        CLDS_HASH_TABLE_HANDLE clds_hash_table = clds_hash_table_cursor->clds_hash_table;
+        uint32_t stored_item_count = 0;
+        bool walk_failed = false;
 
-        // compute the hash
-        /* Codes_SRS_CLDS_HASH_TABLE_01_040: [ clds_hash_table_find shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-        uint64_t hash = clds_hash_table->compute_hash(key);
-
-        /* Codes_SRS_CLDS_HASH_TABLE_01_041: [ clds_hash_table_find shall look up the key in the biggest array of buckets. ]*/
-        BUCKET_ARRAY* current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
-        while (current_bucket_array != NULL)
+        /* Codes_SRS_CLDS_HASH_TABLE_01_165: [ clds_hash_table_cursor_next shall stop once item_capacity items are stored in items or all the arrays of buckets were walked. ]*/
+        while ((stored_item_count < item_capacity) && (clds_hash_table_cursor->bucket_array != NULL))
         {
-            BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
+            BUCKET_ARRAY* bucket_array = clds_hash_table_cursor->bucket_array;
 
-            if (interlocked_add(&current_bucket_array->item_count, 0) != 0)
+            /* Codes_SRS_CLDS_HASH_TABLE_01_164: [ Once a bucket has no more items, clds_hash_table_cursor_next shall continue with the next bucket and after the last bucket of an array of buckets with the first bucket of the next array of buckets. ]*/
+            if (clds_hash_table_cursor->bucket_index >= interlocked_add(&bucket_array->bucket_count, 0))
             {
-                // find the bucket
-                /* Codes_SRS_CLDS_HASH_TABLE_01_044: [ Looking up the key in the array of buckets is done by obtaining the list in the bucket correspoding to the hash and looking up the key in the list by calling clds_sorted_list_find. ]*/
-                uint64_t bucket_index = hash % interlocked_add(&current_bucket_array->bucket_count, 0);
+                clds_hash_table_cursor->bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_array->next_bucket, NULL, NULL);
+                clds_hash_table_cursor->bucket_index = 0;
+            }
+            else
+            {
+                CLDS_SORTED_LIST_HEAD* bucket_list = &bucket_array->hash_table[clds_hash_table_cursor->bucket_index];
+                CLDS_SORTED_LIST_ITEM* item;
 
-                bucket_list = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->hash_table[bucket_index], NULL, NULL);
-                if (bucket_list != NULL)
+                if (clds_hash_table_cursor->last_item == NULL)
                 {
-                    /* Codes_SRS_CLDS_HASH_TABLE_01_034: [ clds_hash_table_find shall find the key identified by key in the hash table and on success return the item corresponding to it. ]*/
-                    result = (void*)clds_sorted_list_find_key(bucket_list, clds_hazard_pointers_thread, key);
-                    if (result == NULL)
+                    if (CLDS_SORTED_LIST_HEAD_IS_EMPTY(bucket_list))
+                    {
+                        item = NULL;
+                    }
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_163: [ clds_hash_table_cursor_next shall walk the buckets from where the previous call left off, getting the first item of a bucket with clds_sorted_list_head_get_first and each following item with clds_sorted_list_head_get_next and the key of the last item returned out of the bucket. ]*/
+                    else if (clds_sorted_list_head_get_first(clds_hash_table->bucket_lists, bucket_list, clds_hazard_pointers_thread, &item) != 0)
                     {
-                        // go to the next level of buckets
+                        LogError("clds_sorted_list_head_get_first failed");
+                        walk_failed = true;
+                        break;
                     }
                     else
                     {
-                        // found
+                        // got the first item (if any)
+                    }
+                }
+                else
+                {
+                    HASH_TABLE_ITEM* last_hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, clds_hash_table_cursor->last_item);
+
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_163: [ clds_hash_table_cursor_next shall walk the buckets from where the previous call left off, getting the first item of a bucket with clds_sorted_list_head_get_first and each following item with clds_sorted_list_head_get_next and the key of the last item returned out of the bucket. ]*/
+                    if (clds_sorted_list_head_get_next(clds_hash_table->bucket_lists, bucket_list, clds_hazard_pointers_thread, &last_hash_table_item->hashed_key, &item) != 0)
+                    {
+                        LogError("clds_sorted_list_head_get_next failed");
+                        walk_failed = true;
                         break;
                     }
                 }
-            }
 
-            /* Codes_SRS_CLDS_HASH_TABLE_01_042: [ If the key is not found in the biggest array of buckets, the next bucket arrays shall be looked up. ]*/
-            current_bucket_array = next_bucket_array;
+                if (item == NULL)
+                {
+                    if (clds_hash_table_cursor->last_item != NULL)
+                    {
+                        clds_sorted_list_node_release(clds_hash_table_cursor->last_item);
+                        clds_hash_table_cursor->last_item = NULL;
+                    }
+
+                    clds_hash_table_cursor->bucket_index++;
+                }
+                else
+                {
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_166: [ clds_hash_table_cursor_next shall return each item with a reference that the caller has to release. ]*/
+                    items[stored_item_count] = (CLDS_HASH_TABLE_ITEM*)item;
+                    stored_item_count++;
+
+                    // the cursor keeps its own reference, the caller might release the item before the next call
+                    (void)clds_sorted_list_node_inc_ref(item);
+                    if (clds_hash_table_cursor->last_item != NULL)
+                    {
+                        clds_sorted_list_node_release(clds_hash_table_cursor->last_item);
+                    }
+                    clds_hash_table_cursor->last_item = item;
+                }
+            }
         }
 
-        if (current_bucket_array == NULL)
+        if (walk_failed && (stored_item_count == 0))
         {
-            /* not found */
-            /* Codes_SRS_CLDS_HASH_TABLE_01_043: [ If the key is not found at all, clds_hash_table_find shall return NULL. ]*/
-            result = NULL;
+            /* Codes_SRS_CLDS_HASH_TABLE_01_168: [ If clds_sorted_list_head_get_first or clds_sorted_list_head_get_next fails before any item was stored in items, clds_hash_table_cursor_next shall fail and return a non-zero value. ]*/
+            result = MU_FAILURE;
         }
         else
         {
-            // all OK
+            /* Codes_SRS_CLDS_HASH_TABLE_01_169: [ If clds_sorted_list_head_get_first or clds_sorted_list_head_get_next fails after items were stored in items, clds_hash_table_cursor_next shall return the stored items and the next call shall continue with the bucket that failed. ]*/
+            /* Codes_SRS_CLDS_HASH_TABLE_01_167: [ On success clds_hash_table_cursor_next shall store the number of items stored in items in item_count (0 once all the buckets were walked) and return 0. ]*/
+            *item_count = stored_item_count;
+            result = 0;
         }
     }
 
     return result;
 }
 
-CLDS_HASH_TABLE_SNAPSHOT_RESULT clds_hash_table_snapshot(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count)
+void clds_hash_table_cursor_close(CLDS_HASH_TABLE_CURSOR_HANDLE clds_hash_table_cursor)
 {
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result;
+    /* Codes_SRS_CLDS_HASH_TABLE_01_170: [ If clds_hash_table_cursor is NULL, clds_hash_table_cursor_close shall return. ]*/
+    if (clds_hash_table_cursor == NULL)
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_CURSOR_HANDLE clds_hash_table_cursor=%p", clds_hash_table_cursor);
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_HASH_TABLE_01_171: [ clds_hash_table_cursor_close shall release the reference the cursor holds on the last item it returned. ]*/
+        if (clds_hash_table_cursor->last_item != NULL)
+        {
+            clds_sorted_list_node_release(clds_hash_table_cursor->last_item);
+        }
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_172: [ clds_hash_table_cursor_close shall decrement the count of open cursors of the table and free the cursor. ]*/
+        (void)interlocked_decrement(&clds_hash_table_cursor->clds_hash_table->open_cursor_count);
+        free(clds_hash_table_cursor);
+    }
+}
+
+int clds_hash_table_set_migration_bucket_count(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint32_t write_migration_bucket_count, uint32_t read_migration_bucket_count)
+{
+    int result;
 
     if (
-        /* Codes_SRS_CLDS_HASH_TABLE_42_013: [ If clds_hash_table is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        /* Codes_SRS_CLDS_HASH_TABLE_01_120: [ If clds_hash_table is NULL, clds_hash_table_set_migration_bucket_count shall fail and return a non-zero value. ]*/
         (clds_hash_table == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_42_014: [ If clds_hazard_pointers_thread is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-        (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_42_015: [ If items is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-        (items == NULL) ||
-        /* Codes_SRS_CLDS_HASH_TABLE_42_016: [ If item_count is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-        (item_count == NULL)
+        /* Codes_SRS_CLDS_HASH_TABLE_01_121: [ If write_migration_bucket_count or read_migration_bucket_count is greater than INT32_MAX, clds_hash_table_set_migration_bucket_count shall fail and return a non-zero value. ]*/
+        (write_migration_bucket_count > INT32_MAX) ||
+        (read_migration_bucket_count > INT32_MAX)
         )
     {
-        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_HASH_TABLE_ITEM*** items=%p, uint64_t* item_count=%p",
-            clds_hash_table, clds_hazard_pointers_thread, items, item_count);
-        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, uint32_t write_migration_bucket_count=%" PRIu32 ", uint32_t read_migration_bucket_count=%" PRIu32 "",
+            clds_hash_table, write_migration_bucket_count, read_migration_bucket_count);
+        result = MU_FAILURE;
     }
     else
     {
-        internal_lock_writes(clds_hash_table);
+        /* Codes_SRS_CLDS_HASH_TABLE_01_122: [ clds_hash_table_set_migration_bucket_count shall set the number of buckets migrated by each write operation to write_migration_bucket_count and the number of buckets migrated by each clds_hash_table_find to read_migration_bucket_count. ]*/
+        (void)interlocked_exchange(&clds_hash_table->write_migration_bucket_count, (int32_t)write_migration_bucket_count);
+        (void)interlocked_exchange(&clds_hash_table->read_migration_bucket_count, (int32_t)read_migration_bucket_count);
 
-        uint64_t temp_item_count = 0;
-        bool failed = false;
-        bool need_to_unlock_all = false;
+        /* Codes_SRS_CLDS_HASH_TABLE_01_123: [ On success clds_hash_table_set_migration_bucket_count shall return 0. ]*/
+        result = 0;
+    }
 
-        /* Codes_SRS_CLDS_HASH_TABLE_42_019: [ For each bucket in the array: ]*/
-        BUCKET_ARRAY* current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
-        while (current_bucket_array != NULL)
+    return result;
+}
+
+int clds_hash_table_reserve(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint32_t item_count)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_216: [ If clds_hash_table is NULL, clds_hash_table_reserve shall fail and return a non-zero value. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_217: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_reserve shall fail and return a non-zero value. ]*/
+        (clds_hazard_pointers_thread == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, uint32_t item_count=%" PRIu32 "",
+            clds_hash_table, clds_hazard_pointers_thread, item_count);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        uint32_t write_slot = check_lock_and_begin_write_operation(clds_hash_table);
+
+        /* Codes_SRS_CLDS_HASH_TABLE_01_218: [ If the first array of buckets has fewer buckets than needed to hold item_count items, clds_hash_table_reserve shall add a new first array of buckets, with the number of buckets of the first array doubled as many times as needed to hold item_count items. ]*/
+        if (presize_first_bucket_array(clds_hash_table, clds_hazard_pointers_thread, item_count, false) != 0)
         {
-            BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
+            /* Codes_SRS_CLDS_HASH_TABLE_01_219: [ If any error occurs, clds_hash_table_reserve shall fail and return a non-zero value. ]*/
+            LogError("Cannot size the first bucket array for %" PRIu32 " items", item_count);
+            result = MU_FAILURE;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_HASH_TABLE_01_220: [ On success clds_hash_table_reserve shall return 0. ]*/
+            result = 0;
+        }
 
-            if (interlocked_add(&current_bucket_array->item_count, 0) != 0)
-            {
-                int32_t bucket_count = interlocked_add(&current_bucket_array->bucket_count, 0);
-                int32_t i;
-                for (i = 0; i < bucket_count; i++)
-                {
-                    if (current_bucket_array->hash_table[i] != NULL)
-                    {
-                        /* Codes_SRS_CLDS_HASH_TABLE_42_020: [ clds_hash_table_snapshot shall call clds_sorted_list_lock_writes. ]*/
-                        clds_sorted_list_lock_writes(current_bucket_array->hash_table[i]);
-                        need_to_unlock_all = true;
+        end_write_operation(clds_hash_table, write_slot);
+    }
 
-                        /* Codes_SRS_CLDS_HASH_TABLE_42_021: [ clds_hash_table_snapshot shall call clds_sorted_list_get_count and add to the running total. ]*/
-                        uint64_t list_item_count;
-                        CLDS_SORTED_LIST_GET_COUNT_RESULT count_result = clds_sorted_list_get_count(current_bucket_array->hash_table[i], clds_hazard_pointers_thread, &list_item_count);
-                        if (count_result != CLDS_SORTED_LIST_GET_COUNT_OK)
-                        {
-                            /* Codes_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-                            LogError("clds_sorted_list_get_count failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_GET_COUNT_RESULT, count_result));
-                            clds_sorted_list_unlock_writes(current_bucket_array->hash_table[i]);
-                            break;
-                        }
-                        else
-                        {
-                            if (list_item_count + temp_item_count < temp_item_count)
-                            {
-                                /* Codes_SRS_CLDS_HASH_TABLE_42_022: [ If the addition of the list count causes overflow then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-                                LogError("overflow in computing total count (%" PRIu64 " + %" PRIu64 ")", temp_item_count, list_item_count);
-                                clds_sorted_list_unlock_writes(current_bucket_array->hash_table[i]);
-                                break;
-                            }
-                            else
-                            {
-                                temp_item_count += list_item_count;
-                            }
-                        }
-                    }
-                }
+    return result;
+}
 
-                if (i < bucket_count)
-                {
-                    for (int32_t index_to_clean = 0; index_to_clean < i; index_to_clean++)
-                    {
-                        if (current_bucket_array->hash_table[index_to_clean] != NULL)
-                        {
-                            clds_sorted_list_unlock_writes(current_bucket_array->hash_table[index_to_clean]);
-                        }
-                    }
-                    failed = true;
-                    break;
-                }
-            }
+int clds_hash_table_shrink(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    int result;
 
-            current_bucket_array = next_bucket_array;
-        }
+    if (
+        /* Codes_SRS_CLDS_HASH_TABLE_01_221: [ If clds_hash_table is NULL, clds_hash_table_shrink shall fail and return a non-zero value. ]*/
+        (clds_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_HASH_TABLE_01_222: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_shrink shall fail and return a non-zero value. ]*/
+        (clds_hazard_pointers_thread == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HASH_TABLE_HANDLE clds_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p",
+            clds_hash_table, clds_hazard_pointers_thread);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        uint32_t write_slot = check_lock_and_begin_write_operation(clds_hash_table);
 
-        if (failed)
+        CLDS_HAZARD_POINTER_RECORD_HANDLE first_bucket_array_hp;
+        BUCKET_ARRAY* first_bucket_array = acquire_first_bucket_array(clds_hash_table, clds_hazard_pointers_thread, &first_bucket_array_hp);
+        if (first_bucket_array == NULL)
         {
-            result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+            /* Codes_SRS_CLDS_HASH_TABLE_01_228: [ If any error occurs, clds_hash_table_shrink shall fail and return a non-zero value. ]*/
+            LogError("Cannot acquire the first bucket array");
+            result = MU_FAILURE;
         }
         else
         {
-            if (temp_item_count == 0)
+            int64_t item_count;
+
+            /* Codes_SRS_CLDS_HASH_TABLE_01_223: [ clds_hash_table_shrink shall count the items in all the arrays of buckets. ]*/
+            if (get_item_count_in_all_bucket_arrays(clds_hazard_pointers_thread, first_bucket_array, &item_count) != 0)
             {
-                /* Codes_SRS_CLDS_HASH_TABLE_42_064: [ If there are no items then clds_hash_table_snapshot shall set items to NULL and item_count to 0 and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
-                *items = NULL;
-                *item_count = 0;
-                result = CLDS_HASH_TABLE_SNAPSHOT_OK;
+                /* Codes_SRS_CLDS_HASH_TABLE_01_228: [ If any error occurs, clds_hash_table_shrink shall fail and return a non-zero value. ]*/
+                LogError("Cannot count the items in the bucket arrays");
+                result = MU_FAILURE;
             }
             else
             {
-                /* Codes_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
-                CLDS_SORTED_LIST_ITEM** items_to_return = malloc_2((size_t)temp_item_count, sizeof(CLDS_SORTED_LIST_ITEM*));
+                int32_t bucket_count = interlocked_add(&first_bucket_array->bucket_count, 0);
 
-                if (items_to_return == NULL)
+                /* Codes_SRS_CLDS_HASH_TABLE_01_224: [ clds_hash_table_shrink shall halve the number of buckets of the first array of buckets as long as the halved number of buckets is at least the number of buckets the table was created with and at least twice the number of items. ]*/
+                int32_t new_bucket_count = get_shrunk_bucket_count(clds_hash_table, bucket_count, item_count);
+                if (new_bucket_count == bucket_count)
                 {
-                    /* Codes_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-                    LogError("malloc_2((size_t)temp_item_count=%zu, sizeof(CLDS_SORTED_LIST_ITEM*)=%zu) failed for the items to return",
-                        (size_t)temp_item_count, sizeof(CLDS_SORTED_LIST_ITEM*));
-                    result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+                    // the first array is as small as it gets, the older arrays are still migrated and freed
+                    result = 0;
                 }
                 else
                 {
-                    uint64_t result_index = 0;
-
-                    /* Codes_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
-                    current_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
-                    while (current_bucket_array != NULL)
+                    /* Codes_SRS_CLDS_HASH_TABLE_01_225: [ If the number of buckets is smaller than the number of buckets of the first array of buckets, clds_hash_table_shrink shall add a new first array of buckets with that number of buckets. ]*/
+                    BUCKET_ARRAY* new_bucket_array = create_bucket_array(new_bucket_count);
+                    if (new_bucket_array == NULL)
                     {
-                        BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_bucket_array->next_bucket, NULL, NULL);
-
-                        if (interlocked_add(&current_bucket_array->item_count, 0) != 0)
-                        {
-                            int32_t bucket_count = interlocked_add(&current_bucket_array->bucket_count, 0);
-                            int32_t i;
-                            for (i = 0; i < bucket_count; i++)
-                            {
-                                if (current_bucket_array->hash_table[i] != NULL)
-                                {
-                                    if (!failed)
-                                    {
-                                        /* Codes_SRS_CLDS_HASH_TABLE_42_025: [ clds_hash_table_snapshot shall call clds_sorted_list_get_count. ]*/
-                                        uint64_t list_item_count;
-                                        CLDS_SORTED_LIST_GET_COUNT_RESULT count_result = clds_sorted_list_get_count(current_bucket_array->hash_table[i], clds_hazard_pointers_thread, &list_item_count);
-                                        if (count_result != CLDS_SORTED_LIST_GET_COUNT_OK)
-                                        {
-                                            /* Codes_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-                                            LogError("clds_sorted_list_get_count failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_GET_COUNT_RESULT, count_result));
-                                            failed = true;
-                                        }
-                                        else
-                                        {
-                                            if (list_item_count == 0)
-                                            {
-                                                // skip
-                                            }
-                                            else
-                                            {
-                                                /* Codes_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array. ]*/
-                                                CLDS_SORTED_LIST_GET_ALL_RESULT get_all_result = clds_sorted_list_get_all(current_bucket_array->hash_table[i], clds_hazard_pointers_thread, list_item_count, items_to_return + result_index);
-                                                if (get_all_result != CLDS_SORTED_LIST_GET_ALL_OK)
-                                                {
-                                                    /* Codes_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-                                                    LogError("clds_sorted_list_get_all failed with %" PRI_MU_ENUM, MU_ENUM_VALUE(CLDS_SORTED_LIST_GET_ALL_RESULT, get_all_result));
-                                                    failed = true;
-                                                }
-                                                else
-                                                {
-                                                    result_index += list_item_count;
-                                                }
-                                            }
-                                        }
-                                    }
-
-                                    /* Codes_SRS_CLDS_HASH_TABLE_42_027: [ clds_hash_table_snapshot shall call clds_sorted_list_unlock_writes. ]*/
-                                    clds_sorted_list_unlock_writes(current_bucket_array->hash_table[i]);
-                                }
-                            }
-                        }
-
-                        current_bucket_array = next_bucket_array;
+                        /* Codes_SRS_CLDS_HASH_TABLE_01_228: [ If any error occurs, clds_hash_table_shrink shall fail and return a non-zero value. ]*/
+                        LogError("Cannot allocate the bucket array for %" PRId32 " buckets", new_bucket_count);
+                        result = MU_FAILURE;
                     }
-
-                    need_to_unlock_all = false; // Unlocked
-
-                    if (failed)
+                    else
                     {
-                        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
-
-                        for (uint64_t i = 0; i < result_index; i++)
+                        (void)interlocked_exchange_pointer((void* volatile_atomic*)&new_bucket_array->next_bucket, first_bucket_array);
+                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, new_bucket_array, first_bucket_array) == first_bucket_array)
                         {
-                            clds_sorted_list_node_release(items_to_return[i]);
+                            (void)interlocked_increment(&clds_hash_table->bucket_array_count);
+                        }
+                        else
+                        {
+                            /* Codes_SRS_CLDS_HASH_TABLE_01_226: [ If the first array of buckets was changed by another write in the meantime, clds_hash_table_shrink shall not add the new array of buckets. ]*/
+                            // the table grew because of the writes, it is not the time to shrink it
+                            free(new_bucket_array);
                         }
-                        free(items_to_return);
-                    }
-                    else
-                    {
-                        /* Codes_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
-                        *items = (CLDS_HASH_TABLE_ITEM**)items_to_return;
-                        items_to_return = NULL;
-
-                        /* Codes_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
-                        *item_count = result_index;
 
-                        /* Codes_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
-                        result = CLDS_HASH_TABLE_SNAPSHOT_OK;
+                        result = 0;
                     }
                 }
             }
+
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, first_bucket_array_hp);
         }
 
-        if (need_to_unlock_all)
+        if (result == 0)
         {
-            // Unlock all the lists that have been locked so far
-            // If we only looked at part of the table, the old "current_bucket_array" is already in a cleaned up state
-            // Otherwise it is NULL and we will unlock everything
-            BUCKET_ARRAY* bucket_array_to_clean = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hash_table->first_hash_table, NULL, NULL);
-            while (bucket_array_to_clean != current_bucket_array)
-            {
-                BUCKET_ARRAY* next_bucket_array = interlocked_compare_exchange_pointer((void* volatile_atomic*)&bucket_array_to_clean->next_bucket, NULL, NULL);
-
-                if (interlocked_add(&bucket_array_to_clean->item_count, 0) != 0)
-                {
-                    int32_t bucket_count = interlocked_add(&bucket_array_to_clean->bucket_count, 0);
-                    for (int32_t i = 0; i < bucket_count; i++)
-                    {
-                        if (bucket_array_to_clean->hash_table[i] != NULL)
-                        {
-                            clds_sorted_list_unlock_writes(bucket_array_to_clean->hash_table[i]);
-                        }
-                    }
-                }
+            /* Codes_SRS_CLDS_HASH_TABLE_01_227: [ clds_hash_table_shrink shall migrate all the items of the older arrays of buckets to the first array of buckets, the emptied arrays of buckets being freed once no thread uses them anymore. ]*/
+            migrate_older_bucket_arrays(clds_hash_table, clds_hazard_pointers_thread);
 
-                bucket_array_to_clean = next_bucket_array;
-            }
+            /* Codes_SRS_CLDS_HASH_TABLE_01_229: [ On success clds_hash_table_shrink shall return 0. ]*/
         }
 
-        internal_unlock_writes(clds_hash_table);
+        end_write_operation(clds_hash_table, write_slot);
     }
 
     return result;
@@ -1335,9 +3997,13 @@ CLDS_HASH_TABLE_ITEM* clds_hash_table_node_create(size_t node_size, HASH_TABLE_I
         HASH_TABLE_ITEM* hash_table_item = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item);
         hash_table_item->item_cleanup_callback = item_cleanup_callback;
         hash_table_item->item_cleanup_callback_context = item_cleanup_callback_context;
+        (void)interlocked_exchange_64(&hash_table_item->insert_sequence_number, INT64_MAX);
+        hash_table_item->next_superseded_item = NULL;
+        (void)interlocked_exchange(&hash_table_item->is_superseded, 0);
         item->item.item_cleanup_callback = sorted_list_item_cleanup;
         item->item.item_cleanup_callback_context = (void*)item;
         (void)interlocked_exchange(&item->item.ref_count, 1);
+        CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&item->item);
     }
 
     return result;
@@ -2,19 +2,64 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <stdbool.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include "windows.h"
+#elif defined(__linux__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/membarrier.h>
+#endif
+
+#ifndef _MSC_VER
+#include <stdatomic.h>
+#endif
 
 #include "c_logging/logger.h"
 
 #include "c_pal/gballoc_hl.h"
 #include "c_pal/gballoc_hl_redirect.h"
 #include "c_pal/interlocked.h"
-
-#include "clds/clds_st_hash_set.h"
+#include "c_pal/sync.h"
+#include "c_pal/threadapi.h"
+#include "c_pal/timer.h"
 
 #include "clds/clds_hazard_pointers.h"
 
+MU_DEFINE_ENUM_STRINGS(CLDS_HAZARD_POINTERS_RECLAMATION_MODE, CLDS_HAZARD_POINTERS_RECLAMATION_MODE_VALUES);
+
 #define DEFAULT_RECLAIM_THRESHOLD 1
+#define INITIAL_SCAN_BUFFER_SIZE 16
+#define CACHE_LINE_SIZE 64
+#define MAX_HAZARD_POINTER_SLOT_COUNT 32
+#define MAX_RECLAIM_THRESHOLD_HEADROOM_PERCENT 10000
+#define INITIAL_EPOCH 1
+#define NOT_PINNED 0
+// how often the background reclaimer retries the nodes that were still in use when nothing new is handed to it
+#define BACKGROUND_RECLAIMER_RETRY_TIMEOUT_MS 10
+
+// asymmetric fence publication: the thread that acquires publishes with a plain store and a compiler barrier,
+// the scan makes up for it with a heavy fence that acts as a full barrier on all the threads of the process
+#ifdef _MSC_VER
+#define STORE_RELEASE_POINTER(address, value) (*(address) = (value))
+#define COMPILER_BARRIER() _ReadWriteBarrier()
+#else
+#define STORE_RELEASE_POINTER(address, value) atomic_store_explicit((address), (value), memory_order_release)
+#define COMPILER_BARRIER() atomic_signal_fence(memory_order_seq_cst)
+#endif
+
+// the era clock is shared by all instances so that nodes can get their birth era when they are created (CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT)
+// without knowing the instance they will be retired to, eras only have to grow so sharing the clock is harmless
+volatile_atomic int64_t clds_hazard_pointers_global_era = INITIAL_EPOCH;
+
+typedef struct CLDS_HAZARD_POINTERS_ERA_INTERVAL_TAG
+{
+    int64_t lower_era;
+    int64_t upper_era;
+} CLDS_HAZARD_POINTERS_ERA_INTERVAL;
 
 typedef struct CLDS_HAZARD_POINTER_RECORD_TAG
 {
@@ -22,44 +67,189 @@ typedef struct CLDS_HAZARD_POINTER_RECORD_TAG
     struct CLDS_HAZARD_POINTER_RECORD_TAG* volatile_atomic next;
 } CLDS_HAZARD_POINTER_RECORD;
 
-typedef struct CLDS_RECLAIM_LIST_ENTRY_TAG
-{
-    struct CLDS_RECLAIM_LIST_ENTRY_TAG* next;
-    void* node;
-    RECLAIM_FUNC reclaim;
-} CLDS_RECLAIM_LIST_ENTRY;
-
 typedef struct CLDS_HAZARD_POINTERS_THREAD_TAG
 {
     struct CLDS_HAZARD_POINTERS_THREAD_TAG* volatile_atomic next;
     CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
     CLDS_HAZARD_POINTER_RECORD* free_pointers;
     CLDS_HAZARD_POINTER_RECORD* volatile_atomic pointers;
-    CLDS_RECLAIM_LIST_ENTRY* reclaim_list;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK* reclaim_list;
     volatile_atomic int32_t active;
     size_t reclaim_list_entry_count;
+    // hazard pointers collected by a scan, kept between scans so that the steady state scan does not allocate
+    void** scan_buffer;
+    size_t scan_buffer_size;
+    // fixed slots mode: slot_count hazard pointer records in a cache line aligned array, the list above is only used when all slots are in use
+    CLDS_HAZARD_POINTER_RECORD* slots;
+    void* slots_memory;
+    uint32_t slot_count;
+    // bit i is set when slot i is in use, only touched by the owning thread
+    uint32_t used_slots;
+    // number of hazard pointer records (slots and list records) that the thread owns, only touched by the owning thread
+    int64_t hazard_pointer_record_count;
+    CLDS_HAZARD_POINTERS_RECLAMATION_MODE reclamation_mode;
+    // epoch based mode: the epoch pinned by the thread (NOT_PINNED when the thread is not in an operation)
+    // interval based mode: the lower end of the interval of eras reserved by the thread (NOT_PINNED when the thread is not in an operation)
+    volatile_atomic int64_t local_epoch;
+    // interval based mode: the upper end of the interval of eras reserved by the thread
+    volatile_atomic int64_t upper_era;
+    // interval based mode: the last value written to upper_era, only touched by the owning thread
+    int64_t published_upper_era;
+    // epoch and interval based modes: number of records the thread has acquired and not released yet, only touched by the owning thread
+    uint32_t pin_count;
+    // epoch and interval based modes: the record handed out by acquire, it is never published
+    CLDS_HAZARD_POINTER_RECORD epoch_record;
+    // interval based mode: intervals collected by a scan, kept between scans like the scan buffer
+    CLDS_HAZARD_POINTERS_ERA_INTERVAL* interval_buffer;
+    size_t interval_buffer_size;
+    // copied from the instance when the thread registers
+    bool use_asymmetric_fence;
+    // statistics, only written by the thread that uses the record (or by destroy) and read by anyone, so updating them is never contended
+    volatile_atomic int64_t retired_count;
+    volatile_atomic int64_t freed_count;
+    // the number of entries in the reclaim list, published after each retire
+    volatile_atomic int64_t backlog_count;
+    volatile_atomic int64_t scan_count;
+    volatile_atomic int64_t total_scan_time_ns;
+    volatile_atomic int64_t max_scan_time_ns;
+    volatile_atomic int64_t visited_thread_count;
 } CLDS_HAZARD_POINTERS_THREAD;
 
 typedef struct CLDS_HAZARD_POINTERS_TAG
 {
-    size_t reclaim_threshold;
+    CLDS_HAZARD_POINTERS_RECLAMATION_MODE reclamation_mode;
+    volatile_atomic int64_t epoch;
+    // written with interlocked_exchange_64 while threads retire nodes, read on each retire
+    volatile_atomic int64_t reclaim_threshold;
+    // adaptive threshold: reclaim_threshold follows H * (1 + k), where H is the number of hazard pointer records owned by the registered threads
+    // (at least the number of registered threads) and k is reclaim_threshold_headroom_percent / 100
+    volatile_atomic int32_t adaptive_reclaim_threshold;
+    volatile_atomic int32_t reclaim_threshold_headroom_percent;
+    volatile_atomic int64_t thread_count;
+    volatile_atomic int64_t hazard_pointer_record_count;
+    uint32_t slot_count;
+    // hazard pointers are published without a fence, the scans issue a heavy asymmetric fence instead
+    bool use_asymmetric_fence;
     CLDS_HAZARD_POINTERS_THREAD* volatile_atomic head;
+    // entries left in the reclaim lists of threads that unregistered, adopted by the next thread that reclaims
+    CLDS_HAZARD_POINTERS_RETIRE_LINK* volatile_atomic orphan_list;
+    // background reclaimer: threads hand their full reclaim lists to it instead of scanning themselves
+    bool has_background_reclaimer;
+    THREAD_HANDLE background_reclaimer;
+    // the thread record used by the background reclaimer for its scans
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE background_reclaimer_thread;
+    uint32_t max_pending_reclaim_batches;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK* volatile_atomic reclaim_batches;
+    volatile_atomic int32_t pending_reclaim_batch_count;
+    // incremented for each batch handed off and when the reclaimer has to stop, the reclaimer waits on it
+    volatile_atomic int32_t background_reclaimer_signal;
+    // set while the reclaimer waits on the signal, a hand off only wakes the reclaimer then
+    volatile_atomic int32_t background_reclaimer_idle;
+    volatile_atomic int32_t stop_background_reclaimer;
+    // statistics of the threads that unregistered, the records of the registered threads hold the rest
+    volatile_atomic int64_t retired_count;
+    volatile_atomic int64_t freed_count;
+    volatile_atomic int64_t scan_count;
+    volatile_atomic int64_t total_scan_time_ns;
+    volatile_atomic int64_t max_scan_time_ns;
+    volatile_atomic int64_t visited_thread_count;
 } CLDS_HAZARD_POINTERS;
 
-static uint64_t hp_key_hash(void* key)
+#if defined(_WIN32)
+
+static int asymmetric_fence_init(void)
+{
+    // FlushProcessWriteBuffers is always there
+    return 0;
+}
+
+static void asymmetric_fence_heavy(void)
+{
+    FlushProcessWriteBuffers();
+}
+
+#elif defined(__linux__)
+
+static int membarrier(int cmd, unsigned int flags)
+{
+    return (int)syscall(__NR_membarrier, cmd, flags, 0);
+}
+
+static int asymmetric_fence_init(void)
+{
+    int result;
+    int supported_commands = membarrier(MEMBARRIER_CMD_QUERY, 0);
+
+    if (supported_commands < 0)
+    {
+        LogError("membarrier(MEMBARRIER_CMD_QUERY) failed, membarrier is not available");
+        result = MU_FAILURE;
+    }
+    else if ((supported_commands & MEMBARRIER_CMD_PRIVATE_EXPEDITED) == 0)
+    {
+        LogError("MEMBARRIER_CMD_PRIVATE_EXPEDITED is not supported, supported commands: %d", supported_commands);
+        result = MU_FAILURE;
+    }
+    else if (membarrier(MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0) != 0)
+    {
+        LogError("membarrier(MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED) failed");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        result = 0;
+    }
+
+    return result;
+}
+
+static void asymmetric_fence_heavy(void)
+{
+    // cannot fail once the process is registered
+    if (membarrier(MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0) != 0)
+    {
+        LogError("membarrier(MEMBARRIER_CMD_PRIVATE_EXPEDITED) failed");
+    }
+}
+
+#else
+
+static int asymmetric_fence_init(void)
+{
+    LogError("No asymmetric fence on this platform");
+    return MU_FAILURE;
+}
+
+static void asymmetric_fence_heavy(void)
 {
-    return (uint64_t)key;
 }
 
-static int hp_key_compare(void* key1, void* key2)
+#endif
+
+static void publish_hazard_pointer(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HAZARD_POINTER_RECORD* clds_hazard_pointer_record, void* node)
+{
+    if (clds_hazard_pointers_thread->use_asymmetric_fence)
+    {
+        // no fence here, the heavy fence of the scan orders this store before the read that the caller does next to validate the node
+        // the compiler barrier keeps the compiler from moving that read before the store
+        STORE_RELEASE_POINTER(&clds_hazard_pointer_record->node, node);
+        COMPILER_BARRIER();
+    }
+    else
+    {
+        (void)interlocked_exchange_pointer(&clds_hazard_pointer_record->node, node);
+    }
+}
+
+static int compare_hazard_pointers(const void* node_1, const void* node_2)
 {
     int result;
 
-    if (key1 < key2)
+    if (node_1 < node_2)
     {
         result = -1;
     }
-    else if (key1 > key2)
+    else if (node_1 > node_2)
     {
         result = 1;
     }
@@ -71,114 +261,652 @@ static int hp_key_compare(void* key1, void* key2)
     return result;
 }
 
-static void internal_reclaim(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+static void sift_down_hazard_pointers(void** hazard_pointers, size_t start, size_t count)
 {
-    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_thread->clds_hazard_pointers;
-    CLDS_ST_HASH_SET_HANDLE all_hps_set = clds_st_hash_set_create(hp_key_hash, hp_key_compare, clds_hazard_pointers_thread->clds_hazard_pointers->reclaim_threshold);
-    if (all_hps_set == NULL)
+    size_t root = start;
+
+    while ((root * 2) + 1 < count)
     {
-        // oops, panic now!
-        LogError("Cannot allocate hazard pointers hash set");
+        size_t child = (root * 2) + 1;
+        if ((child + 1 < count) &&
+            (compare_hazard_pointers(hazard_pointers[child], hazard_pointers[child + 1]) < 0))
+        {
+            child++;
+        }
+
+        if (compare_hazard_pointers(hazard_pointers[root], hazard_pointers[child]) >= 0)
+        {
+            break;
+        }
+        else
+        {
+            void* temp = hazard_pointers[root];
+            hazard_pointers[root] = hazard_pointers[child];
+            hazard_pointers[child] = temp;
+            root = child;
+        }
+    }
+}
+
+static void sort_hazard_pointers(void** hazard_pointers, size_t count)
+{
+    // heap sort, in place, so that the scan never needs any memory besides the scan buffer
+    size_t i;
+
+    if (count > 1)
+    {
+        for (i = count / 2; i > 0; i--)
+        {
+            sift_down_hazard_pointers(hazard_pointers, i - 1, count);
+        }
+
+        for (i = count - 1; i > 0; i--)
+        {
+            void* temp = hazard_pointers[0];
+            hazard_pointers[0] = hazard_pointers[i];
+            hazard_pointers[i] = temp;
+            sift_down_hazard_pointers(hazard_pointers, 0, i);
+        }
+    }
+}
+
+static bool is_hazard_pointer(void** hazard_pointers, size_t count, void* node)
+{
+    bool result = false;
+    size_t low = 0;
+    size_t high = count;
+
+    while (low < high)
+    {
+        size_t middle = low + ((high - low) / 2);
+        int compare_result = compare_hazard_pointers(node, hazard_pointers[middle]);
+        if (compare_result == 0)
+        {
+            result = true;
+            break;
+        }
+        else if (compare_result < 0)
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle + 1;
+        }
+    }
+
+    return result;
+}
+
+static int add_to_scan_buffer(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, size_t* hazard_pointer_count, void* node)
+{
+    int result;
+
+    if (*hazard_pointer_count == clds_hazard_pointers_thread->scan_buffer_size)
+    {
+        // the buffer is kept around for the next scans, so this only happens until it reaches the steady state size
+        size_t new_scan_buffer_size = (clds_hazard_pointers_thread->scan_buffer_size == 0) ? INITIAL_SCAN_BUFFER_SIZE : clds_hazard_pointers_thread->scan_buffer_size * 2;
+        void** new_scan_buffer = malloc_2(new_scan_buffer_size, sizeof(void*));
+        if (new_scan_buffer == NULL)
+        {
+            LogError("malloc_2(%zu, %zu) failed", new_scan_buffer_size, sizeof(void*));
+            result = MU_FAILURE;
+        }
+        else
+        {
+            if (clds_hazard_pointers_thread->scan_buffer != NULL)
+            {
+                (void)memcpy(new_scan_buffer, clds_hazard_pointers_thread->scan_buffer, *hazard_pointer_count * sizeof(void*));
+                free(clds_hazard_pointers_thread->scan_buffer);
+            }
+
+            clds_hazard_pointers_thread->scan_buffer = new_scan_buffer;
+            clds_hazard_pointers_thread->scan_buffer_size = new_scan_buffer_size;
+            result = 0;
+        }
     }
     else
     {
-        // go through all hazard pointers of all threads, no thread should be able to get a hazard pointer after this point
-        CLDS_HAZARD_POINTERS_THREAD_HANDLE current_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->head, NULL, NULL);
-        while (current_thread != NULL)
+        result = 0;
+    }
+
+    if (result == 0)
+    {
+        clds_hazard_pointers_thread->scan_buffer[*hazard_pointer_count] = node;
+        (*hazard_pointer_count)++;
+    }
+
+    return result;
+}
+
+static void remove_from_reclaim_list_and_reclaim(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HAZARD_POINTERS_RETIRE_LINK* prev_reclaim_entry, CLDS_HAZARD_POINTERS_RETIRE_LINK* reclaim_entry, void* node)
+{
+    RECLAIM_FUNC reclaim = reclaim_entry->reclaim;
+
+    // now remove it from the reclaim list
+    if (prev_reclaim_entry == NULL)
+    {
+        // this is the head of the reclaim list
+        clds_hazard_pointers_thread->reclaim_list = reclaim_entry->next;
+    }
+    else
+    {
+        prev_reclaim_entry->next = reclaim_entry->next;
+    }
+
+    clds_hazard_pointers_thread->reclaim_list_entry_count--;
+
+    // node is safe to be reclaimed
+    if (reclaim_entry->is_allocated)
+    {
+        reclaim(node);
+        free(reclaim_entry);
+    }
+    else
+    {
+        // the link lives in the node, so it shall not be touched anymore after this point (the node can be retired again)
+        (void)interlocked_exchange_pointer(&reclaim_entry->node, NULL);
+        reclaim(node);
+    }
+}
+
+static void internal_reclaim_hazard_pointers(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, size_t* visited_thread_count)
+{
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_thread->clds_hazard_pointers;
+    size_t hazard_pointer_count = 0;
+
+    if (clds_hazard_pointers->use_asymmetric_fence)
+    {
+        // make the hazard pointers published without a fence visible, after this the threads that did not publish yet
+        // see the nodes removed, so they fail the validation of the node
+        asymmetric_fence_heavy();
+    }
+
+    // go through all hazard pointers of all threads, no thread should be able to get a hazard pointer after this point
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE current_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->head, NULL, NULL);
+    while (current_thread != NULL)
+    {
+        CLDS_HAZARD_POINTERS_THREAD_HANDLE next_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_thread->next, NULL, NULL);
+        (*visited_thread_count)++;
+        if (interlocked_add(&current_thread->active, 0) == 1)
         {
-            CLDS_HAZARD_POINTERS_THREAD_HANDLE next_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_thread->next, NULL, NULL);
-            if (interlocked_add(&current_thread->active, 0) == 1)
+            uint32_t i;
+
+            // look at the pointers of this thread
+            // if it gets unregistered in the meanwhile we won't care
+            // if it gets registered again we also don't care as for sure it does not have our hazard pointer anymore
+
+            // the slots are a dense array, sweep them first
+            for (i = 0; i < current_thread->slot_count; i++)
             {
-                // look at the pointers of this thread
-                // if it gets unregistered in the meanwhile we won't care
-                // if it gets registered again we also don't care as for sure it does not have our hazard pointer anymore
-                CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointer = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_thread->pointers, NULL, NULL);
-                while (clds_hazard_pointer != NULL)
+                void* node = interlocked_compare_exchange_pointer(&current_thread->slots[i].node, NULL, NULL);
+                if (node != NULL)
                 {
-                    CLDS_HAZARD_POINTER_RECORD_HANDLE next_hazard_pointer = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointer->next, NULL, NULL);
-                    void* node = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointer->node, NULL, NULL);
-                    if (node != NULL)
+                    if (add_to_scan_buffer(clds_hazard_pointers_thread, &hazard_pointer_count, node) != 0)
                     {
-                        CLDS_ST_HASH_SET_INSERT_RESULT insert_result = clds_st_hash_set_insert(all_hps_set, node);
-                        if ((insert_result == CLDS_ST_HASH_SET_INSERT_OK) ||
-                            (insert_result == CLDS_ST_HASH_SET_INSERT_KEY_ALREADY_EXISTS))
-                        {
-                            // all ok
-                        }
-                        else
-                        {
-                            LogError("Cannot insert hazard pointer in set");
-                            break;
-                        }
+                        LogError("Cannot add hazard pointer to scan buffer");
+                        break;
                     }
+                }
+            }
 
-                    clds_hazard_pointer = next_hazard_pointer;
+            if (i < current_thread->slot_count)
+            {
+                break;
+            }
+
+            CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointer = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_thread->pointers, NULL, NULL);
+            while (clds_hazard_pointer != NULL)
+            {
+                CLDS_HAZARD_POINTER_RECORD_HANDLE next_hazard_pointer = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointer->next, NULL, NULL);
+                void* node = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointer->node, NULL, NULL);
+                if (node != NULL)
+                {
+                    if (add_to_scan_buffer(clds_hazard_pointers_thread, &hazard_pointer_count, node) != 0)
+                    {
+                        LogError("Cannot add hazard pointer to scan buffer");
+                        break;
+                    }
                 }
 
-                if (clds_hazard_pointer != NULL)
+                clds_hazard_pointer = next_hazard_pointer;
+            }
+
+            if (clds_hazard_pointer != NULL)
+            {
+                break;
+            }
+        }
+
+        current_thread = next_thread;
+    }
+
+    if (current_thread != NULL)
+    {
+        LogError("Error collecting hazard pointers");
+    }
+    else
+    {
+        // sort the hazard pointers so that each reclaim list entry is a binary search
+        sort_hazard_pointers(clds_hazard_pointers_thread->scan_buffer, hazard_pointer_count);
+
+        // go through all pointers in the reclaim list
+        CLDS_HAZARD_POINTERS_RETIRE_LINK* current_reclaim_entry = clds_hazard_pointers_thread->reclaim_list;
+        CLDS_HAZARD_POINTERS_RETIRE_LINK* prev_reclaim_entry = NULL;
+        while (current_reclaim_entry != NULL)
+        {
+            CLDS_HAZARD_POINTERS_RETIRE_LINK* next_reclaim_entry = current_reclaim_entry->next;
+            void* node = interlocked_compare_exchange_pointer(&current_reclaim_entry->node, NULL, NULL);
+
+            // this is the scan for the pointers
+            if (!is_hazard_pointer(clds_hazard_pointers_thread->scan_buffer, hazard_pointer_count, node))
+            {
+                remove_from_reclaim_list_and_reclaim(clds_hazard_pointers_thread, prev_reclaim_entry, current_reclaim_entry, node);
+            }
+            else
+            {
+                // not safe, sorry, shall still have it around, move to next reclaim entry
+                prev_reclaim_entry = current_reclaim_entry;
+            }
+
+            current_reclaim_entry = next_reclaim_entry;
+        }
+    }
+}
+
+static void internal_reclaim_epoch_based(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, size_t* visited_thread_count)
+{
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_thread->clds_hazard_pointers;
+    int64_t current_epoch = interlocked_add_64(&clds_hazard_pointers->epoch, 0);
+    int64_t oldest_pinned_epoch = INT64_MAX;
+    bool can_advance_epoch = true;
+
+    // go through the epochs pinned by all threads
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE current_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->head, NULL, NULL);
+    while (current_thread != NULL)
+    {
+        CLDS_HAZARD_POINTERS_THREAD_HANDLE next_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_thread->next, NULL, NULL);
+        (*visited_thread_count)++;
+        if (interlocked_add(&current_thread->active, 0) == 1)
+        {
+            int64_t local_epoch = interlocked_add_64(&current_thread->local_epoch, 0);
+            if (local_epoch != NOT_PINNED)
+            {
+                if (local_epoch != current_epoch)
                 {
-                    break;
+                    // this thread is still in an operation that started in an older epoch
+                    can_advance_epoch = false;
+                }
+
+                if (local_epoch < oldest_pinned_epoch)
+                {
+                    oldest_pinned_epoch = local_epoch;
                 }
             }
+        }
 
-            current_thread = next_thread;
+        current_thread = next_thread;
+    }
+
+    if (can_advance_epoch)
+    {
+        // all pinned threads are in the current epoch, move to the next one so that the operations starting from now on
+        // do not hold back the nodes retired so far (if another thread advanced it already that is just as good)
+        (void)interlocked_compare_exchange_64(&clds_hazard_pointers->epoch, current_epoch + 1, current_epoch);
+    }
+
+    // a node retired in epoch E was removed before E was read, so a thread that pinned an epoch greater than E
+    // started its operation after the removal and cannot have a reference to the node
+    // threads that are not pinned are not in an operation, so they do not hold any reference either
+    CLDS_HAZARD_POINTERS_RETIRE_LINK* current_reclaim_entry = clds_hazard_pointers_thread->reclaim_list;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK* prev_reclaim_entry = NULL;
+    while (current_reclaim_entry != NULL)
+    {
+        CLDS_HAZARD_POINTERS_RETIRE_LINK* next_reclaim_entry = current_reclaim_entry->next;
+
+        if (current_reclaim_entry->retire_epoch < oldest_pinned_epoch)
+        {
+            void* node = interlocked_compare_exchange_pointer(&current_reclaim_entry->node, NULL, NULL);
+            remove_from_reclaim_list_and_reclaim(clds_hazard_pointers_thread, prev_reclaim_entry, current_reclaim_entry, node);
+        }
+        else
+        {
+            // some thread might still look at it, keep it around
+            prev_reclaim_entry = current_reclaim_entry;
         }
 
-        if (current_thread != NULL)
+        current_reclaim_entry = next_reclaim_entry;
+    }
+}
+
+static int add_to_interval_buffer(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, size_t* interval_count, int64_t lower_era, int64_t upper_era)
+{
+    int result;
+
+    if (*interval_count == clds_hazard_pointers_thread->interval_buffer_size)
+    {
+        size_t new_interval_buffer_size = (clds_hazard_pointers_thread->interval_buffer_size == 0) ? INITIAL_SCAN_BUFFER_SIZE : clds_hazard_pointers_thread->interval_buffer_size * 2;
+        CLDS_HAZARD_POINTERS_ERA_INTERVAL* new_interval_buffer = malloc_2(new_interval_buffer_size, sizeof(CLDS_HAZARD_POINTERS_ERA_INTERVAL));
+        if (new_interval_buffer == NULL)
         {
-            LogError("Error collecting hazard pointers");
+            LogError("malloc_2(%zu, %zu) failed", new_interval_buffer_size, sizeof(CLDS_HAZARD_POINTERS_ERA_INTERVAL));
+            result = MU_FAILURE;
         }
         else
         {
-            // go through all pointers in the reclaim list
-            CLDS_RECLAIM_LIST_ENTRY* current_reclaim_entry = clds_hazard_pointers_thread->reclaim_list;
-            CLDS_RECLAIM_LIST_ENTRY* prev_reclaim_entry = NULL;
-            while (current_reclaim_entry != NULL)
+            if (clds_hazard_pointers_thread->interval_buffer != NULL)
             {
-                // this is the scan for the pointers
-                CLDS_ST_HASH_SET_FIND_RESULT find_result = clds_st_hash_set_find(all_hps_set, current_reclaim_entry->node);
+                (void)memcpy(new_interval_buffer, clds_hazard_pointers_thread->interval_buffer, *interval_count * sizeof(CLDS_HAZARD_POINTERS_ERA_INTERVAL));
+                free(clds_hazard_pointers_thread->interval_buffer);
+            }
 
-                if (find_result == CLDS_ST_HASH_SET_FIND_ERROR)
+            clds_hazard_pointers_thread->interval_buffer = new_interval_buffer;
+            clds_hazard_pointers_thread->interval_buffer_size = new_interval_buffer_size;
+            result = 0;
+        }
+    }
+    else
+    {
+        result = 0;
+    }
+
+    if (result == 0)
+    {
+        clds_hazard_pointers_thread->interval_buffer[*interval_count].lower_era = lower_era;
+        clds_hazard_pointers_thread->interval_buffer[*interval_count].upper_era = upper_era;
+        (*interval_count)++;
+    }
+
+    return result;
+}
+
+static void internal_reclaim_interval_based(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, size_t* visited_thread_count)
+{
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_thread->clds_hazard_pointers;
+    size_t interval_count = 0;
+
+    // advance the era, so that nodes created from now on are not covered by the intervals reserved so far
+    (void)interlocked_increment_64(&clds_hazard_pointers_global_era);
+
+    // go through the intervals reserved by all threads
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE current_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->head, NULL, NULL);
+    while (current_thread != NULL)
+    {
+        CLDS_HAZARD_POINTERS_THREAD_HANDLE next_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_thread->next, NULL, NULL);
+        (*visited_thread_count)++;
+        if (interlocked_add(&current_thread->active, 0) == 1)
+        {
+            // the upper end is written before the lower end when a thread starts an operation, so reading them in the other order
+            // never yields an interval that is smaller than the one reserved
+            int64_t lower_era = interlocked_add_64(&current_thread->local_epoch, 0);
+            if (lower_era != NOT_PINNED)
+            {
+                int64_t upper_era = interlocked_add_64(&current_thread->upper_era, 0);
+                if (add_to_interval_buffer(clds_hazard_pointers_thread, &interval_count, lower_era, upper_era) != 0)
                 {
-                    LogError("Error finding pointer");
+                    LogError("Cannot add era interval to interval buffer");
                     break;
                 }
-                else if (find_result == CLDS_ST_HASH_SET_FIND_NOT_FOUND)
-                {
-                    // node is safe to be reclaimed
-                    current_reclaim_entry->reclaim(current_reclaim_entry->node);
+            }
+        }
 
-                    // now remove it from the reclaim list
-                    if (prev_reclaim_entry == NULL)
-                    {
-                        // this is the head of the reclaim list
-                        clds_hazard_pointers_thread->reclaim_list = current_reclaim_entry->next;
-                        free(current_reclaim_entry);
-                        current_reclaim_entry = clds_hazard_pointers_thread->reclaim_list;
-                    }
-                    else
-                    {
-                        prev_reclaim_entry->next = current_reclaim_entry->next;
-                        free(current_reclaim_entry);
-                        current_reclaim_entry = prev_reclaim_entry->next;
-                    }
+        current_thread = next_thread;
+    }
 
-                    clds_hazard_pointers_thread->reclaim_list_entry_count--;
-                }
-                else
+    if (current_thread != NULL)
+    {
+        LogError("Error collecting era intervals");
+    }
+    else
+    {
+        // a node can be seen by a thread only if it was alive at some point in the interval reserved by the thread,
+        // so a node whose lifetime [birth era, retire era] does not overlap any reserved interval can be reclaimed
+        // a thread that is stuck in an operation only holds back the nodes that were alive during its interval
+        CLDS_HAZARD_POINTERS_RETIRE_LINK* current_reclaim_entry = clds_hazard_pointers_thread->reclaim_list;
+        CLDS_HAZARD_POINTERS_RETIRE_LINK* prev_reclaim_entry = NULL;
+        while (current_reclaim_entry != NULL)
+        {
+            CLDS_HAZARD_POINTERS_RETIRE_LINK* next_reclaim_entry = current_reclaim_entry->next;
+            size_t i;
+
+            for (i = 0; i < interval_count; i++)
+            {
+                if ((current_reclaim_entry->birth_era <= clds_hazard_pointers_thread->interval_buffer[i].upper_era) &&
+                    (current_reclaim_entry->retire_epoch >= clds_hazard_pointers_thread->interval_buffer[i].lower_era))
                 {
-                    // not safe, sorry, shall still have it around, move to next reclaim entry
-                    prev_reclaim_entry = current_reclaim_entry;
-                    current_reclaim_entry = current_reclaim_entry->next;
+                    break;
                 }
             }
+
+            if (i == interval_count)
+            {
+                void* node = interlocked_compare_exchange_pointer(&current_reclaim_entry->node, NULL, NULL);
+                remove_from_reclaim_list_and_reclaim(clds_hazard_pointers_thread, prev_reclaim_entry, current_reclaim_entry, node);
+            }
+            else
+            {
+                // some thread might still look at it, keep it around
+                prev_reclaim_entry = current_reclaim_entry;
+            }
+
+            current_reclaim_entry = next_reclaim_entry;
         }
+    }
+}
+
+static void push_retire_list(CLDS_HAZARD_POINTERS_RETIRE_LINK* volatile_atomic* list_head, CLDS_HAZARD_POINTERS_RETIRE_LINK* retire_list)
+{
+    CLDS_HAZARD_POINTERS_RETIRE_LINK* retire_list_tail = retire_list;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK* current_list_head;
 
-        clds_st_hash_set_destroy(all_hps_set);
+    while (retire_list_tail->next != NULL)
+    {
+        retire_list_tail = retire_list_tail->next;
     }
+
+    do
+    {
+        current_list_head = interlocked_compare_exchange_pointer((void* volatile_atomic*)list_head, NULL, NULL);
+        retire_list_tail->next = current_list_head;
+    } while (interlocked_compare_exchange_pointer((void* volatile_atomic*)list_head, retire_list, current_list_head) != current_list_head);
 }
 
-CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers_create(void)
+static void adopt_retire_list(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HAZARD_POINTERS_RETIRE_LINK* volatile_atomic* list_head)
+{
+    // take the whole list at once, no other thread can see the entries after this
+    CLDS_HAZARD_POINTERS_RETIRE_LINK* retire_list = interlocked_exchange_pointer((void* volatile_atomic*)list_head, NULL);
+    if (retire_list != NULL)
+    {
+        CLDS_HAZARD_POINTERS_RETIRE_LINK* retire_list_tail = retire_list;
+        size_t retire_count = 1;
+
+        while (retire_list_tail->next != NULL)
+        {
+            retire_list_tail = retire_list_tail->next;
+            retire_count++;
+        }
+
+        retire_list_tail->next = clds_hazard_pointers_thread->reclaim_list;
+        clds_hazard_pointers_thread->reclaim_list = retire_list;
+        clds_hazard_pointers_thread->reclaim_list_entry_count += retire_count;
+    }
+}
+
+static void adopt_orphans(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    adopt_retire_list(clds_hazard_pointers_thread, &clds_hazard_pointers_thread->clds_hazard_pointers->orphan_list);
+}
+
+static void adopt_reclaim_batches(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_thread->clds_hazard_pointers;
+
+    // the count is read before the batches are taken, a batch that is counted but pushed after the exchange is taken
+    // next time without being counted again, so each batch is subtracted exactly once
+    int32_t pending_reclaim_batch_count = interlocked_add(&clds_hazard_pointers->pending_reclaim_batch_count, 0);
+    adopt_retire_list(clds_hazard_pointers_thread, &clds_hazard_pointers->reclaim_batches);
+    (void)interlocked_add(&clds_hazard_pointers->pending_reclaim_batch_count, -pending_reclaim_batch_count);
+}
+
+static void update_max(volatile_atomic int64_t* max_value, int64_t value)
+{
+    int64_t current_max_value;
+
+    do
+    {
+        current_max_value = interlocked_add_64(max_value, 0);
+        if (value <= current_max_value)
+        {
+            break;
+        }
+    } while (interlocked_compare_exchange_64(max_value, value, current_max_value) != current_max_value);
+}
+
+static void internal_reclaim(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    size_t reclaim_list_entry_count;
+    size_t visited_thread_count = 0;
+    double start_time;
+    int64_t scan_time_ns;
+
+    adopt_orphans(clds_hazard_pointers_thread);
+
+    reclaim_list_entry_count = clds_hazard_pointers_thread->reclaim_list_entry_count;
+    start_time = timer_global_get_elapsed_us();
+
+    if (clds_hazard_pointers_thread->reclamation_mode == CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH_BASED)
+    {
+        internal_reclaim_epoch_based(clds_hazard_pointers_thread, &visited_thread_count);
+    }
+    else if (clds_hazard_pointers_thread->reclamation_mode == CLDS_HAZARD_POINTERS_RECLAMATION_MODE_INTERVAL_BASED)
+    {
+        internal_reclaim_interval_based(clds_hazard_pointers_thread, &visited_thread_count);
+    }
+    else
+    {
+        internal_reclaim_hazard_pointers(clds_hazard_pointers_thread, &visited_thread_count);
+    }
+
+    // a few uncontended interlocked adds per scan, the scan itself costs much more
+    scan_time_ns = (int64_t)((timer_global_get_elapsed_us() - start_time) * 1000.0);
+    (void)interlocked_increment_64(&clds_hazard_pointers_thread->scan_count);
+    (void)interlocked_add_64(&clds_hazard_pointers_thread->freed_count, (int64_t)(reclaim_list_entry_count - clds_hazard_pointers_thread->reclaim_list_entry_count));
+    (void)interlocked_add_64(&clds_hazard_pointers_thread->total_scan_time_ns, scan_time_ns);
+    (void)interlocked_add_64(&clds_hazard_pointers_thread->visited_thread_count, (int64_t)visited_thread_count);
+    update_max(&clds_hazard_pointers_thread->max_scan_time_ns, scan_time_ns);
+}
+
+static void update_hazard_pointer_counts(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, int64_t thread_count_delta, int64_t hazard_pointer_record_count_delta)
+{
+    int64_t thread_count = interlocked_add_64(&clds_hazard_pointers->thread_count, thread_count_delta);
+    int64_t hazard_pointer_record_count = interlocked_add_64(&clds_hazard_pointers->hazard_pointer_record_count, hazard_pointer_record_count_delta);
+
+    if (interlocked_add(&clds_hazard_pointers->adaptive_reclaim_threshold, 0) != 0)
+    {
+        // with R >= H * (1 + k) at least H * k nodes are reclaimed by each scan, so the cost of a scan is amortized over them
+        // concurrent updates can leave a threshold computed from slightly old counts, which is corrected by the next update
+        int64_t hazard_pointers = (hazard_pointer_record_count > thread_count) ? hazard_pointer_record_count : thread_count;
+        int64_t reclaim_threshold = hazard_pointers + ((hazard_pointers * interlocked_add(&clds_hazard_pointers->reclaim_threshold_headroom_percent, 0)) / 100);
+        (void)interlocked_exchange_64(&clds_hazard_pointers->reclaim_threshold, (reclaim_threshold < DEFAULT_RECLAIM_THRESHOLD) ? DEFAULT_RECLAIM_THRESHOLD : reclaim_threshold);
+    }
+}
+
+static int hand_off_to_background_reclaimer(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    int result;
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_thread->clds_hazard_pointers;
+    int32_t pending_reclaim_batch_count;
+
+    // reserve a place in the queue of batches, unless the reclaimer is too far behind
+    do
+    {
+        pending_reclaim_batch_count = interlocked_add(&clds_hazard_pointers->pending_reclaim_batch_count, 0);
+        if (pending_reclaim_batch_count >= (int32_t)clds_hazard_pointers->max_pending_reclaim_batches)
+        {
+            break;
+        }
+    } while (interlocked_compare_exchange(&clds_hazard_pointers->pending_reclaim_batch_count, pending_reclaim_batch_count + 1, pending_reclaim_batch_count) != pending_reclaim_batch_count);
+
+    if (pending_reclaim_batch_count >= (int32_t)clds_hazard_pointers->max_pending_reclaim_batches)
+    {
+        // the caller has to reclaim on its own, so that the memory held by the queued batches stays bounded
+        result = MU_FAILURE;
+    }
+    else
+    {
+        // the whole reclaim list is the batch, the entries are linked already so the hand off does not allocate
+        push_retire_list(&clds_hazard_pointers->reclaim_batches, clds_hazard_pointers_thread->reclaim_list);
+        clds_hazard_pointers_thread->reclaim_list = NULL;
+        clds_hazard_pointers_thread->reclaim_list_entry_count = 0;
+
+        (void)interlocked_increment(&clds_hazard_pointers->background_reclaimer_signal);
+
+        // a busy reclaimer looks for batches again before it waits, and its wait returns right away since the signal changed,
+        // so only an idle reclaimer needs the wake
+        if (interlocked_compare_exchange(&clds_hazard_pointers->background_reclaimer_idle, 0, 1) == 1)
+        {
+            wake_by_address_single(&clds_hazard_pointers->background_reclaimer_signal);
+        }
+
+        result = 0;
+    }
+
+    return result;
+}
+
+static void internal_add_to_reclaim_list(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HAZARD_POINTERS_RETIRE_LINK* retire_link, RECLAIM_FUNC reclaim_func)
+{
+    retire_link->next = clds_hazard_pointers_thread->reclaim_list;
+    retire_link->reclaim = reclaim_func;
+
+    if (clds_hazard_pointers_thread->reclamation_mode == CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH_BASED)
+    {
+        // the node has been removed by now, so the epoch read here is not older than the epoch pinned by any thread that can still see it
+        retire_link->retire_epoch = interlocked_add_64(&clds_hazard_pointers_thread->clds_hazard_pointers->epoch, 0);
+    }
+    else if (clds_hazard_pointers_thread->reclamation_mode == CLDS_HAZARD_POINTERS_RECLAMATION_MODE_INTERVAL_BASED)
+    {
+        // same for the era, a thread that can still see the node has reserved an interval that reaches this era
+        retire_link->retire_epoch = interlocked_add_64(&clds_hazard_pointers_global_era, 0);
+    }
+
+    // add the pointer to the reclaim list, no other thread has access to this list, so no interlocked needed
+    clds_hazard_pointers_thread->reclaim_list = retire_link;
+    clds_hazard_pointers_thread->reclaim_list_entry_count++;
+    (void)interlocked_increment_64(&clds_hazard_pointers_thread->retired_count);
+    // the threshold changes while threads retire (set by the user or adapted to the registered threads)
+    if ((int64_t)clds_hazard_pointers_thread->reclaim_list_entry_count >= interlocked_add_64(&clds_hazard_pointers_thread->clds_hazard_pointers->reclaim_threshold, 0))
+    {
+        if (
+            (!clds_hazard_pointers_thread->clds_hazard_pointers->has_background_reclaimer) ||
+            (hand_off_to_background_reclaimer(clds_hazard_pointers_thread) != 0)
+            )
+        {
+            internal_reclaim(clds_hazard_pointers_thread);
+        }
+    }
+
+    (void)interlocked_exchange_64(&clds_hazard_pointers_thread->backlog_count, (int64_t)clds_hazard_pointers_thread->reclaim_list_entry_count);
+}
+
+static void internal_reclaim_with_allocated_link(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* node, int64_t birth_era, RECLAIM_FUNC reclaim_func)
+{
+    CLDS_HAZARD_POINTERS_RETIRE_LINK* reclaim_list_entry = malloc(sizeof(CLDS_HAZARD_POINTERS_RETIRE_LINK));
+    if (reclaim_list_entry == NULL)
+    {
+        // oops, panic now!
+        LogError("Cannot allocate reclaim list entry");
+    }
+    else
+    {
+        reclaim_list_entry->is_allocated = true;
+        reclaim_list_entry->birth_era = birth_era;
+        (void)interlocked_exchange_pointer(&reclaim_list_entry->node, node);
+        internal_add_to_reclaim_list(clds_hazard_pointers_thread, reclaim_list_entry, reclaim_func);
+    }
+}
+
+static CLDS_HAZARD_POINTERS_HANDLE internal_create(CLDS_HAZARD_POINTERS_RECLAMATION_MODE reclamation_mode)
 {
     CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
 
@@ -189,8 +917,58 @@ CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers_create(void)
     }
     else
     {
-        clds_hazard_pointers->reclaim_threshold = DEFAULT_RECLAIM_THRESHOLD;
+        clds_hazard_pointers->reclamation_mode = reclamation_mode;
+        (void)interlocked_exchange_64(&clds_hazard_pointers->epoch, INITIAL_EPOCH);
+        (void)interlocked_exchange_64(&clds_hazard_pointers->reclaim_threshold, DEFAULT_RECLAIM_THRESHOLD);
+        (void)interlocked_exchange(&clds_hazard_pointers->adaptive_reclaim_threshold, 0);
+        (void)interlocked_exchange(&clds_hazard_pointers->reclaim_threshold_headroom_percent, 0);
+        (void)interlocked_exchange_64(&clds_hazard_pointers->thread_count, 0);
+        (void)interlocked_exchange_64(&clds_hazard_pointers->hazard_pointer_record_count, 0);
+        clds_hazard_pointers->slot_count = 0;
+        clds_hazard_pointers->use_asymmetric_fence = false;
         (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->head, NULL);
+        (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->orphan_list, NULL);
+        clds_hazard_pointers->has_background_reclaimer = false;
+        clds_hazard_pointers->background_reclaimer_thread = NULL;
+        clds_hazard_pointers->max_pending_reclaim_batches = 0;
+        (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->reclaim_batches, NULL);
+        (void)interlocked_exchange(&clds_hazard_pointers->pending_reclaim_batch_count, 0);
+        (void)interlocked_exchange(&clds_hazard_pointers->background_reclaimer_signal, 0);
+        (void)interlocked_exchange(&clds_hazard_pointers->background_reclaimer_idle, 0);
+        (void)interlocked_exchange(&clds_hazard_pointers->stop_background_reclaimer, 0);
+        (void)interlocked_exchange_64(&clds_hazard_pointers->retired_count, 0);
+        (void)interlocked_exchange_64(&clds_hazard_pointers->freed_count, 0);
+        (void)interlocked_exchange_64(&clds_hazard_pointers->scan_count, 0);
+        (void)interlocked_exchange_64(&clds_hazard_pointers->total_scan_time_ns, 0);
+        (void)interlocked_exchange_64(&clds_hazard_pointers->max_scan_time_ns, 0);
+        (void)interlocked_exchange_64(&clds_hazard_pointers->visited_thread_count, 0);
+    }
+
+    return clds_hazard_pointers;
+}
+
+CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers_create(void)
+{
+    return internal_create(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS);
+}
+
+CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers_create_with_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE reclamation_mode)
+{
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
+
+    if (
+        (reclamation_mode != CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS) &&
+        (reclamation_mode != CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH_BASED) &&
+        (reclamation_mode != CLDS_HAZARD_POINTERS_RECLAMATION_MODE_INTERVAL_BASED)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HAZARD_POINTERS_RECLAMATION_MODE reclamation_mode=%" PRI_MU_ENUM "",
+            MU_ENUM_VALUE(CLDS_HAZARD_POINTERS_RECLAMATION_MODE, reclamation_mode));
+        clds_hazard_pointers = NULL;
+    }
+    else
+    {
+        clds_hazard_pointers = internal_create(reclamation_mode);
     }
 
     return clds_hazard_pointers;
@@ -198,60 +976,234 @@ CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers_create(void)
 
 void clds_hazard_pointers_destroy(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers)
 {
-    if (clds_hazard_pointers == NULL)
+    if (clds_hazard_pointers == NULL)
+    {
+        LogError("Invalid arguments: CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers=%p", clds_hazard_pointers);
+    }
+    else
+    {
+        CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
+
+        if (clds_hazard_pointers->has_background_reclaimer)
+        {
+            int dont_care;
+
+            (void)interlocked_exchange(&clds_hazard_pointers->stop_background_reclaimer, 1);
+            (void)interlocked_increment(&clds_hazard_pointers->background_reclaimer_signal);
+            wake_by_address_single(&clds_hazard_pointers->background_reclaimer_signal);
+            if (ThreadAPI_Join(clds_hazard_pointers->background_reclaimer, &dont_care) != THREADAPI_OK)
+            {
+                LogError("ThreadAPI_Join failed");
+            }
+
+            // batches handed off after the last pass of the reclaimer are reclaimed with the rest below
+            adopt_reclaim_batches(clds_hazard_pointers->background_reclaimer_thread);
+        }
+
+        clds_hazard_pointers_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->head, NULL, NULL);
+        while (clds_hazard_pointers_thread != NULL)
+        {
+            internal_reclaim(clds_hazard_pointers_thread);
+            clds_hazard_pointers_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->next, NULL, NULL);
+        }
+
+        // free all thread data here
+        clds_hazard_pointers_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->head, NULL, NULL);
+        while (clds_hazard_pointers_thread != NULL)
+        {
+            CLDS_HAZARD_POINTERS_THREAD_HANDLE next_clds_hazard_pointers_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->next, NULL, NULL);
+            CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_ptr = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->pointers, NULL, NULL);
+            while (hazard_ptr != NULL)
+            {
+                CLDS_HAZARD_POINTER_RECORD_HANDLE next_hazard_ptr = interlocked_compare_exchange_pointer((void* volatile_atomic*)&hazard_ptr->next, NULL, NULL);
+                free(hazard_ptr);
+                hazard_ptr = next_hazard_ptr;
+            }
+
+            hazard_ptr = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->free_pointers, NULL, NULL);
+            while (hazard_ptr != NULL)
+            {
+                CLDS_HAZARD_POINTER_RECORD_HANDLE next_hazard_ptr = interlocked_compare_exchange_pointer((void* volatile_atomic*)&hazard_ptr->next, NULL, NULL);
+                free(hazard_ptr);
+                hazard_ptr = next_hazard_ptr;
+            }
+
+            if (clds_hazard_pointers_thread->scan_buffer != NULL)
+            {
+                free(clds_hazard_pointers_thread->scan_buffer);
+            }
+
+            if (clds_hazard_pointers_thread->interval_buffer != NULL)
+            {
+                free(clds_hazard_pointers_thread->interval_buffer);
+            }
+
+            if (clds_hazard_pointers_thread->slots_memory != NULL)
+            {
+                free(clds_hazard_pointers_thread->slots_memory);
+            }
+
+            free(clds_hazard_pointers_thread);
+            clds_hazard_pointers_thread = next_clds_hazard_pointers_thread;
+        }
+
+        free(clds_hazard_pointers);
+    }
+}
+
+static uint32_t get_all_slots_mask(uint32_t slot_count)
+{
+    return (slot_count == MAX_HAZARD_POINTER_SLOT_COUNT) ? UINT32_MAX : (((uint32_t)1 << slot_count) - 1);
+}
+
+static bool is_slot(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointer_record)
+{
+    return (clds_hazard_pointers_thread->slot_count > 0) &&
+        ((uintptr_t)clds_hazard_pointer_record >= (uintptr_t)clds_hazard_pointers_thread->slots) &&
+        ((uintptr_t)clds_hazard_pointer_record < (uintptr_t)(clds_hazard_pointers_thread->slots + clds_hazard_pointers_thread->slot_count));
+}
+
+static int allocate_slots(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint32_t slot_count)
+{
+    int result;
+
+    if (slot_count == 0)
     {
-        LogError("Invalid arguments: CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers=%p", clds_hazard_pointers);
+        clds_hazard_pointers_thread->slots = NULL;
+        clds_hazard_pointers_thread->slots_memory = NULL;
+        clds_hazard_pointers_thread->slot_count = 0;
+        result = 0;
     }
     else
     {
-        CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->head, NULL, NULL);
-        while (clds_hazard_pointers_thread != NULL)
+        // round up to a whole number of cache lines so that no other data shares the lines of the slots
+        // and allocate one extra cache line to be able to align the array
+        size_t slots_size = (((sizeof(CLDS_HAZARD_POINTER_RECORD) * slot_count) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE) * CACHE_LINE_SIZE;
+        clds_hazard_pointers_thread->slots_memory = malloc(slots_size + CACHE_LINE_SIZE - 1);
+        if (clds_hazard_pointers_thread->slots_memory == NULL)
         {
-            internal_reclaim(clds_hazard_pointers_thread);
-            clds_hazard_pointers_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->next, NULL, NULL);
+            LogError("malloc(%zu) failed", slots_size + CACHE_LINE_SIZE - 1);
+            result = MU_FAILURE;
         }
-
-        // free all thread data here
-        clds_hazard_pointers_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->head, NULL, NULL);
-        while (clds_hazard_pointers_thread != NULL)
+        else
         {
-            CLDS_HAZARD_POINTERS_THREAD_HANDLE next_clds_hazard_pointers_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->next, NULL, NULL);
-            CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_ptr = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->pointers, NULL, NULL);
-            while (hazard_ptr != NULL)
-            {
-                CLDS_HAZARD_POINTER_RECORD_HANDLE next_hazard_ptr = interlocked_compare_exchange_pointer((void* volatile_atomic*)&hazard_ptr->next, NULL, NULL);
-                free(hazard_ptr);
-                hazard_ptr = next_hazard_ptr;
-            }
+            uint32_t i;
 
-            hazard_ptr = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->free_pointers, NULL, NULL);
-            while (hazard_ptr != NULL)
+            clds_hazard_pointers_thread->slots = (CLDS_HAZARD_POINTER_RECORD*)(((uintptr_t)clds_hazard_pointers_thread->slots_memory + CACHE_LINE_SIZE - 1) & ~((uintptr_t)CACHE_LINE_SIZE - 1));
+            for (i = 0; i < slot_count; i++)
             {
-                CLDS_HAZARD_POINTER_RECORD_HANDLE next_hazard_ptr = interlocked_compare_exchange_pointer((void* volatile_atomic*)&hazard_ptr->next, NULL, NULL);
-                free(hazard_ptr);
-                hazard_ptr = next_hazard_ptr;
+                (void)interlocked_exchange_pointer(&clds_hazard_pointers_thread->slots[i].node, NULL);
+                clds_hazard_pointers_thread->slots[i].next = NULL;
             }
 
-            free(clds_hazard_pointers_thread);
-            clds_hazard_pointers_thread = next_clds_hazard_pointers_thread;
+            clds_hazard_pointers_thread->slot_count = slot_count;
+            result = 0;
         }
+    }
 
-        free(clds_hazard_pointers);
+    clds_hazard_pointers_thread->used_slots = 0;
+
+    return result;
+}
+
+static void reset_thread_statistics(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    (void)interlocked_exchange_64(&clds_hazard_pointers_thread->retired_count, 0);
+    (void)interlocked_exchange_64(&clds_hazard_pointers_thread->freed_count, 0);
+    (void)interlocked_exchange_64(&clds_hazard_pointers_thread->backlog_count, 0);
+    (void)interlocked_exchange_64(&clds_hazard_pointers_thread->scan_count, 0);
+    (void)interlocked_exchange_64(&clds_hazard_pointers_thread->total_scan_time_ns, 0);
+    (void)interlocked_exchange_64(&clds_hazard_pointers_thread->max_scan_time_ns, 0);
+    (void)interlocked_exchange_64(&clds_hazard_pointers_thread->visited_thread_count, 0);
+}
+
+static void fold_thread_statistics(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_thread->clds_hazard_pointers;
+
+    (void)interlocked_add_64(&clds_hazard_pointers->retired_count, interlocked_add_64(&clds_hazard_pointers_thread->retired_count, 0));
+    (void)interlocked_add_64(&clds_hazard_pointers->freed_count, interlocked_add_64(&clds_hazard_pointers_thread->freed_count, 0));
+    (void)interlocked_add_64(&clds_hazard_pointers->scan_count, interlocked_add_64(&clds_hazard_pointers_thread->scan_count, 0));
+    (void)interlocked_add_64(&clds_hazard_pointers->total_scan_time_ns, interlocked_add_64(&clds_hazard_pointers_thread->total_scan_time_ns, 0));
+    (void)interlocked_add_64(&clds_hazard_pointers->visited_thread_count, interlocked_add_64(&clds_hazard_pointers_thread->visited_thread_count, 0));
+    update_max(&clds_hazard_pointers->max_scan_time_ns, interlocked_add_64(&clds_hazard_pointers_thread->max_scan_time_ns, 0));
+    reset_thread_statistics(clds_hazard_pointers_thread);
+}
+
+static void add_thread_statistics(CLDS_HAZARD_POINTERS_STATISTICS* statistics, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    double max_scan_time_us = (double)interlocked_add_64(&clds_hazard_pointers_thread->max_scan_time_ns, 0) / 1000.0;
+
+    statistics->retired_count += (uint64_t)interlocked_add_64(&clds_hazard_pointers_thread->retired_count, 0);
+    statistics->freed_count += (uint64_t)interlocked_add_64(&clds_hazard_pointers_thread->freed_count, 0);
+    statistics->scan_count += (uint64_t)interlocked_add_64(&clds_hazard_pointers_thread->scan_count, 0);
+    statistics->total_scan_time_us += (double)interlocked_add_64(&clds_hazard_pointers_thread->total_scan_time_ns, 0) / 1000.0;
+    statistics->visited_thread_count += (uint64_t)interlocked_add_64(&clds_hazard_pointers_thread->visited_thread_count, 0);
+    if (max_scan_time_us > statistics->max_scan_time_us)
+    {
+        statistics->max_scan_time_us = max_scan_time_us;
     }
 }
 
-CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_register_thread(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers)
+static CLDS_HAZARD_POINTERS_THREAD_HANDLE recycle_thread(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers)
+{
+    // look for the record of a thread that unregistered, records are never removed from the list so walking it is safe
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->head, NULL, NULL);
+    while (clds_hazard_pointers_thread != NULL)
+    {
+        // records with a different slot count are skipped, as their slots cannot be changed while a scan might look at them
+        if ((clds_hazard_pointers_thread->slot_count == clds_hazard_pointers->slot_count) &&
+            (interlocked_compare_exchange(&clds_hazard_pointers_thread->active, 1, 0) == 0))
+        {
+            // claimed it, everything that was acquired has been released and the reclaim list went to the orphan list at unregister
+            clds_hazard_pointers_thread->reclaim_list_entry_count = 0;
+            clds_hazard_pointers_thread->reclaim_list = NULL;
+            clds_hazard_pointers_thread->used_slots = 0;
+            clds_hazard_pointers_thread->pin_count = 0;
+            clds_hazard_pointers_thread->published_upper_era = NOT_PINNED;
+            clds_hazard_pointers_thread->use_asymmetric_fence = clds_hazard_pointers->use_asymmetric_fence;
+            update_hazard_pointer_counts(clds_hazard_pointers, 1, clds_hazard_pointers_thread->hazard_pointer_record_count);
+            break;
+        }
+
+        clds_hazard_pointers_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->next, NULL, NULL);
+    }
+
+    return clds_hazard_pointers_thread;
+}
+
+static CLDS_HAZARD_POINTERS_THREAD_HANDLE create_thread(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers)
 {
     CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = malloc(sizeof(CLDS_HAZARD_POINTERS_THREAD));
     if (clds_hazard_pointers_thread == NULL)
     {
         LogError("malloc failed");
     }
+    else if (allocate_slots(clds_hazard_pointers_thread, clds_hazard_pointers->slot_count) != 0)
+    {
+        LogError("allocate_slots failed");
+        free(clds_hazard_pointers_thread);
+        clds_hazard_pointers_thread = NULL;
+    }
     else
     {
         bool restart_needed;
 
         clds_hazard_pointers_thread->clds_hazard_pointers = clds_hazard_pointers;
+        clds_hazard_pointers_thread->scan_buffer = NULL;
+        clds_hazard_pointers_thread->scan_buffer_size = 0;
+        clds_hazard_pointers_thread->reclamation_mode = clds_hazard_pointers->reclamation_mode;
+        clds_hazard_pointers_thread->use_asymmetric_fence = clds_hazard_pointers->use_asymmetric_fence;
+        clds_hazard_pointers_thread->hazard_pointer_record_count = clds_hazard_pointers_thread->slot_count;
+        (void)interlocked_exchange_64(&clds_hazard_pointers_thread->local_epoch, NOT_PINNED);
+        (void)interlocked_exchange_64(&clds_hazard_pointers_thread->upper_era, NOT_PINNED);
+        clds_hazard_pointers_thread->published_upper_era = NOT_PINNED;
+        clds_hazard_pointers_thread->interval_buffer = NULL;
+        clds_hazard_pointers_thread->interval_buffer_size = 0;
+        clds_hazard_pointers_thread->pin_count = 0;
+        (void)interlocked_exchange_pointer(&clds_hazard_pointers_thread->epoch_record.node, NULL);
+        clds_hazard_pointers_thread->epoch_record.next = NULL;
+        reset_thread_statistics(clds_hazard_pointers_thread);
         do
         {
             CLDS_HAZARD_POINTERS_THREAD_HANDLE current_threads_head = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->head, NULL, NULL);
@@ -271,6 +1223,20 @@ CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_register_thread(CLDS_HAZ
                 restart_needed = false;
             }
         } while (restart_needed);
+
+        update_hazard_pointer_counts(clds_hazard_pointers, 1, clds_hazard_pointers_thread->hazard_pointer_record_count);
+    }
+
+    return clds_hazard_pointers_thread;
+}
+
+CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_register_thread(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers)
+{
+    // reuse the record of a thread that unregistered if there is one, so that the thread list only grows with the number of threads registered at the same time
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = recycle_thread(clds_hazard_pointers);
+    if (clds_hazard_pointers_thread == NULL)
+    {
+        clds_hazard_pointers_thread = create_thread(clds_hazard_pointers);
     }
 
     return clds_hazard_pointers_thread;
@@ -284,9 +1250,23 @@ void clds_hazard_pointers_unregister_thread(CLDS_HAZARD_POINTERS_THREAD_HANDLE c
     }
     else
     {
-        // remove the thread from the thread list
+        if (clds_hazard_pointers_thread->reclaim_list != NULL)
+        {
+            // hand the nodes that could not be reclaimed yet to the next thread that reclaims
+            push_retire_list(&clds_hazard_pointers_thread->clds_hazard_pointers->orphan_list, clds_hazard_pointers_thread->reclaim_list);
+        }
+
+        update_hazard_pointer_counts(clds_hazard_pointers_thread->clds_hazard_pointers, -1, -clds_hazard_pointers_thread->hazard_pointer_record_count);
+
+        // move the statistics to the instance, so that the next thread using the record starts from 0
+        // a statistics read running at the same time can miss them or count them twice, which is fine for monitoring
+        fold_thread_statistics(clds_hazard_pointers_thread);
+
+        // the record stays in the thread list and is reused by the next thread that registers
         clds_hazard_pointers_thread->reclaim_list_entry_count = 0;
         clds_hazard_pointers_thread->reclaim_list = NULL;
+        clds_hazard_pointers_thread->pin_count = 0;
+        (void)interlocked_exchange_64(&clds_hazard_pointers_thread->local_epoch, NOT_PINNED);
         (void)interlocked_exchange(&clds_hazard_pointers_thread->active, 0);
     }
 }
@@ -301,6 +1281,60 @@ CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointers_acquire(CLDS_HAZARD_POINT
             clds_hazard_pointers_thread, node);
         result = NULL;
     }
+    else if (clds_hazard_pointers_thread->reclamation_mode == CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH_BASED)
+    {
+        // nothing is published per node, the first acquire pins the epoch and that covers all nodes acquired until the last release
+        if (clds_hazard_pointers_thread->pin_count == 0)
+        {
+            int64_t current_epoch = interlocked_add_64(&clds_hazard_pointers_thread->clds_hazard_pointers->epoch, 0);
+
+            // the exchange is a full barrier, so no node is read before the epoch is visible to reclaimers
+            (void)interlocked_exchange_64(&clds_hazard_pointers_thread->local_epoch, current_epoch);
+        }
+
+        clds_hazard_pointers_thread->pin_count++;
+        result = &clds_hazard_pointers_thread->epoch_record;
+    }
+    else if (clds_hazard_pointers_thread->reclamation_mode == CLDS_HAZARD_POINTERS_RECLAMATION_MODE_INTERVAL_BASED)
+    {
+        // nothing is published per node, the thread reserves the interval of eras in which the nodes it acquires were alive
+        if (clds_hazard_pointers_thread->pin_count == 0)
+        {
+            int64_t current_era = interlocked_add_64(&clds_hazard_pointers_global_era, 0);
+
+            // upper end first, a reclaimer that sees the lower end also sees an upper end that is not below it
+            // the exchanges are full barriers, so no node is read before the interval is visible to reclaimers
+            (void)interlocked_exchange_64(&clds_hazard_pointers_thread->upper_era, current_era);
+            (void)interlocked_exchange_64(&clds_hazard_pointers_thread->local_epoch, current_era);
+            clds_hazard_pointers_thread->published_upper_era = current_era;
+        }
+        else
+        {
+            // the node was born at the latest in the current era, the era moves rarely so most of the time this is just a read
+            int64_t current_era = clds_hazard_pointers_global_era;
+            if (current_era != clds_hazard_pointers_thread->published_upper_era)
+            {
+                (void)interlocked_exchange_64(&clds_hazard_pointers_thread->upper_era, current_era);
+                clds_hazard_pointers_thread->published_upper_era = current_era;
+            }
+        }
+
+        clds_hazard_pointers_thread->pin_count++;
+        result = &clds_hazard_pointers_thread->epoch_record;
+    }
+    else if (clds_hazard_pointers_thread->used_slots != get_all_slots_mask(clds_hazard_pointers_thread->slot_count))
+    {
+        // there is a free slot, take the first one
+        uint32_t slot_index = 0;
+        while ((clds_hazard_pointers_thread->used_slots & ((uint32_t)1 << slot_index)) != 0)
+        {
+            slot_index++;
+        }
+
+        clds_hazard_pointers_thread->used_slots |= ((uint32_t)1 << slot_index);
+        publish_hazard_pointer(clds_hazard_pointers_thread, &clds_hazard_pointers_thread->slots[slot_index], node);
+        result = &clds_hazard_pointers_thread->slots[slot_index];
+    }
     else
     {
         bool restart_needed;
@@ -343,10 +1377,14 @@ CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointers_acquire(CLDS_HAZARD_POINT
             {
                 CLDS_HAZARD_POINTER_RECORD* current_list_head;
 
+                // the thread owns one more record from now on (it goes to the free list on release)
+                clds_hazard_pointers_thread->hazard_pointer_record_count++;
+                update_hazard_pointer_counts(clds_hazard_pointers_thread->clds_hazard_pointers, 0, 1);
+
                 // add it to the hazard pointer list
                 current_list_head = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->pointers, NULL, NULL);
 
-                (void)interlocked_exchange_pointer(&hazard_ptr->node, node);
+                publish_hazard_pointer(clds_hazard_pointers_thread, hazard_ptr, node);
                 hazard_ptr->next = current_list_head;
                 
                 (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->pointers, hazard_ptr);
@@ -362,7 +1400,7 @@ CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointers_acquire(CLDS_HAZARD_POINT
             // add it to the hazard pointer list
             current_list_head = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->pointers, NULL, NULL);
 
-            (void)interlocked_exchange_pointer(&hazard_ptr->node, node);
+            publish_hazard_pointer(clds_hazard_pointers_thread, hazard_ptr, node);
             hazard_ptr->next = current_list_head;
 
             (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->pointers, hazard_ptr);
@@ -382,6 +1420,22 @@ void clds_hazard_pointers_release(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard
         LogError("Invalid arguments: CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointer_record=%p",
             clds_hazard_pointers_thread, clds_hazard_pointer_record);
     }
+    else if (clds_hazard_pointer_record == &clds_hazard_pointers_thread->epoch_record)
+    {
+        clds_hazard_pointers_thread->pin_count--;
+        if (clds_hazard_pointers_thread->pin_count == 0)
+        {
+            // last record released, the thread is out of the operation
+            (void)interlocked_exchange_64(&clds_hazard_pointers_thread->local_epoch, NOT_PINNED);
+        }
+    }
+    else if (is_slot(clds_hazard_pointers_thread, clds_hazard_pointer_record))
+    {
+        uint32_t slot_index = (uint32_t)(clds_hazard_pointer_record - clds_hazard_pointers_thread->slots);
+        // clearing late only keeps the node around a bit longer, so this does not need a fence either
+        publish_hazard_pointer(clds_hazard_pointers_thread, clds_hazard_pointer_record, NULL);
+        clds_hazard_pointers_thread->used_slots &= ~((uint32_t)1 << slot_index);
+    }
     else
     {
         // remove it from the hazard pointers list for this thread, this thread is the only one removing
@@ -432,25 +1486,35 @@ void clds_hazard_pointers_reclaim(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard
     }
     else
     {
-        CLDS_RECLAIM_LIST_ENTRY* reclaim_list_entry = malloc(sizeof(CLDS_RECLAIM_LIST_ENTRY));
-        if (reclaim_list_entry == NULL)
+        // the birth era of the node is not known, so the node is considered alive since the beginning
+        internal_reclaim_with_allocated_link(clds_hazard_pointers_thread, node, 0, reclaim_func);
+    }
+}
+
+void clds_hazard_pointers_retire(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* node, CLDS_HAZARD_POINTERS_RETIRE_LINK* retire_link, RECLAIM_FUNC reclaim_func)
+{
+    if (
+        (clds_hazard_pointers_thread == NULL) ||
+        (node == NULL) ||
+        (retire_link == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* node=%p, CLDS_HAZARD_POINTERS_RETIRE_LINK* retire_link=%p, RECLAIM_FUNC reclaim_func=%p",
+            clds_hazard_pointers_thread, node, retire_link, reclaim_func);
+    }
+    else
+    {
+        // claim the link embedded in the node
+        if (interlocked_compare_exchange_pointer(&retire_link->node, node, NULL) != NULL)
         {
-            // oops, panic now!
-            LogError("Cannot allocate reclaim list entry");
+            // the node was retired before (it was removed and inserted again) and that retire is still pending
+            // so its link is in use, fall back to an allocated link
+            internal_reclaim_with_allocated_link(clds_hazard_pointers_thread, node, retire_link->birth_era, reclaim_func);
         }
         else
         {
-            reclaim_list_entry->next = clds_hazard_pointers_thread->reclaim_list;
-            reclaim_list_entry->node = node;
-            reclaim_list_entry->reclaim = reclaim_func;
-
-            // add the pointer to the reclaim list, no other thread has access to this list, so no interlocked needed
-            clds_hazard_pointers_thread->reclaim_list = reclaim_list_entry;
-            clds_hazard_pointers_thread->reclaim_list_entry_count++;
-            if (clds_hazard_pointers_thread->reclaim_list_entry_count >= clds_hazard_pointers_thread->clds_hazard_pointers->reclaim_threshold)
-            {
-                internal_reclaim(clds_hazard_pointers_thread);
-            }
+            retire_link->is_allocated = false;
+            internal_add_to_reclaim_list(clds_hazard_pointers_thread, retire_link, reclaim_func);
         }
     }
 }
@@ -470,7 +1534,232 @@ int clds_hazard_pointers_set_reclaim_threshold(CLDS_HAZARD_POINTERS_HANDLE clds_
     }
     else
     {
-        clds_hazard_pointers->reclaim_threshold = reclaim_threshold;
+        (void)interlocked_exchange(&clds_hazard_pointers->adaptive_reclaim_threshold, 0);
+        (void)interlocked_exchange_64(&clds_hazard_pointers->reclaim_threshold, (int64_t)reclaim_threshold);
+        result = 0;
+    }
+
+    return result;
+}
+
+int clds_hazard_pointers_set_slot_count(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, uint32_t slot_count)
+{
+    int result;
+
+    if (
+        (clds_hazard_pointers == NULL) ||
+        (slot_count > MAX_HAZARD_POINTER_SLOT_COUNT)
+        )
+    {
+        LogError("Invalid arguments: clds_hazard_pointers = %p, slot_count = %" PRIu32 "",
+            clds_hazard_pointers, slot_count);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        // only threads registered from now on get the slots
+        clds_hazard_pointers->slot_count = slot_count;
+        result = 0;
+    }
+
+    return result;
+}
+
+int clds_hazard_pointers_set_adaptive_reclaim_threshold(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, uint32_t headroom_percent)
+{
+    int result;
+
+    if (
+        (clds_hazard_pointers == NULL) ||
+        (headroom_percent > MAX_RECLAIM_THRESHOLD_HEADROOM_PERCENT)
+        )
+    {
+        LogError("Invalid arguments: clds_hazard_pointers = %p, headroom_percent = %" PRIu32 "",
+            clds_hazard_pointers, headroom_percent);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        (void)interlocked_exchange(&clds_hazard_pointers->reclaim_threshold_headroom_percent, (int32_t)headroom_percent);
+        (void)interlocked_exchange(&clds_hazard_pointers->adaptive_reclaim_threshold, 1);
+
+        // compute the threshold for the current counts
+        update_hazard_pointer_counts(clds_hazard_pointers, 0, 0);
+        result = 0;
+    }
+
+    return result;
+}
+
+static int background_reclaimer_func(void* arg)
+{
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = arg;
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers->background_reclaimer_thread;
+
+    while (interlocked_add(&clds_hazard_pointers->stop_background_reclaimer, 0) == 0)
+    {
+        // read the signal before looking for batches, so that a batch handed off after this read wakes up the wait below
+        int32_t signal = interlocked_add(&clds_hazard_pointers->background_reclaimer_signal, 0);
+
+        adopt_reclaim_batches(clds_hazard_pointers_thread);
+        if (clds_hazard_pointers_thread->reclaim_list != NULL)
+        {
+            internal_reclaim(clds_hazard_pointers_thread);
+        }
+
+        (void)interlocked_exchange_64(&clds_hazard_pointers_thread->backlog_count, (int64_t)clds_hazard_pointers_thread->reclaim_list_entry_count);
+
+        // nodes that are still in use are retried from time to time, even if no other batch comes in
+        // the idle flag is set before the wait compares the signal, so a hand off either wakes the wait or changes the signal before it
+        (void)interlocked_exchange(&clds_hazard_pointers->background_reclaimer_idle, 1);
+        (void)wait_on_address(&clds_hazard_pointers->background_reclaimer_signal, signal,
+            (clds_hazard_pointers_thread->reclaim_list == NULL) ? UINT32_MAX : BACKGROUND_RECLAIMER_RETRY_TIMEOUT_MS);
+        (void)interlocked_exchange(&clds_hazard_pointers->background_reclaimer_idle, 0);
+    }
+
+    return 0;
+}
+
+int clds_hazard_pointers_start_background_reclaimer(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, uint32_t max_pending_batches)
+{
+    int result;
+
+    if (
+        (clds_hazard_pointers == NULL) ||
+        (max_pending_batches == 0) ||
+        (max_pending_batches > INT32_MAX)
+        )
+    {
+        LogError("Invalid arguments: clds_hazard_pointers = %p, max_pending_batches = %" PRIu32 "",
+            clds_hazard_pointers, max_pending_batches);
+        result = MU_FAILURE;
+    }
+    else if (clds_hazard_pointers->has_background_reclaimer)
+    {
+        LogError("Background reclaimer already started");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        // the reclaimer scans with its own thread record, it never acquires anything so it does not hold back any node
+        clds_hazard_pointers->background_reclaimer_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+        if (clds_hazard_pointers->background_reclaimer_thread == NULL)
+        {
+            LogError("clds_hazard_pointers_register_thread failed");
+            result = MU_FAILURE;
+        }
+        else
+        {
+            clds_hazard_pointers->max_pending_reclaim_batches = max_pending_batches;
+            (void)interlocked_exchange(&clds_hazard_pointers->background_reclaimer_idle, 0);
+            (void)interlocked_exchange(&clds_hazard_pointers->stop_background_reclaimer, 0);
+
+            if (ThreadAPI_Create(&clds_hazard_pointers->background_reclaimer, background_reclaimer_func, clds_hazard_pointers) != THREADAPI_OK)
+            {
+                LogError("ThreadAPI_Create failed");
+                clds_hazard_pointers_unregister_thread(clds_hazard_pointers->background_reclaimer_thread);
+                clds_hazard_pointers->background_reclaimer_thread = NULL;
+                result = MU_FAILURE;
+            }
+            else
+            {
+                // threads that retire from now on hand their batches to the reclaimer
+                clds_hazard_pointers->has_background_reclaimer = true;
+                result = 0;
+            }
+        }
+    }
+
+    return result;
+}
+
+int clds_hazard_pointers_get_statistics(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, CLDS_HAZARD_POINTERS_STATISTICS* statistics)
+{
+    int result;
+
+    if (
+        (clds_hazard_pointers == NULL) ||
+        (statistics == NULL)
+        )
+    {
+        LogError("Invalid arguments: clds_hazard_pointers = %p, statistics = %p",
+            clds_hazard_pointers, statistics);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
+
+        // start with what the threads that unregistered left behind
+        statistics->retired_count = (uint64_t)interlocked_add_64(&clds_hazard_pointers->retired_count, 0);
+        statistics->freed_count = (uint64_t)interlocked_add_64(&clds_hazard_pointers->freed_count, 0);
+        statistics->scan_count = (uint64_t)interlocked_add_64(&clds_hazard_pointers->scan_count, 0);
+        statistics->total_scan_time_us = (double)interlocked_add_64(&clds_hazard_pointers->total_scan_time_ns, 0) / 1000.0;
+        statistics->max_scan_time_us = (double)interlocked_add_64(&clds_hazard_pointers->max_scan_time_ns, 0) / 1000.0;
+        statistics->visited_thread_count = (uint64_t)interlocked_add_64(&clds_hazard_pointers->visited_thread_count, 0);
+
+        // and add the counters of all thread records, records are never removed from the list so walking it is safe
+        clds_hazard_pointers_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers->head, NULL, NULL);
+        while (clds_hazard_pointers_thread != NULL)
+        {
+            add_thread_statistics(statistics, clds_hazard_pointers_thread);
+            clds_hazard_pointers_thread = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_hazard_pointers_thread->next, NULL, NULL);
+        }
+
+        // nodes move between threads (orphans, background reclaimer batches), so the backlog is only meaningful for the whole instance
+        // the counters are not read at the same instant, so clamp at 0 instead of reporting a negative backlog
+        statistics->backlog_count = (statistics->retired_count > statistics->freed_count) ? (statistics->retired_count - statistics->freed_count) : 0;
+        result = 0;
+    }
+
+    return result;
+}
+
+int clds_hazard_pointers_get_thread_statistics(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HAZARD_POINTERS_STATISTICS* statistics)
+{
+    int result;
+
+    if (
+        (clds_hazard_pointers_thread == NULL) ||
+        (statistics == NULL)
+        )
+    {
+        LogError("Invalid arguments: clds_hazard_pointers_thread = %p, statistics = %p",
+            clds_hazard_pointers_thread, statistics);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        (void)memset(statistics, 0, sizeof(CLDS_HAZARD_POINTERS_STATISTICS));
+        add_thread_statistics(statistics, clds_hazard_pointers_thread);
+
+        // for a thread the backlog is what sits in its reclaim list
+        statistics->backlog_count = (uint64_t)interlocked_add_64(&clds_hazard_pointers_thread->backlog_count, 0);
+        result = 0;
+    }
+
+    return result;
+}
+
+int clds_hazard_pointers_enable_asymmetric_fence(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers)
+{
+    int result;
+
+    if (clds_hazard_pointers == NULL)
+    {
+        LogError("Invalid arguments: clds_hazard_pointers = %p", clds_hazard_pointers);
+        result = MU_FAILURE;
+    }
+    else if (asymmetric_fence_init() != 0)
+    {
+        // keep publishing with interlocked exchanges
+        LogError("asymmetric fence is not available, hazard pointers are published with a full fence");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        // only threads registered from now on publish without a fence, the others keep the full fence which works with the heavy fence just as well
+        clds_hazard_pointers->use_asymmetric_fence = true;
         result = 0;
     }
 
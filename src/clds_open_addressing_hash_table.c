@@ -0,0 +1,879 @@
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "c_logging/logger.h"
+
+#include "c_pal/gballoc_hl.h"
+#include "c_pal/gballoc_hl_redirect.h"
+#include "c_pal/sync.h"
+#include "c_pal/interlocked.h"
+
+#include "clds/clds_hazard_pointers.h"
+#include "clds/clds_hash_table.h"
+
+#include "clds/clds_open_addressing_group.h"
+#include "clds/clds_open_addressing_hash_table.h"
+
+/* this is a hash table implementation with open addressing over groups of slots (in the spirit of SwissTable), the groups are in clds_open_addressing_group.h */
+
+typedef struct CLDS_OPEN_ADDRESSING_HASH_TABLE_TAG
+{
+    COMPUTE_HASH_FUNC compute_hash;
+    KEY_COMPARE_FUNC key_compare_func;
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
+    volatile_atomic int64_t* sequence_number;
+
+    // the groups are never rebuilt with fewer groups than the table was created with
+    int32_t initial_group_count;
+    CLDS_OPEN_ADDRESSING_GROUP_ARRAY* volatile_atomic group_array;
+
+    // writers are blocked while the groups are rebuilt
+    volatile_atomic int32_t locked_for_write;
+    volatile_atomic int32_t pending_write_operations;
+} CLDS_OPEN_ADDRESSING_HASH_TABLE;
+
+// where a lookup found the slot of a key, item_hp protects the item of the slot
+typedef struct KEY_SLOT_TAG
+{
+    CLDS_OPEN_ADDRESSING_GROUP* group;
+    uint32_t slot_index;
+    void* slot_value;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE item_hp;
+} KEY_SLOT;
+
+static void internal_node_destroy(CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item)
+{
+    if (interlocked_decrement(&item->ref_count) == 0)
+    {
+        if (item->item_cleanup_callback != NULL)
+        {
+            item->item_cleanup_callback(item->item_cleanup_callback_context, item);
+        }
+
+        free((void*)item);
+    }
+}
+
+static void reclaim_table_node(void* node)
+{
+    internal_node_destroy((CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM*)node);
+}
+
+static void reclaim_group_array(void* node)
+{
+    // the items of the array were moved to the new array or retired on their own
+    free(node);
+}
+
+static void check_lock_and_begin_write_operation(CLDS_OPEN_ADDRESSING_HASH_TABLE* clds_open_addressing_hash_table)
+{
+    int32_t locked_for_write;
+    do
+    {
+        (void)interlocked_increment(&clds_open_addressing_hash_table->pending_write_operations);
+        locked_for_write = interlocked_add(&clds_open_addressing_hash_table->locked_for_write, 0);
+        if (locked_for_write != 0)
+        {
+            (void)interlocked_decrement(&clds_open_addressing_hash_table->pending_write_operations);
+            wake_by_address_all(&clds_open_addressing_hash_table->pending_write_operations);
+
+            // Wait for the groups to be rebuilt
+            (void)wait_on_address(&clds_open_addressing_hash_table->locked_for_write, locked_for_write, UINT32_MAX);
+        }
+    } while (locked_for_write != 0);
+}
+
+static void end_write_operation(CLDS_OPEN_ADDRESSING_HASH_TABLE* clds_open_addressing_hash_table)
+{
+    // only a rebuild waits for the writers, so there is nobody to wake otherwise
+    if (
+        (interlocked_decrement(&clds_open_addressing_hash_table->pending_write_operations) == 0) &&
+        (interlocked_add(&clds_open_addressing_hash_table->locked_for_write, 0) != 0)
+        )
+    {
+        wake_by_address_all(&clds_open_addressing_hash_table->pending_write_operations);
+    }
+}
+
+static void wait_for_write_operations(CLDS_OPEN_ADDRESSING_HASH_TABLE* clds_open_addressing_hash_table)
+{
+    int32_t pending_writes;
+    do
+    {
+        pending_writes = interlocked_add(&clds_open_addressing_hash_table->pending_write_operations, 0);
+        if (pending_writes != 0)
+        {
+            // Wait for writes
+            (void)wait_on_address(&clds_open_addressing_hash_table->pending_write_operations, pending_writes, UINT32_MAX);
+        }
+    } while (pending_writes != 0);
+}
+
+// returns the hazard pointer that keeps the group array of the table from being freed while it is read
+static CLDS_HAZARD_POINTER_RECORD_HANDLE acquire_group_array(CLDS_OPEN_ADDRESSING_HASH_TABLE* clds_open_addressing_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_OPEN_ADDRESSING_GROUP_ARRAY** group_array)
+{
+    CLDS_HAZARD_POINTER_RECORD_HANDLE result;
+    bool done = false;
+
+    do
+    {
+        *group_array = clds_open_addressing_hash_table->group_array;
+        result = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, *group_array);
+        if (result == NULL)
+        {
+            LogError("Cannot acquire hazard pointer");
+            done = true;
+        }
+        else if (clds_open_addressing_hash_table->group_array != *group_array)
+        {
+            // the groups were rebuilt before the hazard pointer was published
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, result);
+        }
+        else
+        {
+            done = true;
+        }
+    } while (!done);
+
+    return result;
+}
+
+// looks for the slot of the key, key_slot->group is NULL if the key is not in the groups
+// *group_array_replaced is set when the groups were rebuilt while they were read (only a reader can see that), the key has to be looked for again in the new group array
+static int find_key_slot(CLDS_OPEN_ADDRESSING_HASH_TABLE* clds_open_addressing_hash_table, CLDS_OPEN_ADDRESSING_GROUP_ARRAY* group_array, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t hash, void* key, KEY_SLOT* key_slot, bool* group_array_replaced)
+{
+    int result = 0;
+    uint8_t tag = clds_open_addressing_group_get_tag(hash);
+    int32_t group_index = clds_open_addressing_group_get_first_group_index(group_array->group_count, hash);
+    int32_t probe_count = 0;
+    bool done = false;
+
+    key_slot->group = NULL;
+    *group_array_replaced = false;
+
+    while (!done && (probe_count < group_array->group_count))
+    {
+        CLDS_OPEN_ADDRESSING_GROUP* group = &group_array->groups[group_index];
+        int32_t version = clds_open_addressing_group_read_version(group);
+        bool group_changed = false;
+        CLDS_OPEN_ADDRESSING_CONTROL_BYTES control_bytes;
+        uint32_t match_mask;
+
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_034: [ clds_open_addressing_hash_table_find shall compare the control bytes of each visited group with the low 7 bits of the hash of the key, using one 16 byte SSE2 compare when available, without locking the group. ]*/
+        clds_open_addressing_group_read_control_bytes(group, &control_bytes);
+        match_mask = clds_open_addressing_group_match_control_byte(&control_bytes, tag);
+
+        while ((match_mask != 0) && !group_changed && !done)
+        {
+            uint32_t slot_index = clds_open_addressing_group_get_lowest_set_bit_index(match_mask);
+            void* slot_value = clds_open_addressing_group_get_slot(group, slot_index);
+
+            match_mask &= match_mask - 1;
+
+            if (clds_open_addressing_group_is_slot_deleted(slot_value))
+            {
+                // the item of the slot was deleted, the key of the slot is not in the table anymore
+            }
+            else
+            {
+                CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = slot_value;
+                CLDS_HAZARD_POINTER_RECORD_HANDLE item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, item);
+                if (item_hp == NULL)
+                {
+                    LogError("Cannot acquire hazard pointer");
+                    result = MU_FAILURE;
+                    done = true;
+                }
+                else
+                {
+                    /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_035: [ For each matching slot, clds_open_addressing_hash_table_find shall acquire a hazard pointer on the item in the slot, check that the version of the group did not change and compare the hash and then the key of the item. ]*/
+                    if (clds_open_addressing_group_version_changed(group, version))
+                    {
+                        // the item might have been retired before the hazard pointer was published
+                        group_changed = true;
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, item_hp);
+                    }
+                    else if (clds_open_addressing_hash_table->group_array != group_array)
+                    {
+                        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_056: [ If the group array of the table was replaced when the hazard pointer on the item was acquired, clds_open_addressing_hash_table_find shall look for the key again in the group array of the table. ]*/
+                        // the slots of a replaced group array (and their versions) do not change anymore, so the item might have been deleted and retired from the new group array before the hazard pointer was published
+                        *group_array_replaced = true;
+                        done = true;
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, item_hp);
+                    }
+                    else if (
+                        (item->hash == hash) &&
+                        (clds_open_addressing_hash_table->key_compare_func(item->key, key) == 0)
+                        )
+                    {
+                        // the slot holds the key, the key is in no other slot
+                        key_slot->group = group;
+                        key_slot->slot_index = slot_index;
+                        key_slot->slot_value = slot_value;
+                        key_slot->item_hp = item_hp;
+                        done = true;
+                    }
+                    else
+                    {
+                        // tag collision, look at the next matching slot
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, item_hp);
+                    }
+                }
+            }
+        }
+
+        if (!done)
+        {
+            if (group_changed || (clds_open_addressing_group_version_changed(group, version)))
+            {
+                /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_036: [ If the version of the group changed while it was read, clds_open_addressing_hash_table_find shall read the group again. ]*/
+            }
+            else if (clds_open_addressing_group_has_free_slot(group, clds_open_addressing_group_match_control_byte(&control_bytes, CLDS_OPEN_ADDRESSING_CONTROL_BYTE_EMPTY)))
+            {
+                // no insert of this key ever went past this group
+                done = true;
+            }
+            else
+            {
+                probe_count++;
+                group_index = clds_open_addressing_group_get_next_group_index(group_array->group_count, group_index, probe_count);
+            }
+        }
+    }
+
+    return result;
+}
+
+// marks the slot of the key deleted and retires the item, the slot is given back when the groups are rebuilt
+static CLDS_HASH_TABLE_REMOVE_RESULT remove_item(CLDS_OPEN_ADDRESSING_HASH_TABLE* clds_open_addressing_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM** item, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    uint64_t hash = clds_open_addressing_hash_table->compute_hash(key);
+    CLDS_OPEN_ADDRESSING_GROUP_ARRAY* group_array;
+    bool done = false;
+
+    check_lock_and_begin_write_operation(clds_open_addressing_hash_table);
+
+    // the groups are not rebuilt while a write operation is pending
+    group_array = clds_open_addressing_hash_table->group_array;
+
+    do
+    {
+        KEY_SLOT key_slot;
+        bool group_array_replaced;
+
+        if (find_key_slot(clds_open_addressing_hash_table, group_array, clds_hazard_pointers_thread, hash, key, &key_slot, &group_array_replaced) != 0)
+        {
+            LogError("find_key_slot failed");
+            result = CLDS_HASH_TABLE_REMOVE_ERROR;
+            done = true;
+        }
+        else if (key_slot.group == NULL)
+        {
+            result = CLDS_HASH_TABLE_REMOVE_NOT_FOUND;
+            done = true;
+        }
+        else
+        {
+            CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* removed_item = key_slot.slot_value;
+
+            if (clds_open_addressing_group_change_slot(key_slot.group, key_slot.slot_index, removed_item, CLDS_OPEN_ADDRESSING_SLOT_DELETED))
+            {
+                clds_open_addressing_group_increment_version(key_slot.group);
+
+                if (sequence_number != NULL)
+                {
+                    *sequence_number = interlocked_increment_64(clds_open_addressing_hash_table->sequence_number);
+                }
+
+                if (item != NULL)
+                {
+                    *item = removed_item;
+                    (void)interlocked_increment(&removed_item->ref_count);
+                }
+
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, key_slot.item_hp);
+
+                // the reference of the table goes away once no reader protects the item anymore
+                CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, removed_item, reclaim_table_node);
+
+                result = CLDS_HASH_TABLE_REMOVE_OK;
+                done = true;
+            }
+            else
+            {
+                // another writer deleted the key first, look again
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, key_slot.item_hp);
+            }
+        }
+    } while (!done);
+
+    end_write_operation(clds_open_addressing_hash_table);
+
+    return result;
+}
+
+// must be called as a write operation, *no_free_slot is set when the first max_probe_count groups of the probe sequence have no free slot
+static CLDS_HASH_TABLE_INSERT_RESULT insert_in_groups(CLDS_OPEN_ADDRESSING_HASH_TABLE* clds_open_addressing_hash_table, CLDS_OPEN_ADDRESSING_GROUP_ARRAY* group_array, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* value, int32_t max_probe_count, int64_t* sequence_number, bool* no_free_slot)
+{
+    CLDS_HASH_TABLE_INSERT_RESULT result = CLDS_HASH_TABLE_INSERT_ERROR;
+    uint8_t tag = clds_open_addressing_group_get_tag(value->hash);
+    int32_t group_index = clds_open_addressing_group_get_first_group_index(group_array->group_count, value->hash);
+    int32_t probe_count = 0;
+    bool done = false;
+
+    while (!done && (probe_count < max_probe_count))
+    {
+        CLDS_OPEN_ADDRESSING_GROUP* group = &group_array->groups[group_index];
+        bool group_changed = false;
+        CLDS_OPEN_ADDRESSING_CONTROL_BYTES control_bytes;
+        uint32_t candidate_mask;
+
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_017: [ clds_open_addressing_hash_table_insert shall visit the groups of the probe sequence of the hash, starting at the group given by the hash bits above the low 7 bits, and in each group the slots whose control byte is EMPTY or equal to the low 7 bits of the hash, without locking the group. ]*/
+        clds_open_addressing_group_read_control_bytes(group, &control_bytes);
+        candidate_mask = clds_open_addressing_group_match_control_byte(&control_bytes, tag) | clds_open_addressing_group_match_control_byte(&control_bytes, CLDS_OPEN_ADDRESSING_CONTROL_BYTE_EMPTY);
+
+        while ((candidate_mask != 0) && !group_changed && !done)
+        {
+            uint32_t slot_index = clds_open_addressing_group_get_lowest_set_bit_index(candidate_mask);
+            void* slot_value = clds_open_addressing_group_get_slot(group, slot_index);
+
+            candidate_mask &= candidate_mask - 1;
+
+            if (slot_value == NULL)
+            {
+                if (clds_open_addressing_group_change_slot(group, slot_index, NULL, value))
+                {
+                    /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_019: [ If a visited slot is NULL, clds_open_addressing_hash_table_insert shall claim it by changing it from NULL to value with a compare exchange, set the control byte of the slot to the low 7 bits of the hash, increment the version of the group and return CLDS_HASH_TABLE_INSERT_OK. ]*/
+                    clds_open_addressing_group_set_control_byte(group, slot_index, tag);
+                    clds_open_addressing_group_increment_version(group);
+
+                    if (sequence_number != NULL)
+                    {
+                        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_020: [ For a non-NULL sequence_number, clds_open_addressing_hash_table_insert shall increment the start sequence number after changing the slot and store the result in sequence_number. ]*/
+                        *sequence_number = interlocked_increment_64(clds_open_addressing_hash_table->sequence_number);
+                    }
+
+                    result = CLDS_HASH_TABLE_INSERT_OK;
+                    done = true;
+                }
+                else
+                {
+                    /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_042: [ If the compare exchange of a slot fails, clds_open_addressing_hash_table_insert shall read the group again. ]*/
+                    group_changed = true;
+                }
+            }
+            else if (clds_open_addressing_group_is_slot_deleted(slot_value))
+            {
+                /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_021: [ clds_open_addressing_hash_table_insert shall skip the slots of deleted items. ]*/
+                // the slot is given back when the groups are rebuilt
+            }
+            else
+            {
+                CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = slot_value;
+
+                /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_043: [ Before comparing the key of the item in a slot, clds_open_addressing_hash_table_insert shall acquire a hazard pointer on the item and check that the slot did not change, reading the group again if it did. ]*/
+                CLDS_HAZARD_POINTER_RECORD_HANDLE item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, item);
+                if (item_hp == NULL)
+                {
+                    /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_049: [ If any error occurs, clds_open_addressing_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+                    LogError("Cannot acquire hazard pointer");
+                    done = true;
+                }
+                else
+                {
+                    if (clds_open_addressing_group_get_slot(group, slot_index) != slot_value)
+                    {
+                        group_changed = true;
+                    }
+                    else if (
+                        (item->hash == value->hash) &&
+                        (clds_open_addressing_hash_table->key_compare_func(item->key, value->key) == 0)
+                        )
+                    {
+                        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_018: [ If a slot holds an item with the same key, clds_open_addressing_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+                        result = CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS;
+                        done = true;
+                    }
+                    else
+                    {
+                        // the slot holds another key
+                    }
+
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, item_hp);
+                }
+            }
+        }
+
+        if (!done && !group_changed)
+        {
+            probe_count++;
+            group_index = clds_open_addressing_group_get_next_group_index(group_array->group_count, group_index, probe_count);
+        }
+    }
+
+    *no_free_slot = !done;
+
+    return result;
+}
+
+// gives the slots of the deleted items back and grows the groups when they are more than half full
+static int rebuild_groups(CLDS_OPEN_ADDRESSING_HASH_TABLE* clds_open_addressing_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread)
+{
+    int result;
+
+    if (interlocked_compare_exchange(&clds_open_addressing_hash_table->locked_for_write, 1, 0) != 0)
+    {
+        // another insert is rebuilding the groups, look again once it is done
+        result = 0;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_045: [ To rebuild the groups, clds_open_addressing_hash_table_insert shall block the other writers and wait for the write operations in progress to complete. ]*/
+        CLDS_OPEN_ADDRESSING_GROUP_ARRAY* old_group_array;
+        size_t item_count;
+        int32_t group_count;
+
+        wait_for_write_operations(clds_open_addressing_hash_table);
+
+        old_group_array = clds_open_addressing_hash_table->group_array;
+        item_count = clds_open_addressing_group_array_get_item_count(old_group_array);
+
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_046: [ clds_open_addressing_hash_table_insert shall allocate a new group array with the number of groups of 16 slots needed for twice the number of items plus one, rounded up to a power of 2 and at least the group count computed at create time. ]*/
+        group_count = clds_open_addressing_group_get_rebuild_group_count(item_count + 1, clds_open_addressing_hash_table->initial_group_count);
+        if (group_count == 0)
+        {
+            /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_049: [ If any error occurs, clds_open_addressing_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+            LogError("The table cannot hold more than %zu items", item_count);
+            result = MU_FAILURE;
+        }
+        else
+        {
+            CLDS_OPEN_ADDRESSING_GROUP_ARRAY* new_group_array = malloc_flex(sizeof(CLDS_OPEN_ADDRESSING_GROUP_ARRAY), (size_t)group_count, sizeof(CLDS_OPEN_ADDRESSING_GROUP));
+            if (new_group_array == NULL)
+            {
+                /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_049: [ If any error occurs, clds_open_addressing_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+                LogError("malloc_flex(sizeof(CLDS_OPEN_ADDRESSING_GROUP_ARRAY)=%zu, (size_t)group_count=%zu, sizeof(CLDS_OPEN_ADDRESSING_GROUP)=%zu) failed",
+                    sizeof(CLDS_OPEN_ADDRESSING_GROUP_ARRAY), (size_t)group_count, sizeof(CLDS_OPEN_ADDRESSING_GROUP));
+                result = MU_FAILURE;
+            }
+            else
+            {
+                int32_t i;
+
+                new_group_array->group_count = group_count;
+                CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(new_group_array);
+                for (i = 0; i < group_count; i++)
+                {
+                    clds_open_addressing_group_init(&new_group_array->groups[i]);
+                }
+
+                /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_047: [ clds_open_addressing_hash_table_insert shall store the items in the new group array and publish the new group array. ]*/
+                for (i = 0; i < old_group_array->group_count; i++)
+                {
+                    uint32_t j;
+
+                    for (j = 0; j < CLDS_OPEN_ADDRESSING_GROUP_SIZE; j++)
+                    {
+                        void* slot_value = clds_open_addressing_group_get_slot(&old_group_array->groups[i], j);
+                        if (clds_open_addressing_group_is_slot_item(slot_value))
+                        {
+                            CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = slot_value;
+                            clds_open_addressing_group_array_place_item(new_group_array, item, item->hash);
+                        }
+                    }
+                }
+
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_open_addressing_hash_table->group_array, new_group_array);
+
+                /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_048: [ clds_open_addressing_hash_table_insert shall retire the old group array through hazard pointers. ]*/
+                CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, old_group_array, reclaim_group_array);
+
+                result = 0;
+            }
+        }
+
+        (void)interlocked_exchange(&clds_open_addressing_hash_table->locked_for_write, 0);
+        wake_by_address_all(&clds_open_addressing_hash_table->locked_for_write);
+    }
+
+    return result;
+}
+
+CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE clds_open_addressing_hash_table_create(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t capacity, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* start_sequence_number)
+{
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE clds_open_addressing_hash_table;
+
+    /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_006: [ start_sequence_number shall be allowed to be NULL, in which case no sequence number computations shall be performed. ]*/
+
+    if (
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_002: [ If compute_hash is NULL, clds_open_addressing_hash_table_create shall fail and return NULL. ]*/
+        (compute_hash == NULL) ||
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_003: [ If key_compare_func is NULL, clds_open_addressing_hash_table_create shall fail and return NULL. ]*/
+        (key_compare_func == NULL) ||
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_004: [ If capacity is 0 or greater than 2^30, clds_open_addressing_hash_table_create shall fail and return NULL. ]*/
+        (capacity == 0) ||
+        (capacity > CLDS_OPEN_ADDRESSING_MAX_CAPACITY) ||
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_005: [ If clds_hazard_pointers is NULL, clds_open_addressing_hash_table_create shall fail and return NULL. ]*/
+        (clds_hazard_pointers == NULL)
+        )
+    {
+        LogError("Invalid arguments: COMPUTE_HASH_FUNC compute_hash=%p, KEY_COMPARE_FUNC key_compare_func=%p, size_t capacity=%zu, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers=%p, volatile_atomic int64_t* start_sequence_number=%p",
+            compute_hash, key_compare_func, capacity, clds_hazard_pointers, start_sequence_number);
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_001: [ clds_open_addressing_hash_table_create shall create a new hash table object and on success it shall return a non-NULL handle to the newly created hash table. ]*/
+        clds_open_addressing_hash_table = malloc(sizeof(CLDS_OPEN_ADDRESSING_HASH_TABLE));
+        if (clds_open_addressing_hash_table == NULL)
+        {
+            /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_009: [ If any error happens, clds_open_addressing_hash_table_create shall fail and return NULL. ]*/
+            LogError("malloc(sizeof(CLDS_OPEN_ADDRESSING_HASH_TABLE)=%zu) failed", sizeof(CLDS_OPEN_ADDRESSING_HASH_TABLE));
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_007: [ The group count shall be the number of groups of 16 slots needed for capacity items, rounded up to a power of 2, and the groups shall never be rebuilt with fewer groups. ]*/
+            int32_t group_count = clds_open_addressing_group_get_group_count(capacity);
+            CLDS_OPEN_ADDRESSING_GROUP_ARRAY* group_array = malloc_flex(sizeof(CLDS_OPEN_ADDRESSING_GROUP_ARRAY), (size_t)group_count, sizeof(CLDS_OPEN_ADDRESSING_GROUP));
+            if (group_array == NULL)
+            {
+                /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_009: [ If any error happens, clds_open_addressing_hash_table_create shall fail and return NULL. ]*/
+                LogError("malloc_flex(sizeof(CLDS_OPEN_ADDRESSING_GROUP_ARRAY)=%zu, (size_t)group_count=%zu, sizeof(CLDS_OPEN_ADDRESSING_GROUP)=%zu) failed",
+                    sizeof(CLDS_OPEN_ADDRESSING_GROUP_ARRAY), (size_t)group_count, sizeof(CLDS_OPEN_ADDRESSING_GROUP));
+            }
+            else
+            {
+                int32_t i;
+
+                clds_open_addressing_hash_table->compute_hash = compute_hash;
+                clds_open_addressing_hash_table->key_compare_func = key_compare_func;
+                clds_open_addressing_hash_table->clds_hazard_pointers = clds_hazard_pointers;
+
+                /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_010: [ start_sequence_number shall be used as the sequence number variable that shall be incremented at every operation that is done on the hash table. ]*/
+                clds_open_addressing_hash_table->sequence_number = start_sequence_number;
+                clds_open_addressing_hash_table->initial_group_count = group_count;
+
+                /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_008: [ All the slots shall start EMPTY. ]*/
+                group_array->group_count = group_count;
+                CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(group_array);
+                for (i = 0; i < group_count; i++)
+                {
+                    clds_open_addressing_group_init(&group_array->groups[i]);
+                }
+
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_open_addressing_hash_table->group_array, group_array);
+                (void)interlocked_exchange(&clds_open_addressing_hash_table->locked_for_write, 0);
+                (void)interlocked_exchange(&clds_open_addressing_hash_table->pending_write_operations, 0);
+
+                goto all_ok;
+            }
+
+            free(clds_open_addressing_hash_table);
+        }
+    }
+
+    clds_open_addressing_hash_table = NULL;
+
+all_ok:
+    return clds_open_addressing_hash_table;
+}
+
+void clds_open_addressing_hash_table_destroy(CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE clds_open_addressing_hash_table)
+{
+    if (clds_open_addressing_hash_table == NULL)
+    {
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_012: [ If clds_open_addressing_hash_table is NULL, clds_open_addressing_hash_table_destroy shall return. ]*/
+        LogError("Invalid arguments: CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE clds_open_addressing_hash_table=%p", clds_open_addressing_hash_table);
+    }
+    else
+    {
+        CLDS_OPEN_ADDRESSING_GROUP_ARRAY* group_array = clds_open_addressing_hash_table->group_array;
+        int32_t i;
+
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_011: [ clds_open_addressing_hash_table_destroy shall release the items in the table and free all resources associated with the hash table instance. ]*/
+        for (i = 0; i < group_array->group_count; i++)
+        {
+            uint32_t j;
+            CLDS_OPEN_ADDRESSING_GROUP* group = &group_array->groups[i];
+
+            for (j = 0; j < CLDS_OPEN_ADDRESSING_GROUP_SIZE; j++)
+            {
+                void* slot_value = clds_open_addressing_group_get_slot(group, j);
+                if (clds_open_addressing_group_is_slot_item(slot_value))
+                {
+                    internal_node_destroy(slot_value);
+                }
+            }
+        }
+
+        free(group_array);
+        free(clds_open_addressing_hash_table);
+    }
+}
+
+CLDS_HASH_TABLE_INSERT_RESULT clds_open_addressing_hash_table_insert(CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE clds_open_addressing_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* value, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_013: [ If clds_open_addressing_hash_table is NULL, clds_open_addressing_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (clds_open_addressing_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_014: [ If clds_hazard_pointers_thread, key or value is NULL, clds_open_addressing_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        (key == NULL) ||
+        (value == NULL) ||
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_015: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_open_addressing_hash_table_create, clds_open_addressing_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_open_addressing_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE clds_open_addressing_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* value=%p, int64_t* sequence_number=%p",
+            clds_open_addressing_hash_table, clds_hazard_pointers_thread, key, value, sequence_number);
+        result = CLDS_HASH_TABLE_INSERT_ERROR;
+    }
+    else
+    {
+        bool groups_rebuilt = false;
+        bool done = false;
+
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_016: [ clds_open_addressing_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_open_addressing_hash_table_create. ]*/
+        value->hash = clds_open_addressing_hash_table->compute_hash(key);
+        value->key = key;
+
+        do
+        {
+            CLDS_OPEN_ADDRESSING_GROUP_ARRAY* group_array;
+            int32_t max_probe_count;
+            bool no_free_slot;
+
+            /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_044: [ If the groups are being rebuilt, clds_open_addressing_hash_table_insert shall wait for the rebuild to complete before visiting the groups. ]*/
+            check_lock_and_begin_write_operation(clds_open_addressing_hash_table);
+
+            group_array = clds_open_addressing_hash_table->group_array;
+            max_probe_count = (groups_rebuilt || (group_array->group_count < CLDS_OPEN_ADDRESSING_MAX_PROBE_COUNT)) ? group_array->group_count : CLDS_OPEN_ADDRESSING_MAX_PROBE_COUNT;
+
+            result = insert_in_groups(clds_open_addressing_hash_table, group_array, clds_hazard_pointers_thread, value, max_probe_count, sequence_number, &no_free_slot);
+
+            end_write_operation(clds_open_addressing_hash_table);
+
+            if (!no_free_slot)
+            {
+                done = true;
+            }
+            /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_022: [ If no NULL slot is found in the first 8 groups of the probe sequence (or in all the groups once the groups were rebuilt), clds_open_addressing_hash_table_insert shall rebuild the groups and look again. ]*/
+            else if (rebuild_groups(clds_open_addressing_hash_table, clds_hazard_pointers_thread) != 0)
+            {
+                /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_049: [ If any error occurs, clds_open_addressing_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+                LogError("rebuild_groups failed");
+                result = CLDS_HASH_TABLE_INSERT_ERROR;
+                done = true;
+            }
+            else
+            {
+                groups_rebuilt = true;
+            }
+        } while (!done);
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_DELETE_RESULT clds_open_addressing_hash_table_delete(CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE clds_open_addressing_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_023: [ If clds_open_addressing_hash_table, clds_hazard_pointers_thread or key is NULL, clds_open_addressing_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_open_addressing_hash_table == NULL) ||
+        (clds_hazard_pointers_thread == NULL) ||
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_024: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_open_addressing_hash_table_create, clds_open_addressing_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_open_addressing_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE clds_open_addressing_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, int64_t* sequence_number=%p",
+            clds_open_addressing_hash_table, clds_hazard_pointers_thread, key, sequence_number);
+        result = CLDS_HASH_TABLE_DELETE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_051: [ If the groups are being rebuilt, clds_open_addressing_hash_table_delete shall wait for the rebuild to complete before visiting the groups. ]*/
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_025: [ clds_open_addressing_hash_table_delete shall look for the key in the groups of its probe sequence like clds_open_addressing_hash_table_find, mark the slot of the key deleted with a compare exchange, increment the version of the group, retire the item through hazard pointers and return CLDS_HASH_TABLE_DELETE_OK. ]*/
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_050: [ If the compare exchange of the slot fails, clds_open_addressing_hash_table_delete shall look for the key again. ]*/
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_026: [ For a non-NULL sequence_number, clds_open_addressing_hash_table_delete shall increment the start sequence number after changing the slot and store the result in sequence_number. ]*/
+        switch (remove_item(clds_open_addressing_hash_table, clds_hazard_pointers_thread, key, NULL, sequence_number))
+        {
+        case CLDS_HASH_TABLE_REMOVE_OK:
+            result = CLDS_HASH_TABLE_DELETE_OK;
+            break;
+        case CLDS_HASH_TABLE_REMOVE_NOT_FOUND:
+            /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_027: [ If the key is not found, clds_open_addressing_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+            result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+            break;
+        default:
+            /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_052: [ If any error occurs, clds_open_addressing_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+            result = CLDS_HASH_TABLE_DELETE_ERROR;
+            break;
+        }
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_REMOVE_RESULT clds_open_addressing_hash_table_remove(CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE clds_open_addressing_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM** item, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_028: [ If clds_open_addressing_hash_table, clds_hazard_pointers_thread, key or item is NULL, clds_open_addressing_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        (clds_open_addressing_hash_table == NULL) ||
+        (clds_hazard_pointers_thread == NULL) ||
+        (key == NULL) ||
+        (item == NULL) ||
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_029: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_open_addressing_hash_table_create, clds_open_addressing_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_open_addressing_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE clds_open_addressing_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM** item=%p, int64_t* sequence_number=%p",
+            clds_open_addressing_hash_table, clds_hazard_pointers_thread, key, item, sequence_number);
+        result = CLDS_HASH_TABLE_REMOVE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_053: [ If the groups are being rebuilt, clds_open_addressing_hash_table_remove shall wait for the rebuild to complete before visiting the groups. ]*/
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_030: [ clds_open_addressing_hash_table_remove shall remove the item with the given key like clds_open_addressing_hash_table_delete, return it with its reference count incremented in item and return CLDS_HASH_TABLE_REMOVE_OK. ]*/
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_032: [ For a non-NULL sequence_number, clds_open_addressing_hash_table_remove shall increment the start sequence number after changing the slot and store the result in sequence_number. ]*/
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_031: [ If the key is not found, clds_open_addressing_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_054: [ If any error occurs, clds_open_addressing_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        result = remove_item(clds_open_addressing_hash_table, clds_hazard_pointers_thread, key, item, sequence_number);
+    }
+
+    return result;
+}
+
+CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* clds_open_addressing_hash_table_find(CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE clds_open_addressing_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+{
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* result;
+
+    if (
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_033: [ If clds_open_addressing_hash_table, clds_hazard_pointers_thread or key is NULL, clds_open_addressing_hash_table_find shall fail and return NULL. ]*/
+        (clds_open_addressing_hash_table == NULL) ||
+        (clds_hazard_pointers_thread == NULL) ||
+        (key == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE clds_open_addressing_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p",
+            clds_open_addressing_hash_table, clds_hazard_pointers_thread, key);
+        result = NULL;
+    }
+    else
+    {
+        uint64_t hash = clds_open_addressing_hash_table->compute_hash(key);
+        bool done = false;
+
+        do
+        {
+            CLDS_OPEN_ADDRESSING_GROUP_ARRAY* group_array;
+
+            /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_055: [ clds_open_addressing_hash_table_find shall acquire a hazard pointer on the group array of the table and check that it is still the group array of the table before reading the groups. ]*/
+            CLDS_HAZARD_POINTER_RECORD_HANDLE group_array_hp = acquire_group_array(clds_open_addressing_hash_table, clds_hazard_pointers_thread, &group_array);
+            if (group_array_hp == NULL)
+            {
+                /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_038: [ If any error occurs, clds_open_addressing_hash_table_find shall fail and return NULL. ]*/
+                LogError("acquire_group_array failed");
+                result = NULL;
+                done = true;
+            }
+            else
+            {
+                KEY_SLOT key_slot;
+                bool group_array_replaced;
+
+                if (find_key_slot(clds_open_addressing_hash_table, group_array, clds_hazard_pointers_thread, hash, key, &key_slot, &group_array_replaced) != 0)
+                {
+                    /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_038: [ If any error occurs, clds_open_addressing_hash_table_find shall fail and return NULL. ]*/
+                    LogError("find_key_slot failed");
+                    result = NULL;
+                    done = true;
+                }
+                else if (group_array_replaced)
+                {
+                    /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_056: [ If the group array of the table was replaced when the hazard pointer on the item was acquired, clds_open_addressing_hash_table_find shall look for the key again in the group array of the table. ]*/
+                }
+                else if (key_slot.group == NULL)
+                {
+                    /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_039: [ If the key is not found before a group with a NULL slot or after visiting all the groups, clds_open_addressing_hash_table_find shall return NULL. ]*/
+                    result = NULL;
+                    done = true;
+                }
+                else
+                {
+                    /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_037: [ If the key is found, clds_open_addressing_hash_table_find shall return the item with its reference count incremented. ]*/
+                    result = key_slot.slot_value;
+                    (void)interlocked_increment(&result->ref_count);
+
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, key_slot.item_hp);
+                    done = true;
+                }
+
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, group_array_hp);
+            }
+        } while (!done);
+    }
+
+    return result;
+}
+
+CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* clds_open_addressing_hash_table_node_create(size_t node_size, OPEN_ADDRESSING_HASH_TABLE_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context)
+{
+    /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_040: [ item_cleanup_callback and item_cleanup_callback_context shall be allowed to be NULL. ]*/
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* result = malloc(node_size);
+    if (result == NULL)
+    {
+        LogError("malloc(node_size=%zu) failed", node_size);
+    }
+    else
+    {
+        result->item_cleanup_callback = item_cleanup_callback;
+        result->item_cleanup_callback_context = item_cleanup_callback_context;
+        result->key = NULL;
+        result->hash = 0;
+        (void)interlocked_exchange(&result->ref_count, 1);
+        CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(result);
+    }
+
+    return result;
+}
+
+int clds_open_addressing_hash_table_node_inc_ref(CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item)
+{
+    int result;
+
+    if (item == NULL)
+    {
+        LogError("Invalid arguments: CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item=%p", item);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        (void)interlocked_increment(&item->ref_count);
+        result = 0;
+    }
+
+    return result;
+}
+
+void clds_open_addressing_hash_table_node_release(CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item)
+{
+    if (item == NULL)
+    {
+        LogError("Invalid arguments: CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item=%p", item);
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_041: [ When the reference count of an item reaches 0, item_cleanup_callback shall be called (if not NULL) and the item shall be freed. ]*/
+        internal_node_destroy(item);
+    }
+}
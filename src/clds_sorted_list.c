@@ -27,7 +27,7 @@ MU_DEFINE_ENUM_STRINGS(CLDS_CONDITION_CHECK_RESULT, CLDS_CONDITION_CHECK_RESULT_
 typedef struct CLDS_SORTED_LIST_TAG
 {
     CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
-    volatile_atomic CLDS_SORTED_LIST_ITEM* head;
+    CLDS_SORTED_LIST_HEAD list_head;
     SORTED_LIST_GET_ITEM_KEY_CB get_item_key_cb;
     void* get_item_key_cb_context;
     SORTED_LIST_KEY_COMPARE_CB key_compare_cb;
@@ -76,7 +76,7 @@ static void internal_node_destroy(CLDS_SORTED_LIST_ITEM* item)
         /* Codes_SRS_CLDS_SORTED_LIST_01_044: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the reclaimed item. ]*/
         if (item->item_cleanup_callback != NULL)
         {
-            /* Codes_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+            /* Codes_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_retire shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
             item->item_cleanup_callback(item->item_cleanup_callback_context, item);
         }
 
@@ -138,7 +138,7 @@ static void internal_unlock_writes(CLDS_SORTED_LIST_HANDLE clds_sorted_list)
     wake_by_address_all(&clds_sorted_list->locked_for_write);
 }
 
-static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, SORTED_LIST_ITEM_COMPARE_CB item_compare_callback, void* item_compare_target, int64_t* sequence_number)
+static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, SORTED_LIST_ITEM_COMPARE_CB item_compare_callback, void* item_compare_target, int64_t* sequence_number)
 {
     CLDS_SORTED_LIST_DELETE_RESULT result = CLDS_SORTED_LIST_DELETE_ERROR;
 
@@ -156,7 +156,7 @@ static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE cl
         CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp = NULL;
         CLDS_SORTED_LIST_ITEM* previous_item = NULL;
         // start at the head of the list and scan through all nodes until we find the one we are looking for
-        CLDS_SORTED_LIST_ITEM* volatile_atomic* current_item_address = (CLDS_SORTED_LIST_ITEM * volatile_atomic*)&clds_sorted_list->head;
+        CLDS_SORTED_LIST_ITEM* volatile_atomic* current_item_address = (CLDS_SORTED_LIST_ITEM * volatile_atomic*)&list_head->head;
 
         do
         {
@@ -264,7 +264,7 @@ static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE cl
                                 if (previous_item == NULL)
                                 {
                                     // we are removing the head, special case
-                                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_sorted_list->head, (void*)current_next, (void*)current_item) != (void*)current_item)
+                                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&list_head->head, (void*)current_next, (void*)current_item) != (void*)current_item)
                                     {
                                         // head changed, restart, but make sure we unlock the delete bit for current node
                                         (void)interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, (void*)current_next, (void*)((uintptr_t)current_next | 1));
@@ -301,8 +301,8 @@ static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE cl
                                         clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
 
                                         // reclaim the memory
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-                                        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
+                                        /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_retire. ]*/
+                                        CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, current_item, reclaim_list_node);
                                         restart_needed = false;
 
                                         /* Codes_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
@@ -355,8 +355,8 @@ static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE cl
                                         clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
 
                                         // reclaim the memory
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-                                        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
+                                        /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_retire. ]*/
+                                        CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, current_item, reclaim_list_node);
 
                                         /* Codes_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
                                         /* Codes_SRS_CLDS_SORTED_LIST_01_025: [ On success, clds_sorted_list_delete_key shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
@@ -390,7 +390,7 @@ static CLDS_SORTED_LIST_DELETE_RESULT internal_delete(CLDS_SORTED_LIST_HANDLE cl
     return result;
 }
 
-static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, SORTED_LIST_ITEM_COMPARE_CB item_compare_callback, void* item_compare_target, CLDS_SORTED_LIST_ITEM** item, int64_t* sequence_number)
+static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, SORTED_LIST_ITEM_COMPARE_CB item_compare_callback, void* item_compare_target, CLDS_SORTED_LIST_ITEM** item, int64_t* sequence_number)
 {
     CLDS_SORTED_LIST_REMOVE_RESULT result = CLDS_SORTED_LIST_DELETE_ERROR;
 
@@ -408,7 +408,7 @@ static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE cl
 
         CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp = NULL;
         CLDS_SORTED_LIST_ITEM* previous_item = NULL;
-        CLDS_SORTED_LIST_ITEM* volatile_atomic* current_item_address = (CLDS_SORTED_LIST_ITEM* volatile_atomic*)&clds_sorted_list->head;
+        CLDS_SORTED_LIST_ITEM* volatile_atomic* current_item_address = (CLDS_SORTED_LIST_ITEM* volatile_atomic*)&list_head->head;
 
         do
         {
@@ -510,7 +510,7 @@ static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE cl
                                 if (previous_item == NULL)
                                 {
                                     // we are removing the head
-                                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_sorted_list->head, (void*)current_next, (void*)current_item) != (void*)current_item)
+                                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&list_head->head, (void*)current_next, (void*)current_item) != (void*)current_item)
                                     {
                                         // head changed, restart
                                         (void)interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, (void*)current_next, (void*)((uintptr_t)current_next | 1));
@@ -548,8 +548,8 @@ static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE cl
                                         clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
 
                                         // reclaim the memory
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-                                        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
+                                        /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_retire. ]*/
+                                        CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, current_item, reclaim_list_node);
                                         restart_needed = false;
 
                                         /* Codes_SRS_CLDS_SORTED_LIST_01_052: [ On success, clds_sorted_list_remove_key shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
@@ -600,8 +600,8 @@ static CLDS_SORTED_LIST_REMOVE_RESULT internal_remove(CLDS_SORTED_LIST_HANDLE cl
                                         clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
 
                                         // reclaim the memory
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-                                        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
+                                        /* Codes_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_retire. ]*/
+                                        CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, current_item, reclaim_list_node);
 
                                         /* Codes_SRS_CLDS_SORTED_LIST_01_052: [ On success, clds_sorted_list_remove_key shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
                                         result = CLDS_SORTED_LIST_REMOVE_OK;
@@ -686,13 +686,31 @@ CLDS_SORTED_LIST_HANDLE clds_sorted_list_create(CLDS_HAZARD_POINTERS_HANDLE clds
             /* Codes_SRS_CLDS_SORTED_LIST_01_058: [ start_sequence_number shall be used by the sorted list to compute the sequence number of each operation. ]*/
             clds_sorted_list->sequence_number = start_sequence_number;
 
-            (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_sorted_list->head, NULL);
+            CLDS_SORTED_LIST_HEAD_INIT(&clds_sorted_list->list_head);
         }
     }
 
     return clds_sorted_list;
 }
 
+static void free_list_items(CLDS_SORTED_LIST_HEAD* list_head)
+{
+    CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&list_head->head, NULL, NULL);
+
+    // go through all the items and free them
+    while (current_item != NULL)
+    {
+        CLDS_SORTED_LIST_ITEM* next_item = (CLDS_SORTED_LIST_ITEM*)((uintptr_t)interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, NULL, NULL) & ~0x1);
+
+        /* Codes_SRS_CLDS_SORTED_LIST_01_040: [ For each item that is freed, the callback item_cleanup_callback passed to clds_sorted_list_node_create shall be called, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_041: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the freed items. ]*/
+        internal_node_destroy(current_item);
+        current_item = next_item;
+    }
+
+    CLDS_SORTED_LIST_HEAD_INIT(list_head);
+}
+
 void clds_sorted_list_destroy(CLDS_SORTED_LIST_HANDLE clds_sorted_list)
 {
     if (clds_sorted_list == NULL)
@@ -702,147 +720,183 @@ void clds_sorted_list_destroy(CLDS_SORTED_LIST_HANDLE clds_sorted_list)
     }
     else
     {
-        CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_sorted_list->head, NULL, NULL);
-
         /* Codes_SRS_CLDS_SORTED_LIST_01_039: [ Any items still present in the list shall be freed. ]*/
-        // go through all the items and free them
-        while (current_item != NULL)
-        {
-            CLDS_SORTED_LIST_ITEM* next_item = (CLDS_SORTED_LIST_ITEM*)((uintptr_t)interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, NULL, NULL) & ~0x1);
-
-            /* Codes_SRS_CLDS_SORTED_LIST_01_040: [ For each item that is freed, the callback item_cleanup_callback passed to clds_sorted_list_node_create shall be called, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
-            /* Codes_SRS_CLDS_SORTED_LIST_01_041: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the freed items. ]*/
-            internal_node_destroy(current_item);
-            current_item = next_item;
-        }
+        free_list_items(&clds_sorted_list->list_head);
 
         /* Codes_SRS_CLDS_SORTED_LIST_01_004: [ clds_sorted_list_destroy shall free all resources associated with the sorted list instance. ]*/
         free(clds_sorted_list);
     }
 }
 
-CLDS_SORTED_LIST_INSERT_RESULT clds_sorted_list_insert(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM* item, int64_t* sequence_number)
+static CLDS_SORTED_LIST_ITEM* create_item_with_factory(SORTED_LIST_ITEM_FACTORY_CB item_factory, void* item_factory_context)
 {
-    CLDS_SORTED_LIST_INSERT_RESULT result;
-
-    if (
-        /* Codes_SRS_CLDS_SORTED_LIST_01_011: [ If clds_sorted_list is NULL, clds_sorted_list_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
-        (clds_sorted_list == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_012: [ If item is NULL, clds_sorted_list_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
-        (item == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_013: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
-        (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_062: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_sorted_list->sequence_number == NULL))
-        )
+    CLDS_SORTED_LIST_ITEM* result = item_factory(item_factory_context);
+    if (result == NULL)
     {
-        LogError("Invalid arguments: clds_sorted_list = %p, item = %p, clds_hazard_pointers_thread = %p, sequence_number = %p",
-            clds_sorted_list, item, clds_hazard_pointers_thread, sequence_number);
-        result = CLDS_SORTED_LIST_INSERT_ERROR;
+        LogError("item_factory failed");
     }
     else
     {
-        /*Codes_SRS_CLDS_SORTED_LIST_42_001: [ clds_sorted_list_insert shall try the following until it acquires a write lock for the list: ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_002: [ clds_sorted_list_insert shall increment the count of pending write operations. ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_003: [ If the counter to lock the list for writes is non-zero then: ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_004: [ clds_sorted_list_insert shall decrement the count of pending write operations. ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_005: [ clds_sorted_list_insert shall wait for the counter to lock the list for writes to reach 0 and repeat. ]*/
-        check_lock_and_begin_write_operation(clds_sorted_list);
+        // one reference for the list and one for the caller, the item can be deleted by another thread as soon as it is linked
+        (void)interlocked_increment(&result->ref_count);
+    }
 
-        bool restart_needed;
-        void* new_item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, item);
-        int64_t local_seq_no = 0;
+    return result;
+}
 
-        /* Codes_SRS_CLDS_SORTED_LIST_01_069: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
-        if (clds_sorted_list->sequence_number != NULL)
-        {
-            /* Codes_SRS_CLDS_SORTED_LIST_01_060: [ For each insert the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
-            local_seq_no = interlocked_increment_64(clds_sorted_list->sequence_number);
+// when item_factory is not NULL, item is NULL, key is the key to insert and the item is only created once the insert position is found,
+// existing_or_new_item receives the item in the list for key (either the one that was there or the created one) with a reference taken
+static CLDS_SORTED_LIST_INSERT_RESULT internal_insert(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM* item, void* key, SORTED_LIST_ITEM_FACTORY_CB item_factory, void* item_factory_context, CLDS_SORTED_LIST_ITEM** existing_or_new_item, int64_t* sequence_number)
+{
+    CLDS_SORTED_LIST_INSERT_RESULT result;
 
-            /* Codes_SRS_CLDS_SORTED_LIST_01_061: [ If the sequence_number argument passed to clds_sorted_list_insert is NULL, the computed sequence number for the insert shall still be computed but it shall not be provided to the user. ]*/
-            if (sequence_number != NULL)
-            {
-                *sequence_number = local_seq_no;
-            }
+    /*Codes_SRS_CLDS_SORTED_LIST_42_001: [ clds_sorted_list_insert shall try the following until it acquires a write lock for the list: ]*/
+    /*Codes_SRS_CLDS_SORTED_LIST_42_002: [ clds_sorted_list_insert shall increment the count of pending write operations. ]*/
+    /*Codes_SRS_CLDS_SORTED_LIST_42_003: [ If the counter to lock the list for writes is non-zero then: ]*/
+    /*Codes_SRS_CLDS_SORTED_LIST_42_004: [ clds_sorted_list_insert shall decrement the count of pending write operations. ]*/
+    /*Codes_SRS_CLDS_SORTED_LIST_42_005: [ clds_sorted_list_insert shall wait for the counter to lock the list for writes to reach 0 and repeat. ]*/
+    check_lock_and_begin_write_operation(clds_sorted_list);
+
+    bool restart_needed;
+    void* new_item_key = (item_factory == NULL) ? clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, item) : key;
+    int64_t local_seq_no = 0;
+
+    /* Codes_SRS_CLDS_SORTED_LIST_01_069: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
+    if (clds_sorted_list->sequence_number != NULL)
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_01_060: [ For each insert the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
+        local_seq_no = interlocked_increment_64(clds_sorted_list->sequence_number);
+
+        /* Codes_SRS_CLDS_SORTED_LIST_01_061: [ If the sequence_number argument passed to clds_sorted_list_insert is NULL, the computed sequence number for the insert shall still be computed but it shall not be provided to the user. ]*/
+        if (sequence_number != NULL)
+        {
+            *sequence_number = local_seq_no;
         }
+    }
 
-        /* Codes_SRS_CLDS_SORTED_LIST_01_047: [ clds_sorted_list_insert shall insert the item at its correct location making sure that items in the list are sorted according to the order given by item keys. ]*/
+    /* Codes_SRS_CLDS_SORTED_LIST_01_047: [ clds_sorted_list_insert shall insert the item at its correct location making sure that items in the list are sorted according to the order given by item keys. ]*/
+
+    do
+    {
+        CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp = NULL;
+        CLDS_SORTED_LIST_ITEM* previous_item = NULL;
+        CLDS_SORTED_LIST_ITEM* volatile_atomic* current_item_address = (CLDS_SORTED_LIST_ITEM* volatile_atomic*)&list_head->head;
+        result = CLDS_SORTED_LIST_INSERT_ERROR;
+        uint64_t iteration_count = 0;
 
         do
         {
-            CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp = NULL;
-            CLDS_SORTED_LIST_ITEM* previous_item = NULL;
-            CLDS_SORTED_LIST_ITEM* volatile_atomic* current_item_address = (CLDS_SORTED_LIST_ITEM* volatile_atomic*)&clds_sorted_list->head;
-            result = CLDS_SORTED_LIST_INSERT_ERROR;
-            uint64_t iteration_count = 0;
-
-            do
+            if (++iteration_count > ITERATION_COUNT_LOG_LIMIT)
             {
-                if (++iteration_count > ITERATION_COUNT_LOG_LIMIT)
-                {
-                    LogInfo("clds_sorted_list_insert spun for %" PRIu64 " iterations", (uint64_t)ITERATION_COUNT_LOG_LIMIT);
-                    iteration_count = 0;
-                }
+                LogInfo("clds_sorted_list_insert spun for %" PRIu64 " iterations", (uint64_t)ITERATION_COUNT_LOG_LIMIT);
+                iteration_count = 0;
+            }
 
-                // get the current_item value
-                CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, NULL, NULL);
+            // get the current_item value
+            CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, NULL, NULL);
 
-                // clear any delete lock bit from what we read
-                current_item = (CLDS_SORTED_LIST_ITEM*)((uintptr_t)current_item & ~0x1);
+            // clear any delete lock bit from what we read
+            current_item = (CLDS_SORTED_LIST_ITEM*)((uintptr_t)current_item & ~0x1);
 
-                // check if the item is NULL
-                if (current_item == NULL)
+            // check if the item is NULL
+            if (current_item == NULL)
+            {
+                if (item == NULL)
                 {
-                    item->next = NULL;
-
-                    // not found, so insert it here
-                    if (previous_item != NULL)
+                    /* Codes_SRS_CLDS_SORTED_LIST_01_166: [ clds_sorted_list_head_get_or_insert shall call item_factory only when key is not found in the items linked to list_head. ]*/
+                    item = create_item_with_factory(item_factory, item_factory_context);
+                    if (item == NULL)
                     {
-                        // have a previous item, try to replace the NULL with the new item
-                        // if there is something else than NULL there, restart, there were some major changes
-                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&previous_item->next, (void*)item, (void*)current_item) != NULL)
+                        if (previous_hp != NULL)
                         {
                             // let go of previous hazard pointer
                             clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                            restart_needed = true;
-                            break;
                         }
-                        else
-                        {
-                            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                            restart_needed = false;
 
-                            /* Codes_SRS_CLDS_SORTED_LIST_01_010: [ On success clds_sorted_list_insert shall return CLDS_SORTED_LIST_INSERT_OK. ]*/
-                            result = CLDS_SORTED_LIST_INSERT_OK;
-                            break;
+                        if (clds_sorted_list->skipped_seq_no_cb != NULL)
+                        {
+                            clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, local_seq_no);
                         }
+
+                        /* Codes_SRS_CLDS_SORTED_LIST_01_169: [ If item_factory fails or any other error occurs, clds_sorted_list_head_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+                        restart_needed = false;
+                        result = CLDS_SORTED_LIST_INSERT_ERROR;
+                        break;
+                    }
+                }
+
+                item->next = NULL;
+
+                // not found, so insert it here
+                if (previous_item != NULL)
+                {
+                    // have a previous item, try to replace the NULL with the new item
+                    // if there is something else than NULL there, restart, there were some major changes
+                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&previous_item->next, (void*)item, (void*)current_item) != NULL)
+                    {
+                        // let go of previous hazard pointer
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                        restart_needed = true;
+                        break;
                     }
                     else
                     {
-                        // no previous item, replace the head, make sure it is a "clean" NULL, no lock bit set
-                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_sorted_list->head, item, NULL) != NULL)
-                        {
-                            restart_needed = true;
-                            break;
-                        }
-                        else
-                        {
-                            // insert done
-                            restart_needed = false;
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                        restart_needed = false;
 
-                            /* Codes_SRS_CLDS_SORTED_LIST_01_010: [ On success clds_sorted_list_insert shall return CLDS_SORTED_LIST_INSERT_OK. ]*/
-                            result = CLDS_SORTED_LIST_INSERT_OK;
-                            break;
-                        }
+                        /* Codes_SRS_CLDS_SORTED_LIST_01_010: [ On success clds_sorted_list_insert shall return CLDS_SORTED_LIST_INSERT_OK. ]*/
+                        result = CLDS_SORTED_LIST_INSERT_OK;
+                        break;
+                    }
+                }
+                else
+                {
+                    // no previous item, replace the head, make sure it is a "clean" NULL, no lock bit set
+                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&list_head->head, item, NULL) != NULL)
+                    {
+                        restart_needed = true;
+                        break;
+                    }
+                    else
+                    {
+                        // insert done
+                        restart_needed = false;
+
+                        /* Codes_SRS_CLDS_SORTED_LIST_01_010: [ On success clds_sorted_list_insert shall return CLDS_SORTED_LIST_INSERT_OK. ]*/
+                        result = CLDS_SORTED_LIST_INSERT_OK;
+                        break;
+                    }
+                }
+
+                break;
+            }
+            else
+            {
+                // acquire hazard pointer
+                CLDS_HAZARD_POINTER_RECORD_HANDLE current_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)current_item);
+                if (current_item_hp == NULL)
+                {
+                    if (previous_hp != NULL)
+                    {
+                        // let go of previous hazard pointer
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                     }
 
+                    if (clds_sorted_list->skipped_seq_no_cb != NULL)
+                    {
+                        /* Codes_SRS_CLDS_SORTED_LIST_01_079: [** If sequence numbers are generated and a skipped sequence number callback was provided to clds_sorted_list_create, when the item is indicated as already existing, the generated sequence number shall be indicated as skipped. ]*/
+                        clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, local_seq_no);
+                    }
+
+                    LogError("Cannot acquire hazard pointer");
+                    restart_needed = false;
+                    result = CLDS_SORTED_LIST_INSERT_ERROR;
                     break;
                 }
                 else
                 {
-                    // acquire hazard pointer
-                    CLDS_HAZARD_POINTER_RECORD_HANDLE current_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)current_item);
-                    if (current_item_hp == NULL)
+                    // now make sure the item has not changed. This also takes care of checking that the delete lock bit is not set
+                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, NULL, NULL) != (void*)current_item)
                     {
                         if (previous_hp != NULL)
                         {
@@ -850,132 +904,189 @@ CLDS_SORTED_LIST_INSERT_RESULT clds_sorted_list_insert(CLDS_SORTED_LIST_HANDLE c
                             clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                         }
 
-                        if (clds_sorted_list->skipped_seq_no_cb != NULL)
-                        {
-                            /* Codes_SRS_CLDS_SORTED_LIST_01_079: [** If sequence numbers are generated and a skipped sequence number callback was provided to clds_sorted_list_create, when the item is indicated as already existing, the generated sequence number shall be indicated as skipped. ]*/
-                            clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, local_seq_no);
-                        }
+                        // item changed, it is likely that the node is no longer reachable, so we should not use its memory, restart
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
 
-                        LogError("Cannot acquire hazard pointer");
-                        restart_needed = false;
-                        result = CLDS_SORTED_LIST_INSERT_ERROR;
+                        restart_needed = true;
                         break;
                     }
                     else
                     {
-                        // now make sure the item has not changed. This also takes care of checking that the delete lock bit is not set
-                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, NULL, NULL) != (void*)current_item)
+                        // we are in a stable state, at this point the previous node does not have a delete lock bit set
+                        // compare the current item key to our key
+                        void* current_item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)current_item);
+                        int compare_result = clds_sorted_list->key_compare_cb(clds_sorted_list->key_compare_cb_context, new_item_key, current_item_key);
+
+                        if (compare_result == 0)
                         {
-                            if (previous_hp != NULL)
+                            // item already in the list
+                            if (previous_item != NULL)
                             {
-                                // let go of previous hazard pointer
                                 clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                             }
 
-                            // item changed, it is likely that the node is no longer reachable, so we should not use its memory, restart
+                            if (item_factory != NULL)
+                            {
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_168: [ If key is found, clds_sorted_list_head_get_or_insert shall set item to the item in the list, with its reference count incremented, and return CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS. ]*/
+                                // the hazard pointer is still held, so the item cannot be reclaimed before the reference is taken
+                                (void)interlocked_increment(&current_item->ref_count);
+                                *existing_or_new_item = current_item;
+                            }
+
                             clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                            restart_needed = false;
 
-                            restart_needed = true;
+                            if (clds_sorted_list->skipped_seq_no_cb != NULL)
+                            {
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_079: [** If sequence numbers are generated and a skipped sequence number callback was provided to clds_sorted_list_create, when the item is indicated as already existing, the generated sequence number shall be indicated as skipped. ]*/
+                                clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, local_seq_no);
+                            }
+
+                            /* Codes_SRS_CLDS_SORTED_LIST_01_048: [ If the item with the given key already exists in the list, clds_sorted_list_insert shall fail and return CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS. ]*/
+                            result = CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS;
                             break;
                         }
-                        else
+                        else if (compare_result < 0)
                         {
-                            // we are in a stable state, at this point the previous node does not have a delete lock bit set
-                            // compare the current item key to our key
-                            void* current_item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)current_item);
-                            int compare_result = clds_sorted_list->key_compare_cb(clds_sorted_list->key_compare_cb_context, new_item_key, current_item_key);
-
-                            if (compare_result == 0)
+                            if (item == NULL)
                             {
-                                // item already in the list
-                                if (previous_item != NULL)
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_166: [ clds_sorted_list_head_get_or_insert shall call item_factory only when key is not found in the items linked to list_head. ]*/
+                                item = create_item_with_factory(item_factory, item_factory_context);
+                                if (item == NULL)
                                 {
-                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                }
+                                    if (previous_hp != NULL)
+                                    {
+                                        // let go of previous hazard pointer
+                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                    }
 
-                                clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                                restart_needed = false;
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
 
-                                if (clds_sorted_list->skipped_seq_no_cb != NULL)
-                                {
-                                    /* Codes_SRS_CLDS_SORTED_LIST_01_079: [** If sequence numbers are generated and a skipped sequence number callback was provided to clds_sorted_list_create, when the item is indicated as already existing, the generated sequence number shall be indicated as skipped. ]*/
-                                    clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, local_seq_no);
-                                }
+                                    if (clds_sorted_list->skipped_seq_no_cb != NULL)
+                                    {
+                                        clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, local_seq_no);
+                                    }
 
-                                /* Codes_SRS_CLDS_SORTED_LIST_01_048: [ If the item with the given key already exists in the list, clds_sorted_list_insert shall fail and return CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS. ]*/
-                                result = CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS;
-                                break;
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_169: [ If item_factory fails or any other error occurs, clds_sorted_list_head_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+                                    restart_needed = false;
+                                    result = CLDS_SORTED_LIST_INSERT_ERROR;
+                                    break;
+                                }
                             }
-                            else if (compare_result < 0)
-                            {
-                                // need to insert between the previous and current node, since current node's key is higher than what we want to insert
-                                item->next = current_item;
 
-                                if (previous_item != NULL)
-                                {
-                                    // have a previous item
-                                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&previous_item->next, (void*)item, (void*)current_item) != (void*)current_item)
-                                    {
-                                        // let go of both hazard pointers
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                                        restart_needed = true;
-                                        break;
-                                    }
-                                    else
-                                    {
-                                        // let go of both hazard pointers
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                                        restart_needed = false;
+                            // need to insert between the previous and current node, since current node's key is higher than what we want to insert
+                            item->next = current_item;
 
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_010: [ On success clds_sorted_list_insert shall return 0. ]*/
-                                        result = CLDS_SORTED_LIST_INSERT_OK;
-                                        break;
-                                    }
+                            if (previous_item != NULL)
+                            {
+                                // have a previous item
+                                if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&previous_item->next, (void*)item, (void*)current_item) != (void*)current_item)
+                                {
+                                    // let go of both hazard pointers
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                    restart_needed = true;
+                                    break;
                                 }
                                 else
                                 {
-                                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_sorted_list->head, (void*)item, (void*)current_item) != current_item)
-                                    {
-                                        // let go of the hazard pointer
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                                        restart_needed = true;
-                                        break;
-                                    }
-                                    else
-                                    {
-                                        // let go of the hazard pointer
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                                        restart_needed = false;
+                                    // let go of both hazard pointers
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                    restart_needed = false;
 
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_010: [ On success clds_sorted_list_insert shall return CLDS_SORTED_LIST_INSERT_OK. ]*/
-                                        result = CLDS_SORTED_LIST_INSERT_OK;
-                                        break;
-                                    }
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_010: [ On success clds_sorted_list_insert shall return 0. ]*/
+                                    result = CLDS_SORTED_LIST_INSERT_OK;
+                                    break;
                                 }
                             }
-                            else // item is less than the current, so move on
+                            else
                             {
-                                // we have a stable pointer to the current item, now simply set the previous to be this
-                                if (previous_hp != NULL)
+                                if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&list_head->head, (void*)item, (void*)current_item) != current_item)
                                 {
-                                    // let go of previous hazard pointer
-                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                    // let go of the hazard pointer
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                    restart_needed = true;
+                                    break;
                                 }
+                                else
+                                {
+                                    // let go of the hazard pointer
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                    restart_needed = false;
 
-                                previous_hp = current_item_hp;
-                                previous_item = current_item;
-                                current_item_address = (CLDS_SORTED_LIST_ITEM* volatile_atomic*)&current_item->next;
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_010: [ On success clds_sorted_list_insert shall return CLDS_SORTED_LIST_INSERT_OK. ]*/
+                                    result = CLDS_SORTED_LIST_INSERT_OK;
+                                    break;
+                                }
+                            }
+                        }
+                        else // item is less than the current, so move on
+                        {
+                            // we have a stable pointer to the current item, now simply set the previous to be this
+                            if (previous_hp != NULL)
+                            {
+                                // let go of previous hazard pointer
+                                clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                             }
+
+                            previous_hp = current_item_hp;
+                            previous_item = current_item;
+                            current_item_address = (CLDS_SORTED_LIST_ITEM* volatile_atomic*)&current_item->next;
                         }
                     }
                 }
-            } while (1);
-        } while (restart_needed);
+            }
+        } while (1);
+    } while (restart_needed);
 
-        /*Codes_SRS_CLDS_SORTED_LIST_42_051: [ clds_sorted_list_insert shall decrement the count of pending write operations. ]*/
-        end_write_operation(clds_sorted_list);
+    if (item_factory != NULL)
+    {
+        if (result == CLDS_SORTED_LIST_INSERT_OK)
+        {
+            /* Codes_SRS_CLDS_SORTED_LIST_01_167: [ If key is not found, clds_sorted_list_head_get_or_insert shall link the item created by item_factory at its position, set item to it with its reference count incremented and return CLDS_SORTED_LIST_INSERT_OK. ]*/
+            *existing_or_new_item = item;
+        }
+        else if (item != NULL)
+        {
+            // the created item did not make it in the list (the key got inserted by another thread after the item was created), drop both references
+            internal_node_destroy(item);
+            internal_node_destroy(item);
+        }
+        else
+        {
+            // nothing was created
+        }
+    }
+
+    /*Codes_SRS_CLDS_SORTED_LIST_42_051: [ clds_sorted_list_insert shall decrement the count of pending write operations. ]*/
+    end_write_operation(clds_sorted_list);
+
+    return result;
+}
+
+CLDS_SORTED_LIST_INSERT_RESULT clds_sorted_list_insert(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM* item, int64_t* sequence_number)
+{
+    CLDS_SORTED_LIST_INSERT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_011: [ If clds_sorted_list is NULL, clds_sorted_list_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_012: [ If item is NULL, clds_sorted_list_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (item == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_013: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_062: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_sorted_list->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: clds_sorted_list = %p, item = %p, clds_hazard_pointers_thread = %p, sequence_number = %p",
+            clds_sorted_list, item, clds_hazard_pointers_thread, sequence_number);
+        result = CLDS_SORTED_LIST_INSERT_ERROR;
+    }
+    else
+    {
+        result = internal_insert(clds_sorted_list, &clds_sorted_list->list_head, clds_hazard_pointers_thread, item, NULL, NULL, NULL, NULL, sequence_number);
     }
 
     return result;
@@ -1010,7 +1121,7 @@ CLDS_SORTED_LIST_DELETE_RESULT clds_sorted_list_delete_item(CLDS_SORTED_LIST_HAN
         check_lock_and_begin_write_operation(clds_sorted_list);
 
         /* Codes_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
-        result = internal_delete(clds_sorted_list, clds_hazard_pointers_thread, compare_item_by_ptr, item, sequence_number);
+        result = internal_delete(clds_sorted_list, &clds_sorted_list->list_head, clds_hazard_pointers_thread, compare_item_by_ptr, item, sequence_number);
 
         /*Codes_SRS_CLDS_SORTED_LIST_42_011: [ clds_sorted_list_delete_item shall decrement the count of pending write operations. ]*/
         end_write_operation(clds_sorted_list);
@@ -1048,7 +1159,7 @@ CLDS_SORTED_LIST_DELETE_RESULT clds_sorted_list_delete_key(CLDS_SORTED_LIST_HAND
         check_lock_and_begin_write_operation(clds_sorted_list);
 
         /* Codes_SRS_CLDS_SORTED_LIST_01_019: [ clds_sorted_list_delete_key shall delete an item by its key. ]*/
-        result = internal_delete(clds_sorted_list, clds_hazard_pointers_thread, compare_item_by_key, key, sequence_number);
+        result = internal_delete(clds_sorted_list, &clds_sorted_list->list_head, clds_hazard_pointers_thread, compare_item_by_key, key, sequence_number);
 
         /*Codes_SRS_CLDS_SORTED_LIST_42_017: [ clds_sorted_list_delete_key shall decrement the count of pending write operations. ]*/
         end_write_operation(clds_sorted_list);
@@ -1086,7 +1197,7 @@ CLDS_SORTED_LIST_REMOVE_RESULT clds_sorted_list_remove_key(CLDS_SORTED_LIST_HAND
         check_lock_and_begin_write_operation(clds_sorted_list);
 
         /* Codes_SRS_CLDS_SORTED_LIST_01_051: [ clds_sorted_list_remove_key shall delete an item by its key and return the pointer to the deleted item. ]*/
-        result = internal_remove(clds_sorted_list, clds_hazard_pointers_thread, compare_item_by_key, key, item, sequence_number);
+        result = internal_remove(clds_sorted_list, &clds_sorted_list->list_head, clds_hazard_pointers_thread, compare_item_by_key, key, item, sequence_number);
 
         /*Codes_SRS_CLDS_SORTED_LIST_42_023: [ clds_sorted_list_remove_key shall decrement the count of pending write operations. ]*/
         end_write_operation(clds_sorted_list);
@@ -1095,51 +1206,54 @@ CLDS_SORTED_LIST_REMOVE_RESULT clds_sorted_list_remove_key(CLDS_SORTED_LIST_HAND
     return result;
 }
 
-CLDS_SORTED_LIST_ITEM* clds_sorted_list_find_key(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+static CLDS_SORTED_LIST_ITEM* internal_find_key(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
 {
     CLDS_SORTED_LIST_ITEM* result;
 
-    /* Codes_SRS_CLDS_SORTED_LIST_01_028: [ If clds_sorted_list is NULL, clds_sorted_list_find shall fail and return NULL. ]*/
-    if (
-        (clds_sorted_list == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_030: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_find shall fail and return NULL. ]*/
-        (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_031: [ If key is NULL, clds_sorted_list_find shall fail and return NULL. ]*/
-        (key == NULL)
-        )
-    {
-        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p",
-            clds_sorted_list, clds_hazard_pointers_thread, key);
-        result = NULL;
-    }
-    else
+    /* Codes_SRS_CLDS_SORTED_LIST_01_027: [ clds_sorted_list_find shall find in the list the first item that matches the criteria given by a user compare function. ]*/
+
+    bool restart_needed;
+    result = NULL;
+    uint64_t iteration_count = 0;
+
+    do
     {
-        /* Codes_SRS_CLDS_SORTED_LIST_01_027: [ clds_sorted_list_find shall find in the list the first item that matches the criteria given by a user compare function. ]*/
+        if (++iteration_count > ITERATION_COUNT_LOG_LIMIT)
+        {
+            LogInfo("clds_sorted_list_find_key spun for %" PRIu64 " iterations", (uint64_t)ITERATION_COUNT_LOG_LIMIT);
+            iteration_count = 0;
+        }
 
-        bool restart_needed;
-        result = NULL;
-        uint64_t iteration_count = 0;
+        CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp = NULL;
+        volatile_atomic CLDS_SORTED_LIST_ITEM** current_item_address = &list_head->head;
 
         do
         {
-            if (++iteration_count > ITERATION_COUNT_LOG_LIMIT)
-            {
-                LogInfo("clds_sorted_list_find_key spun for %" PRIu64 " iterations", (uint64_t)ITERATION_COUNT_LOG_LIMIT);
-                iteration_count = 0;
-            }
+            // get the current_item value
+            CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, NULL, NULL);
 
-            CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp = NULL;
-            volatile_atomic CLDS_SORTED_LIST_ITEM** current_item_address = &clds_sorted_list->head;
+            // clear any delete lock bit from what we read
+            current_item = (void*)((uintptr_t)current_item & ~0x1);
 
-            do
+            if (current_item == NULL)
             {
-                // get the current_item value
-                CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, NULL, NULL);
+                if (previous_hp != NULL)
+                {
+                    // let go of previous hazard pointer
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                }
 
-                // clear any delete lock bit from what we read
-                current_item = (void*)((uintptr_t)current_item & ~0x1);
+                restart_needed = false;
 
-                if (current_item == NULL)
+                /* Codes_SRS_CLDS_SORTED_LIST_01_033: [ If no item satisfying the user compare function is found in the list, clds_sorted_list_find_key shall fail and return NULL. ]*/
+                result = NULL;
+                break;
+            }
+            else
+            {
+                // acquire hazard pointer
+                CLDS_HAZARD_POINTER_RECORD_HANDLE current_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)current_item);
+                if (current_item_hp == NULL)
                 {
                     if (previous_hp != NULL)
                     {
@@ -1147,6 +1261,7 @@ CLDS_SORTED_LIST_ITEM* clds_sorted_list_find_key(CLDS_SORTED_LIST_HANDLE clds_so
                         clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                     }
 
+                    LogError("Cannot acquire hazard pointer");
                     restart_needed = false;
 
                     /* Codes_SRS_CLDS_SORTED_LIST_01_033: [ If no item satisfying the user compare function is found in the list, clds_sorted_list_find_key shall fail and return NULL. ]*/
@@ -1155,9 +1270,8 @@ CLDS_SORTED_LIST_ITEM* clds_sorted_list_find_key(CLDS_SORTED_LIST_HANDLE clds_so
                 }
                 else
                 {
-                    // acquire hazard pointer
-                    CLDS_HAZARD_POINTER_RECORD_HANDLE current_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)current_item);
-                    if (current_item_hp == NULL)
+                    // now make sure the item has not changed
+                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, (void*)current_item, (void*)current_item) != (void*)current_item)
                     {
                         if (previous_hp != NULL)
                         {
@@ -1165,17 +1279,16 @@ CLDS_SORTED_LIST_ITEM* clds_sorted_list_find_key(CLDS_SORTED_LIST_HANDLE clds_so
                             clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                         }
 
-                        LogError("Cannot acquire hazard pointer");
-                        restart_needed = false;
-
-                        /* Codes_SRS_CLDS_SORTED_LIST_01_033: [ If no item satisfying the user compare function is found in the list, clds_sorted_list_find_key shall fail and return NULL. ]*/
-                        result = NULL;
+                        // item changed, it is likely that the node is no longer reachable, so we should not use its memory, restart
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                        restart_needed = true;
                         break;
                     }
                     else
                     {
-                        // now make sure the item has not changed
-                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, (void*)current_item, (void*)current_item) != (void*)current_item)
+                        void* item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)current_item);
+                        int compare_result = clds_sorted_list->key_compare_cb(clds_sorted_list->key_compare_cb_context, key, item_key);
+                        if (compare_result == 0)
                         {
                             if (previous_hp != NULL)
                             {
@@ -1183,200 +1296,202 @@ CLDS_SORTED_LIST_ITEM* clds_sorted_list_find_key(CLDS_SORTED_LIST_HANDLE clds_so
                                 clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                             }
 
-                            // item changed, it is likely that the node is no longer reachable, so we should not use its memory, restart
+                            // found it
+                            /* Codes_SRS_CLDS_SORTED_LIST_01_034: [ clds_sorted_list_find_key shall return a pointer to the item with the reference count already incremented so that it can be safely used by the caller. ]*/
+                            (void)interlocked_increment(&current_item->ref_count);
                             clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                            restart_needed = true;
+
+                            /* Codes_SRS_CLDS_SORTED_LIST_01_029: [ On success clds_sorted_list_find shall return a non-NULL pointer to the found linked list item. ]*/
+                            result = (CLDS_SORTED_LIST_ITEM*)current_item;
+                            restart_needed = false;
                             break;
                         }
                         else
                         {
-                            void* item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)current_item);
-                            int compare_result = clds_sorted_list->key_compare_cb(clds_sorted_list->key_compare_cb_context, key, item_key);
-                            if (compare_result == 0)
+                            // we have a stable pointer to the current item, now simply set the previous to be this
+                            if (previous_hp != NULL)
                             {
-                                if (previous_hp != NULL)
-                                {
-                                    // let go of previous hazard pointer
-                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                }
-
-                                // found it
-                                /* Codes_SRS_CLDS_SORTED_LIST_01_034: [ clds_sorted_list_find_key shall return a pointer to the item with the reference count already incremented so that it can be safely used by the caller. ]*/
-                                (void)interlocked_increment(&current_item->ref_count);
-                                clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-
-                                /* Codes_SRS_CLDS_SORTED_LIST_01_029: [ On success clds_sorted_list_find shall return a non-NULL pointer to the found linked list item. ]*/
-                                result = (CLDS_SORTED_LIST_ITEM*)current_item;
-                                restart_needed = false;
-                                break;
+                                // let go of previous hazard pointer
+                                clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                             }
-                            else
-                            {
-                                // we have a stable pointer to the current item, now simply set the previous to be this
-                                if (previous_hp != NULL)
-                                {
-                                    // let go of previous hazard pointer
-                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                }
 
-                                previous_hp = current_item_hp;
-                                current_item_address = (volatile_atomic CLDS_SORTED_LIST_ITEM**)&current_item->next;
-                            }
+                            previous_hp = current_item_hp;
+                            current_item_address = (volatile_atomic CLDS_SORTED_LIST_ITEM**)&current_item->next;
                         }
                     }
                 }
-            } while (1);
-        } while (restart_needed);
-    }
+            }
+        } while (1);
+    } while (restart_needed);
 
     return result;
 }
 
-CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SORTED_LIST_ITEM* new_item, CONDITION_CHECK_CB condition_check_func, void* condition_check_context, CLDS_SORTED_LIST_ITEM** old_item, int64_t* sequence_number, bool only_if_exists)
+CLDS_SORTED_LIST_ITEM* clds_sorted_list_find_key(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
 {
-    CLDS_SORTED_LIST_SET_VALUE_RESULT result;
+    CLDS_SORTED_LIST_ITEM* result;
 
+    /* Codes_SRS_CLDS_SORTED_LIST_01_028: [ If clds_sorted_list is NULL, clds_sorted_list_find shall fail and return NULL. ]*/
     if (
-        /* Codes_SRS_CLDS_SORTED_LIST_01_081: [ If clds_sorted_list is NULL, clds_sorted_list_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
         (clds_sorted_list == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_082: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
+        /* Codes_SRS_CLDS_SORTED_LIST_01_030: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_find shall fail and return NULL. ]*/
         (clds_hazard_pointers_thread == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_083: [ If key is NULL, clds_sorted_list_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
-        (key == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_084: [ If new_item is NULL, clds_sorted_list_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
-        (new_item == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_085: [ If old_item is NULL, clds_sorted_list_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
-        (old_item == NULL) ||
-        /* Codes_SRS_CLDS_SORTED_LIST_01_086: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
-        ((sequence_number != NULL) && (clds_sorted_list->sequence_number == NULL))
+        /* Codes_SRS_CLDS_SORTED_LIST_01_031: [ If key is NULL, clds_sorted_list_find shall fail and return NULL. ]*/
+        (key == NULL)
         )
     {
-        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_SORTED_LIST_ITEM* new_item=%p, CONDITION_CHECK_CB condition_check_func=%p, void* condition_check_context=%p, CLDS_SORTED_LIST_ITEM** old_item=%p, int64_t* sequence_number=%p",
-            clds_sorted_list, clds_hazard_pointers_thread, key, new_item, condition_check_func, condition_check_context, old_item, sequence_number);
-        result = CLDS_SORTED_LIST_SET_VALUE_ERROR;
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p",
+            clds_sorted_list, clds_hazard_pointers_thread, key);
+        result = NULL;
     }
     else
     {
-        /*Codes_SRS_CLDS_SORTED_LIST_42_024: [ clds_sorted_list_set_value shall try the following until it acquires a write lock for the list: ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_025: [ clds_sorted_list_set_value shall increment the count of pending write operations. ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_026: [ If the counter to lock the list for writes is non-zero then: ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_027: [ clds_sorted_list_set_value shall decrement the count of pending write operations. ]*/
-        /*Codes_SRS_CLDS_SORTED_LIST_42_028: [ clds_sorted_list_set_value shall wait for the counter to lock the list for writes to reach 0 and repeat. ]*/
-        check_lock_and_begin_write_operation(clds_sorted_list);
+        result = internal_find_key(clds_sorted_list, &clds_sorted_list->list_head, clds_hazard_pointers_thread, key);
+    }
 
-        bool restart_needed;
-        void* new_item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, new_item);
-        int64_t insert_seq_no = 0;
-        
-        /* Codes_SRS_CLDS_SORTED_LIST_01_091: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
-        if (clds_sorted_list->sequence_number != NULL)
+    return result;
+}
+
+static CLDS_SORTED_LIST_SET_VALUE_RESULT internal_set_value(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SORTED_LIST_ITEM* new_item, CONDITION_CHECK_CB condition_check_func, void* condition_check_context, CLDS_SORTED_LIST_ITEM** old_item, int64_t* sequence_number, bool only_if_exists)
+{
+    CLDS_SORTED_LIST_SET_VALUE_RESULT result;
+
+    /*Codes_SRS_CLDS_SORTED_LIST_42_024: [ clds_sorted_list_set_value shall try the following until it acquires a write lock for the list: ]*/
+    /*Codes_SRS_CLDS_SORTED_LIST_42_025: [ clds_sorted_list_set_value shall increment the count of pending write operations. ]*/
+    /*Codes_SRS_CLDS_SORTED_LIST_42_026: [ If the counter to lock the list for writes is non-zero then: ]*/
+    /*Codes_SRS_CLDS_SORTED_LIST_42_027: [ clds_sorted_list_set_value shall decrement the count of pending write operations. ]*/
+    /*Codes_SRS_CLDS_SORTED_LIST_42_028: [ clds_sorted_list_set_value shall wait for the counter to lock the list for writes to reach 0 and repeat. ]*/
+    check_lock_and_begin_write_operation(clds_sorted_list);
+
+    bool restart_needed;
+    void* new_item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, new_item);
+    int64_t insert_seq_no = 0;
+    
+    /* Codes_SRS_CLDS_SORTED_LIST_01_091: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
+    if (clds_sorted_list->sequence_number != NULL)
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_01_090: [ For each set value the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
+        insert_seq_no = interlocked_increment_64(clds_sorted_list->sequence_number);
+
+        /* Codes_SRS_CLDS_SORTED_LIST_01_092: [ If the sequence_number argument passed to clds_sorted_list_set_value is NULL, the computed sequence number for the remove shall still be computed but it shall not be provided to the user. ]*/
+        if (sequence_number != NULL)
         {
-            /* Codes_SRS_CLDS_SORTED_LIST_01_090: [ For each set value the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
-            insert_seq_no = interlocked_increment_64(clds_sorted_list->sequence_number);
+            *sequence_number = insert_seq_no;
+        }
+    }
 
-            /* Codes_SRS_CLDS_SORTED_LIST_01_092: [ If the sequence_number argument passed to clds_sorted_list_set_value is NULL, the computed sequence number for the remove shall still be computed but it shall not be provided to the user. ]*/
-            if (sequence_number != NULL)
-            {
-                *sequence_number = insert_seq_no;
-            }
+    uint64_t iteration_count = 0;
+
+    do
+    {
+        if (++iteration_count > ITERATION_COUNT_LOG_LIMIT)
+        {
+            LogInfo("clds_sorted_list_set_value spun for %" PRIu64 " iterations", (uint64_t)ITERATION_COUNT_LOG_LIMIT);
+            iteration_count = 0;
         }
 
-        uint64_t iteration_count = 0;
+        CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp = NULL;
+        CLDS_SORTED_LIST_ITEM* previous_item = NULL;
+        volatile_atomic CLDS_SORTED_LIST_ITEM** current_item_address = &list_head->head;
+        result = CLDS_SORTED_LIST_SET_VALUE_ERROR;
 
         do
         {
-            if (++iteration_count > ITERATION_COUNT_LOG_LIMIT)
-            {
-                LogInfo("clds_sorted_list_set_value spun for %" PRIu64 " iterations", (uint64_t)ITERATION_COUNT_LOG_LIMIT);
-                iteration_count = 0;
-            }
+            // get the current_item value
+            CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, NULL, NULL);
 
-            CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp = NULL;
-            CLDS_SORTED_LIST_ITEM* previous_item = NULL;
-            volatile_atomic CLDS_SORTED_LIST_ITEM** current_item_address = &clds_sorted_list->head;
-            result = CLDS_SORTED_LIST_SET_VALUE_ERROR;
+            // clear any delete lock bit from what we read
+            current_item = (void*)((uintptr_t)current_item & ~0x1);
 
-            do
+            if (current_item == NULL)
             {
-                // get the current_item value
-                CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, NULL, NULL);
+                if (only_if_exists)
+                {
+                    if (previous_item != NULL)
+                    {
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                    }
 
-                // clear any delete lock bit from what we read
-                current_item = (void*)((uintptr_t)current_item & ~0x1);
+                    /* Codes_SRS_CLDS_SORTED_LIST_01_093: [ If the key entry does not exist and only_if_exists is true, clds_sorted_list_set_value shall return CLDS_SORTED_LIST_SET_VALUE_NOT_FOUND. ]*/
+                    result = CLDS_SORTED_LIST_SET_VALUE_NOT_FOUND;
+                    restart_needed = false;
+                    break;
+                }
 
-                if (current_item == NULL)
+                new_item->next = NULL;
+
+                // not found, so insert it here
+                if (previous_item != NULL)
                 {
-                    if (only_if_exists)
+                    // have a previous item
+                    /* Codes_SRS_CLDS_SORTED_LIST_01_087: [ If the key entry does not exist in the list and only_if_exists is false, new_item shall be inserted at the key position. ]*/
+                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&previous_item->next, (void*)new_item, NULL) != NULL)
                     {
-                        if (previous_item != NULL)
-                        {
-                            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                        }
+                        // let go of previous hazard pointer
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                        restart_needed = true;
 
-                        /* Codes_SRS_CLDS_SORTED_LIST_01_093: [ If the key entry does not exist and only_if_exists is true, clds_sorted_list_set_value shall return CLDS_SORTED_LIST_SET_VALUE_NOT_FOUND. ]*/
-                        result = CLDS_SORTED_LIST_SET_VALUE_NOT_FOUND;
-                        restart_needed = false;
                         break;
                     }
-
-                    new_item->next = NULL;
-
-                    // not found, so insert it here
-                    if (previous_item != NULL)
+                    else
                     {
-                        // have a previous item
-                        /* Codes_SRS_CLDS_SORTED_LIST_01_087: [ If the key entry does not exist in the list and only_if_exists is false, new_item shall be inserted at the key position. ]*/
-                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&previous_item->next, (void*)new_item, NULL) != NULL)
-                        {
-                            // let go of previous hazard pointer
-                            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                            restart_needed = true;
-
-                            break;
-                        }
-                        else
-                        {
-                            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                            restart_needed = false;
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                        restart_needed = false;
 
-                            /* Codes_SRS_CLDS_SORTED_LIST_01_089: [ The previous value shall be returned in old_item. ]*/
-                            *old_item = NULL;
+                        /* Codes_SRS_CLDS_SORTED_LIST_01_089: [ The previous value shall be returned in old_item. ]*/
+                        *old_item = NULL;
 
-                            /* Codes_SRS_CLDS_SORTED_LIST_01_080: [ clds_sorted_list_set_value shall replace in the list the item that matches the criteria given by the compare function passed to clds_sorted_list_create with new_item and on success it shall return CLDS_SORTED_LIST_SET_VALUE_OK. ]*/
-                            result = CLDS_SORTED_LIST_SET_VALUE_OK;
-                            break;
-                        }
+                        /* Codes_SRS_CLDS_SORTED_LIST_01_080: [ clds_sorted_list_set_value shall replace in the list the item that matches the criteria given by the compare function passed to clds_sorted_list_create with new_item and on success it shall return CLDS_SORTED_LIST_SET_VALUE_OK. ]*/
+                        result = CLDS_SORTED_LIST_SET_VALUE_OK;
+                        break;
+                    }
+                }
+                else
+                {
+                    // no previous item, replace the head
+                    /* Codes_SRS_CLDS_SORTED_LIST_01_087: [ If the key entry does not exist in the list and only_if_exists is false, new_item shall be inserted at the key position. ]*/
+                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&list_head->head, new_item, NULL) != NULL)
+                    {
+                        restart_needed = true;
+                        break;
                     }
                     else
                     {
-                        // no previous item, replace the head
-                        /* Codes_SRS_CLDS_SORTED_LIST_01_087: [ If the key entry does not exist in the list and only_if_exists is false, new_item shall be inserted at the key position. ]*/
-                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_sorted_list->head, new_item, NULL) != NULL)
-                        {
-                            restart_needed = true;
-                            break;
-                        }
-                        else
-                        {
-                            // insert done
-                            restart_needed = false;
+                        // insert done
+                        restart_needed = false;
 
-                            /* Codes_SRS_CLDS_SORTED_LIST_01_089: [ The previous value shall be returned in old_item. ]*/
-                            *old_item = NULL;
+                        /* Codes_SRS_CLDS_SORTED_LIST_01_089: [ The previous value shall be returned in old_item. ]*/
+                        *old_item = NULL;
 
-                            /* Codes_SRS_CLDS_SORTED_LIST_01_080: [ clds_sorted_list_set_value shall replace in the list the item that matches the criteria given by the compare function passed to clds_sorted_list_create with new_item and on success it shall return CLDS_SORTED_LIST_SET_VALUE_OK. ]*/
-                            result = CLDS_SORTED_LIST_SET_VALUE_OK;
-                            break;
-                        }
+                        /* Codes_SRS_CLDS_SORTED_LIST_01_080: [ clds_sorted_list_set_value shall replace in the list the item that matches the criteria given by the compare function passed to clds_sorted_list_create with new_item and on success it shall return CLDS_SORTED_LIST_SET_VALUE_OK. ]*/
+                        result = CLDS_SORTED_LIST_SET_VALUE_OK;
+                        break;
+                    }
+                }
+
+                break;
+            }
+            else
+            {
+                // acquire hazard pointer
+                CLDS_HAZARD_POINTER_RECORD_HANDLE current_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)current_item);
+                if (current_item_hp == NULL)
+                {
+                    if (previous_hp != NULL)
+                    {
+                        // let go of previous hazard pointer
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                     }
 
+                    LogError("Cannot acquire hazard pointer");
+                    restart_needed = false;
+                    result = CLDS_SORTED_LIST_SET_VALUE_ERROR;
                     break;
                 }
                 else
                 {
-                    // acquire hazard pointer
-                    CLDS_HAZARD_POINTER_RECORD_HANDLE current_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)current_item);
-                    if (current_item_hp == NULL)
+                    // now make sure the item has not changed
+                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, (void*)current_item, (void*)current_item) != (void*)current_item)
                     {
                         if (previous_hp != NULL)
                         {
@@ -1384,197 +1499,271 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
                             clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                         }
 
-                        LogError("Cannot acquire hazard pointer");
-                        restart_needed = false;
-                        result = CLDS_SORTED_LIST_SET_VALUE_ERROR;
+                        // item changed, it is likely that the node is no longer reachable, so we should not use its memory, restart
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                        restart_needed = true;
                         break;
                     }
                     else
                     {
-                        // now make sure the item has not changed
-                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, (void*)current_item, (void*)current_item) != (void*)current_item)
-                        {
-                            if (previous_hp != NULL)
-                            {
-                                // let go of previous hazard pointer
-                                clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                            }
+                        // we are in a stable state, compare the current item key to our key
+                        void* current_item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)current_item);
 
-                            // item changed, it is likely that the node is no longer reachable, so we should not use its memory, restart
-                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                            restart_needed = true;
-                            break;
-                        }
-                        else
+                        int compare_result = clds_sorted_list->key_compare_cb(clds_sorted_list->key_compare_cb_context, new_item_key, current_item_key);
+                        if (compare_result == 0)
                         {
-                            // we are in a stable state, compare the current item key to our key
-                            void* current_item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)current_item);
-
-                            int compare_result = clds_sorted_list->key_compare_cb(clds_sorted_list->key_compare_cb_context, new_item_key, current_item_key);
-                            if (compare_result == 0)
+                            if (condition_check_func != NULL)
                             {
-                                if (condition_check_func != NULL)
+                                /* Codes_SRS_CLDS_SORTED_LIST_04_001: [ If condition_check_func is not NULL it shall be called passing condition_check_context and the new and old keys. ]*/
+                                CLDS_CONDITION_CHECK_RESULT condition_check_result = condition_check_func(condition_check_context, new_item_key, current_item_key);
+                                switch (condition_check_result)
                                 {
-                                    /* Codes_SRS_CLDS_SORTED_LIST_04_001: [ If condition_check_func is not NULL it shall be called passing condition_check_context and the new and old keys. ]*/
-                                    CLDS_CONDITION_CHECK_RESULT condition_check_result = condition_check_func(condition_check_context, new_item_key, current_item_key);
-                                    switch (condition_check_result)
+                                    case CLDS_CONDITION_CHECK_RESULT_INVALID:
+                                    case CLDS_CONDITION_CHECK_ERROR:
                                     {
-                                        case CLDS_CONDITION_CHECK_RESULT_INVALID:
-                                        case CLDS_CONDITION_CHECK_ERROR:
+                                        LogError("Condition check failed - %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_CONDITION_CHECK_RESULT, condition_check_result));
+                                        if (previous_hp != NULL)
                                         {
-                                            LogError("Condition check failed - %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_CONDITION_CHECK_RESULT, condition_check_result));
-                                            if (previous_hp != NULL)
-                                            {
-                                                // let go of previous hazard pointer
-                                                clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                            }
+                                            // let go of previous hazard pointer
+                                            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                        }
 
-                                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
 
-                                            /* Codes_SRS_CLDS_SORTED_LIST_04_002: [ If condition_check_func returns CLDS_CONDITION_CHECK_ERROR then clds_sorted_list_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
-                                            result = CLDS_SORTED_LIST_SET_VALUE_ERROR;
+                                        /* Codes_SRS_CLDS_SORTED_LIST_04_002: [ If condition_check_func returns CLDS_CONDITION_CHECK_ERROR then clds_sorted_list_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
+                                        result = CLDS_SORTED_LIST_SET_VALUE_ERROR;
 
-                                            break;
-                                        }
+                                        break;
+                                    }
 
-                                        case CLDS_CONDITION_CHECK_NOT_MET:
+                                    case CLDS_CONDITION_CHECK_NOT_MET:
+                                    {
+                                        LogError("Condition check not met - %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_CONDITION_CHECK_RESULT, condition_check_result));
+                                        if (previous_hp != NULL)
                                         {
-                                            LogError("Condition check not met - %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_CONDITION_CHECK_RESULT, condition_check_result));
-                                            if (previous_hp != NULL)
-                                            {
-                                                // let go of previous hazard pointer
-                                                clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                            }
-
-                                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                            // let go of previous hazard pointer
+                                            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                        }
 
-                                            /* Codes_SRS_CLDS_SORTED_LIST_04_003: [ If condition_check_func returns CLDS_CONDITION_CHECK_NOT_MET then clds_sorted_list_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET. ]*/
-                                            result = CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET;
+                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
 
-                                            break;
-                                        }
+                                        /* Codes_SRS_CLDS_SORTED_LIST_04_003: [ If condition_check_func returns CLDS_CONDITION_CHECK_NOT_MET then clds_sorted_list_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET. ]*/
+                                        result = CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET;
 
-                                        case CLDS_CONDITION_CHECK_OK:
-                                        {
-                                            /* Nothing to do. Life continues like normal. */
-                                            break;
-                                        }
+                                        break;
                                     }
 
-                                    /* Codes_SRS_CLDS_SORTED_LIST_04_004: [ If condition_check_func returns CLDS_CONDITION_CHECK_OK then clds_sorted_list_set_value continues. ]*/
-                                    if (condition_check_result != CLDS_CONDITION_CHECK_OK)
+                                    case CLDS_CONDITION_CHECK_OK:
                                     {
-                                        restart_needed = false;
+                                        /* Nothing to do. Life continues like normal. */
                                         break;
                                     }
                                 }
 
-                                /* Codes_SRS_CLDS_SORTED_LIST_01_088: [ If the key entry exists in the list, its value shall be replaced with new_item. ]*/
+                                /* Codes_SRS_CLDS_SORTED_LIST_04_004: [ If condition_check_func returns CLDS_CONDITION_CHECK_OK then clds_sorted_list_set_value continues. ]*/
+                                if (condition_check_result != CLDS_CONDITION_CHECK_OK)
+                                {
+                                    restart_needed = false;
+                                    break;
+                                }
+                            }
+
+                            /* Codes_SRS_CLDS_SORTED_LIST_01_088: [ If the key entry exists in the list, its value shall be replaced with new_item. ]*/
+
+                            CLDS_SORTED_LIST_ITEM* volatile_atomic current_next = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, NULL, NULL);
+
+                            // clear any delete lock bit from what we read
+                            current_next = (void*)((uintptr_t)current_next & ~0x1);
+
+                            if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, (void*)((uintptr_t)current_next | 0x1), (void*)current_next) != (void*)current_next)
+                            {
+                                if (previous_item != NULL)
+                                {
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                }
+
+                                clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                restart_needed = true;
+                                break;
+                            }
+
+                            if (clds_sorted_list->sequence_number != NULL)
+                            {
+                                if (interlocked_add_64(clds_sorted_list->sequence_number, 0) != insert_seq_no)
+                                {
+                                    if (clds_sorted_list->skipped_seq_no_cb != NULL)
+                                    {
+                                        clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, insert_seq_no);
+                                    }
 
-                                CLDS_SORTED_LIST_ITEM* volatile_atomic current_next = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, NULL, NULL);
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_090: [ For each set value the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
+                                    insert_seq_no = interlocked_increment_64(clds_sorted_list->sequence_number);
 
-                                // clear any delete lock bit from what we read
-                                current_next = (void*)((uintptr_t)current_next & ~0x1);
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_092: [ If the sequence_number argument passed to clds_sorted_list_set_value is NULL, the computed sequence number for the remove shall still be computed but it shall not be provided to the user. ]*/
+                                    if (sequence_number != NULL)
+                                    {
+                                        *sequence_number = insert_seq_no;
+                                    }
+                                }
+                            }
 
-                                if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, (void*)((uintptr_t)current_next | 0x1), (void*)current_next) != (void*)current_next)
+                            // same item!, locked, noone changes it now, so we can set the seq no.
+                            if (current_item == new_item)
+                            {
+                                if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, (void*)current_next, (void*)((uintptr_t)current_next | 0x1)) != (void*)((uintptr_t)current_next | 0x1))
                                 {
+                                    LogError("This should not happen");
                                     if (previous_item != NULL)
                                     {
                                         clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                                     }
 
                                     clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                                    restart_needed = true;
+                                    restart_needed = false;
+
+                                    result = CLDS_SORTED_LIST_SET_VALUE_ERROR;
+
                                     break;
                                 }
-
-                                if (clds_sorted_list->sequence_number != NULL)
+                                else
                                 {
-                                    if (interlocked_add_64(clds_sorted_list->sequence_number, 0) != insert_seq_no)
+                                    if (previous_item != NULL)
                                     {
-                                        if (clds_sorted_list->skipped_seq_no_cb != NULL)
-                                        {
-                                            clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, insert_seq_no);
-                                        }
+                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                    }
 
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_090: [ For each set value the order of the operation shall be computed based on the start sequence number passed to clds_sorted_list_create. ]*/
-                                        insert_seq_no = interlocked_increment_64(clds_sorted_list->sequence_number);
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
 
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_092: [ If the sequence_number argument passed to clds_sorted_list_set_value is NULL, the computed sequence number for the remove shall still be computed but it shall not be provided to the user. ]*/
-                                        if (sequence_number != NULL)
-                                        {
-                                            *sequence_number = insert_seq_no;
-                                        }
-                                    }
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_089: [ The previous value shall be returned in old_item. ]*/
+                                    *old_item = (CLDS_SORTED_LIST_ITEM*)current_item;
+
+                                    // no need to inc_ref or similar as the item is going to be held in the list
+
+                                    restart_needed = false;
+
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_080: [ clds_sorted_list_set_value shall replace in the list the item that matches the criteria given by the compare function passed to clds_sorted_list_create with new_item and on success it shall return CLDS_SORTED_LIST_SET_VALUE_OK. ]*/
+                                    result = CLDS_SORTED_LIST_SET_VALUE_OK;
+
+                                    break;
                                 }
+                            }
+
+                            // set the new_item->next to point to the next item in the list
+                            new_item->next = current_next;
 
-                                // same item!, locked, noone changes it now, so we can set the seq no.
-                                if (current_item == new_item)
+                            // now its locked, no insert/delete should be happening on current->next
+                            if (previous_item != NULL)
+                            {
+                                // have a previous item
+                                if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&previous_item->next, (void*)new_item, (void*)current_item) != current_item)
                                 {
                                     if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, (void*)current_next, (void*)((uintptr_t)current_next | 0x1)) != (void*)((uintptr_t)current_next | 0x1))
                                     {
                                         LogError("This should not happen");
-                                        if (previous_item != NULL)
-                                        {
-                                            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                        }
-
+                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                                         clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
                                         restart_needed = false;
-
                                         result = CLDS_SORTED_LIST_SET_VALUE_ERROR;
-
                                         break;
                                     }
                                     else
                                     {
-                                        if (previous_item != NULL)
-                                        {
-                                            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                        }
-
+                                        // let go of previous hazard pointer
+                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
                                         clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                        restart_needed = true;
+                                        break;
+                                    }
+                                }
+                                else
+                                {
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                    restart_needed = false;
 
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_089: [ The previous value shall be returned in old_item. ]*/
-                                        *old_item = (CLDS_SORTED_LIST_ITEM*)current_item;
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_089: [ The previous value shall be returned in old_item. ]*/
+                                    *old_item = (CLDS_SORTED_LIST_ITEM*)current_item;
+                                    (void)clds_sorted_list_node_inc_ref(*old_item);
 
-                                        // no need to inc_ref or similar as the item is going to be held in the list
+                                    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, current_item, reclaim_list_node);
 
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_080: [ clds_sorted_list_set_value shall replace in the list the item that matches the criteria given by the compare function passed to clds_sorted_list_create with new_item and on success it shall return CLDS_SORTED_LIST_SET_VALUE_OK. ]*/
+                                    result = CLDS_SORTED_LIST_SET_VALUE_OK;
+                                    break;
+                                }
+                            }
+                            else
+                            {
+                                if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&list_head->head, (void*)new_item, (void*)current_item) != current_item)
+                                {
+                                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, (void*)current_next, (void*)((uintptr_t)current_next | 0x1)) != (void*)((uintptr_t)current_next | 0x1))
+                                    {
+                                        LogError("This should not happen");
+                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
                                         restart_needed = false;
-
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_080: [ clds_sorted_list_set_value shall replace in the list the item that matches the criteria given by the compare function passed to clds_sorted_list_create with new_item and on success it shall return CLDS_SORTED_LIST_SET_VALUE_OK. ]*/
-                                        result = CLDS_SORTED_LIST_SET_VALUE_OK;
-
+                                        result = CLDS_SORTED_LIST_SET_VALUE_ERROR;
+                                        break;
+                                    }
+                                    else
+                                    {
+                                        // let go of previous hazard pointer
+                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                        restart_needed = true;
                                         break;
                                     }
                                 }
+                                else
+                                {
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                    restart_needed = false;
+
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_089: [ The previous value shall be returned in old_item. ]*/
+                                    *old_item = (CLDS_SORTED_LIST_ITEM*)current_item;
+                                    (void)clds_sorted_list_node_inc_ref(*old_item);
+
+                                    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, current_item, reclaim_list_node);
+
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_080: [ clds_sorted_list_set_value shall replace in the list the item that matches the criteria given by the compare function passed to clds_sorted_list_create with new_item and on success it shall return CLDS_SORTED_LIST_SET_VALUE_OK. ]*/
+                                    result = CLDS_SORTED_LIST_SET_VALUE_OK;
+                                    break;
+                                }
+
+                            }
+
+                            break;
+                        }
+                        else if (compare_result < 0)
+                        {
+                            if (only_if_exists)
+                            {
+                                if (previous_item != NULL)
+                                {
+                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                }
 
-                                // set the new_item->next to point to the next item in the list
-                                new_item->next = current_next;
+                                clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_093: [ If the key entry does not exist and only_if_exists is true, clds_sorted_list_set_value shall return CLDS_SORTED_LIST_SET_VALUE_NOT_FOUND. ]*/
+                                result = CLDS_SORTED_LIST_SET_VALUE_NOT_FOUND;
+                                restart_needed = false;
+                                break;
+                            }
+                            else
+                            {
+                                // need to insert between these 2 nodes
+                                new_item->next = current_item;
 
-                                // now its locked, no insert/delete should be happening on current->next
                                 if (previous_item != NULL)
                                 {
                                     // have a previous item
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_087: [ If the key entry does not exist in the list and only_if_exists is false, new_item shall be inserted at the key position. ]*/
                                     if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&previous_item->next, (void*)new_item, (void*)current_item) != current_item)
                                     {
-                                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, (void*)current_next, (void*)((uintptr_t)current_next | 0x1)) != (void*)((uintptr_t)current_next | 0x1))
-                                        {
-                                            LogError("This should not happen");
-                                            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                                            restart_needed = false;
-                                            result = CLDS_SORTED_LIST_SET_VALUE_ERROR;
-                                            break;
-                                        }
-                                        else
-                                        {
-                                            // let go of previous hazard pointer
-                                            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                                            restart_needed = true;
-                                            break;
-                                        }
+                                        // let go of previous hazard pointer
+                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                        restart_needed = true;
+                                        break;
                                     }
                                     else
                                     {
@@ -1583,10 +1772,7 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
                                         restart_needed = false;
 
                                         /* Codes_SRS_CLDS_SORTED_LIST_01_089: [ The previous value shall be returned in old_item. ]*/
-                                        *old_item = (CLDS_SORTED_LIST_ITEM*)current_item;
-                                        (void)clds_sorted_list_node_inc_ref(*old_item);
-
-                                        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
+                                        *old_item = NULL;
 
                                         /* Codes_SRS_CLDS_SORTED_LIST_01_080: [ clds_sorted_list_set_value shall replace in the list the item that matches the criteria given by the compare function passed to clds_sorted_list_create with new_item and on success it shall return CLDS_SORTED_LIST_SET_VALUE_OK. ]*/
                                         result = CLDS_SORTED_LIST_SET_VALUE_OK;
@@ -1595,23 +1781,13 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
                                 }
                                 else
                                 {
-                                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_sorted_list->head, (void*)new_item, (void*)current_item) != current_item)
+                                    /* Codes_SRS_CLDS_SORTED_LIST_01_087: [ If the key entry does not exist in the list and only_if_exists is false, new_item shall be inserted at the key position. ]*/
+                                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&list_head->head, (void*)new_item, (void*)current_item) != current_item)
                                     {
-                                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, (void*)current_next, (void*)((uintptr_t)current_next | 0x1)) != (void*)((uintptr_t)current_next | 0x1))
-                                        {
-                                            LogError("This should not happen");
-                                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                                            restart_needed = false;
-                                            result = CLDS_SORTED_LIST_SET_VALUE_ERROR;
-                                            break;
-                                        }
-                                        else
-                                        {
-                                            // let go of previous hazard pointer
-                                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                                            restart_needed = true;
-                                            break;
-                                        }
+                                        // let go of previous hazard pointer
+                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                        restart_needed = true;
+                                        break;
                                     }
                                     else
                                     {
@@ -1619,122 +1795,75 @@ CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HA
                                         restart_needed = false;
 
                                         /* Codes_SRS_CLDS_SORTED_LIST_01_089: [ The previous value shall be returned in old_item. ]*/
-                                        *old_item = (CLDS_SORTED_LIST_ITEM*)current_item;
-                                        (void)clds_sorted_list_node_inc_ref(*old_item);
-
-                                        clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, (void*)current_item, reclaim_list_node);
+                                        *old_item = NULL;
 
                                         /* Codes_SRS_CLDS_SORTED_LIST_01_080: [ clds_sorted_list_set_value shall replace in the list the item that matches the criteria given by the compare function passed to clds_sorted_list_create with new_item and on success it shall return CLDS_SORTED_LIST_SET_VALUE_OK. ]*/
                                         result = CLDS_SORTED_LIST_SET_VALUE_OK;
                                         break;
                                     }
-
                                 }
-
-                                break;
                             }
-                            else if (compare_result < 0)
+                        }
+                        else // item is less than the current, so move on
+                        {
+                            // we have a stable pointer to the current item, now simply set the previous to be this
+                            if (previous_hp != NULL)
                             {
-                                if (only_if_exists)
-                                {
-                                    if (previous_item != NULL)
-                                    {
-                                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                    }
+                                // let go of previous hazard pointer
+                                clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                            }
 
-                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                            previous_hp = current_item_hp;
+                            previous_item = current_item;
+                            current_item_address = (volatile_atomic CLDS_SORTED_LIST_ITEM**)&current_item->next;
+                        }
+                    }
+                }
+            }
+        } while (1);
+    } while (restart_needed);
 
-                                    /* Codes_SRS_CLDS_SORTED_LIST_01_093: [ If the key entry does not exist and only_if_exists is true, clds_sorted_list_set_value shall return CLDS_SORTED_LIST_SET_VALUE_NOT_FOUND. ]*/
-                                    result = CLDS_SORTED_LIST_SET_VALUE_NOT_FOUND;
-                                    restart_needed = false;
-                                    break;
-                                }
-                                else
-                                {
-                                    // need to insert between these 2 nodes
-                                    new_item->next = current_item;
-
-                                    if (previous_item != NULL)
-                                    {
-                                        // have a previous item
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_087: [ If the key entry does not exist in the list and only_if_exists is false, new_item shall be inserted at the key position. ]*/
-                                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&previous_item->next, (void*)new_item, (void*)current_item) != current_item)
-                                        {
-                                            // let go of previous hazard pointer
-                                            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                                            restart_needed = true;
-                                            break;
-                                        }
-                                        else
-                                        {
-                                            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                                            restart_needed = false;
-
-                                            /* Codes_SRS_CLDS_SORTED_LIST_01_089: [ The previous value shall be returned in old_item. ]*/
-                                            *old_item = NULL;
+    /*Codes_SRS_CLDS_SORTED_LIST_42_029: [ clds_sorted_list_set_value shall decrement the count of pending write operations. ]*/
+    end_write_operation(clds_sorted_list);
 
-                                            /* Codes_SRS_CLDS_SORTED_LIST_01_080: [ clds_sorted_list_set_value shall replace in the list the item that matches the criteria given by the compare function passed to clds_sorted_list_create with new_item and on success it shall return CLDS_SORTED_LIST_SET_VALUE_OK. ]*/
-                                            result = CLDS_SORTED_LIST_SET_VALUE_OK;
-                                            break;
-                                        }
-                                    }
-                                    else
-                                    {
-                                        /* Codes_SRS_CLDS_SORTED_LIST_01_087: [ If the key entry does not exist in the list and only_if_exists is false, new_item shall be inserted at the key position. ]*/
-                                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_sorted_list->head, (void*)new_item, (void*)current_item) != current_item)
-                                        {
-                                            // let go of previous hazard pointer
-                                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                                            restart_needed = true;
-                                            break;
-                                        }
-                                        else
-                                        {
-                                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
-                                            restart_needed = false;
-
-                                            /* Codes_SRS_CLDS_SORTED_LIST_01_089: [ The previous value shall be returned in old_item. ]*/
-                                            *old_item = NULL;
-
-                                            /* Codes_SRS_CLDS_SORTED_LIST_01_080: [ clds_sorted_list_set_value shall replace in the list the item that matches the criteria given by the compare function passed to clds_sorted_list_create with new_item and on success it shall return CLDS_SORTED_LIST_SET_VALUE_OK. ]*/
-                                            result = CLDS_SORTED_LIST_SET_VALUE_OK;
-                                            break;
-                                        }
-                                    }
-                                }
-                            }
-                            else // item is less than the current, so move on
-                            {
-                                // we have a stable pointer to the current item, now simply set the previous to be this
-                                if (previous_hp != NULL)
-                                {
-                                    // let go of previous hazard pointer
-                                    clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
-                                }
+    if (result != CLDS_SORTED_LIST_SET_VALUE_OK)
+    {
+        // the insert as part of set value did not really materialize
+        if (clds_sorted_list->skipped_seq_no_cb != NULL)
+        {
+            clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, insert_seq_no);
+        }
+    }
 
-                                previous_hp = current_item_hp;
-                                previous_item = current_item;
-                                current_item_address = (volatile_atomic CLDS_SORTED_LIST_ITEM**)&current_item->next;
-                            }
-                        }
-                    }
-                }
-            } while (1);
-        } while (restart_needed);
+    return result;
+}
 
-        /*Codes_SRS_CLDS_SORTED_LIST_42_029: [ clds_sorted_list_set_value shall decrement the count of pending write operations. ]*/
-        end_write_operation(clds_sorted_list);
+CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_set_value(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SORTED_LIST_ITEM* new_item, CONDITION_CHECK_CB condition_check_func, void* condition_check_context, CLDS_SORTED_LIST_ITEM** old_item, int64_t* sequence_number, bool only_if_exists)
+{
+    CLDS_SORTED_LIST_SET_VALUE_RESULT result;
 
-        if (result != CLDS_SORTED_LIST_SET_VALUE_OK)
-        {
-            // the insert as part of set value did not really materialize
-            if (clds_sorted_list->skipped_seq_no_cb != NULL)
-            {
-                clds_sorted_list->skipped_seq_no_cb(clds_sorted_list->skipped_seq_no_cb_context, insert_seq_no);
-            }
-        }
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_081: [ If clds_sorted_list is NULL, clds_sorted_list_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_082: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_083: [ If key is NULL, clds_sorted_list_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_084: [ If new_item is NULL, clds_sorted_list_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
+        (new_item == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_085: [ If old_item is NULL, clds_sorted_list_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
+        (old_item == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_086: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_sorted_list->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_SORTED_LIST_ITEM* new_item=%p, CONDITION_CHECK_CB condition_check_func=%p, void* condition_check_context=%p, CLDS_SORTED_LIST_ITEM** old_item=%p, int64_t* sequence_number=%p",
+            clds_sorted_list, clds_hazard_pointers_thread, key, new_item, condition_check_func, condition_check_context, old_item, sequence_number);
+        result = CLDS_SORTED_LIST_SET_VALUE_ERROR;
+    }
+    else
+    {
+        result = internal_set_value(clds_sorted_list, &clds_sorted_list->list_head, clds_hazard_pointers_thread, key, new_item, condition_check_func, condition_check_context, old_item, sequence_number, only_if_exists);
     }
 
     return result;
@@ -1766,6 +1895,38 @@ void clds_sorted_list_unlock_writes(CLDS_SORTED_LIST_HANDLE clds_sorted_list)
     }
 }
 
+static CLDS_SORTED_LIST_GET_COUNT_RESULT internal_get_count(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t* item_count)
+{
+    CLDS_SORTED_LIST_GET_COUNT_RESULT result;
+
+    if (interlocked_add(&clds_sorted_list->locked_for_write, 0) == 0)
+    {
+        /*Codes_SRS_CLDS_SORTED_LIST_42_038: [ If the counter to lock the list for writes is 0 then clds_sorted_list_get_count shall fail and return CLDS_SORTED_LIST_GET_COUNT_NOT_LOCKED. ]*/
+        LogError("Must lock the list before getting the count of items");
+        result = CLDS_SORTED_LIST_GET_COUNT_NOT_LOCKED;
+    }
+    else
+    {
+        /*Codes_SRS_CLDS_SORTED_LIST_42_039: [ clds_sorted_list_get_count shall iterate over the items in the list and count them in item_count. ]*/
+        uint64_t count = 0;
+        CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&list_head->head, NULL, NULL);
+
+        while (current_item != NULL)
+        {
+            count++;
+            CLDS_SORTED_LIST_ITEM* next_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, NULL, NULL);
+            current_item = next_item;
+        }
+
+        *item_count = count;
+
+        /*Codes_SRS_CLDS_SORTED_LIST_42_040: [ clds_sorted_list_get_count shall succeed and return CLDS_SORTED_LIST_GET_COUNT_OK. ]*/
+        result = CLDS_SORTED_LIST_GET_COUNT_OK;
+    }
+
+    return result;
+}
+
 CLDS_SORTED_LIST_GET_COUNT_RESULT clds_sorted_list_get_count(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t* item_count)
 {
     CLDS_SORTED_LIST_GET_COUNT_RESULT result;
@@ -1786,29 +1947,73 @@ CLDS_SORTED_LIST_GET_COUNT_RESULT clds_sorted_list_get_count(CLDS_SORTED_LIST_HA
     }
     else
     {
-        if (interlocked_add(&clds_sorted_list->locked_for_write, 0) == 0)
-        {
-            /*Codes_SRS_CLDS_SORTED_LIST_42_038: [ If the counter to lock the list for writes is 0 then clds_sorted_list_get_count shall fail and return CLDS_SORTED_LIST_GET_COUNT_NOT_LOCKED. ]*/
-            LogError("Must lock the list before getting the count of items");
-            result = CLDS_SORTED_LIST_GET_COUNT_NOT_LOCKED;
-        }
-        else
+        result = internal_get_count(clds_sorted_list, &clds_sorted_list->list_head, clds_hazard_pointers_thread, item_count);
+    }
+
+    return result;
+}
+
+static CLDS_SORTED_LIST_GET_ALL_RESULT internal_get_all(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t item_count, CLDS_SORTED_LIST_ITEM** items)
+{
+    CLDS_SORTED_LIST_GET_ALL_RESULT result;
+
+    if (interlocked_add(&clds_sorted_list->locked_for_write, 0) == 0)
+    {
+        /*Codes_SRS_CLDS_SORTED_LIST_42_045: [ If the counter to lock the list for writes is 0 then clds_sorted_list_get_all shall fail and return CLDS_SORTED_LIST_GET_ALL_NOT_LOCKED. ]*/
+        LogError("Must lock the list before getting all items");
+        result = CLDS_SORTED_LIST_GET_ALL_NOT_LOCKED;
+    }
+    else
+    {
+        result = CLDS_SORTED_LIST_GET_ALL_OK;
+
+        /*Codes_SRS_CLDS_SORTED_LIST_42_046: [ For each item in the list: ]*/
+        uint64_t current_index = 0;
+        CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&list_head->head, NULL, NULL);
+
+        while (current_item != NULL)
         {
-            /*Codes_SRS_CLDS_SORTED_LIST_42_039: [ clds_sorted_list_get_count shall iterate over the items in the list and count them in item_count. ]*/
-            uint64_t count = 0;
-            CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_sorted_list->head, NULL, NULL);
+            CLDS_SORTED_LIST_ITEM* next_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, NULL, NULL);
 
-            while (current_item != NULL)
+            if (current_index + 1 > item_count)
             {
-                count++;
-                CLDS_SORTED_LIST_ITEM* next_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, NULL, NULL);
-                current_item = next_item;
+                /*Codes_SRS_CLDS_SORTED_LIST_42_049: [ If item_count does not match the number of items in the list then clds_sorted_list_get_all shall fail and return CLDS_SORTED_LIST_GET_ALL_WRONG_SIZE. ]*/
+                LogError("Attempted to get all items with array of size %" PRIu64 ", but there were at least %" PRIu64 " items in the list (too small)",
+                    item_count, current_index + 1);
+                result = CLDS_SORTED_LIST_GET_ALL_WRONG_SIZE;
+                break;
             }
 
-            *item_count = count;
+            /*Codes_SRS_CLDS_SORTED_LIST_42_047: [ clds_sorted_list_get_all shall increment the ref count. ]*/
+            (void)clds_sorted_list_node_inc_ref(current_item);
 
-            /*Codes_SRS_CLDS_SORTED_LIST_42_040: [ clds_sorted_list_get_count shall succeed and return CLDS_SORTED_LIST_GET_COUNT_OK. ]*/
-            result = CLDS_SORTED_LIST_GET_COUNT_OK;
+            /*Codes_SRS_CLDS_SORTED_LIST_42_048: [ clds_sorted_list_get_all shall store the pointer in items. ]*/
+            items[current_index] = current_item;
+
+            current_index++;
+            current_item = next_item;
+        }
+
+        if (current_item != NULL || current_index != item_count)
+        {
+            if (current_index < item_count)
+            {
+                /*Codes_SRS_CLDS_SORTED_LIST_42_049: [ If item_count does not match the number of items in the list then clds_sorted_list_get_all shall fail and return CLDS_SORTED_LIST_GET_ALL_WRONG_SIZE. ]*/
+                LogError("Attempted to get all items with array of size %" PRIu64 ", but there were %" PRIu64 " items in the list (too large)",
+                    item_count, current_index);
+                result = CLDS_SORTED_LIST_GET_ALL_WRONG_SIZE;
+            }
+
+            for (uint64_t i = 0; i < current_index; ++i)
+            {
+                clds_sorted_list_node_release(items[i]);
+                items[i] = NULL;
+            }
+        }
+        else
+        {
+            /*Codes_SRS_CLDS_SORTED_LIST_42_050: [ clds_sorted_list_get_all shall succeed and return CLDS_SORTED_LIST_GET_ALL_OK. ]*/
+            result = CLDS_SORTED_LIST_GET_ALL_OK;
         }
     }
 
@@ -1837,70 +2042,505 @@ CLDS_SORTED_LIST_GET_ALL_RESULT clds_sorted_list_get_all(CLDS_SORTED_LIST_HANDLE
     }
     else
     {
-        if (interlocked_add(&clds_sorted_list->locked_for_write, 0) == 0)
-        {
-            /*Codes_SRS_CLDS_SORTED_LIST_42_045: [ If the counter to lock the list for writes is 0 then clds_sorted_list_get_all shall fail and return CLDS_SORTED_LIST_GET_ALL_NOT_LOCKED. ]*/
-            LogError("Must lock the list before getting all items");
-            result = CLDS_SORTED_LIST_GET_ALL_NOT_LOCKED;
-        }
-        else
+        result = internal_get_all(clds_sorted_list, &clds_sorted_list->list_head, clds_hazard_pointers_thread, item_count, items);
+    }
+
+    return result;
+}
+
+CLDS_SORTED_LIST_INSERT_RESULT clds_sorted_list_head_insert(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM* item, int64_t* sequence_number)
+{
+    CLDS_SORTED_LIST_INSERT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_094: [ If clds_sorted_list is NULL, clds_sorted_list_head_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_095: [ If list_head is NULL, clds_sorted_list_head_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (list_head == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_096: [ If item is NULL, clds_sorted_list_head_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (item == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_097: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_head_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_098: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_head_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_sorted_list->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_SORTED_LIST_HEAD* list_head=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_SORTED_LIST_ITEM* item=%p, int64_t* sequence_number=%p",
+            clds_sorted_list, list_head, clds_hazard_pointers_thread, item, sequence_number);
+        result = CLDS_SORTED_LIST_INSERT_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_01_099: [ Otherwise clds_sorted_list_head_insert shall insert item in the items linked to list_head the same way clds_sorted_list_insert does, using the callbacks, sequence number and write lock of clds_sorted_list. ]*/
+        result = internal_insert(clds_sorted_list, list_head, clds_hazard_pointers_thread, item, NULL, NULL, NULL, NULL, sequence_number);
+    }
+
+    return result;
+}
+
+CLDS_SORTED_LIST_INSERT_RESULT clds_sorted_list_head_get_or_insert(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, SORTED_LIST_ITEM_FACTORY_CB item_factory, void* item_factory_context, CLDS_SORTED_LIST_ITEM** item, int64_t* sequence_number)
+{
+    CLDS_SORTED_LIST_INSERT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_160: [ If clds_sorted_list is NULL, clds_sorted_list_head_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_161: [ If list_head is NULL, clds_sorted_list_head_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (list_head == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_162: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_head_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_163: [ If key, item_factory or item is NULL, clds_sorted_list_head_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        (key == NULL) ||
+        (item_factory == NULL) ||
+        (item == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_164: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_head_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_sorted_list->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_SORTED_LIST_HEAD* list_head=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, SORTED_LIST_ITEM_FACTORY_CB item_factory=%p, void* item_factory_context=%p, CLDS_SORTED_LIST_ITEM** item=%p, int64_t* sequence_number=%p",
+            clds_sorted_list, list_head, clds_hazard_pointers_thread, key, item_factory, item_factory_context, item, sequence_number);
+        result = CLDS_SORTED_LIST_INSERT_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_01_165: [ Otherwise clds_sorted_list_head_get_or_insert shall look for key in the items linked to list_head and insert a new item at its position in the same pass, the same way clds_sorted_list_head_insert does. ]*/
+        result = internal_insert(clds_sorted_list, list_head, clds_hazard_pointers_thread, NULL, key, item_factory, item_factory_context, item, sequence_number);
+    }
+
+    return result;
+}
+
+CLDS_SORTED_LIST_DELETE_RESULT clds_sorted_list_head_delete_item(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM* item, int64_t* sequence_number)
+{
+    CLDS_SORTED_LIST_DELETE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_100: [ If clds_sorted_list is NULL, clds_sorted_list_head_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_101: [ If list_head is NULL, clds_sorted_list_head_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        (list_head == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_102: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_head_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_103: [ If item is NULL, clds_sorted_list_head_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        (item == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_104: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_head_delete_item shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_sorted_list->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_SORTED_LIST_HEAD* list_head=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_SORTED_LIST_ITEM* item=%p, int64_t* sequence_number=%p",
+            clds_sorted_list, list_head, clds_hazard_pointers_thread, item, sequence_number);
+        result = CLDS_SORTED_LIST_DELETE_ERROR;
+    }
+    else
+    {
+        check_lock_and_begin_write_operation(clds_sorted_list);
+
+        /* Codes_SRS_CLDS_SORTED_LIST_01_105: [ Otherwise clds_sorted_list_head_delete_item shall delete item from the items linked to list_head the same way clds_sorted_list_delete_item does, using the callbacks, sequence number and write lock of clds_sorted_list. ]*/
+        result = internal_delete(clds_sorted_list, list_head, clds_hazard_pointers_thread, compare_item_by_ptr, item, sequence_number);
+
+        end_write_operation(clds_sorted_list);
+    }
+
+    return result;
+}
+
+CLDS_SORTED_LIST_DELETE_RESULT clds_sorted_list_head_delete_key(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, int64_t* sequence_number)
+{
+    CLDS_SORTED_LIST_DELETE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_106: [ If clds_sorted_list is NULL, clds_sorted_list_head_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_107: [ If list_head is NULL, clds_sorted_list_head_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        (list_head == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_108: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_head_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_109: [ If key is NULL, clds_sorted_list_head_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_110: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_head_delete_key shall fail and return CLDS_SORTED_LIST_DELETE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_sorted_list->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_SORTED_LIST_HEAD* list_head=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, int64_t* sequence_number=%p",
+            clds_sorted_list, list_head, clds_hazard_pointers_thread, key, sequence_number);
+        result = CLDS_SORTED_LIST_DELETE_ERROR;
+    }
+    else
+    {
+        check_lock_and_begin_write_operation(clds_sorted_list);
+
+        /* Codes_SRS_CLDS_SORTED_LIST_01_111: [ Otherwise clds_sorted_list_head_delete_key shall delete the item with the given key from the items linked to list_head the same way clds_sorted_list_delete_key does, using the callbacks, sequence number and write lock of clds_sorted_list. ]*/
+        result = internal_delete(clds_sorted_list, list_head, clds_hazard_pointers_thread, compare_item_by_key, key, sequence_number);
+
+        end_write_operation(clds_sorted_list);
+    }
+
+    return result;
+}
+
+CLDS_SORTED_LIST_REMOVE_RESULT clds_sorted_list_head_remove_key(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SORTED_LIST_ITEM** item, int64_t* sequence_number)
+{
+    CLDS_SORTED_LIST_REMOVE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_112: [ If clds_sorted_list is NULL, clds_sorted_list_head_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_113: [ If list_head is NULL, clds_sorted_list_head_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
+        (list_head == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_114: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_head_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_115: [ If key is NULL, clds_sorted_list_head_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_116: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_head_remove_key shall fail and return CLDS_SORTED_LIST_REMOVE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_sorted_list->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_SORTED_LIST_HEAD* list_head=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_SORTED_LIST_ITEM** item=%p, int64_t* sequence_number=%p",
+            clds_sorted_list, list_head, clds_hazard_pointers_thread, key, item, sequence_number);
+        result = CLDS_SORTED_LIST_REMOVE_ERROR;
+    }
+    else
+    {
+        check_lock_and_begin_write_operation(clds_sorted_list);
+
+        /* Codes_SRS_CLDS_SORTED_LIST_01_117: [ Otherwise clds_sorted_list_head_remove_key shall remove the item with the given key from the items linked to list_head the same way clds_sorted_list_remove_key does, using the callbacks, sequence number and write lock of clds_sorted_list. ]*/
+        result = internal_remove(clds_sorted_list, list_head, clds_hazard_pointers_thread, compare_item_by_key, key, item, sequence_number);
+
+        end_write_operation(clds_sorted_list);
+    }
+
+    return result;
+}
+
+CLDS_SORTED_LIST_ITEM* clds_sorted_list_head_find_key(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+{
+    CLDS_SORTED_LIST_ITEM* result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_118: [ If clds_sorted_list is NULL, clds_sorted_list_head_find_key shall fail and return NULL. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_119: [ If list_head is NULL, clds_sorted_list_head_find_key shall fail and return NULL. ]*/
+        (list_head == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_120: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_head_find_key shall fail and return NULL. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_121: [ If key is NULL, clds_sorted_list_head_find_key shall fail and return NULL. ]*/
+        (key == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_SORTED_LIST_HEAD* list_head=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p",
+            clds_sorted_list, list_head, clds_hazard_pointers_thread, key);
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_01_122: [ Otherwise clds_sorted_list_head_find_key shall find the item with the given key in the items linked to list_head the same way clds_sorted_list_find_key does, using the callbacks of clds_sorted_list. ]*/
+        result = internal_find_key(clds_sorted_list, list_head, clds_hazard_pointers_thread, key);
+    }
+
+    return result;
+}
+
+CLDS_SORTED_LIST_SET_VALUE_RESULT clds_sorted_list_head_set_value(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SORTED_LIST_ITEM* new_item, CONDITION_CHECK_CB condition_check_func, void* condition_check_context, CLDS_SORTED_LIST_ITEM** old_item, int64_t* sequence_number, bool only_if_exists)
+{
+    CLDS_SORTED_LIST_SET_VALUE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_123: [ If clds_sorted_list is NULL, clds_sorted_list_head_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_124: [ If list_head is NULL, clds_sorted_list_head_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
+        (list_head == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_125: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_head_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_126: [ If key is NULL, clds_sorted_list_head_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_127: [ If new_item is NULL, clds_sorted_list_head_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
+        (new_item == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_128: [ If old_item is NULL, clds_sorted_list_head_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
+        (old_item == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_129: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_head_set_value shall fail and return CLDS_SORTED_LIST_SET_VALUE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_sorted_list->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_SORTED_LIST_HEAD* list_head=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_SORTED_LIST_ITEM* new_item=%p, CONDITION_CHECK_CB condition_check_func=%p, void* condition_check_context=%p, CLDS_SORTED_LIST_ITEM** old_item=%p, int64_t* sequence_number=%p",
+            clds_sorted_list, list_head, clds_hazard_pointers_thread, key, new_item, condition_check_func, condition_check_context, old_item, sequence_number);
+        result = CLDS_SORTED_LIST_SET_VALUE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_01_130: [ Otherwise clds_sorted_list_head_set_value shall set the value for key in the items linked to list_head the same way clds_sorted_list_set_value does, using the callbacks, sequence number and write lock of clds_sorted_list. ]*/
+        result = internal_set_value(clds_sorted_list, list_head, clds_hazard_pointers_thread, key, new_item, condition_check_func, condition_check_context, old_item, sequence_number, only_if_exists);
+    }
+
+    return result;
+}
+
+CLDS_SORTED_LIST_GET_COUNT_RESULT clds_sorted_list_head_get_count(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t* item_count)
+{
+    CLDS_SORTED_LIST_GET_COUNT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_131: [ If clds_sorted_list is NULL then clds_sorted_list_head_get_count shall fail and return CLDS_SORTED_LIST_GET_COUNT_ERROR. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_132: [ If list_head is NULL then clds_sorted_list_head_get_count shall fail and return CLDS_SORTED_LIST_GET_COUNT_ERROR. ]*/
+        (list_head == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_133: [ If clds_hazard_pointers_thread is NULL then clds_sorted_list_head_get_count shall fail and return CLDS_SORTED_LIST_GET_COUNT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_134: [ If item_count is NULL then clds_sorted_list_head_get_count shall fail and return CLDS_SORTED_LIST_GET_COUNT_ERROR. ]*/
+        (item_count == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_SORTED_LIST_HEAD* list_head=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, uint64_t* item_count=%p",
+            clds_sorted_list, list_head, clds_hazard_pointers_thread, item_count);
+        result = CLDS_SORTED_LIST_GET_COUNT_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_01_135: [ Otherwise clds_sorted_list_head_get_count shall count the items linked to list_head the same way clds_sorted_list_get_count does, which requires clds_sorted_list to be locked for writes. ]*/
+        result = internal_get_count(clds_sorted_list, list_head, clds_hazard_pointers_thread, item_count);
+    }
+
+    return result;
+}
+
+CLDS_SORTED_LIST_GET_ALL_RESULT clds_sorted_list_head_get_all(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t item_count, CLDS_SORTED_LIST_ITEM** items)
+{
+    CLDS_SORTED_LIST_GET_ALL_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_136: [ If clds_sorted_list is NULL then clds_sorted_list_head_get_all shall fail and return CLDS_SORTED_LIST_GET_ALL_ERROR. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_137: [ If list_head is NULL then clds_sorted_list_head_get_all shall fail and return CLDS_SORTED_LIST_GET_ALL_ERROR. ]*/
+        (list_head == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_138: [ If clds_hazard_pointers_thread is NULL then clds_sorted_list_head_get_all shall fail and return CLDS_SORTED_LIST_GET_ALL_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_139: [ If item_count is 0 then clds_sorted_list_head_get_all shall fail and return CLDS_SORTED_LIST_GET_ALL_ERROR. ]*/
+        (item_count == 0) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_140: [ If items is NULL then clds_sorted_list_head_get_all shall fail and return CLDS_SORTED_LIST_GET_ALL_ERROR. ]*/
+        (items == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_SORTED_LIST_HEAD* list_head=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, uint64_t item_count=%" PRIu64 ", CLDS_SORTED_LIST_ITEM* items=%p",
+            clds_sorted_list, list_head, clds_hazard_pointers_thread, item_count, items);
+        result = CLDS_SORTED_LIST_GET_ALL_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_01_141: [ Otherwise clds_sorted_list_head_get_all shall return the items linked to list_head the same way clds_sorted_list_get_all does, which requires clds_sorted_list to be locked for writes. ]*/
+        result = internal_get_all(clds_sorted_list, list_head, clds_hazard_pointers_thread, item_count, items);
+    }
+
+    return result;
+}
+
+int clds_sorted_list_head_get_first(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM** item)
+{
+    int result;
+
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_142: [ If clds_sorted_list is NULL, clds_sorted_list_head_get_first shall fail and return a non-zero value. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_143: [ If list_head is NULL, clds_sorted_list_head_get_first shall fail and return a non-zero value. ]*/
+        (list_head == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_144: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_head_get_first shall fail and return a non-zero value. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_145: [ If item is NULL, clds_sorted_list_head_get_first shall fail and return a non-zero value. ]*/
+        (item == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_SORTED_LIST_HEAD* list_head=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_SORTED_LIST_ITEM** item=%p",
+            clds_sorted_list, list_head, clds_hazard_pointers_thread, item);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        do
         {
-            result = CLDS_SORTED_LIST_GET_ALL_OK;
+            CLDS_SORTED_LIST_ITEM* first_item = (CLDS_SORTED_LIST_ITEM*)((uintptr_t)interlocked_compare_exchange_pointer((void* volatile_atomic*)&list_head->head, NULL, NULL) & ~0x1);
+            if (first_item == NULL)
+            {
+                /* Codes_SRS_CLDS_SORTED_LIST_01_146: [ If no items are linked to list_head, clds_sorted_list_head_get_first shall set item to NULL and return 0. ]*/
+                *item = NULL;
+                result = 0;
+                break;
+            }
 
-            /*Codes_SRS_CLDS_SORTED_LIST_42_046: [ For each item in the list: ]*/
-            uint64_t current_index = 0;
-            CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_sorted_list->head, NULL, NULL);
+            CLDS_HAZARD_POINTER_RECORD_HANDLE first_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, first_item);
+            if (first_item_hp == NULL)
+            {
+                /* Codes_SRS_CLDS_SORTED_LIST_01_147: [ If acquiring the hazard pointer for the first item fails, clds_sorted_list_head_get_first shall fail and return a non-zero value. ]*/
+                LogError("Cannot acquire hazard pointer");
+                result = MU_FAILURE;
+                break;
+            }
 
-            while (current_item != NULL)
+            // the item can only be used if it was not unlinked before it got protected
+            if (((uintptr_t)interlocked_compare_exchange_pointer((void* volatile_atomic*)&list_head->head, NULL, NULL) & ~0x1) == (uintptr_t)first_item)
             {
-                CLDS_SORTED_LIST_ITEM* next_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, NULL, NULL);
+                /* Codes_SRS_CLDS_SORTED_LIST_01_148: [ Otherwise clds_sorted_list_head_get_first shall set item to the first item linked to list_head, with its reference count incremented so that it can be safely used by the caller, and return 0. ]*/
+                (void)interlocked_increment(&first_item->ref_count);
+                clds_hazard_pointers_release(clds_hazard_pointers_thread, first_item_hp);
+                *item = first_item;
+                result = 0;
+                break;
+            }
 
-                if (current_index + 1 > item_count)
-                {
-                    /*Codes_SRS_CLDS_SORTED_LIST_42_049: [ If item_count does not match the number of items in the list then clds_sorted_list_get_all shall fail and return CLDS_SORTED_LIST_GET_ALL_WRONG_SIZE. ]*/
-                    LogError("Attempted to get all items with array of size %" PRIu64 ", but there were at least %" PRIu64 " items in the list (too small)",
-                        item_count, current_index + 1);
-                    result = CLDS_SORTED_LIST_GET_ALL_WRONG_SIZE;
-                    break;
-                }
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, first_item_hp);
+        } while (1);
+    }
 
-                /*Codes_SRS_CLDS_SORTED_LIST_42_047: [ clds_sorted_list_get_all shall increment the ref count. ]*/
-                (void)clds_sorted_list_node_inc_ref(current_item);
+    return result;
+}
 
-                /*Codes_SRS_CLDS_SORTED_LIST_42_048: [ clds_sorted_list_get_all shall store the pointer in items. ]*/
-                items[current_index] = current_item;
+int clds_sorted_list_head_get_next(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SORTED_LIST_ITEM** item)
+{
+    int result;
 
-                current_index++;
-                current_item = next_item;
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_152: [ If clds_sorted_list is NULL, clds_sorted_list_head_get_next shall fail and return a non-zero value. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_153: [ If list_head is NULL, clds_sorted_list_head_get_next shall fail and return a non-zero value. ]*/
+        (list_head == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_154: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_head_get_next shall fail and return a non-zero value. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_155: [ If key is NULL, clds_sorted_list_head_get_next shall fail and return a non-zero value. ]*/
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_156: [ If item is NULL, clds_sorted_list_head_get_next shall fail and return a non-zero value. ]*/
+        (item == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_SORTED_LIST_HEAD* list_head=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_SORTED_LIST_ITEM** item=%p",
+            clds_sorted_list, list_head, clds_hazard_pointers_thread, key, item);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        // the items are walked from the head like a find does, the key does not have to be in the list anymore,
+        // which is what allows the caller to go through a list that is written to at the same time
+        bool restart_needed;
+        uint64_t iteration_count = 0;
+
+        do
+        {
+            if (++iteration_count > ITERATION_COUNT_LOG_LIMIT)
+            {
+                LogInfo("clds_sorted_list_head_get_next spun for %" PRIu64 " iterations", (uint64_t)ITERATION_COUNT_LOG_LIMIT);
+                iteration_count = 0;
             }
 
-            if (current_item != NULL || current_index != item_count)
+            CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp = NULL;
+            volatile_atomic CLDS_SORTED_LIST_ITEM** current_item_address = &list_head->head;
+
+            do
             {
-                if (current_index < item_count)
+                // get the current_item value
+                CLDS_SORTED_LIST_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, NULL, NULL);
+
+                // clear any delete lock bit from what we read
+                current_item = (void*)((uintptr_t)current_item & ~0x1);
+
+                if (current_item == NULL)
                 {
-                    /*Codes_SRS_CLDS_SORTED_LIST_42_049: [ If item_count does not match the number of items in the list then clds_sorted_list_get_all shall fail and return CLDS_SORTED_LIST_GET_ALL_WRONG_SIZE. ]*/
-                    LogError("Attempted to get all items with array of size %" PRIu64 ", but there were %" PRIu64 " items in the list (too large)",
-                        item_count, current_index);
-                    result = CLDS_SORTED_LIST_GET_ALL_WRONG_SIZE;
-                }
+                    if (previous_hp != NULL)
+                    {
+                        // let go of previous hazard pointer
+                        clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                    }
 
-                for (uint64_t i = 0; i < current_index; ++i)
+                    /* Codes_SRS_CLDS_SORTED_LIST_01_157: [ If no item linked to list_head has a key greater than key, clds_sorted_list_head_get_next shall set item to NULL and return 0. ]*/
+                    *item = NULL;
+                    result = 0;
+                    restart_needed = false;
+                    break;
+                }
+                else
                 {
-                    clds_sorted_list_node_release(items[i]);
-                    items[i] = NULL;
+                    // acquire hazard pointer
+                    CLDS_HAZARD_POINTER_RECORD_HANDLE current_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, (void*)current_item);
+                    if (current_item_hp == NULL)
+                    {
+                        if (previous_hp != NULL)
+                        {
+                            // let go of previous hazard pointer
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                        }
+
+                        /* Codes_SRS_CLDS_SORTED_LIST_01_158: [ If acquiring a hazard pointer fails, clds_sorted_list_head_get_next shall fail and return a non-zero value. ]*/
+                        LogError("Cannot acquire hazard pointer");
+                        result = MU_FAILURE;
+                        restart_needed = false;
+                        break;
+                    }
+                    else
+                    {
+                        // now make sure the item has not changed
+                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)current_item_address, (void*)current_item, (void*)current_item) != (void*)current_item)
+                        {
+                            if (previous_hp != NULL)
+                            {
+                                // let go of previous hazard pointer
+                                clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                            }
+
+                            // item changed, it is likely that the node is no longer reachable, so we should not use its memory, restart
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                            restart_needed = true;
+                            break;
+                        }
+                        else
+                        {
+                            if (previous_hp != NULL)
+                            {
+                                // let go of previous hazard pointer
+                                clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                            }
+
+                            void* item_key = clds_sorted_list->get_item_key_cb(clds_sorted_list->get_item_key_cb_context, (struct CLDS_SORTED_LIST_ITEM_TAG*)current_item);
+                            if (clds_sorted_list->key_compare_cb(clds_sorted_list->key_compare_cb_context, key, item_key) < 0)
+                            {
+                                /* Codes_SRS_CLDS_SORTED_LIST_01_159: [ Otherwise clds_sorted_list_head_get_next shall set item to the first item linked to list_head whose key is greater than key, with its reference count incremented so that it can be safely used by the caller, and return 0. ]*/
+                                (void)interlocked_increment(&current_item->ref_count);
+                                clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+
+                                *item = current_item;
+                                result = 0;
+                                restart_needed = false;
+                                break;
+                            }
+                            else
+                            {
+                                // we have a stable pointer to the current item, now simply set the previous to be this
+                                previous_hp = current_item_hp;
+                                current_item_address = (volatile_atomic CLDS_SORTED_LIST_ITEM**)&current_item->next;
+                            }
+                        }
+                    }
                 }
-            }
-            else
-            {
-                /*Codes_SRS_CLDS_SORTED_LIST_42_050: [ clds_sorted_list_get_all shall succeed and return CLDS_SORTED_LIST_GET_ALL_OK. ]*/
-                result = CLDS_SORTED_LIST_GET_ALL_OK;
-            }
-        }
+            } while (1);
+        } while (restart_needed);
     }
 
     return result;
 }
 
+void clds_sorted_list_head_clear(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head)
+{
+    if (
+        /* Codes_SRS_CLDS_SORTED_LIST_01_149: [ If clds_sorted_list is NULL, clds_sorted_list_head_clear shall return. ]*/
+        (clds_sorted_list == NULL) ||
+        /* Codes_SRS_CLDS_SORTED_LIST_01_150: [ If list_head is NULL, clds_sorted_list_head_clear shall return. ]*/
+        (list_head == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SORTED_LIST_HANDLE clds_sorted_list=%p, CLDS_SORTED_LIST_HEAD* list_head=%p",
+            clds_sorted_list, list_head);
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SORTED_LIST_01_151: [ Otherwise clds_sorted_list_head_clear shall free all the items linked to list_head, calling the item_cleanup_callback of each of them, and leave list_head empty. ]*/
+        free_list_items(list_head);
+    }
+}
+
 CLDS_SORTED_LIST_ITEM* clds_sorted_list_node_create(size_t node_size, SORTED_LIST_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context)
 {
     /* Codes_SRS_CLDS_SORTED_LIST_01_036: [ item_cleanup_callback shall be allowed to be NULL. ]*/
@@ -1917,6 +2557,7 @@ CLDS_SORTED_LIST_ITEM* clds_sorted_list_node_create(size_t node_size, SORTED_LIS
         item->item_cleanup_callback_context = item_cleanup_callback_context;
         (void)interlocked_exchange(&item->ref_count, 1);
         (void)interlocked_exchange_pointer((void* volatile_atomic*)&item->next, NULL);
+        CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(item);
     }
 
     return result;
@@ -0,0 +1,1494 @@
+// Licensed under the MIT license.See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "c_logging/logger.h"
+
+#include "c_pal/gballoc_hl.h"
+#include "c_pal/gballoc_hl_redirect.h"
+#include "c_pal/sync.h"
+#include "c_pal/interlocked.h"
+
+#include "clds/clds_hazard_pointers.h"
+#include "clds/clds_hash_table.h"
+
+#include "clds/clds_split_ordered_hash_table.h"
+
+/* this is a lock free hash table implementation based on split ordered lists (Shalev, Shavit) */
+
+// all the items are in one lock free list ordered by the bit reversed hash of their key (the split order key)
+// each bucket is a dummy node in the list, the items of a bucket are the ones between its dummy node and the next dummy node
+// when the bucket count doubles, bucket i splits into buckets i and i + old bucket count, the dummy node of the new bucket
+// is inserted (on first use) in the middle of the items of the old bucket, so no item is ever moved
+
+#define ITERATION_COUNT_LOG_LIMIT 100000
+
+// the bucket count doubles when there are on average more items than this in a bucket
+#define MAX_LOAD_FACTOR 2
+
+// bucket counts are powers of 2 kept in an int32_t
+#define MAX_BUCKET_COUNT ((int32_t)1 << 30)
+
+// segment 0 holds the initial buckets, each next segment holds as many buckets as all the previous ones together
+#define MAX_SEGMENT_COUNT 32
+
+#define DELETED_MARK ((uintptr_t)0x1)
+
+typedef struct CLDS_SPLIT_ORDERED_HASH_TABLE_TAG
+{
+    COMPUTE_HASH_FUNC compute_hash;
+    KEY_COMPARE_FUNC key_compare_func;
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
+    volatile_atomic int64_t* sequence_number;
+    HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb;
+    void* skipped_seq_no_cb_context;
+
+    // the dummy node of bucket 0, which is the head of the list
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* head;
+    int32_t initial_bucket_count;
+    volatile_atomic int32_t bucket_count;
+    volatile_atomic int32_t item_count;
+
+    // the dummy nodes of the buckets, a segment is allocated when one of its buckets is first used
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* volatile_atomic* volatile_atomic bucket_segments[MAX_SEGMENT_COUNT];
+
+    // Support for locking the table for writes
+    volatile_atomic int32_t locked_for_write;
+    volatile_atomic int32_t pending_write_operations;
+} CLDS_SPLIT_ORDERED_HASH_TABLE;
+
+// where a key is (or would be) in the list: current is the first node that is not smaller than the key and previous is the node before it
+typedef struct LIST_POSITION_TAG
+{
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* previous;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp;
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* current;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE current_hp;
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* next;
+} LIST_POSITION;
+
+static void check_lock_and_begin_write_operation(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table)
+{
+    int32_t locked_for_write;
+    do
+    {
+        (void)interlocked_increment(&clds_split_ordered_hash_table->pending_write_operations);
+        locked_for_write = interlocked_add(&clds_split_ordered_hash_table->locked_for_write, 0);
+        if (locked_for_write != 0)
+        {
+            (void)interlocked_decrement(&clds_split_ordered_hash_table->pending_write_operations);
+            wake_by_address_all(&clds_split_ordered_hash_table->pending_write_operations);
+
+            // Wait for unlock
+            (void)wait_on_address(&clds_split_ordered_hash_table->locked_for_write, locked_for_write, UINT32_MAX);
+        }
+    } while (locked_for_write != 0);
+}
+
+static void end_write_operation(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table)
+{
+    (void)interlocked_decrement(&clds_split_ordered_hash_table->pending_write_operations);
+    wake_by_address_all(&clds_split_ordered_hash_table->pending_write_operations);
+}
+
+static void internal_lock_writes(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table)
+{
+    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_061: [ clds_split_ordered_hash_table_snapshot shall increment a counter to lock the table for writes and wait for the ongoing write operations to complete. ]*/
+    (void)interlocked_increment(&clds_split_ordered_hash_table->locked_for_write);
+
+    int32_t pending_writes;
+    do
+    {
+        pending_writes = interlocked_add(&clds_split_ordered_hash_table->pending_write_operations, 0);
+        if (pending_writes != 0)
+        {
+            // Wait for writes
+            (void)wait_on_address(&clds_split_ordered_hash_table->pending_write_operations, pending_writes, UINT32_MAX);
+        }
+    } while (pending_writes != 0);
+}
+
+static void internal_unlock_writes(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table)
+{
+    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_066: [ clds_split_ordered_hash_table_snapshot shall decrement the counter to unlock the table for writes. ]*/
+    (void)interlocked_decrement(&clds_split_ordered_hash_table->locked_for_write);
+    wake_by_address_all(&clds_split_ordered_hash_table->locked_for_write);
+}
+
+static void internal_node_destroy(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item)
+{
+    if (interlocked_decrement(&item->ref_count) == 0)
+    {
+        if (item->item_cleanup_callback != NULL)
+        {
+            item->item_cleanup_callback(item->item_cleanup_callback_context, item);
+        }
+
+        free((void*)item);
+    }
+}
+
+static void reclaim_list_node(void* node)
+{
+    internal_node_destroy((CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*)node);
+}
+
+static uint64_t reverse_bits(uint64_t value)
+{
+    value = ((value >> 1) & 0x5555555555555555) | ((value & 0x5555555555555555) << 1);
+    value = ((value >> 2) & 0x3333333333333333) | ((value & 0x3333333333333333) << 2);
+    value = ((value >> 4) & 0x0F0F0F0F0F0F0F0F) | ((value & 0x0F0F0F0F0F0F0F0F) << 4);
+    value = ((value >> 8) & 0x00FF00FF00FF00FF) | ((value & 0x00FF00FF00FF00FF) << 8);
+    value = ((value >> 16) & 0x0000FFFF0000FFFF) | ((value & 0x0000FFFF0000FFFF) << 16);
+    return (value >> 32) | (value << 32);
+}
+
+// the split order key of an item has the lowest bit set, so that it sorts after the dummy node of its bucket
+static uint64_t get_item_split_order_key(uint64_t hash)
+{
+    return reverse_bits(hash) | 1;
+}
+
+static uint64_t get_bucket_split_order_key(int32_t bucket_index)
+{
+    return reverse_bits((uint64_t)bucket_index);
+}
+
+static bool is_dummy_node(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* node)
+{
+    return (node->split_order_key & 1) == 0;
+}
+
+static int compare_node(CLDS_SPLIT_ORDERED_HASH_TABLE* clds_split_ordered_hash_table, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* node, uint64_t split_order_key, void* key)
+{
+    int result;
+
+    if (node->split_order_key < split_order_key)
+    {
+        result = -1;
+    }
+    else if (node->split_order_key > split_order_key)
+    {
+        result = 1;
+    }
+    else if (key == NULL)
+    {
+        // there is only one dummy node for each split order key
+        result = 0;
+    }
+    else
+    {
+        // same split order key, items with colliding hashes are ordered by key
+        result = clds_split_ordered_hash_table->key_compare_func(node->key, key);
+    }
+
+    return result;
+}
+
+static void report_skipped_seq_no(CLDS_SPLIT_ORDERED_HASH_TABLE* clds_split_ordered_hash_table, int64_t skipped_sequence_no)
+{
+    if (
+        (clds_split_ordered_hash_table->sequence_number != NULL) &&
+        (clds_split_ordered_hash_table->skipped_seq_no_cb != NULL)
+        )
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_014: [ When an operation consumed a sequence number and then had to be retried, the consumed sequence number shall be reported by calling skipped_seq_no_cb with skipped_seq_no_cb_context. ]*/
+        clds_split_ordered_hash_table->skipped_seq_no_cb(clds_split_ordered_hash_table->skipped_seq_no_cb_context, skipped_sequence_no);
+    }
+}
+
+static void release_position(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, LIST_POSITION* position)
+{
+    if (position->previous_hp != NULL)
+    {
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, position->previous_hp);
+    }
+
+    if (position->current_hp != NULL)
+    {
+        clds_hazard_pointers_release(clds_hazard_pointers_thread, position->current_hp);
+    }
+}
+
+// finds the position of a key in the list, starting at start_node, which has to be a dummy node (they are never reclaimed while the table exists)
+// the deleted nodes found on the way are unlinked and retired
+// on success the previous and current nodes are protected by hazard pointers that have to be released with release_position
+static int find_position(CLDS_SPLIT_ORDERED_HASH_TABLE* clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* start_node, uint64_t split_order_key, void* key, LIST_POSITION* position, bool* found)
+{
+    int result = MU_FAILURE;
+    bool restart_needed;
+    uint64_t iteration_count = 0;
+
+    do
+    {
+        if (++iteration_count > ITERATION_COUNT_LOG_LIMIT)
+        {
+            LogInfo("find_position spun for %" PRIu64 " iterations", (uint64_t)ITERATION_COUNT_LOG_LIMIT);
+            iteration_count = 0;
+        }
+
+        restart_needed = false;
+        position->previous = start_node;
+        position->previous_hp = NULL;
+
+        do
+        {
+            // a deleted previous node would show up as a mark on the link, which makes it different than the current node we read
+            CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&position->previous->next, NULL, NULL);
+            if (((uintptr_t)current_item & DELETED_MARK) != 0)
+            {
+                restart_needed = true;
+                break;
+            }
+            else if (current_item == NULL)
+            {
+                position->current = NULL;
+                position->current_hp = NULL;
+                position->next = NULL;
+                *found = false;
+                result = 0;
+                break;
+            }
+            else
+            {
+                CLDS_HAZARD_POINTER_RECORD_HANDLE current_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, current_item);
+                if (current_item_hp == NULL)
+                {
+                    LogError("Cannot acquire hazard pointer");
+                    result = MU_FAILURE;
+                    break;
+                }
+                else if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&position->previous->next, NULL, NULL) != current_item)
+                {
+                    // the current node might not be reachable anymore, so its memory cannot be used
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                    restart_needed = true;
+                    break;
+                }
+                else
+                {
+                    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* next_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, NULL, NULL);
+                    if (((uintptr_t)next_item & DELETED_MARK) != 0)
+                    {
+                        // the current node is deleted, help unlinking it
+                        next_item = (CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*)((uintptr_t)next_item & ~DELETED_MARK);
+                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&position->previous->next, next_item, current_item) != current_item)
+                        {
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                            restart_needed = true;
+                            break;
+                        }
+                        else
+                        {
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+
+                            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_015: [ The node that unlinks a deleted item from the list shall retire it by calling clds_hazard_pointers_retire. ]*/
+                            CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, current_item, reclaim_list_node);
+                        }
+                    }
+                    else
+                    {
+                        int compare_result = compare_node(clds_split_ordered_hash_table, current_item, split_order_key, key);
+                        if (compare_result >= 0)
+                        {
+                            position->current = current_item;
+                            position->current_hp = current_item_hp;
+                            position->next = next_item;
+                            *found = (compare_result == 0);
+                            result = 0;
+                            break;
+                        }
+                        else
+                        {
+                            if (position->previous_hp != NULL)
+                            {
+                                clds_hazard_pointers_release(clds_hazard_pointers_thread, position->previous_hp);
+                            }
+
+                            position->previous = current_item;
+                            position->previous_hp = current_item_hp;
+                        }
+                    }
+                }
+            }
+        } while (1);
+
+        if ((restart_needed || (result != 0)) && (position->previous_hp != NULL))
+        {
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, position->previous_hp);
+        }
+    } while (restart_needed);
+
+    return result;
+}
+
+// links node in the list after start_node, unless a node with the same key is already there, in which case it is returned in existing_node (if not NULL)
+static CLDS_HASH_TABLE_INSERT_RESULT insert_node(CLDS_SPLIT_ORDERED_HASH_TABLE* clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* start_node, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* node, int64_t* sequence_number, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** existing_node)
+{
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    bool restart_needed;
+    // the dummy nodes are not operations of the user, so they do not get a sequence number
+    bool use_sequence_number = (clds_split_ordered_hash_table->sequence_number != NULL) && !is_dummy_node(node);
+
+    do
+    {
+        LIST_POSITION position;
+        bool found;
+
+        if (find_position(clds_split_ordered_hash_table, clds_hazard_pointers_thread, start_node, node->split_order_key, node->key, &position, &found) != 0)
+        {
+            LogError("Cannot find the position of the node in the list");
+            restart_needed = false;
+            result = CLDS_HASH_TABLE_INSERT_ERROR;
+        }
+        else if (found)
+        {
+            if (existing_node != NULL)
+            {
+                *existing_node = position.current;
+            }
+
+            release_position(clds_hazard_pointers_thread, &position);
+            restart_needed = false;
+            result = CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS;
+        }
+        else
+        {
+            int64_t local_seq_no = 0;
+
+            (void)interlocked_exchange_pointer((void* volatile_atomic*)&node->next, position.current);
+
+            if (use_sequence_number)
+            {
+                local_seq_no = interlocked_increment_64(clds_split_ordered_hash_table->sequence_number);
+            }
+
+            if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&position.previous->next, node, position.current) != position.current)
+            {
+                release_position(clds_hazard_pointers_thread, &position);
+
+                if (use_sequence_number)
+                {
+                    report_skipped_seq_no(clds_split_ordered_hash_table, local_seq_no);
+                }
+
+                restart_needed = true;
+            }
+            else
+            {
+                if (use_sequence_number && (sequence_number != NULL))
+                {
+                    *sequence_number = local_seq_no;
+                }
+
+                release_position(clds_hazard_pointers_thread, &position);
+                restart_needed = false;
+                result = CLDS_HASH_TABLE_INSERT_OK;
+            }
+        }
+    } while (restart_needed);
+
+    return result;
+}
+
+// unlinks a node that was just marked as deleted, if the previous node changed in the meanwhile the node is unlinked by searching for it again
+static void unlink_deleted_node(CLDS_SPLIT_ORDERED_HASH_TABLE* clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* start_node, LIST_POSITION* position, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* next_item)
+{
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* deleted_item = position->current;
+    bool unlinked = (interlocked_compare_exchange_pointer((void* volatile_atomic*)&position->previous->next, next_item, deleted_item) == deleted_item);
+
+    release_position(clds_hazard_pointers_thread, position);
+
+    if (unlinked)
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_015: [ The node that unlinks a deleted item from the list shall retire it by calling clds_hazard_pointers_retire. ]*/
+        CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, deleted_item, reclaim_list_node);
+    }
+    else
+    {
+        LIST_POSITION cleanup_position;
+        bool found;
+
+        // if this fails the node stays marked in the list until the next operation going over it unlinks it
+        if (find_position(clds_split_ordered_hash_table, clds_hazard_pointers_thread, start_node, deleted_item->split_order_key, deleted_item->key, &cleanup_position, &found) == 0)
+        {
+            release_position(clds_hazard_pointers_thread, &cleanup_position);
+        }
+    }
+}
+
+// deletes the node with the given key (and if value is not NULL, only if the node is value)
+static CLDS_HASH_TABLE_REMOVE_RESULT remove_node(CLDS_SPLIT_ORDERED_HASH_TABLE* clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* start_node, uint64_t split_order_key, void* key, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* value, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** item, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    bool restart_needed;
+
+    do
+    {
+        LIST_POSITION position;
+        bool found;
+
+        if (find_position(clds_split_ordered_hash_table, clds_hazard_pointers_thread, start_node, split_order_key, key, &position, &found) != 0)
+        {
+            LogError("Cannot find the position of the key in the list");
+            restart_needed = false;
+            result = CLDS_HASH_TABLE_REMOVE_ERROR;
+        }
+        else if (
+            (!found) ||
+            ((value != NULL) && (position.current != value))
+            )
+        {
+            release_position(clds_hazard_pointers_thread, &position);
+            restart_needed = false;
+            result = CLDS_HASH_TABLE_REMOVE_NOT_FOUND;
+        }
+        else
+        {
+            int64_t local_seq_no = 0;
+
+            if (clds_split_ordered_hash_table->sequence_number != NULL)
+            {
+                local_seq_no = interlocked_increment_64(clds_split_ordered_hash_table->sequence_number);
+            }
+
+            // marking the node is what deletes it, unlinking it from the list is only cleanup
+            if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&position.current->next, (void*)((uintptr_t)position.next | DELETED_MARK), position.next) != position.next)
+            {
+                release_position(clds_hazard_pointers_thread, &position);
+                report_skipped_seq_no(clds_split_ordered_hash_table, local_seq_no);
+                restart_needed = true;
+            }
+            else
+            {
+                (void)interlocked_decrement(&clds_split_ordered_hash_table->item_count);
+
+                if (item != NULL)
+                {
+                    (void)interlocked_increment(&position.current->ref_count);
+                    *item = position.current;
+                }
+
+                if ((clds_split_ordered_hash_table->sequence_number != NULL) && (sequence_number != NULL))
+                {
+                    *sequence_number = local_seq_no;
+                }
+
+                unlink_deleted_node(clds_split_ordered_hash_table, clds_hazard_pointers_thread, start_node, &position, position.next);
+                restart_needed = false;
+                result = CLDS_HASH_TABLE_REMOVE_OK;
+            }
+        }
+    } while (restart_needed);
+
+    return result;
+}
+
+static void get_bucket_location(CLDS_SPLIT_ORDERED_HASH_TABLE* clds_split_ordered_hash_table, int32_t bucket_index, uint32_t* segment_index, int32_t* index_in_segment, int32_t* segment_size)
+{
+    if (bucket_index < clds_split_ordered_hash_table->initial_bucket_count)
+    {
+        *segment_index = 0;
+        *index_in_segment = bucket_index;
+        *segment_size = clds_split_ordered_hash_table->initial_bucket_count;
+    }
+    else
+    {
+        // segment N (N > 0) starts at bucket initial_bucket_count * 2^(N - 1) and has as many buckets
+        int32_t segment_start = clds_split_ordered_hash_table->initial_bucket_count;
+        *segment_index = 1;
+        while (bucket_index - segment_start >= segment_start)
+        {
+            segment_start *= 2;
+            (*segment_index)++;
+        }
+
+        *index_in_segment = bucket_index - segment_start;
+        *segment_size = segment_start;
+    }
+}
+
+static CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* volatile_atomic* get_bucket_slot(CLDS_SPLIT_ORDERED_HASH_TABLE* clds_split_ordered_hash_table, int32_t bucket_index)
+{
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* volatile_atomic* result;
+    uint32_t segment_index;
+    int32_t index_in_segment;
+    int32_t segment_size;
+
+    get_bucket_location(clds_split_ordered_hash_table, bucket_index, &segment_index, &index_in_segment, &segment_size);
+
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* volatile_atomic* segment = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_split_ordered_hash_table->bucket_segments[segment_index], NULL, NULL);
+    if (segment == NULL)
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_011: [ The bucket slots shall be allocated in segments, each segment being allocated when one of its buckets is used for the first time. ]*/
+        CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* volatile_atomic* new_segment = malloc_2((size_t)segment_size, sizeof(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*));
+        if (new_segment == NULL)
+        {
+            LogError("malloc_2((size_t)segment_size=%zu, sizeof(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*)=%zu) failed",
+                (size_t)segment_size, sizeof(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*));
+        }
+        else
+        {
+            int32_t i;
+            for (i = 0; i < segment_size; i++)
+            {
+                (void)interlocked_exchange_pointer((void* volatile_atomic*)&new_segment[i], NULL);
+            }
+
+            segment = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_split_ordered_hash_table->bucket_segments[segment_index], (void*)new_segment, NULL);
+            if (segment != NULL)
+            {
+                // someone else allocated the segment
+                free((void*)new_segment);
+            }
+            else
+            {
+                segment = new_segment;
+            }
+        }
+    }
+
+    if (segment == NULL)
+    {
+        result = NULL;
+    }
+    else
+    {
+        result = &segment[index_in_segment];
+    }
+
+    return result;
+}
+
+static int32_t get_parent_bucket_index(int32_t bucket_index)
+{
+    // the parent is the bucket that got split to create this one, clearing the most significant bit gives it
+    uint32_t most_significant_bit = (uint32_t)MAX_BUCKET_COUNT;
+    while (((uint32_t)bucket_index & most_significant_bit) == 0)
+    {
+        most_significant_bit >>= 1;
+    }
+
+    return (int32_t)((uint32_t)bucket_index & ~most_significant_bit);
+}
+
+// returns the dummy node of a bucket, initializing the bucket (and its parent buckets) if needed
+static CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* get_bucket_node(CLDS_SPLIT_ORDERED_HASH_TABLE* clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, int32_t bucket_index)
+{
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* result;
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* volatile_atomic* bucket_slot = get_bucket_slot(clds_split_ordered_hash_table, bucket_index);
+
+    if (bucket_slot == NULL)
+    {
+        LogError("Cannot get the slot for bucket %" PRId32 "", bucket_index);
+        result = NULL;
+    }
+    else
+    {
+        result = interlocked_compare_exchange_pointer((void* volatile_atomic*)bucket_slot, NULL, NULL);
+        if (result == NULL)
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_012: [ When a bucket is used for the first time, a dummy node for the bucket shall be inserted in the list, starting at the dummy node of the bucket it was split from (initializing that bucket first if needed). ]*/
+            CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* parent_bucket_node = get_bucket_node(clds_split_ordered_hash_table, clds_hazard_pointers_thread, get_parent_bucket_index(bucket_index));
+            if (parent_bucket_node == NULL)
+            {
+                LogError("Cannot get the parent bucket of bucket %" PRId32 "", bucket_index);
+            }
+            else
+            {
+                CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* bucket_node = malloc(sizeof(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM));
+                if (bucket_node == NULL)
+                {
+                    LogError("malloc(sizeof(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM)=%zu) failed", sizeof(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM));
+                }
+                else
+                {
+                    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* existing_bucket_node = NULL;
+                    CLDS_HASH_TABLE_INSERT_RESULT insert_result;
+
+                    bucket_node->item_cleanup_callback = NULL;
+                    bucket_node->item_cleanup_callback_context = NULL;
+                    bucket_node->key = NULL;
+                    bucket_node->split_order_key = get_bucket_split_order_key(bucket_index);
+                    (void)interlocked_exchange(&bucket_node->ref_count, 1);
+                    (void)interlocked_exchange_pointer((void* volatile_atomic*)&bucket_node->next, NULL);
+                    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(bucket_node);
+
+                    insert_result = insert_node(clds_split_ordered_hash_table, clds_hazard_pointers_thread, parent_bucket_node, bucket_node, NULL, &existing_bucket_node);
+                    if (insert_result == CLDS_HASH_TABLE_INSERT_OK)
+                    {
+                        result = bucket_node;
+                    }
+                    else
+                    {
+                        free(bucket_node);
+
+                        if (insert_result == CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS)
+                        {
+                            // another thread initialized the bucket
+                            result = existing_bucket_node;
+                        }
+                        else
+                        {
+                            LogError("Cannot insert the dummy node for bucket %" PRId32 "", bucket_index);
+                        }
+                    }
+
+                    if (result != NULL)
+                    {
+                        // there is only one dummy node per bucket in the list, so it does not matter who sets the slot
+                        (void)interlocked_compare_exchange_pointer((void* volatile_atomic*)bucket_slot, result, NULL);
+                    }
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+static CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* get_bucket_node_for_hash(CLDS_SPLIT_ORDERED_HASH_TABLE* clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t hash)
+{
+    int32_t bucket_count = interlocked_add(&clds_split_ordered_hash_table->bucket_count, 0);
+
+    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_013: [ The bucket of a key shall be the hash of the key modulo the current bucket count. ]*/
+    return get_bucket_node(clds_split_ordered_hash_table, clds_hazard_pointers_thread, (int32_t)(hash & (uint64_t)(bucket_count - 1)));
+}
+
+static void count_inserted_item(CLDS_SPLIT_ORDERED_HASH_TABLE* clds_split_ordered_hash_table)
+{
+    int32_t item_count = interlocked_increment(&clds_split_ordered_hash_table->item_count);
+    int32_t bucket_count = interlocked_add(&clds_split_ordered_hash_table->bucket_count, 0);
+
+    if (
+        (item_count / bucket_count > MAX_LOAD_FACTOR) &&
+        (bucket_count < MAX_BUCKET_COUNT)
+        )
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_024: [ If after the insert there are on average more than 2 items in a bucket, clds_split_ordered_hash_table_insert shall double the bucket count with one compare exchange, without moving any item. ]*/
+        (void)interlocked_compare_exchange(&clds_split_ordered_hash_table->bucket_count, bucket_count * 2, bucket_count);
+    }
+}
+
+static int collect_items(CLDS_SPLIT_ORDERED_HASH_TABLE* clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** items, uint64_t item_count)
+{
+    int result = MU_FAILURE;
+    bool restart_needed;
+    uint64_t collected_count = 0;
+
+    do
+    {
+        CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* previous_item = clds_split_ordered_hash_table->head;
+        CLDS_HAZARD_POINTER_RECORD_HANDLE previous_hp = NULL;
+
+        // the list changed under a previous pass, start over
+        while (collected_count > 0)
+        {
+            collected_count--;
+            internal_node_destroy(items[collected_count]);
+        }
+
+        restart_needed = false;
+
+        do
+        {
+            CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* current_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&previous_item->next, NULL, NULL);
+            if (((uintptr_t)current_item & DELETED_MARK) != 0)
+            {
+                restart_needed = true;
+                break;
+            }
+            else if (current_item == NULL)
+            {
+                if (collected_count != item_count)
+                {
+                    LogError("Found %" PRIu64 " items in the list, expected %" PRIu64 "", collected_count, item_count);
+                    result = MU_FAILURE;
+                }
+                else
+                {
+                    result = 0;
+                }
+                break;
+            }
+            else
+            {
+                CLDS_HAZARD_POINTER_RECORD_HANDLE current_item_hp = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, current_item);
+                if (current_item_hp == NULL)
+                {
+                    LogError("Cannot acquire hazard pointer");
+                    result = MU_FAILURE;
+                    break;
+                }
+                else if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&previous_item->next, NULL, NULL) != current_item)
+                {
+                    clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                    restart_needed = true;
+                    break;
+                }
+                else
+                {
+                    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* next_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, NULL, NULL);
+                    if (((uintptr_t)next_item & DELETED_MARK) != 0)
+                    {
+                        // deleted before the table was locked, but not unlinked yet
+                        next_item = (CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*)((uintptr_t)next_item & ~DELETED_MARK);
+                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&previous_item->next, next_item, current_item) != current_item)
+                        {
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                            restart_needed = true;
+                            break;
+                        }
+                        else
+                        {
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                            CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, current_item, reclaim_list_node);
+                        }
+                    }
+                    else
+                    {
+                        if (!is_dummy_node(current_item))
+                        {
+                            if (collected_count == item_count)
+                            {
+                                LogError("Found more items in the list than the expected %" PRIu64 "", item_count);
+                                clds_hazard_pointers_release(clds_hazard_pointers_thread, current_item_hp);
+                                result = MU_FAILURE;
+                                break;
+                            }
+
+                            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_064: [ clds_split_ordered_hash_table_snapshot shall increment the reference count of each item it returns. ]*/
+                            (void)interlocked_increment(&current_item->ref_count);
+                            items[collected_count] = current_item;
+                            collected_count++;
+                        }
+
+                        if (previous_hp != NULL)
+                        {
+                            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+                        }
+
+                        previous_item = current_item;
+                        previous_hp = current_item_hp;
+                    }
+                }
+            }
+        } while (1);
+
+        if (previous_hp != NULL)
+        {
+            clds_hazard_pointers_release(clds_hazard_pointers_thread, previous_hp);
+        }
+    } while (restart_needed);
+
+    if (result != 0)
+    {
+        while (collected_count > 0)
+        {
+            collected_count--;
+            internal_node_destroy(items[collected_count]);
+        }
+    }
+
+    return result;
+}
+
+CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table_create(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context)
+{
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table;
+
+    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_006: [ start_sequence_number shall be allowed to be NULL, in which case no sequence number computations shall be performed. ]*/
+    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_007: [ skipped_seq_no_cb and skipped_seq_no_cb_context shall be allowed to be NULL. ]*/
+
+    if (
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_002: [ If compute_hash is NULL, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+        (compute_hash == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_003: [ If key_compare_func is NULL, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+        (key_compare_func == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_004: [ If initial_bucket_size is 0 or greater than 2^30, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+        (initial_bucket_size == 0) ||
+        (initial_bucket_size > (size_t)MAX_BUCKET_COUNT) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_005: [ If clds_hazard_pointers is NULL, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+        (clds_hazard_pointers == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_008: [ If start_sequence_number is NULL, then skipped_seq_no_cb must also be NULL, otherwise clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+        ((start_sequence_number == NULL) && (skipped_seq_no_cb != NULL))
+        )
+    {
+        LogError("Invalid arguments: COMPUTE_HASH_FUNC compute_hash=%p, KEY_COMPARE_FUNC key_compare_func=%p, size_t initial_bucket_size=%zu, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers=%p, volatile_atomic int64_t* start_sequence_number=%p, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb=%p, void* skipped_seq_no_cb_context=%p",
+            compute_hash, key_compare_func, initial_bucket_size, clds_hazard_pointers, start_sequence_number, skipped_seq_no_cb, skipped_seq_no_cb_context);
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_001: [ clds_split_ordered_hash_table_create shall create a new hash table object and on success it shall return a non-NULL handle to the newly created hash table. ]*/
+        clds_split_ordered_hash_table = malloc(sizeof(CLDS_SPLIT_ORDERED_HASH_TABLE));
+        if (clds_split_ordered_hash_table == NULL)
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_009: [ If any error happens, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+            LogError("malloc(sizeof(CLDS_SPLIT_ORDERED_HASH_TABLE)=%zu) failed", sizeof(CLDS_SPLIT_ORDERED_HASH_TABLE));
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_010: [ The initial bucket count shall be initial_bucket_size rounded up to a power of 2. ]*/
+            int32_t initial_bucket_count = 1;
+            while ((size_t)initial_bucket_count < initial_bucket_size)
+            {
+                initial_bucket_count *= 2;
+            }
+
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_011: [ The bucket slots shall be allocated in segments, each segment being allocated when one of its buckets is used for the first time. ]*/
+            CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* volatile_atomic* first_segment = malloc_2((size_t)initial_bucket_count, sizeof(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*));
+            if (first_segment == NULL)
+            {
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_009: [ If any error happens, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+                LogError("malloc_2((size_t)initial_bucket_count=%zu, sizeof(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*)=%zu) failed",
+                    (size_t)initial_bucket_count, sizeof(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*));
+            }
+            else
+            {
+                // the dummy node of bucket 0 is the head of the list
+                clds_split_ordered_hash_table->head = malloc(sizeof(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM));
+                if (clds_split_ordered_hash_table->head == NULL)
+                {
+                    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_009: [ If any error happens, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+                    LogError("malloc(sizeof(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM)=%zu) failed", sizeof(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM));
+                }
+                else
+                {
+                    int32_t i;
+
+                    clds_split_ordered_hash_table->head->item_cleanup_callback = NULL;
+                    clds_split_ordered_hash_table->head->item_cleanup_callback_context = NULL;
+                    clds_split_ordered_hash_table->head->key = NULL;
+                    clds_split_ordered_hash_table->head->split_order_key = get_bucket_split_order_key(0);
+                    (void)interlocked_exchange(&clds_split_ordered_hash_table->head->ref_count, 1);
+                    (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_split_ordered_hash_table->head->next, NULL);
+                    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(clds_split_ordered_hash_table->head);
+
+                    clds_split_ordered_hash_table->compute_hash = compute_hash;
+                    clds_split_ordered_hash_table->key_compare_func = key_compare_func;
+                    clds_split_ordered_hash_table->clds_hazard_pointers = clds_hazard_pointers;
+                    clds_split_ordered_hash_table->skipped_seq_no_cb = skipped_seq_no_cb;
+                    clds_split_ordered_hash_table->skipped_seq_no_cb_context = skipped_seq_no_cb_context;
+
+                    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_016: [ start_sequence_number shall be used as the sequence number variable that shall be incremented at every operation that is done on the hash table. ]*/
+                    clds_split_ordered_hash_table->sequence_number = start_sequence_number;
+
+                    clds_split_ordered_hash_table->initial_bucket_count = initial_bucket_count;
+                    (void)interlocked_exchange(&clds_split_ordered_hash_table->bucket_count, initial_bucket_count);
+                    (void)interlocked_exchange(&clds_split_ordered_hash_table->item_count, 0);
+                    (void)interlocked_exchange(&clds_split_ordered_hash_table->pending_write_operations, 0);
+                    (void)interlocked_exchange(&clds_split_ordered_hash_table->locked_for_write, 0);
+
+                    for (i = 0; i < initial_bucket_count; i++)
+                    {
+                        (void)interlocked_exchange_pointer((void* volatile_atomic*)&first_segment[i], NULL);
+                    }
+
+                    (void)interlocked_exchange_pointer((void* volatile_atomic*)&first_segment[0], clds_split_ordered_hash_table->head);
+
+                    (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_split_ordered_hash_table->bucket_segments[0], (void*)first_segment);
+                    for (i = 1; i < MAX_SEGMENT_COUNT; i++)
+                    {
+                        (void)interlocked_exchange_pointer((void* volatile_atomic*)&clds_split_ordered_hash_table->bucket_segments[i], NULL);
+                    }
+
+                    goto all_ok;
+                }
+
+                free((void*)first_segment);
+            }
+
+            free(clds_split_ordered_hash_table);
+        }
+    }
+
+    clds_split_ordered_hash_table = NULL;
+
+all_ok:
+    return clds_split_ordered_hash_table;
+}
+
+void clds_split_ordered_hash_table_destroy(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table)
+{
+    if (clds_split_ordered_hash_table == NULL)
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_018: [ If clds_split_ordered_hash_table is NULL, clds_split_ordered_hash_table_destroy shall return. ]*/
+        LogError("Invalid arguments: CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table=%p", clds_split_ordered_hash_table);
+    }
+    else
+    {
+        uint32_t i;
+
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_017: [ clds_split_ordered_hash_table_destroy shall release the items in the table and free all resources associated with the hash table instance. ]*/
+        CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* current_item = clds_split_ordered_hash_table->head;
+        while (current_item != NULL)
+        {
+            CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* next_item = interlocked_compare_exchange_pointer((void* volatile_atomic*)&current_item->next, NULL, NULL);
+            next_item = (CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*)((uintptr_t)next_item & ~DELETED_MARK);
+
+            if (is_dummy_node(current_item))
+            {
+                free(current_item);
+            }
+            else
+            {
+                internal_node_destroy(current_item);
+            }
+
+            current_item = next_item;
+        }
+
+        for (i = 0; i < MAX_SEGMENT_COUNT; i++)
+        {
+            CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* volatile_atomic* segment = interlocked_compare_exchange_pointer((void* volatile_atomic*)&clds_split_ordered_hash_table->bucket_segments[i], NULL, NULL);
+            if (segment != NULL)
+            {
+                free((void*)segment);
+            }
+        }
+
+        free(clds_split_ordered_hash_table);
+    }
+}
+
+CLDS_HASH_TABLE_INSERT_RESULT clds_split_ordered_hash_table_insert(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* value, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_019: [ If clds_split_ordered_hash_table is NULL, clds_split_ordered_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (clds_split_ordered_hash_table == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_020: [ If clds_hazard_pointers_thread, key or value is NULL, clds_split_ordered_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        (clds_hazard_pointers_thread == NULL) ||
+        (key == NULL) ||
+        (value == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_021: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_split_ordered_hash_table_create, clds_split_ordered_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_split_ordered_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* value=%p, int64_t* sequence_number=%p",
+            clds_split_ordered_hash_table, clds_hazard_pointers_thread, key, value, sequence_number);
+        result = CLDS_HASH_TABLE_INSERT_ERROR;
+    }
+    else
+    {
+        check_lock_and_begin_write_operation(clds_split_ordered_hash_table);
+
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_022: [ clds_split_ordered_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_split_ordered_hash_table_create. ]*/
+        uint64_t hash = clds_split_ordered_hash_table->compute_hash(key);
+        CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* bucket_node = get_bucket_node_for_hash(clds_split_ordered_hash_table, clds_hazard_pointers_thread, hash);
+        if (bucket_node == NULL)
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_026: [ If any error is encountered while inserting the key/value pair, clds_split_ordered_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+            LogError("Cannot get the bucket for hash %" PRIu64 "", hash);
+            result = CLDS_HASH_TABLE_INSERT_ERROR;
+        }
+        else
+        {
+            value->key = key;
+            value->split_order_key = get_item_split_order_key(hash);
+
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_023: [ clds_split_ordered_hash_table_insert shall insert value in the list after the dummy node of the bucket of the key, at the position given by the bit reversed hash of the key and then by the key. ]*/
+            result = insert_node(clds_split_ordered_hash_table, clds_hazard_pointers_thread, bucket_node, value, sequence_number, NULL);
+            if (result == CLDS_HASH_TABLE_INSERT_OK)
+            {
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_024: [ If after the insert there are on average more than 2 items in a bucket, clds_split_ordered_hash_table_insert shall double the bucket count with one compare exchange, without moving any item. ]*/
+                count_inserted_item(clds_split_ordered_hash_table);
+            }
+            else if (result == CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS)
+            {
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_025: [ If the key already exists in the hash table, clds_split_ordered_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+            }
+            else
+            {
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_026: [ If any error is encountered while inserting the key/value pair, clds_split_ordered_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+                LogError("Cannot insert the item in the list");
+            }
+        }
+
+        end_write_operation(clds_split_ordered_hash_table);
+    }
+
+    return result;
+}
+
+static CLDS_HASH_TABLE_DELETE_RESULT internal_delete(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* value, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+
+    check_lock_and_begin_write_operation(clds_split_ordered_hash_table);
+
+    uint64_t hash = clds_split_ordered_hash_table->compute_hash(key);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* bucket_node = get_bucket_node_for_hash(clds_split_ordered_hash_table, clds_hazard_pointers_thread, hash);
+    if (bucket_node == NULL)
+    {
+        LogError("Cannot get the bucket for hash %" PRIu64 "", hash);
+        result = CLDS_HASH_TABLE_DELETE_ERROR;
+    }
+    else
+    {
+        CLDS_HASH_TABLE_REMOVE_RESULT remove_result = remove_node(clds_split_ordered_hash_table, clds_hazard_pointers_thread, bucket_node, get_item_split_order_key(hash), key, value, NULL, sequence_number);
+        if (remove_result == CLDS_HASH_TABLE_REMOVE_OK)
+        {
+            result = CLDS_HASH_TABLE_DELETE_OK;
+        }
+        else if (remove_result == CLDS_HASH_TABLE_REMOVE_NOT_FOUND)
+        {
+            result = CLDS_HASH_TABLE_DELETE_NOT_FOUND;
+        }
+        else
+        {
+            LogError("Cannot delete the item from the list");
+            result = CLDS_HASH_TABLE_DELETE_ERROR;
+        }
+    }
+
+    end_write_operation(clds_split_ordered_hash_table);
+
+    return result;
+}
+
+CLDS_HASH_TABLE_DELETE_RESULT clds_split_ordered_hash_table_delete(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_027: [ If clds_split_ordered_hash_table, clds_hazard_pointers_thread or key is NULL, clds_split_ordered_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_split_ordered_hash_table == NULL) ||
+        (clds_hazard_pointers_thread == NULL) ||
+        (key == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_028: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_split_ordered_hash_table_create, clds_split_ordered_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_split_ordered_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, int64_t* sequence_number=%p",
+            clds_split_ordered_hash_table, clds_hazard_pointers_thread, key, sequence_number);
+        result = CLDS_HASH_TABLE_DELETE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_029: [ clds_split_ordered_hash_table_delete shall mark the item with the given key as deleted, unlink it from the list and on success return CLDS_HASH_TABLE_DELETE_OK. ]*/
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_030: [ If the key is not found, clds_split_ordered_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_031: [ If any error occurs, clds_split_ordered_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        result = internal_delete(clds_split_ordered_hash_table, clds_hazard_pointers_thread, key, NULL, sequence_number);
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_DELETE_RESULT clds_split_ordered_hash_table_delete_key_value(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* value, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_032: [ If clds_split_ordered_hash_table, clds_hazard_pointers_thread, key or value is NULL, clds_split_ordered_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        (clds_split_ordered_hash_table == NULL) ||
+        (clds_hazard_pointers_thread == NULL) ||
+        (key == NULL) ||
+        (value == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_033: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_split_ordered_hash_table_create, clds_split_ordered_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_split_ordered_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* value=%p, int64_t* sequence_number=%p",
+            clds_split_ordered_hash_table, clds_hazard_pointers_thread, key, value, sequence_number);
+        result = CLDS_HASH_TABLE_DELETE_ERROR;
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_034: [ clds_split_ordered_hash_table_delete_key_value shall delete the item with the given key only if the item in the table is value and on success return CLDS_HASH_TABLE_DELETE_OK. ]*/
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_035: [ If the key is not found or the item with the key is not value, clds_split_ordered_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_036: [ If any error occurs, clds_split_ordered_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+        result = internal_delete(clds_split_ordered_hash_table, clds_hazard_pointers_thread, key, value, sequence_number);
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_REMOVE_RESULT clds_split_ordered_hash_table_remove(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** item, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_037: [ If clds_split_ordered_hash_table, clds_hazard_pointers_thread, key or item is NULL, clds_split_ordered_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        (clds_split_ordered_hash_table == NULL) ||
+        (clds_hazard_pointers_thread == NULL) ||
+        (key == NULL) ||
+        (item == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_038: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_split_ordered_hash_table_create, clds_split_ordered_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_split_ordered_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** item=%p, int64_t* sequence_number=%p",
+            clds_split_ordered_hash_table, clds_hazard_pointers_thread, key, item, sequence_number);
+        result = CLDS_HASH_TABLE_REMOVE_ERROR;
+    }
+    else
+    {
+        check_lock_and_begin_write_operation(clds_split_ordered_hash_table);
+
+        uint64_t hash = clds_split_ordered_hash_table->compute_hash(key);
+        CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* bucket_node = get_bucket_node_for_hash(clds_split_ordered_hash_table, clds_hazard_pointers_thread, hash);
+        if (bucket_node == NULL)
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_041: [ If any error occurs, clds_split_ordered_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+            LogError("Cannot get the bucket for hash %" PRIu64 "", hash);
+            result = CLDS_HASH_TABLE_REMOVE_ERROR;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_039: [ clds_split_ordered_hash_table_remove shall delete the item with the given key, return it with its reference count incremented in item and on success return CLDS_HASH_TABLE_REMOVE_OK. ]*/
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_040: [ If the key is not found, clds_split_ordered_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
+            result = remove_node(clds_split_ordered_hash_table, clds_hazard_pointers_thread, bucket_node, get_item_split_order_key(hash), key, NULL, item, sequence_number);
+            if (result == CLDS_HASH_TABLE_REMOVE_ERROR)
+            {
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_041: [ If any error occurs, clds_split_ordered_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+                LogError("Cannot remove the item from the list");
+            }
+        }
+
+        end_write_operation(clds_split_ordered_hash_table);
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_SET_VALUE_RESULT clds_split_ordered_hash_table_set_value(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* new_item, CONDITION_CHECK_CB condition_check_func, void* condition_check_context, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** old_item, int64_t* sequence_number)
+{
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_042: [ If clds_split_ordered_hash_table, clds_hazard_pointers_thread, key, new_item or old_item is NULL, clds_split_ordered_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        (clds_split_ordered_hash_table == NULL) ||
+        (clds_hazard_pointers_thread == NULL) ||
+        (key == NULL) ||
+        (new_item == NULL) ||
+        (old_item == NULL) ||
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_043: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_split_ordered_hash_table_create, clds_split_ordered_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+        ((sequence_number != NULL) && (clds_split_ordered_hash_table->sequence_number == NULL))
+        )
+    {
+        LogError("Invalid arguments: CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* new_item=%p, CONDITION_CHECK_CB condition_check_func=%p, void* condition_check_context=%p, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** old_item=%p, int64_t* sequence_number=%p",
+            clds_split_ordered_hash_table, clds_hazard_pointers_thread, key, new_item, condition_check_func, condition_check_context, old_item, sequence_number);
+        result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+    }
+    else
+    {
+        check_lock_and_begin_write_operation(clds_split_ordered_hash_table);
+
+        uint64_t hash = clds_split_ordered_hash_table->compute_hash(key);
+        CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* bucket_node = get_bucket_node_for_hash(clds_split_ordered_hash_table, clds_hazard_pointers_thread, hash);
+        if (bucket_node == NULL)
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_049: [ If any error occurs, clds_split_ordered_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+            LogError("Cannot get the bucket for hash %" PRIu64 "", hash);
+            result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+        }
+        else
+        {
+            bool restart_needed;
+
+            new_item->key = key;
+            new_item->split_order_key = get_item_split_order_key(hash);
+
+            do
+            {
+                LIST_POSITION position;
+                bool found;
+                int64_t local_seq_no = 0;
+
+                if (find_position(clds_split_ordered_hash_table, clds_hazard_pointers_thread, bucket_node, new_item->split_order_key, key, &position, &found) != 0)
+                {
+                    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_049: [ If any error occurs, clds_split_ordered_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+                    LogError("Cannot find the position of the key in the list");
+                    restart_needed = false;
+                    result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+                }
+                else if (!found)
+                {
+                    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_044: [ If the key is not in the table, clds_split_ordered_hash_table_set_value shall insert new_item, set old_item to NULL and return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
+                    (void)interlocked_exchange_pointer((void* volatile_atomic*)&new_item->next, position.current);
+
+                    if (clds_split_ordered_hash_table->sequence_number != NULL)
+                    {
+                        local_seq_no = interlocked_increment_64(clds_split_ordered_hash_table->sequence_number);
+                    }
+
+                    if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&position.previous->next, new_item, position.current) != position.current)
+                    {
+                        release_position(clds_hazard_pointers_thread, &position);
+                        report_skipped_seq_no(clds_split_ordered_hash_table, local_seq_no);
+                        restart_needed = true;
+                    }
+                    else
+                    {
+                        release_position(clds_hazard_pointers_thread, &position);
+                        count_inserted_item(clds_split_ordered_hash_table);
+
+                        if ((clds_split_ordered_hash_table->sequence_number != NULL) && (sequence_number != NULL))
+                        {
+                            *sequence_number = local_seq_no;
+                        }
+
+                        *old_item = NULL;
+                        restart_needed = false;
+                        result = CLDS_HASH_TABLE_SET_VALUE_OK;
+                    }
+                }
+                else
+                {
+                    CLDS_CONDITION_CHECK_RESULT condition_check_result = CLDS_CONDITION_CHECK_OK;
+
+                    if (condition_check_func != NULL)
+                    {
+                        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_046: [ If condition_check_func is not NULL, it shall be called with condition_check_context, the key of new_item and the key of the item in the table. ]*/
+                        condition_check_result = condition_check_func(condition_check_context, key, position.current->key);
+                    }
+
+                    if (condition_check_result == CLDS_CONDITION_CHECK_NOT_MET)
+                    {
+                        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_047: [ If condition_check_func returns CLDS_CONDITION_CHECK_NOT_MET, clds_split_ordered_hash_table_set_value shall return CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET. ]*/
+                        release_position(clds_hazard_pointers_thread, &position);
+                        restart_needed = false;
+                        result = CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET;
+                    }
+                    else if (condition_check_result != CLDS_CONDITION_CHECK_OK)
+                    {
+                        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_048: [ If condition_check_func returns CLDS_CONDITION_CHECK_ERROR, clds_split_ordered_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+                        LogError("condition_check_func returned %" PRI_MU_ENUM "", MU_ENUM_VALUE(CLDS_CONDITION_CHECK_RESULT, condition_check_result));
+                        release_position(clds_hazard_pointers_thread, &position);
+                        restart_needed = false;
+                        result = CLDS_HASH_TABLE_SET_VALUE_ERROR;
+                    }
+                    else if (position.current == new_item)
+                    {
+                        // the item is already the one in the table
+                        (void)interlocked_increment(&new_item->ref_count);
+                        *old_item = new_item;
+
+                        if ((clds_split_ordered_hash_table->sequence_number != NULL) && (sequence_number != NULL))
+                        {
+                            *sequence_number = interlocked_increment_64(clds_split_ordered_hash_table->sequence_number);
+                        }
+
+                        release_position(clds_hazard_pointers_thread, &position);
+                        restart_needed = false;
+                        result = CLDS_HASH_TABLE_SET_VALUE_OK;
+                    }
+                    else
+                    {
+                        // new_item takes the place of the old item in one compare exchange: the old item gets marked as deleted while its next link points to new_item,
+                        // so anyone going over the old item continues with new_item and unlinking the old item leaves new_item in its place
+                        (void)interlocked_exchange_pointer((void* volatile_atomic*)&new_item->next, position.next);
+
+                        if (clds_split_ordered_hash_table->sequence_number != NULL)
+                        {
+                            local_seq_no = interlocked_increment_64(clds_split_ordered_hash_table->sequence_number);
+                        }
+
+                        if (interlocked_compare_exchange_pointer((void* volatile_atomic*)&position.current->next, (void*)((uintptr_t)new_item | DELETED_MARK), position.next) != position.next)
+                        {
+                            release_position(clds_hazard_pointers_thread, &position);
+                            report_skipped_seq_no(clds_split_ordered_hash_table, local_seq_no);
+                            restart_needed = true;
+                        }
+                        else
+                        {
+                            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_045: [ If the key is in the table, clds_split_ordered_hash_table_set_value shall replace the item with new_item in one compare exchange, return the previous item with its reference count incremented in old_item and return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
+                            (void)interlocked_increment(&position.current->ref_count);
+                            *old_item = position.current;
+
+                            if ((clds_split_ordered_hash_table->sequence_number != NULL) && (sequence_number != NULL))
+                            {
+                                *sequence_number = local_seq_no;
+                            }
+
+                            unlink_deleted_node(clds_split_ordered_hash_table, clds_hazard_pointers_thread, bucket_node, &position, new_item);
+                            restart_needed = false;
+                            result = CLDS_HASH_TABLE_SET_VALUE_OK;
+                        }
+                    }
+                }
+            } while (restart_needed);
+        }
+
+        end_write_operation(clds_split_ordered_hash_table);
+    }
+
+    return result;
+}
+
+CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* clds_split_ordered_hash_table_find(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+{
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* result;
+
+    if (
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_050: [ If clds_split_ordered_hash_table, clds_hazard_pointers_thread or key is NULL, clds_split_ordered_hash_table_find shall fail and return NULL. ]*/
+        (clds_split_ordered_hash_table == NULL) ||
+        (clds_hazard_pointers_thread == NULL) ||
+        (key == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, void* key=%p",
+            clds_split_ordered_hash_table, clds_hazard_pointers_thread, key);
+        result = NULL;
+    }
+    else
+    {
+        uint64_t hash = clds_split_ordered_hash_table->compute_hash(key);
+        CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* bucket_node = get_bucket_node_for_hash(clds_split_ordered_hash_table, clds_hazard_pointers_thread, hash);
+        if (bucket_node == NULL)
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_053: [ If any error occurs, clds_split_ordered_hash_table_find shall fail and return NULL. ]*/
+            LogError("Cannot get the bucket for hash %" PRIu64 "", hash);
+            result = NULL;
+        }
+        else
+        {
+            LIST_POSITION position;
+            bool found;
+
+            if (find_position(clds_split_ordered_hash_table, clds_hazard_pointers_thread, bucket_node, get_item_split_order_key(hash), key, &position, &found) != 0)
+            {
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_053: [ If any error occurs, clds_split_ordered_hash_table_find shall fail and return NULL. ]*/
+                LogError("Cannot find the position of the key in the list");
+                result = NULL;
+            }
+            else
+            {
+                if (found)
+                {
+                    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_051: [ clds_split_ordered_hash_table_find shall look up the key starting at the dummy node of its bucket and return the item with its reference count incremented. ]*/
+                    (void)interlocked_increment(&position.current->ref_count);
+                    result = position.current;
+                }
+                else
+                {
+                    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_052: [ If the key is not found, clds_split_ordered_hash_table_find shall return NULL. ]*/
+                    result = NULL;
+                }
+
+                release_position(clds_hazard_pointers_thread, &position);
+            }
+        }
+    }
+
+    return result;
+}
+
+CLDS_HASH_TABLE_SNAPSHOT_RESULT clds_split_ordered_hash_table_snapshot(CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*** items, uint64_t* item_count)
+{
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result;
+
+    if (
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_060: [ If clds_split_ordered_hash_table, clds_hazard_pointers_thread, items or item_count is NULL, clds_split_ordered_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+        (clds_split_ordered_hash_table == NULL) ||
+        (clds_hazard_pointers_thread == NULL) ||
+        (items == NULL) ||
+        (item_count == NULL)
+        )
+    {
+        LogError("Invalid arguments: CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE clds_split_ordered_hash_table=%p, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread=%p, CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*** items=%p, uint64_t* item_count=%p",
+            clds_split_ordered_hash_table, clds_hazard_pointers_thread, items, item_count);
+        result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+    }
+    else
+    {
+        internal_lock_writes(clds_split_ordered_hash_table);
+
+        // with the writes locked the item count is exact
+        uint64_t temp_item_count = (uint64_t)interlocked_add(&clds_split_ordered_hash_table->item_count, 0);
+        if (temp_item_count == 0)
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_062: [ If there are no items, clds_split_ordered_hash_table_snapshot shall set items to NULL and item_count to 0 and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+            *items = NULL;
+            *item_count = 0;
+            result = CLDS_HASH_TABLE_SNAPSHOT_OK;
+        }
+        else
+        {
+            /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_063: [ clds_split_ordered_hash_table_snapshot shall allocate an array of CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* and fill it with the items in the list. ]*/
+            CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** items_to_return = malloc_2((size_t)temp_item_count, sizeof(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*));
+            if (items_to_return == NULL)
+            {
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_067: [ If there are any other failures then clds_split_ordered_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                LogError("malloc_2((size_t)temp_item_count=%zu, sizeof(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*)=%zu) failed for the items to return",
+                    (size_t)temp_item_count, sizeof(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*));
+                result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+            }
+            else if (collect_items(clds_split_ordered_hash_table, clds_hazard_pointers_thread, items_to_return, temp_item_count) != 0)
+            {
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_067: [ If there are any other failures then clds_split_ordered_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+                LogError("Cannot collect the %" PRIu64 " items of the table", temp_item_count);
+                free(items_to_return);
+                result = CLDS_HASH_TABLE_SNAPSHOT_ERROR;
+            }
+            else
+            {
+                /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_065: [ clds_split_ordered_hash_table_snapshot shall store the allocated array of items in items and the count in item_count and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+                *items = items_to_return;
+                *item_count = temp_item_count;
+                result = CLDS_HASH_TABLE_SNAPSHOT_OK;
+            }
+        }
+
+        internal_unlock_writes(clds_split_ordered_hash_table);
+    }
+
+    return result;
+}
+
+CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* clds_split_ordered_hash_table_node_create(size_t node_size, SPLIT_ORDERED_HASH_TABLE_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context)
+{
+    /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_070: [ item_cleanup_callback and item_cleanup_callback_context shall be allowed to be NULL. ]*/
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* result = malloc(node_size);
+    if (result == NULL)
+    {
+        LogError("malloc(node_size=%zu) failed", node_size);
+    }
+    else
+    {
+        result->item_cleanup_callback = item_cleanup_callback;
+        result->item_cleanup_callback_context = item_cleanup_callback_context;
+        result->key = NULL;
+        result->split_order_key = 0;
+        (void)interlocked_exchange(&result->ref_count, 1);
+        (void)interlocked_exchange_pointer((void* volatile_atomic*)&result->next, NULL);
+        CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(result);
+    }
+
+    return result;
+}
+
+int clds_split_ordered_hash_table_node_inc_ref(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item)
+{
+    int result;
+
+    if (item == NULL)
+    {
+        LogError("Invalid arguments: CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item=%p", item);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        (void)interlocked_increment(&item->ref_count);
+        result = 0;
+    }
+
+    return result;
+}
+
+void clds_split_ordered_hash_table_node_release(CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item)
+{
+    if (item == NULL)
+    {
+        LogError("Invalid arguments: CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item=%p", item);
+    }
+    else
+    {
+        /* Codes_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_071: [ When the reference count of an item reaches 0, item_cleanup_callback shall be called (if not NULL) and the item shall be freed. ]*/
+        internal_node_destroy(item);
+    }
+}
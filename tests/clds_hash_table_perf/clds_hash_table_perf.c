@@ -3,25 +3,37 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <stdbool.h>
 
 #include "c_logging/logger.h"
 
 #include "c_pal/threadapi.h"
 #include "c_pal/timer.h"
+#include "c_pal/sysinfo.h"
 #include "c_pal/gballoc_hl.h"
 #include "c_pal/gballoc_hl_redirect.h"
+#include "c_pal/sync.h"
 #include "c_pal/uuid.h"
 
 #include "c_util/uuid_string.h"
 
 #include "clds/clds_hash_table.h"
+#include "clds/clds_split_ordered_hash_table.h"
+#include "clds/clds_open_addressing_hash_table.h"
+#include "clds/clds_typed_hash_table.h"
 
 #include "clds_hash_table_perf.h"
 #include "test_hash_func.h"
 
 #define THREAD_COUNT 8
 #define INSERT_COUNT 100000
+// the oversubscribed test runs this many threads per core
+#define OVERSUBSCRIBED_THREADS_PER_CORE 4
+#define MAX_THREAD_COUNT 256
+// the batched find test fills a table that is bigger than the last level cache, so that the lookups miss the cache
+#define FIND_BATCH_ITEM_COUNT (1024 * 1024)
+#define FIND_BATCH_KEY_COUNT 32
 
 typedef struct TEST_ITEM_TAG
 {
@@ -29,11 +41,265 @@ typedef struct TEST_ITEM_TAG
 } TEST_ITEM;
 
 DECLARE_HASH_TABLE_NODE_TYPE(TEST_ITEM)
+DECLARE_SPLIT_ORDERED_HASH_TABLE_NODE_TYPE(TEST_ITEM)
+DECLARE_OPEN_ADDRESSING_HASH_TABLE_NODE_TYPE(TEST_ITEM)
+
+// the operations of a hash table engine, so that the same test runs against all the engines
+typedef struct HASH_TABLE_ENGINE_TAG
+{
+    void* (*create)(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* sequence_number);
+    void (*destroy)(void* hash_table);
+    void* (*node_create)(void);
+    void (*node_release)(void* item);
+    TEST_ITEM* (*get_value)(void* item);
+    bool (*insert)(void* hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, void* item);
+    bool (*delete)(void* hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key);
+    void* (*find)(void* hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key);
+} HASH_TABLE_ENGINE;
+
+static void* clds_hash_table_engine_create(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* sequence_number)
+{
+    return clds_hash_table_create(compute_hash, key_compare_func, initial_bucket_size, clds_hazard_pointers, sequence_number, NULL, NULL);
+}
+
+static void clds_hash_table_engine_destroy(void* hash_table)
+{
+    clds_hash_table_destroy(hash_table);
+}
+
+static void* clds_hash_table_engine_node_create(void)
+{
+    return CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+}
+
+static void clds_hash_table_engine_node_release(void* item)
+{
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+static TEST_ITEM* clds_hash_table_engine_get_value(void* item)
+{
+    return CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, item);
+}
+
+static bool clds_hash_table_engine_insert(void* hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, void* item)
+{
+    return clds_hash_table_insert(hash_table, clds_hazard_pointers_thread, key, item, NULL) == CLDS_HASH_TABLE_INSERT_OK;
+}
+
+static bool clds_hash_table_engine_delete(void* hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+{
+    return clds_hash_table_delete(hash_table, clds_hazard_pointers_thread, key, NULL) == CLDS_HASH_TABLE_DELETE_OK;
+}
+
+static void* clds_hash_table_engine_find(void* hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+{
+    return clds_hash_table_find(hash_table, clds_hazard_pointers_thread, key);
+}
+
+static const HASH_TABLE_ENGINE clds_hash_table_engine =
+{
+    clds_hash_table_engine_create,
+    clds_hash_table_engine_destroy,
+    clds_hash_table_engine_node_create,
+    clds_hash_table_engine_node_release,
+    clds_hash_table_engine_get_value,
+    clds_hash_table_engine_insert,
+    clds_hash_table_engine_delete,
+    clds_hash_table_engine_find
+};
+
+static void* split_ordered_engine_create(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* sequence_number)
+{
+    return clds_split_ordered_hash_table_create(compute_hash, key_compare_func, initial_bucket_size, clds_hazard_pointers, sequence_number, NULL, NULL);
+}
+
+static void split_ordered_engine_destroy(void* hash_table)
+{
+    clds_split_ordered_hash_table_destroy(hash_table);
+}
+
+static void* split_ordered_engine_node_create(void)
+{
+    return CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+}
+
+static void split_ordered_engine_node_release(void* item)
+{
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+static TEST_ITEM* split_ordered_engine_get_value(void* item)
+{
+    return CLDS_SPLIT_ORDERED_HASH_TABLE_GET_VALUE(TEST_ITEM, item);
+}
+
+static bool split_ordered_engine_insert(void* hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, void* item)
+{
+    return clds_split_ordered_hash_table_insert(hash_table, clds_hazard_pointers_thread, key, item, NULL) == CLDS_HASH_TABLE_INSERT_OK;
+}
+
+static bool split_ordered_engine_delete(void* hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+{
+    return clds_split_ordered_hash_table_delete(hash_table, clds_hazard_pointers_thread, key, NULL) == CLDS_HASH_TABLE_DELETE_OK;
+}
+
+static void* split_ordered_engine_find(void* hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+{
+    return clds_split_ordered_hash_table_find(hash_table, clds_hazard_pointers_thread, key);
+}
+
+static const HASH_TABLE_ENGINE split_ordered_engine =
+{
+    split_ordered_engine_create,
+    split_ordered_engine_destroy,
+    split_ordered_engine_node_create,
+    split_ordered_engine_node_release,
+    split_ordered_engine_get_value,
+    split_ordered_engine_insert,
+    split_ordered_engine_delete,
+    split_ordered_engine_find
+};
+
+static void* open_addressing_engine_create(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* sequence_number)
+{
+    (void)initial_bucket_size;
+    // the open addressing table does not grow, so size it for all the items the test inserts at half load
+    return clds_open_addressing_hash_table_create(compute_hash, key_compare_func, THREAD_COUNT * INSERT_COUNT * 2, clds_hazard_pointers, sequence_number);
+}
+
+static void open_addressing_engine_destroy(void* hash_table)
+{
+    clds_open_addressing_hash_table_destroy(hash_table);
+}
+
+static void* open_addressing_engine_node_create(void)
+{
+    return CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+}
+
+static void open_addressing_engine_node_release(void* item)
+{
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+static TEST_ITEM* open_addressing_engine_get_value(void* item)
+{
+    return CLDS_OPEN_ADDRESSING_HASH_TABLE_GET_VALUE(TEST_ITEM, item);
+}
+
+static bool open_addressing_engine_insert(void* hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, void* item)
+{
+    return clds_open_addressing_hash_table_insert(hash_table, clds_hazard_pointers_thread, key, item, NULL) == CLDS_HASH_TABLE_INSERT_OK;
+}
+
+static bool open_addressing_engine_delete(void* hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+{
+    return clds_open_addressing_hash_table_delete(hash_table, clds_hazard_pointers_thread, key, NULL) == CLDS_HASH_TABLE_DELETE_OK;
+}
+
+static void* open_addressing_engine_find(void* hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+{
+    return clds_open_addressing_hash_table_find(hash_table, clds_hazard_pointers_thread, key);
+}
+
+static const HASH_TABLE_ENGINE open_addressing_engine =
+{
+    open_addressing_engine_create,
+    open_addressing_engine_destroy,
+    open_addressing_engine_node_create,
+    open_addressing_engine_node_release,
+    open_addressing_engine_get_value,
+    open_addressing_engine_insert,
+    open_addressing_engine_delete,
+    open_addressing_engine_find
+};
+
+// the typed table keeps the key string pointer in the item and calls the hash and compare functions directly
+typedef const char* TYPED_TEST_KEY;
+
+static inline uint64_t typed_test_key_hash(const TYPED_TEST_KEY* key)
+{
+    return test_compute_hash((void*)*key);
+}
+
+static inline bool typed_test_key_equal(const TYPED_TEST_KEY* key_1, const TYPED_TEST_KEY* key_2)
+{
+    return strcmp(*key_1, *key_2) == 0;
+}
+
+DECLARE_CLDS_HASH_TABLE_TYPE(TYPED_TEST_TABLE, TYPED_TEST_KEY)
+DEFINE_CLDS_HASH_TABLE_TYPE(TYPED_TEST_TABLE, TYPED_TEST_KEY, typed_test_key_hash, typed_test_key_equal)
+DECLARE_CLDS_HASH_TABLE_TYPE_NODE_TYPE(TYPED_TEST_TABLE, TEST_ITEM)
+
+static void* typed_engine_create(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* sequence_number)
+{
+    (void)compute_hash;
+    (void)key_compare_func;
+    (void)initial_bucket_size;
+    // same sizing as the open addressing engine
+    return TYPED_TEST_TABLE_create(THREAD_COUNT * INSERT_COUNT * 2, clds_hazard_pointers, sequence_number);
+}
+
+static void typed_engine_destroy(void* hash_table)
+{
+    TYPED_TEST_TABLE_destroy(hash_table);
+}
+
+static void* typed_engine_node_create(void)
+{
+    // the key is only known at insert time
+    TYPED_TEST_KEY key = NULL;
+    return CLDS_HASH_TABLE_TYPE_NODE_CREATE(TYPED_TEST_TABLE, TEST_ITEM, &key, NULL, NULL);
+}
+
+static void typed_engine_node_release(void* item)
+{
+    CLDS_HASH_TABLE_TYPE_NODE_RELEASE(TYPED_TEST_TABLE, item);
+}
+
+static TEST_ITEM* typed_engine_get_value(void* item)
+{
+    return CLDS_HASH_TABLE_TYPE_GET_VALUE(TYPED_TEST_TABLE, TEST_ITEM, item);
+}
+
+static bool typed_engine_insert(void* hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, void* item)
+{
+    TYPED_TEST_TABLE_ITEM* typed_item = item;
+    typed_item->key = key;
+    return TYPED_TEST_TABLE_insert(hash_table, clds_hazard_pointers_thread, typed_item, NULL) == CLDS_HASH_TABLE_INSERT_OK;
+}
+
+static bool typed_engine_delete(void* hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+{
+    TYPED_TEST_KEY typed_key = key;
+    return TYPED_TEST_TABLE_delete(hash_table, clds_hazard_pointers_thread, &typed_key, NULL) == CLDS_HASH_TABLE_DELETE_OK;
+}
+
+static void* typed_engine_find(void* hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key)
+{
+    TYPED_TEST_KEY typed_key = key;
+    return TYPED_TEST_TABLE_find(hash_table, clds_hazard_pointers_thread, &typed_key);
+}
+
+static const HASH_TABLE_ENGINE typed_engine =
+{
+    typed_engine_create,
+    typed_engine_destroy,
+    typed_engine_node_create,
+    typed_engine_node_release,
+    typed_engine_get_value,
+    typed_engine_insert,
+    typed_engine_delete,
+    typed_engine_find
+};
 
 typedef struct THREAD_DATA_TAG
 {
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_ITEM* items[INSERT_COUNT];
+    const HASH_TABLE_ENGINE* engine;
+    void* hash_table;
+    void* items[INSERT_COUNT];
+    size_t insert_count;
     double runtime;
     CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
 } THREAD_DATA;
@@ -45,17 +311,17 @@ static int insert_thread(void* arg)
     int result;
 
     double start_time = timer_global_get_elapsed_ms();
-    for (i = 0; i < INSERT_COUNT; i++)
+    for (i = 0; i < thread_data->insert_count; i++)
     {
-        TEST_ITEM* test_item = CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, thread_data->items[i]);
-        if (clds_hash_table_insert(thread_data->hash_table, thread_data->clds_hazard_pointers_thread, test_item->key, thread_data->items[i], NULL) != CLDS_HASH_TABLE_INSERT_OK)
+        TEST_ITEM* test_item = thread_data->engine->get_value(thread_data->items[i]);
+        if (!thread_data->engine->insert(thread_data->hash_table, thread_data->clds_hazard_pointers_thread, test_item->key, thread_data->items[i]))
         {
             LogError("Error inserting");
             break;
         }
     }
 
-    if (i < INSERT_COUNT)
+    if (i < thread_data->insert_count)
     {
         LogError("Error in test");
         result = MU_FAILURE;
@@ -76,17 +342,17 @@ static int delete_thread(void* arg)
     int result;
 
     double start_time = timer_global_get_elapsed_ms();
-    for (i = 0; i < INSERT_COUNT; i++)
+    for (i = 0; i < thread_data->insert_count; i++)
     {
-        TEST_ITEM* test_item = CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, thread_data->items[i]);
-        if (clds_hash_table_delete(thread_data->hash_table, thread_data->clds_hazard_pointers_thread, test_item->key, NULL) != CLDS_HASH_TABLE_DELETE_OK)
+        TEST_ITEM* test_item = thread_data->engine->get_value(thread_data->items[i]);
+        if (!thread_data->engine->delete(thread_data->hash_table, thread_data->clds_hazard_pointers_thread, test_item->key))
         {
             LogError("Error deleting");
             break;
         }
     }
 
-    if (i < INSERT_COUNT)
+    if (i < thread_data->insert_count)
     {
         LogError("Error in test");
         result = MU_FAILURE;
@@ -107,10 +373,10 @@ static int find_thread(void* arg)
     int result;
 
     double start_time = timer_global_get_elapsed_ms();
-    for (i = 0; i < INSERT_COUNT; i++)
+    for (i = 0; i < thread_data->insert_count; i++)
     {
-        TEST_ITEM* test_item = CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, thread_data->items[i]);
-        CLDS_HASH_TABLE_ITEM* found_item = clds_hash_table_find(thread_data->hash_table, thread_data->clds_hazard_pointers_thread, test_item->key);
+        TEST_ITEM* test_item = thread_data->engine->get_value(thread_data->items[i]);
+        void* found_item = thread_data->engine->find(thread_data->hash_table, thread_data->clds_hazard_pointers_thread, test_item->key);
         if (found_item == NULL)
         {
             LogError("Error finding");
@@ -118,11 +384,11 @@ static int find_thread(void* arg)
         }
         else
         {
-            CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+            thread_data->engine->node_release(found_item);
         }
     }
 
-    if (i < INSERT_COUNT)
+    if (i < thread_data->insert_count)
     {
         LogError("Error in test");
         result = MU_FAILURE;
@@ -141,24 +407,39 @@ static int key_compare_func(void* key_1, void* key_2)
     return strcmp((const char*)key_1, (const char*)key_2);
 }
 
-int clds_hash_table_perf_main(void)
+static void run_hash_table_test(const char* test_name, const HASH_TABLE_ENGINE* engine, CLDS_HAZARD_POINTERS_RECLAMATION_MODE reclamation_mode, uint32_t slot_count, bool use_asymmetric_fence, uint32_t thread_count)
 {
     CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    THREAD_HANDLE threads[THREAD_COUNT];
+    void* hash_table;
+    THREAD_HANDLE threads[MAX_THREAD_COUNT];
+    // the total number of operations is the same for any thread count, so that the runs can be compared
+    size_t insert_count = ((size_t)INSERT_COUNT * THREAD_COUNT) / thread_count;
     THREAD_DATA* thread_data;
     size_t i;
     size_t j;
 
-    clds_hazard_pointers = clds_hazard_pointers_create();
+    clds_hazard_pointers = clds_hazard_pointers_create_with_mode(reclamation_mode);
     if (clds_hazard_pointers == NULL)
     {
         LogError("Error creating hazard pointers");
     }
+    else if (clds_hazard_pointers_set_slot_count(clds_hazard_pointers, slot_count) != 0)
+    {
+        LogError("Error setting slot count to %" PRIu32 "", slot_count);
+        clds_hazard_pointers_destroy(clds_hazard_pointers);
+    }
+    else if (
+        use_asymmetric_fence &&
+        (clds_hazard_pointers_enable_asymmetric_fence(clds_hazard_pointers) != 0)
+        )
+    {
+        LogInfo("%s: asymmetric fence not available, skipping test", test_name);
+        clds_hazard_pointers_destroy(clds_hazard_pointers);
+    }
     else
     {
         volatile_atomic int64_t sequence_number;
-        hash_table = clds_hash_table_create(test_compute_hash, key_compare_func, 1024, clds_hazard_pointers, &sequence_number, NULL, NULL);
+        hash_table = engine->create(test_compute_hash, key_compare_func, 1024, clds_hazard_pointers, &sequence_number);
         if (hash_table == NULL)
         {
             LogError("Error creating hash table");
@@ -167,21 +448,23 @@ int clds_hash_table_perf_main(void)
         {
             LogInfo("Generating data");
 
-            thread_data = malloc_2(THREAD_COUNT, sizeof(THREAD_DATA));
+            thread_data = malloc_2(thread_count, sizeof(THREAD_DATA));
             if (thread_data == NULL)
             {
                 LogError("Error allocating thread data array");
             }
             else
             {
-                for (i = 0; i < THREAD_COUNT; i++)
+                for (i = 0; i < thread_count; i++)
                 {
                     thread_data[i].clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+                    thread_data[i].engine = engine;
                     thread_data[i].hash_table = hash_table;
+                    thread_data[i].insert_count = insert_count;
 
-                    for (j = 0; j < INSERT_COUNT; j++)
+                    for (j = 0; j < insert_count; j++)
                     {
-                        thread_data[i].items[j] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+                        thread_data[i].items[j] = engine->node_create();
                         if (thread_data[i].items[j] == NULL)
                         {
                             LogError("Error allocating test item");
@@ -204,7 +487,7 @@ int clds_hash_table_perf_main(void)
                                 }
                                 else
                                 {
-                                    TEST_ITEM* test_item = CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, thread_data[i].items[j]);
+                                    TEST_ITEM* test_item = engine->get_value(thread_data[i].items[j]);
                                     (void)sprintf(test_item->key, "%s", uuid_string);
                                     free(uuid_string);
                                 }
@@ -212,18 +495,18 @@ int clds_hash_table_perf_main(void)
                         }
                     }
 
-                    if (j < INSERT_COUNT)
+                    if (j < insert_count)
                     {
                         size_t k;
 
                         for (k = 0; k < j; k++)
                         {
-                            CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, thread_data[i].items[k]);
+                            engine->node_release(thread_data[i].items[k]);
                         }
                     }
                 }
 
-                if (i < THREAD_COUNT)
+                if (i < thread_count)
                 {
                     LogError("Error creating test thread data");
                 }
@@ -231,9 +514,9 @@ int clds_hash_table_perf_main(void)
                 {
                     // insert test
 
-                    LogInfo("Starting test");
+                    LogInfo("Starting %s test", test_name);
 
-                    for (i = 0; i < THREAD_COUNT; i++)
+                    for (i = 0; i < thread_count; i++)
                     {
                         if (ThreadAPI_Create(&threads[i], insert_thread, &thread_data[i]) != THREADAPI_OK)
                         {
@@ -242,7 +525,7 @@ int clds_hash_table_perf_main(void)
                         }
                     }
 
-                    if (i < THREAD_COUNT)
+                    if (i < thread_count)
                     {
                         for (j = 0; j < i; j++)
                         {
@@ -255,7 +538,7 @@ int clds_hash_table_perf_main(void)
                         bool is_error = false;
                         double runtime = 0.0;
 
-                        for (i = 0; i < THREAD_COUNT; i++)
+                        for (i = 0; i < thread_count; i++)
                         {
                             int thread_result;
                             (void)ThreadAPI_Join(threads[i], &thread_result);
@@ -271,14 +554,15 @@ int clds_hash_table_perf_main(void)
 
                         if (!is_error)
                         {
-                            LogInfo("Insert test done in %.02f ms, %.02f inserts/s/thread, %.02f inserts/s on all threads",
+                            LogInfo("%s: Insert test done in %.02f ms, %.02f inserts/s/thread, %.02f inserts/s on all threads",
+                                test_name,
                                 runtime,
-                                ((double)THREAD_COUNT * (double)INSERT_COUNT) / (double)runtime * 1000.0,
-                                ((double)THREAD_COUNT * (double)INSERT_COUNT) / ((double)runtime / THREAD_COUNT) * 1000.0);
+                                ((double)thread_count * (double)insert_count) / (double)runtime * 1000.0,
+                                ((double)thread_count * (double)insert_count) / ((double)runtime / thread_count) * 1000.0);
 
                             // find test
 
-                            for (i = 0; i < THREAD_COUNT; i++)
+                            for (i = 0; i < thread_count; i++)
                             {
                                 if (ThreadAPI_Create(&threads[i], find_thread, &thread_data[i]) != THREADAPI_OK)
                                 {
@@ -287,7 +571,7 @@ int clds_hash_table_perf_main(void)
                                 }
                             }
 
-                            if (i < THREAD_COUNT)
+                            if (i < thread_count)
                             {
                                 for (j = 0; j < i; j++)
                                 {
@@ -300,7 +584,7 @@ int clds_hash_table_perf_main(void)
                                 is_error = false;
                                 runtime = 0;
 
-                                for (i = 0; i < THREAD_COUNT; i++)
+                                for (i = 0; i < thread_count; i++)
                                 {
                                     int thread_result;
                                     (void)ThreadAPI_Join(threads[i], &thread_result);
@@ -316,15 +600,16 @@ int clds_hash_table_perf_main(void)
 
                                 if (!is_error)
                                 {
-                                    LogInfo("Find test done in %.02f ms, %.02f finds/s/thread, %.02f finds/s on all threads",
+                                    LogInfo("%s: Find test done in %.02f ms, %.02f finds/s/thread, %.02f finds/s on all threads",
+                                        test_name,
                                         runtime,
-                                        ((double)THREAD_COUNT * (double)INSERT_COUNT) / (double)runtime * 1000.0,
-                                        ((double)THREAD_COUNT * (double)INSERT_COUNT) / ((double)runtime / THREAD_COUNT) * 1000.0);
+                                        ((double)thread_count * (double)insert_count) / (double)runtime * 1000.0,
+                                        ((double)thread_count * (double)insert_count) / ((double)runtime / thread_count) * 1000.0);
                                 }
 
                                 // delete test
 
-                                for (i = 0; i < THREAD_COUNT; i++)
+                                for (i = 0; i < thread_count; i++)
                                 {
                                     if (ThreadAPI_Create(&threads[i], delete_thread, &thread_data[i]) != THREADAPI_OK)
                                     {
@@ -333,7 +618,7 @@ int clds_hash_table_perf_main(void)
                                     }
                                 }
 
-                                if (i < THREAD_COUNT)
+                                if (i < thread_count)
                                 {
                                     for (j = 0; j < i; j++)
                                     {
@@ -346,7 +631,7 @@ int clds_hash_table_perf_main(void)
                                     is_error = false;
                                     runtime = 0;
 
-                                    for (i = 0; i < THREAD_COUNT; i++)
+                                    for (i = 0; i < thread_count; i++)
                                     {
                                         int thread_result;
                                         (void)ThreadAPI_Join(threads[i], &thread_result);
@@ -362,17 +647,18 @@ int clds_hash_table_perf_main(void)
 
                                     if (!is_error)
                                     {
-                                        LogInfo("Delete test done in %.02f ms, %.02f deletes/s/thread, %.02f deletes/s on all threads",
+                                        LogInfo("%s: Delete test done in %.02f ms, %.02f deletes/s/thread, %.02f deletes/s on all threads",
+                                            test_name,
                                             runtime,
-                                            ((double)THREAD_COUNT * (double)INSERT_COUNT) / (double)runtime * 1000.0,
-                                            ((double)THREAD_COUNT * (double)INSERT_COUNT) / ((double)runtime / THREAD_COUNT) * 1000.0);
+                                            ((double)thread_count * (double)insert_count) / (double)runtime * 1000.0,
+                                            ((double)thread_count * (double)insert_count) / ((double)runtime / thread_count) * 1000.0);
                                     }
                                 }
                             }
                         }
                     }
 
-                    for (i = 0; i < THREAD_COUNT; i++)
+                    for (i = 0; i < thread_count; i++)
                     {
                         clds_hazard_pointers_unregister_thread(thread_data[i].clds_hazard_pointers_thread);
                     }
@@ -381,11 +667,200 @@ int clds_hash_table_perf_main(void)
                 }
             }
 
-            clds_hash_table_destroy(hash_table);
+            engine->destroy(hash_table);
+        }
+
+        clds_hazard_pointers_destroy(clds_hazard_pointers);
+    }
+}
+
+static void run_find_batch_test(void)
+{
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    if (clds_hazard_pointers == NULL)
+    {
+        LogError("Error creating hazard pointers");
+    }
+    else
+    {
+        CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+        if (clds_hazard_pointers_thread == NULL)
+        {
+            LogError("Error registering hazard pointers thread");
+        }
+        else
+        {
+            // enough buckets for all the items, so that the table does not grow while it is filled
+            CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, key_compare_func, FIND_BATCH_ITEM_COUNT, clds_hazard_pointers, NULL, NULL, NULL);
+            if (hash_table == NULL)
+            {
+                LogError("Error creating hash table");
+            }
+            else
+            {
+                CLDS_HASH_TABLE_ITEM** items = malloc_2(FIND_BATCH_ITEM_COUNT, sizeof(CLDS_HASH_TABLE_ITEM*));
+                if (items == NULL)
+                {
+                    LogError("Error allocating items array");
+                }
+                else
+                {
+                    size_t i;
+
+                    LogInfo("Generating data for the batched find test");
+
+                    for (i = 0; i < FIND_BATCH_ITEM_COUNT; i++)
+                    {
+                        items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+                        if (items[i] == NULL)
+                        {
+                            LogError("Error allocating test item");
+                            break;
+                        }
+
+                        TEST_ITEM* test_item = CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, items[i]);
+                        (void)sprintf(test_item->key, "%zu", i);
+                        if (clds_hash_table_insert(hash_table, clds_hazard_pointers_thread, test_item->key, items[i], NULL) != CLDS_HASH_TABLE_INSERT_OK)
+                        {
+                            LogError("Error inserting");
+                            CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+                            break;
+                        }
+                    }
+
+                    if (i < FIND_BATCH_ITEM_COUNT)
+                    {
+                        LogError("Error in test");
+                    }
+                    else
+                    {
+                        // look the keys up in a random order, so that consecutive lookups do not touch the same cache lines
+                        uint64_t random_state = 0x9E3779B97F4A7C15;
+                        for (i = FIND_BATCH_ITEM_COUNT - 1; i > 0; i--)
+                        {
+                            random_state ^= random_state << 13;
+                            random_state ^= random_state >> 7;
+                            random_state ^= random_state << 17;
+                            size_t j = (size_t)(random_state % (i + 1));
+                            CLDS_HASH_TABLE_ITEM* temp = items[i];
+                            items[i] = items[j];
+                            items[j] = temp;
+                        }
+
+                        LogInfo("Starting batched find test");
+
+                        double start_time = timer_global_get_elapsed_ms();
+                        for (i = 0; i < FIND_BATCH_ITEM_COUNT; i++)
+                        {
+                            CLDS_HASH_TABLE_ITEM* found_item = clds_hash_table_find(hash_table, clds_hazard_pointers_thread, CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, items[i])->key);
+                            if (found_item == NULL)
+                            {
+                                LogError("Error finding");
+                                break;
+                            }
+
+                            CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+                        }
+                        double single_find_runtime = timer_global_get_elapsed_ms() - start_time;
+
+                        if (i < FIND_BATCH_ITEM_COUNT)
+                        {
+                            LogError("Error in test");
+                        }
+                        else
+                        {
+                            void* keys[FIND_BATCH_KEY_COUNT];
+                            CLDS_HASH_TABLE_ITEM* found_items[FIND_BATCH_KEY_COUNT];
+                            bool is_error = false;
+
+                            start_time = timer_global_get_elapsed_ms();
+                            for (i = 0; (i < FIND_BATCH_ITEM_COUNT) && !is_error; i += FIND_BATCH_KEY_COUNT)
+                            {
+                                uint32_t key_count = ((FIND_BATCH_ITEM_COUNT - i) < FIND_BATCH_KEY_COUNT) ? (uint32_t)(FIND_BATCH_ITEM_COUNT - i) : FIND_BATCH_KEY_COUNT;
+                                uint32_t j;
+
+                                for (j = 0; j < key_count; j++)
+                                {
+                                    keys[j] = CLDS_HASH_TABLE_GET_VALUE(TEST_ITEM, items[i + j])->key;
+                                }
+
+                                if (clds_hash_table_find_batch(hash_table, clds_hazard_pointers_thread, keys, key_count, found_items) != 0)
+                                {
+                                    LogError("Error finding batch");
+                                    is_error = true;
+                                }
+                                else
+                                {
+                                    for (j = 0; j < key_count; j++)
+                                    {
+                                        if (found_items[j] == NULL)
+                                        {
+                                            LogError("Error finding");
+                                            is_error = true;
+                                        }
+                                        else
+                                        {
+                                            CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_items[j]);
+                                        }
+                                    }
+                                }
+                            }
+                            double batch_find_runtime = timer_global_get_elapsed_ms() - start_time;
+
+                            if (!is_error)
+                            {
+                                LogInfo("Find of %d items one at a time done in %.02f ms, %.02f finds/s",
+                                    FIND_BATCH_ITEM_COUNT,
+                                    single_find_runtime,
+                                    (double)FIND_BATCH_ITEM_COUNT / single_find_runtime * 1000.0);
+                                LogInfo("Find of %d items in batches of %d done in %.02f ms, %.02f finds/s, %.02fx the finds one at a time",
+                                    FIND_BATCH_ITEM_COUNT,
+                                    FIND_BATCH_KEY_COUNT,
+                                    batch_find_runtime,
+                                    (double)FIND_BATCH_ITEM_COUNT / batch_find_runtime * 1000.0,
+                                    single_find_runtime / batch_find_runtime);
+                            }
+                        }
+                    }
+
+                    free(items);
+                }
+
+                // the table owns the inserted items
+                clds_hash_table_destroy(hash_table);
+            }
+
+            clds_hazard_pointers_unregister_thread(clds_hazard_pointers_thread);
         }
 
         clds_hazard_pointers_destroy(clds_hazard_pointers);
     }
+}
+
+int clds_hash_table_perf_main(void)
+{
+    run_hash_table_test("hazard pointers", &clds_hash_table_engine, CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS, 0, false, THREAD_COUNT);
+    // the find test shows the cost of publishing hazard pointers with and without the fence on the reader side
+    run_hash_table_test("hazard pointers, 4 slots", &clds_hash_table_engine, CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS, 4, false, THREAD_COUNT);
+    run_hash_table_test("hazard pointers, 4 slots, asymmetric fence", &clds_hash_table_engine, CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS, 4, true, THREAD_COUNT);
+    run_hash_table_test("epoch based", &clds_hash_table_engine, CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH_BASED, 0, false, THREAD_COUNT);
+    run_hash_table_test("interval based", &clds_hash_table_engine, CLDS_HAZARD_POINTERS_RECLAMATION_MODE_INTERVAL_BASED, 0, false, THREAD_COUNT);
+    // same workload on the split ordered list engine, which grows without migrating items
+    run_hash_table_test("split ordered, hazard pointers", &split_ordered_engine, CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS, 0, false, THREAD_COUNT);
+    // same workload on the open addressing engine, where a find compares the tags of a whole group of slots at once
+    run_hash_table_test("open addressing, hazard pointers", &open_addressing_engine, CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS, 0, false, THREAD_COUNT);
+    // same layout with the hash and compare functions inlined and the key stored in the item
+    run_hash_table_test("typed open addressing, hazard pointers", &typed_engine, CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS, 0, false, THREAD_COUNT);
+    // more threads than cores, the table grows while threads that hold inserts in flight are preempted,
+    // which shows how much time the writes that have to wait for those inserts burn
+    uint32_t oversubscribed_thread_count = sysinfo_get_processor_count() * OVERSUBSCRIBED_THREADS_PER_CORE;
+    if (oversubscribed_thread_count > MAX_THREAD_COUNT)
+    {
+        oversubscribed_thread_count = MAX_THREAD_COUNT;
+    }
+    run_hash_table_test("hazard pointers, oversubscribed", &clds_hash_table_engine, CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS, 0, false, oversubscribed_thread_count);
+    // lookups one at a time against lookups in batches that overlap their cache misses
+    run_find_batch_test();
 
     return 0;
 }
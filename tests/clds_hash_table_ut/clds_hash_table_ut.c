@@ -3,6 +3,7 @@
 #include <stdbool.h>
 #include <inttypes.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "macro_utils/macro_utils.h"
 #include "testrunnerswitcher.h"
@@ -20,6 +21,7 @@
 
 #include "c_pal/gballoc_hl.h"
 #include "c_pal/gballoc_hl_redirect.h"
+#include "c_pal/threadapi.h"
 
 #include "clds/clds_sorted_list.h"
 #include "clds/clds_st_hash_set.h"
@@ -44,6 +46,9 @@ IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SORTED_LIST_REMOVE_RESULT, CLDS_SORTED_LIST_REM
 TEST_DEFINE_ENUM_TYPE(CLDS_SORTED_LIST_SET_VALUE_RESULT, CLDS_SORTED_LIST_SET_VALUE_RESULT_VALUES);
 IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_SORTED_LIST_SET_VALUE_RESULT, CLDS_SORTED_LIST_SET_VALUE_RESULT_VALUES);
 
+TEST_DEFINE_ENUM_TYPE(THREADAPI_RESULT, THREADAPI_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(THREADAPI_RESULT, THREADAPI_RESULT_VALUES);
+
 TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_RESULT_VALUES);
 IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_RESULT_VALUES);
 TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_RESULT_VALUES);
@@ -83,9 +88,13 @@ static CLDS_CONDITION_CHECK_RESULT g_condition_check_result = CLDS_CONDITION_CHE
 MOCK_FUNCTION_WITH_CODE(, CLDS_CONDITION_CHECK_RESULT, test_item_condition_check, void*, context, void*, new_key, void*, old_key)
 MOCK_FUNCTION_END(g_condition_check_result)
 
+static size_t g_key_compare_call_count;
+
 static int test_key_compare_func(void* key_1, void* key_2)
 {
     int result;
+
+    g_key_compare_call_count++;
     if (key_1 < key_2)
     {
         result = -1;
@@ -102,6 +111,100 @@ static int test_key_compare_func(void* key_1, void* key_2)
     return result;
 }
 
+static CLDS_HASH_TABLE_ITEM* g_test_item_factory_result;
+static void* g_test_item_factory_item_key;
+static size_t g_test_item_factory_call_count;
+static void* g_test_item_factory_context;
+static void* g_test_item_factory_key;
+
+static CLDS_HASH_TABLE_ITEM* test_item_factory(void* context, void* key, void** item_key)
+{
+    g_test_item_factory_call_count++;
+    g_test_item_factory_context = context;
+    g_test_item_factory_key = key;
+    *item_key = g_test_item_factory_item_key;
+    return g_test_item_factory_result;
+}
+
+// umock_c is not thread safe, so the threads of clds_hash_table_insert_batch run their work synchronously in ThreadAPI_Create
+static THREADAPI_RESULT hook_ThreadAPI_Create(THREAD_HANDLE* threadHandle, THREAD_START_FUNC func, void* arg)
+{
+    *threadHandle = (THREAD_HANDLE)0x4247;
+    (void)func(arg);
+    return THREADAPI_OK;
+}
+
+static size_t count_actual_calls(const char* call_prefix)
+{
+    size_t result = 0;
+    const char* actual_calls = umock_c_get_actual_calls();
+    const char* position = strstr(actual_calls, call_prefix);
+
+    while (position != NULL)
+    {
+        result++;
+        position = strstr(position + 1, call_prefix);
+    }
+
+    return result;
+}
+
+// a write done by the hook of clds_sorted_list_head_get_next (once), while a snapshot at a sequence number walks the buckets
+static CLDS_HASH_TABLE_HANDLE g_write_during_walk_hash_table;
+static CLDS_HAZARD_POINTERS_THREAD_HANDLE g_write_during_walk_thread;
+static void* g_write_during_walk_key;
+// NULL to delete the key, otherwise the item is inserted with the key
+static CLDS_HASH_TABLE_ITEM* g_write_during_walk_item;
+// the number of calls to malloc made by the write
+static size_t g_write_during_walk_malloc_count;
+// when set the key is removed, inserted again with the removed item and removed again
+static bool g_write_during_walk_remove_twice;
+
+static size_t get_actual_call_count(const char* call_prefix)
+{
+    size_t result = 0;
+    const char* actual_calls = umock_c_get_actual_calls();
+    const char* call = strstr(actual_calls, call_prefix);
+    while (call != NULL)
+    {
+        result++;
+        call = strstr(call + strlen(call_prefix), call_prefix);
+    }
+
+    return result;
+}
+
+static int hook_clds_sorted_list_head_get_next(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SORTED_LIST_ITEM** item)
+{
+    if (g_write_during_walk_hash_table != NULL)
+    {
+        CLDS_HASH_TABLE_HANDLE hash_table = g_write_during_walk_hash_table;
+        size_t malloc_count = get_actual_call_count("[malloc(");
+        g_write_during_walk_hash_table = NULL;
+
+        if (g_write_during_walk_remove_twice)
+        {
+            CLDS_HASH_TABLE_ITEM* removed_item;
+            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, clds_hash_table_remove(hash_table, g_write_during_walk_thread, g_write_during_walk_key, &removed_item, NULL));
+            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, g_write_during_walk_thread, g_write_during_walk_key, removed_item, NULL));
+            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, clds_hash_table_remove(hash_table, g_write_during_walk_thread, g_write_during_walk_key, &removed_item, NULL));
+            CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
+        }
+        else if (g_write_during_walk_item == NULL)
+        {
+            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_hash_table_delete(hash_table, g_write_during_walk_thread, g_write_during_walk_key, NULL));
+        }
+        else
+        {
+            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, g_write_during_walk_thread, g_write_during_walk_key, g_write_during_walk_item, NULL));
+        }
+
+        g_write_during_walk_malloc_count = get_actual_call_count("[malloc(") - malloc_count;
+    }
+
+    return real_clds_sorted_list_head_get_next(clds_sorted_list, list_head, clds_hazard_pointers_thread, key, item);
+}
+
 typedef struct TEST_ITEM_TAG
 {
     int dummy;
@@ -123,17 +226,22 @@ TEST_SUITE_INITIALIZE(suite_init)
     REGISTER_CLDS_ST_HASH_SET_GLOBAL_MOCK_HOOKS();
     REGISTER_CLDS_HAZARD_POINTERS_GLOBAL_MOCK_HOOKS();
     REGISTER_CLDS_SORTED_LIST_GLOBAL_MOCK_HOOKS();
+    REGISTER_GLOBAL_MOCK_HOOK(clds_sorted_list_head_get_next, hook_clds_sorted_list_head_get_next);
 
     REGISTER_GBALLOC_HL_GLOBAL_MOCK_HOOK();
+    REGISTER_GLOBAL_MOCK_HOOK(ThreadAPI_Create, hook_ThreadAPI_Create);
+    REGISTER_GLOBAL_MOCK_RETURN(ThreadAPI_Join, THREADAPI_OK);
 
-    REGISTER_GLOBAL_MOCK_FAIL_RETURN(clds_sorted_list_get_count, CLDS_SORTED_LIST_GET_COUNT_ERROR);
-    REGISTER_GLOBAL_MOCK_FAIL_RETURN(clds_sorted_list_get_all, CLDS_SORTED_LIST_GET_ALL_ERROR);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(clds_sorted_list_head_get_count, CLDS_SORTED_LIST_GET_COUNT_ERROR);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(clds_sorted_list_head_get_all, CLDS_SORTED_LIST_GET_ALL_ERROR);
 
     REGISTER_UMOCK_ALIAS_TYPE(RECLAIM_FUNC, void*);
     REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTER_RECORD_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(CLDS_SORTED_LIST_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_THREAD_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(THREAD_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(THREAD_START_FUNC, void*);
     REGISTER_UMOCK_ALIAS_TYPE(SORTED_LIST_ITEM_CLEANUP_CB, void*);
     REGISTER_UMOCK_ALIAS_TYPE(SORTED_LIST_GET_ITEM_KEY_CB, void*);
     REGISTER_UMOCK_ALIAS_TYPE(SORTED_LIST_KEY_COMPARE_CB, void*);
@@ -142,6 +250,7 @@ TEST_SUITE_INITIALIZE(suite_init)
     REGISTER_UMOCK_ALIAS_TYPE(SORTED_LIST_SKIPPED_SEQ_NO_CB, void*);
     REGISTER_UMOCK_ALIAS_TYPE(CLDS_ST_HASH_SET_KEY_COMPARE_FUNC, void*);
     REGISTER_UMOCK_ALIAS_TYPE(CONDITION_CHECK_CB, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(SORTED_LIST_ITEM_FACTORY_CB, void*);
 
     REGISTER_TYPE(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_RESULT);
     REGISTER_TYPE(CLDS_SORTED_LIST_DELETE_RESULT, CLDS_SORTED_LIST_DELETE_RESULT);
@@ -168,6 +277,14 @@ TEST_SUITE_CLEANUP(suite_cleanup)
 TEST_FUNCTION_INITIALIZE(method_init)
 {
     g_condition_check_result = CLDS_CONDITION_CHECK_OK;
+    g_write_during_walk_hash_table = NULL;
+    g_write_during_walk_malloc_count = 0;
+    g_write_during_walk_remove_twice = false;
+    g_test_item_factory_result = NULL;
+    g_test_item_factory_item_key = NULL;
+    g_test_item_factory_call_count = 0;
+    g_test_item_factory_context = NULL;
+    g_test_item_factory_key = NULL;
     umock_c_reset_all_calls();
 }
 
@@ -180,6 +297,7 @@ TEST_FUNCTION_CLEANUP(method_cleanup)
 /* Tests_SRS_CLDS_HASH_TABLE_01_001: [ clds_hash_table_create shall create a new hash table object and on success it shall return a non-NULL handle to the newly created hash table. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_01_027: [ The hash table shall maintain a list of arrays of buckets, so that it can be resized as needed. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_01_058: [ start_sequence_number shall be allowed to be NULL, in which case no sequence number computations shall be performed. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_130: [ clds_hash_table_create shall create the hash table the same way clds_hash_table_create_with_bucket_indexing does with bucket_indexing set to CLDS_HASH_TABLE_BUCKET_INDEXING_MODULO. ]*/
 TEST_FUNCTION(clds_hash_table_create_succeeds)
 {
     // arrange
@@ -190,6 +308,7 @@ TEST_FUNCTION(clds_hash_table_create_succeeds)
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
     // act
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_cb, (void*)0x5556);
@@ -216,6 +335,7 @@ TEST_FUNCTION(clds_hash_table_create_succeeds_with_NULL_skipped_seq_no_cb)
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
     // act
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &sequence_number, NULL, NULL);
@@ -241,6 +361,7 @@ TEST_FUNCTION(clds_hash_table_create_succeeds_with_NULL_sequence_number_and_skip
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
     // act
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
@@ -319,6 +440,32 @@ TEST_FUNCTION(when_allocating_memory_for_the_hash_table_array_fails_clds_hash_ta
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
+/* Tests_SRS_CLDS_HASH_TABLE_01_002: [ If any error happens, clds_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_creating_the_bucket_lists_fails_clds_hash_table_create_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_create(hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, NULL, IGNORED_ARG))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
 /* Tests_SRS_CLDS_HASH_TABLE_01_003: [ If compute_hash is NULL, clds_hash_table_create shall fail and return NULL. ]*/
 TEST_FUNCTION(clds_hash_table_create_with_NULL_compute_hash_function_fails)
 {
@@ -400,9 +547,11 @@ TEST_FUNCTION(two_hash_tables_can_be_created_with_the_same_hazard_pointer_instan
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
     // act
     hash_table_1 = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
@@ -432,9 +581,11 @@ TEST_FUNCTION(two_hash_tables_can_be_created_with_different_hazard_pointer_insta
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
     // act
     hash_table_1 = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers_1, NULL, NULL, NULL);
@@ -463,6 +614,7 @@ TEST_FUNCTION(clds_hash_table_create_with_initial_size_2_succeeds)
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
     // act
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
@@ -477,6 +629,8 @@ TEST_FUNCTION(clds_hash_table_create_with_initial_size_2_succeeds)
 }
 
 /* Tests_SRS_CLDS_HASH_TABLE_01_057: [ start_sequence_number shall be used as the sequence number variable that shall be incremented at every operation that is done on the hash table. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_071: [ The start sequence number passed to clds_hash_table_create shall be passed as the start_sequence_number argument when creating the sorted list. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_124: [ clds_hash_table_create shall create one sorted list by calling clds_sorted_list_create, which provides the key callbacks, the write lock and the sequence numbers for the lists of all the buckets. ]*/
 TEST_FUNCTION(clds_hash_table_create_with_non_NULL_start_sequence_number_succeeds)
 {
     // arrange
@@ -487,6 +641,7 @@ TEST_FUNCTION(clds_hash_table_create_with_non_NULL_start_sequence_number_succeed
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_create(hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, &sequence_number, IGNORED_ARG, IGNORED_ARG));
 
     // act
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &sequence_number, NULL, NULL);
@@ -500,6 +655,135 @@ TEST_FUNCTION(clds_hash_table_create_with_non_NULL_start_sequence_number_succeed
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
+/* clds_hash_table_create_with_bucket_indexing */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_134: [ If bucket_indexing is not one of the CLDS_HASH_TABLE_BUCKET_INDEXING values, clds_hash_table_create_with_bucket_indexing shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_hash_table_create_with_bucket_indexing_with_invalid_bucket_indexing_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    umock_c_reset_all_calls();
+
+    // act
+    hash_table = clds_hash_table_create_with_bucket_indexing(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL, (CLDS_HASH_TABLE_BUCKET_INDEXING)0x42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_135: [ Otherwise clds_hash_table_create_with_bucket_indexing shall create the hash table the same way clds_hash_table_create does, picking the bucket of a key as indicated by bucket_indexing. ]*/
+TEST_FUNCTION(clds_hash_table_create_with_bucket_indexing_with_modulo_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 3, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    hash_table = clds_hash_table_create_with_bucket_indexing(test_compute_hash, test_key_compare_func, 3, hazard_pointers, NULL, NULL, NULL, CLDS_HASH_TABLE_BUCKET_INDEXING_MODULO);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_131: [ If bucket_indexing is CLDS_HASH_TABLE_BUCKET_INDEXING_POWER_OF_TWO, clds_hash_table_create_with_bucket_indexing shall round initial_bucket_size up to a power of two. ]*/
+TEST_FUNCTION(clds_hash_table_create_with_bucket_indexing_with_power_of_two_rounds_up_the_bucket_count)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 4, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    hash_table = clds_hash_table_create_with_bucket_indexing(test_compute_hash, test_key_compare_func, 3, hazard_pointers, NULL, NULL, NULL, CLDS_HASH_TABLE_BUCKET_INDEXING_POWER_OF_TWO);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_133: [ If bucket_indexing is CLDS_HASH_TABLE_BUCKET_INDEXING_POWER_OF_TWO and initial_bucket_size rounded up to a power of two does not fit the bucket count, clds_hash_table_create_with_bucket_indexing shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_hash_table_create_with_bucket_indexing_with_power_of_two_and_a_too_big_bucket_count_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    umock_c_reset_all_calls();
+
+    // act
+    hash_table = clds_hash_table_create_with_bucket_indexing(test_compute_hash, test_key_compare_func, ((size_t)1 << 30) + 1, hazard_pointers, NULL, NULL, NULL, CLDS_HASH_TABLE_BUCKET_INDEXING_POWER_OF_TWO);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_132: [ If bucket_indexing is CLDS_HASH_TABLE_BUCKET_INDEXING_POWER_OF_TWO, the bucket index shall be the hash masked with the bucket count minus 1. ]*/
+TEST_FUNCTION(clds_hash_table_find_with_power_of_two_bucket_indexing_finds_the_inserted_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_ITEM* result_1;
+    CLDS_HASH_TABLE_ITEM* result_2;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create_with_bucket_indexing(test_compute_hash, test_key_compare_func, 4, hazard_pointers, NULL, NULL, NULL, CLDS_HASH_TABLE_BUCKET_INDEXING_POWER_OF_TWO);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    result_1 = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
+    result_2 = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_1, (void*)result_1);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_2, (void*)result_2);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result_1);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result_2);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
 /* clds_hash_table_destroy */
 
 /* Tests_SRS_CLDS_HASH_TABLE_01_006: [ clds_hash_table_destroy shall free all resources associated with the hash table instance. ]*/
@@ -511,7 +795,10 @@ TEST_FUNCTION(clds_hash_table_destroy_frees_the_hash_table_resources)
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_clear(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_clear(IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_destroy(IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
     // act
@@ -540,29 +827,27 @@ TEST_FUNCTION(clds_hash_table_destroy_with_NULL_hash_table_returns)
 
 /* Tests_SRS_CLDS_HASH_TABLE_01_009: [ On success clds_hash_table_insert shall return CLDS_HASH_TABLE_INSERT_OK. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_01_018: [ clds_hash_table_insert shall obtain the bucket index to be used by calling compute_hash and passing to it the key value. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_019: [ If no sorted list exists at the determined bucket index then a new list shall be created. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_019: [ The sorted list head of the bucket at the determined bucket index shall be used, no list is created for a bucket. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_01_020: [ A new sorted list item shall be created by calling clds_sorted_list_node_create. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_021: [ The new sorted list node shall be inserted in the sorted list at the identified bucket by calling clds_sorted_list_insert. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_021: [ The new sorted list node shall be inserted in the sorted list at the identified bucket by calling clds_sorted_list_head_insert. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_01_038: [ clds_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_071: [ When a new list is created, the start sequence number passed to clds_hash_tabel_create shall be passed as the start_sequence_number argument. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_059: [ For each insert the order of the operation shall be computed by passing sequence_number to clds_sorted_list_insert. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_059: [ For each insert the order of the operation shall be computed by passing sequence_number to clds_sorted_list_head_insert. ]*/
 TEST_FUNCTION(clds_hash_table_insert_inserts_one_key_value_pair)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_SORTED_LIST_HANDLE linked_list;
     CLDS_HASH_TABLE_INSERT_RESULT result;
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list);
-    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list);
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_insert(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL));
 
     // act
     result = clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
@@ -576,25 +861,23 @@ TEST_FUNCTION(clds_hash_table_insert_inserts_one_key_value_pair)
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_071: [ When a new list is created, the start sequence number passed to clds_hash_tabel_create shall be passed as the start_sequence_number argument. ]*/
 TEST_FUNCTION(clds_hash_table_insert_inserts_one_key_value_pair_with_non_NULL_start_sequence_no)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_SORTED_LIST_HANDLE linked_list;
     CLDS_HASH_TABLE_INSERT_RESULT result;
     volatile_atomic int64_t sequence_number = 42;
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &sequence_number, NULL, NULL);
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, &sequence_number, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list);
-    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list);
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_insert(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL));
 
     // act
     result = clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
@@ -679,35 +962,6 @@ TEST_FUNCTION(clds_hash_table_insert_with_NULL_key_fails)
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_022: [ If any error is encountered while inserting the key/value pair, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
-TEST_FUNCTION(when_creating_the_singly_linked_list_fails_clds_hash_table_insert_fails)
-{
-    // arrange
-    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
-    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_INSERT_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
-    umock_c_reset_all_calls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
-        .SetReturn(NULL);
-
-    // act
-    result = clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
-
-    // assert
-    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
-
-    // cleanup
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
-    clds_hash_table_destroy(hash_table);
-    clds_hazard_pointers_destroy(hazard_pointers);
-}
-
 /* Tests_SRS_CLDS_HASH_TABLE_01_022: [ If any error is encountered while inserting the key/value pair, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
 TEST_FUNCTION(when_inserting_the_singly_linked_list_item_fails_clds_hash_table_insert_fails)
 {
@@ -720,9 +974,11 @@ TEST_FUNCTION(when_inserting_the_singly_linked_list_item_fails_clds_hash_table_i
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL))
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_insert(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL))
         .SetReturn(CLDS_SORTED_LIST_INSERT_ERROR);
 
     // act
@@ -741,9 +997,9 @@ TEST_FUNCTION(when_inserting_the_singly_linked_list_item_fails_clds_hash_table_i
 /* Tests_SRS_CLDS_HASH_TABLE_01_009: [ On success clds_hash_table_insert shall return CLDS_HASH_TABLE_INSERT_OK. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_01_018: [ clds_hash_table_insert shall obtain the bucket index to be used by calling compute_hash and passing to it the key value. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_01_020: [ A new sorted list item shall be created by calling clds_sorted_list_node_create. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_021: [ The new sorted list node shall be inserted in the sorted list at the identified bucket by calling clds_sorted_list_insert. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_021: [ The new sorted list node shall be inserted in the sorted list at the identified bucket by calling clds_sorted_list_head_insert. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_01_038: [ clds_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-TEST_FUNCTION(clds_hash_table_insert_with_2nd_key_on_the_same_bucket_does_not_create_another_list)
+TEST_FUNCTION(clds_hash_table_insert_with_2nd_key_on_the_same_bucket_succeeds)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
@@ -764,7 +1020,7 @@ TEST_FUNCTION(clds_hash_table_insert_with_2nd_key_on_the_same_bucket_does_not_cr
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2))
         .SetReturn(first_hash);
-    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_2, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_insert(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_2, NULL));
 
     // act
     result = clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
@@ -781,15 +1037,14 @@ TEST_FUNCTION(clds_hash_table_insert_with_2nd_key_on_the_same_bucket_does_not_cr
 /* Tests_SRS_CLDS_HASH_TABLE_01_009: [ On success clds_hash_table_insert shall return CLDS_HASH_TABLE_INSERT_OK. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_01_018: [ clds_hash_table_insert shall obtain the bucket index to be used by calling compute_hash and passing to it the key value. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_01_020: [ A new sorted list item shall be created by calling clds_sorted_list_node_create. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_021: [ The new sorted list node shall be inserted in the sorted list at the identified bucket by calling clds_sorted_list_insert. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_021: [ The new sorted list node shall be inserted in the sorted list at the identified bucket by calling clds_sorted_list_head_insert. ]*/
 /* Tests_SRS_CLDS_HASH_TABLE_01_038: [ clds_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-TEST_FUNCTION(clds_hash_table_insert_with_2nd_key_on_a_different_bucket_creates_another_list)
+TEST_FUNCTION(clds_hash_table_insert_with_2nd_key_on_a_different_bucket_succeeds)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_SORTED_LIST_HANDLE linked_list;
     CLDS_HASH_TABLE_INSERT_RESULT result;
     CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
@@ -797,11 +1052,11 @@ TEST_FUNCTION(clds_hash_table_insert_with_2nd_key_on_a_different_bucket_creates_
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list);
-    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_2, NULL))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list);
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_insert(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_2, NULL));
 
     // act
     result = clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
@@ -822,11 +1077,12 @@ TEST_FUNCTION(clds_hash_table_insert_when_the_number_of_items_reaches_number_of_
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_SORTED_LIST_HANDLE linked_list;
     CLDS_HASH_TABLE_INSERT_RESULT result;
     CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
     CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
     umock_c_reset_all_calls();
 
@@ -835,11 +1091,8 @@ TEST_FUNCTION(clds_hash_table_insert_when_the_number_of_items_reaches_number_of_
 
     STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, hazard_pointers_thread, (void*)0x2));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list);
-    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_2, NULL))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list);
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_insert(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item_2, NULL));
 
     // act
     result = clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
@@ -853,6 +1106,44 @@ TEST_FUNCTION(clds_hash_table_insert_when_the_number_of_items_reaches_number_of_
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
+/* Tests_SRS_CLDS_HASH_TABLE_01_030: [ If the number of items in the list reaches the number of buckets, the number of buckets shall be doubled. ]*/
+TEST_FUNCTION(clds_hash_table_insert_counts_the_items_inserted_by_all_threads_when_deciding_to_allocate_another_bucket_array)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread_1 = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread_2 = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread_1, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread_2, (void*)0x2, item_2, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_insert(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread_1, (CLDS_SORTED_LIST_ITEM*)item_3, NULL));
+
+    // act
+    result = clds_hash_table_insert(hash_table, hazard_pointers_thread_1, (void*)0x3, item_3, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
 /* Tests_SRS_CLDS_HASH_TABLE_01_046: [ If the key already exists in the hash table, clds_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ALREADY_EXISTS. ]*/
 TEST_FUNCTION(clds_hash_table_insert_with_the_same_key_2_times_returns_KEY_ALREADY_EXISTS)
 {
@@ -872,7 +1163,7 @@ TEST_FUNCTION(clds_hash_table_insert_with_the_same_key_2_times_returns_KEY_ALREA
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_2, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_insert(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_2, NULL));
 
     // act
     result = clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_2, NULL);
@@ -887,14 +1178,13 @@ TEST_FUNCTION(clds_hash_table_insert_with_the_same_key_2_times_returns_KEY_ALREA
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_059: [ For each insert the order of the operation shall be computed by passing sequence_number to clds_sorted_list_insert. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_059: [ For each insert the order of the operation shall be computed by passing sequence_number to clds_sorted_list_head_insert. ]*/
 TEST_FUNCTION(clds_hash_table_insert_passes_the_sequence_number_to_the_sorted_list_insert)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_SORTED_LIST_HANDLE linked_list;
     CLDS_HASH_TABLE_INSERT_RESULT result;
     volatile_atomic int64_t sequence_number = 42;
     int64_t insert_seq_no = 0;
@@ -902,11 +1192,11 @@ TEST_FUNCTION(clds_hash_table_insert_passes_the_sequence_number_to_the_sorted_li
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, &sequence_number, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list);
-    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, &insert_seq_no))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list);
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_insert(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, &insert_seq_no));
 
     // act
     result = clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, &insert_seq_no);
@@ -947,445 +1237,447 @@ TEST_FUNCTION(clds_hash_table_insert_with_non_NULL_sequence_no_but_NULL_start_se
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* clds_hash_table_delete */
+/* clds_hash_table_get_or_insert */
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_014: [ On success clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_039: [ clds_hash_table_delete shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_063: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_key. ]*/
-TEST_FUNCTION(clds_hash_table_delete_deletes_the_key)
+/* Tests_SRS_CLDS_HASH_TABLE_01_186: [ If clds_hash_table is NULL, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_get_or_insert_with_NULL_hash_table_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item;
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, hazard_pointers_thread, (void*)0x1, NULL));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
-
     // act
-    result = clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL);
+    result = clds_hash_table_get_or_insert(NULL, hazard_pointers_thread, (void*)0x1, test_item_factory, (void*)0x4245, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
+    ASSERT_ARE_EQUAL(size_t, 0, g_test_item_factory_call_count);
 
     // cleanup
-    clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_015: [ If clds_hash_table is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_delete_with_NULL_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_187: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_get_or_insert_with_NULL_clds_hazard_pointers_thread_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
-    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    int result;
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_delete(NULL, hazard_pointers_thread, (void*)0x1, NULL);
+    result = clds_hash_table_get_or_insert(hash_table, NULL, (void*)0x1, test_item_factory, (void*)0x4245, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
+    ASSERT_ARE_EQUAL(size_t, 0, g_test_item_factory_call_count);
 
     // cleanup
+    clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_017: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_delete_with_NULL_clds_hazard_pointers_thread_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_188: [ If key, item_factory or item is NULL, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_get_or_insert_with_NULL_key_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    int result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item;
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_delete(hash_table, NULL, (void*)0x1, NULL);
+    result = clds_hash_table_get_or_insert(hash_table, hazard_pointers_thread, NULL, test_item_factory, (void*)0x4245, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
+    ASSERT_ARE_EQUAL(size_t, 0, g_test_item_factory_call_count);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_016: [ If key is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_delete_with_NULL_key_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_188: [ If key, item_factory or item is NULL, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_get_or_insert_with_NULL_item_factory_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    int result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item;
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_delete(hash_table, hazard_pointers_thread, NULL, NULL);
+    result = clds_hash_table_get_or_insert(hash_table, hazard_pointers_thread, (void*)0x1, NULL, (void*)0x4245, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-TEST_FUNCTION(clds_hash_table_delete_with_a_key_that_is_not_in_the_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_188: [ If key, item_factory or item is NULL, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_get_or_insert_with_NULL_item_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    int result;
+    CLDS_HASH_TABLE_INSERT_RESULT result;
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-
     // act
-    result = clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL);
+    result = clds_hash_table_get_or_insert(hash_table, hazard_pointers_thread, (void*)0x1, test_item_factory, (void*)0x4245, NULL, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
+    ASSERT_ARE_EQUAL(size_t, 0, g_test_item_factory_call_count);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-TEST_FUNCTION(clds_hash_table_delete_with_a_key_that_is_already_deleted_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_189: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_get_or_insert_with_non_NULL_sequence_no_but_NULL_start_sequence_no_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    int result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item;
+    int64_t insert_seq_no = 0;
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
-    (void)clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-
     // act
-    result = clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL);
+    result = clds_hash_table_get_or_insert(hash_table, hazard_pointers_thread, (void*)0x1, test_item_factory, (void*)0x4245, &item, &insert_seq_no);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
+    ASSERT_ARE_EQUAL(size_t, 0, g_test_item_factory_call_count);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_024: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(when_the_underlying_delete_from_list_fails_clds_hash_table_delete_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_190: [ clds_hash_table_get_or_insert shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_192: [ Otherwise clds_hash_table_get_or_insert shall call clds_sorted_list_head_get_or_insert on the bucket of the key in the first array of buckets, so that the key is looked up and the new item is inserted in one pass over the bucket. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_193: [ item_factory shall be called with item_factory_context and key only when key is not in the table. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_194: [ clds_hash_table_get_or_insert shall store in the created item the hash of the key and the key set by item_factory in item_key, or key if item_factory leaves item_key NULL. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_195: [ If clds_sorted_list_head_get_or_insert returns CLDS_SORTED_LIST_INSERT_OK, clds_hash_table_get_or_insert shall set item to the created item and return CLDS_HASH_TABLE_INSERT_OK. ]*/
+TEST_FUNCTION(clds_hash_table_get_or_insert_inserts_the_item_created_by_item_factory)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item;
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    g_test_item_factory_result = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL))
-        .SetReturn(CLDS_SORTED_LIST_DELETE_ERROR);
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_get_or_insert(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL));
 
     // act
-    result = clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL);
+    result = clds_hash_table_get_or_insert(hash_table, hazard_pointers_thread, (void*)0x1, test_item_factory, (void*)0x4245, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, g_test_item_factory_result, item);
+    ASSERT_ARE_EQUAL(size_t, 1, g_test_item_factory_call_count);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4245, g_test_item_factory_context);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x1, g_test_item_factory_key);
+    ASSERT_ARE_EQUAL(uint64_t, 1, CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item)->hashed_key.hash);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x1, CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item)->hashed_key.key);
+    ASSERT_ARE_EQUAL(void_ptr, item, clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1));
 
     // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_101: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_025: [ If the element to be deleted is not found in an array of buckets, then it shall be looked up in the next available array of buckets. ] */
-TEST_FUNCTION(delete_looks_in_2_buckets)
+/* Tests_SRS_CLDS_HASH_TABLE_01_194: [ clds_hash_table_get_or_insert shall store in the created item the hash of the key and the key set by item_factory in item_key, or key if item_factory leaves item_key NULL. ]*/
+TEST_FUNCTION(clds_hash_table_get_or_insert_stores_the_key_returned_by_item_factory)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    g_test_item_factory_result = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    g_test_item_factory_item_key = (void*)0x4246;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_get_or_insert(hash_table, hazard_pointers_thread, (void*)0x1, test_item_factory, (void*)0x4245, &item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+    ASSERT_ARE_EQUAL(uint64_t, 1, CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item)->hashed_key.hash);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4246, CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item)->hashed_key.key);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_193: [ item_factory shall be called with item_factory_context and key only when key is not in the table. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_196: [ If clds_sorted_list_head_get_or_insert returns CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS, clds_hash_table_get_or_insert shall set item to the item in the table and return CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+TEST_FUNCTION(clds_hash_table_get_or_insert_with_existing_key_returns_the_item_without_calling_item_factory)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* existing_item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, existing_item, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1, NULL));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_get_or_insert(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL));
 
     // act
-    result = clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL);
+    result = clds_hash_table_get_or_insert(hash_table, hazard_pointers_thread, (void*)0x1, test_item_factory, (void*)0x4245, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS, result);
+    ASSERT_ARE_EQUAL(void_ptr, existing_item, item);
+    ASSERT_ARE_EQUAL(size_t, 0, g_test_item_factory_call_count);
 
     // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_101: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_025: [ If the element to be deleted is not found in an array of buckets, then it shall be looked up in the next available array of buckets. ] */
-TEST_FUNCTION(delete_looks_in_3_buckets)
+/* Tests_SRS_CLDS_HASH_TABLE_01_191: [ clds_hash_table_get_or_insert shall look for the key in all the arrays of buckets except the first one, and if it is found it shall set item to the item in the table and return CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS without calling item_factory. ]*/
+TEST_FUNCTION(clds_hash_table_get_or_insert_with_key_in_a_lower_bucket_array_returns_the_item_without_calling_item_factory)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    // 1st bucket array has 1 bucket
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    // 2nd bucket array has 2 buckets
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    // 3rd bucket array has 4 buckets
-    CLDS_HASH_TABLE_ITEM* item_4 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_3, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x4, item_4, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1, NULL));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1, NULL));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
 
     // act
-    result = clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL);
+    result = clds_hash_table_get_or_insert(hash_table, hazard_pointers_thread, (void*)0x1, test_item_factory, (void*)0x4245, &item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS, result);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, item);
+    ASSERT_ARE_EQUAL(size_t, 0, g_test_item_factory_call_count);
 
     // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-TEST_FUNCTION(when_item_is_not_found_in_any_bucket_delete_returns_NOT_FOUND)
+/* Tests_SRS_CLDS_HASH_TABLE_01_197: [ If any error occurs, clds_hash_table_get_or_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(when_item_factory_fails_clds_hash_table_get_or_insert_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, IGNORED_ARG, (void*)0x3, NULL));
-
     // act
-    result = clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x3, NULL);
+    result = clds_hash_table_get_or_insert(hash_table, hazard_pointers_thread, (void*)0x1, test_item_factory, (void*)0x4245, &item, NULL);
 
     // assert
-    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_NOT_FOUND, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
+    ASSERT_ARE_EQUAL(size_t, 1, g_test_item_factory_call_count);
+    ASSERT_IS_NULL(clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1));
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_063: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_key. ]*/
-TEST_FUNCTION(clds_hash_table_delete_deletes_the_key_and_stamps_the_sequence_no)
+/* Tests_SRS_CLDS_HASH_TABLE_01_192: [ Otherwise clds_hash_table_get_or_insert shall call clds_sorted_list_head_get_or_insert on the bucket of the key in the first array of buckets, so that the key is looked up and the new item is inserted in one pass over the bucket. ]*/
+TEST_FUNCTION(clds_hash_table_get_or_insert_passes_the_sequence_number_to_the_sorted_list_get_or_insert)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item;
     volatile_atomic int64_t sequence_number = 42;
-    int64_t delete_seq_no = 0;
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    int64_t insert_seq_no = 0;
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &sequence_number, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    g_test_item_factory_result = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_key(IGNORED_ARG, hazard_pointers_thread, (void*)0x1, &delete_seq_no));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_get_or_insert(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, &insert_seq_no));
 
     // act
-    result = clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, &delete_seq_no);
+    result = clds_hash_table_get_or_insert(hash_table, hazard_pointers_thread, (void*)0x1, test_item_factory, (void*)0x4245, &item, &insert_seq_no);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
-    ASSERT_ARE_EQUAL(int64_t, 44, delete_seq_no);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+    ASSERT_ARE_EQUAL(int64_t, 43, insert_seq_no);
 
     // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_066: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_delete_with_non_NULL_sequence_no_but_NULL_start_sequence_number_fails)
+/* clds_hash_table_insert_batch */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_199: [ If clds_hash_table is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_NULL_hash_table_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    int64_t delete_seq_no = 0;
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    void* keys[1] = { (void*)0x1 };
+    CLDS_HASH_TABLE_ITEM* items[1] = { (CLDS_HASH_TABLE_ITEM*)0x4242 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[1];
+    int result;
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, &delete_seq_no);
+    result = clds_hash_table_insert_batch(NULL, hazard_pointers_thread, keys, items, 1, 1, results, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
-    clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* clds_hash_table_delete_key_value */
-
-/* Tests_SRS_CLDS_HASH_TABLE_42_002: [ On success clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_001: [ clds_hash_table_delete_key_value shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_011: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_item. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_deletes_the_key)
+/* Tests_SRS_CLDS_HASH_TABLE_01_200: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_NULL_clds_hazard_pointers_thread_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
-    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    void* keys[1] = { (void*)0x1 };
+    CLDS_HASH_TABLE_ITEM* items[1] = { (CLDS_HASH_TABLE_ITEM*)0x4242 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[1];
+    int result;
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item, NULL));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
-
     // act
-    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    result = clds_hash_table_insert_batch(hash_table, NULL, keys, items, 1, 1, results, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_003: [ If clds_hash_table is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_with_NULL_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_201: [ If keys, items or results is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_NULL_keys_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* items[1] = { (CLDS_HASH_TABLE_ITEM*)0x4242 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[1];
     int result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_delete_key_value(NULL, hazard_pointers_thread, (void*)0x1, item, NULL);
+    result = clds_hash_table_insert_batch(hash_table, hazard_pointers_thread, NULL, items, 1, 1, results, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
     ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_004: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_with_NULL_clds_hazard_pointers_thread_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_201: [ If keys, items or results is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_NULL_items_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    void* keys[1] = { (void*)0x1 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[1];
     int result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_delete_key_value(hash_table, NULL, (void*)0x1, item, NULL);
+    result = clds_hash_table_insert_batch(hash_table, hazard_pointers_thread, keys, NULL, 1, 1, results, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
@@ -1396,21 +1688,20 @@ TEST_FUNCTION(clds_hash_table_delete_key_value_with_NULL_clds_hazard_pointers_th
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_005: [ If key is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_with_NULL_key_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_201: [ If keys, items or results is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_NULL_results_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    void* keys[1] = { (void*)0x1 };
+    CLDS_HASH_TABLE_ITEM* items[1] = { (CLDS_HASH_TABLE_ITEM*)0x4242 };
     int result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, NULL, item, NULL);
+    result = clds_hash_table_insert_batch(hash_table, hazard_pointers_thread, keys, items, 1, 1, NULL, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
@@ -1421,21 +1712,21 @@ TEST_FUNCTION(clds_hash_table_delete_key_value_with_NULL_key_fails)
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_006: [ If value is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_with_NULL_value_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_202: [ If thread_count is 0, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_0_thread_count_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    void* keys[1] = { (void*)0x1 };
+    CLDS_HASH_TABLE_ITEM* items[1] = { (CLDS_HASH_TABLE_ITEM*)0x4242 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[1];
     int result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, NULL, NULL);
+    result = clds_hash_table_insert_batch(hash_table, hazard_pointers_thread, keys, items, 1, 0, results, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
@@ -1446,22 +1737,22 @@ TEST_FUNCTION(clds_hash_table_delete_key_value_with_NULL_value_fails)
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_with_a_key_that_is_not_in_the_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_203: [ If the sequence_numbers argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_non_NULL_sequence_numbers_but_NULL_start_sequence_no_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    void* keys[1] = { (void*)0x1 };
+    CLDS_HASH_TABLE_ITEM* items[1] = { (CLDS_HASH_TABLE_ITEM*)0x4242 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[1];
+    int64_t sequence_numbers[1];
     int result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-
     // act
-    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    result = clds_hash_table_insert_batch(hash_table, hazard_pointers_thread, keys, items, 1, 1, results, sequence_numbers);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
@@ -1469,28 +1760,24 @@ TEST_FUNCTION(clds_hash_table_delete_key_value_with_a_key_that_is_not_in_the_has
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_with_a_key_that_is_already_deleted_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_204: [ If any of the keys or items is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_a_NULL_key_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    void* keys[2] = { (void*)0x1, NULL };
+    CLDS_HASH_TABLE_ITEM* items[2] = { (CLDS_HASH_TABLE_ITEM*)0x4242, (CLDS_HASH_TABLE_ITEM*)0x4243 };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
     int result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
-    (void)clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-
     // act
-    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    result = clds_hash_table_insert_batch(hash_table, hazard_pointers_thread, keys, items, 2, 1, results, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
@@ -1501,555 +1788,574 @@ TEST_FUNCTION(clds_hash_table_delete_key_value_with_a_key_that_is_already_delete
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_009: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(when_the_underlying_delete_from_list_fails_clds_hash_table_delete_key_value_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_204: [ If any of the keys or items is NULL, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_a_NULL_item_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    void* keys[2] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* items[2] = { (CLDS_HASH_TABLE_ITEM*)0x4242, NULL };
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int result;
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL))
-        .SetReturn(CLDS_SORTED_LIST_DELETE_ERROR);
-
     // act
-    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    result = clds_hash_table_insert_batch(hash_table, hazard_pointers_thread, keys, items, 2, 1, results, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-
-/* Tests_SRS_CLDS_HASH_TABLE_42_007: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_010: [ If the element to be deleted is not found in an array of buckets, then clds_hash_table_delete_key_value shall look in the next available array of buckets. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_looks_in_2_buckets)
+/* Tests_SRS_CLDS_HASH_TABLE_01_206: [ clds_hash_table_insert_batch shall hash all the keys by calling the compute_hash function passed to clds_hash_table_create and store the hash and the key in each item. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_211: [ Each item shall be inserted in the first array of buckets the same way clds_hash_table_insert inserts an item, results[i] receiving the result of inserting items[i] and, if sequence_numbers is non-NULL, sequence_numbers[i] receiving its sequence number. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_215: [ Otherwise clds_hash_table_insert_batch shall succeed and return 0, the items whose key was already in the hash table having their result set to CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_inserts_all_the_items)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    void* keys[3] = { (void*)0x1, (void*)0x2, (void*)0x3 };
+    CLDS_HASH_TABLE_ITEM* items[3];
+    CLDS_HASH_TABLE_INSERT_RESULT results[3];
+    int result;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    }
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
 
     // act
-    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    result = clds_hash_table_insert_batch(hash_table, hazard_pointers_thread, keys, items, 3, 1, results, NULL);
 
     // assert
-    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[i]);
+        ASSERT_ARE_EQUAL(void_ptr, keys[i], CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, items[i])->hashed_key.key);
+        CLDS_HASH_TABLE_ITEM* found_item = clds_hash_table_find(hash_table, hazard_pointers_thread, keys[i]);
+        ASSERT_ARE_EQUAL(void_ptr, items[i], found_item);
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+    }
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_007: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_010: [ If the element to be deleted is not found in an array of buckets, then clds_hash_table_delete_key_value shall look in the next available array of buckets. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_looks_in_3_buckets)
+/* Tests_SRS_CLDS_HASH_TABLE_01_207: [ If the first array of buckets has fewer buckets than the items in it plus item_count, clds_hash_table_insert_batch shall add a new first array of buckets, with the number of buckets doubled as many times as needed to hold all the items. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_allocates_the_buckets_for_all_the_items_at_once)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    // 1st bucket array has 1 bucket
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    // 2nd bucket array has 2 buckets
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    // 3rd bucket array has 4 buckets
-    CLDS_HASH_TABLE_ITEM* item_4 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_3, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x4, item_4, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    void* keys[100];
+    CLDS_HASH_TABLE_ITEM* items[100];
+    CLDS_HASH_TABLE_INSERT_RESULT results[100];
+    int result;
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        keys[i] = (void*)(uintptr_t)(i + 1);
+        items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    }
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
-
     // act
-    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    result = clds_hash_table_insert_batch(hash_table, hazard_pointers_thread, keys, items, 100, 1, results, NULL);
 
     // assert
-    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    // one array of buckets is allocated, instead of one per doubling
+    ASSERT_ARE_EQUAL(size_t, 1, count_actual_calls("[malloc_flex("));
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[i]);
+    }
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-TEST_FUNCTION(when_item_is_not_found_in_any_bucket_clds_hash_table_delete_key_value_returns_NOT_FOUND)
+/* Tests_SRS_CLDS_HASH_TABLE_01_208: [ clds_hash_table_insert_batch shall migrate all the items of the older arrays of buckets to the first array of buckets, so that only one array of buckets is left. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_migrates_the_items_of_the_older_arrays_of_buckets)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    void* keys[1] = { (void*)0x5 };
+    CLDS_HASH_TABLE_ITEM* items[1];
+    CLDS_HASH_TABLE_INSERT_RESULT results[1];
+    int result;
+    // 3 arrays of buckets, with 1, 2 and 4 buckets, each holding the items inserted while it was the first one
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    for (uintptr_t key = 1; key <= 4; key++)
+    {
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)key, CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL), NULL));
+    }
+    items[0] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_3, NULL));
-
     // act
-    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x3, item_3, NULL);
+    result = clds_hash_table_insert_batch(hash_table, hazard_pointers_thread, keys, items, 1, 1, results, NULL);
 
     // assert
-    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_NOT_FOUND, result);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[0]);
+    // the 2 older arrays of buckets were emptied and retired
+    ASSERT_ARE_EQUAL(size_t, 2, count_actual_calls("[clds_hazard_pointers_reclaim("));
+    for (uintptr_t key = 1; key <= 5; key++)
+    {
+        CLDS_HASH_TABLE_ITEM* found_item = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)key);
+        ASSERT_IS_NOT_NULL(found_item);
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+    }
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-
-/* Tests_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
-TEST_FUNCTION(when_item_is_not_found_in_any_bucket_clds_hash_table_delete_key_value_returns_NOT_FOUND_even_when_key_is_found_but_different_value)
+/* Tests_SRS_CLDS_HASH_TABLE_01_215: [ Otherwise clds_hash_table_insert_batch shall succeed and return 0, the items whose key was already in the hash table having their result set to CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_keys_already_in_the_table_sets_their_result_to_KEY_ALREADY_EXISTS)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    // 0x1 is in the table, 0x2 is twice in the batch
+    void* keys[3] = { (void*)0x1, (void*)0x2, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* items[3];
+    CLDS_HASH_TABLE_INSERT_RESULT results[3];
+    int result;
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL), NULL);
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    }
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    // act
+    result = clds_hash_table_insert_batch(hash_table, hazard_pointers_thread, keys, items, 3, 1, results, NULL);
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_3, NULL));
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS, results[0]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[1]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS, results[2]);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[2]);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_209: [ clds_hash_table_insert_batch shall order the items by the range of buckets they fall in and give each of the thread_count threads the items of a contiguous range of buckets. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_210: [ For each thread but the first, clds_hash_table_insert_batch shall register a hazard pointers thread and create a thread by calling ThreadAPI_Create, the calling thread inserting the items of the first thread. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_213: [ clds_hash_table_insert_batch shall wait for the threads it created by calling ThreadAPI_Join and unregister their hazard pointers threads. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_with_4_threads_inserts_the_items_in_3_created_threads_and_the_calling_thread)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 64, hazard_pointers, NULL, NULL, NULL);
+    void* keys[32];
+    CLDS_HASH_TABLE_ITEM* items[32];
+    CLDS_HASH_TABLE_INSERT_RESULT results[32];
+    int result;
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        keys[i] = (void*)(uintptr_t)(i * 2 + 1);
+        items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    }
+    umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, item_3, NULL);
+    result = clds_hash_table_insert_batch(hash_table, hazard_pointers_thread, keys, items, 32, 4, results, NULL);
 
     // assert
-    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_NOT_FOUND, result);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 3, count_actual_calls("[clds_hazard_pointers_register_thread("));
+    ASSERT_ARE_EQUAL(size_t, 3, count_actual_calls("[ThreadAPI_Create("));
+    ASSERT_ARE_EQUAL(size_t, 3, count_actual_calls("[ThreadAPI_Join("));
+    ASSERT_ARE_EQUAL(size_t, 3, count_actual_calls("[clds_hazard_pointers_unregister_thread("));
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[i]);
+        CLDS_HASH_TABLE_ITEM* found_item = clds_hash_table_find(hash_table, hazard_pointers_thread, keys[i]);
+        ASSERT_ARE_EQUAL(void_ptr, items[i], found_item);
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+    }
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_011: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_item. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_deletes_the_key_and_stamps_the_sequence_no)
+/* Tests_SRS_CLDS_HASH_TABLE_01_212: [ If registering the hazard pointers thread or creating the thread fails, the calling thread shall insert the items of that thread. ]*/
+TEST_FUNCTION(when_ThreadAPI_Create_fails_clds_hash_table_insert_batch_inserts_the_items_of_the_thread_in_the_calling_thread)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    volatile_atomic int64_t sequence_number = 42;
-    int64_t delete_seq_no = 0;
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &sequence_number, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 64, hazard_pointers, NULL, NULL, NULL);
+    void* keys[32];
+    CLDS_HASH_TABLE_ITEM* items[32];
+    CLDS_HASH_TABLE_INSERT_RESULT results[32];
+    int result;
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        keys[i] = (void*)(uintptr_t)(i * 2 + 1);
+        items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    }
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_delete_item(IGNORED_ARG, hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item, &delete_seq_no));
-    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(ThreadAPI_Create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
+        .SetReturn(THREADAPI_ERROR);
 
     // act
-    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, item, &delete_seq_no);
+    result = clds_hash_table_insert_batch(hash_table, hazard_pointers_thread, keys, items, 32, 2, results, NULL);
 
     // assert
-    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
-    ASSERT_ARE_EQUAL(int64_t, 44, delete_seq_no);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, count_actual_calls("[ThreadAPI_Join("));
+    ASSERT_ARE_EQUAL(size_t, 1, count_actual_calls("[clds_hazard_pointers_unregister_thread("));
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, results[i]);
+    }
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_012: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_delete_key_value_with_non_NULL_sequence_no_but_NULL_start_sequence_number_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_211: [ Each item shall be inserted in the first array of buckets the same way clds_hash_table_insert inserts an item, results[i] receiving the result of inserting items[i] and, if sequence_numbers is non-NULL, sequence_numbers[i] receiving its sequence number. ]*/
+TEST_FUNCTION(clds_hash_table_insert_batch_returns_the_sequence_numbers_of_the_inserts)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    int64_t delete_seq_no = 0;
-    CLDS_HASH_TABLE_DELETE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    volatile_atomic int64_t sequence_number = 42;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &sequence_number, NULL, NULL);
+    void* keys[2] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* items[2];
+    CLDS_HASH_TABLE_INSERT_RESULT results[2];
+    int64_t sequence_numbers[2] = { 0, 0 };
+    int result;
+    items[0] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    items[1] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, item, &delete_seq_no);
+    result = clds_hash_table_insert_batch(hash_table, hazard_pointers_thread, keys, items, 2, 1, results, sequence_numbers);
 
     // assert
-    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    // the items are inserted in the order of their buckets
+    ASSERT_ARE_EQUAL(int64_t, 43, sequence_numbers[0]);
+    ASSERT_ARE_EQUAL(int64_t, 44, sequence_numbers[1]);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* clds_hash_table_remove */
-
-/* Tests_SRS_CLDS_HASH_TABLE_01_047: [ clds_hash_table_remove shall remove a key from the hash table and return a pointer to the item to the user. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_049: [ On success clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_OK. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_048: [ clds_hash_table_remove shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_067: [ For each remove the order of the operation shall be computed by passing sequence_number to clds_sorted_list_remove_key. ]*/
-TEST_FUNCTION(clds_hash_table_remove_removes_the_key_from_the_list)
+/* Tests_SRS_CLDS_HASH_TABLE_01_205: [ clds_hash_table_insert_batch shall set all the results to CLDS_HASH_TABLE_INSERT_ERROR before inserting any item, so that the items that could not be inserted are reported as not inserted. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_214: [ If any item could not be inserted because of an error, or any other error occurs, clds_hash_table_insert_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_allocating_fails_clds_hash_table_insert_batch_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* removed_item;
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    void* keys[2] = { (void*)0x1, (void*)0x2 };
+    CLDS_HASH_TABLE_ITEM* items[2];
+    CLDS_HASH_TABLE_INSERT_RESULT results[2] = { CLDS_HASH_TABLE_INSERT_OK, CLDS_HASH_TABLE_INSERT_OK };
+    int result;
+    items[0] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    items[1] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, hazard_pointers_thread, (void*)0x1, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(2, sizeof(uint32_t)))
+        .SetReturn(NULL);
 
     // act
-    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+    result = clds_hash_table_insert_batch(hash_table, hazard_pointers_thread, keys, items, 2, 1, results, NULL);
 
     // assert
-    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, results[0]);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, results[1]);
+    ASSERT_IS_NULL(clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1));
 
     // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[1]);
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_067: [ For each remove the order of the operation shall be computed by passing sequence_number to clds_sorted_list_remove_key. ]*/
-TEST_FUNCTION(clds_hash_table_remove_removes_the_key_from_the_list_with_non_NULL_sequence_no)
+/* clds_hash_table_delete */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_014: [ On success clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_039: [ clds_hash_table_delete shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_063: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_key. ]*/
+TEST_FUNCTION(clds_hash_table_delete_deletes_the_key)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* removed_item;
-    volatile_atomic int64_t sequence_number = 42;
-    int64_t remove_seq_no;
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &sequence_number, NULL, NULL);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, hazard_pointers_thread, (void*)0x1, IGNORED_ARG, &remove_seq_no));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_delete_key(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, NULL));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
 
     // act
-    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, &remove_seq_no);
+    result = clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, result);
-    ASSERT_ARE_EQUAL(int64_t, 44, remove_seq_no);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_050: [ If clds_hash_table is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_remove_with_NULL_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_015: [ If clds_hash_table is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_delete_with_NULL_hash_table_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* removed_item;
+    int result;
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_remove(NULL, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+    result = clds_hash_table_delete(NULL, hazard_pointers_thread, (void*)0x1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_052: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_remove_with_NULL_clds_hazard_pointers_thread_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_017: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_delete_with_NULL_clds_hazard_pointers_thread_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    int result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* removed_item;
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_remove(hash_table, NULL, (void*)0x1, &removed_item, NULL);
+    result = clds_hash_table_delete(hash_table, NULL, (void*)0x1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_051: [ If key is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_remove_with_NULL_key_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_016: [ If key is NULL, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_delete_with_NULL_key_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    int result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* removed_item;
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, NULL, &removed_item, NULL);
+    result = clds_hash_table_delete(hash_table, hazard_pointers_thread, NULL, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_056: [ If item is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_remove_with_NULL_item_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_hash_table_delete_with_a_key_that_is_not_in_the_hash_table_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    int result;
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+
     // act
-    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, NULL, NULL);
+    result = clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_053: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
-TEST_FUNCTION(clds_hash_table_remove_with_a_key_that_is_not_in_the_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_hash_table_delete_with_a_key_that_is_already_deleted_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* removed_item;
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
-    umock_c_reset_all_calls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-
-    // act
-    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
-
-    // assert
-    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_NOT_FOUND, result);
-
-    // cleanup
-    clds_hash_table_destroy(hash_table);
-    clds_hazard_pointers_destroy(hazard_pointers);
-}
-
-/* Tests_SRS_CLDS_HASH_TABLE_01_053: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
-TEST_FUNCTION(clds_hash_table_remove_with_a_key_that_is_already_deleted_fails)
-{
-    // arrange
-    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
-    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* removed_item;
+    int result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     (void)clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
 
     // act
-    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+    result = clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_NOT_FOUND, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_054: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-TEST_FUNCTION(when_the_underlying_delete_from_list_fails_clds_hash_table_remove_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_024: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(when_the_underlying_delete_from_list_fails_clds_hash_table_delete_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* removed_item;
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
-        .SetReturn(CLDS_SORTED_LIST_REMOVE_ERROR);
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_delete_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL))
+        .SetReturn(CLDS_SORTED_LIST_DELETE_ERROR);
 
     // act
-    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+    result = clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_055: [ If the element to be deleted is not found in the biggest array of buckets, then it shall be looked up in the next available array of buckets. ]*/
-TEST_FUNCTION(remove_looks_in_2_buckets)
+/* Tests_SRS_CLDS_HASH_TABLE_01_101: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_025: [ If the element to be deleted is not found in an array of buckets, then it shall be looked up in the next available array of buckets. ] */
+TEST_FUNCTION(delete_looks_in_2_buckets)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* removed_item;
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    // due to resize it is only one
-    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_delete_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
 
     // act
-    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+    result = clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_055: [ If the element to be deleted is not found in the biggest array of buckets, then it shall be looked up in the next available array of buckets. ]*/
-TEST_FUNCTION(remove_looks_in_3_buckets)
+/* Tests_SRS_CLDS_HASH_TABLE_01_101: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_025: [ If the element to be deleted is not found in an array of buckets, then it shall be looked up in the next available array of buckets. ] */
+TEST_FUNCTION(delete_looks_in_3_buckets)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
     // 1st bucket array has 1 bucket
     CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     // 2nd bucket array has 2 buckets
@@ -2057,8 +2363,9 @@ TEST_FUNCTION(remove_looks_in_3_buckets)
     CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     // 3rd bucket array has 4 buckets
     CLDS_HASH_TABLE_ITEM* item_4 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* removed_item;
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_3, NULL);
@@ -2067,1753 +2374,4398 @@ TEST_FUNCTION(remove_looks_in_3_buckets)
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    // due to resize, only too lists are there
-    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1, IGNORED_ARG, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_delete_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_delete_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
 
     // act
-    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+    result = clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_053: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
-TEST_FUNCTION(when_item_is_not_found_in_any_bucket_remove_returns_NOT_FOUND)
+/* Tests_SRS_CLDS_HASH_TABLE_01_023: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(when_item_is_not_found_in_any_bucket_delete_returns_NOT_FOUND)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* removed_item;
     hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
-    STRICT_EXPECTED_CALL(clds_sorted_list_remove_key(IGNORED_ARG, IGNORED_ARG, (void*)0x3, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_delete_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL));
 
     // act
-    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x3, &removed_item, NULL);
+    result = clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x3, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_NOT_FOUND, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_NOT_FOUND, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_070: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_remove_with_non_NULL_sequence_no_and_NULL_start_sequence_no_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_063: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_key. ]*/
+TEST_FUNCTION(clds_hash_table_delete_deletes_the_key_and_stamps_the_sequence_no)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    volatile_atomic int64_t sequence_number = 42;
+    int64_t delete_seq_no = 0;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* removed_item;
-    int64_t remove_seq_no;
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &sequence_number, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_delete_key(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, &delete_seq_no));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+
     // act
-    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, &remove_seq_no);
+    result = clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, &delete_seq_no);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(int64_t, 44, delete_seq_no);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* clds_hash_table_find */
-
-/* Tests_SRS_CLDS_HASH_TABLE_01_034: [ clds_hash_table_find shall find the key identified by key in the hash table and on success return the item corresponding to it. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_040: [ clds_hash_table_find shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_041: [ clds_hash_table_find shall look up the key in the biggest array of buckets. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_044: [ Looking up the key in the array of buckets is done by obtaining the list in the bucket correspoding to the hash and looking up the key in the list by calling clds_sorted_list_find. ]*/
-TEST_FUNCTION(clds_hash_table_find_succeeds)
+/* Tests_SRS_CLDS_HASH_TABLE_01_066: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_delete_with_non_NULL_sequence_no_but_NULL_start_sequence_number_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_ITEM* result;
+    int64_t delete_seq_no = 0;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 3, hazard_pointers, NULL, NULL, NULL);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
-
     // act
-    result = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
+    result = clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, &delete_seq_no);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(void_ptr, (void*)item, (void*)result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_034: [ clds_hash_table_find shall find the key identified by key in the hash table and on success return the item corresponding to it. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_040: [ clds_hash_table_find shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-TEST_FUNCTION(clds_hash_table_find_2nd_item_out_of_3_succeeds)
+/* clds_hash_table_delete_key_value */
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_002: [ On success clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_001: [ clds_hash_table_delete_key_value shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_011: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_item. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_deletes_the_key)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_ITEM* result;
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 3, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_3, NULL);
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x2));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_delete_item(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item, NULL));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
 
     // act
-    result = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x2);
+    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(void_ptr, (void*)item_2, (void*)result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_034: [ clds_hash_table_find shall find the key identified by key in the hash table and on success return the item corresponding to it. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_040: [ clds_hash_table_find shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
-TEST_FUNCTION(clds_hash_table_find_3rd_item_out_of_3_succeeds)
+/* Tests_SRS_CLDS_HASH_TABLE_42_003: [ If clds_hash_table is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_with_NULL_hash_table_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_ITEM* result;
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 3, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_3, NULL);
+    int result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x3));
-
     // act
-    result = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x3);
+    result = clds_hash_table_delete_key_value(NULL, hazard_pointers_thread, (void*)0x1, item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(void_ptr, (void*)item_3, (void*)result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
-    clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_035: [ If clds_hash_table is NULL, clds_hash_table_find shall fail and return NULL. ]*/
-TEST_FUNCTION(clds_hash_table_find_with_NULL_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_42_004: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_with_NULL_clds_hazard_pointers_thread_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    int result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_find(NULL, hazard_pointers_thread, (void*)0x3);
+    result = clds_hash_table_delete_key_value(hash_table, NULL, (void*)0x1, item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_IS_NULL(result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
+    clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_036: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_find shall fail and return NULL. ]*/
-TEST_FUNCTION(clds_hash_table_find_with_NULL_clds_hazard_pointers_thread_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_42_005: [ If key is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_with_NULL_key_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_ITEM* result;
+    int result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_find(hash_table, NULL, (void*)0x3);
+    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, NULL, item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_IS_NULL(result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_037: [ If key is NULL, clds_hash_table_find shall fail and return NULL. ]*/
-TEST_FUNCTION(clds_hash_table_find_with_NULL_key_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_42_006: [ If value is NULL, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_with_NULL_value_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_ITEM* result;
+    int result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     // act
-    result = clds_hash_table_find(hash_table, hazard_pointers_thread, NULL);
+    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, NULL, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_IS_NULL(result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_042: [ If the key is not found in the biggest array of buckets, the next bucket arrays shall be looked up. ]*/
-TEST_FUNCTION(clds_hash_table_find_looks_up_in_the_2nd_array_of_buckets)
+/* Tests_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_with_a_key_that_is_not_in_the_hash_table_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_ITEM* result;
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_3, NULL);
+    int result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
 
     // act
-    result = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
+    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(void_ptr, (void*)item_1, (void*)result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_043: [ If the key is not found at all, clds_hash_table_find shall return NULL. ]*/
-TEST_FUNCTION(when_key_is_not_found_in_any_bucket_levels_clds_hash_table_find_yields_NULL)
+/* Tests_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_with_a_key_that_is_already_deleted_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_ITEM* result;
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_3, NULL);
+    int result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    (void)clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x4));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x4));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x4));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
 
     // act
-    result = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x4);
+    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_IS_NULL(result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* clds_hash_table_set_value */
-
-/* Tests_SRS_CLDS_HASH_TABLE_01_079: [ If clds_hash_table is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_NULL_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_42_009: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(when_the_underlying_delete_from_list_fails_clds_hash_table_delete_key_value_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    int64_t set_value_seq_no;
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_delete_item(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL))
+        .SetReturn(CLDS_SORTED_LIST_DELETE_ERROR);
+
     // act
-    result = clds_hash_table_set_value(NULL, hazard_pointers_thread, (void*)0x4, item_1, NULL, NULL, &old_item, &set_value_seq_no);
+    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result);
 
     // cleanup
+    clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_080: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_NULL_clds_hazard_pointers_thread_fails)
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_007: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_010: [ If the element to be deleted is not found in an array of buckets, then clds_hash_table_delete_key_value shall look in the next available array of buckets. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_looks_in_2_buckets)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    int64_t set_value_seq_no;
-    volatile_atomic int64_t sequence_number;
-    (void)interlocked_exchange_64(&sequence_number, 42);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &sequence_number, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_delete_item(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+
     // act
-    result = clds_hash_table_set_value(hash_table, NULL, (void*)0x4, item_1, NULL, NULL, &old_item, &set_value_seq_no);
+    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_081: [ If key is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_NULL_key_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_42_007: [ Otherwise, key shall be looked up in each of the arrays of buckets starting with the first. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_010: [ If the element to be deleted is not found in an array of buckets, then clds_hash_table_delete_key_value shall look in the next available array of buckets. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_looks_in_3_buckets)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+    // 1st bucket array has 1 bucket
     CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    int64_t set_value_seq_no;
-    volatile_atomic int64_t sequence_number;
-    (void)interlocked_exchange_64(&sequence_number, 42);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &sequence_number, NULL, NULL);
+    // 2nd bucket array has 2 buckets
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    // 3rd bucket array has 4 buckets
+    CLDS_HASH_TABLE_ITEM* item_4 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_3, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x4, item_4, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_delete_item(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_delete_item(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_1, NULL));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+
     // act
-    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, NULL, item_1, NULL, NULL, &old_item, &set_value_seq_no);
+    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_082: [ If new_item is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_NULL_new_item_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(when_item_is_not_found_in_any_bucket_clds_hash_table_delete_key_value_returns_NOT_FOUND)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    int64_t set_value_seq_no;
-    volatile_atomic int64_t sequence_number;
-    (void)interlocked_exchange_64(&sequence_number, 42);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &sequence_number, NULL, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_delete_item(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_3, NULL));
+
     // act
-    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x4, NULL, NULL, NULL, &old_item, &set_value_seq_no);
+    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x3, item_3, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_NOT_FOUND, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_083: [ If old_item is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_NULL_old_item_fails)
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_008: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(when_item_is_not_found_in_any_bucket_clds_hash_table_delete_key_value_returns_NOT_FOUND_even_when_key_is_found_but_different_value)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    int64_t set_value_seq_no;
-    volatile_atomic int64_t sequence_number;
-    (void)interlocked_exchange_64(&sequence_number, 42);
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &sequence_number, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_delete_item(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_3, NULL));
+
     // act
-    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x4, item_1, NULL, NULL, NULL, &set_value_seq_no);
+    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, item_3, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_NOT_FOUND, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
     clds_hazard_pointers_destroy(hazard_pointers);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_084: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_non_NULL_sequence_number_when_a_starting_sequence_number_was_not_specified)
+/* Tests_SRS_CLDS_HASH_TABLE_42_011: [ For each delete the order of the operation shall be computed by passing sequence_number to clds_sorted_list_delete_item. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_deletes_the_key_and_stamps_the_sequence_no)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    int64_t set_value_seq_no;
-    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t sequence_number = 42;
+    int64_t delete_seq_no = 0;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &sequence_number, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_delete_item(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, (CLDS_SORTED_LIST_ITEM*)item, &delete_seq_no));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, IGNORED_ARG));
+
     // act
-    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x4, item_1, NULL, NULL, &old_item, &set_value_seq_no);
+    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, item, &delete_seq_no);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(int64_t, 44, delete_seq_no);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_085: [ clds_hash_table_set_value shall go through all non top level bucket arrays and: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_102: [ If the key is not found in any of the non top level buckets arrays, clds_hash_table_set_value: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_103: [ clds_hash_table_set_value shall obtain the sorted list at the bucket corresponding to the hash of the key. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_104: [  If no list exists at the designated bucket, one shall be created. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_105: [ clds_hash_table_set_value shall call clds_hash_table_set_value on the top level bucket array, passing key, new_item, condition_check_func, condition_check_context, old_item and only_if_exists set to false. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_099: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_OK, clds_hash_table_set_value shall succeed and return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_empty_hash_table_sets_the_value_on_the_top_level_buckets_array)
+/* Tests_SRS_CLDS_HASH_TABLE_42_012: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_delete_key_value shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_delete_key_value_with_non_NULL_sequence_no_but_NULL_start_sequence_number_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_SORTED_LIST_HANDLE linked_list;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    int64_t delete_seq_no = 0;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list);
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item, NULL, NULL, IGNORED_ARG, NULL, false))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list);
-
     // act
-    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL, NULL, &old_item, NULL);
+    result = clds_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, item, &delete_seq_no);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_085: [ clds_hash_table_set_value shall go through all non top level bucket arrays and: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_102: [ If the key is not found in any of the non top level buckets arrays, clds_hash_table_set_value: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_103: [ clds_hash_table_set_value shall obtain the sorted list at the bucket corresponding to the hash of the key. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_104: [  If no list exists at the designated bucket, one shall be created. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_105: [ clds_hash_table_set_value shall call clds_hash_table_set_value on the top level bucket array, passing key, new_item, condition_check_func, condition_check_context, old_item and only_if_exists set to false. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_099: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_OK, clds_hash_table_set_value shall succeed and return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_empty_hash_table_sets_the_value_on_the_top_level_buckets_array_with_condition_check)
+/* clds_hash_table_remove */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_047: [ clds_hash_table_remove shall remove a key from the hash table and return a pointer to the item to the user. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_049: [ On success clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_OK. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_048: [ clds_hash_table_remove shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_067: [ For each remove the order of the operation shall be computed by passing sequence_number to clds_sorted_list_remove_key. ]*/
+TEST_FUNCTION(clds_hash_table_remove_removes_the_key_from_the_list)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_SORTED_LIST_HANDLE linked_list;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list);
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item, test_item_condition_check, (void*)0x42, IGNORED_ARG, NULL, false))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list);
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_remove_key(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
     // act
-    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item, test_item_condition_check, (void*)0x42, &old_item, NULL);
+    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-static void test_when_clds_sorted_list_set_value_fails_clds_hash_table_set_value_with_empty_hash_table_fails(
-    CLDS_SORTED_LIST_SET_VALUE_RESULT sorted_list_result, CLDS_HASH_TABLE_SET_VALUE_RESULT set_value_result,
-    CONDITION_CHECK_CB condition_check_cb, void* condition_check_context)
+/* Tests_SRS_CLDS_HASH_TABLE_01_067: [ For each remove the order of the operation shall be computed by passing sequence_number to clds_sorted_list_remove_key. ]*/
+TEST_FUNCTION(clds_hash_table_remove_removes_the_key_from_the_list_with_non_NULL_sequence_no)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_SORTED_LIST_HANDLE linked_list;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    umock_c_reset_all_calls();
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    volatile_atomic int64_t sequence_number = 42;
+    int64_t remove_seq_no;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &sequence_number, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list);
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item, condition_check_cb, condition_check_context, IGNORED_ARG, NULL, false))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list)
-        .SetReturn(sorted_list_result);
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_remove_key(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, &remove_seq_no));
 
     // act
-    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item, condition_check_cb, condition_check_context, &old_item, NULL);
+    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, &remove_seq_no);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, set_value_result, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, result);
+    ASSERT_ARE_EQUAL(int64_t, 44, remove_seq_no);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
     clds_hazard_pointers_destroy(hazard_pointers);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_100: [ If clds_sorted_list_set_value returns any other value, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-TEST_FUNCTION(when_clds_sorted_list_set_value_fails_with_ERROR_clds_hash_table_set_value_with_empty_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_050: [ If clds_hash_table is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_remove_with_NULL_hash_table_fails)
 {
-    test_when_clds_sorted_list_set_value_fails_clds_hash_table_set_value_with_empty_hash_table_fails(CLDS_SORTED_LIST_SET_VALUE_ERROR, CLDS_HASH_TABLE_SET_VALUE_ERROR, NULL, NULL);
-}
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    umock_c_reset_all_calls();
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_100: [ If clds_sorted_list_set_value returns any other value, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-TEST_FUNCTION(when_clds_sorted_list_set_value_fails_with_NOT_FOUND_clds_hash_table_set_value_with_empty_hash_table_fails)
-{
-    test_when_clds_sorted_list_set_value_fails_clds_hash_table_set_value_with_empty_hash_table_fails(CLDS_SORTED_LIST_SET_VALUE_NOT_FOUND, CLDS_HASH_TABLE_SET_VALUE_ERROR, NULL, NULL);
-}
+    // act
+    result = clds_hash_table_remove(NULL, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
 
-/* Tests_SRS_CLDS_HASH_TABLE_04_002: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET. ]*/
-TEST_FUNCTION(when_clds_sorted_list_set_value_fails_with_CONDITION_NOT_MET_clds_hash_table_set_value_with_empty_hash_table_fails)
-{
-    test_when_clds_sorted_list_set_value_fails_clds_hash_table_set_value_with_empty_hash_table_fails(CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET, test_item_condition_check, (void*)0x42);
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_106: [ If any error occurs, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-TEST_FUNCTION(when_underlying_calls_fail_clds_hash_table_set_value_with_empty_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_052: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_remove_with_NULL_clds_hazard_pointers_thread_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_SORTED_LIST_HANDLE linked_list;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1))
-        .CallCannotFail();
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list)
-        .SetFailReturn(NULL);
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item, NULL, NULL, IGNORED_ARG, NULL, false))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list)
-        .SetFailReturn(CLDS_SORTED_LIST_SET_VALUE_ERROR);
-
-    umock_c_negative_tests_snapshot();
-
-    for (size_t i = 0; i < umock_c_negative_tests_call_count(); i++)
-    {
-        if (umock_c_negative_tests_can_call_fail(i))
-        {
-            umock_c_negative_tests_reset();
-            umock_c_negative_tests_fail_call(i);
-
-            // act
-            result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL, NULL, &old_item, NULL);
+    // act
+    result = clds_hash_table_remove(hash_table, NULL, (void*)0x1, &removed_item, NULL);
 
-            // assert
-            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result, "On failed call %zu", i);
-        }
-    }
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_107: [ If there is no sorted list in the bucket identified by the hash of the key, clds_hash_table_set_value shall advance to the next level of buckets. ]*/
-TEST_FUNCTION(when_there_is_no_sorted_list_in_lower_level_bucket_no_find_is_done_by_clds_hash_table_set_value)
+/* Tests_SRS_CLDS_HASH_TABLE_01_051: [ If key is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_remove_with_NULL_key_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    CLDS_SORTED_LIST_HANDLE linked_list;
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
-    size_t i;
-
-    CLDS_HASH_TABLE_ITEM* dummy_items[4];
-    for (i = 0; i < 4; i++)
-    {
-        dummy_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-        ASSERT_IS_NOT_NULL(dummy_items[i]);
-        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)((4 * i) + 2), dummy_items[i], NULL));
-    }
-
-    CLDS_HASH_TABLE_ITEM* new_item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    ASSERT_IS_NOT_NULL(new_item);
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list);
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x3, (CLDS_SORTED_LIST_ITEM*)new_item, NULL, NULL, IGNORED_ARG, NULL, false))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list);
-
     // act
-    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x3, new_item, NULL, NULL, &old_item, NULL);
+    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, NULL, &removed_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_108: [ If there is a sorted list in the bucket identified by the hash of the key, clds_hash_table_set_value shall find the key in the list. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_109: [ If the key is not found, clds_hash_table_set_value shall advance to the next level of buckets. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_an_existing_item_in_the_lower_level_bucket_looks_for_the_item_in_the_lower_levels)
+/* Tests_SRS_CLDS_HASH_TABLE_01_056: [ If item is NULL, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_remove_with_NULL_item_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_SORTED_LIST_HANDLE linked_list;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
-    // add one filler item to expand the hash table
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x2));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, IGNORED_ARG, IGNORED_ARG))
-        .CaptureReturn(&linked_list);
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x2, (CLDS_SORTED_LIST_ITEM*)item_3, NULL, NULL, IGNORED_ARG, NULL, false))
-        .ValidateArgumentValue_clds_sorted_list(&linked_list);
-
     // act
-    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x2, item_3, NULL, NULL, &old_item, NULL);
+    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, NULL, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item, condition_check_func, condition_check_context and old_item and only_if_exists set to true. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_112: [ If clds_sorted_list_set_value succeeds, clds_hash_table_set_value shall return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_an_existing_item_in_the_lower_level_finds_the_item_and_replaces_it_in_the_lower_levels)
+/* Tests_SRS_CLDS_HASH_TABLE_01_053: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_hash_table_remove_with_a_key_that_is_not_in_the_hash_table_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
-    // add one filler item to expand the hash table
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item_3, NULL, NULL, IGNORED_ARG, NULL, true));
 
     // act
-    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item_3, NULL, NULL, &old_item, NULL);
+    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_NOT_FOUND, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, old_item);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item, condition_check_func, condition_check_context and old_item and only_if_exists set to true. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_112: [ If clds_sorted_list_set_value succeeds, clds_hash_table_set_value shall return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_with_condition_check_cb_has_cb_called)
+/* Tests_SRS_CLDS_HASH_TABLE_01_053: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_hash_table_remove_with_a_key_that_is_already_deleted_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
-    // add one filler item to expand the hash table
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    (void)clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item_3, test_item_condition_check, (void*)0x42, IGNORED_ARG, NULL, true));
-    STRICT_EXPECTED_CALL(test_item_condition_check((void*)0x42, IGNORED_ARG, IGNORED_ARG));
 
     // act
-    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item_3, test_item_condition_check, (void*)0x42, &old_item, NULL);
+    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_NOT_FOUND, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, old_item);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item, condition_check_func, condition_check_context and old_item and only_if_exists set to true. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_04_001: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_fails_when_condition_check_returns_not_met)
+/* Tests_SRS_CLDS_HASH_TABLE_01_054: [ If a bucket is identified and the delete of the item from the underlying list fails, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(when_the_underlying_delete_from_list_fails_clds_hash_table_remove_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
-    // add one filler item to expand the hash table
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item_3, test_item_condition_check, (void*)0x42, IGNORED_ARG, NULL, true));
-    g_condition_check_result = CLDS_CONDITION_CHECK_NOT_MET;
-    STRICT_EXPECTED_CALL(test_item_condition_check((void*)0x42, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_remove_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
+        .SetReturn(CLDS_SORTED_LIST_REMOVE_ERROR);
 
     // act
-    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item_3, test_item_condition_check, (void*)0x42, &old_item, NULL);
+    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
 
     // cleanup
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item, condition_check_func, condition_check_context and old_item and only_if_exists set to true. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_01_111: [ If clds_sorted_list_set_value fails, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_set_value_fails_when_condition_check_returns_error)
+/* Tests_SRS_CLDS_HASH_TABLE_01_055: [ If the element to be deleted is not found in the biggest array of buckets, then it shall be looked up in the next available array of buckets. ]*/
+TEST_FUNCTION(remove_looks_in_2_buckets)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
     CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
-    // add one filler item to expand the hash table
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item_3, test_item_condition_check, (void*)0x42, IGNORED_ARG, NULL, true));
-    g_condition_check_result = CLDS_CONDITION_CHECK_ERROR;
-    STRICT_EXPECTED_CALL(test_item_condition_check((void*)0x42, IGNORED_ARG, IGNORED_ARG));
+    // due to resize it is only one
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_remove_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
     // act
-    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item_3, test_item_condition_check, (void*)0x42, &old_item, NULL);
+    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, result);
 
     // cleanup
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
     clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_111: [ If clds_sorted_list_set_value fails, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
-TEST_FUNCTION(when_clds_sorted_list_set_value_in_lower_layer_fails_clds_hash_table_set_value_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_055: [ If the element to be deleted is not found in the biggest array of buckets, then it shall be looked up in the next available array of buckets. ]*/
+TEST_FUNCTION(remove_looks_in_3_buckets)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
-    CLDS_HASH_TABLE_ITEM* old_item;
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
-    // add one filler item to expand the hash table
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    // 1st bucket array has 1 bucket
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    // 2nd bucket array has 2 buckets
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    // 3rd bucket array has 4 buckets
+    CLDS_HASH_TABLE_ITEM* item_4 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_3, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x4, item_4, NULL);
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
     STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_find_key(IGNORED_ARG, IGNORED_ARG, (void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_set_value(IGNORED_ARG, IGNORED_ARG, (void*)0x1, (CLDS_SORTED_LIST_ITEM*)item_3, NULL, NULL, IGNORED_ARG, NULL, true))
-        .SetReturn(CLDS_SORTED_LIST_SET_VALUE_ERROR);
+    // due to resize, only too lists are there
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_remove_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_remove_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
     // act
-    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item_3, NULL, NULL, &old_item, NULL);
+    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
     clds_hazard_pointers_destroy(hazard_pointers);
-    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
 }
 
-/* on_sorted_list_skipped_seq_no */
-
-/* Tests_SRS_CLDS_HASH_TABLE_01_075: [ on_sorted_list_skipped_seq_no called with NULL context shall return. ]*/
-TEST_FUNCTION(on_sorted_list_skipped_seq_no_with_NULL_returns)
+/* Tests_SRS_CLDS_HASH_TABLE_01_053: [ If the desired key is not found in the hash table (not found in any of the arrays of buckets), clds_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
+TEST_FUNCTION(when_item_is_not_found_in_any_bucket_remove_returns_NOT_FOUND)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    volatile_atomic int64_t start_seq_no;
-    (void)interlocked_exchange_64(&start_seq_no, 0);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
-    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    SORTED_LIST_SKIPPED_SEQ_NO_CB test_on_sorted_list_skipped_seq_no;
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
-        .CaptureArgumentValue_skipped_seq_no_cb(&test_on_sorted_list_skipped_seq_no);
-    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL));
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
-    umock_c_reset_all_calls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_remove_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
     // act
-    test_on_sorted_list_skipped_seq_no(NULL, 1);
+    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x3, &removed_item, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_NOT_FOUND, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_01_076: [ on_sorted_list_skipped_seq_no shall call the skipped sequence number callback passed to clds_hash_table_create and pass the skipped_sequence_no as skipped_sequence_no argument. ]*/
-TEST_FUNCTION(on_sorted_list_skipped_seq_no_calls_the_hash_table_skipped_seq_no)
+/* Tests_SRS_CLDS_HASH_TABLE_01_070: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_remove_with_non_NULL_sequence_no_and_NULL_start_sequence_no_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    volatile_atomic int64_t start_seq_no;
-    (void)interlocked_exchange_64(&start_seq_no, 0);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    SORTED_LIST_SKIPPED_SEQ_NO_CB test_on_sorted_list_skipped_seq_no;
-    void* test_on_sorted_list_skipped_seq_no_context;
-    umock_c_reset_all_calls();
-
-    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
-    STRICT_EXPECTED_CALL(clds_sorted_list_create(hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
-        .CaptureArgumentValue_skipped_seq_no_cb(&test_on_sorted_list_skipped_seq_no)
-        .CaptureArgumentValue_skipped_seq_no_cb_context(&test_on_sorted_list_skipped_seq_no_context);
-    STRICT_EXPECTED_CALL(clds_sorted_list_insert(IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL));
+    CLDS_HASH_TABLE_ITEM* removed_item;
+    int64_t remove_seq_no;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(test_skipped_seq_no_cb(NULL, 1));
-
     // act
-    test_on_sorted_list_skipped_seq_no(test_on_sorted_list_skipped_seq_no_context, 1);
+    result = clds_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, &remove_seq_no);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* clds_hash_table_snapshot */
+/* clds_hash_table_find */
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_013: [ If clds_hash_table is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_null_clds_hash_table_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_034: [ clds_hash_table_find shall find the key identified by key in the hash table and on success return the item corresponding to it. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_040: [ clds_hash_table_find shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_041: [ clds_hash_table_find shall look up the key in the biggest array of buckets. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_044: [ Looking up the key in the array of buckets is done by obtaining the list in the bucket correspoding to the hash and looking up the key in the list by calling clds_sorted_list_find. ]*/
+TEST_FUNCTION(clds_hash_table_find_succeeds)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 3, hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(NULL, hazard_pointers_thread, &items, &item_count);
+    result = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item, (void*)result);
 
     // cleanup
+    clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_014: [ If clds_hazard_pointers_thread is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_null_clds_hazard_pointers_thread_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_034: [ clds_hash_table_find shall find the key identified by key in the hash table and on success return the item corresponding to it. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_040: [ clds_hash_table_find shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+TEST_FUNCTION(clds_hash_table_find_2nd_item_out_of_3_succeeds)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    volatile_atomic int64_t start_seq_no;
-    (void)interlocked_exchange_64(&start_seq_no, 0);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 3, hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_3, NULL);
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, NULL, &items, &item_count);
+    result = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x2);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_2, (void*)result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_015: [ If items is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_null_items_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_034: [ clds_hash_table_find shall find the key identified by key in the hash table and on success return the item corresponding to it. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_040: [ clds_hash_table_find shall hash the key by calling the compute_hash function passed to clds_hash_table_create. ]*/
+TEST_FUNCTION(clds_hash_table_find_3rd_item_out_of_3_succeeds)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    volatile_atomic int64_t start_seq_no;
-    (void)interlocked_exchange_64(&start_seq_no, 0);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 3, hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_3, NULL);
     umock_c_reset_all_calls();
 
-    uint64_t item_count;
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, NULL, &item_count);
+    result = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x3);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_3, (void*)result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_016: [ If item_count is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_null_item_count_fails)
+/* Tests_SRS_CLDS_HASH_TABLE_01_035: [ If clds_hash_table is NULL, clds_hash_table_find shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_hash_table_find_with_NULL_hash_table_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    volatile_atomic int64_t start_seq_no;
-    (void)interlocked_exchange_64(&start_seq_no, 0);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* result;
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, NULL);
+    result = clds_hash_table_find(NULL, hazard_pointers_thread, (void*)0x3);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+    ASSERT_IS_NULL(result);
 
     // cleanup
-    clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_019: [ For each bucket in the array: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_020: [ clds_hash_table_snapshot shall call clds_sorted_list_lock_writes. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_021: [ clds_hash_table_snapshot shall call clds_sorted_list_get_count and add to the running total. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_064: [ If there are no items then clds_hash_table_snapshot shall set items to NULL and item_count to 0 and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_empty_table_succeeds)
+/* Tests_SRS_CLDS_HASH_TABLE_01_036: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_find shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_hash_table_find_with_NULL_clds_hazard_pointers_thread_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    volatile_atomic int64_t start_seq_no;
-    (void)interlocked_exchange_64(&start_seq_no, 0);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
-
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count);
+    result = clds_hash_table_find(hash_table, NULL, (void*)0x3);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
-
-    ASSERT_ARE_EQUAL(uint64_t, 0, item_count);
-    ASSERT_IS_NULL(items);
+    ASSERT_IS_NULL(result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_019: [ For each bucket in the array: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_020: [ clds_hash_table_snapshot shall call clds_sorted_list_lock_writes. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_021: [ clds_hash_table_snapshot shall call clds_sorted_list_get_count and add to the running total. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_025: [ clds_hash_table_snapshot shall call clds_sorted_list_get_count. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_027: [ clds_hash_table_snapshot shall call clds_sorted_list_unlock_writes. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_1_item_succeeds)
+/* Tests_SRS_CLDS_HASH_TABLE_01_037: [ If key is NULL, clds_hash_table_find shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_hash_table_find_with_NULL_key_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    volatile_atomic int64_t start_seq_no;
-    (void)interlocked_exchange_64(&start_seq_no, 0);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
-
+    CLDS_HASH_TABLE_ITEM* result;
     CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
     (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
-
-    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
-
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
-
-    STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
-
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count);
+    result = clds_hash_table_find(hash_table, hazard_pointers_thread, NULL);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
-
-    ASSERT_ARE_EQUAL(uint64_t, 1, item_count);
-    ASSERT_IS_NOT_NULL(items);
-
-    ASSERT_ARE_EQUAL(void_ptr, (void*)item, (void*)items[0]);
+    ASSERT_IS_NULL(result);
 
     // cleanup
-    for (uint64_t i = 0; i < item_count; i++)
-    {
-        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
-    }
-    free(items);
-
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_019: [ For each bucket in the array: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_020: [ clds_hash_table_snapshot shall call clds_sorted_list_lock_writes. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_021: [ clds_hash_table_snapshot shall call clds_sorted_list_get_count and add to the running total. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_025: [ clds_hash_table_snapshot shall call clds_sorted_list_get_count. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_027: [ clds_hash_table_snapshot shall call clds_sorted_list_unlock_writes. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_10_items_same_bucket_succeeds)
+/* Tests_SRS_CLDS_HASH_TABLE_01_042: [ If the key is not found in the biggest array of buckets, the next bucket arrays shall be looked up. ]*/
+TEST_FUNCTION(clds_hash_table_find_looks_up_in_the_2nd_array_of_buckets)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    volatile_atomic int64_t start_seq_no;
-    (void)interlocked_exchange_64(&start_seq_no, 0);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 20, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
-
-    CLDS_HASH_TABLE_ITEM* original_items[10];
-    bool found_originals[10];
-    uint32_t number_of_items = 10;
-
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
-        (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)(uintptr_t)((20 * i) + 1), original_items[i], NULL);
-        found_originals[i] = false;
-    }
+    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_3, NULL);
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
-
-    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
-
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count);
+    result = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
-
-    ASSERT_ARE_EQUAL(uint64_t, number_of_items, item_count);
-    ASSERT_IS_NOT_NULL(items);
-
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        uint32_t original;
-        for (original = 0; original < 10; original++)
-        {
-            if (!found_originals[original] &&
-                (void*)original_items[original] == (void*)items[i])
-            {
-                found_originals[original] = true;
-                break;
-            }
-        }
-
-        if (original >= number_of_items)
-        {
-            ASSERT_FAIL("The returned item in index %" PRIu32 " was not found in the original", i);
-        }
-    }
-
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        ASSERT_IS_TRUE(found_originals[i], "should have found the item with index %" PRIu32, i);
-    }
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_1, (void*)result);
 
     // cleanup
-    for (uint64_t i = 0; i < item_count; i++)
-    {
-        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
-    }
-    free(items);
-
     clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_019: [ For each bucket in the array: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_020: [ clds_hash_table_snapshot shall call clds_sorted_list_lock_writes. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_021: [ clds_hash_table_snapshot shall call clds_sorted_list_get_count and add to the running total. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_025: [ clds_hash_table_snapshot shall call clds_sorted_list_get_count. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_027: [ clds_hash_table_snapshot shall call clds_sorted_list_unlock_writes. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_10_items_multiple_buckets_succeeds)
+/* Tests_SRS_CLDS_HASH_TABLE_01_043: [ If the key is not found at all, clds_hash_table_find shall return NULL. ]*/
+TEST_FUNCTION(when_key_is_not_found_in_any_bucket_levels_clds_hash_table_find_yields_NULL)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
     CLDS_HASH_TABLE_HANDLE hash_table;
-    volatile_atomic int64_t start_seq_no;
-    (void)interlocked_exchange_64(&start_seq_no, 0);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_3, NULL);
+    umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM* original_items[10];
-    bool found_originals[10];
-    uint32_t number_of_items = 10;
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    const uint32_t number_of_sorted_lists = 10;
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x4));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
 
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
-        (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)(uintptr_t)(0x1 + i), original_items[i], NULL);
-        found_originals[i] = false;
-    }
-    umock_c_reset_all_calls();
+    // act
+    result = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x4);
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
 
-    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
-    {
-        STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
-        STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
-    }
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
 
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+/* clds_hash_table_find_batch */
 
-    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
-    {
-        STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
-        STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
-        STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
-    }
+/* Tests_SRS_CLDS_HASH_TABLE_01_174: [ If clds_hash_table is NULL, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_find_batch_with_NULL_clds_hash_table_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    void* keys[1] = { (void*)0x1 };
+    CLDS_HASH_TABLE_ITEM* items[1];
+    int result;
+    umock_c_reset_all_calls();
 
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count);
+    result = clds_hash_table_find_batch(NULL, hazard_pointers_thread, keys, 1, items);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
-    ASSERT_ARE_EQUAL(uint64_t, number_of_items, item_count);
-    ASSERT_IS_NOT_NULL(items);
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
 
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        uint32_t original;
-        for (original = 0; original < number_of_items; original++)
-        {
-            if (!found_originals[original] &&
-                (void*)original_items[original] == (void*)items[i])
-            {
-                found_originals[original] = true;
-                break;
-            }
-        }
+/* Tests_SRS_CLDS_HASH_TABLE_01_175: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_find_batch_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    void* keys[1] = { (void*)0x1 };
+    CLDS_HASH_TABLE_ITEM* items[1];
+    int result;
+    umock_c_reset_all_calls();
 
-        if (original >= number_of_items)
-        {
-            ASSERT_FAIL("The returned item in index %" PRIu32 " was not found in the original", i);
-        }
-    }
+    // act
+    result = clds_hash_table_find_batch(hash_table, NULL, keys, 1, items);
 
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        ASSERT_IS_TRUE(found_originals[i], "should have found the item with index %" PRIu32, i);
-    }
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
-    for (uint64_t i = 0; i < item_count; i++)
-    {
-        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
-    }
-    free(items);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_176: [ If keys is NULL, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_find_batch_with_NULL_keys_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* items[1];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_find_batch(hash_table, hazard_pointers_thread, NULL, 1, items);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
+    // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_019: [ For each bucket in the array: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_020: [ clds_hash_table_snapshot shall call clds_sorted_list_lock_writes. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_021: [ clds_hash_table_snapshot shall call clds_sorted_list_get_count and add to the running total. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_025: [ clds_hash_table_snapshot shall call clds_sorted_list_get_count. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_get_all with the next portion of the allocated array. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_027: [ clds_hash_table_snapshot shall call clds_sorted_list_unlock_writes. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
-/* Tests_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_100_items_multiple_buckets_different_hashes_succeeds)
+/* Tests_SRS_CLDS_HASH_TABLE_01_177: [ If items is NULL, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_find_batch_with_NULL_items_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    volatile_atomic int64_t start_seq_no;
-    (void)interlocked_exchange_64(&start_seq_no, 0);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    void* keys[1] = { (void*)0x1 };
+    int result;
+    umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM* original_items[100];
-    bool found_originals[100];
-    uint32_t number_of_items = 100;
+    // act
+    result = clds_hash_table_find_batch(hash_table, hazard_pointers_thread, keys, 1, NULL);
 
-    const uint32_t number_of_sorted_lists = 100;
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
 
-        STRICT_EXPECTED_CALL(test_compute_hash((void*)(uintptr_t)(0x1 + i)))
-            .SetReturn(i);
-        (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)(uintptr_t)(0x1 + i), original_items[i], NULL);
-        found_originals[i] = false;
-        umock_c_reset_all_calls();
-    }
+/* Tests_SRS_CLDS_HASH_TABLE_01_178: [ If any of the keys is NULL, clds_hash_table_find_batch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_find_batch_with_a_NULL_key_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    void* keys[2] = { (void*)0x1, NULL };
+    CLDS_HASH_TABLE_ITEM* items[2];
+    int result;
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
+    // act
+    result = clds_hash_table_find_batch(hash_table, hazard_pointers_thread, keys, 2, items);
 
-    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
-    {
-        STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
-        STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
-    }
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
 
-    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
-    {
-        STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
-        STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
-        STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
-    }
+/* Tests_SRS_CLDS_HASH_TABLE_01_179: [ clds_hash_table_find_batch shall look up the keys in groups of 16 keys, starting each group by hashing all its keys with the compute_hash function passed to clds_hash_table_create. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_180: [ clds_hash_table_find_batch shall then prefetch the bucket of each key of the group in the first array of buckets, then prefetch the first item of each of these buckets and only then look up each key in its bucket with clds_sorted_list_head_find_key. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_182: [ clds_hash_table_find_batch shall store in each element of items the item found for the key with the same index (with a reference that the caller has to release) or NULL if the key was not found. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_184: [ On success clds_hash_table_find_batch shall return 0. ]*/
+TEST_FUNCTION(clds_hash_table_find_batch_hashes_all_the_keys_before_looking_them_up)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    void* keys[3] = { (void*)0x2, (void*)0x3, (void*)0x1 };
+    CLDS_HASH_TABLE_ITEM* items[3];
+    int result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
 
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count);
+    result = clds_hash_table_find_batch(hash_table, hazard_pointers_thread, keys, 3, items);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, items[0]);
+    ASSERT_IS_NULL(items[1]);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, items[2]);
 
-    ASSERT_ARE_EQUAL(uint64_t, number_of_items, item_count);
-    ASSERT_IS_NOT_NULL(items);
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[2]);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
 
-    for (uint32_t i = 0; i < number_of_items; i++)
+/* Tests_SRS_CLDS_HASH_TABLE_01_179: [ clds_hash_table_find_batch shall look up the keys in groups of 16 keys, starting each group by hashing all its keys with the compute_hash function passed to clds_hash_table_create. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_182: [ clds_hash_table_find_batch shall store in each element of items the item found for the key with the same index (with a reference that the caller has to release) or NULL if the key was not found. ]*/
+TEST_FUNCTION(clds_hash_table_find_batch_with_more_keys_than_a_group_finds_all_the_keys)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 64, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* inserted_items[20];
+    void* keys[20];
+    CLDS_HASH_TABLE_ITEM* items[20];
+    for (uint32_t i = 0; i < 20; i++)
     {
-        uint32_t original;
-        for (original = 0; original < number_of_items; original++)
-        {
-            if (!found_originals[original] &&
-                (void*)original_items[original] == (void*)items[i])
-            {
-                found_originals[original] = true;
-                break;
-            }
-        }
+        keys[i] = (void*)(uintptr_t)(i + 1);
+        inserted_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, keys[i], inserted_items[i], NULL));
+    }
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_find_batch(hash_table, hazard_pointers_thread, keys, 20, items);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        ASSERT_ARE_EQUAL(void_ptr, inserted_items[i], items[i]);
+    }
+
+    // cleanup
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_181: [ If a key is not found in the first array of buckets and the table has other arrays of buckets or items with hashes in the same move stripe as the key were moved between the arrays of buckets meanwhile, clds_hash_table_find_batch shall look up the key the same way clds_hash_table_find does. ]*/
+TEST_FUNCTION(clds_hash_table_find_batch_finds_a_key_in_a_lower_array_of_buckets)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_3, NULL));
+    void* keys[4] = { (void*)0x1, (void*)0x2, (void*)0x3, (void*)0x4 };
+    CLDS_HASH_TABLE_ITEM* items[4];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_find_batch(hash_table, hazard_pointers_thread, keys, 4, items);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, items[0]);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, items[1]);
+    ASSERT_ARE_EQUAL(void_ptr, item_3, items[2]);
+    ASSERT_IS_NULL(items[3]);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[1]);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[2]);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_185: [ If any error occurs, clds_hash_table_find_batch shall release the items it found, fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_acquiring_the_first_bucket_array_fails_clds_hash_table_find_batch_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    void* keys[1] = { (void*)0x1 };
+    CLDS_HASH_TABLE_ITEM* items[1];
+    int result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    result = clds_hash_table_find_batch(hash_table, hazard_pointers_thread, keys, 1, items);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_hash_table_set_value */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_079: [ If clds_hash_table is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_NULL_hash_table_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    int64_t set_value_seq_no;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_set_value(NULL, hazard_pointers_thread, (void*)0x4, item_1, NULL, NULL, &old_item, &set_value_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_080: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    int64_t set_value_seq_no;
+    volatile_atomic int64_t sequence_number;
+    (void)interlocked_exchange_64(&sequence_number, 42);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &sequence_number, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_set_value(hash_table, NULL, (void*)0x4, item_1, NULL, NULL, &old_item, &set_value_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_081: [ If key is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_NULL_key_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    int64_t set_value_seq_no;
+    volatile_atomic int64_t sequence_number;
+    (void)interlocked_exchange_64(&sequence_number, 42);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &sequence_number, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, NULL, item_1, NULL, NULL, &old_item, &set_value_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_082: [ If new_item is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_NULL_new_item_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    int64_t set_value_seq_no;
+    volatile_atomic int64_t sequence_number;
+    (void)interlocked_exchange_64(&sequence_number, 42);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &sequence_number, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x4, NULL, NULL, NULL, &old_item, &set_value_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_083: [ If old_item is NULL, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_NULL_old_item_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    int64_t set_value_seq_no;
+    volatile_atomic int64_t sequence_number;
+    (void)interlocked_exchange_64(&sequence_number, 42);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &sequence_number, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x4, item_1, NULL, NULL, NULL, &set_value_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_084: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_hash_table_create, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_non_NULL_sequence_number_when_a_starting_sequence_number_was_not_specified)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    int64_t set_value_seq_no;
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x4, item_1, NULL, NULL, &old_item, &set_value_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_1);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_085: [ clds_hash_table_set_value shall go through all non top level bucket arrays and: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_102: [ If the key is not found in any of the non top level buckets arrays, clds_hash_table_set_value: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_103: [ clds_hash_table_set_value shall obtain the sorted list at the bucket corresponding to the hash of the key. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_105: [ clds_hash_table_set_value shall call clds_hash_table_set_value on the top level bucket array, passing key, new_item, condition_check_func, condition_check_context, old_item and only_if_exists set to false. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_099: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_OK, clds_hash_table_set_value shall succeed and return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_empty_hash_table_sets_the_value_on_the_top_level_buckets_array)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_set_value(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL, NULL, IGNORED_ARG, NULL, false));
+
+    // act
+    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL, NULL, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_085: [ clds_hash_table_set_value shall go through all non top level bucket arrays and: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_102: [ If the key is not found in any of the non top level buckets arrays, clds_hash_table_set_value: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_103: [ clds_hash_table_set_value shall obtain the sorted list at the bucket corresponding to the hash of the key. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_105: [ clds_hash_table_set_value shall call clds_hash_table_set_value on the top level bucket array, passing key, new_item, condition_check_func, condition_check_context, old_item and only_if_exists set to false. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_099: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_OK, clds_hash_table_set_value shall succeed and return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_empty_hash_table_sets_the_value_on_the_top_level_buckets_array_with_condition_check)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_set_value(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, false));
+
+    // act
+    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item, test_item_condition_check, (void*)0x42, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+static void test_when_clds_sorted_list_set_value_fails_clds_hash_table_set_value_with_empty_hash_table_fails(
+    CLDS_SORTED_LIST_SET_VALUE_RESULT sorted_list_result, CLDS_HASH_TABLE_SET_VALUE_RESULT set_value_result,
+    CONDITION_CHECK_CB condition_check_cb, void* condition_check_context)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_set_value(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, false))
+        .SetReturn(sorted_list_result);
+
+    // act
+    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item, condition_check_cb, condition_check_context, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, set_value_result, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_100: [ If clds_sorted_list_set_value returns any other value, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(when_clds_sorted_list_set_value_fails_with_ERROR_clds_hash_table_set_value_with_empty_hash_table_fails)
+{
+    test_when_clds_sorted_list_set_value_fails_clds_hash_table_set_value_with_empty_hash_table_fails(CLDS_SORTED_LIST_SET_VALUE_ERROR, CLDS_HASH_TABLE_SET_VALUE_ERROR, NULL, NULL);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_100: [ If clds_sorted_list_set_value returns any other value, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(when_clds_sorted_list_set_value_fails_with_NOT_FOUND_clds_hash_table_set_value_with_empty_hash_table_fails)
+{
+    test_when_clds_sorted_list_set_value_fails_clds_hash_table_set_value_with_empty_hash_table_fails(CLDS_SORTED_LIST_SET_VALUE_NOT_FOUND, CLDS_HASH_TABLE_SET_VALUE_ERROR, NULL, NULL);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_04_002: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET. ]*/
+TEST_FUNCTION(when_clds_sorted_list_set_value_fails_with_CONDITION_NOT_MET_clds_hash_table_set_value_with_empty_hash_table_fails)
+{
+    test_when_clds_sorted_list_set_value_fails_clds_hash_table_set_value_with_empty_hash_table_fails(CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET, test_item_condition_check, (void*)0x42);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_106: [ If any error occurs, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(when_underlying_calls_fail_clds_hash_table_set_value_with_empty_hash_table_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls()
+        .CallCannotFail();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1))
+        .CallCannotFail();
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_set_value(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item, NULL, NULL, IGNORED_ARG, NULL, false))
+        .SetFailReturn(CLDS_SORTED_LIST_SET_VALUE_ERROR);
+
+    umock_c_negative_tests_snapshot();
+
+    for (size_t i = 0; i < umock_c_negative_tests_call_count(); i++)
+    {
+        if (umock_c_negative_tests_can_call_fail(i))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(i);
+
+            // act
+            result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL, NULL, &old_item, NULL);
+
+            // assert
+            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result, "On failed call %zu", i);
+        }
+    }
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_107: [ If there is no sorted list in the bucket identified by the hash of the key, clds_hash_table_set_value shall advance to the next level of buckets. ]*/
+TEST_FUNCTION(when_there_is_no_sorted_list_in_lower_level_bucket_no_find_is_done_by_clds_hash_table_set_value)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    size_t i;
+
+    CLDS_HASH_TABLE_ITEM* dummy_items[4];
+    for (i = 0; i < 4; i++)
+    {
+        dummy_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+        ASSERT_IS_NOT_NULL(dummy_items[i]);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)((4 * i) + 2), dummy_items[i], NULL));
+    }
+
+    CLDS_HASH_TABLE_ITEM* new_item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_IS_NOT_NULL(new_item);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_set_value(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)new_item, NULL, NULL, IGNORED_ARG, NULL, false));
+
+    // act
+    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x3, new_item, NULL, NULL, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_108: [ If there is a sorted list in the bucket identified by the hash of the key, clds_hash_table_set_value shall find the key in the list. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_109: [ If the key is not found, clds_hash_table_set_value shall advance to the next level of buckets. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_an_existing_item_in_the_lower_level_bucket_looks_for_the_item_in_the_lower_levels)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    // add one filler item to expand the hash table
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x2));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_set_value(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_3, NULL, NULL, IGNORED_ARG, NULL, false));
+
+    // act
+    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x2, item_3, NULL, NULL, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item, condition_check_func, condition_check_context and old_item and only_if_exists set to true. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_112: [ If clds_sorted_list_set_value succeeds, clds_hash_table_set_value shall return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_an_existing_item_in_the_lower_level_finds_the_item_and_replaces_it_in_the_lower_levels)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    // add one filler item to expand the hash table
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_set_value(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_3, NULL, NULL, IGNORED_ARG, NULL, true));
+
+    // act
+    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item_3, NULL, NULL, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, old_item);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item, condition_check_func, condition_check_context and old_item and only_if_exists set to true. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_112: [ If clds_sorted_list_set_value succeeds, clds_hash_table_set_value shall return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_128: [ The condition_check_func passed to clds_hash_table_set_value shall be called with the keys of the items, not with their hashed keys. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_with_condition_check_cb_has_cb_called)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    // add one filler item to expand the hash table
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_set_value(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_3, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, true));
+    STRICT_EXPECTED_CALL(test_item_condition_check((void*)0x42, (void*)0x1, (void*)0x1));
+
+    // act
+    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item_3, test_item_condition_check, (void*)0x42, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, old_item);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item, condition_check_func, condition_check_context and old_item and only_if_exists set to true. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_04_001: [ If clds_sorted_list_set_value returns CLDS_SORTED_LIST_SET_VALUE_CONDITION_NOT_MET, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_fails_when_condition_check_returns_not_met)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    // add one filler item to expand the hash table
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_set_value(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_3, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, true));
+    g_condition_check_result = CLDS_CONDITION_CHECK_NOT_MET;
+    STRICT_EXPECTED_CALL(test_item_condition_check((void*)0x42, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item_3, test_item_condition_check, (void*)0x42, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_110: [ If the key is found, clds_hash_table_set_value shall call clds_sorted_list_set_value with the key, new_item, condition_check_func, condition_check_context and old_item and only_if_exists set to true. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_111: [ If clds_sorted_list_set_value fails, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_set_value_fails_when_condition_check_returns_error)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    // add one filler item to expand the hash table
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_set_value(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_3, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, NULL, true));
+    g_condition_check_result = CLDS_CONDITION_CHECK_ERROR;
+    STRICT_EXPECTED_CALL(test_item_condition_check((void*)0x42, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item_3, test_item_condition_check, (void*)0x42, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_111: [ If clds_sorted_list_set_value fails, clds_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(when_clds_sorted_list_set_value_in_lower_layer_fails_clds_hash_table_set_value_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    CLDS_HASH_TABLE_ITEM* old_item;
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    // add one filler item to expand the hash table
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_set_value(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, (CLDS_SORTED_LIST_ITEM*)item_3, NULL, NULL, IGNORED_ARG, NULL, true))
+        .SetReturn(CLDS_SORTED_LIST_SET_VALUE_ERROR);
+
+    // act
+    result = clds_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item_3, NULL, NULL, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_3);
+}
+
+/* on_sorted_list_skipped_seq_no */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_075: [ on_sorted_list_skipped_seq_no called with NULL context shall return. ]*/
+TEST_FUNCTION(on_sorted_list_skipped_seq_no_with_NULL_returns)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    SORTED_LIST_SKIPPED_SEQ_NO_CB test_on_sorted_list_skipped_seq_no;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_create(hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
+        .CaptureArgumentValue_skipped_seq_no_cb(&test_on_sorted_list_skipped_seq_no);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    test_on_sorted_list_skipped_seq_no(NULL, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_076: [ on_sorted_list_skipped_seq_no shall call the skipped sequence number callback passed to clds_hash_table_create and pass the skipped_sequence_no as skipped_sequence_no argument. ]*/
+TEST_FUNCTION(on_sorted_list_skipped_seq_no_calls_the_hash_table_skipped_seq_no)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    SORTED_LIST_SKIPPED_SEQ_NO_CB test_on_sorted_list_skipped_seq_no;
+    void* test_on_sorted_list_skipped_seq_no_context;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_create(hazard_pointers, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG))
+        .CaptureArgumentValue_skipped_seq_no_cb(&test_on_sorted_list_skipped_seq_no)
+        .CaptureArgumentValue_skipped_seq_no_cb_context(&test_on_sorted_list_skipped_seq_no_context);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_skipped_seq_no_cb(NULL, 1));
+
+    // act
+    test_on_sorted_list_skipped_seq_no(test_on_sorted_list_skipped_seq_no_context, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_hash_table_snapshot */
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_013: [ If clds_hash_table is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_null_clds_hash_table_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(NULL, hazard_pointers_thread, &items, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_014: [ If clds_hazard_pointers_thread is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_null_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, NULL, &items, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_015: [ If items is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_null_items_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    uint64_t item_count;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, NULL, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_016: [ If item_count is NULL then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_null_item_count_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_019: [ For each bucket in the array: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_020: [ clds_hash_table_snapshot shall call clds_sorted_list_lock_writes on the sorted list shared by all the buckets. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_021: [ clds_hash_table_snapshot shall call clds_sorted_list_head_get_count and add to the running total. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_064: [ If there are no items then clds_hash_table_snapshot shall set items to NULL and item_count to 0 and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_empty_table_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+
+    ASSERT_ARE_EQUAL(uint64_t, 0, item_count);
+    ASSERT_IS_NULL(items);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_019: [ For each bucket in the array: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_020: [ clds_hash_table_snapshot shall call clds_sorted_list_lock_writes on the sorted list shared by all the buckets. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_021: [ clds_hash_table_snapshot shall call clds_sorted_list_head_get_count and add to the running total. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_025: [ clds_hash_table_snapshot shall call clds_sorted_list_head_get_count. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_head_get_all with the next portion of the allocated array. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_027: [ clds_hash_table_snapshot shall call clds_sorted_list_unlock_writes on the sorted list shared by all the buckets. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_1_item_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* item = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_get_count(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
+
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_get_count(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_get_all(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+
+    ASSERT_ARE_EQUAL(uint64_t, 1, item_count);
+    ASSERT_IS_NOT_NULL(items);
+
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item, (void*)items[0]);
+
+    // cleanup
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_019: [ For each bucket in the array: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_020: [ clds_hash_table_snapshot shall call clds_sorted_list_lock_writes on the sorted list shared by all the buckets. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_021: [ clds_hash_table_snapshot shall call clds_sorted_list_head_get_count and add to the running total. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_025: [ clds_hash_table_snapshot shall call clds_sorted_list_head_get_count. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_head_get_all with the next portion of the allocated array. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_027: [ clds_hash_table_snapshot shall call clds_sorted_list_unlock_writes on the sorted list shared by all the buckets. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_10_items_same_bucket_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 20, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* original_items[10];
+    bool found_originals[10];
+    uint32_t number_of_items = 10;
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
+        (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)(uintptr_t)((20 * i) + 1), original_items[i], NULL);
+        found_originals[i] = false;
+    }
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_get_count(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
+
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_get_count(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_get_all(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+
+    ASSERT_ARE_EQUAL(uint64_t, number_of_items, item_count);
+    ASSERT_IS_NOT_NULL(items);
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        uint32_t original;
+        for (original = 0; original < 10; original++)
+        {
+            if (!found_originals[original] &&
+                (void*)original_items[original] == (void*)items[i])
+            {
+                found_originals[original] = true;
+                break;
+            }
+        }
+
+        if (original >= number_of_items)
+        {
+            ASSERT_FAIL("The returned item in index %" PRIu32 " was not found in the original", i);
+        }
+    }
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        ASSERT_IS_TRUE(found_originals[i], "should have found the item with index %" PRIu32, i);
+    }
+
+    // cleanup
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_019: [ For each bucket in the array: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_020: [ clds_hash_table_snapshot shall call clds_sorted_list_lock_writes on the sorted list shared by all the buckets. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_021: [ clds_hash_table_snapshot shall call clds_sorted_list_head_get_count and add to the running total. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_025: [ clds_hash_table_snapshot shall call clds_sorted_list_head_get_count. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_head_get_all with the next portion of the allocated array. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_027: [ clds_hash_table_snapshot shall call clds_sorted_list_unlock_writes on the sorted list shared by all the buckets. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_10_items_multiple_buckets_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+
+    CLDS_HASH_TABLE_ITEM* original_items[10];
+    bool found_originals[10];
+    uint32_t number_of_items = 10;
+
+    const uint32_t number_of_sorted_lists = 10;
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
+        (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)(uintptr_t)(0x1 + i), original_items[i], NULL);
+        found_originals[i] = false;
+    }
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
+
+    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
+    {
+        STRICT_EXPECTED_CALL(clds_sorted_list_head_get_count(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
+    }
+
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+
+    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
+    {
+        STRICT_EXPECTED_CALL(clds_sorted_list_head_get_count(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
+        STRICT_EXPECTED_CALL(clds_sorted_list_head_get_all(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    }
+    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+
+    ASSERT_ARE_EQUAL(uint64_t, number_of_items, item_count);
+    ASSERT_IS_NOT_NULL(items);
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        uint32_t original;
+        for (original = 0; original < number_of_items; original++)
+        {
+            if (!found_originals[original] &&
+                (void*)original_items[original] == (void*)items[i])
+            {
+                found_originals[original] = true;
+                break;
+            }
+        }
+
+        if (original >= number_of_items)
+        {
+            ASSERT_FAIL("The returned item in index %" PRIu32 " was not found in the original", i);
+        }
+    }
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        ASSERT_IS_TRUE(found_originals[i], "should have found the item with index %" PRIu32, i);
+    }
+
+    // cleanup
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_019: [ For each bucket in the array: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_020: [ clds_hash_table_snapshot shall call clds_sorted_list_lock_writes on the sorted list shared by all the buckets. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_021: [ clds_hash_table_snapshot shall call clds_sorted_list_head_get_count and add to the running total. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_023: [ clds_hash_table_snapshot shall allocate an array of CLDS_HASH_TABLE_ITEM* ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_024: [ For each bucket in the array: ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_025: [ clds_hash_table_snapshot shall call clds_sorted_list_head_get_count. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_026: [ clds_hash_table_snapshot shall call clds_sorted_list_head_get_all with the next portion of the allocated array. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_027: [ clds_hash_table_snapshot shall call clds_sorted_list_unlock_writes on the sorted list shared by all the buckets. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_028: [ clds_hash_table_snapshot shall store the allocated array of items in items. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_029: [ clds_hash_table_snapshot shall store the count of items in item_count. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_42_031: [ clds_hash_table_snapshot shall succeed and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_100_items_multiple_buckets_different_hashes_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+
+    CLDS_HASH_TABLE_ITEM* original_items[100];
+    bool found_originals[100];
+    uint32_t number_of_items = 100;
+
+    const uint32_t number_of_sorted_lists = 100;
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
+
+        STRICT_EXPECTED_CALL(test_compute_hash((void*)(uintptr_t)(0x1 + i)))
+            .SetReturn(i);
+        (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)(uintptr_t)(0x1 + i), original_items[i], NULL);
+        found_originals[i] = false;
+        umock_c_reset_all_calls();
+    }
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
+
+    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
+    {
+        STRICT_EXPECTED_CALL(clds_sorted_list_head_get_count(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
+    }
+
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+
+    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
+    {
+        STRICT_EXPECTED_CALL(clds_sorted_list_head_get_count(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
+        STRICT_EXPECTED_CALL(clds_sorted_list_head_get_all(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    }
+    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+
+    ASSERT_ARE_EQUAL(uint64_t, number_of_items, item_count);
+    ASSERT_IS_NOT_NULL(items);
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        uint32_t original;
+        for (original = 0; original < number_of_items; original++)
+        {
+            if (!found_originals[original] &&
+                (void*)original_items[original] == (void*)items[i])
+            {
+                found_originals[original] = true;
+                break;
+            }
+        }
+
+        if (original >= number_of_items)
+        {
+            ASSERT_FAIL("The returned item in index %" PRIu32 " was not found in the original", i);
+        }
+    }
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        ASSERT_IS_TRUE(found_originals[i], "should have found the item with index %" PRIu32, i);
+    }
+
+    // cleanup
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_10_items_same_bucket_fails_when_underlying_functions_fail)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 20, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+
+    CLDS_HASH_TABLE_ITEM* original_items[10];
+
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
+        (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)(uintptr_t)(0x1 + (20 * i)), original_items[i], NULL);
+    }
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_get_count(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
+
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_get_count(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_get_all(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+
+    umock_c_negative_tests_snapshot();
+
+    for (size_t i = 0; i < umock_c_negative_tests_call_count(); i++)
+    {
+        if (umock_c_negative_tests_can_call_fail(i))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(i);
+
+            // act
+            CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count);
+
+            // assert
+            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result, "On failed call %zu", i);
+        }
+    }
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_10_items_multiple_buckets_fails_when_underlying_functions_fail)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+
+    CLDS_HASH_TABLE_ITEM* original_items[10];
+
+    const uint32_t number_of_sorted_lists = 10;
+
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
+        (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)(uintptr_t)(0x1 + i), original_items[i], NULL);
+    }
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
+
+    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
+    {
+        STRICT_EXPECTED_CALL(clds_sorted_list_head_get_count(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
+    }
+
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+
+    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
+    {
+        STRICT_EXPECTED_CALL(clds_sorted_list_head_get_count(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
+        STRICT_EXPECTED_CALL(clds_sorted_list_head_get_all(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    }
+    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+
+    umock_c_negative_tests_snapshot();
+
+    for (size_t i = 0; i < umock_c_negative_tests_call_count(); i++)
+    {
+        if (umock_c_negative_tests_can_call_fail(i))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(i);
+
+            // act
+            CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count);
+
+            // assert
+            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result, "On failed call %zu", i);
+        }
+    }
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_with_20_items_multiple_buckets_different_hashes_fails_when_underlying_functions_fail)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+
+    CLDS_HASH_TABLE_ITEM* original_items[20];
+    uint32_t number_of_items = 20;
+
+    const uint32_t number_of_sorted_lists = 20;
+
+    for (uint32_t i = 0; i < number_of_items; i++)
+    {
+        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
+
+        STRICT_EXPECTED_CALL(test_compute_hash((void*)(uintptr_t)(0x1 + i)))
+            .SetReturn(i);
+        (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)(uintptr_t)(0x1 + i), original_items[i], NULL);
+        umock_c_reset_all_calls();
+    }
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
+
+    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
+    {
+        STRICT_EXPECTED_CALL(clds_sorted_list_head_get_count(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
+    }
+
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+
+    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
+    {
+        STRICT_EXPECTED_CALL(clds_sorted_list_head_get_count(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
+        STRICT_EXPECTED_CALL(clds_sorted_list_head_get_all(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
+    }
+    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+
+    umock_c_negative_tests_snapshot();
+
+    for (size_t i = 0; i < umock_c_negative_tests_call_count(); i++)
+    {
+        if (umock_c_negative_tests_can_call_fail(i))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(i);
+
+            // act
+            CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count);
+
+            // assert
+            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result, "On failed call %zu", i);
+        }
+    }
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_42_022: [ If the addition of the list count causes overflow then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_fails_if_number_of_items_would_overflow)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    // keep the items in the arrays of buckets they were inserted in
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
+
+    umock_c_reset_all_calls();
+
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+
+    uint64_t mocked_item_count_1 = UINT64_MAX / 2 + 1;
+    uint64_t mocked_item_count_2 = UINT64_MAX / 2 + 1;
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_get_count(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG))
+        .CopyOutArgumentBuffer_item_count(&mocked_item_count_1, sizeof(mocked_item_count_1));
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_get_count(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG))
+        .CopyOutArgumentBuffer_item_count(&mocked_item_count_2, sizeof(mocked_item_count_2));
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_hash_table_snapshot_at_sequence_number */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_136: [ If clds_hash_table is NULL, clds_hash_table_snapshot_at_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_at_sequence_number_with_NULL_clds_hash_table_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    int64_t sequence_number;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_at_sequence_number(NULL, hazard_pointers_thread, &items, &item_count, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_140: [ If sequence_number is NULL, clds_hash_table_snapshot_at_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_at_sequence_number_with_NULL_sequence_number_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_at_sequence_number(hash_table, hazard_pointers_thread, &items, &item_count, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_141: [ If no start sequence number was specified in clds_hash_table_create, clds_hash_table_snapshot_at_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_at_sequence_number_without_sequence_numbers_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    int64_t sequence_number;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_at_sequence_number(hash_table, hazard_pointers_thread, &items, &item_count, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_143: [ clds_hash_table_snapshot_at_sequence_number shall wait for the write operations that started before it to complete and then take the current sequence number of the table as the sequence number of the snapshot, without blocking the write operations that start after it. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_147: [ If there are no items, clds_hash_table_snapshot_at_sequence_number shall set items to NULL and item_count to 0. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_at_sequence_number_with_empty_table_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 42);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    int64_t sequence_number;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_at_sequence_number(hash_table, hazard_pointers_thread, &items, &item_count, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_IS_NULL(items);
+    ASSERT_ARE_EQUAL(uint64_t, 0, item_count);
+    ASSERT_ARE_EQUAL(int64_t, 42, sequence_number);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_144: [ clds_hash_table_snapshot_at_sequence_number shall walk the items of each bucket by calling clds_sorted_list_head_get_first and then clds_sorted_list_head_get_next with the key of the last item, while the writes continue. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_145: [ clds_hash_table_snapshot_at_sequence_number shall return the items that were inserted at or before the sequence number of the snapshot. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_148: [ On success clds_hash_table_snapshot_at_sequence_number shall store the items, each with a reference that the caller has to release, in items, their count in item_count and the sequence number of the snapshot in sequence_number and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_at_sequence_number_with_2_items_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    int64_t sequence_number;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_at_sequence_number(hash_table, hazard_pointers_thread, &items, &item_count, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_EQUAL(uint64_t, 2, item_count);
+    ASSERT_IS_TRUE(((items[0] == item_1) && (items[1] == item_2)) || ((items[0] == item_2) && (items[1] == item_1)));
+    ASSERT_ARE_EQUAL(int64_t, 2, sequence_number);
+
+    // cleanup
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_146: [ clds_hash_table_snapshot_at_sequence_number shall also return the items that were inserted at or before the sequence number of the snapshot and taken out of the table after it while the snapshot was taken. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_150: [ While a snapshot at a sequence number is taken, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove and clds_hash_table_set_value shall keep a reference to each item they take out of the table, together with the sequence numbers of its insert and of its removal, until the snapshot completes. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_at_sequence_number_returns_an_item_deleted_before_its_bucket_is_walked)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    int64_t sequence_number;
+
+    // the bucket of 0x2 is walked first, 0x1 is deleted while it is walked
+    g_write_during_walk_hash_table = hash_table;
+    g_write_during_walk_thread = hazard_pointers_thread;
+    g_write_during_walk_key = (void*)0x1;
+    g_write_during_walk_item = NULL;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_at_sequence_number(hash_table, hazard_pointers_thread, &items, &item_count, &sequence_number);
+
+    // assert
+    ASSERT_IS_NULL(g_write_during_walk_hash_table);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_EQUAL(uint64_t, 2, item_count);
+    ASSERT_IS_TRUE(((items[0] == item_1) && (items[1] == item_2)) || ((items[0] == item_2) && (items[1] == item_1)));
+    ASSERT_ARE_EQUAL(int64_t, 2, sequence_number);
+    ASSERT_IS_NULL(clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1));
+
+    // cleanup
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_150: [ While a snapshot at a sequence number is taken, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove and clds_hash_table_set_value shall keep a reference to each item they take out of the table, together with the sequence numbers of its insert and of its removal, until the snapshot completes. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_at_sequence_number_keeps_an_item_deleted_while_the_buckets_are_walked_without_allocating)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    int64_t sequence_number;
+
+    g_write_during_walk_hash_table = hash_table;
+    g_write_during_walk_thread = hazard_pointers_thread;
+    g_write_during_walk_key = (void*)0x1;
+    g_write_during_walk_item = NULL;
+    g_write_during_walk_malloc_count = 1;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_at_sequence_number(hash_table, hazard_pointers_thread, &items, &item_count, &sequence_number);
+
+    // assert
+    ASSERT_IS_NULL(g_write_during_walk_hash_table);
+    ASSERT_ARE_EQUAL(size_t, 0, g_write_during_walk_malloc_count);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_EQUAL(uint64_t, 2, item_count);
+
+    // cleanup
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_146: [ clds_hash_table_snapshot_at_sequence_number shall also return the items that were inserted at or before the sequence number of the snapshot and taken out of the table after it while the snapshot was taken. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_150: [ While a snapshot at a sequence number is taken, clds_hash_table_delete, clds_hash_table_delete_key_value, clds_hash_table_remove and clds_hash_table_set_value shall keep a reference to each item they take out of the table, together with the sequence numbers of its insert and of its removal, until the snapshot completes. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_at_sequence_number_returns_an_item_removed_inserted_again_and_removed_again_before_its_bucket_is_walked)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    int64_t sequence_number;
+
+    // the bucket of 0x2 is walked first, item_1 is taken out, inserted again and taken out again while it is walked
+    g_write_during_walk_hash_table = hash_table;
+    g_write_during_walk_thread = hazard_pointers_thread;
+    g_write_during_walk_key = (void*)0x1;
+    g_write_during_walk_item = NULL;
+    g_write_during_walk_remove_twice = true;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_at_sequence_number(hash_table, hazard_pointers_thread, &items, &item_count, &sequence_number);
+
+    // assert
+    ASSERT_IS_NULL(g_write_during_walk_hash_table);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_EQUAL(uint64_t, 2, item_count);
+    ASSERT_IS_TRUE(((items[0] == item_1) && (items[1] == item_2)) || ((items[0] == item_2) && (items[1] == item_1)));
+    ASSERT_ARE_EQUAL(int64_t, 2, sequence_number);
+    ASSERT_IS_NULL(clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1));
+
+    // cleanup
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_230: [ When the snapshot completes, clds_hash_table_snapshot_at_sequence_number shall stop the writes from keeping items, wait for the writes that still keep items to complete and release all the kept items. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_at_sequence_number_releases_the_kept_items_when_it_completes)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    HASH_TABLE_ITEM* hash_table_item_1 = CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, item_1);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    int64_t sequence_number;
+
+    g_write_during_walk_hash_table = hash_table;
+    g_write_during_walk_thread = hazard_pointers_thread;
+    g_write_during_walk_key = (void*)0x1;
+    g_write_during_walk_item = NULL;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_at_sequence_number(hash_table, hazard_pointers_thread, &items, &item_count, &sequence_number);
+
+    // assert
+    ASSERT_IS_NULL(g_write_during_walk_hash_table);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_EQUAL(uint64_t, 2, item_count);
+    // the snapshot holds a reference on item_1, the item is not linked in the kept items anymore
+    ASSERT_ARE_EQUAL(int32_t, 0, interlocked_add(&hash_table_item_1->is_superseded, 0));
+    ASSERT_IS_NULL(hash_table_item_1->next_superseded_item);
+
+    // cleanup
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_145: [ clds_hash_table_snapshot_at_sequence_number shall return the items that were inserted at or before the sequence number of the snapshot. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_at_sequence_number_does_not_return_an_item_inserted_while_the_buckets_are_walked)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 4, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4244);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    int64_t sequence_number;
+
+    // 0x3 lands in a bucket that is walked after the one of 0x1
+    g_write_during_walk_hash_table = hash_table;
+    g_write_during_walk_thread = hazard_pointers_thread;
+    g_write_during_walk_key = (void*)0x3;
+    g_write_during_walk_item = item_3;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_at_sequence_number(hash_table, hazard_pointers_thread, &items, &item_count, &sequence_number);
+
+    // assert
+    ASSERT_IS_NULL(g_write_during_walk_hash_table);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_EQUAL(uint64_t, 2, item_count);
+    ASSERT_IS_TRUE(((items[0] == item_1) && (items[1] == item_2)) || ((items[0] == item_2) && (items[1] == item_1)));
+    ASSERT_ARE_EQUAL(int64_t, 2, sequence_number);
+
+    // cleanup
+    for (uint64_t i = 0; i < item_count; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_149: [ If any error occurs, clds_hash_table_snapshot_at_sequence_number shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_hash_table_snapshot_at_sequence_number_fails_when_clds_sorted_list_head_get_first_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t start_seq_no;
+    (void)interlocked_exchange_64(&start_seq_no, 0);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    CLDS_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    int64_t sequence_number;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_get_first(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG))
+        .SetReturn(1);
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot_at_sequence_number(hash_table, hazard_pointers_thread, &items, &item_count, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_hash_table_cursor_open */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_152: [ If clds_hash_table is NULL, clds_hash_table_cursor_open shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_hash_table_cursor_open_with_NULL_clds_hash_table_fails)
+{
+    // arrange
+    CLDS_HASH_TABLE_CURSOR_HANDLE cursor;
+
+    // act
+    cursor = clds_hash_table_cursor_open(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(cursor);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_153: [ clds_hash_table_cursor_open shall allocate a new cursor. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_155: [ clds_hash_table_cursor_open shall increment the count of open cursors of the table and wait for the write operations that started before it to complete, without blocking the write operations that start after it. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_156: [ clds_hash_table_cursor_open shall position the cursor at the first bucket of the first array of buckets. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_157: [ On success clds_hash_table_cursor_open shall return a non-NULL handle to the cursor. ]*/
+TEST_FUNCTION(clds_hash_table_cursor_open_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_CURSOR_HANDLE cursor;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    cursor = clds_hash_table_cursor_open(hash_table);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(cursor);
+
+    // cleanup
+    clds_hash_table_cursor_close(cursor);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_154: [ If any error occurs, clds_hash_table_cursor_open shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_memory_fails_clds_hash_table_cursor_open_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_CURSOR_HANDLE cursor;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    cursor = clds_hash_table_cursor_open(hash_table);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(cursor);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_hash_table_cursor_next */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_158: [ If clds_hash_table_cursor is NULL, clds_hash_table_cursor_next shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_cursor_next_with_NULL_clds_hash_table_cursor_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_ITEM* items[2];
+    uint32_t item_count;
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_cursor_next(NULL, hazard_pointers_thread, items, 2, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_159: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_cursor_next shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_cursor_next_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_CURSOR_HANDLE cursor = clds_hash_table_cursor_open(hash_table);
+    CLDS_HASH_TABLE_ITEM* items[2];
+    uint32_t item_count;
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_cursor_next(cursor, NULL, items, 2, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_cursor_close(cursor);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_160: [ If items is NULL, clds_hash_table_cursor_next shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_cursor_next_with_NULL_items_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_CURSOR_HANDLE cursor = clds_hash_table_cursor_open(hash_table);
+    uint32_t item_count;
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_cursor_next(cursor, hazard_pointers_thread, NULL, 2, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_cursor_close(cursor);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_161: [ If item_capacity is 0, clds_hash_table_cursor_next shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_cursor_next_with_0_item_capacity_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_CURSOR_HANDLE cursor = clds_hash_table_cursor_open(hash_table);
+    CLDS_HASH_TABLE_ITEM* items[2];
+    uint32_t item_count;
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_cursor_next(cursor, hazard_pointers_thread, items, 0, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_cursor_close(cursor);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_162: [ If item_count is NULL, clds_hash_table_cursor_next shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_cursor_next_with_NULL_item_count_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_CURSOR_HANDLE cursor = clds_hash_table_cursor_open(hash_table);
+    CLDS_HASH_TABLE_ITEM* items[2];
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_cursor_next(cursor, hazard_pointers_thread, items, 2, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_cursor_close(cursor);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_164: [ Once a bucket has no more items, clds_hash_table_cursor_next shall continue with the next bucket and after the last bucket of an array of buckets with the first bucket of the next array of buckets. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_167: [ On success clds_hash_table_cursor_next shall store the number of items stored in items in item_count (0 once all the buckets were walked) and return 0. ]*/
+TEST_FUNCTION(clds_hash_table_cursor_next_on_an_empty_table_returns_0_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_CURSOR_HANDLE cursor = clds_hash_table_cursor_open(hash_table);
+    CLDS_HASH_TABLE_ITEM* items[2];
+    uint32_t item_count;
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_cursor_next(cursor, hazard_pointers_thread, items, 2, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint32_t, 0, item_count);
+
+    // cleanup
+    clds_hash_table_cursor_close(cursor);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_163: [ clds_hash_table_cursor_next shall walk the buckets from where the previous call left off, getting the first item of a bucket with clds_sorted_list_head_get_first and each following item with clds_sorted_list_head_get_next and the key of the last item returned out of the bucket. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_165: [ clds_hash_table_cursor_next shall stop once item_capacity items are stored in items or all the arrays of buckets were walked. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_166: [ clds_hash_table_cursor_next shall return each item with a reference that the caller has to release. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_167: [ On success clds_hash_table_cursor_next shall store the number of items stored in items in item_count (0 once all the buckets were walked) and return 0. ]*/
+TEST_FUNCTION(clds_hash_table_cursor_next_returns_all_the_items_in_batches)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4244);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_3, NULL));
+    CLDS_HASH_TABLE_CURSOR_HANDLE cursor = clds_hash_table_cursor_open(hash_table);
+    CLDS_HASH_TABLE_ITEM* items[4];
+    uint32_t item_count_1;
+    uint32_t item_count_2;
+    uint32_t item_count_3;
+    int result_1;
+    int result_2;
+    int result_3;
+    umock_c_reset_all_calls();
+
+    // act
+    result_1 = clds_hash_table_cursor_next(cursor, hazard_pointers_thread, &items[0], 2, &item_count_1);
+    result_2 = clds_hash_table_cursor_next(cursor, hazard_pointers_thread, &items[2], 2, &item_count_2);
+    result_3 = clds_hash_table_cursor_next(cursor, hazard_pointers_thread, &items[3], 1, &item_count_3);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result_1);
+    ASSERT_ARE_EQUAL(uint32_t, 2, item_count_1);
+    ASSERT_ARE_EQUAL(int, 0, result_2);
+    ASSERT_ARE_EQUAL(uint32_t, 1, item_count_2);
+    ASSERT_ARE_EQUAL(int, 0, result_3);
+    ASSERT_ARE_EQUAL(uint32_t, 0, item_count_3);
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        ASSERT_IS_TRUE((items[i] == item_1) || (items[i] == item_2) || (items[i] == item_3));
+        for (uint32_t j = 0; j < i; j++)
+        {
+            ASSERT_ARE_NOT_EQUAL(void_ptr, items[j], items[i]);
+        }
+    }
+
+    // cleanup
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    clds_hash_table_cursor_close(cursor);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_163: [ clds_hash_table_cursor_next shall walk the buckets from where the previous call left off, getting the first item of a bucket with clds_sorted_list_head_get_first and each following item with clds_sorted_list_head_get_next and the key of the last item returned out of the bucket. ]*/
+TEST_FUNCTION(clds_hash_table_cursor_next_continues_after_the_last_item_returned_when_it_was_deleted)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    CLDS_HASH_TABLE_CURSOR_HANDLE cursor = clds_hash_table_cursor_open(hash_table);
+    CLDS_HASH_TABLE_ITEM* first_item;
+    CLDS_HASH_TABLE_ITEM* second_item;
+    uint32_t item_count;
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_cursor_next(cursor, hazard_pointers_thread, &first_item, 1, &item_count));
+    ASSERT_ARE_EQUAL(uint32_t, 1, item_count);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_hash_table_delete(hash_table, hazard_pointers_thread, (first_item == item_1) ? (void*)0x1 : (void*)0x2, NULL));
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_cursor_next(cursor, hazard_pointers_thread, &second_item, 1, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint32_t, 1, item_count);
+    ASSERT_ARE_EQUAL(void_ptr, (first_item == item_1) ? item_2 : item_1, second_item);
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_cursor_next(cursor, hazard_pointers_thread, &second_item, 1, &item_count));
+    ASSERT_ARE_EQUAL(uint32_t, 0, item_count);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, first_item);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, (first_item == item_1) ? item_2 : item_1);
+    clds_hash_table_cursor_close(cursor);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_168: [ If clds_sorted_list_head_get_first or clds_sorted_list_head_get_next fails before any item was stored in items, clds_hash_table_cursor_next shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_clds_sorted_list_head_get_first_fails_clds_hash_table_cursor_next_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    CLDS_HASH_TABLE_CURSOR_HANDLE cursor = clds_hash_table_cursor_open(hash_table);
+    CLDS_HASH_TABLE_ITEM* items[2];
+    uint32_t item_count;
+    int result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_get_first(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG))
+        .SetReturn(1);
+
+    // act
+    result = clds_hash_table_cursor_next(cursor, hazard_pointers_thread, items, 2, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_cursor_close(cursor);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_169: [ If clds_sorted_list_head_get_first or clds_sorted_list_head_get_next fails after items were stored in items, clds_hash_table_cursor_next shall return the stored items and the next call shall continue with the bucket that failed. ]*/
+TEST_FUNCTION(when_clds_sorted_list_head_get_next_fails_after_an_item_was_stored_clds_hash_table_cursor_next_returns_the_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL));
+    CLDS_HASH_TABLE_CURSOR_HANDLE cursor = clds_hash_table_cursor_open(hash_table);
+    CLDS_HASH_TABLE_ITEM* items[2];
+    uint32_t item_count;
+    int result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_get_first(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_inc_ref(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_get_next(IGNORED_ARG, IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG))
+        .SetReturn(1);
+
+    // act
+    result = clds_hash_table_cursor_next(cursor, hazard_pointers_thread, items, 2, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint32_t, 1, item_count);
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_cursor_next(cursor, hazard_pointers_thread, &items[1], 1, &item_count));
+    ASSERT_ARE_EQUAL(uint32_t, 1, item_count);
+    ASSERT_ARE_NOT_EQUAL(void_ptr, items[0], items[1]);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[0]);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[1]);
+    clds_hash_table_cursor_close(cursor);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_hash_table_cursor_close */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_170: [ If clds_hash_table_cursor is NULL, clds_hash_table_cursor_close shall return. ]*/
+TEST_FUNCTION(clds_hash_table_cursor_close_with_NULL_clds_hash_table_cursor_returns)
+{
+    // arrange
+
+    // act
+    clds_hash_table_cursor_close(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_171: [ clds_hash_table_cursor_close shall release the reference the cursor holds on the last item it returned. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_172: [ clds_hash_table_cursor_close shall decrement the count of open cursors of the table and free the cursor. ]*/
+TEST_FUNCTION(clds_hash_table_cursor_close_releases_the_last_item_and_frees_the_cursor)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    CLDS_HASH_TABLE_CURSOR_HANDLE cursor = clds_hash_table_cursor_open(hash_table);
+    CLDS_HASH_TABLE_ITEM* item;
+    uint32_t item_count;
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_cursor_next(cursor, hazard_pointers_thread, &item, 1, &item_count));
+    ASSERT_ARE_EQUAL(uint32_t, 1, item_count);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_sorted_list_node_release(item_1));
+    STRICT_EXPECTED_CALL(free(cursor));
+
+    // act
+    clds_hash_table_cursor_close(cursor);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_hash_table_set_migration_bucket_count */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_120: [ If clds_hash_table is NULL, clds_hash_table_set_migration_bucket_count shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_set_migration_bucket_count_with_NULL_hash_table_fails)
+{
+    // arrange
+    int result;
+
+    // act
+    result = clds_hash_table_set_migration_bucket_count(NULL, 1, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_121: [ If write_migration_bucket_count or read_migration_bucket_count is greater than INT32_MAX, clds_hash_table_set_migration_bucket_count shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_set_migration_bucket_count_with_write_migration_bucket_count_too_big_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_set_migration_bucket_count(hash_table, (uint32_t)INT32_MAX + 1, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_121: [ If write_migration_bucket_count or read_migration_bucket_count is greater than INT32_MAX, clds_hash_table_set_migration_bucket_count shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_set_migration_bucket_count_with_read_migration_bucket_count_too_big_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_set_migration_bucket_count(hash_table, 1, (uint32_t)INT32_MAX + 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_122: [ clds_hash_table_set_migration_bucket_count shall set the number of buckets migrated by each write operation to write_migration_bucket_count and the number of buckets migrated by each clds_hash_table_find to read_migration_bucket_count. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_123: [ On success clds_hash_table_set_migration_bucket_count shall return 0. ]*/
+TEST_FUNCTION(clds_hash_table_set_migration_bucket_count_with_0_leaves_the_items_in_the_old_array_of_buckets)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // 0x1 goes in the only bucket of the 1st array, 0x3 goes in bucket 1 of the 2nd array (2 buckets)
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_2, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_1, (void*)result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_113: [ By default each write operation shall migrate 4 buckets out of the oldest array of buckets and read operations shall not migrate any buckets. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_114: [ clds_hash_table_insert shall migrate the items of the next buckets of the oldest array of buckets to the first array of buckets. ]*/
+TEST_FUNCTION(clds_hash_table_insert_migrates_the_items_of_the_old_array_of_buckets)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    // this insert adds the 2nd array and moves 0x1 to bucket 1 of it, next to 0x3
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_2, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_1, (void*)result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_115: [ clds_hash_table_delete shall migrate the items of the next buckets of the oldest array of buckets to the first array of buckets. ]*/
+TEST_FUNCTION(clds_hash_table_delete_migrates_the_items_of_the_old_array_of_buckets)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_3 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_2, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x5, item_3, NULL);
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 1, 0));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x5, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_1, (void*)result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_118: [ If the table is not locked for writes, clds_hash_table_find shall migrate the items of the next buckets of the oldest array of buckets to the first array of buckets, as set by clds_hash_table_set_migration_bucket_count. ]*/
+TEST_FUNCTION(clds_hash_table_find_migrates_the_items_of_the_old_array_of_buckets_when_read_migration_is_set)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 1));
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
+    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_2, NULL);
+    result = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x3);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_2, (void*)result);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_1, (void*)result);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* bucket ordering */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_126: [ If the hashes of the keys are different, the key_compare_func passed to clds_hash_table_create shall not be called. ]*/
+TEST_FUNCTION(clds_hash_table_find_does_not_compare_keys_with_a_different_hash)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    // 0x1 and 0x3 go in the same bucket
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    g_key_compare_call_count = 0;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x5));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x5);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 0, g_key_compare_call_count);
+
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_125: [ The items of a bucket shall be ordered by the hash of their key and then by their key. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_127: [ If the hashes of the keys are equal, the keys shall be compared by calling the key_compare_func passed to clds_hash_table_create. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_129: [ clds_hash_table_insert shall store the hash of the key in the item, next to the key. ]*/
+TEST_FUNCTION(clds_hash_table_find_compares_only_the_key_with_the_same_hash)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table;
+    CLDS_HASH_TABLE_ITEM* result;
+    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, NULL, NULL, NULL);
+    // 0x1 and 0x3 go in the same bucket, 0x1 is the first item of the bucket
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x3, item_2, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    g_key_compare_call_count = 0;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x3));
+    STRICT_EXPECTED_CALL(clds_sorted_list_head_find_key(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    result = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x3);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, (void*)item_2, (void*)result);
+    ASSERT_ARE_EQUAL(size_t, 1, g_key_compare_call_count);
+    ASSERT_ARE_EQUAL(uint64_t, 3, CLDS_SORTED_LIST_GET_VALUE(HASH_TABLE_ITEM, result)->hashed_key.hash);
+
+    // cleanup
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_hash_table_reserve */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_216: [ If clds_hash_table is NULL, clds_hash_table_reserve shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_reserve_with_NULL_hash_table_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_hash_table_reserve(NULL, hazard_pointers_thread, 100);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_217: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_reserve shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_reserve_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    int result;
+    umock_c_reset_all_calls();
 
-        if (original >= number_of_items)
-        {
-            ASSERT_FAIL("The returned item in index %" PRIu32 " was not found in the original", i);
-        }
-    }
+    // act
+    result = clds_hash_table_reserve(hash_table, NULL, 100);
 
-    for (uint32_t i = 0; i < number_of_items; i++)
-    {
-        ASSERT_IS_TRUE(found_originals[i], "should have found the item with index %" PRIu32, i);
-    }
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
-    for (uint64_t i = 0; i < item_count; i++)
-    {
-        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
-    }
-    free(items);
-
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_10_items_same_bucket_fails_when_underlying_functions_fail)
+/* Tests_SRS_CLDS_HASH_TABLE_01_218: [ If the first array of buckets has fewer buckets than needed to hold item_count items, clds_hash_table_reserve shall add a new first array of buckets, with the number of buckets of the first array doubled as many times as needed to hold item_count items. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_220: [ On success clds_hash_table_reserve shall return 0. ]*/
+TEST_FUNCTION(clds_hash_table_reserve_allocates_the_buckets_for_all_the_items_at_once)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    volatile_atomic int64_t start_seq_no;
-    (void)interlocked_exchange_64(&start_seq_no, 0);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 20, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    int result;
+    umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM* original_items[10];
+    // act
+    result = clds_hash_table_reserve(hash_table, hazard_pointers_thread, 100);
 
-    for (uint32_t i = 0; i < 10; i++)
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, count_actual_calls("[malloc_flex("));
+
+    // the 100 items are inserted without the table growing
+    umock_c_reset_all_calls();
+    for (uintptr_t key = 1; key <= 100; key++)
     {
-        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
-        (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)(uintptr_t)(0x1 + (20 * i)), original_items[i], NULL);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)key, CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL), NULL));
     }
-    umock_c_reset_all_calls();
+    ASSERT_ARE_EQUAL(size_t, 0, count_actual_calls("[malloc_flex("));
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
 
-    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
+/* Tests_SRS_CLDS_HASH_TABLE_01_218: [ If the first array of buckets has fewer buckets than needed to hold item_count items, clds_hash_table_reserve shall add a new first array of buckets, with the number of buckets of the first array doubled as many times as needed to hold item_count items. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_220: [ On success clds_hash_table_reserve shall return 0. ]*/
+TEST_FUNCTION(clds_hash_table_reserve_with_enough_buckets_does_not_allocate)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 128, hazard_pointers, NULL, NULL, NULL);
+    int result;
+    umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    // act
+    result = clds_hash_table_reserve(hash_table, hazard_pointers_thread, 100);
 
-    STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, count_actual_calls("[malloc_flex("));
 
-    umock_c_negative_tests_snapshot();
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
 
-    for (size_t i = 0; i < umock_c_negative_tests_call_count(); i++)
-    {
-        if (umock_c_negative_tests_can_call_fail(i))
-        {
-            umock_c_negative_tests_reset();
-            umock_c_negative_tests_fail_call(i);
+/* Tests_SRS_CLDS_HASH_TABLE_01_219: [ If any error occurs, clds_hash_table_reserve shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_allocating_the_buckets_fails_clds_hash_table_reserve_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    int result;
+    umock_c_reset_all_calls();
 
-            // act
-            CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count);
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 128, IGNORED_ARG))
+        .SetReturn(NULL);
 
-            // assert
-            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result, "On failed call %zu", i);
-        }
-    }
+    // act
+    result = clds_hash_table_reserve(hash_table, hazard_pointers_thread, 100);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_10_items_multiple_buckets_fails_when_underlying_functions_fail)
+/* clds_hash_table_shrink */
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_221: [ If clds_hash_table is NULL, clds_hash_table_shrink shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_shrink_with_NULL_hash_table_fails)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    volatile_atomic int64_t start_seq_no;
-    (void)interlocked_exchange_64(&start_seq_no, 0);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
+    int result;
+    umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM* original_items[10];
+    // act
+    result = clds_hash_table_shrink(NULL, hazard_pointers_thread);
 
-    const uint32_t number_of_sorted_lists = 10;
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
-    for (uint32_t i = 0; i < 10; i++)
-    {
-        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
-        (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)(uintptr_t)(0x1 + i), original_items[i], NULL);
-    }
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_HASH_TABLE_01_222: [ If clds_hazard_pointers_thread is NULL, clds_hash_table_shrink shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_hash_table_shrink_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    int result;
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
+    // act
+    result = clds_hash_table_shrink(hash_table, NULL);
 
-    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
-    {
-        STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
-        STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
-    }
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
 
-    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
+/* Tests_SRS_CLDS_HASH_TABLE_01_223: [ clds_hash_table_shrink shall count the items in all the arrays of buckets. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_225: [ If the number of buckets is smaller than the number of buckets of the first array of buckets, clds_hash_table_shrink shall add a new first array of buckets with that number of buckets. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_227: [ clds_hash_table_shrink shall migrate all the items of the older arrays of buckets to the first array of buckets, the emptied arrays of buckets being freed once no thread uses them anymore. ]*/
+/* Tests_SRS_CLDS_HASH_TABLE_01_229: [ On success clds_hash_table_shrink shall return 0. ]*/
+TEST_FUNCTION(clds_hash_table_shrink_after_deleting_items_moves_the_items_left_to_a_smaller_array_of_buckets)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* found_item;
+    int result;
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_reserve(hash_table, hazard_pointers_thread, 100));
+    for (uintptr_t key = 1; key <= 100; key++)
     {
-        STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
-        STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
-        STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)key, CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL), NULL));
     }
-
-    umock_c_negative_tests_snapshot();
-
-    for (size_t i = 0; i < umock_c_negative_tests_call_count(); i++)
+    for (uintptr_t key = 2; key <= 100; key++)
     {
-        if (umock_c_negative_tests_can_call_fail(i))
-        {
-            umock_c_negative_tests_reset();
-            umock_c_negative_tests_fail_call(i);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_hash_table_delete(hash_table, hazard_pointers_thread, (void*)key, NULL));
+    }
+    umock_c_reset_all_calls();
 
-            // act
-            CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count);
+    // act
+    result = clds_hash_table_shrink(hash_table, hazard_pointers_thread);
 
-            // assert
-            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result, "On failed call %zu", i);
-        }
-    }
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, count_actual_calls("[malloc_flex("));
+    // the array with 128 buckets is retired (the one with 1 bucket was migrated by the inserts)
+    ASSERT_ARE_EQUAL(size_t, 1, count_actual_calls("[clds_hazard_pointers_reclaim("));
+    found_item = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
+    ASSERT_IS_NOT_NULL(found_item);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+    ASSERT_IS_NULL(clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x2));
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_061: [ If there are any other failures then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_with_20_items_multiple_buckets_different_hashes_fails_when_underlying_functions_fail)
+/* Tests_SRS_CLDS_HASH_TABLE_01_224: [ clds_hash_table_shrink shall halve the number of buckets of the first array of buckets as long as the halved number of buckets is at least the number of buckets the table was created with and at least twice the number of items. ]*/
+TEST_FUNCTION(clds_hash_table_shrink_leaves_buckets_for_twice_the_items)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    volatile_atomic int64_t start_seq_no;
-    (void)interlocked_exchange_64(&start_seq_no, 0);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 2, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
-
-    CLDS_HASH_TABLE_ITEM* original_items[20];
-    uint32_t number_of_items = 20;
-
-    const uint32_t number_of_sorted_lists = 20;
-
-    for (uint32_t i = 0; i < number_of_items; i++)
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    int result;
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_reserve(hash_table, hazard_pointers_thread, 100));
+    for (uintptr_t key = 1; key <= 8; key++)
     {
-        original_items[i] = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)(uintptr_t)(0x4242 + i));
-
-        STRICT_EXPECTED_CALL(test_compute_hash((void*)(uintptr_t)(0x1 + i)))
-            .SetReturn(i);
-        (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)(uintptr_t)(0x1 + i), original_items[i], NULL);
-        umock_c_reset_all_calls();
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)key, CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL), NULL));
     }
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
-
-    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
-    {
-        STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
-        STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
-    }
+    // act
+    result = clds_hash_table_shrink(hash_table, hazard_pointers_thread);
 
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(CLDS_SORTED_LIST_ITEM*)));
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, count_actual_calls("[malloc_flex("));
 
-    for (uint32_t i = 0; i < number_of_sorted_lists; i++)
+    // the 8 items are in an array of 16 buckets, which grows when the 17th item is inserted
+    umock_c_reset_all_calls();
+    for (uintptr_t key = 9; key <= 16; key++)
     {
-        STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG));
-        STRICT_EXPECTED_CALL(clds_sorted_list_get_all(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG));
-        STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)key, CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL), NULL));
     }
+    ASSERT_ARE_EQUAL(size_t, 0, count_actual_calls("[malloc_flex("));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x11, CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL), NULL));
+    ASSERT_ARE_EQUAL(size_t, 1, count_actual_calls("[malloc_flex("));
 
-    umock_c_negative_tests_snapshot();
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
 
-    for (size_t i = 0; i < umock_c_negative_tests_call_count(); i++)
-    {
-        if (umock_c_negative_tests_can_call_fail(i))
-        {
-            umock_c_negative_tests_reset();
-            umock_c_negative_tests_fail_call(i);
+/* Tests_SRS_CLDS_HASH_TABLE_01_224: [ clds_hash_table_shrink shall halve the number of buckets of the first array of buckets as long as the halved number of buckets is at least the number of buckets the table was created with and at least twice the number of items. ]*/
+TEST_FUNCTION(clds_hash_table_shrink_does_not_go_below_the_initial_bucket_size)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 8, hazard_pointers, NULL, NULL, NULL);
+    int result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL), NULL));
+    umock_c_reset_all_calls();
 
-            // act
-            CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count);
+    // act
+    result = clds_hash_table_shrink(hash_table, hazard_pointers_thread);
 
-            // assert
-            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result, "On failed call %zu", i);
-        }
-    }
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, count_actual_calls("[malloc_flex("));
+    ASSERT_ARE_EQUAL(size_t, 0, count_actual_calls("[clds_hazard_pointers_reclaim("));
 
     // cleanup
     clds_hash_table_destroy(hash_table);
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
-/* Tests_SRS_CLDS_HASH_TABLE_42_022: [ If the addition of the list count causes overflow then clds_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
-TEST_FUNCTION(clds_hash_table_snapshot_fails_if_number_of_items_would_overflow)
+/* Tests_SRS_CLDS_HASH_TABLE_01_227: [ clds_hash_table_shrink shall migrate all the items of the older arrays of buckets to the first array of buckets, the emptied arrays of buckets being freed once no thread uses them anymore. ]*/
+TEST_FUNCTION(clds_hash_table_shrink_of_a_table_that_cannot_be_smaller_frees_the_older_arrays_of_buckets)
 {
     // arrange
     CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
     CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
-    CLDS_HASH_TABLE_HANDLE hash_table;
-    volatile_atomic int64_t start_seq_no;
-    (void)interlocked_exchange_64(&start_seq_no, 0);
-    hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &start_seq_no, test_skipped_seq_no_cb, NULL);
-
-    CLDS_HASH_TABLE_ITEM* item_1 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL);
-
-    CLDS_HASH_TABLE_ITEM* item_2 = CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4243);
-    (void)clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, NULL);
-
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    int result;
+    // 3 arrays of buckets, with 1, 2 and 4 buckets, the first one is as small as it can be for the 4 items
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_set_migration_bucket_count(hash_table, 0, 0));
+    for (uintptr_t key = 1; key <= 4; key++)
+    {
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)key, CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL), NULL));
+    }
     umock_c_reset_all_calls();
 
-    CLDS_HASH_TABLE_ITEM** items;
-    uint64_t item_count;
+    // act
+    result = clds_hash_table_shrink(hash_table, hazard_pointers_thread);
 
-    uint64_t mocked_item_count_1 = UINT64_MAX / 2 + 1;
-    uint64_t mocked_item_count_2 = UINT64_MAX / 2 + 1;
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, count_actual_calls("[malloc_flex("));
+    ASSERT_ARE_EQUAL(size_t, 2, count_actual_calls("[clds_hazard_pointers_reclaim("));
+    for (uintptr_t key = 1; key <= 4; key++)
+    {
+        CLDS_HASH_TABLE_ITEM* found_item = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)key);
+        ASSERT_IS_NOT_NULL(found_item);
+        CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+    }
 
-    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG))
-        .CopyOutArgumentBuffer_item_count(&mocked_item_count_1, sizeof(mocked_item_count_1));
+    // cleanup
+    clds_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
 
-    STRICT_EXPECTED_CALL(clds_sorted_list_lock_writes(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_get_count(IGNORED_ARG, hazard_pointers_thread, IGNORED_ARG))
-        .CopyOutArgumentBuffer_item_count(&mocked_item_count_2, sizeof(mocked_item_count_2));
+/* Tests_SRS_CLDS_HASH_TABLE_01_228: [ If any error occurs, clds_hash_table_shrink shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_allocating_the_buckets_fails_clds_hash_table_shrink_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_HASH_TABLE_HANDLE hash_table = clds_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_ITEM* found_item;
+    int result;
+    ASSERT_ARE_EQUAL(int, 0, clds_hash_table_reserve(hash_table, hazard_pointers_thread, 100));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, CLDS_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL), NULL));
+    umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_sorted_list_unlock_writes(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 2, IGNORED_ARG))
+        .SetReturn(NULL);
 
     // act
-    CLDS_HASH_TABLE_SNAPSHOT_RESULT result = clds_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count);
+    result = clds_hash_table_shrink(hash_table, hazard_pointers_thread);
 
     // assert
-    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    found_item = clds_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
+    ASSERT_IS_NOT_NULL(found_item);
+    CLDS_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
 
     // cleanup
     clds_hash_table_destroy(hash_table);
@@ -0,0 +1,324 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "c_logging/logger.h"
+
+#include "c_pal/threadapi.h"
+#include "c_pal/timer.h"
+#include "c_pal/gballoc_hl.h"
+#include "c_pal/gballoc_hl_redirect.h"
+
+#include "clds/clds_hazard_pointers.h"
+
+#include "clds_hazard_pointers_perf.h"
+
+#define THREAD_COUNT 10
+#define RETIRE_COUNT 100000
+
+// a list traversal typically holds 2 or 3 hazard pointers at once, so the test holds as many while retiring
+#define HAZARD_POINTERS_PER_THREAD 3
+
+typedef struct TEST_NODE_TAG
+{
+    uint64_t value;
+} TEST_NODE;
+
+typedef struct THREAD_DATA_TAG
+{
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread;
+    TEST_NODE* protected_nodes[HAZARD_POINTERS_PER_THREAD];
+    double runtime;
+} THREAD_DATA;
+
+static void reclaim_test_node(void* node)
+{
+    free(node);
+}
+
+static int retire_thread(void* arg)
+{
+    size_t i;
+    size_t j;
+    size_t acquired_count;
+    THREAD_DATA* thread_data = arg;
+    int result;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointers[HAZARD_POINTERS_PER_THREAD];
+
+    double start_time = timer_global_get_elapsed_ms();
+    for (i = 0; i < RETIRE_COUNT; i++)
+    {
+        TEST_NODE* test_node = malloc(sizeof(TEST_NODE));
+        if (test_node == NULL)
+        {
+            LogError("Error allocating test node");
+            break;
+        }
+        else
+        {
+            test_node->value = i;
+
+            for (j = 0; j < HAZARD_POINTERS_PER_THREAD; j++)
+            {
+                hazard_pointers[j] = clds_hazard_pointers_acquire(thread_data->clds_hazard_pointers_thread, thread_data->protected_nodes[j]);
+                if (hazard_pointers[j] == NULL)
+                {
+                    LogError("Error acquiring hazard pointer");
+                    break;
+                }
+            }
+
+            if (j < HAZARD_POINTERS_PER_THREAD)
+            {
+                free(test_node);
+            }
+            else
+            {
+                clds_hazard_pointers_reclaim(thread_data->clds_hazard_pointers_thread, test_node, reclaim_test_node);
+            }
+
+            acquired_count = j;
+            while (j > 0)
+            {
+                j--;
+                clds_hazard_pointers_release(thread_data->clds_hazard_pointers_thread, hazard_pointers[j]);
+            }
+
+            if (acquired_count < HAZARD_POINTERS_PER_THREAD)
+            {
+                break;
+            }
+        }
+    }
+
+    if (i < RETIRE_COUNT)
+    {
+        LogError("Error running test");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        thread_data->runtime = timer_global_get_elapsed_ms() - start_time;
+        result = 0;
+    }
+
+    return result;
+}
+
+static int run_retire_test(const char* test_name, CLDS_HAZARD_POINTERS_RECLAMATION_MODE reclamation_mode, size_t reclaim_threshold, uint32_t slot_count, uint32_t max_pending_reclaim_batches)
+{
+    int result;
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers;
+    THREAD_HANDLE threads[THREAD_COUNT];
+    THREAD_DATA* thread_data;
+    TEST_NODE protected_nodes[HAZARD_POINTERS_PER_THREAD];
+    size_t registered_count;
+    size_t i;
+    size_t j;
+
+    clds_hazard_pointers = clds_hazard_pointers_create_with_mode(reclamation_mode);
+    if (clds_hazard_pointers == NULL)
+    {
+        LogError("Error creating hazard pointers");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        if (clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, reclaim_threshold) != 0)
+        {
+            LogError("Error setting reclaim threshold to %zu", reclaim_threshold);
+            result = MU_FAILURE;
+        }
+        else if (clds_hazard_pointers_set_slot_count(clds_hazard_pointers, slot_count) != 0)
+        {
+            LogError("Error setting slot count to %" PRIu32 "", slot_count);
+            result = MU_FAILURE;
+        }
+        else if (
+            (max_pending_reclaim_batches > 0) &&
+            (clds_hazard_pointers_start_background_reclaimer(clds_hazard_pointers, max_pending_reclaim_batches) != 0)
+            )
+        {
+            LogError("Error starting background reclaimer");
+            result = MU_FAILURE;
+        }
+        else
+        {
+            thread_data = malloc_2(THREAD_COUNT, sizeof(THREAD_DATA));
+            if (thread_data == NULL)
+            {
+                LogError("Error allocating thread data array");
+                result = MU_FAILURE;
+            }
+            else
+            {
+                for (i = 0; i < THREAD_COUNT; i++)
+                {
+                    thread_data[i].clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+                    if (thread_data[i].clds_hazard_pointers_thread == NULL)
+                    {
+                        LogError("Error registering thread with harzard pointers");
+                        break;
+                    }
+                    else
+                    {
+                        for (j = 0; j < HAZARD_POINTERS_PER_THREAD; j++)
+                        {
+                            thread_data[i].protected_nodes[j] = &protected_nodes[j];
+                        }
+                    }
+                }
+
+                registered_count = i;
+
+                if (registered_count < THREAD_COUNT)
+                {
+                    LogError("Error creating test thread data");
+                    result = MU_FAILURE;
+                }
+                else
+                {
+                    LogInfo("Start %s retire test", test_name);
+
+                    for (i = 0; i < THREAD_COUNT; i++)
+                    {
+                        if (ThreadAPI_Create(&threads[i], retire_thread, &thread_data[i]) != THREADAPI_OK)
+                        {
+                            LogError("Error spawning test thread");
+                            break;
+                        }
+                    }
+
+                    if (i < THREAD_COUNT)
+                    {
+                        for (j = 0; j < i; j++)
+                        {
+                            int dont_care;
+                            (void)ThreadAPI_Join(threads[j], &dont_care);
+                        }
+
+                        result = MU_FAILURE;
+                    }
+                    else
+                    {
+                        bool is_error = false;
+                        double runtime = 0.0;
+
+                        for (i = 0; i < THREAD_COUNT; i++)
+                        {
+                            int thread_result;
+                            (void)ThreadAPI_Join(threads[i], &thread_result);
+                            if (thread_result != 0)
+                            {
+                                is_error = true;
+                            }
+                            else
+                            {
+                                runtime += thread_data[i].runtime;
+                            }
+                        }
+
+                        if (is_error)
+                        {
+                            result = MU_FAILURE;
+                        }
+                        else
+                        {
+                            CLDS_HAZARD_POINTERS_STATISTICS statistics;
+
+                            LogInfo("%s retire test done in %.02f ms, %.02f retires/s/thread, %.02f retires/s on all threads",
+                                test_name,
+                                runtime,
+                                ((double)THREAD_COUNT * (double)RETIRE_COUNT) / (double)runtime * 1000.0,
+                                ((double)THREAD_COUNT * (double)RETIRE_COUNT) / ((double)runtime / THREAD_COUNT) * 1000.0);
+
+                            if (clds_hazard_pointers_get_statistics(clds_hazard_pointers, &statistics) != 0)
+                            {
+                                LogError("Error getting hazard pointers statistics");
+                                result = MU_FAILURE;
+                            }
+                            else
+                            {
+                                LogInfo("%s retire test: %" PRIu64 " retired, %" PRIu64 " freed, %" PRIu64 " backlog, %" PRIu64 " scans, %.02f us max scan time, %.02f us average scan time",
+                                    test_name,
+                                    statistics.retired_count,
+                                    statistics.freed_count,
+                                    statistics.backlog_count,
+                                    statistics.scan_count,
+                                    statistics.max_scan_time_us,
+                                    (statistics.scan_count == 0) ? 0.0 : (statistics.total_scan_time_us / (double)statistics.scan_count));
+                                result = 0;
+                            }
+                        }
+                    }
+                }
+
+                for (i = 0; i < registered_count; i++)
+                {
+                    clds_hazard_pointers_unregister_thread(thread_data[i].clds_hazard_pointers_thread);
+                }
+
+                free(thread_data);
+            }
+        }
+
+        clds_hazard_pointers_destroy(clds_hazard_pointers);
+    }
+
+    return result;
+}
+
+int clds_hazard_pointers_perf_main(void)
+{
+    // threshold 1 is the default and scans on every retire, which is the reclaim storm case
+    if (run_retire_test("threshold 1", CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS, 1, 0, 0) != 0)
+    {
+        LogError("threshold 1 retire test failed");
+    }
+    else if (run_retire_test("threshold 64", CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS, 64, 0, 0) != 0)
+    {
+        LogError("threshold 64 retire test failed");
+    }
+    else if (run_retire_test("threshold 1, 4 slots", CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS, 1, 4, 0) != 0)
+    {
+        LogError("threshold 1, 4 slots retire test failed");
+    }
+    else if (run_retire_test("threshold 64, 4 slots", CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS, 64, 4, 0) != 0)
+    {
+        LogError("threshold 64, 4 slots retire test failed");
+    }
+    else if (run_retire_test("epoch based, threshold 1", CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH_BASED, 1, 0, 0) != 0)
+    {
+        LogError("epoch based, threshold 1 retire test failed");
+    }
+    else if (run_retire_test("epoch based, threshold 64", CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH_BASED, 64, 0, 0) != 0)
+    {
+        LogError("epoch based, threshold 64 retire test failed");
+    }
+    else if (run_retire_test("interval based, threshold 1", CLDS_HAZARD_POINTERS_RECLAMATION_MODE_INTERVAL_BASED, 1, 0, 0) != 0)
+    {
+        LogError("interval based, threshold 1 retire test failed");
+    }
+    else if (run_retire_test("interval based, threshold 64", CLDS_HAZARD_POINTERS_RECLAMATION_MODE_INTERVAL_BASED, 64, 0, 0) != 0)
+    {
+        LogError("interval based, threshold 64 retire test failed");
+    }
+    else if (run_retire_test("background reclaimer, threshold 64", CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS, 64, 0, 16) != 0)
+    {
+        LogError("background reclaimer, threshold 64 retire test failed");
+    }
+    else if (run_retire_test("background reclaimer, threshold 64, 4 slots", CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS, 64, 4, 16) != 0)
+    {
+        LogError("background reclaimer, threshold 64, 4 slots retire test failed");
+    }
+    else
+    {
+        // all done
+    }
+
+    return 0;
+}
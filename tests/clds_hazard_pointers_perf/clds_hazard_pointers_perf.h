@@ -0,0 +1,10 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef CLDS_HAZARD_POINTERS_PERF_H
+#define CLDS_HAZARD_POINTERS_PERF_H
+
+
+int clds_hazard_pointers_perf_main(void);
+
+
+#endif /* CLDS_HAZARD_POINTERS_PERF_H */
@@ -0,0 +1,18 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+
+#include "c_logging/logger.h"
+
+#include "clds_hazard_pointers_perf.h"
+
+int main(void)
+{
+    (void)logger_init();
+
+    clds_hazard_pointers_perf_main();
+
+    logger_init();
+
+    return 0;
+}
@@ -39,6 +39,12 @@ static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
 MOCK_FUNCTION_WITH_CODE(, void, test_reclaim_func, void*, node)
 MOCK_FUNCTION_END()
 
+typedef struct TEST_NODE_TAG
+{
+    int value;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_FIELD
+} TEST_NODE;
+
 BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
 
 TEST_SUITE_INITIALIZE(suite_init)
@@ -83,6 +89,68 @@ TEST_FUNCTION(clds_hazard_pointers_create_succeeds)
     clds_hazard_pointers_destroy(clds_hazard_pointers);
 }
 
+/* clds_hazard_pointers_create_with_mode */
+
+TEST_FUNCTION(clds_hazard_pointers_create_with_mode_with_hazard_pointers_mode_succeeds)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create_with_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_HAZARD_POINTERS);
+
+    // assert
+    ASSERT_IS_NOT_NULL(clds_hazard_pointers);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_create_with_mode_with_epoch_based_mode_succeeds)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create_with_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH_BASED);
+
+    // assert
+    ASSERT_IS_NOT_NULL(clds_hazard_pointers);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_create_with_mode_with_interval_based_mode_succeeds)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create_with_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_INTERVAL_BASED);
+
+    // assert
+    ASSERT_IS_NOT_NULL(clds_hazard_pointers);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_create_with_mode_with_an_invalid_mode_fails)
+{
+    // arrange
+
+    // act
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create_with_mode((CLDS_HAZARD_POINTERS_RECLAMATION_MODE)0x42);
+
+    // assert
+    ASSERT_IS_NULL(clds_hazard_pointers);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
 /* clds_hazard_pointers_destroy */
 
 TEST_FUNCTION(clds_hazard_pointers_destroy_frees_the_resources)
@@ -130,6 +198,77 @@ TEST_FUNCTION(clds_hazard_pointers_unregister_thread_frees_the_thread_specific_d
     clds_hazard_pointers_destroy(clds_hazard_pointers);
 }
 
+TEST_FUNCTION(clds_hazard_pointers_register_thread_after_unregister_reuses_the_thread_record)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_1 = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_2;
+    clds_hazard_pointers_unregister_thread(clds_hazard_pointers_thread_1);
+    umock_c_reset_all_calls();
+
+    // act
+    clds_hazard_pointers_thread_2 = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, clds_hazard_pointers_thread_1, clds_hazard_pointers_thread_2);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_register_thread_does_not_reuse_the_record_of_a_registered_thread)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_1 = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_2;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    clds_hazard_pointers_thread_2 = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(void_ptr, clds_hazard_pointers_thread_1, clds_hazard_pointers_thread_2);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_unregister_thread_hands_the_pending_nodes_to_the_next_thread_that_reclaims)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_1 = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_2 = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer;
+    TEST_NODE test_node_1;
+    TEST_NODE test_node_2;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node_1);
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node_2);
+    hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread_2, &test_node_1);
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread_1, &test_node_1, test_reclaim_func);
+    clds_hazard_pointers_unregister_thread(clds_hazard_pointers_thread_1);
+    clds_hazard_pointers_release(clds_hazard_pointers_thread_2, hazard_pointer);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_node_1));
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_node_2));
+
+    // act
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread_2, &test_node_2, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
 /* clds_hazard_pointers_acquire */
 
 TEST_FUNCTION(clds_hazard_pointer_acquire_succeeds)
@@ -183,12 +322,7 @@ TEST_FUNCTION(clds_hazard_pointers_reclaim_with_a_hazard_pointer_set_does_not_re
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(void*)));
 
     // act
     clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_1, test_reclaim_func);
@@ -211,20 +345,1090 @@ TEST_FUNCTION(clds_hazard_pointers_reclaim_with_a_pointer_that_is_not_acquired_r
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, IGNORED_ARG));
     STRICT_EXPECTED_CALL(test_reclaim_func(pointer_1));
     STRICT_EXPECTED_CALL(free(IGNORED_ARG));
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_1, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_reclaim_does_not_allocate_the_scan_buffer_again_once_it_is_large_enough)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer;
+    void* pointer_1 = (void*)0x4242;
+    void* pointer_2 = (void*)0x4243;
+    hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1);
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_1, test_reclaim_func);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_reclaim_func(pointer_2));
     STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
     // act
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_2, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_reclaim_only_reclaims_the_pointers_that_are_not_acquired)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 3);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer_1;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer_3;
+    void* pointer_1 = (void*)0x4242;
+    void* pointer_2 = (void*)0x4243;
+    void* pointer_3 = (void*)0x4244;
+    hazard_pointer_3 = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_3);
+    hazard_pointer_1 = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1);
     clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_1, test_reclaim_func);
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_2, test_reclaim_func);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(void*)));
+    STRICT_EXPECTED_CALL(test_reclaim_func(pointer_2));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_3, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer_1);
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer_3);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/* clds_hazard_pointers_retire */
+
+TEST_FUNCTION(clds_hazard_pointers_retire_with_NULL_clds_hazard_pointers_thread_returns)
+{
+    // arrange
+    TEST_NODE test_node;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node);
+
+    // act
+    clds_hazard_pointers_retire(NULL, &test_node, &test_node.retire_link, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+TEST_FUNCTION(clds_hazard_pointers_retire_with_NULL_node_returns)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    TEST_NODE test_node;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node);
+    umock_c_reset_all_calls();
+
+    // act
+    clds_hazard_pointers_retire(clds_hazard_pointers_thread, NULL, &test_node.retire_link, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_retire_with_NULL_retire_link_returns)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    TEST_NODE test_node;
+    umock_c_reset_all_calls();
+
+    // act
+    clds_hazard_pointers_retire(clds_hazard_pointers_thread, &test_node, NULL, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_retire_with_a_node_that_is_not_acquired_reclaims_it_without_allocating)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    TEST_NODE test_node;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_node));
+
+    // act
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, &test_node, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_retire_with_a_hazard_pointer_set_does_not_reclaim_the_node)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer;
+    TEST_NODE test_node;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node);
+    hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, &test_node);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(void*)));
+
+    // act
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, &test_node, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_retire_of_a_node_whose_previous_retire_is_pending_uses_an_allocated_link)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer;
+    TEST_NODE test_node;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node);
+    hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, &test_node);
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, &test_node, test_reclaim_func);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, &test_node, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_retire_after_the_node_was_reclaimed_reuses_the_link)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 1);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    TEST_NODE test_node;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node);
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, &test_node, test_reclaim_func);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_node));
+
+    // act
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, &test_node, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/* clds_hazard_pointers_set_adaptive_reclaim_threshold */
+
+TEST_FUNCTION(clds_hazard_pointers_set_adaptive_reclaim_threshold_with_NULL_clds_hazard_pointers_fails)
+{
+    // arrange
+    int result;
+
+    // act
+    result = clds_hazard_pointers_set_adaptive_reclaim_threshold(NULL, 100);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_set_adaptive_reclaim_threshold_with_a_headroom_above_10000_percent_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    int result;
+
+    // act
+    result = clds_hazard_pointers_set_adaptive_reclaim_threshold(clds_hazard_pointers, 10001);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_set_adaptive_reclaim_threshold_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    int result;
+
+    // act
+    result = clds_hazard_pointers_set_adaptive_reclaim_threshold(clds_hazard_pointers, 100);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_with_adaptive_reclaim_threshold_reclaims_when_the_retired_nodes_reach_the_hazard_pointer_count_with_headroom)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_slot_count(clds_hazard_pointers, 2);
+    (void)clds_hazard_pointers_set_adaptive_reclaim_threshold(clds_hazard_pointers, 100);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    TEST_NODE test_nodes[4];
+    size_t i;
+    for (i = 0; i < 4; i++)
+    {
+        CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_nodes[i]);
+    }
+
+    // 2 hazard pointers, 100% headroom, so the threshold is 4
+    for (i = 0; i < 3; i++)
+    {
+        CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, &test_nodes[i], test_reclaim_func);
+    }
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_nodes[3]));
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_nodes[2]));
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_nodes[1]));
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_nodes[0]));
+
+    // act
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, &test_nodes[3], test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_with_adaptive_reclaim_threshold_follows_the_registered_threads)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_slot_count(clds_hazard_pointers, 2);
+    (void)clds_hazard_pointers_set_adaptive_reclaim_threshold(clds_hazard_pointers, 100);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_1 = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_2 = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    TEST_NODE test_nodes[5];
+    size_t i;
+    for (i = 0; i < 5; i++)
+    {
+        CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_nodes[i]);
+    }
+    umock_c_reset_all_calls();
+
+    // 4 hazard pointers, 100% headroom, so the threshold is 8 and nothing gets reclaimed
+    for (i = 0; i < 4; i++)
+    {
+        CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread_1, &test_nodes[i], test_reclaim_func);
+    }
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // one thread less, the threshold goes back to 4
+    clds_hazard_pointers_unregister_thread(clds_hazard_pointers_thread_2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_nodes[4]));
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_nodes[3]));
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_nodes[2]));
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_nodes[1]));
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_nodes[0]));
+
+    // act
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread_1, &test_nodes[4], test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/* clds_hazard_pointers_set_slot_count */
+
+TEST_FUNCTION(clds_hazard_pointers_set_slot_count_with_NULL_clds_hazard_pointers_fails)
+{
+    // arrange
+
+    // act
+    int result = clds_hazard_pointers_set_slot_count(NULL, 4);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_set_slot_count_with_more_than_32_slots_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+
+    // act
+    int result = clds_hazard_pointers_set_slot_count(clds_hazard_pointers, 33);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_set_slot_count_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+
+    // act
+    int result = clds_hazard_pointers_set_slot_count(clds_hazard_pointers, 4);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_register_thread_with_slots_allocates_the_slots)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_slot_count(clds_hazard_pointers, 4);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+
+    // assert
+    ASSERT_IS_NOT_NULL(clds_hazard_pointers_thread);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_acquire_with_a_free_slot_does_not_allocate)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_slot_count(clds_hazard_pointers, 2);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer_1;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer_2;
+    void* pointer_1 = (void*)0x4242;
+    void* pointer_2 = (void*)0x4243;
+    umock_c_reset_all_calls();
+
+    // act
+    hazard_pointer_1 = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1);
+    hazard_pointer_2 = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_2);
+
+    // assert
+    ASSERT_IS_NOT_NULL(hazard_pointer_1);
+    ASSERT_IS_NOT_NULL(hazard_pointer_2);
+    ASSERT_ARE_NOT_EQUAL(void_ptr, hazard_pointer_1, hazard_pointer_2);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer_1);
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer_2);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_acquire_after_release_reuses_the_slot)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_slot_count(clds_hazard_pointers, 2);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer_1;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer_2;
+    void* pointer_1 = (void*)0x4242;
+    void* pointer_2 = (void*)0x4243;
+    hazard_pointer_1 = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1);
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer_1);
+    umock_c_reset_all_calls();
+
+    // act
+    hazard_pointer_2 = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_2);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, hazard_pointer_1, hazard_pointer_2);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer_2);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_acquire_with_all_slots_in_use_allocates_a_hazard_pointer)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_slot_count(clds_hazard_pointers, 1);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer_1;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer_2;
+    void* pointer_1 = (void*)0x4242;
+    void* pointer_2 = (void*)0x4243;
+    hazard_pointer_1 = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    hazard_pointer_2 = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_2);
+
+    // assert
+    ASSERT_IS_NOT_NULL(hazard_pointer_2);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer_1);
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer_2);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_reclaim_with_a_pointer_held_in_a_slot_does_not_reclaim_it)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_reclaim_threshold(clds_hazard_pointers, 2);
+    (void)clds_hazard_pointers_set_slot_count(clds_hazard_pointers, 2);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer;
+    void* pointer_1 = (void*)0x4242;
+    void* pointer_2 = (void*)0x4243;
+    hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1);
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_1, test_reclaim_func);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, sizeof(void*)));
+    STRICT_EXPECTED_CALL(test_reclaim_func(pointer_2));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    clds_hazard_pointers_reclaim(clds_hazard_pointers_thread, pointer_2, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/* clds_hazard_pointers_start_background_reclaimer */
+
+TEST_FUNCTION(clds_hazard_pointers_start_background_reclaimer_with_NULL_clds_hazard_pointers_fails)
+{
+    // arrange
+    int result;
+
+    // act
+    result = clds_hazard_pointers_start_background_reclaimer(NULL, 4);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_start_background_reclaimer_with_0_max_pending_batches_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    int result;
+
+    // act
+    result = clds_hazard_pointers_start_background_reclaimer(clds_hazard_pointers, 0);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_start_background_reclaimer_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    int result;
+
+    // act
+    result = clds_hazard_pointers_start_background_reclaimer(clds_hazard_pointers, 4);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_start_background_reclaimer_when_already_started_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    int result;
+    (void)clds_hazard_pointers_start_background_reclaimer(clds_hazard_pointers, 4);
+
+    // act
+    result = clds_hazard_pointers_start_background_reclaimer(clds_hazard_pointers, 4);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_with_background_reclaimer_reclaims_the_retired_node_at_the_latest_on_destroy)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_start_background_reclaimer(clds_hazard_pointers, 4);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    TEST_NODE test_node;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_node));
+
+    // act
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, &test_node, test_reclaim_func);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+
+    // assert
+    // the node is reclaimed either by the reclaimer thread or by destroy, but exactly once
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+}
+
+/* clds_hazard_pointers_get_statistics */
+
+TEST_FUNCTION(clds_hazard_pointers_get_statistics_with_NULL_clds_hazard_pointers_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_STATISTICS statistics;
+    int result;
+
+    // act
+    result = clds_hazard_pointers_get_statistics(NULL, &statistics);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_get_statistics_with_NULL_statistics_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    int result;
+
+    // act
+    result = clds_hazard_pointers_get_statistics(clds_hazard_pointers, NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_get_statistics_on_a_new_instance_returns_all_0)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_STATISTICS statistics;
+    int result;
+
+    // act
+    result = clds_hazard_pointers_get_statistics(clds_hazard_pointers, &statistics);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint64_t, 0, statistics.retired_count);
+    ASSERT_ARE_EQUAL(uint64_t, 0, statistics.freed_count);
+    ASSERT_ARE_EQUAL(uint64_t, 0, statistics.backlog_count);
+    ASSERT_ARE_EQUAL(uint64_t, 0, statistics.scan_count);
+    ASSERT_ARE_EQUAL(uint64_t, 0, statistics.visited_thread_count);
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_get_statistics_counts_retired_and_freed_nodes_and_scans)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_STATISTICS statistics;
+    TEST_NODE test_node_1;
+    TEST_NODE test_node_2;
+    int result;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node_1);
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node_2);
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, &test_node_1, test_reclaim_func);
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, &test_node_2, test_reclaim_func);
+
+    // act
+    result = clds_hazard_pointers_get_statistics(clds_hazard_pointers, &statistics);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint64_t, 2, statistics.retired_count);
+    ASSERT_ARE_EQUAL(uint64_t, 2, statistics.freed_count);
+    ASSERT_ARE_EQUAL(uint64_t, 0, statistics.backlog_count);
+    ASSERT_ARE_EQUAL(uint64_t, 2, statistics.scan_count);
+    ASSERT_ARE_EQUAL(uint64_t, 2, statistics.visited_thread_count);
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_get_statistics_reports_a_node_still_in_use_as_backlog)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_STATISTICS statistics;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer;
+    TEST_NODE test_node;
+    int result;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node);
+    hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, &test_node);
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, &test_node, test_reclaim_func);
+
+    // act
+    result = clds_hazard_pointers_get_statistics(clds_hazard_pointers, &statistics);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint64_t, 1, statistics.retired_count);
+    ASSERT_ARE_EQUAL(uint64_t, 0, statistics.freed_count);
+    ASSERT_ARE_EQUAL(uint64_t, 1, statistics.backlog_count);
+    ASSERT_ARE_EQUAL(uint64_t, 1, statistics.scan_count);
+
+    // cleanup
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_get_statistics_keeps_the_counters_of_unregistered_threads)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_STATISTICS statistics;
+    TEST_NODE test_node;
+    int result;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node);
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, &test_node, test_reclaim_func);
+    clds_hazard_pointers_unregister_thread(clds_hazard_pointers_thread);
+    // this one gets the same record
+    clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+
+    // act
+    result = clds_hazard_pointers_get_statistics(clds_hazard_pointers, &statistics);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint64_t, 1, statistics.retired_count);
+    ASSERT_ARE_EQUAL(uint64_t, 1, statistics.freed_count);
+    ASSERT_ARE_EQUAL(uint64_t, 1, statistics.scan_count);
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/* clds_hazard_pointers_get_thread_statistics */
+
+TEST_FUNCTION(clds_hazard_pointers_get_thread_statistics_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_STATISTICS statistics;
+    int result;
+
+    // act
+    result = clds_hazard_pointers_get_thread_statistics(NULL, &statistics);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_get_thread_statistics_with_NULL_statistics_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    int result;
+
+    // act
+    result = clds_hazard_pointers_get_thread_statistics(clds_hazard_pointers_thread, NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_get_thread_statistics_returns_the_counters_of_the_thread)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_1 = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_2 = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_STATISTICS statistics;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer;
+    TEST_NODE test_node_1;
+    TEST_NODE test_node_2;
+    int result;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node_1);
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node_2);
+    hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread_2, &test_node_1);
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread_1, &test_node_1, test_reclaim_func);
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread_2, &test_node_2, test_reclaim_func);
+
+    // act
+    result = clds_hazard_pointers_get_thread_statistics(clds_hazard_pointers_thread_1, &statistics);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint64_t, 1, statistics.retired_count);
+    ASSERT_ARE_EQUAL(uint64_t, 0, statistics.freed_count);
+    ASSERT_ARE_EQUAL(uint64_t, 1, statistics.backlog_count);
+    ASSERT_ARE_EQUAL(uint64_t, 1, statistics.scan_count);
+    ASSERT_ARE_EQUAL(uint64_t, 2, statistics.visited_thread_count);
+
+    // cleanup
+    clds_hazard_pointers_release(clds_hazard_pointers_thread_2, hazard_pointer);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/* clds_hazard_pointers_enable_asymmetric_fence */
+
+TEST_FUNCTION(clds_hazard_pointers_enable_asymmetric_fence_with_NULL_clds_hazard_pointers_fails)
+{
+    // arrange
+    int result;
+
+    // act
+    result = clds_hazard_pointers_enable_asymmetric_fence(NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_retire_with_asymmetric_fence_does_not_reclaim_a_node_in_a_slot)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_slot_count(clds_hazard_pointers, 2);
+    // whether the platform has the heavy fence or not, the node shall stay protected
+    (void)clds_hazard_pointers_enable_asymmetric_fence(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer;
+    TEST_NODE test_node;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node);
+    hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, &test_node);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, &test_node, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_retire_with_asymmetric_fence_reclaims_a_node_released_from_a_slot)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create();
+    (void)clds_hazard_pointers_set_slot_count(clds_hazard_pointers, 2);
+    (void)clds_hazard_pointers_enable_asymmetric_fence(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer;
+    TEST_NODE test_node;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node);
+    hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, &test_node);
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_node));
+
+    // act
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, &test_node, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/* epoch based mode */
+
+TEST_FUNCTION(clds_hazard_pointers_acquire_in_epoch_based_mode_does_not_allocate)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create_with_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH_BASED);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer_1;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer_2;
+    void* pointer_1 = (void*)0x4242;
+    void* pointer_2 = (void*)0x4243;
+    umock_c_reset_all_calls();
+
+    // act
+    hazard_pointer_1 = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1);
+    hazard_pointer_2 = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_2);
+
+    // assert
+    ASSERT_IS_NOT_NULL(hazard_pointer_1);
+    ASSERT_IS_NOT_NULL(hazard_pointer_2);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer_2);
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer_1);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_retire_in_epoch_based_mode_with_no_thread_pinned_reclaims_the_node)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create_with_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH_BASED);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    TEST_NODE test_node;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_node));
+
+    // act
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, &test_node, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_retire_in_epoch_based_mode_with_a_thread_pinned_does_not_reclaim_the_node)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create_with_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH_BASED);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_1 = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_2 = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer;
+    TEST_NODE test_node;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node);
+    hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread_2, &test_node);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread_1, &test_node, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_release(clds_hazard_pointers_thread_2, hazard_pointer);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_retire_in_epoch_based_mode_reclaims_the_node_after_the_pinned_thread_releases_all_records)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create_with_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_EPOCH_BASED);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_1 = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_2 = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer_1;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer_2;
+    TEST_NODE test_node_1;
+    TEST_NODE test_node_2;
+    TEST_NODE test_node_3;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node_1);
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node_2);
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node_3);
+    hazard_pointer_1 = clds_hazard_pointers_acquire(clds_hazard_pointers_thread_2, &test_node_1);
+    hazard_pointer_2 = clds_hazard_pointers_acquire(clds_hazard_pointers_thread_2, &test_node_2);
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread_1, &test_node_1, test_reclaim_func);
+    clds_hazard_pointers_release(clds_hazard_pointers_thread_2, hazard_pointer_1);
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread_1, &test_node_2, test_reclaim_func);
+    clds_hazard_pointers_release(clds_hazard_pointers_thread_2, hazard_pointer_2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_node_3));
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_node_2));
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_node_1));
+
+    // act
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread_1, &test_node_3, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+/* interval based mode */
+
+TEST_FUNCTION(clds_hazard_pointers_acquire_in_interval_based_mode_does_not_allocate)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create_with_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_INTERVAL_BASED);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer_1;
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer_2;
+    void* pointer_1 = (void*)0x4242;
+    void* pointer_2 = (void*)0x4243;
+    umock_c_reset_all_calls();
+
+    // act
+    hazard_pointer_1 = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_1);
+    hazard_pointer_2 = clds_hazard_pointers_acquire(clds_hazard_pointers_thread, pointer_2);
+
+    // assert
+    ASSERT_IS_NOT_NULL(hazard_pointer_1);
+    ASSERT_IS_NOT_NULL(hazard_pointer_2);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer_2);
+    clds_hazard_pointers_release(clds_hazard_pointers_thread, hazard_pointer_1);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_retire_in_interval_based_mode_with_no_thread_in_an_operation_reclaims_the_node)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create_with_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_INTERVAL_BASED);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    TEST_NODE test_node;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_node));
+
+    // act
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread, &test_node, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_retire_in_interval_based_mode_of_a_node_alive_during_a_reserved_interval_does_not_reclaim_the_node)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create_with_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_INTERVAL_BASED);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_1 = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_2 = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer;
+    TEST_NODE test_node;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node);
+    hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread_2, &test_node);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc_2(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread_1, &test_node, test_reclaim_func);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_release(clds_hazard_pointers_thread_2, hazard_pointer);
+    clds_hazard_pointers_destroy(clds_hazard_pointers);
+}
+
+TEST_FUNCTION(clds_hazard_pointers_retire_in_interval_based_mode_of_a_node_created_after_a_reserved_interval_reclaims_the_node)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers = clds_hazard_pointers_create_with_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE_INTERVAL_BASED);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_1 = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread_2 = clds_hazard_pointers_register_thread(clds_hazard_pointers);
+    CLDS_HAZARD_POINTER_RECORD_HANDLE hazard_pointer;
+    TEST_NODE test_node_1;
+    TEST_NODE test_node_2;
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node_1);
+    // thread 2 is stuck in an operation that has seen test_node_1
+    hazard_pointer = clds_hazard_pointers_acquire(clds_hazard_pointers_thread_2, &test_node_1);
+    // this moves the era past the interval reserved by thread 2
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread_1, &test_node_1, test_reclaim_func);
+    CLDS_HAZARD_POINTERS_RETIRE_LINK_INIT(&test_node_2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_reclaim_func(&test_node_2));
+
+    // act
+    CLDS_HAZARD_POINTERS_RETIRE_NODE(clds_hazard_pointers_thread_1, &test_node_2, test_reclaim_func);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
+    clds_hazard_pointers_release(clds_hazard_pointers_thread_2, hazard_pointer);
     clds_hazard_pointers_destroy(clds_hazard_pointers);
 }
 
@@ -0,0 +1,1366 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdbool.h>
+#include <inttypes.h>
+#include <stdlib.h>
+
+#include "macro_utils/macro_utils.h"
+#include "testrunnerswitcher.h"
+
+#include "real_gballoc_ll.h"
+
+#include "umock_c/umock_c.h"
+#include "umock_c/umocktypes_stdint.h"
+#include "umock_c/umocktypes_bool.h"
+#include "umock_c/umock_c_negative_tests.h"
+
+#include "c_pal/interlocked.h"
+
+#define ENABLE_MOCKS
+
+#include "c_pal/gballoc_hl.h"
+#include "c_pal/gballoc_hl_redirect.h"
+
+#include "clds/clds_hazard_pointers.h"
+
+#undef ENABLE_MOCKS
+
+#include "real_gballoc_hl.h"
+
+#include "../reals/real_clds_hazard_pointers.h"
+
+#include "clds/clds_open_addressing_hash_table.h"
+
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_RESULT_VALUES);
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%" PRI_MU_ENUM "", MU_ENUM_VALUE(UMOCK_C_ERROR_CODE, error_code));
+}
+
+MOCK_FUNCTION_WITH_CODE(, void, test_item_cleanup_func, void*, context, struct CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM_TAG*, item)
+MOCK_FUNCTION_END()
+
+MOCK_FUNCTION_WITH_CODE(, uint64_t, test_compute_hash, void*, key)
+    (void)key;
+MOCK_FUNCTION_END((uint64_t)key)
+
+static int test_key_compare_func(void* key_1, void* key_2)
+{
+    int result;
+    if (key_1 < key_2)
+    {
+        result = -1;
+    }
+    else if (key_1 > key_2)
+    {
+        result = 1;
+    }
+    else
+    {
+        result = 0;
+    }
+
+    return result;
+}
+
+typedef struct TEST_ITEM_TAG
+{
+    int dummy;
+} TEST_ITEM;
+
+DECLARE_OPEN_ADDRESSING_HASH_TABLE_NODE_TYPE(TEST_ITEM)
+
+static CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE g_rebuild_during_find_hash_table;
+static CLDS_HAZARD_POINTERS_THREAD_HANDLE g_rebuild_during_find_thread;
+static CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* g_rebuild_during_find_item;
+static CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* g_rebuild_during_find_new_item;
+
+// when g_rebuild_during_find_item (the item of key 0x1) is about to be protected, the groups are rebuilt and the key is deleted and inserted again with g_rebuild_during_find_new_item,
+// which retires g_rebuild_during_find_item before the hazard pointer on it is published
+static CLDS_HAZARD_POINTER_RECORD_HANDLE hook_clds_hazard_pointers_acquire(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* node)
+{
+    if (
+        (g_rebuild_during_find_hash_table != NULL) &&
+        (node == g_rebuild_during_find_item)
+        )
+    {
+        CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = g_rebuild_during_find_hash_table;
+        uintptr_t i;
+
+        g_rebuild_during_find_hash_table = NULL;
+
+        // the table has one group of 16 slots, the 16 keys after 0x1 do not fit in it
+        for (i = 2; i <= 17; i++)
+        {
+            CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+            ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, g_rebuild_during_find_thread, (void*)i, item, NULL));
+        }
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_open_addressing_hash_table_delete(hash_table, g_rebuild_during_find_thread, (void*)0x1, NULL));
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, g_rebuild_during_find_thread, (void*)0x1, g_rebuild_during_find_new_item, NULL));
+    }
+
+    return real_clds_hazard_pointers_acquire(clds_hazard_pointers_thread, node);
+}
+
+BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    ASSERT_ARE_EQUAL(int, 0, real_gballoc_hl_init(NULL, NULL));
+
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init(on_umock_c_error), "umock_c_init failed");
+
+    ASSERT_ARE_EQUAL(int, 0, umocktypes_stdint_register_types(), "umocktypes_stdint_register_types failed");
+    ASSERT_ARE_EQUAL(int, 0, umocktypes_bool_register_types(), "umocktypes_bool_register_types failed");
+
+    REGISTER_CLDS_HAZARD_POINTERS_GLOBAL_MOCK_HOOKS();
+    REGISTER_GLOBAL_MOCK_HOOK(clds_hazard_pointers_acquire, hook_clds_hazard_pointers_acquire);
+
+    REGISTER_GBALLOC_HL_GLOBAL_MOCK_HOOK();
+
+    REGISTER_UMOCK_ALIAS_TYPE(RECLAIM_FUNC, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTER_RECORD_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_THREAD_HANDLE, void*);
+
+    REGISTER_TYPE(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_RESULT);
+    REGISTER_TYPE(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_RESULT);
+    REGISTER_TYPE(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_RESULT);
+
+    ASSERT_ARE_EQUAL(int, 0, umock_c_negative_tests_init());
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_negative_tests_deinit();
+    umock_c_deinit();
+
+    real_gballoc_hl_deinit();
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+    g_rebuild_during_find_hash_table = NULL;
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+}
+
+/* clds_open_addressing_hash_table_create */
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_001: [ clds_open_addressing_hash_table_create shall create a new hash table object and on success it shall return a non-NULL handle to the newly created hash table. ]*/
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_008: [ All the slots shall start EMPTY. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_create_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t sequence_number = 55;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+
+    // act
+    hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_006: [ start_sequence_number shall be allowed to be NULL, in which case no sequence number computations shall be performed. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_create_succeeds_with_NULL_sequence_number)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+
+    // act
+    hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_007: [ The group count shall be the number of groups of 16 slots needed for capacity items, rounded up to a power of 2, and the groups shall never be rebuilt with fewer groups. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_create_rounds_up_the_group_count_to_a_power_of_2)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 4, IGNORED_ARG));
+
+    // act
+    hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 33, hazard_pointers, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_002: [ If compute_hash is NULL, clds_open_addressing_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_create_with_NULL_compute_hash_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table;
+    umock_c_reset_all_calls();
+
+    // act
+    hash_table = clds_open_addressing_hash_table_create(NULL, test_key_compare_func, 16, hazard_pointers, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_003: [ If key_compare_func is NULL, clds_open_addressing_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_create_with_NULL_key_compare_func_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table;
+    umock_c_reset_all_calls();
+
+    // act
+    hash_table = clds_open_addressing_hash_table_create(test_compute_hash, NULL, 16, hazard_pointers, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_004: [ If capacity is 0 or greater than 2^30, clds_open_addressing_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_create_with_capacity_0_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table;
+    umock_c_reset_all_calls();
+
+    // act
+    hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 0, hazard_pointers, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_004: [ If capacity is 0 or greater than 2^30, clds_open_addressing_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_create_with_capacity_too_big_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table;
+    umock_c_reset_all_calls();
+
+    // act
+    hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, ((size_t)1 << 30) + 1, hazard_pointers, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_005: [ If clds_hazard_pointers is NULL, clds_open_addressing_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_create_with_NULL_clds_hazard_pointers_fails)
+{
+    // arrange
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table;
+
+    // act
+    hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(hash_table);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_009: [ If any error happens, clds_open_addressing_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_underlying_calls_fail_clds_open_addressing_hash_table_create_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table;
+    size_t i;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 1, IGNORED_ARG));
+
+    umock_c_negative_tests_snapshot();
+
+    for (i = 0; i < umock_c_negative_tests_call_count(); i++)
+    {
+        if (umock_c_negative_tests_can_call_fail(i))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(i);
+
+            // act
+            hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+
+            // assert
+            ASSERT_IS_NULL(hash_table, "On failed call %zu", i);
+        }
+    }
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_open_addressing_hash_table_destroy */
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_011: [ clds_open_addressing_hash_table_destroy shall release the items in the table and free all resources associated with the hash table instance. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_destroy_frees_the_resources)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(hash_table));
+
+    // act
+    clds_open_addressing_hash_table_destroy(hash_table);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_011: [ clds_open_addressing_hash_table_destroy shall release the items in the table and free all resources associated with the hash table instance. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_destroy_releases_the_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
+    STRICT_EXPECTED_CALL(free(item));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(hash_table));
+
+    // act
+    clds_open_addressing_hash_table_destroy(hash_table);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_011: [ clds_open_addressing_hash_table_destroy shall release the items in the table and free all resources associated with the hash table instance. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_destroy_does_not_release_the_deleted_items_again)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_open_addressing_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL));
+    umock_c_reset_all_calls();
+
+    // the deleted item was released by the delete
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(hash_table));
+
+    // act
+    clds_open_addressing_hash_table_destroy(hash_table);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_012: [ If clds_open_addressing_hash_table is NULL, clds_open_addressing_hash_table_destroy shall return. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_destroy_with_NULL_returns)
+{
+    // arrange
+
+    // act
+    clds_open_addressing_hash_table_destroy(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* clds_open_addressing_hash_table_insert */
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_016: [ clds_open_addressing_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_open_addressing_hash_table_create. ]*/
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_017: [ clds_open_addressing_hash_table_insert shall visit the groups of the probe sequence of the hash, starting at the group given by the hash bits above the low 7 bits, and in each group the slots whose control byte is EMPTY or equal to the low 7 bits of the hash, without locking the group. ]*/
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_019: [ If a visited slot is NULL, clds_open_addressing_hash_table_insert shall claim it by changing it from NULL to value with a compare exchange, set the control byte of the slot to the low 7 bits of the hash, increment the version of the group and return CLDS_HASH_TABLE_INSERT_OK. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_insert_inserts_one_key_value_pair)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+
+    // act
+    result = clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x1, item->key);
+    ASSERT_ARE_EQUAL(uint64_t, 1, item->hash);
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_010: [ start_sequence_number shall be used as the sequence number variable that shall be incremented at every operation that is done on the hash table. ]*/
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_020: [ For a non-NULL sequence_number, clds_open_addressing_hash_table_insert shall increment the start sequence number after changing the slot and store the result in sequence_number. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_insert_returns_the_sequence_number)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    volatile_atomic int64_t sequence_number;
+    (void)interlocked_exchange_64(&sequence_number, 42);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, &sequence_number);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item_1 = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item_2 = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    int64_t insert_seq_no_1;
+    int64_t insert_seq_no_2;
+    umock_c_reset_all_calls();
+
+    // act
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, &insert_seq_no_1));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, &insert_seq_no_2));
+
+    // assert
+    ASSERT_ARE_EQUAL(int64_t, 43, insert_seq_no_1);
+    ASSERT_ARE_EQUAL(int64_t, 44, insert_seq_no_2);
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_013: [ If clds_open_addressing_hash_table is NULL, clds_open_addressing_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_insert_with_NULL_hash_table_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_open_addressing_hash_table_insert(NULL, hazard_pointers_thread, (void*)0x1, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
+
+    // cleanup
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_014: [ If clds_hazard_pointers_thread, key or value is NULL, clds_open_addressing_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_insert_with_NULL_arguments_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_INSERT_RESULT result_1 = clds_open_addressing_hash_table_insert(hash_table, NULL, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result_2 = clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, NULL, item, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result_3 = clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result_1);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result_2);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result_3);
+
+    // cleanup
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_015: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_open_addressing_hash_table_create, clds_open_addressing_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_insert_with_non_NULL_sequence_number_and_no_start_sequence_number_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    int64_t sequence_number;
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
+
+    // cleanup
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_018: [ If a slot holds an item with the same key, clds_open_addressing_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_043: [ Before comparing the key of the item in a slot, clds_open_addressing_hash_table_insert shall acquire a hazard pointer on the item and check that the slot did not change, reading the group again if it did. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_insert_with_the_same_key_2_times_returns_KEY_ALREADY_EXISTS)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item_1 = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item_2 = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_2, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS, result);
+
+    // cleanup
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_017: [ clds_open_addressing_hash_table_insert shall visit the groups of the probe sequence of the hash, starting at the group given by the hash bits above the low 7 bits, and in each group the slots whose control byte is EMPTY or equal to the low 7 bits of the hash, without locking the group. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_insert_of_a_key_whose_group_is_full_goes_to_the_next_group)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 32, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item;
+    uintptr_t i;
+
+    // keys 1 to 17 all hash to group 0
+    for (i = 1; i <= 16; i++)
+    {
+        item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)i, item, NULL));
+    }
+    item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)17, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+    for (i = 1; i <= 17; i++)
+    {
+        CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* found_item = clds_open_addressing_hash_table_find(hash_table, hazard_pointers_thread, (void*)i);
+        ASSERT_IS_NOT_NULL(found_item);
+        ASSERT_ARE_EQUAL(void_ptr, (void*)i, found_item->key);
+        CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+    }
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_022: [ If no NULL slot is found in the first 8 groups of the probe sequence (or in all the groups once the groups were rebuilt), clds_open_addressing_hash_table_insert shall rebuild the groups and look again. ]*/
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_045: [ To rebuild the groups, clds_open_addressing_hash_table_insert shall block the other writers and wait for the write operations in progress to complete. ]*/
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_046: [ clds_open_addressing_hash_table_insert shall allocate a new group array with the number of groups of 16 slots needed for twice the number of items plus one, rounded up to a power of 2 and at least the group count computed at create time. ]*/
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_047: [ clds_open_addressing_hash_table_insert shall store the items in the new group array and publish the new group array. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_insert_in_a_full_table_grows_the_table)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item;
+    uintptr_t i;
+
+    for (i = 1; i <= 16; i++)
+    {
+        item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)i, item, NULL));
+    }
+    item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // 17 items need 4 groups to be at most half full
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)17));
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 4, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)17, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+    for (i = 1; i <= 17; i++)
+    {
+        CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* found_item = clds_open_addressing_hash_table_find(hash_table, hazard_pointers_thread, (void*)i);
+        ASSERT_IS_NOT_NULL(found_item);
+        ASSERT_ARE_EQUAL(void_ptr, (void*)i, found_item->key);
+        CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+    }
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_049: [ If any error occurs, clds_open_addressing_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(when_allocating_the_new_groups_fails_clds_open_addressing_hash_table_insert_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item;
+    uintptr_t i;
+
+    for (i = 1; i <= 16; i++)
+    {
+        item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)i, item, NULL));
+    }
+    item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)17));
+    STRICT_EXPECTED_CALL(malloc_flex(IGNORED_ARG, 4, IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    CLDS_HASH_TABLE_INSERT_RESULT result = clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)17, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
+
+    // cleanup
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_021: [ clds_open_addressing_hash_table_insert shall skip the slots of deleted items. ]*/
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_019: [ If a visited slot is NULL, clds_open_addressing_hash_table_insert shall claim it by changing it from NULL to value with a compare exchange, set the control byte of the slot to the low 7 bits of the hash, increment the version of the group and return CLDS_HASH_TABLE_INSERT_OK. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_insert_of_a_deleted_key_skips_its_slot)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item_1 = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item_2 = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* found_item;
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_open_addressing_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL));
+    umock_c_reset_all_calls();
+
+    // the deleted slot holds no item to compare, the next slot is claimed
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+
+    // act
+    result = clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_2, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+    found_item = clds_open_addressing_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, found_item);
+
+    // cleanup
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_022: [ If no NULL slot is found in the first 8 groups of the probe sequence (or in all the groups once the groups were rebuilt), clds_open_addressing_hash_table_insert shall rebuild the groups and look again. ]*/
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_048: [ clds_open_addressing_hash_table_insert shall retire the old group array through hazard pointers. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_insert_and_delete_of_many_keys_in_a_small_table_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    uintptr_t i;
+    umock_c_reset_all_calls();
+
+    // act
+    // assert
+    // every key leaves a deleted item behind, the slots have to be given back for the inserts to keep succeeding
+    for (i = 1; i <= 1000; i++)
+    {
+        CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)i, item, NULL), "insert of key %" PRIuPTR " failed", i);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_open_addressing_hash_table_delete(hash_table, hazard_pointers_thread, (void*)i, NULL), "delete of key %" PRIuPTR " failed", i);
+    }
+    ASSERT_IS_NULL(clds_open_addressing_hash_table_find(hash_table, hazard_pointers_thread, (void*)1000));
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_open_addressing_hash_table_delete */
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_025: [ clds_open_addressing_hash_table_delete shall look for the key in the groups of its probe sequence like clds_open_addressing_hash_table_find, mark the slot of the key deleted with a compare exchange, increment the version of the group, retire the item through hazard pointers and return CLDS_HASH_TABLE_DELETE_OK. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_delete_deletes_the_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item, IGNORED_ARG, IGNORED_ARG));
+    // no reader protects the item, so it is released right away
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
+    STRICT_EXPECTED_CALL(free(item));
+
+    // act
+    result = clds_open_addressing_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_IS_NULL(clds_open_addressing_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1));
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_025: [ clds_open_addressing_hash_table_delete shall look for the key in the groups of its probe sequence like clds_open_addressing_hash_table_find, mark the slot of the key deleted with a compare exchange, increment the version of the group, retire the item through hazard pointers and return CLDS_HASH_TABLE_DELETE_OK. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_delete_deletes_an_item_that_went_to_the_next_group)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 32, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+    uintptr_t i;
+
+    for (i = 1; i <= 17; i++)
+    {
+        item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)i, item, NULL));
+    }
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_open_addressing_hash_table_delete(hash_table, hazard_pointers_thread, (void*)17, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_IS_NULL(clds_open_addressing_hash_table_find(hash_table, hazard_pointers_thread, (void*)17));
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_026: [ For a non-NULL sequence_number, clds_open_addressing_hash_table_delete shall increment the start sequence number after changing the slot and store the result in sequence_number. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_delete_returns_the_sequence_number)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    volatile_atomic int64_t sequence_number;
+    (void)interlocked_exchange_64(&sequence_number, 42);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, &sequence_number);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    int64_t delete_seq_no;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_DELETE_RESULT result = clds_open_addressing_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, &delete_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_ARE_EQUAL(int64_t, 43, delete_seq_no);
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_027: [ If the key is not found, clds_open_addressing_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_delete_with_a_key_that_is_not_in_the_table_returns_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_open_addressing_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x2, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_NOT_FOUND, result);
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_023: [ If clds_open_addressing_hash_table, clds_hazard_pointers_thread or key is NULL, clds_open_addressing_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_delete_with_NULL_arguments_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_DELETE_RESULT result_1 = clds_open_addressing_hash_table_delete(NULL, hazard_pointers_thread, (void*)0x1, NULL);
+    CLDS_HASH_TABLE_DELETE_RESULT result_2 = clds_open_addressing_hash_table_delete(hash_table, NULL, (void*)0x1, NULL);
+    CLDS_HASH_TABLE_DELETE_RESULT result_3 = clds_open_addressing_hash_table_delete(hash_table, hazard_pointers_thread, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result_1);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result_2);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result_3);
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_024: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_open_addressing_hash_table_create, clds_open_addressing_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_delete_with_non_NULL_sequence_number_and_no_start_sequence_number_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    int64_t sequence_number;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_open_addressing_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result);
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_open_addressing_hash_table_remove */
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_030: [ clds_open_addressing_hash_table_remove shall remove the item with the given key like clds_open_addressing_hash_table_delete, return it with its reference count incremented in item and return CLDS_HASH_TABLE_REMOVE_OK. ]*/
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_032: [ For a non-NULL sequence_number, clds_open_addressing_hash_table_remove shall increment the start sequence number after changing the slot and store the result in sequence_number. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_remove_removes_the_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    volatile_atomic int64_t sequence_number;
+    (void)interlocked_exchange_64(&sequence_number, 42);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, &sequence_number);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* removed_item;
+    int64_t remove_seq_no;
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_open_addressing_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, &remove_seq_no);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, item, removed_item);
+    ASSERT_ARE_EQUAL(int64_t, 43, remove_seq_no);
+    ASSERT_IS_NULL(clds_open_addressing_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1));
+
+    // cleanup
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_031: [ If the key is not found, clds_open_addressing_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_remove_with_a_key_that_is_not_in_the_table_returns_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* removed_item;
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_open_addressing_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_NOT_FOUND, result);
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_028: [ If clds_open_addressing_hash_table, clds_hazard_pointers_thread, key or item is NULL, clds_open_addressing_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_remove_with_NULL_arguments_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* removed_item;
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_REMOVE_RESULT result_1 = clds_open_addressing_hash_table_remove(NULL, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+    CLDS_HASH_TABLE_REMOVE_RESULT result_2 = clds_open_addressing_hash_table_remove(hash_table, NULL, (void*)0x1, &removed_item, NULL);
+    CLDS_HASH_TABLE_REMOVE_RESULT result_3 = clds_open_addressing_hash_table_remove(hash_table, hazard_pointers_thread, NULL, &removed_item, NULL);
+    CLDS_HASH_TABLE_REMOVE_RESULT result_4 = clds_open_addressing_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result_1);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result_2);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result_3);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result_4);
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_029: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_open_addressing_hash_table_create, clds_open_addressing_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_remove_with_non_NULL_sequence_number_and_no_start_sequence_number_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* removed_item;
+    int64_t sequence_number;
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_open_addressing_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_open_addressing_hash_table_find */
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_034: [ clds_open_addressing_hash_table_find shall compare the control bytes of each visited group with the low 7 bits of the hash of the key, using one 16 byte SSE2 compare when available, without locking the group. ]*/
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_035: [ For each matching slot, clds_open_addressing_hash_table_find shall acquire a hazard pointer on the item in the slot, check that the version of the group did not change and compare the hash and then the key of the item. ]*/
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_037: [ If the key is found, clds_open_addressing_hash_table_find shall return the item with its reference count incremented. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_find_returns_the_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_open_addressing_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, item, result);
+
+    // cleanup
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_035: [ For each matching slot, clds_open_addressing_hash_table_find shall acquire a hazard pointer on the item in the slot, check that the version of the group did not change and compare the hash and then the key of the item. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_find_with_2_keys_with_the_same_tag_in_one_group_returns_the_right_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    // 2 groups, 0x1 and 0x101 both go to group 0 with tag 1
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 32, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item_1 = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item_2 = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x101, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x101));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_2));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_open_addressing_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x101);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, item_2, result);
+
+    // cleanup
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_039: [ If the key is not found before a group with a NULL slot or after visiting all the groups, clds_open_addressing_hash_table_find shall return NULL. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_find_with_a_key_that_is_not_in_the_table_returns_NULL)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_open_addressing_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_039: [ If the key is not found before a group with a NULL slot or after visiting all the groups, clds_open_addressing_hash_table_find shall return NULL. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_find_in_a_full_table_with_a_key_that_is_not_in_the_table_returns_NULL)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* result;
+    uintptr_t i;
+
+    for (i = 1; i <= 16; i++)
+    {
+        CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)i, item, NULL));
+    }
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_open_addressing_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x42);
+
+    // assert
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_033: [ If clds_open_addressing_hash_table, clds_hazard_pointers_thread or key is NULL, clds_open_addressing_hash_table_find shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_find_with_NULL_arguments_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* result_1 = clds_open_addressing_hash_table_find(NULL, hazard_pointers_thread, (void*)0x1);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* result_2 = clds_open_addressing_hash_table_find(hash_table, NULL, (void*)0x1);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* result_3 = clds_open_addressing_hash_table_find(hash_table, hazard_pointers_thread, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result_1);
+    ASSERT_IS_NULL(result_2);
+    ASSERT_IS_NULL(result_3);
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_038: [ If any error occurs, clds_open_addressing_hash_table_find shall fail and return NULL. ]*/
+TEST_FUNCTION(when_acquiring_the_hazard_pointer_fails_clds_open_addressing_hash_table_find_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_open_addressing_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_055: [ clds_open_addressing_hash_table_find shall acquire a hazard pointer on the group array of the table and check that it is still the group array of the table before reading the groups. ]*/
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_038: [ If any error occurs, clds_open_addressing_hash_table_find shall fail and return NULL. ]*/
+TEST_FUNCTION(when_acquiring_the_hazard_pointer_on_the_groups_fails_clds_open_addressing_hash_table_find_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG))
+        .SetReturn(NULL);
+
+    // act
+    result = clds_open_addressing_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_039: [ If the key is not found before a group with a NULL slot or after visiting all the groups, clds_open_addressing_hash_table_find shall return NULL. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_find_of_a_deleted_key_returns_NULL)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_open_addressing_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_open_addressing_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_056: [ If the group array of the table was replaced when the hazard pointer on the item was acquired, clds_open_addressing_hash_table_find shall look for the key again in the group array of the table. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_find_looks_again_when_the_groups_are_rebuilt_and_the_key_inserted_again_before_the_item_is_protected)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE hash_table = clds_open_addressing_hash_table_create(test_compute_hash, test_key_compare_func, 16, hazard_pointers, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item_1 = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item_2 = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_open_addressing_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+
+    g_rebuild_during_find_thread = hazard_pointers_thread;
+    g_rebuild_during_find_item = item_1;
+    g_rebuild_during_find_new_item = item_2;
+    g_rebuild_during_find_hash_table = hash_table;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_open_addressing_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
+
+    // assert
+    ASSERT_IS_NULL(g_rebuild_during_find_hash_table);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, result);
+
+    // cleanup
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
+    clds_open_addressing_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_open_addressing_hash_table_node_create */
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_040: [ item_cleanup_callback and item_cleanup_callback_context shall be allowed to be NULL. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_node_create_with_NULL_cleanup_callback_succeeds)
+{
+    // arrange
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item;
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(item);
+
+    // cleanup
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+}
+
+/* clds_open_addressing_hash_table_node_release */
+
+/* Tests_SRS_CLDS_OPEN_ADDRESSING_HASH_TABLE_01_041: [ When the reference count of an item reaches 0, item_cleanup_callback shall be called (if not NULL) and the item shall be freed. ]*/
+TEST_FUNCTION(clds_open_addressing_hash_table_node_release_calls_the_cleanup_callback)
+{
+    // arrange
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item = CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
+    STRICT_EXPECTED_CALL(free(item));
+
+    // act
+    CLDS_OPEN_ADDRESSING_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
@@ -67,6 +67,10 @@ static CLDS_CONDITION_CHECK_RESULT g_condition_check_result = CLDS_CONDITION_CHE
 MOCK_FUNCTION_WITH_CODE(, CLDS_CONDITION_CHECK_RESULT, test_item_condition_check, void*, context, void*, new_key, void*, old_key)
 MOCK_FUNCTION_END(g_condition_check_result)
 
+static CLDS_SORTED_LIST_ITEM* g_test_item_factory_result;
+MOCK_FUNCTION_WITH_CODE(, CLDS_SORTED_LIST_ITEM*, test_item_factory, void*, context)
+MOCK_FUNCTION_END(g_test_item_factory_result)
+
 typedef struct TEST_ITEM_TAG
 {
     uint32_t key;
@@ -147,6 +151,7 @@ TEST_SUITE_CLEANUP(suite_cleanup)
 TEST_FUNCTION_INITIALIZE(method_init)
 {
     g_condition_check_result = CLDS_CONDITION_CHECK_OK;
+    g_test_item_factory_result = NULL;
     umock_c_reset_all_calls();
 }
 
@@ -898,8 +903,8 @@ TEST_FUNCTION(clds_sorted_list_insert_with_non_NULL_sequence_number_but_no_start
 
 /* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_retire. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_retire shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_070: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
 TEST_FUNCTION(clds_sorted_list_delete_item_deletes_the_item)
 {
@@ -920,7 +925,7 @@ TEST_FUNCTION(clds_sorted_list_delete_item_deletes_the_item)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item, &item->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
     STRICT_EXPECTED_CALL(free(item));
 
@@ -938,8 +943,8 @@ TEST_FUNCTION(clds_sorted_list_delete_item_deletes_the_item)
 
 /* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_retire. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_retire shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
 TEST_FUNCTION(clds_sorted_list_delete_for_the_2nd_item_succeeds)
 {
     // arrange
@@ -964,7 +969,7 @@ TEST_FUNCTION(clds_sorted_list_delete_for_the_2nd_item_succeeds)
     STRICT_EXPECTED_CALL(clds_st_hash_set_insert(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_2, &item_2->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_2));
     STRICT_EXPECTED_CALL(free(item_2));
 
@@ -982,8 +987,8 @@ TEST_FUNCTION(clds_sorted_list_delete_for_the_2nd_item_succeeds)
 
 /* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_retire. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_retire shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
 TEST_FUNCTION(clds_sorted_list_delete_for_the_oldest_out_of_2_items_succeeds)
 {
     // arrange
@@ -1008,7 +1013,7 @@ TEST_FUNCTION(clds_sorted_list_delete_for_the_oldest_out_of_2_items_succeeds)
     STRICT_EXPECTED_CALL(clds_st_hash_set_insert(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_1, &item_1->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_1));
     STRICT_EXPECTED_CALL(free(item_1));
 
@@ -1026,8 +1031,8 @@ TEST_FUNCTION(clds_sorted_list_delete_for_the_oldest_out_of_2_items_succeeds)
 
 /* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_retire. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_retire shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
 TEST_FUNCTION(clds_sorted_list_delete_for_the_2nd_out_of_3_items_succeeds)
 {
     // arrange
@@ -1055,7 +1060,7 @@ TEST_FUNCTION(clds_sorted_list_delete_for_the_2nd_out_of_3_items_succeeds)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_2, &item_2->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_2));
     STRICT_EXPECTED_CALL(free(item_2));
 
@@ -1073,7 +1078,7 @@ TEST_FUNCTION(clds_sorted_list_delete_for_the_2nd_out_of_3_items_succeeds)
 
 /* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_retire. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_044: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the reclaimed item. ]*/
 TEST_FUNCTION(clds_sorted_list_delete_deletes_the_item_NULL_cleanup_callback)
 {
@@ -1094,7 +1099,7 @@ TEST_FUNCTION(clds_sorted_list_delete_deletes_the_item_NULL_cleanup_callback)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item, &item->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(item));
 
     // act
@@ -1111,7 +1116,7 @@ TEST_FUNCTION(clds_sorted_list_delete_deletes_the_item_NULL_cleanup_callback)
 
 /* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_retire. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_044: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the reclaimed item. ]*/
 TEST_FUNCTION(clds_sorted_list_delete_for_the_2nd_item_succeeds_NULL_cleanup_callback)
 {
@@ -1136,7 +1141,7 @@ TEST_FUNCTION(clds_sorted_list_delete_for_the_2nd_item_succeeds_NULL_cleanup_cal
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_2, &item_2->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(item_2));
 
     // act
@@ -1153,7 +1158,7 @@ TEST_FUNCTION(clds_sorted_list_delete_for_the_2nd_item_succeeds_NULL_cleanup_cal
 
 /* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_retire. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_044: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the reclaimed item. ]*/
 TEST_FUNCTION(clds_sorted_list_delete_for_the_oldest_out_of_2_items_succeeds_NULL_cleanup_callback)
 {
@@ -1178,7 +1183,7 @@ TEST_FUNCTION(clds_sorted_list_delete_for_the_oldest_out_of_2_items_succeeds_NUL
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_1, &item_1->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(item_1));
 
     // act
@@ -1195,7 +1200,7 @@ TEST_FUNCTION(clds_sorted_list_delete_for_the_oldest_out_of_2_items_succeeds_NUL
 
 /* Tests_SRS_CLDS_SORTED_LIST_01_014: [ clds_sorted_list_delete_item shall delete an item from the list by its pointer. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_026: [ On success, clds_sorted_list_delete_item shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_reclaim. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_042: [ When an item is deleted it shall be indicated to the hazard pointers instance as reclaimed by calling clds_hazard_pointers_retire. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_044: [ If item_cleanup_callback is NULL, no user callback shall be triggered for the reclaimed item. ]*/
 TEST_FUNCTION(clds_sorted_list_delete_for_the_2nd_out_of_3_items_succeeds_NULL_cleanup_callback)
 {
@@ -1224,7 +1229,7 @@ TEST_FUNCTION(clds_sorted_list_delete_for_the_2nd_out_of_3_items_succeeds_NULL_c
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_2, &item_2->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(item_2));
 
     // act
@@ -1433,10 +1438,10 @@ TEST_FUNCTION(clds_sorted_list_delete_stamps_the_order)
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_1, &item_1->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(item_1));
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_2, &item_2->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(item_2));
 
     // act
@@ -1483,10 +1488,10 @@ TEST_FUNCTION(clds_sorted_list_delete_with_no_start_seq_no_stamps_the_order)
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_1, &item_1->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(item_1));
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_2, &item_2->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(item_2));
 
     // act
@@ -1536,7 +1541,7 @@ TEST_FUNCTION(clds_sorted_list_delete_with_non_NULL_sequence_no_and_no_start_seq
 
 /* Tests_SRS_CLDS_SORTED_LIST_01_019: [ clds_sorted_list_delete_key shall delete an item by its key. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_025: [ On success, clds_sorted_list_delete_key shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_retire shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_071: [ If no start sequence number was provided in clds_sorted_list_create and sequence_number is NULL, no sequence number computations shall be done. ]*/
 TEST_FUNCTION(clds_sorted_list_delete_key_succeeds)
 {
@@ -1557,7 +1562,7 @@ TEST_FUNCTION(clds_sorted_list_delete_key_succeeds)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item, &item->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
     STRICT_EXPECTED_CALL(free(item));
 
@@ -1595,7 +1600,7 @@ TEST_FUNCTION(clds_sorted_list_delete_key_succeeds_with_NULL_item_cleanup_callba
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item, &item->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(free(item));
 
     // act
@@ -1693,7 +1698,7 @@ TEST_FUNCTION(clds_sorted_list_delete_key_with_NULL_key_fails)
 
 /* Tests_SRS_CLDS_SORTED_LIST_01_019: [ clds_sorted_list_delete_key shall delete an item by its key. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_025: [ On success, clds_sorted_list_delete_key shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_retire shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
 TEST_FUNCTION(clds_sorted_list_delete_key_deletes_the_second_item)
 {
     // arrange
@@ -1717,7 +1722,7 @@ TEST_FUNCTION(clds_sorted_list_delete_key_deletes_the_second_item)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_2, &item_2->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_2));
     STRICT_EXPECTED_CALL(free(item_2));
 
@@ -1735,7 +1740,7 @@ TEST_FUNCTION(clds_sorted_list_delete_key_deletes_the_second_item)
 
 /* Tests_SRS_CLDS_SORTED_LIST_01_019: [ clds_sorted_list_delete_key shall delete an item by its key. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_025: [ On success, clds_sorted_list_delete_key shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_retire shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
 TEST_FUNCTION(clds_sorted_list_delete_key_deletes_the_oldest_out_of_2_items)
 {
     // arrange
@@ -1759,7 +1764,7 @@ TEST_FUNCTION(clds_sorted_list_delete_key_deletes_the_oldest_out_of_2_items)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_1, &item_1->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_1));
     STRICT_EXPECTED_CALL(free(item_1));
 
@@ -1777,7 +1782,7 @@ TEST_FUNCTION(clds_sorted_list_delete_key_deletes_the_oldest_out_of_2_items)
 
 /* Tests_SRS_CLDS_SORTED_LIST_01_019: [ clds_sorted_list_delete_key shall delete an item by its key. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_025: [ On success, clds_sorted_list_delete_key shall return CLDS_SORTED_LIST_DELETE_OK. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_retire shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
 TEST_FUNCTION(clds_sorted_list_delete_key_deletes_the_2nd_out_of_3_items)
 {
     // arrange
@@ -1805,7 +1810,7 @@ TEST_FUNCTION(clds_sorted_list_delete_key_deletes_the_2nd_out_of_3_items)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_2, &item_2->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_2));
     STRICT_EXPECTED_CALL(free(item_2));
 
@@ -1913,11 +1918,11 @@ TEST_FUNCTION(clds_sorted_list_delete_key_stamps_the_sequence_no)
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_1, &item_1->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_1));
     STRICT_EXPECTED_CALL(free(item_1));
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_2, &item_2->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4243, item_2));
     STRICT_EXPECTED_CALL(free(item_2));
 
@@ -1965,11 +1970,11 @@ TEST_FUNCTION(clds_sorted_list_delete_key_with_NULL_sequence_no_and_non_NULL_sta
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_1, &item_1->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item_1));
     STRICT_EXPECTED_CALL(free(item_1));
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_2, &item_2->retire_link, IGNORED_ARG));
     STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4243, item_2));
     STRICT_EXPECTED_CALL(free(item_2));
 
@@ -2042,7 +2047,7 @@ TEST_FUNCTION(clds_sorted_list_remove_key_succeeds)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item, &item->retire_link, IGNORED_ARG));
 
     // act
     result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x42, &removed_item, NULL);
@@ -2080,7 +2085,7 @@ TEST_FUNCTION(clds_sorted_list_remove_key_succeeds_with_NULL_item_cleanup_callba
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item, &item->retire_link, IGNORED_ARG));
 
     // act
     result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x42, &removed_item, NULL);
@@ -2182,7 +2187,7 @@ TEST_FUNCTION(clds_sorted_list_remove_key_with_NULL_key_fails)
 /* Tests_SRS_CLDS_SORTED_LIST_01_051: [ clds_sorted_list_remove_key shall delete an item by its key and return the pointer to the deleted item. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_052: [ On success, clds_sorted_list_remove_key shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_054: [ On success, the found item shall be returned in the item argument. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_retire shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
 TEST_FUNCTION(clds_sorted_list_remove_key_deletes_the_second_item)
 {
     // arrange
@@ -2207,7 +2212,7 @@ TEST_FUNCTION(clds_sorted_list_remove_key_deletes_the_second_item)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_2, &item_2->retire_link, IGNORED_ARG));
 
     // act
     result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x43, &removed_item, NULL);
@@ -2225,7 +2230,7 @@ TEST_FUNCTION(clds_sorted_list_remove_key_deletes_the_second_item)
 /* Tests_SRS_CLDS_SORTED_LIST_01_051: [ clds_sorted_list_remove_key shall delete an item by its key and return the pointer to the deleted item. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_052: [ On success, clds_sorted_list_remove_key shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_054: [ On success, the found item shall be returned in the item argument. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_retire shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
 TEST_FUNCTION(clds_sorted_list_remove_key_deletes_the_oldest_out_of_2_items)
 {
     // arrange
@@ -2250,7 +2255,7 @@ TEST_FUNCTION(clds_sorted_list_remove_key_deletes_the_oldest_out_of_2_items)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_1, &item_1->retire_link, IGNORED_ARG));
 
     // act
     result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x42, &removed_item, NULL);
@@ -2268,7 +2273,7 @@ TEST_FUNCTION(clds_sorted_list_remove_key_deletes_the_oldest_out_of_2_items)
 /* Tests_SRS_CLDS_SORTED_LIST_01_051: [ clds_sorted_list_remove_key shall delete an item by its key and return the pointer to the deleted item. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_052: [ On success, clds_sorted_list_remove_key shall return CLDS_SORTED_LIST_REMOVE_OK. ]*/
 /* Tests_SRS_CLDS_SORTED_LIST_01_054: [ On success, the found item shall be returned in the item argument. ]*/
-/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_reclaim shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_043: [ The reclaim function passed to clds_hazard_pointers_retire shall call the user callback item_cleanup_callback that was passed to clds_sorted_list_node_create, while passing item_cleanup_callback_context and the freed item as arguments. ]*/
 TEST_FUNCTION(clds_sorted_list_remove_key_deletes_the_2nd_out_of_3_items)
 {
     // arrange
@@ -2297,7 +2302,7 @@ TEST_FUNCTION(clds_sorted_list_remove_key_deletes_the_2nd_out_of_3_items)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_2, &item_2->retire_link, IGNORED_ARG));
 
     // act
     result = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x43, &removed_item, NULL);
@@ -2408,8 +2413,8 @@ TEST_FUNCTION(clds_sorted_list_remove_key_stamps_the_sequence_numbers)
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_1, &item_1->retire_link, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_2, &item_2->retire_link, IGNORED_ARG));
 
     // act
     result_1 = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x42, &removed_item_1, &remove_seq_no_1);
@@ -2459,8 +2464,8 @@ TEST_FUNCTION(clds_sorted_list_remove_key_with_NULL_sequence_number_and_non_NULL
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
 
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_1, &item_1->retire_link, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_2, &item_2->retire_link, IGNORED_ARG));
 
     // act
     result_1 = clds_sorted_list_remove_key(list, hazard_pointers_thread, (void*)0x42, &removed_item_1, NULL);
@@ -2837,7 +2842,7 @@ TEST_FUNCTION(clds_sorted_list_find_key_result_has_the_ref_count_incremented)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item, &item->retire_link, IGNORED_ARG));
 
     // no item cleanup and free should happen here
 
@@ -3869,7 +3874,7 @@ TEST_FUNCTION(clds_sorted_list_set_value_when_the_key_is_in_the_list_succeeds)
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_1, &item_1->retire_link, IGNORED_ARG));
 
     // act
     result = clds_sorted_list_set_value(list, hazard_pointers_thread, (void*)0x42, item_2, NULL, NULL, &old_item, &set_value_seq_no, false);
@@ -3977,7 +3982,7 @@ TEST_FUNCTION(clds_sorted_list_set_value_succeeds_when_condition_check_db_return
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(test_item_condition_check((void*)0x42, IGNORED_ARG, IGNORED_ARG));
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_1, &item_1->retire_link, IGNORED_ARG));
 
     // act
     result = clds_sorted_list_set_value(list, hazard_pointers_thread, (void*)0x42, item_2, test_item_condition_check, (void *)0x42, &old_item, &set_value_seq_no, false);
@@ -4031,7 +4036,7 @@ TEST_FUNCTION(clds_sorted_list_set_value_when_the_key_is_in_the_list_for_the_2nd
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_2, &item_2->retire_link, IGNORED_ARG));
 
     // act
     result = clds_sorted_list_set_value(list, hazard_pointers_thread, (void*)0x43, item_3, NULL, NULL, &old_item, &set_value_seq_no, false);
@@ -4080,7 +4085,7 @@ TEST_FUNCTION(clds_sorted_list_set_value_when_the_key_is_in_the_list_for_the_2nd
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_2, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_2, &item_2->retire_link, IGNORED_ARG));
 
     // act
     result = clds_sorted_list_set_value(list, hazard_pointers_thread, (void*)0x43, item_3, NULL, NULL, &old_item, NULL, false);
@@ -4130,7 +4135,7 @@ TEST_FUNCTION(clds_sorted_list_set_value_with_NULL_sequence_number_still_increme
     STRICT_EXPECTED_CALL(clds_st_hash_set_create(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_destroy(IGNORED_ARG)).IgnoreAllCalls();
     STRICT_EXPECTED_CALL(clds_st_hash_set_find(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
-    STRICT_EXPECTED_CALL(clds_hazard_pointers_reclaim(hazard_pointers_thread, item_3, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_3, &item_3->retire_link, IGNORED_ARG));
 
     // act
     result = clds_sorted_list_set_value(list, hazard_pointers_thread, (void*)0x43, item_2, NULL, NULL, &old_item, &set_value_seq_no, false);
@@ -4199,4 +4204,596 @@ TEST_FUNCTION(clds_sorted_list_set_value_with_the_same_item_succeeds)
     clds_hazard_pointers_destroy(hazard_pointers);
 }
 
+/* clds_sorted_list_head_insert */
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_094: [ If clds_sorted_list is NULL, clds_sorted_list_head_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_head_insert_with_NULL_clds_sorted_list_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HEAD list_head;
+    CLDS_SORTED_LIST_INSERT_RESULT result;
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
+    item_payload->key = 0x42;
+    CLDS_SORTED_LIST_HEAD_INIT(&list_head);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_sorted_list_head_insert(NULL, &list_head, hazard_pointers_thread, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result);
+
+    // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_095: [ If list_head is NULL, clds_sorted_list_head_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_head_insert_with_NULL_list_head_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_INSERT_RESULT result;
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
+    item_payload->key = 0x42;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_sorted_list_head_insert(list, NULL, hazard_pointers_thread, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result);
+
+    // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item);
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_099: [ Otherwise clds_sorted_list_head_insert shall insert item in the items linked to list_head the same way clds_sorted_list_insert does, using the callbacks, sequence number and write lock of clds_sorted_list. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_122: [ Otherwise clds_sorted_list_head_find_key shall find the item with the given key in the items linked to list_head the same way clds_sorted_list_find_key does, using the callbacks of clds_sorted_list. ]*/
+TEST_FUNCTION(clds_sorted_list_head_insert_links_the_item_to_the_head_and_not_to_the_list)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_HEAD list_head;
+    CLDS_SORTED_LIST_INSERT_RESULT result;
+    CLDS_SORTED_LIST_ITEM* found_item;
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item);
+    item_payload->key = 0x42;
+    CLDS_SORTED_LIST_HEAD_INIT(&list_head);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+
+    // act
+    result = clds_sorted_list_head_insert(list, &list_head, hazard_pointers_thread, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_OK, result);
+    ASSERT_IS_FALSE(CLDS_SORTED_LIST_HEAD_IS_EMPTY(&list_head));
+    ASSERT_IS_NULL(clds_sorted_list_find_key(list, hazard_pointers_thread, (void*)0x42));
+    found_item = clds_sorted_list_head_find_key(list, &list_head, hazard_pointers_thread, (void*)0x42);
+    ASSERT_ARE_EQUAL(void_ptr, item, found_item);
+
+    // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, found_item);
+    clds_sorted_list_head_clear(list, &list_head);
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_sorted_list_head_get_or_insert */
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_160: [ If clds_sorted_list is NULL, clds_sorted_list_head_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_head_get_or_insert_with_NULL_clds_sorted_list_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HEAD list_head;
+    CLDS_SORTED_LIST_INSERT_RESULT result;
+    CLDS_SORTED_LIST_ITEM* item;
+    CLDS_SORTED_LIST_HEAD_INIT(&list_head);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_sorted_list_head_get_or_insert(NULL, &list_head, hazard_pointers_thread, (void*)0x42, test_item_factory, (void*)0x4245, &item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_161: [ If list_head is NULL, clds_sorted_list_head_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_head_get_or_insert_with_NULL_list_head_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_INSERT_RESULT result;
+    CLDS_SORTED_LIST_ITEM* item;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_sorted_list_head_get_or_insert(list, NULL, hazard_pointers_thread, (void*)0x42, test_item_factory, (void*)0x4245, &item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_162: [ If clds_hazard_pointers_thread is NULL, clds_sorted_list_head_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_head_get_or_insert_with_NULL_clds_hazard_pointers_thread_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_HEAD list_head;
+    CLDS_SORTED_LIST_INSERT_RESULT result;
+    CLDS_SORTED_LIST_ITEM* item;
+    CLDS_SORTED_LIST_HEAD_INIT(&list_head);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_sorted_list_head_get_or_insert(list, &list_head, NULL, (void*)0x42, test_item_factory, (void*)0x4245, &item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_163: [ If key, item_factory or item is NULL, clds_sorted_list_head_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_head_get_or_insert_with_NULL_key_item_factory_or_item_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_HEAD list_head;
+    CLDS_SORTED_LIST_ITEM* item;
+    CLDS_SORTED_LIST_HEAD_INIT(&list_head);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_SORTED_LIST_INSERT_RESULT result_1 = clds_sorted_list_head_get_or_insert(list, &list_head, hazard_pointers_thread, NULL, test_item_factory, (void*)0x4245, &item, NULL);
+    CLDS_SORTED_LIST_INSERT_RESULT result_2 = clds_sorted_list_head_get_or_insert(list, &list_head, hazard_pointers_thread, (void*)0x42, NULL, (void*)0x4245, &item, NULL);
+    CLDS_SORTED_LIST_INSERT_RESULT result_3 = clds_sorted_list_head_get_or_insert(list, &list_head, hazard_pointers_thread, (void*)0x42, test_item_factory, (void*)0x4245, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result_1);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result_2);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result_3);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_164: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_sorted_list_create, clds_sorted_list_head_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_sorted_list_head_get_or_insert_with_non_NULL_sequence_number_and_no_start_sequence_number_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_HEAD list_head;
+    CLDS_SORTED_LIST_INSERT_RESULT result;
+    CLDS_SORTED_LIST_ITEM* item;
+    int64_t sequence_number;
+    CLDS_SORTED_LIST_HEAD_INIT(&list_head);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_sorted_list_head_get_or_insert(list, &list_head, hazard_pointers_thread, (void*)0x42, test_item_factory, (void*)0x4245, &item, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_165: [ Otherwise clds_sorted_list_head_get_or_insert shall look for key in the items linked to list_head and insert a new item at its position in the same pass, the same way clds_sorted_list_head_insert does. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_166: [ clds_sorted_list_head_get_or_insert shall call item_factory only when key is not found in the items linked to list_head. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_167: [ If key is not found, clds_sorted_list_head_get_or_insert shall link the item created by item_factory at its position, set item to it with its reference count incremented and return CLDS_SORTED_LIST_INSERT_OK. ]*/
+TEST_FUNCTION(clds_sorted_list_head_get_or_insert_in_an_empty_list_inserts_the_item_made_by_the_factory)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_HEAD list_head;
+    CLDS_SORTED_LIST_INSERT_RESULT result;
+    CLDS_SORTED_LIST_ITEM* item;
+    CLDS_SORTED_LIST_ITEM* found_item;
+    CLDS_SORTED_LIST_ITEM* new_item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    TEST_ITEM* item_payload = CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, new_item);
+    item_payload->key = 0x42;
+    g_test_item_factory_result = new_item;
+    CLDS_SORTED_LIST_HEAD_INIT(&list_head);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_item_factory((void*)0x4245));
+
+    // act
+    result = clds_sorted_list_head_get_or_insert(list, &list_head, hazard_pointers_thread, (void*)0x42, test_item_factory, (void*)0x4245, &item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, new_item, item);
+    ASSERT_ARE_EQUAL(int32_t, 2, interlocked_add(&new_item->ref_count, 0));
+    found_item = clds_sorted_list_head_find_key(list, &list_head, hazard_pointers_thread, (void*)0x42);
+    ASSERT_ARE_EQUAL(void_ptr, new_item, found_item);
+
+    // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, found_item);
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item);
+    clds_sorted_list_head_clear(list, &list_head);
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_167: [ If key is not found, clds_sorted_list_head_get_or_insert shall link the item created by item_factory at its position, set item to it with its reference count incremented and return CLDS_SORTED_LIST_INSERT_OK. ]*/
+TEST_FUNCTION(clds_sorted_list_head_get_or_insert_links_the_new_item_between_the_lower_and_the_greater_keys)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_HEAD list_head;
+    CLDS_SORTED_LIST_INSERT_RESULT result;
+    CLDS_SORTED_LIST_ITEM* item;
+    CLDS_SORTED_LIST_ITEM* first_item;
+    CLDS_SORTED_LIST_ITEM* next_item;
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_3 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* new_item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1)->key = 0x41;
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_3)->key = 0x43;
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, new_item)->key = 0x42;
+    g_test_item_factory_result = new_item;
+    CLDS_SORTED_LIST_HEAD_INIT(&list_head);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_OK, clds_sorted_list_head_insert(list, &list_head, hazard_pointers_thread, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_OK, clds_sorted_list_head_insert(list, &list_head, hazard_pointers_thread, item_3, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_item_factory((void*)0x4245));
+
+    // act
+    result = clds_sorted_list_head_get_or_insert(list, &list_head, hazard_pointers_thread, (void*)0x42, test_item_factory, (void*)0x4245, &item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, new_item, item);
+    ASSERT_ARE_EQUAL(int, 0, clds_sorted_list_head_get_first(list, &list_head, hazard_pointers_thread, &first_item));
+    ASSERT_ARE_EQUAL(void_ptr, item_1, first_item);
+    ASSERT_ARE_EQUAL(int, 0, clds_sorted_list_head_get_next(list, &list_head, hazard_pointers_thread, (void*)0x41, &next_item));
+    ASSERT_ARE_EQUAL(void_ptr, new_item, next_item);
+
+    // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, first_item);
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, next_item);
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item);
+    clds_sorted_list_head_clear(list, &list_head);
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_166: [ clds_sorted_list_head_get_or_insert shall call item_factory only when key is not found in the items linked to list_head. ]*/
+/* Tests_SRS_CLDS_SORTED_LIST_01_168: [ If key is found, clds_sorted_list_head_get_or_insert shall set item to the item in the list, with its reference count incremented, and return CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS. ]*/
+TEST_FUNCTION(clds_sorted_list_head_get_or_insert_with_a_key_in_the_list_returns_the_item_without_calling_the_factory)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_HEAD list_head;
+    CLDS_SORTED_LIST_INSERT_RESULT result;
+    CLDS_SORTED_LIST_ITEM* item;
+    CLDS_SORTED_LIST_ITEM* existing_item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, existing_item)->key = 0x42;
+    CLDS_SORTED_LIST_HEAD_INIT(&list_head);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_OK, clds_sorted_list_head_insert(list, &list_head, hazard_pointers_thread, existing_item, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, existing_item));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_sorted_list_head_get_or_insert(list, &list_head, hazard_pointers_thread, (void*)0x42, test_item_factory, (void*)0x4245, &item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_KEY_ALREADY_EXISTS, result);
+    ASSERT_ARE_EQUAL(void_ptr, existing_item, item);
+    ASSERT_ARE_EQUAL(int32_t, 2, interlocked_add(&existing_item->ref_count, 0));
+
+    // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item);
+    clds_sorted_list_head_clear(list, &list_head);
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_169: [ If item_factory fails or any other error occurs, clds_sorted_list_head_get_or_insert shall fail and return CLDS_SORTED_LIST_INSERT_ERROR. ]*/
+TEST_FUNCTION(when_item_factory_fails_clds_sorted_list_head_get_or_insert_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_HEAD list_head;
+    CLDS_SORTED_LIST_INSERT_RESULT result;
+    CLDS_SORTED_LIST_ITEM* item;
+    g_test_item_factory_result = NULL;
+    CLDS_SORTED_LIST_HEAD_INIT(&list_head);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_item_factory((void*)0x4245));
+
+    // act
+    result = clds_sorted_list_head_get_or_insert(list, &list_head, hazard_pointers_thread, (void*)0x42, test_item_factory, (void*)0x4245, &item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_ERROR, result);
+    ASSERT_IS_TRUE(CLDS_SORTED_LIST_HEAD_IS_EMPTY(&list_head));
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_sorted_list_head_get_first */
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_143: [ If list_head is NULL, clds_sorted_list_head_get_first shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_sorted_list_head_get_first_with_NULL_list_head_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_ITEM* item;
+    int result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_sorted_list_head_get_first(list, NULL, hazard_pointers_thread, &item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_146: [ If no items are linked to list_head, clds_sorted_list_head_get_first shall set item to NULL and return 0. ]*/
+TEST_FUNCTION(clds_sorted_list_head_get_first_with_an_empty_head_yields_NULL)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_HEAD list_head;
+    CLDS_SORTED_LIST_ITEM* item = (CLDS_SORTED_LIST_ITEM*)0x4242;
+    int result;
+    CLDS_SORTED_LIST_HEAD_INIT(&list_head);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_sorted_list_head_get_first(list, &list_head, hazard_pointers_thread, &item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(item);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_148: [ Otherwise clds_sorted_list_head_get_first shall set item to the first item linked to list_head, with its reference count incremented so that it can be safely used by the caller, and return 0. ]*/
+TEST_FUNCTION(clds_sorted_list_head_get_first_returns_the_item_with_the_lowest_key)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_HEAD list_head;
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item;
+    int result;
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1)->key = 0x43;
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2)->key = 0x42;
+    CLDS_SORTED_LIST_HEAD_INIT(&list_head);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_OK, clds_sorted_list_head_insert(list, &list_head, hazard_pointers_thread, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_OK, clds_sorted_list_head_insert(list, &list_head, hazard_pointers_thread, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_2));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_sorted_list_head_get_first(list, &list_head, hazard_pointers_thread, &item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, item);
+
+    // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item);
+    clds_sorted_list_head_clear(list, &list_head);
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_sorted_list_head_get_next */
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_155: [ If key is NULL, clds_sorted_list_head_get_next shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(clds_sorted_list_head_get_next_with_NULL_key_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_HEAD list_head;
+    CLDS_SORTED_LIST_ITEM* item;
+    int result;
+    CLDS_SORTED_LIST_HEAD_INIT(&list_head);
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_sorted_list_head_get_next(list, &list_head, hazard_pointers_thread, NULL, &item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_157: [ If no item linked to list_head has a key greater than key, clds_sorted_list_head_get_next shall set item to NULL and return 0. ]*/
+TEST_FUNCTION(clds_sorted_list_head_get_next_after_the_last_key_yields_NULL)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_HEAD list_head;
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item = (CLDS_SORTED_LIST_ITEM*)0x4242;
+    int result;
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1)->key = 0x42;
+    CLDS_SORTED_LIST_HEAD_INIT(&list_head);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_OK, clds_sorted_list_head_insert(list, &list_head, hazard_pointers_thread, item_1, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = clds_sorted_list_head_get_next(list, &list_head, hazard_pointers_thread, (void*)0x42, &item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(item);
+
+    // cleanup
+    clds_sorted_list_head_clear(list, &list_head);
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_159: [ Otherwise clds_sorted_list_head_get_next shall set item to the first item linked to list_head whose key is greater than key, with its reference count incremented so that it can be safely used by the caller, and return 0. ]*/
+TEST_FUNCTION(clds_sorted_list_head_get_next_returns_the_item_after_the_key)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_HEAD list_head;
+    CLDS_SORTED_LIST_ITEM* item_1 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item_2 = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_ITEM* item;
+    int result;
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_1)->key = 0x42;
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item_2)->key = 0x44;
+    CLDS_SORTED_LIST_HEAD_INIT(&list_head);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_OK, clds_sorted_list_head_insert(list, &list_head, hazard_pointers_thread, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_OK, clds_sorted_list_head_insert(list, &list_head, hazard_pointers_thread, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_2));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    // the key does not have to be in the list
+    result = clds_sorted_list_head_get_next(list, &list_head, hazard_pointers_thread, (void*)0x43, &item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, item);
+
+    // cleanup
+    CLDS_SORTED_LIST_NODE_RELEASE(TEST_ITEM, item);
+    clds_sorted_list_head_clear(list, &list_head);
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_sorted_list_head_clear */
+
+/* Tests_SRS_CLDS_SORTED_LIST_01_151: [ Otherwise clds_sorted_list_head_clear shall free all the items linked to list_head, calling the item_cleanup_callback of each of them, and leave list_head empty. ]*/
+TEST_FUNCTION(clds_sorted_list_head_clear_frees_the_items_linked_to_the_head)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SORTED_LIST_HANDLE list = clds_sorted_list_create(hazard_pointers, test_get_item_key, (void*)0x4242, test_key_compare, (void*)0x4243, NULL, NULL, NULL);
+    CLDS_SORTED_LIST_HEAD list_head;
+    CLDS_SORTED_LIST_ITEM* item = CLDS_SORTED_LIST_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_SORTED_LIST_GET_VALUE(TEST_ITEM, item)->key = 0x42;
+    CLDS_SORTED_LIST_HEAD_INIT(&list_head);
+    ASSERT_ARE_EQUAL(CLDS_SORTED_LIST_INSERT_RESULT, CLDS_SORTED_LIST_INSERT_OK, clds_sorted_list_head_insert(list, &list_head, hazard_pointers_thread, item, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
+    STRICT_EXPECTED_CALL(free(item));
+
+    // act
+    clds_sorted_list_head_clear(list, &list_head);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_TRUE(CLDS_SORTED_LIST_HEAD_IS_EMPTY(&list_head));
+
+    // cleanup
+    clds_sorted_list_destroy(list);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
 END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
@@ -0,0 +1,1105 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdbool.h>
+#include <inttypes.h>
+#include <stdlib.h>
+
+#include "macro_utils/macro_utils.h"
+#include "testrunnerswitcher.h"
+
+#include "real_gballoc_ll.h"
+
+#include "umock_c/umock_c.h"
+#include "umock_c/umocktypes_stdint.h"
+#include "umock_c/umocktypes_bool.h"
+#include "umock_c/umock_c_negative_tests.h"
+
+#include "c_pal/interlocked.h"
+
+#define ENABLE_MOCKS
+
+#include "c_pal/gballoc_hl.h"
+#include "c_pal/gballoc_hl_redirect.h"
+
+#include "clds/clds_hazard_pointers.h"
+
+#undef ENABLE_MOCKS
+
+#include "real_gballoc_hl.h"
+
+#include "../reals/real_clds_hazard_pointers.h"
+
+#include "clds/clds_split_ordered_hash_table.h"
+
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_CONDITION_CHECK_RESULT, CLDS_CONDITION_CHECK_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_CONDITION_CHECK_RESULT, CLDS_CONDITION_CHECK_RESULT_VALUES);
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%" PRI_MU_ENUM "", MU_ENUM_VALUE(UMOCK_C_ERROR_CODE, error_code));
+}
+
+MOCK_FUNCTION_WITH_CODE(, void, test_item_cleanup_func, void*, context, struct CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM_TAG*, item)
+MOCK_FUNCTION_END()
+
+MOCK_FUNCTION_WITH_CODE(, uint64_t, test_compute_hash, void*, key)
+    (void)key;
+MOCK_FUNCTION_END((uint64_t)key)
+
+MOCK_FUNCTION_WITH_CODE(, void, test_skipped_seq_no_cb, void*, context, int64_t, skipped_seq_no)
+MOCK_FUNCTION_END()
+
+static CLDS_CONDITION_CHECK_RESULT g_condition_check_result = CLDS_CONDITION_CHECK_OK;
+MOCK_FUNCTION_WITH_CODE(, CLDS_CONDITION_CHECK_RESULT, test_item_condition_check, void*, context, void*, new_key, void*, old_key)
+MOCK_FUNCTION_END(g_condition_check_result)
+
+static int test_key_compare_func(void* key_1, void* key_2)
+{
+    int result;
+    if (key_1 < key_2)
+    {
+        result = -1;
+    }
+    else if (key_1 > key_2)
+    {
+        result = 1;
+    }
+    else
+    {
+        result = 0;
+    }
+
+    return result;
+}
+
+typedef struct TEST_ITEM_TAG
+{
+    int dummy;
+} TEST_ITEM;
+
+DECLARE_SPLIT_ORDERED_HASH_TABLE_NODE_TYPE(TEST_ITEM)
+
+BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    ASSERT_ARE_EQUAL(int, 0, real_gballoc_hl_init(NULL, NULL));
+
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init(on_umock_c_error), "umock_c_init failed");
+
+    ASSERT_ARE_EQUAL(int, 0, umocktypes_stdint_register_types(), "umocktypes_stdint_register_types failed");
+    ASSERT_ARE_EQUAL(int, 0, umocktypes_bool_register_types(), "umocktypes_bool_register_types failed");
+
+    REGISTER_CLDS_HAZARD_POINTERS_GLOBAL_MOCK_HOOKS();
+
+    REGISTER_GBALLOC_HL_GLOBAL_MOCK_HOOK();
+
+    REGISTER_UMOCK_ALIAS_TYPE(RECLAIM_FUNC, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTER_RECORD_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_THREAD_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CONDITION_CHECK_CB, void*);
+
+    REGISTER_TYPE(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_RESULT);
+    REGISTER_TYPE(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_RESULT);
+    REGISTER_TYPE(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_RESULT);
+    REGISTER_TYPE(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_RESULT);
+    REGISTER_TYPE(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_RESULT);
+    REGISTER_TYPE(CLDS_CONDITION_CHECK_RESULT, CLDS_CONDITION_CHECK_RESULT);
+
+    ASSERT_ARE_EQUAL(int, 0, umock_c_negative_tests_init());
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_negative_tests_deinit();
+    umock_c_deinit();
+
+    real_gballoc_hl_deinit();
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+    g_condition_check_result = CLDS_CONDITION_CHECK_OK;
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+}
+
+/* clds_split_ordered_hash_table_create */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_001: [ clds_split_ordered_hash_table_create shall create a new hash table object and on success it shall return a non-NULL handle to the newly created hash table. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_011: [ The bucket slots shall be allocated in segments, each segment being allocated when one of its buckets is used for the first time. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_create_succeeds)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table;
+    volatile_atomic int64_t sequence_number = 55;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_cb, (void*)0x5556);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_006: [ start_sequence_number shall be allowed to be NULL, in which case no sequence number computations shall be performed. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_007: [ skipped_seq_no_cb and skipped_seq_no_cb_context shall be allowed to be NULL. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_create_succeeds_with_NULL_sequence_number_and_skipped_seq_no_cb)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_010: [ The initial bucket count shall be initial_bucket_size rounded up to a power of 2. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_create_rounds_up_the_bucket_count_to_a_power_of_2)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(8, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 5, hazard_pointers, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(hash_table);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_002: [ If compute_hash is NULL, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_create_with_NULL_compute_hash_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table;
+    umock_c_reset_all_calls();
+
+    // act
+    hash_table = clds_split_ordered_hash_table_create(NULL, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_003: [ If key_compare_func is NULL, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_create_with_NULL_key_compare_func_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table;
+    umock_c_reset_all_calls();
+
+    // act
+    hash_table = clds_split_ordered_hash_table_create(test_compute_hash, NULL, 1, hazard_pointers, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_004: [ If initial_bucket_size is 0 or greater than 2^30, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_create_with_initial_bucket_size_0_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table;
+    umock_c_reset_all_calls();
+
+    // act
+    hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 0, hazard_pointers, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_004: [ If initial_bucket_size is 0 or greater than 2^30, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_create_with_initial_bucket_size_too_big_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table;
+    umock_c_reset_all_calls();
+
+    // act
+    hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, ((size_t)1 << 30) + 1, hazard_pointers, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_005: [ If clds_hazard_pointers is NULL, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_create_with_NULL_clds_hazard_pointers_fails)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table;
+
+    // act
+    hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, NULL, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(hash_table);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_008: [ If start_sequence_number is NULL, then skipped_seq_no_cb must also be NULL, otherwise clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_create_with_NULL_sequence_number_and_non_NULL_skipped_seq_no_cb_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table;
+    umock_c_reset_all_calls();
+
+    // act
+    hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, test_skipped_seq_no_cb, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(hash_table);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_009: [ If any error happens, clds_split_ordered_hash_table_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_underlying_calls_fail_clds_split_ordered_hash_table_create_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table;
+    size_t i;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc_2(1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    umock_c_negative_tests_snapshot();
+
+    for (i = 0; i < umock_c_negative_tests_call_count(); i++)
+    {
+        if (umock_c_negative_tests_can_call_fail(i))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(i);
+
+            // act
+            hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+
+            // assert
+            ASSERT_IS_NULL(hash_table, "On failed call %zu", i);
+        }
+    }
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_split_ordered_hash_table_destroy */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_017: [ clds_split_ordered_hash_table_destroy shall release the items in the table and free all resources associated with the hash table instance. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_destroy_frees_the_resources)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    clds_split_ordered_hash_table_destroy(hash_table);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_017: [ clds_split_ordered_hash_table_destroy shall release the items in the table and free all resources associated with the hash table instance. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_destroy_releases_the_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_split_ordered_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
+    STRICT_EXPECTED_CALL(free(item));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    clds_split_ordered_hash_table_destroy(hash_table);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_018: [ If clds_split_ordered_hash_table is NULL, clds_split_ordered_hash_table_destroy shall return. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_destroy_with_NULL_returns)
+{
+    // arrange
+
+    // act
+    clds_split_ordered_hash_table_destroy(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* clds_split_ordered_hash_table_insert */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_022: [ clds_split_ordered_hash_table_insert shall hash the key by calling the compute_hash function passed to clds_split_ordered_hash_table_create. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_023: [ clds_split_ordered_hash_table_insert shall insert value in the list after the dummy node of the bucket of the key, at the position given by the bit reversed hash of the key and then by the key. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_insert_inserts_one_key_value_pair)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+
+    // act
+    result = clds_split_ordered_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_016: [ start_sequence_number shall be used as the sequence number variable that shall be incremented at every operation that is done on the hash table. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_insert_returns_the_sequence_number)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    volatile_atomic int64_t sequence_number;
+    (void)interlocked_exchange_64(&sequence_number, 42);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, &sequence_number, test_skipped_seq_no_cb, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item_1 = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item_2 = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    int64_t insert_seq_no_1;
+    int64_t insert_seq_no_2;
+    umock_c_reset_all_calls();
+
+    // act
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_split_ordered_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, &insert_seq_no_1));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_split_ordered_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x2, item_2, &insert_seq_no_2));
+
+    // assert
+    ASSERT_ARE_EQUAL(int64_t, 43, insert_seq_no_1);
+    ASSERT_ARE_EQUAL(int64_t, 44, insert_seq_no_2);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_019: [ If clds_split_ordered_hash_table is NULL, clds_split_ordered_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_insert_with_NULL_hash_table_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_split_ordered_hash_table_insert(NULL, hazard_pointers_thread, (void*)0x1, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_020: [ If clds_hazard_pointers_thread, key or value is NULL, clds_split_ordered_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_insert_with_NULL_arguments_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_INSERT_RESULT result_1 = clds_split_ordered_hash_table_insert(hash_table, NULL, (void*)0x1, item, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result_2 = clds_split_ordered_hash_table_insert(hash_table, hazard_pointers_thread, NULL, item, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result_3 = clds_split_ordered_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result_1);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result_2);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result_3);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_021: [ If the sequence_number argument is non-NULL, but no start sequence number was specified in clds_split_ordered_hash_table_create, clds_split_ordered_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_insert_with_non_NULL_sequence_number_and_no_start_sequence_number_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    int64_t sequence_number;
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_split_ordered_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, &sequence_number);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_025: [ If the key already exists in the hash table, clds_split_ordered_hash_table_insert shall fail and return CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_insert_with_the_same_key_2_times_returns_KEY_ALREADY_EXISTS)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item_1 = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item_2 = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_split_ordered_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_split_ordered_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_2, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS, result);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_012: [ When a bucket is used for the first time, a dummy node for the bucket shall be inserted in the list, starting at the dummy node of the bucket it was split from (initializing that bucket first if needed). ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_013: [ The bucket of a key shall be the hash of the key modulo the current bucket count. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_024: [ If after the insert there are on average more than 2 items in a bucket, clds_split_ordered_hash_table_insert shall double the bucket count with one compare exchange, without moving any item. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_items_can_be_found_after_the_table_grows)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    uintptr_t i;
+    umock_c_reset_all_calls();
+
+    // act
+    for (i = 1; i <= 100; i++)
+    {
+        CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_split_ordered_hash_table_insert(hash_table, hazard_pointers_thread, (void*)i, item, NULL));
+    }
+
+    // assert
+    for (i = 1; i <= 100; i++)
+    {
+        CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* found_item = clds_split_ordered_hash_table_find(hash_table, hazard_pointers_thread, (void*)i);
+        ASSERT_IS_NOT_NULL(found_item);
+        ASSERT_ARE_EQUAL(void_ptr, (void*)i, found_item->key);
+        CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+    }
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_split_ordered_hash_table_delete */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_029: [ clds_split_ordered_hash_table_delete shall mark the item with the given key as deleted, unlink it from the list and on success return CLDS_HASH_TABLE_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_015: [ The node that unlinks a deleted item from the list shall retire it by calling clds_hazard_pointers_retire. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_delete_deletes_the_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_split_ordered_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(item));
+
+    // act
+    result = clds_split_ordered_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x1, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_IS_NULL(clds_split_ordered_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1));
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_030: [ If the key is not found, clds_split_ordered_hash_table_delete shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_delete_with_a_key_that_is_not_in_the_table_returns_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_split_ordered_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_split_ordered_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x2, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_NOT_FOUND, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_027: [ If clds_split_ordered_hash_table, clds_hazard_pointers_thread or key is NULL, clds_split_ordered_hash_table_delete shall fail and return CLDS_HASH_TABLE_DELETE_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_delete_with_NULL_arguments_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_DELETE_RESULT result_1 = clds_split_ordered_hash_table_delete(NULL, hazard_pointers_thread, (void*)0x1, NULL);
+    CLDS_HASH_TABLE_DELETE_RESULT result_2 = clds_split_ordered_hash_table_delete(hash_table, NULL, (void*)0x1, NULL);
+    CLDS_HASH_TABLE_DELETE_RESULT result_3 = clds_split_ordered_hash_table_delete(hash_table, hazard_pointers_thread, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result_1);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result_2);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_ERROR, result_3);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_split_ordered_hash_table_delete_key_value */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_034: [ clds_split_ordered_hash_table_delete_key_value shall delete the item with the given key only if the item in the table is value and on success return CLDS_HASH_TABLE_DELETE_OK. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_035: [ If the key is not found or the item with the key is not value, clds_split_ordered_hash_table_delete_key_value shall return CLDS_HASH_TABLE_DELETE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_delete_key_value_deletes_only_the_matching_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* other_item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_split_ordered_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_DELETE_RESULT result_1 = clds_split_ordered_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, other_item, NULL);
+    CLDS_HASH_TABLE_DELETE_RESULT result_2 = clds_split_ordered_hash_table_delete_key_value(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_NOT_FOUND, result_1);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result_2);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, other_item);
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_split_ordered_hash_table_remove */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_039: [ clds_split_ordered_hash_table_remove shall delete the item with the given key, return it with its reference count incremented in item and on success return CLDS_HASH_TABLE_REMOVE_OK. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_remove_removes_the_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* removed_item;
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_split_ordered_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_split_ordered_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, item, removed_item);
+    ASSERT_IS_NULL(clds_split_ordered_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1));
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, removed_item);
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_040: [ If the key is not found, clds_split_ordered_hash_table_remove shall return CLDS_HASH_TABLE_REMOVE_NOT_FOUND. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_remove_with_a_key_that_is_not_in_the_table_returns_NOT_FOUND)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* removed_item;
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_split_ordered_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, &removed_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_NOT_FOUND, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_037: [ If clds_split_ordered_hash_table, clds_hazard_pointers_thread, key or item is NULL, clds_split_ordered_hash_table_remove shall fail and return CLDS_HASH_TABLE_REMOVE_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_remove_with_NULL_item_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_HASH_TABLE_REMOVE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_split_ordered_hash_table_remove(hash_table, hazard_pointers_thread, (void*)0x1, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_ERROR, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_split_ordered_hash_table_set_value */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_044: [ If the key is not in the table, clds_split_ordered_hash_table_set_value shall insert new_item, set old_item to NULL and return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_set_value_with_a_new_key_inserts_the_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* old_item = (CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM*)0x4242;
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* found_item;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_split_ordered_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL, NULL, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+    ASSERT_IS_NULL(old_item);
+    found_item = clds_split_ordered_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
+    ASSERT_ARE_EQUAL(void_ptr, item, found_item);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_045: [ If the key is in the table, clds_split_ordered_hash_table_set_value shall replace the item with new_item in one compare exchange, return the previous item with its reference count incremented in old_item and return CLDS_HASH_TABLE_SET_VALUE_OK. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_046: [ If condition_check_func is not NULL, it shall be called with condition_check_context, the key of new_item and the key of the item in the table. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_set_value_with_an_existing_key_replaces_the_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item_1 = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item_2 = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* old_item;
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* found_item;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_split_ordered_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+    STRICT_EXPECTED_CALL(test_item_condition_check((void*)0x42, (void*)0x1, (void*)0x1));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_retire(hazard_pointers_thread, item_1, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    result = clds_split_ordered_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item_2, test_item_condition_check, (void*)0x42, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_OK, result);
+    ASSERT_ARE_EQUAL(void_ptr, item_1, old_item);
+    found_item = clds_split_ordered_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
+    ASSERT_ARE_EQUAL(void_ptr, item_2, found_item);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, found_item);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, old_item);
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_047: [ If condition_check_func returns CLDS_CONDITION_CHECK_NOT_MET, clds_split_ordered_hash_table_set_value shall return CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_set_value_when_the_condition_is_not_met_returns_CONDITION_NOT_MET)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item_1 = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item_2 = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* old_item;
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_split_ordered_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item_1, NULL));
+    g_condition_check_result = CLDS_CONDITION_CHECK_NOT_MET;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_split_ordered_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item_2, test_item_condition_check, (void*)0x42, &old_item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_CONDITION_NOT_MET, result);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item_2);
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_042: [ If clds_split_ordered_hash_table, clds_hazard_pointers_thread, key, new_item or old_item is NULL, clds_split_ordered_hash_table_set_value shall fail and return CLDS_HASH_TABLE_SET_VALUE_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_set_value_with_NULL_old_item_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_HASH_TABLE_SET_VALUE_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_split_ordered_hash_table_set_value(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SET_VALUE_RESULT, CLDS_HASH_TABLE_SET_VALUE_ERROR, result);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_split_ordered_hash_table_find */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_051: [ clds_split_ordered_hash_table_find shall look up the key starting at the dummy node of its bucket and return the item with its reference count incremented. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_find_returns_the_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_split_ordered_hash_table_insert(hash_table, hazard_pointers_thread, (void*)0x1, item, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(IGNORED_ARG, IGNORED_ARG)).IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_compute_hash((void*)0x1));
+
+    // act
+    result = clds_split_ordered_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, item, result);
+
+    // cleanup
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, result);
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_052: [ If the key is not found, clds_split_ordered_hash_table_find shall return NULL. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_find_with_a_key_that_is_not_in_the_table_returns_NULL)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_split_ordered_hash_table_find(hash_table, hazard_pointers_thread, (void*)0x1);
+
+    // assert
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_050: [ If clds_split_ordered_hash_table, clds_hazard_pointers_thread or key is NULL, clds_split_ordered_hash_table_find shall fail and return NULL. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_find_with_NULL_hash_table_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_split_ordered_hash_table_find(NULL, hazard_pointers_thread, (void*)0x1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_split_ordered_hash_table_snapshot */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_062: [ If there are no items, clds_split_ordered_hash_table_snapshot shall set items to NULL and item_count to 0 and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_snapshot_with_empty_table_returns_no_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** items = (CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM**)0x4242;
+    uint64_t item_count = 42;
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_split_ordered_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_IS_NULL(items);
+    ASSERT_ARE_EQUAL(uint64_t, 0, item_count);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_063: [ clds_split_ordered_hash_table_snapshot shall allocate an array of CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* and fill it with the items in the list. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_064: [ clds_split_ordered_hash_table_snapshot shall increment the reference count of each item it returns. ]*/
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_065: [ clds_split_ordered_hash_table_snapshot shall store the allocated array of items in items and the count in item_count and return CLDS_HASH_TABLE_SNAPSHOT_OK. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_snapshot_returns_all_the_items)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM** items;
+    uint64_t item_count;
+    uint64_t i;
+    uintptr_t key;
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result;
+    for (key = 1; key <= 10; key++)
+    {
+        CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, NULL, NULL);
+        ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, clds_split_ordered_hash_table_insert(hash_table, hazard_pointers_thread, (void*)key, item, NULL));
+    }
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, clds_split_ordered_hash_table_delete(hash_table, hazard_pointers_thread, (void*)0x5, NULL));
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_split_ordered_hash_table_snapshot(hash_table, hazard_pointers_thread, &items, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_OK, result);
+    ASSERT_ARE_EQUAL(uint64_t, 9, item_count);
+    for (i = 0; i < item_count; i++)
+    {
+        ASSERT_ARE_NOT_EQUAL(void_ptr, (void*)0x5, items[i]->key);
+    }
+
+    // cleanup
+    for (i = 0; i < item_count; i++)
+    {
+        CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, items[i]);
+    }
+    free(items);
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_060: [ If clds_split_ordered_hash_table, clds_hazard_pointers_thread, items or item_count is NULL, clds_split_ordered_hash_table_snapshot shall fail and return CLDS_HASH_TABLE_SNAPSHOT_ERROR. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_snapshot_with_NULL_items_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    CLDS_SPLIT_ORDERED_HASH_TABLE_HANDLE hash_table = clds_split_ordered_hash_table_create(test_compute_hash, test_key_compare_func, 1, hazard_pointers, NULL, NULL, NULL);
+    uint64_t item_count;
+    CLDS_HASH_TABLE_SNAPSHOT_RESULT result;
+    umock_c_reset_all_calls();
+
+    // act
+    result = clds_split_ordered_hash_table_snapshot(hash_table, hazard_pointers_thread, NULL, &item_count);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_SNAPSHOT_RESULT, CLDS_HASH_TABLE_SNAPSHOT_ERROR, result);
+
+    // cleanup
+    clds_split_ordered_hash_table_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* clds_split_ordered_hash_table_node_release */
+
+/* Tests_SRS_CLDS_SPLIT_ORDERED_HASH_TABLE_01_071: [ When the reference count of an item reaches 0, item_cleanup_callback shall be called (if not NULL) and the item shall be freed. ]*/
+TEST_FUNCTION(clds_split_ordered_hash_table_node_release_calls_the_cleanup_callback)
+{
+    // arrange
+    CLDS_SPLIT_ORDERED_HASH_TABLE_ITEM* item = CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_CREATE(TEST_ITEM, test_item_cleanup_func, (void*)0x4242);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
+    STRICT_EXPECTED_CALL(free(item));
+
+    // act
+    CLDS_SPLIT_ORDERED_HASH_TABLE_NODE_RELEASE(TEST_ITEM, item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
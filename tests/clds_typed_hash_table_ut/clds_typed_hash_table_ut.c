@@ -0,0 +1,633 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdbool.h>
+#include <inttypes.h>
+#include <stdlib.h>
+
+#include "macro_utils/macro_utils.h"
+#include "testrunnerswitcher.h"
+
+#include "real_gballoc_ll.h"
+
+#include "umock_c/umock_c.h"
+#include "umock_c/umocktypes_stdint.h"
+#include "umock_c/umocktypes_bool.h"
+#include "umock_c/umock_c_negative_tests.h"
+
+#include "c_logging/logger.h"
+#include "c_pal/interlocked.h"
+#include "c_pal/sync.h"
+
+#define ENABLE_MOCKS
+
+#include "c_pal/gballoc_hl.h"
+#include "c_pal/gballoc_hl_redirect.h"
+
+#include "clds/clds_hazard_pointers.h"
+
+#undef ENABLE_MOCKS
+
+#include "real_gballoc_hl.h"
+
+#include "../reals/real_clds_hazard_pointers.h"
+
+#include "clds/clds_typed_hash_table.h"
+
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_RESULT_VALUES);
+TEST_DEFINE_ENUM_TYPE(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_RESULT_VALUES);
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%" PRI_MU_ENUM "", MU_ENUM_VALUE(UMOCK_C_ERROR_CODE, error_code));
+}
+
+typedef struct TEST_KEY_TAG
+{
+    uint64_t hash;
+    uint32_t id;
+} TEST_KEY;
+
+DECLARE_CLDS_HASH_TABLE_TYPE(TEST_TABLE, TEST_KEY)
+
+// the tests pick the hash of a key, so that they can place keys in groups and make hashes collide
+MOCK_FUNCTION_WITH_CODE(, uint64_t, test_hash_fn, const TEST_KEY*, key)
+MOCK_FUNCTION_END(key->hash)
+
+MOCK_FUNCTION_WITH_CODE(, bool, test_eq_fn, const TEST_KEY*, key_1, const TEST_KEY*, key_2)
+MOCK_FUNCTION_END((key_1->hash == key_2->hash) && (key_1->id == key_2->id))
+
+DEFINE_CLDS_HASH_TABLE_TYPE(TEST_TABLE, TEST_KEY, test_hash_fn, test_eq_fn)
+
+// a second table type, with a scalar key and the static inline hash and compare functions that a user of the header would write
+DECLARE_CLDS_HASH_TABLE_TYPE(UINT64_TABLE, uint64_t)
+
+static inline uint64_t uint64_hash_fn(const uint64_t* key)
+{
+    return *key;
+}
+
+static inline bool uint64_eq_fn(const uint64_t* key_1, const uint64_t* key_2)
+{
+    return *key_1 == *key_2;
+}
+
+DEFINE_CLDS_HASH_TABLE_TYPE(UINT64_TABLE, uint64_t, uint64_hash_fn, uint64_eq_fn)
+
+MOCK_FUNCTION_WITH_CODE(, void, test_item_cleanup_func, void*, context, TEST_TABLE_ITEM*, item)
+MOCK_FUNCTION_END()
+
+typedef struct TEST_ITEM_TAG
+{
+    int dummy;
+} TEST_ITEM;
+
+DECLARE_CLDS_HASH_TABLE_TYPE_NODE_TYPE(TEST_TABLE, TEST_ITEM)
+DECLARE_CLDS_HASH_TABLE_TYPE_NODE_TYPE(UINT64_TABLE, TEST_ITEM)
+
+static TEST_TABLE_ITEM* create_test_item(uint64_t hash, uint32_t id)
+{
+    TEST_KEY key = { hash, id };
+    TEST_TABLE_ITEM* result = CLDS_HASH_TABLE_TYPE_NODE_CREATE(TEST_TABLE, TEST_ITEM, &key, NULL, NULL);
+    ASSERT_IS_NOT_NULL(result);
+    return result;
+}
+
+BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    ASSERT_ARE_EQUAL(int, 0, real_gballoc_hl_init(NULL, NULL));
+
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init(on_umock_c_error), "umock_c_init failed");
+
+    ASSERT_ARE_EQUAL(int, 0, umocktypes_stdint_register_types(), "umocktypes_stdint_register_types failed");
+    ASSERT_ARE_EQUAL(int, 0, umocktypes_bool_register_types(), "umocktypes_bool_register_types failed");
+
+    REGISTER_CLDS_HAZARD_POINTERS_GLOBAL_MOCK_HOOKS();
+
+    REGISTER_GBALLOC_HL_GLOBAL_MOCK_HOOK();
+
+    REGISTER_UMOCK_ALIAS_TYPE(RECLAIM_FUNC, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTER_RECORD_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(CLDS_HAZARD_POINTERS_THREAD_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(const TEST_KEY*, void*);
+
+    REGISTER_TYPE(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_RESULT);
+    REGISTER_TYPE(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_RESULT);
+    REGISTER_TYPE(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_RESULT);
+
+    ASSERT_ARE_EQUAL(int, 0, umock_c_negative_tests_init());
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_negative_tests_deinit();
+    umock_c_deinit();
+
+    real_gballoc_hl_deinit();
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+}
+
+/* DECLARE_CLDS_HASH_TABLE_TYPE */
+
+/* Tests_SRS_CLDS_TYPED_HASH_TABLE_01_045: [ DECLARE_CLDS_HASH_TABLE_TYPE(name, key_type) shall declare the types name_ITEM_CLEANUP_CB, name_ITEM and name_HANDLE and the functions of the table name, without defining them. ]*/
+TEST_FUNCTION(DECLARE_CLDS_HASH_TABLE_TYPE_stores_the_key_in_the_item)
+{
+    // arrange
+    TEST_KEY key = { 0x42, 43 };
+    TEST_TABLE_ITEM* item = CLDS_HASH_TABLE_TYPE_NODE_CREATE(TEST_TABLE, TEST_ITEM, &key, NULL, NULL);
+    ASSERT_IS_NOT_NULL(item);
+
+    // act
+    key.id = 44;
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, sizeof(TEST_KEY), sizeof(item->key));
+    ASSERT_ARE_EQUAL(size_t, sizeof(uint64_t), sizeof(((UINT64_TABLE_ITEM*)NULL)->key));
+    ASSERT_ARE_EQUAL(uint64_t, 0x42, item->key.hash);
+    ASSERT_ARE_EQUAL(uint32_t, 43, item->key.id);
+
+    // cleanup
+    CLDS_HASH_TABLE_TYPE_NODE_RELEASE(TEST_TABLE, item);
+}
+
+/* DEFINE_CLDS_HASH_TABLE_TYPE */
+
+/* Tests_SRS_CLDS_TYPED_HASH_TABLE_01_046: [ DEFINE_CLDS_HASH_TABLE_TYPE(name, key_type, hash_fn, eq_fn) shall define the functions declared by DECLARE_CLDS_HASH_TABLE_TYPE(name, key_type), with external linkage. ]*/
+/* Tests_SRS_CLDS_TYPED_HASH_TABLE_01_047: [ Apart from what the requirements below specify, name_create, name_destroy, name_insert, name_delete, name_remove and name_find shall behave as clds_open_addressing_hash_table_create, clds_open_addressing_hash_table_destroy, clds_open_addressing_hash_table_insert, clds_open_addressing_hash_table_delete, clds_open_addressing_hash_table_remove and clds_open_addressing_hash_table_find, with hash_fn and eq_fn in place of compute_hash and key_compare_func. ]*/
+TEST_FUNCTION(TEST_TABLE_and_UINT64_TABLE_defined_in_the_same_file_are_independent)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    volatile_atomic int64_t sequence_number;
+    (void)interlocked_exchange_64(&sequence_number, 42);
+    TEST_TABLE_HANDLE test_table = TEST_TABLE_create(16, hazard_pointers, &sequence_number);
+    UINT64_TABLE_HANDLE uint64_table = UINT64_TABLE_create(16, hazard_pointers, &sequence_number);
+    TEST_KEY test_key = { 0x1, 1 };
+    uint64_t uint64_key = 0x1;
+    TEST_TABLE_ITEM* test_item = create_test_item(0x1, 1);
+    UINT64_TABLE_ITEM* uint64_item = CLDS_HASH_TABLE_TYPE_NODE_CREATE(UINT64_TABLE, TEST_ITEM, &uint64_key, NULL, NULL);
+    UINT64_TABLE_ITEM* removed_item;
+    TEST_TABLE_ITEM* found_test_item;
+    UINT64_TABLE_ITEM* found_uint64_item;
+    int64_t insert_seq_no_1;
+    int64_t insert_seq_no_2;
+    int64_t remove_seq_no;
+    ASSERT_IS_NOT_NULL(test_table);
+    ASSERT_IS_NOT_NULL(uint64_table);
+    ASSERT_IS_NOT_NULL(uint64_item);
+
+    // act
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, TEST_TABLE_insert(test_table, hazard_pointers_thread, test_item, &insert_seq_no_1));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, UINT64_TABLE_insert(uint64_table, hazard_pointers_thread, uint64_item, &insert_seq_no_2));
+    found_test_item = TEST_TABLE_find(test_table, hazard_pointers_thread, &test_key);
+    found_uint64_item = UINT64_TABLE_find(uint64_table, hazard_pointers_thread, &uint64_key);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_REMOVE_RESULT, CLDS_HASH_TABLE_REMOVE_OK, UINT64_TABLE_remove(uint64_table, hazard_pointers_thread, &uint64_key, &removed_item, &remove_seq_no));
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, test_item, found_test_item);
+    ASSERT_ARE_EQUAL(void_ptr, uint64_item, found_uint64_item);
+    ASSERT_ARE_EQUAL(void_ptr, uint64_item, removed_item);
+    ASSERT_ARE_EQUAL(int64_t, 43, insert_seq_no_1);
+    ASSERT_ARE_EQUAL(int64_t, 44, insert_seq_no_2);
+    ASSERT_ARE_EQUAL(int64_t, 45, remove_seq_no);
+    ASSERT_IS_NULL(UINT64_TABLE_find(uint64_table, hazard_pointers_thread, &uint64_key));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, TEST_TABLE_delete(test_table, hazard_pointers_thread, &test_key, NULL));
+
+    // cleanup
+    CLDS_HASH_TABLE_TYPE_NODE_RELEASE(TEST_TABLE, found_test_item);
+    CLDS_HASH_TABLE_TYPE_NODE_RELEASE(UINT64_TABLE, found_uint64_item);
+    CLDS_HASH_TABLE_TYPE_NODE_RELEASE(UINT64_TABLE, removed_item);
+    UINT64_TABLE_destroy(uint64_table);
+    TEST_TABLE_destroy(test_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* TEST_TABLE_insert */
+
+/* Tests_SRS_CLDS_TYPED_HASH_TABLE_01_013: [ name_insert shall hash the key stored in value by calling hash_fn. ]*/
+TEST_FUNCTION(TEST_TABLE_insert_hashes_the_key_with_hash_fn)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    TEST_TABLE_HANDLE hash_table = TEST_TABLE_create(16, hazard_pointers, NULL);
+    TEST_TABLE_ITEM* item = create_test_item(0x42, 1);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_hash_fn(&item->key));
+
+    // act
+    result = TEST_TABLE_insert(hash_table, hazard_pointers_thread, item, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+    ASSERT_ARE_EQUAL(uint64_t, 0x42, item->hash);
+
+    // cleanup
+    TEST_TABLE_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_TYPED_HASH_TABLE_01_011: [ If hash_table, clds_hazard_pointers_thread or value is NULL, name_insert shall fail and return CLDS_HASH_TABLE_INSERT_ERROR. ]*/
+TEST_FUNCTION(TEST_TABLE_insert_with_NULL_arguments_fails)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    TEST_TABLE_HANDLE hash_table = TEST_TABLE_create(16, hazard_pointers, NULL);
+    TEST_TABLE_ITEM* item = create_test_item(0x1, 1);
+    umock_c_reset_all_calls();
+
+    // act
+    CLDS_HASH_TABLE_INSERT_RESULT result_1 = TEST_TABLE_insert(NULL, hazard_pointers_thread, item, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result_2 = TEST_TABLE_insert(hash_table, NULL, item, NULL);
+    CLDS_HASH_TABLE_INSERT_RESULT result_3 = TEST_TABLE_insert(hash_table, hazard_pointers_thread, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result_1);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result_2);
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_ERROR, result_3);
+
+    // cleanup
+    CLDS_HASH_TABLE_TYPE_NODE_RELEASE(TEST_TABLE, item);
+    TEST_TABLE_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_TYPED_HASH_TABLE_01_016: [ If a slot holds an item whose key is equal to the key of value according to eq_fn, name_insert shall fail and return CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+TEST_FUNCTION(TEST_TABLE_insert_with_a_key_equal_according_to_eq_fn_returns_KEY_ALREADY_EXISTS)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    TEST_TABLE_HANDLE hash_table = TEST_TABLE_create(16, hazard_pointers, NULL);
+    TEST_TABLE_ITEM* item_1 = create_test_item(0x1, 1);
+    TEST_TABLE_ITEM* item_2 = create_test_item(0x1, 1);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, TEST_TABLE_insert(hash_table, hazard_pointers_thread, item_1, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_hash_fn(&item_2->key));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_1));
+    STRICT_EXPECTED_CALL(test_eq_fn(&item_1->key, &item_2->key));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = TEST_TABLE_insert(hash_table, hazard_pointers_thread, item_2, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_TYPE_NODE_RELEASE(TEST_TABLE, item_2);
+    TEST_TABLE_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_TYPED_HASH_TABLE_01_016: [ If a slot holds an item whose key is equal to the key of value according to eq_fn, name_insert shall fail and return CLDS_HASH_TABLE_INSERT_KEY_ALREADY_EXISTS. ]*/
+TEST_FUNCTION(TEST_TABLE_insert_with_a_key_not_equal_according_to_eq_fn_inserts_the_item)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    TEST_TABLE_HANDLE hash_table = TEST_TABLE_create(16, hazard_pointers, NULL);
+    TEST_TABLE_ITEM* item_1 = create_test_item(0x1, 1);
+    TEST_TABLE_ITEM* item_2 = create_test_item(0x1, 2);
+    CLDS_HASH_TABLE_INSERT_RESULT result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, TEST_TABLE_insert(hash_table, hazard_pointers_thread, item_1, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_hash_fn(&item_2->key));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_1));
+    STRICT_EXPECTED_CALL(test_eq_fn(&item_1->key, &item_2->key));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = TEST_TABLE_insert(hash_table, hazard_pointers_thread, item_2, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, result);
+
+    // cleanup
+    TEST_TABLE_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* TEST_TABLE_delete */
+
+/* Tests_SRS_CLDS_TYPED_HASH_TABLE_01_021: [ name_delete shall hash the key with hash_fn, look for it with eq_fn in the groups of its probe sequence like name_find, mark the slot of the key deleted with a compare exchange, retire the item through hazard pointers and return CLDS_HASH_TABLE_DELETE_OK. ]*/
+TEST_FUNCTION(TEST_TABLE_delete_looks_for_the_key_with_hash_fn_and_eq_fn)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    TEST_TABLE_HANDLE hash_table = TEST_TABLE_create(16, hazard_pointers, NULL);
+    TEST_TABLE_ITEM* item = create_test_item(0x1, 1);
+    TEST_KEY key = { 0x1, 1 };
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, TEST_TABLE_insert(hash_table, hazard_pointers_thread, item, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_hash_fn(&key));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item));
+    STRICT_EXPECTED_CALL(test_eq_fn(&item->key, &key));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = TEST_TABLE_delete(hash_table, hazard_pointers_thread, &key, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_IS_NULL(TEST_TABLE_find(hash_table, hazard_pointers_thread, &key));
+
+    // cleanup
+    TEST_TABLE_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_TYPED_HASH_TABLE_01_021: [ name_delete shall hash the key with hash_fn, look for it with eq_fn in the groups of its probe sequence like name_find, mark the slot of the key deleted with a compare exchange, retire the item through hazard pointers and return CLDS_HASH_TABLE_DELETE_OK. ]*/
+TEST_FUNCTION(TEST_TABLE_delete_of_a_key_with_the_same_hash_as_another_key_deletes_only_that_key)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    TEST_TABLE_HANDLE hash_table = TEST_TABLE_create(16, hazard_pointers, NULL);
+    TEST_KEY key_1 = { 0x1, 1 };
+    TEST_KEY key_2 = { 0x1, 2 };
+    TEST_TABLE_ITEM* found_item;
+    CLDS_HASH_TABLE_DELETE_RESULT result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, TEST_TABLE_insert(hash_table, hazard_pointers_thread, create_test_item(0x1, 1), NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, TEST_TABLE_insert(hash_table, hazard_pointers_thread, create_test_item(0x1, 2), NULL));
+    umock_c_reset_all_calls();
+
+    // act
+    result = TEST_TABLE_delete(hash_table, hazard_pointers_thread, &key_2, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_DELETE_RESULT, CLDS_HASH_TABLE_DELETE_OK, result);
+    ASSERT_IS_NULL(TEST_TABLE_find(hash_table, hazard_pointers_thread, &key_2));
+    found_item = TEST_TABLE_find(hash_table, hazard_pointers_thread, &key_1);
+    ASSERT_IS_NOT_NULL(found_item);
+    CLDS_HASH_TABLE_TYPE_NODE_RELEASE(TEST_TABLE, found_item);
+
+    // cleanup
+    TEST_TABLE_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* TEST_TABLE_find */
+
+/* Tests_SRS_CLDS_TYPED_HASH_TABLE_01_030: [ name_find shall hash the key with hash_fn and compare the control bytes of each visited group with the low 7 bits of the hash, without locking the group. ]*/
+/* Tests_SRS_CLDS_TYPED_HASH_TABLE_01_032: [ For each matching slot, name_find shall acquire a hazard pointer on the item in the slot, check that the version of the group did not change and compare the hash and then the key of the item with eq_fn. ]*/
+TEST_FUNCTION(TEST_TABLE_find_looks_for_the_key_with_hash_fn_and_eq_fn)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    TEST_TABLE_HANDLE hash_table = TEST_TABLE_create(16, hazard_pointers, NULL);
+    TEST_TABLE_ITEM* item = create_test_item(0x1, 1);
+    TEST_KEY key = { 0x1, 1 };
+    TEST_TABLE_ITEM* result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, TEST_TABLE_insert(hash_table, hazard_pointers_thread, item, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_hash_fn(&key));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item));
+    STRICT_EXPECTED_CALL(test_eq_fn(&item->key, &key));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = TEST_TABLE_find(hash_table, hazard_pointers_thread, &key);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, item, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_TYPE_NODE_RELEASE(TEST_TABLE, result);
+    TEST_TABLE_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_TYPED_HASH_TABLE_01_032: [ For each matching slot, name_find shall acquire a hazard pointer on the item in the slot, check that the version of the group did not change and compare the hash and then the key of the item with eq_fn. ]*/
+TEST_FUNCTION(TEST_TABLE_find_with_2_keys_with_the_same_hash_returns_the_item_for_which_eq_fn_returns_true)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    TEST_TABLE_HANDLE hash_table = TEST_TABLE_create(16, hazard_pointers, NULL);
+    TEST_TABLE_ITEM* item_1 = create_test_item(0x1, 1);
+    TEST_TABLE_ITEM* item_2 = create_test_item(0x1, 2);
+    TEST_KEY key = { 0x1, 2 };
+    TEST_TABLE_ITEM* result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, TEST_TABLE_insert(hash_table, hazard_pointers_thread, item_1, NULL));
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, TEST_TABLE_insert(hash_table, hazard_pointers_thread, item_2, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_hash_fn(&key));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_1));
+    STRICT_EXPECTED_CALL(test_eq_fn(&item_1->key, &key));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item_2));
+    STRICT_EXPECTED_CALL(test_eq_fn(&item_2->key, &key));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = TEST_TABLE_find(hash_table, hazard_pointers_thread, &key);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(void_ptr, item_2, result);
+
+    // cleanup
+    CLDS_HASH_TABLE_TYPE_NODE_RELEASE(TEST_TABLE, result);
+    TEST_TABLE_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* Tests_SRS_CLDS_TYPED_HASH_TABLE_01_032: [ For each matching slot, name_find shall acquire a hazard pointer on the item in the slot, check that the version of the group did not change and compare the hash and then the key of the item with eq_fn. ]*/
+TEST_FUNCTION(TEST_TABLE_find_does_not_call_eq_fn_for_an_item_with_the_same_tag_and_a_different_hash)
+{
+    // arrange
+    CLDS_HAZARD_POINTERS_HANDLE hazard_pointers = clds_hazard_pointers_create();
+    CLDS_HAZARD_POINTERS_THREAD_HANDLE hazard_pointers_thread = clds_hazard_pointers_register_thread(hazard_pointers);
+    TEST_TABLE_HANDLE hash_table = TEST_TABLE_create(16, hazard_pointers, NULL);
+    // 0x1 and 0x81 have the same low 7 bits
+    TEST_TABLE_ITEM* item = create_test_item(0x81, 1);
+    TEST_KEY key = { 0x1, 1 };
+    TEST_TABLE_ITEM* result;
+    ASSERT_ARE_EQUAL(CLDS_HASH_TABLE_INSERT_RESULT, CLDS_HASH_TABLE_INSERT_OK, TEST_TABLE_insert(hash_table, hazard_pointers_thread, item, NULL));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_hash_fn(&key));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_acquire(hazard_pointers_thread, item));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clds_hazard_pointers_release(hazard_pointers_thread, IGNORED_ARG));
+
+    // act
+    result = TEST_TABLE_find(hash_table, hazard_pointers_thread, &key);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    TEST_TABLE_destroy(hash_table);
+    clds_hazard_pointers_destroy(hazard_pointers);
+}
+
+/* TEST_TABLE_node_create */
+
+/* Tests_SRS_CLDS_TYPED_HASH_TABLE_01_037: [ name_node_create shall allocate node_size bytes, copy the key into the item and set its reference count to 1. ]*/
+/* Tests_SRS_CLDS_TYPED_HASH_TABLE_01_038: [ item_cleanup_callback and item_cleanup_callback_context shall be allowed to be NULL. ]*/
+TEST_FUNCTION(TEST_TABLE_node_create_copies_the_key)
+{
+    // arrange
+    TEST_KEY key = { 0x42, 43 };
+    TEST_TABLE_ITEM* item;
+
+    STRICT_EXPECTED_CALL(malloc(sizeof(TEST_TABLE_NODE_TEST_ITEM)));
+
+    // act
+    item = CLDS_HASH_TABLE_TYPE_NODE_CREATE(TEST_TABLE, TEST_ITEM, &key, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NOT_NULL(item);
+    ASSERT_ARE_NOT_EQUAL(void_ptr, &key, &item->key);
+    ASSERT_ARE_EQUAL(uint64_t, 0x42, item->key.hash);
+    ASSERT_ARE_EQUAL(uint32_t, 43, item->key.id);
+    ASSERT_ARE_EQUAL(int32_t, 1, interlocked_add(&item->ref_count, 0));
+
+    // cleanup
+    CLDS_HASH_TABLE_TYPE_NODE_RELEASE(TEST_TABLE, item);
+}
+
+TEST_FUNCTION(CLDS_HASH_TABLE_TYPE_GET_VALUE_returns_the_record_of_the_node)
+{
+    // arrange
+    TEST_TABLE_ITEM* item = create_test_item(0x42, 43);
+    TEST_ITEM* record;
+
+    // act
+    record = CLDS_HASH_TABLE_TYPE_GET_VALUE(TEST_TABLE, TEST_ITEM, item);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, &((TEST_TABLE_NODE_TEST_ITEM*)item)->record, record);
+
+    // cleanup
+    CLDS_HASH_TABLE_TYPE_NODE_RELEASE(TEST_TABLE, item);
+}
+
+/* Tests_SRS_CLDS_TYPED_HASH_TABLE_01_036: [ If key is NULL or node_size is smaller than the size of the item, name_node_create shall fail and return NULL. ]*/
+TEST_FUNCTION(TEST_TABLE_node_create_with_NULL_key_fails)
+{
+    // arrange
+    TEST_TABLE_ITEM* item;
+
+    // act
+    item = CLDS_HASH_TABLE_TYPE_NODE_CREATE(TEST_TABLE, TEST_ITEM, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(item);
+}
+
+/* Tests_SRS_CLDS_TYPED_HASH_TABLE_01_036: [ If key is NULL or node_size is smaller than the size of the item, name_node_create shall fail and return NULL. ]*/
+TEST_FUNCTION(TEST_TABLE_node_create_with_node_size_smaller_than_the_item_fails)
+{
+    // arrange
+    TEST_KEY key = { 0x42, 43 };
+    TEST_TABLE_ITEM* item;
+
+    // act
+    item = TEST_TABLE_node_create(sizeof(TEST_TABLE_ITEM) - 1, &key, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(item);
+}
+
+/* Tests_SRS_CLDS_TYPED_HASH_TABLE_01_039: [ If any error occurs, name_node_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_malloc_fails_TEST_TABLE_node_create_fails)
+{
+    // arrange
+    TEST_KEY key = { 0x42, 43 };
+    TEST_TABLE_ITEM* item;
+
+    STRICT_EXPECTED_CALL(malloc(sizeof(TEST_TABLE_NODE_TEST_ITEM)))
+        .SetReturn(NULL);
+
+    // act
+    item = CLDS_HASH_TABLE_TYPE_NODE_CREATE(TEST_TABLE, TEST_ITEM, &key, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(item);
+}
+
+/* TEST_TABLE_node_inc_ref */
+
+TEST_FUNCTION(TEST_TABLE_node_inc_ref_with_NULL_item_fails)
+{
+    // arrange
+
+    // act
+    int result = CLDS_HASH_TABLE_TYPE_NODE_INC_REF(TEST_TABLE, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* TEST_TABLE_node_release */
+
+/* Tests_SRS_CLDS_TYPED_HASH_TABLE_01_040: [ When the reference count of an item reaches 0, item_cleanup_callback shall be called (if not NULL) and the item shall be freed. ]*/
+TEST_FUNCTION(TEST_TABLE_node_release_calls_the_cleanup_callback)
+{
+    // arrange
+    TEST_KEY key = { 0x42, 43 };
+    TEST_TABLE_ITEM* item = CLDS_HASH_TABLE_TYPE_NODE_CREATE(TEST_TABLE, TEST_ITEM, &key, test_item_cleanup_func, (void*)0x4242);
+    (void)CLDS_HASH_TABLE_TYPE_NODE_INC_REF(TEST_TABLE, item);
+    CLDS_HASH_TABLE_TYPE_NODE_RELEASE(TEST_TABLE, item);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(test_item_cleanup_func((void*)0x4242, item));
+    STRICT_EXPECTED_CALL(free(item));
+
+    // act
+    CLDS_HASH_TABLE_TYPE_NODE_RELEASE(TEST_TABLE, item);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
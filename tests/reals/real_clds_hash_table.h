@@ -13,29 +13,51 @@
 #define REGISTER_CLDS_HASH_TABLE_GLOBAL_MOCK_HOOKS() \
     MU_FOR_EACH_1(R2, \
         clds_hash_table_create, \
+        clds_hash_table_create_with_bucket_indexing, \
         clds_hash_table_destroy, \
         clds_hash_table_insert, \
+        clds_hash_table_get_or_insert, \
+        clds_hash_table_insert_batch, \
         clds_hash_table_delete, \
         clds_hash_table_delete_key_value, \
         clds_hash_table_remove, \
         clds_hash_table_set_value, \
         clds_hash_table_find, \
+        clds_hash_table_find_batch, \
         clds_hash_table_node_create, \
         clds_hash_table_node_inc_ref, \
         clds_hash_table_node_release, \
-        clds_hash_table_snapshot \
+        clds_hash_table_snapshot, \
+        clds_hash_table_snapshot_at_sequence_number, \
+        clds_hash_table_cursor_open, \
+        clds_hash_table_cursor_next, \
+        clds_hash_table_cursor_close, \
+        clds_hash_table_set_migration_bucket_count, \
+        clds_hash_table_reserve, \
+        clds_hash_table_shrink \
     )
 
 
 CLDS_HASH_TABLE_HANDLE real_clds_hash_table_create(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context);
+CLDS_HASH_TABLE_HANDLE real_clds_hash_table_create_with_bucket_indexing(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t initial_bucket_size, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* start_sequence_number, HASH_TABLE_SKIPPED_SEQ_NO_CB skipped_seq_no_cb, void* skipped_seq_no_cb_context, CLDS_HASH_TABLE_BUCKET_INDEXING bucket_indexing);
 void real_clds_hash_table_destroy(CLDS_HASH_TABLE_HANDLE clds_hash_table);
 CLDS_HASH_TABLE_INSERT_RESULT real_clds_hash_table_insert(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, int64_t* sequence_number);
+CLDS_HASH_TABLE_INSERT_RESULT real_clds_hash_table_get_or_insert(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, HASH_TABLE_ITEM_FACTORY_CB item_factory, void* item_factory_context, CLDS_HASH_TABLE_ITEM** item, int64_t* sequence_number);
+int real_clds_hash_table_insert_batch(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void** keys, CLDS_HASH_TABLE_ITEM** items, uint32_t item_count, uint32_t thread_count, CLDS_HASH_TABLE_INSERT_RESULT* results, int64_t* sequence_numbers);
 CLDS_HASH_TABLE_DELETE_RESULT real_clds_hash_table_delete(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, int64_t* sequence_number);
 CLDS_HASH_TABLE_DELETE_RESULT real_clds_hash_table_delete_key_value(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* value, int64_t* sequence_number);
 CLDS_HASH_TABLE_REMOVE_RESULT real_clds_hash_table_remove(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM** item, int64_t* sequence_number);
 CLDS_HASH_TABLE_ITEM* real_clds_hash_table_find(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key);
+int real_clds_hash_table_find_batch(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void** keys, uint32_t key_count, CLDS_HASH_TABLE_ITEM** items);
 CLDS_HASH_TABLE_SET_VALUE_RESULT real_clds_hash_table_set_value(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_HASH_TABLE_ITEM* new_item, CONDITION_CHECK_CB condition_check_func, void* condition_check_context, CLDS_HASH_TABLE_ITEM** old_item, int64_t* sequence_number);
 CLDS_HASH_TABLE_SNAPSHOT_RESULT real_clds_hash_table_snapshot(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count);
+CLDS_HASH_TABLE_SNAPSHOT_RESULT real_clds_hash_table_snapshot_at_sequence_number(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM*** items, uint64_t* item_count, int64_t* sequence_number);
+CLDS_HASH_TABLE_CURSOR_HANDLE real_clds_hash_table_cursor_open(CLDS_HASH_TABLE_HANDLE clds_hash_table);
+int real_clds_hash_table_cursor_next(CLDS_HASH_TABLE_CURSOR_HANDLE clds_hash_table_cursor, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HASH_TABLE_ITEM** items, uint32_t item_capacity, uint32_t* item_count);
+void real_clds_hash_table_cursor_close(CLDS_HASH_TABLE_CURSOR_HANDLE clds_hash_table_cursor);
+int real_clds_hash_table_set_migration_bucket_count(CLDS_HASH_TABLE_HANDLE clds_hash_table, uint32_t write_migration_bucket_count, uint32_t read_migration_bucket_count);
+int real_clds_hash_table_reserve(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint32_t item_count);
+int real_clds_hash_table_shrink(CLDS_HASH_TABLE_HANDLE clds_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread);
 
 // helper APIs for creating/destroying a hash table node
 CLDS_HASH_TABLE_ITEM* real_clds_hash_table_node_create(size_t node_size, HASH_TABLE_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context);
@@ -1,14 +1,25 @@
 // Copyright (c) Microsoft. All rights reserved.
 
 #define clds_hash_table_create real_clds_hash_table_create
+#define clds_hash_table_create_with_bucket_indexing real_clds_hash_table_create_with_bucket_indexing
 #define clds_hash_table_destroy real_clds_hash_table_destroy
 #define clds_hash_table_insert real_clds_hash_table_insert
+#define clds_hash_table_get_or_insert real_clds_hash_table_get_or_insert
+#define clds_hash_table_insert_batch real_clds_hash_table_insert_batch
 #define clds_hash_table_delete real_clds_hash_table_delete
 #define clds_hash_table_delete_key_value real_clds_hash_table_delete_key_value
 #define clds_hash_table_remove real_clds_hash_table_remove
 #define clds_hash_table_set_value real_clds_hash_table_set_value
 #define clds_hash_table_find real_clds_hash_table_find
+#define clds_hash_table_find_batch real_clds_hash_table_find_batch
 #define clds_hash_table_node_create real_clds_hash_table_node_create
 #define clds_hash_table_node_inc_ref real_clds_hash_table_node_inc_ref
 #define clds_hash_table_node_release real_clds_hash_table_node_release
-#define clds_hash_table_snapshot real_clds_hash_table_snapshot
\ No newline at end of file
+#define clds_hash_table_snapshot real_clds_hash_table_snapshot
+#define clds_hash_table_snapshot_at_sequence_number real_clds_hash_table_snapshot_at_sequence_number
+#define clds_hash_table_cursor_open real_clds_hash_table_cursor_open
+#define clds_hash_table_cursor_next real_clds_hash_table_cursor_next
+#define clds_hash_table_cursor_close real_clds_hash_table_cursor_close
+#define clds_hash_table_set_migration_bucket_count real_clds_hash_table_set_migration_bucket_count
+#define clds_hash_table_reserve real_clds_hash_table_reserve
+#define clds_hash_table_shrink real_clds_hash_table_shrink
\ No newline at end of file
@@ -1,7 +1,6 @@
 // Licensed under the MIT license.See LICENSE file in the project root for full license information.
 
 #include "real_gballoc_hl_renames.h"
-#include "real_clds_st_hash_set_renames.h"
 #include "real_interlocked_renames.h"
 
 #include "real_clds_hazard_pointers_renames.h"
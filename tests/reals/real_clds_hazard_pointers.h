@@ -11,25 +11,41 @@
 #define REGISTER_CLDS_HAZARD_POINTERS_GLOBAL_MOCK_HOOKS() \
     MU_FOR_EACH_1(R2, \
         clds_hazard_pointers_create, \
+        clds_hazard_pointers_create_with_mode, \
         clds_hazard_pointers_destroy, \
         clds_hazard_pointers_register_thread, \
         clds_hazard_pointers_unregister_thread, \
         clds_hazard_pointers_acquire, \
         clds_hazard_pointers_release, \
         clds_hazard_pointers_reclaim, \
-        clds_hazard_pointers_set_reclaim_threshold \
+        clds_hazard_pointers_retire, \
+        clds_hazard_pointers_set_reclaim_threshold, \
+        clds_hazard_pointers_set_adaptive_reclaim_threshold, \
+        clds_hazard_pointers_set_slot_count, \
+        clds_hazard_pointers_start_background_reclaimer, \
+        clds_hazard_pointers_get_statistics, \
+        clds_hazard_pointers_get_thread_statistics, \
+        clds_hazard_pointers_enable_asymmetric_fence \
     )
 
 #include <stddef.h>
 
 CLDS_HAZARD_POINTERS_HANDLE real_clds_hazard_pointers_create(void);
+CLDS_HAZARD_POINTERS_HANDLE real_clds_hazard_pointers_create_with_mode(CLDS_HAZARD_POINTERS_RECLAMATION_MODE reclamation_mode);
 void real_clds_hazard_pointers_destroy(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers);
 CLDS_HAZARD_POINTERS_THREAD_HANDLE real_clds_hazard_pointers_register_thread(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers);
 void real_clds_hazard_pointers_unregister_thread(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread);
 CLDS_HAZARD_POINTER_RECORD_HANDLE real_clds_hazard_pointers_acquire(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* node);
 void real_clds_hazard_pointers_release(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HAZARD_POINTER_RECORD_HANDLE clds_hazard_pointer_record);
 void real_clds_hazard_pointers_reclaim(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* node, RECLAIM_FUNC reclaim_func);
+void real_clds_hazard_pointers_retire(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* node, CLDS_HAZARD_POINTERS_RETIRE_LINK* retire_link, RECLAIM_FUNC reclaim_func);
 int real_clds_hazard_pointers_set_reclaim_threshold(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, size_t reclaim_threshold);
+int real_clds_hazard_pointers_set_adaptive_reclaim_threshold(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, uint32_t headroom_percent);
+int real_clds_hazard_pointers_set_slot_count(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, uint32_t slot_count);
+int real_clds_hazard_pointers_start_background_reclaimer(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, uint32_t max_pending_batches);
+int real_clds_hazard_pointers_get_statistics(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, CLDS_HAZARD_POINTERS_STATISTICS* statistics);
+int real_clds_hazard_pointers_get_thread_statistics(CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_HAZARD_POINTERS_STATISTICS* statistics);
+int real_clds_hazard_pointers_enable_asymmetric_fence(CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers);
 
 
 #endif // REAL_CLDS_HAZARD_POINTERS_H
@@ -1,11 +1,18 @@
 // Licensed under the MIT license.See LICENSE file in the project root for full license information.
 
 #define clds_hazard_pointers_create real_clds_hazard_pointers_create
+#define clds_hazard_pointers_create_with_mode real_clds_hazard_pointers_create_with_mode
 #define clds_hazard_pointers_destroy real_clds_hazard_pointers_destroy
 #define clds_hazard_pointers_register_thread real_clds_hazard_pointers_register_thread
 #define clds_hazard_pointers_unregister_thread real_clds_hazard_pointers_unregister_thread
 #define clds_hazard_pointers_acquire real_clds_hazard_pointers_acquire
 #define clds_hazard_pointers_release real_clds_hazard_pointers_release
 #define clds_hazard_pointers_reclaim real_clds_hazard_pointers_reclaim
+#define clds_hazard_pointers_retire real_clds_hazard_pointers_retire
 #define clds_hazard_pointers_set_reclaim_threshold real_clds_hazard_pointers_set_reclaim_threshold
-
+#define clds_hazard_pointers_set_adaptive_reclaim_threshold real_clds_hazard_pointers_set_adaptive_reclaim_threshold
+#define clds_hazard_pointers_set_slot_count real_clds_hazard_pointers_set_slot_count
+#define clds_hazard_pointers_start_background_reclaimer real_clds_hazard_pointers_start_background_reclaimer
+#define clds_hazard_pointers_get_statistics real_clds_hazard_pointers_get_statistics
+#define clds_hazard_pointers_get_thread_statistics real_clds_hazard_pointers_get_thread_statistics
+#define clds_hazard_pointers_enable_asymmetric_fence real_clds_hazard_pointers_enable_asymmetric_fence
@@ -0,0 +1,10 @@
+// Copyright (c) Microsoft. All rights reserved.
+
+#include "real_gballoc_hl_renames.h"
+#include "real_clds_hazard_pointers_renames.h"
+#include "real_sync_renames.h"
+#include "real_interlocked_renames.h"
+
+#include "real_clds_open_addressing_hash_table_renames.h"
+
+#include "../src/clds_open_addressing_hash_table.c"
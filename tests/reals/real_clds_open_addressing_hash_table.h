@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft. All rights reserved.
+
+#ifndef REAL_CLDS_OPEN_ADDRESSING_HASH_TABLE_H
+#define REAL_CLDS_OPEN_ADDRESSING_HASH_TABLE_H
+
+#include <stddef.h>
+
+#include "macro_utils/macro_utils.h"
+#include "clds/clds_open_addressing_hash_table.h"
+
+#define R2(X) REGISTER_GLOBAL_MOCK_HOOK(X, real_##X);
+
+#define REGISTER_CLDS_OPEN_ADDRESSING_HASH_TABLE_GLOBAL_MOCK_HOOKS() \
+    MU_FOR_EACH_1(R2, \
+        clds_open_addressing_hash_table_create, \
+        clds_open_addressing_hash_table_destroy, \
+        clds_open_addressing_hash_table_insert, \
+        clds_open_addressing_hash_table_delete, \
+        clds_open_addressing_hash_table_remove, \
+        clds_open_addressing_hash_table_find, \
+        clds_open_addressing_hash_table_node_create, \
+        clds_open_addressing_hash_table_node_inc_ref, \
+        clds_open_addressing_hash_table_node_release \
+    )
+
+
+CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE real_clds_open_addressing_hash_table_create(COMPUTE_HASH_FUNC compute_hash, KEY_COMPARE_FUNC key_compare_func, size_t capacity, CLDS_HAZARD_POINTERS_HANDLE clds_hazard_pointers, volatile_atomic int64_t* start_sequence_number);
+void real_clds_open_addressing_hash_table_destroy(CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE clds_open_addressing_hash_table);
+CLDS_HASH_TABLE_INSERT_RESULT real_clds_open_addressing_hash_table_insert(CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE clds_open_addressing_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* value, int64_t* sequence_number);
+CLDS_HASH_TABLE_DELETE_RESULT real_clds_open_addressing_hash_table_delete(CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE clds_open_addressing_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, int64_t* sequence_number);
+CLDS_HASH_TABLE_REMOVE_RESULT real_clds_open_addressing_hash_table_remove(CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE clds_open_addressing_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM** item, int64_t* sequence_number);
+CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* real_clds_open_addressing_hash_table_find(CLDS_OPEN_ADDRESSING_HASH_TABLE_HANDLE clds_open_addressing_hash_table, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key);
+
+// helper APIs for creating/destroying a hash table node
+CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* real_clds_open_addressing_hash_table_node_create(size_t node_size, OPEN_ADDRESSING_HASH_TABLE_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context);
+int real_clds_open_addressing_hash_table_node_inc_ref(CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item);
+void real_clds_open_addressing_hash_table_node_release(CLDS_OPEN_ADDRESSING_HASH_TABLE_ITEM* item);
+
+
+#endif // REAL_CLDS_OPEN_ADDRESSING_HASH_TABLE_H
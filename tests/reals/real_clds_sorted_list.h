@@ -25,6 +25,18 @@
         clds_sorted_list_unlock_writes, \
         clds_sorted_list_get_count, \
         clds_sorted_list_get_all, \
+        clds_sorted_list_head_insert, \
+        clds_sorted_list_head_get_or_insert, \
+        clds_sorted_list_head_delete_item, \
+        clds_sorted_list_head_delete_key, \
+        clds_sorted_list_head_remove_key, \
+        clds_sorted_list_head_find_key, \
+        clds_sorted_list_head_set_value, \
+        clds_sorted_list_head_get_count, \
+        clds_sorted_list_head_get_all, \
+        clds_sorted_list_head_get_first, \
+        clds_sorted_list_head_get_next, \
+        clds_sorted_list_head_clear, \
         clds_sorted_list_node_create, \
         clds_sorted_list_node_inc_ref, \
         clds_sorted_list_node_release \
@@ -44,6 +56,18 @@ void real_clds_sorted_list_lock_writes(CLDS_SORTED_LIST_HANDLE clds_sorted_list)
 void real_clds_sorted_list_unlock_writes(CLDS_SORTED_LIST_HANDLE clds_sorted_list);
 CLDS_SORTED_LIST_GET_COUNT_RESULT real_clds_sorted_list_get_count(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t* item_count);
 CLDS_SORTED_LIST_GET_ALL_RESULT real_clds_sorted_list_get_all(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t item_count, CLDS_SORTED_LIST_ITEM** items);
+CLDS_SORTED_LIST_INSERT_RESULT real_clds_sorted_list_head_insert(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM* item, int64_t* sequence_number);
+CLDS_SORTED_LIST_INSERT_RESULT real_clds_sorted_list_head_get_or_insert(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, SORTED_LIST_ITEM_FACTORY_CB item_factory, void* item_factory_context, CLDS_SORTED_LIST_ITEM** item, int64_t* sequence_number);
+CLDS_SORTED_LIST_DELETE_RESULT real_clds_sorted_list_head_delete_item(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM* item, int64_t* sequence_number);
+CLDS_SORTED_LIST_DELETE_RESULT real_clds_sorted_list_head_delete_key(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, int64_t* sequence_number);
+CLDS_SORTED_LIST_REMOVE_RESULT real_clds_sorted_list_head_remove_key(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SORTED_LIST_ITEM** item, int64_t* sequence_number);
+CLDS_SORTED_LIST_ITEM* real_clds_sorted_list_head_find_key(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key);
+CLDS_SORTED_LIST_SET_VALUE_RESULT real_clds_sorted_list_head_set_value(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SORTED_LIST_ITEM* new_item, CONDITION_CHECK_CB condition_check_func, void* condition_check_context, CLDS_SORTED_LIST_ITEM** old_item, int64_t* sequence_number, bool only_if_exists);
+CLDS_SORTED_LIST_GET_COUNT_RESULT real_clds_sorted_list_head_get_count(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t* item_count);
+CLDS_SORTED_LIST_GET_ALL_RESULT real_clds_sorted_list_head_get_all(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, uint64_t item_count, CLDS_SORTED_LIST_ITEM** items);
+int real_clds_sorted_list_head_get_first(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, CLDS_SORTED_LIST_ITEM** item);
+int real_clds_sorted_list_head_get_next(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head, CLDS_HAZARD_POINTERS_THREAD_HANDLE clds_hazard_pointers_thread, void* key, CLDS_SORTED_LIST_ITEM** item);
+void real_clds_sorted_list_head_clear(CLDS_SORTED_LIST_HANDLE clds_sorted_list, CLDS_SORTED_LIST_HEAD* list_head);
 
 // helper APIs for creating/destroying a singly linked list node
 CLDS_SORTED_LIST_ITEM* real_clds_sorted_list_node_create(size_t node_size, SORTED_LIST_ITEM_CLEANUP_CB item_cleanup_callback, void* item_cleanup_callback_context);
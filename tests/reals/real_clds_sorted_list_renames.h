@@ -12,6 +12,18 @@
 #define clds_sorted_list_unlock_writes real_clds_sorted_list_unlock_writes
 #define clds_sorted_list_get_count real_clds_sorted_list_get_count
 #define clds_sorted_list_get_all real_clds_sorted_list_get_all
+#define clds_sorted_list_head_insert real_clds_sorted_list_head_insert
+#define clds_sorted_list_head_get_or_insert real_clds_sorted_list_head_get_or_insert
+#define clds_sorted_list_head_delete_item real_clds_sorted_list_head_delete_item
+#define clds_sorted_list_head_delete_key real_clds_sorted_list_head_delete_key
+#define clds_sorted_list_head_remove_key real_clds_sorted_list_head_remove_key
+#define clds_sorted_list_head_find_key real_clds_sorted_list_head_find_key
+#define clds_sorted_list_head_set_value real_clds_sorted_list_head_set_value
+#define clds_sorted_list_head_get_count real_clds_sorted_list_head_get_count
+#define clds_sorted_list_head_get_all real_clds_sorted_list_head_get_all
+#define clds_sorted_list_head_get_first real_clds_sorted_list_head_get_first
+#define clds_sorted_list_head_get_next real_clds_sorted_list_head_get_next
+#define clds_sorted_list_head_clear real_clds_sorted_list_head_clear
 
 #define clds_sorted_list_node_create real_clds_sorted_list_node_create
 #define clds_sorted_list_node_inc_ref real_clds_sorted_list_node_inc_ref
@@ -8,8 +8,10 @@
 
 #include "clds/clds_hazard_pointers.h"
 #include "clds/clds_hash_table.h"
+#include "clds/clds_open_addressing_hash_table.h"
 #include "clds/clds_singly_linked_list.h"
 #include "clds/clds_sorted_list.h"
+#include "clds/clds_split_ordered_hash_table.h"
 #include "clds/clds_st_hash_set.h"
 #include "clds/lock_free_set.h"
 #include "clds/mpsc_lock_free_queue.h"
@@ -18,8 +20,10 @@
 
 #include "../tests/reals/real_clds_hazard_pointers.h"
 #include "../tests/reals/real_clds_hash_table.h"
+#include "../tests/reals/real_clds_open_addressing_hash_table.h"
 #include "../tests/reals/real_clds_singly_linked_list.h"
 #include "../tests/reals/real_clds_sorted_list.h"
+#include "../tests/reals/real_clds_split_ordered_hash_table.h"
 #include "../tests/reals/real_clds_st_hash_set.h"
 #include "../tests/reals/real_lock_free_set.h"
 #include "../tests/reals/real_mpsc_lock_free_queue.h"
@@ -35,8 +39,10 @@ TEST_FUNCTION(check_all_clds_reals)
     // act
     REGISTER_CLDS_HAZARD_POINTERS_GLOBAL_MOCK_HOOKS();
     REGISTER_CLDS_HASH_TABLE_GLOBAL_MOCK_HOOKS();
+    REGISTER_CLDS_OPEN_ADDRESSING_HASH_TABLE_GLOBAL_MOCK_HOOKS();
     REGISTER_CLDS_SINGLY_LINKED_LIST_GLOBAL_MOCK_HOOKS();
     REGISTER_CLDS_SORTED_LIST_GLOBAL_MOCK_HOOKS();
+    REGISTER_CLDS_SPLIT_ORDERED_HASH_TABLE_GLOBAL_MOCK_HOOKS();
     REGISTER_CLDS_ST_HASH_SET_GLOBAL_MOCK_HOOKS();
     REGISTER_LOCK_FREE_SET_GLOBAL_MOCK_HOOKS();
     REGISTER_MPSC_LOCK_FREE_QUEUE_GLOBAL_MOCK_HOOKS();